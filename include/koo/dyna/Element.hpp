@@ -174,9 +174,10 @@ public:
     std::vector<ShellElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
 
+private:
     std::vector<ShellElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -217,9 +218,10 @@ public:
     std::vector<SolidElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
 
+private:
     std::vector<SolidElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -249,8 +251,10 @@ public:
     std::vector<BeamElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
+
+private:
     std::vector<BeamElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -280,8 +284,10 @@ public:
     std::vector<DiscreteElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
+
+private:
     std::vector<DiscreteElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -311,8 +317,10 @@ public:
     std::vector<SeatbeltElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
+
+private:
     std::vector<SeatbeltElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -342,8 +350,10 @@ public:
     std::vector<MassElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
+
+private:
     std::vector<MassElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -388,8 +398,10 @@ public:
     std::vector<InertiaElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
+
+private:
     std::vector<InertiaElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -431,8 +443,10 @@ public:
     std::vector<TshellElementData>& getElements() { return elements_; }
     size_t getElementCount() const override { return elements_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
+
+private:
     std::vector<TshellElementData> elements_;
     std::unordered_map<ElementId, size_t> idIndex_;
 };
@@ -446,6 +460,9 @@ struct KOO_API ShellThicknessData {
     double thick2 = 0.0;  // Thickness at node 2
     double thick3 = 0.0;  // Thickness at node 3
     double thick4 = 0.0;  // Thickness at node 4
+
+    /// Mean of the positive nodal thicknesses (0 if none is given)
+    double getAverageThickness() const;
 };
 
 /**
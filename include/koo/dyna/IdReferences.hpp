@@ -0,0 +1,177 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/dyna/Keyword.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace koo::dyna {
+
+/**
+ * @brief Kinds of IDs that keywords define or reference
+ *
+ * Each kind is its own ID namespace: node 1 and part 1 do not collide.
+ * All element types share one namespace, as do all element set types.
+ */
+enum class IdKind {
+    Node,
+    Element,
+    Part,
+    Material,
+    Section,
+    NodeSet,
+    PartSet,
+    ElementSet,
+    SegmentSet,
+    Curve,
+    Contact,
+    CoordinateSystem,
+    Hourglass,
+    Eos
+};
+
+/// Number of IdKind values
+constexpr size_t kIdKindCount = 14;
+
+/**
+ * @brief Get a readable name for an ID kind
+ */
+KOO_API const char* idKindName(IdKind kind);
+
+/**
+ * @brief Whether a field defines an ID or refers to one
+ */
+enum class IdRole {
+    Definition,
+    Reference,
+    Range       ///< End point of an ID range (*_GENERATE); need not be defined itself
+};
+
+/**
+ * @brief Callback receiving one ID field
+ *
+ * The ID is passed by reference so renumbering can rewrite it in place.
+ * Fields holding 0 or negative values mean "none" or carry a special
+ * meaning in LS-DYNA; callers decide whether to skip them.
+ */
+using IdFieldCallback = std::function<void(IdKind kind, IdRole role, int64_t& id)>;
+
+/**
+ * @brief Reference map: which keyword fields hold which kinds of IDs
+ *
+ * Maps a keyword type to an accessor that enumerates its ID fields. Keywords
+ * that hold many items (nodes, elements, set members) expose them as an
+ * item range so callers can split a single large keyword across threads.
+ *
+ * The default map covers nodes, elements, parts, materials (with their load
+ * curves), sections, sets, curves and tables, coordinate systems, contacts,
+ * hourglass and EOS definitions and the *BOUNDARY, *LOAD, *CONSTRAINED,
+ * *INITIAL, *RIGIDWALL, *DATABASE and *CONTROL keywords. *SET_*_GENERAL/
+ * _COLUMN contents are option-driven and listed as Accessor::unmapped.
+ * Keywords without an accessor are described by unmappedKinds(). Custom
+ * keyword types can be added with add() and addFamily().
+ *
+ * Usage:
+ *   const auto& refs = IdReferenceMap::defaults();
+ *   for (auto& kw : model.getKeywords()) {
+ *       if (const auto* accessor = refs.find(*kw)) {
+ *           size_t n = accessor->itemCount(*kw);
+ *           accessor->visit(*kw, 0, n, [](IdKind kind, IdRole role, int64_t& id) {
+ *               // ...
+ *           });
+ *       }
+ *   }
+ */
+class KOO_API IdReferenceMap {
+public:
+    /**
+     * @brief ID field accessor for one keyword type
+     */
+    struct Accessor {
+        /// Number of items (rows) in the keyword
+        std::function<size_t(Keyword&)> itemCount;
+        /// Visit the ID fields of items [begin, end)
+        std::function<void(Keyword&, size_t begin, size_t end, const IdFieldCallback&)> visit;
+        /// Called once after the keyword's IDs were rewritten (may be empty)
+        std::function<void(Keyword&)> finish;
+        /// Kinds the keyword refers to through fields it cannot visit
+        /// (option-driven *SET_*_GENERAL cards); renumbering leaves them alone
+        std::vector<IdKind> unmapped;
+    };
+
+    IdReferenceMap() = default;
+
+    /**
+     * @brief Get the built-in reference map
+     */
+    static const IdReferenceMap& defaults();
+
+    /**
+     * @brief Register or replace the accessor for a keyword type
+     */
+    template<typename T>
+    void add(Accessor accessor) {
+        accessors_[std::type_index(typeid(T))] = std::move(accessor);
+    }
+
+    /**
+     * @brief Register the kinds the keywords of a family may refer to
+     * @tparam Base Common base class of the family
+     *
+     * Describes keywords of that family that have no accessor.
+     */
+    template<typename Base>
+    void addFamily(std::vector<IdKind> kinds) {
+        families_.push_back({[](const Keyword& keyword) {
+            return dynamic_cast<const Base*>(&keyword) != nullptr;
+        }, std::move(kinds)});
+    }
+
+    /**
+     * @brief Find the accessor for a keyword
+     * @param keyword Keyword instance
+     * @return Accessor, or nullptr if the keyword holds no known ID fields
+     *
+     * Looks up the exact type first, then falls back to materials and
+     * sections, whose IDs are available through their base classes.
+     */
+    const Accessor* find(const Keyword& keyword) const;
+
+    /**
+     * @brief Visit all ID fields of a keyword
+     * @return false if the keyword type is not in the map
+     */
+    bool visitAll(Keyword& keyword, const IdFieldCallback& callback) const;
+
+    /**
+     * @brief Kinds a keyword may refer to through fields the map cannot visit
+     *
+     * For a keyword with an accessor this is Accessor::unmapped. Otherwise
+     * it is the kind list of the keyword's family (addFamily()), or every
+     * kind for keywords outside all families, such as unparsed generic
+     * keywords.
+     */
+    std::vector<IdKind> unmappedKinds(const Keyword& keyword) const;
+
+    /**
+     * @brief Number of registered keyword types
+     */
+    size_t size() const { return accessors_.size(); }
+
+private:
+    struct Family {
+        bool (*matches)(const Keyword&);
+        std::vector<IdKind> kinds;
+    };
+
+    std::unordered_map<std::type_index, Accessor> accessors_;
+    std::vector<Family> families_;
+    Accessor materialAccessor_;
+    Accessor sectionAccessor_;
+};
+
+} // namespace koo::dyna
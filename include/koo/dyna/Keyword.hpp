@@ -2,6 +2,7 @@
 
 #include <koo/Export.hpp>
 #include <koo/util/CardParser.hpp>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,8 +47,18 @@ public:
     void setComment(const std::string& comment) { comment_ = comment; }
     const std::string& getComment() const { return comment_; }
 
+    // Source location of the keyword line (set by KeywordFileReader; line 0 = unknown)
+    void setSourceLocation(const std::string& file, size_t line) {
+        sourceFile_ = file;
+        sourceLine_ = line;
+    }
+    const std::string& getSourceFile() const { return sourceFile_; }
+    size_t getSourceLine() const { return sourceLine_; }
+
 protected:
     std::string comment_;
+    std::string sourceFile_;
+    size_t sourceLine_ = 0;
 };
 
 /**
@@ -77,6 +77,11 @@ private:
                        const std::filesystem::path& basePath,
                        Model& model);
 
+    // Handle *INCLUDE_AUTO_OFFSET
+    void handleAutoOffsetInclude(const std::vector<std::string>& lines,
+                                 const std::filesystem::path& basePath,
+                                 Model& model);
+
     // Handle *KEYWORD
     void handleKeywordDirective(const std::string& line);
 
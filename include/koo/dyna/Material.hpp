@@ -5,6 +5,7 @@
 #include <koo/util/Types.hpp>
 #include <vector>
 #include <unordered_map>
+#include <optional>
 
 namespace koo::dyna {
 
@@ -4089,4 +4090,30 @@ private:
     Data data_;
 };
 
+// ============================================================================
+// Material property access
+// ============================================================================
+
+/**
+ * @brief Isotropic elastic constants of a material card
+ *
+ * Used by analyses (time step, mass) that only need density and the
+ * isotropic stiffness of a material, regardless of its constitutive model.
+ */
+struct KOO_API ElasticConstants {
+    double density = 0.0;       ///< RO
+    double youngsModulus = 0.0; ///< E (derived from G and PR if the card has no E)
+    double poissonRatio = 0.0;  ///< PR
+};
+
+/**
+ * @brief Extract density, Young's modulus and Poisson's ratio from any material
+ * @param material Material keyword
+ * @return Elastic constants, or std::nullopt if the material type carries
+ *         no density (e.g. discrete spring/damper materials)
+ *
+ * Cards that only define a shear modulus derive E = 2G(1 + PR).
+ */
+KOO_API std::optional<ElasticConstants> getElasticConstants(const MaterialBase& material);
+
 } // namespace koo::dyna
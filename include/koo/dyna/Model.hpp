@@ -82,6 +82,8 @@ public:
     size_t getNodeCount() const;
     NodeData* findNode(NodeId id);
     const NodeData* findNode(NodeId id) const;
+    /// Position of every node of every *NODE keyword by ID (later definitions win)
+    std::unordered_map<NodeId, Vec3> getNodePositions() const;
 
     // Shell elements
     ElementShell* getShellElements();
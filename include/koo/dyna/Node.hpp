@@ -68,9 +68,10 @@ public:
     // Transform all nodes
     void transform(const Matrix4x4& matrix);
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
 
+private:
     std::vector<NodeData> nodes_;
     std::unordered_map<NodeId, size_t> idIndex_;  // id -> index in nodes_
 };
@@ -62,9 +62,10 @@ public:
     std::vector<PartData>& getParts() { return parts_; }
     size_t getPartCount() const { return parts_.size(); }
 
-private:
+    // Rebuild the ID lookup after editing IDs in place
     void rebuildIndex();
 
+private:
     std::vector<PartData> parts_;
     std::unordered_map<PartId, size_t> idIndex_;
 };
@@ -387,6 +387,9 @@ public:
 
     void accept(ModelVisitor& visitor) override;
 
+    double getThickness() const { return t1_; }
+    void setThickness(double t) { t1_ = t2_ = t3_ = t4_ = t; }
+
     const std::string& getTitle() const { return title_; }
     void setTitle(const std::string& title) { title_ = title; }
 
@@ -802,4 +805,25 @@ private:
     std::string title_;
 };
 
+// ============================================================================
+// Section property access
+// ============================================================================
+
+/**
+ * @brief Geometric section constants used by element analyses
+ *
+ * Used by analyses (time step, mass) that only need the thickness or
+ * cross-section area of a section, regardless of its keyword.
+ */
+struct KOO_API SectionProperties {
+    double shellThickness = 0.0;    ///< T1 of a shell section (0 otherwise)
+    double beamArea = 0.0;          ///< A of a beam section, else TS1 * TT1 (0 otherwise)
+};
+
+/**
+ * @brief Extract shell thickness and beam area from any section
+ * @param section Section keyword
+ */
+KOO_API SectionProperties getSectionProperties(const SectionBase& section);
+
 } // namespace koo::dyna
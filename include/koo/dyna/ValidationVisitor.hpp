@@ -8,8 +8,6 @@
 #include <koo/dyna/Part.hpp>
 #include <koo/dyna/Section.hpp>
 
-#include <set>
-#include <unordered_map>
 #include <vector>
 #include <string>
 #include <sstream>
@@ -42,59 +40,45 @@ struct ValidationMessage {
  * - Missing references (nodes referenced by elements, materials/sections referenced by parts)
  * - Unreferenced entities (nodes, materials, sections not used)
  * - Invalid data (negative densities, zero Young's modulus, etc.)
+ *
+ * IDs are gathered into flat tables while visiting and checked once in
+ * finalizeValidation() after sorting. Only the keyword types visited below
+ * are tracked; managers::IntegrityManager checks references across all
+ * keyword types with source locations.
  */
 class KOO_API ValidationVisitor : public ModelVisitor {
 public:
     ValidationVisitor() = default;
 
-    // Simple validation: just check for duplicate node IDs
+    // Node IDs
     void visit(Node& keyword) override {
         for (const auto& node : keyword.getNodes()) {
-            if (!nodeIds_.insert(node.id).second) {
-                addError("Nodes", "Duplicate node ID: " + std::to_string(node.id));
-            }
+            nodeIds_.push_back(node.id);
         }
     }
 
-    // Simple validation: check for duplicate element IDs and track part references
+    // Element IDs, node and part references
     void visit(ElementShell& keyword) override {
-        for (const auto& elem : keyword.getElements()) {
-            if (!elementIds_.insert(elem.id).second) {
-                addError("Elements", "Duplicate element ID: " + std::to_string(elem.id));
-            }
-            partReferences_[elem.pid]++;
-        }
+        trackElements(keyword.getElements());
     }
 
     void visit(ElementSolid& keyword) override {
-        for (const auto& elem : keyword.getElements()) {
-            if (!elementIds_.insert(elem.id).second) {
-                addError("Elements", "Duplicate element ID: " + std::to_string(elem.id));
-            }
-            partReferences_[elem.pid]++;
-        }
+        trackElements(keyword.getElements());
     }
 
     void visit(ElementBeam& keyword) override {
-        for (const auto& elem : keyword.getElements()) {
-            if (!elementIds_.insert(elem.id).second) {
-                addError("Elements", "Duplicate element ID: " + std::to_string(elem.id));
-            }
-            partReferences_[elem.pid]++;
-        }
+        trackElements(keyword.getElements());
     }
 
-    // Part validation
+    // Part IDs, material and section references
     void visit(Part& keyword) override {
         for (const auto& part : keyword.getParts()) {
-            if (!partIds_.insert(part.id).second) {
-                addError("Parts", "Duplicate part ID: " + std::to_string(part.id));
-            }
+            partIds_.push_back(part.id);
             if (part.mid != 0) {
-                materialReferences_[part.mid]++;
+                materialReferences_.push_back(part.mid);
             }
             if (part.secid != 0) {
-                sectionReferences_[part.secid]++;
+                sectionReferences_.push_back(part.secid);
             }
         }
     }
@@ -102,9 +86,7 @@ public:
     // Material validation - MatElastic
     void visit(MatElastic& keyword) override {
         auto& data = keyword.getData();
-        if (!materialIds_.insert(data.id).second) {
-            addError("Materials", "Duplicate material ID: " + std::to_string(data.id));
-        }
+        materialIds_.push_back(data.id);
         if (data.ro <= 0.0) {
             addWarning("Materials", "Material " + std::to_string(data.id) + " has non-positive density");
         }
@@ -115,18 +97,13 @@ public:
 
     // Material validation - MatRigid
     void visit(MatRigid& keyword) override {
-        auto& data = keyword.getData();
-        if (!materialIds_.insert(data.id).second) {
-            addError("Materials", "Duplicate material ID: " + std::to_string(data.id));
-        }
+        materialIds_.push_back(keyword.getData().id);
     }
 
     // Material validation - MatPlasticKinematic
     void visit(MatPlasticKinematic& keyword) override {
         auto& data = keyword.getData();
-        if (!materialIds_.insert(data.mid).second) {
-            addError("Materials", "Duplicate material ID: " + std::to_string(data.mid));
-        }
+        materialIds_.push_back(data.mid);
         if (data.ro <= 0.0) {
             addWarning("Materials", "Material " + std::to_string(data.mid) + " has non-positive density");
         }
@@ -138,51 +115,22 @@ public:
     // Section validation
     void visit(SectionShell& keyword) override {
         SectionId sid = keyword.getSectionId();
-        if (!sectionIds_.insert(sid).second) {
-            addError("Sections", "Duplicate section ID: " + std::to_string(sid));
-        }
+        sectionIds_.push_back(sid);
         if (keyword.getThickness() <= 0.0) {
             addWarning("Sections", "Shell section " + std::to_string(sid) + " has non-positive thickness");
         }
     }
 
     void visit(SectionSolid& keyword) override {
-        SectionId sid = keyword.getSectionId();
-        if (!sectionIds_.insert(sid).second) {
-            addError("Sections", "Duplicate section ID: " + std::to_string(sid));
-        }
+        sectionIds_.push_back(keyword.getSectionId());
     }
 
     void visit(SectionBeam& keyword) override {
-        SectionId sid = keyword.getSectionId();
-        if (!sectionIds_.insert(sid).second) {
-            addError("Sections", "Duplicate section ID: " + std::to_string(sid));
-        }
+        sectionIds_.push_back(keyword.getSectionId());
     }
 
     // After all keywords are visited, perform final checks
-    void finalizeValidation() {
-        // Check for unreferenced parts
-        for (const auto& pid : partIds_) {
-            if (partReferences_[pid] == 0) {
-                addWarning("Parts", "Part " + std::to_string(pid) + " is not referenced by any elements");
-            }
-        }
-
-        // Check for unreferenced materials
-        for (const auto& mid : materialIds_) {
-            if (materialReferences_[mid] == 0) {
-                addWarning("Materials", "Material " + std::to_string(mid) + " is not referenced by any parts");
-            }
-        }
-
-        // Check for unreferenced sections
-        for (const auto& sid : sectionIds_) {
-            if (sectionReferences_[sid] == 0) {
-                addWarning("Sections", "Section " + std::to_string(sid) + " is not referenced by any parts");
-            }
-        }
-    }
+    void finalizeValidation();
 
     // Get validation results
     const std::vector<ValidationMessage>& getMessages() const { return messages_; }
@@ -207,6 +155,19 @@ public:
     void printMessages(std::ostream& os, ValidationSeverity minSeverity = ValidationSeverity::Info) const;
 
 private:
+    template<typename ElementData>
+    void trackElements(const std::vector<ElementData>& elements) {
+        for (const auto& elem : elements) {
+            elementIds_.push_back(elem.id);
+            partReferences_.push_back(elem.pid);
+            for (NodeId nid : elem.nodeIds) {
+                if (nid > 0) {
+                    nodeReferences_.push_back(nid);
+                }
+            }
+        }
+    }
+
     void addError(const std::string& category, const std::string& message) {
         messages_.push_back({ValidationSeverity::Error, category, message});
     }
@@ -219,17 +180,18 @@ private:
         messages_.push_back({ValidationSeverity::Info, category, message});
     }
 
-    // Tracking sets
-    std::set<NodeId> nodeIds_;
-    std::set<ElementId> elementIds_;
-    std::set<PartId> partIds_;
-    std::set<MaterialId> materialIds_;
-    std::set<SectionId> sectionIds_;
+    // ID tables (sorted in finalizeValidation)
+    std::vector<NodeId> nodeIds_;
+    std::vector<ElementId> elementIds_;
+    std::vector<PartId> partIds_;
+    std::vector<MaterialId> materialIds_;
+    std::vector<SectionId> sectionIds_;
 
-    // Reference counting
-    std::unordered_map<PartId, int> partReferences_;
-    std::unordered_map<MaterialId, int> materialReferences_;
-    std::unordered_map<SectionId, int> sectionReferences_;
+    // Referenced IDs (sorted in finalizeValidation)
+    std::vector<NodeId> nodeReferences_;
+    std::vector<PartId> partReferences_;
+    std::vector<MaterialId> materialReferences_;
+    std::vector<SectionId> sectionReferences_;
 
     // Messages
     std::vector<ValidationMessage> messages_;
@@ -3,7 +3,9 @@
 #include <koo/Export.hpp>
 #include <koo/dyna/Model.hpp>
 #include <koo/dyna/Element.hpp>
+#include <koo/util/Span.hpp>
 #include <koo/util/Types.hpp>
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <optional>
@@ -28,6 +30,16 @@ namespace koo::dyna::managers {
  *
  *   auto solidElems = mgr.getSolidElements();
  *   bool alive = mgr.isAliveAt(elemId, 5.0);  // Check if alive at t=5.0
+ *
+ *   // Zero-copy / batched access for tight loops
+ *   for (ElementId eid : mgr.getElementIdSpan(ElementType::Shell)) {
+ *       util::Span<const NodeId> nodes = mgr.getNodeSpan(eid);
+ *   }
+ *   ElementManager::Connectivity csr;
+ *   mgr.getNodes(mgr.getElementIdSpan(ElementType::Solid), csr);
+ *
+ * Spans point into the model's element storage and are invalidated when
+ * elements are added or removed; call buildIndex() again after editing.
  */
 class KOO_API ElementManager {
 public:
@@ -126,6 +138,13 @@ public:
      */
     std::vector<ElementId> getElementsByType(ElementType type) const;
 
+    /**
+     * @brief Get the cached IDs of all elements of a type without copying
+     * @param type Element type
+     * @return View of the element IDs in model order (empty if none)
+     */
+    util::Span<const ElementId> getElementIdSpan(ElementType type) const;
+
     /**
      * @brief Get all shell element IDs
      */
@@ -168,6 +187,13 @@ public:
      */
     std::vector<NodeId> getNodes(ElementId eid) const;
 
+    /**
+     * @brief Get node IDs for an element without copying
+     * @param eid Element ID
+     * @return View into the element's connectivity (empty if element not found)
+     */
+    util::Span<const NodeId> getNodeSpan(ElementId eid) const;
+
     /**
      * @brief Get number of nodes in an element
      * @param eid Element ID
@@ -175,6 +201,30 @@ public:
      */
     size_t getNodeCount(ElementId eid) const;
 
+    /**
+     * @brief Connectivity of many elements in CSR layout
+     *
+     * Nodes of element i are nodeIds[offsets[i], offsets[i + 1]).
+     */
+    struct Connectivity {
+        std::vector<size_t> offsets;    ///< Size = element count + 1
+        std::vector<NodeId> nodeIds;
+
+        size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+        util::Span<const NodeId> operator[](size_t i) const {
+            return {nodeIds.data() + offsets[i], offsets[i + 1] - offsets[i]};
+        }
+    };
+
+    /**
+     * @brief Get node IDs for many elements at once
+     * @param eids Element IDs
+     * @param out Caller-provided buffer; overwritten, capacity is reused
+     * @param threads Worker threads (0 = hardware concurrency)
+     * @return Number of elements found (missing elements get empty rows)
+     */
+    size_t getNodes(util::Span<const ElementId> eids, Connectivity& out, size_t threads = 0) const;
+
     // ========================================================================
     // Segment Extraction (for Contact/BC)
     // ========================================================================
@@ -219,6 +269,33 @@ public:
      */
     std::vector<Segment> getAllSegments() const;
 
+    /**
+     * @brief Allocation-free segment (up to 4 nodes stored inline)
+     */
+    struct FaceSegment {
+        std::array<NodeId, 4> nodeIds{};   ///< Unused trailing entries are 0
+        uint8_t nodeCount = 0;             ///< 3 or 4
+        int faceIndex = 0;                 ///< Face index (0 for shell, 0-5 for solid)
+        ElementId sourceElement = 0;       ///< Element this segment came from
+
+        util::Span<const NodeId> nodes() const { return {nodeIds.data(), nodeCount}; }
+    };
+
+    /**
+     * @brief Append the segments of an element to a buffer
+     * @param eid Element ID
+     * @param out Buffer the segments are appended to
+     * @return Number of segments appended
+     */
+    size_t getSegments(ElementId eid, std::vector<FaceSegment>& out) const;
+
+    /**
+     * @brief Append the segments of all shell and solid elements to a buffer
+     * @param out Buffer the segments are appended to
+     * @return Number of segments appended
+     */
+    size_t getAllSegments(std::vector<FaceSegment>& out) const;
+
     // ========================================================================
     // Time-Based Queries (Birth/Death)
     // ========================================================================
@@ -268,8 +345,9 @@ private:
     // Index: ElementId → ElementType
     mutable std::unordered_map<ElementId, ElementType> elementType_;
 
-    // Index: ElementType → vector of ElementIds
-    mutable std::unordered_map<ElementType, std::vector<ElementId>> typeToElements_;
+    // Index: ElementType → vector of ElementIds (indexed by the enum value)
+    static constexpr size_t kElementTypeCount = static_cast<size_t>(ElementType::Inertia) + 1;
+    mutable std::array<std::vector<ElementId>, kElementTypeCount> typeToElements_;
 
     // Time indices
     mutable std::unordered_map<ElementId, double> birthTimes_;
@@ -282,6 +360,7 @@ private:
     void buildBirthDeathIndex();
     std::vector<Segment> extractShellSegments(const ShellElementData& elem) const;
     std::vector<Segment> extractSolidSegments(const SolidElementData& elem) const;
+    static size_t appendSegments(const ElementData& elem, ElementType type, std::vector<FaceSegment>& out);
 };
 
 } // namespace koo::dyna::managers
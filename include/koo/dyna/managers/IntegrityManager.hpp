@@ -0,0 +1,147 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/dyna/IdReferences.hpp>
+#include <koo/dyna/Model.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace koo::dyna::managers {
+
+/**
+ * @brief Cross-reference integrity checker
+ *
+ * Collects every ID definition and reference of a model through an
+ * IdReferenceMap, builds one sorted ID table per kind and resolves all
+ * references against it in parallel. Reports:
+ * - Duplicate: an ID defined more than once
+ * - Dangling: a reference to an ID that is not defined, or a *_GENERATE
+ *   range that contains no defined ID (its end points need not be defined)
+ * - Unused: a definition that nothing references (selected kinds only)
+ *
+ * Every issue carries its source location (file:line of the keyword as
+ * read by KeywordFileReader, plus the row within the keyword).
+ *
+ * Usage:
+ *   IntegrityManager mgr(model);
+ *   auto report = mgr.check();
+ *   for (const auto& issue : report.issues) {
+ *       std::cout << IntegrityManager::formatIssue(issue) << "\n";
+ *   }
+ */
+class KOO_API IntegrityManager {
+public:
+    /**
+     * @brief Kind of integrity issue
+     */
+    enum class IssueType {
+        Duplicate,
+        Dangling,
+        Unused
+    };
+
+    /**
+     * @brief Where an ID field was found
+     */
+    struct Location {
+        const Keyword* keyword = nullptr;
+        size_t item = 0;    ///< Row within the keyword (0-based; sets: 0 = set ID)
+
+        /// "file:line *KEYWORD item N" (file omitted when unknown)
+        std::string toString() const;
+    };
+
+    /**
+     * @brief One integrity issue
+     */
+    struct Issue {
+        IssueType type = IssueType::Dangling;
+        IdKind kind = IdKind::Node;
+        int64_t id = 0;
+        Location location;      ///< Duplicate: repeated definition; Dangling: first reference; Unused: definition
+        Location previous;      ///< Duplicate: first definition
+        size_t count = 1;       ///< Dangling: number of references to the ID
+        int64_t last = 0;       ///< Dangling range: last ID of the range starting at id (0 otherwise)
+    };
+
+    /**
+     * @brief Check options
+     */
+    struct Options {
+        size_t threads = 0;                           ///< Worker threads (0 = hardware concurrency)
+        const IdReferenceMap* references = nullptr;   ///< Reference map (nullptr = defaults)
+        /// Kinds checked for unused definitions. Off for kinds that are
+        /// routinely referenced from fields the reference map does not cover.
+        std::array<bool, kIdKindCount> reportUnused{};
+
+        Options() {
+            reportUnused[static_cast<size_t>(IdKind::Part)] = true;
+            reportUnused[static_cast<size_t>(IdKind::Material)] = true;
+            reportUnused[static_cast<size_t>(IdKind::Section)] = true;
+        }
+    };
+
+    /**
+     * @brief Check result
+     */
+    struct Report {
+        std::vector<Issue> issues;                          ///< Duplicates, then dangling, then unused; by kind and ID
+        std::array<size_t, kIdKindCount> definitions{};    ///< Definitions per kind
+        std::array<size_t, kIdKindCount> references{};     ///< References per kind
+        size_t duplicateCount = 0;
+        size_t danglingCount = 0;
+        size_t unusedCount = 0;
+
+        bool ok() const { return duplicateCount == 0 && danglingCount == 0; }
+    };
+
+    /**
+     * @brief Construct an IntegrityManager for the given model
+     * @param model The model to check (must outlive this manager)
+     */
+    explicit IntegrityManager(Model& model);
+
+    /**
+     * @brief Destructor
+     */
+    ~IntegrityManager() = default;
+
+    // Prevent copying (managers reference a model)
+    IntegrityManager(const IntegrityManager&) = delete;
+    IntegrityManager& operator=(const IntegrityManager&) = delete;
+
+    // Allow moving
+    IntegrityManager(IntegrityManager&&) noexcept = default;
+    IntegrityManager& operator=(IntegrityManager&&) noexcept = default;
+
+    // ========================================================================
+    // Checking
+    // ========================================================================
+
+    /**
+     * @brief Check all ID definitions and references
+     * @param options Threading, reference map and unused-kind selection
+     * @return Issues and per-kind statistics
+     *
+     * IDs <= 0 are ignored. The result does not depend on the thread count.
+     */
+    Report check(const Options& options) const;
+
+    /**
+     * @brief Check with default options
+     */
+    Report check() const { return check(Options()); }
+
+    /**
+     * @brief Format an issue as a one-line message
+     */
+    static std::string formatIssue(const Issue& issue);
+
+private:
+    Model& model_;
+};
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/dyna/Model.hpp>
+#include <koo/util/Types.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace koo::dyna::managers {
+
+/**
+ * @brief Mass, center of gravity and inertia tensor calculator
+ *
+ * Computes per-part and model-wide mass properties:
+ * - Shells: density * area * thickness (ELEMENT_SHELL_THICKNESS, element
+ *   card thickness, then SECTION_SHELL)
+ * - Solids: density * volume
+ * - Beams: density * section area * length
+ * - ELEMENT_MASS and ELEMENT_INERTIA point masses
+ * - *PART_INERTIA parts use the mass, CoG and tensor given on the card
+ *
+ * Element mass is lumped equally to its nodes, as the solver does.
+ * The reductions use fixed blocks combined in order, so the results are
+ * bit-identical for any thread count.
+ *
+ * Usage:
+ *   Model model = reader.read("model.k");
+ *   MassPropertiesManager mgr(model);
+ *
+ *   auto report = mgr.compute();
+ *   std::cout << "Total mass: " << report.total.mass << "\n";
+ */
+class KOO_API MassPropertiesManager {
+public:
+    /**
+     * @brief Symmetric inertia tensor
+     *
+     * Off-diagonal entries are tensor components (-sum m*x*y), matching the
+     * IXY/IXZ/IYZ fields of *PART_INERTIA and *ELEMENT_INERTIA.
+     */
+    struct InertiaTensor {
+        double ixx = 0.0;
+        double ixy = 0.0;
+        double ixz = 0.0;
+        double iyy = 0.0;
+        double iyz = 0.0;
+        double izz = 0.0;
+    };
+
+    /**
+     * @brief Mass properties of a group of elements
+     */
+    struct MassProperties {
+        double mass = 0.0;
+        Vec3 centerOfGravity;
+        InertiaTensor inertia;   ///< About the center of gravity
+        size_t elementCount = 0;
+    };
+
+    /**
+     * @brief Mass properties of one part
+     */
+    struct PartMassProperties {
+        PartId pid = 0;
+        bool fromPartInertia = false;  ///< Values taken from *PART_INERTIA
+        MassProperties properties;
+    };
+
+    /**
+     * @brief Calculation options
+     */
+    struct Options {
+        size_t threads = 0;  ///< Worker threads (0 = hardware concurrency)
+    };
+
+    /**
+     * @brief Calculation result
+     */
+    struct Report {
+        std::vector<PartMassProperties> parts;  ///< Parts sorted by ID
+        MassProperties unassigned;              ///< ELEMENT_MASS / ELEMENT_INERTIA without part
+        MassProperties total;                   ///< Whole model
+        size_t skippedCount = 0;                ///< Elements without density or geometry
+    };
+
+    /**
+     * @brief Construct a MassPropertiesManager for the given model
+     * @param model The model to analyze (must outlive this manager)
+     */
+    explicit MassPropertiesManager(Model& model);
+
+    /**
+     * @brief Destructor
+     */
+    ~MassPropertiesManager() = default;
+
+    // Prevent copying (managers reference a model)
+    MassPropertiesManager(const MassPropertiesManager&) = delete;
+    MassPropertiesManager& operator=(const MassPropertiesManager&) = delete;
+
+    // Allow moving
+    MassPropertiesManager(MassPropertiesManager&&) noexcept = default;
+    MassPropertiesManager& operator=(MassPropertiesManager&&) noexcept = default;
+
+    // ========================================================================
+    // Calculation
+    // ========================================================================
+
+    /**
+     * @brief Compute mass properties of all parts and the whole model
+     * @param options Calculation options
+     * @return Per-part, unassigned and total mass properties
+     */
+    Report compute(const Options& options) const;
+
+    /**
+     * @brief Compute with default options
+     */
+    Report compute() const { return compute(Options()); }
+
+    /**
+     * @brief Shift an inertia tensor from a body's CoG to another point
+     * @param tensor Tensor about the center of gravity
+     * @param mass Body mass
+     * @param offset Vector from the new reference point to the CoG
+     * @return Tensor about the new reference point (parallel axis theorem)
+     */
+    static InertiaTensor shiftInertia(const InertiaTensor& tensor, double mass, const Vec3& offset);
+
+private:
+    Model& model_;
+};
+
+} // namespace koo::dyna::managers
@@ -2,6 +2,7 @@
 
 #include <koo/Export.hpp>
 #include <koo/dyna/Model.hpp>
+#include <koo/util/Span.hpp>
 #include <koo/util/Types.hpp>
 #include <vector>
 #include <unordered_map>
@@ -230,12 +231,11 @@ private:
     // Flag indicating if indices have been built
     mutable bool indexBuilt_ = false;
 
-    // Helper: Get all elements from the model
-    struct ElementInfo {
-        ElementId id;
-        std::vector<NodeId> nodeIds;
-    };
-    std::vector<ElementInfo> getAllElementInfo() const;
+    // Helper: Visit every element without copying its connectivity:
+    // fn(ElementId, util::Span<const NodeId> nodes, NodeId extraNode).
+    // extraNode is the beam orientation node (or 0).
+    template<typename Fn>
+    void forEachElement(Fn&& fn) const;
 };
 
 } // namespace koo::dyna::managers
@@ -2,6 +2,7 @@
 
 #include <koo/Export.hpp>
 #include <koo/dyna/Model.hpp>
+#include <koo/util/Span.hpp>
 #include <koo/util/Types.hpp>
 #include <vector>
 #include <unordered_map>
@@ -233,15 +234,11 @@ private:
     // Flag indicating if indices have been built
     mutable bool indexBuilt_ = false;
 
-    // Helper: Get element type and node IDs from any element
-    struct ElementInfo {
-        ElementId id;
-        PartId pid;
-        std::vector<NodeId> nodeIds;
-        ElementType type;
-    };
-
-    std::vector<ElementInfo> getAllElementInfo() const;
+    // Helper: Visit every element that carries a part ID without copying
+    // its connectivity: fn(ElementId, PartId, util::Span<const NodeId> nodes,
+    // NodeId extraNode). extraNode is the beam orientation node (or 0).
+    template<typename Fn>
+    void forEachElement(Fn&& fn) const;
 };
 
 } // namespace koo::dyna::managers
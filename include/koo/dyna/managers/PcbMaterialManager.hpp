@@ -0,0 +1,146 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/dyna/Model.hpp>
+#include <koo/util/Types.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace koo::ecad {
+class OdbJob;
+class Step;
+}
+
+namespace koo::dyna::managers {
+
+/**
+ * @brief Effective PCB materials from the copper coverage of ODB++ layers
+ *
+ * Maps a board mesh (shells, or solids extruded through the board) lying
+ * in the model XY plane onto an ODB++ step. For every copper layer of the
+ * job stackup it computes the copper fraction under each element: the layer
+ * is measured on a raster by CopperArea (overlaps and negative features
+ * resolved exactly per cell), and each element collects the cells its
+ * footprint covers, weighted by the overlap area.
+ *
+ * apply() then turns the fractions into materials: the copper share of the
+ * stack volume of each element is binned into levels, and every level gets
+ * its own *PART, *MAT_ELASTIC (rule of mixtures between copper and
+ * dielectric) and *SECTION_SHELL (stack thickness) or *SECTION_SOLID.
+ *
+ * Copper layers come from the stackup (material type Copper), matched to
+ * step layers by name, then by matrix row (layerIndex). A job without a
+ * stackup falls back to the matrix signal, power/ground and mixed layers,
+ * with the volume share taken as the mean layer fraction.
+ *
+ * Usage:
+ *   PcbMaterialManager mgr(model, job, *job.getStep("pcb"));
+ *   PcbMaterialManager::Options options;
+ *   options.scale = 25.4;          // INCH layers, mm model
+ *   auto result = mgr.apply(options);
+ *   double f = result.getFraction(0, 0);
+ */
+class KOO_API PcbMaterialManager {
+public:
+    /**
+     * @brief Isotropic elastic properties (model units)
+     */
+    struct Properties {
+        double ro = 0.0;    ///< Density
+        double e = 0.0;     ///< Young's modulus
+        double pr = 0.0;    ///< Poisson's ratio
+    };
+
+    /**
+     * @brief Mapping options
+     */
+    struct Options {
+        double scale = 1.0;             ///< Model length per ECAD layer unit
+        double offsetX = 0.0;           ///< Model position of the ECAD origin
+        double offsetY = 0.0;
+        double thicknessScale = 1.0;    ///< Model length per stackup thickness unit
+        double cellSize = 0.0;          ///< Raster cell (model units, 0 = half the mean element width)
+        size_t levels = 10;             ///< Copper volume share levels (parts per element kind)
+        Properties copper{8.96e-9, 1.17e5, 0.34};       ///< Defaults in t, mm, s (MPa)
+        Properties dielectric{1.9e-9, 2.2e4, 0.15};
+        std::vector<PartId> parts;      ///< Parts to map (empty = every shell and solid part)
+        size_t threads = 0;             ///< Worker threads (0 = hardware concurrency)
+    };
+
+    /**
+     * @brief Copper fractions, and what apply() created
+     */
+    struct Result {
+        std::vector<std::string> layers;        ///< Copper layers, in stackup order
+        std::vector<double> layerThickness;     ///< Copper layer thickness (model units)
+        double stackThickness = 0.0;            ///< Whole stackup (model units)
+        std::vector<ElementId> elements;        ///< Mapped shells, then solids
+        std::vector<double> fractions;          ///< Copper fraction per element and layer, row-major
+        std::vector<double> volumeShares;       ///< Copper share of the stack volume per element
+        std::vector<PartId> createdParts;       ///< Parts made by apply(): shell levels, then solid levels
+        std::vector<std::string> warnings;      ///< Unmatched layers, missing nodes, missing stackup
+
+        double getFraction(size_t element, size_t layer) const {
+            return fractions[element * layers.size() + layer];
+        }
+    };
+
+    /**
+     * @brief Construct a PcbMaterialManager
+     * @param model Model holding the board mesh (must outlive this manager)
+     * @param job Job with the stackup and layer matrix (must outlive this manager)
+     * @param step Step whose layers are measured (must outlive this manager)
+     */
+    PcbMaterialManager(Model& model, const ecad::OdbJob& job, const ecad::Step& step);
+
+    /**
+     * @brief Destructor
+     */
+    ~PcbMaterialManager() = default;
+
+    // Prevent copying (managers reference a model)
+    PcbMaterialManager(const PcbMaterialManager&) = delete;
+    PcbMaterialManager& operator=(const PcbMaterialManager&) = delete;
+
+    // ========================================================================
+    // Mapping
+    // ========================================================================
+
+    /**
+     * @brief Copper fraction of every mapped element on every copper layer
+     * @param options Placement, raster and threading
+     * @return Fractions and volume shares; the model is not changed
+     *
+     * The result does not depend on the thread count.
+     */
+    Result computeFractions(const Options& options) const;
+
+    /**
+     * @brief Compute fractions with default options
+     */
+    Result computeFractions() const { return computeFractions(Options()); }
+
+    /**
+     * @brief Compute fractions and move the elements to per-level parts
+     * @param options Placement, raster, levels and material properties
+     * @return Fractions plus the created parts
+     *
+     * New part, material and section IDs continue after the highest
+     * existing ones. Levels without elements get no part. Indices built by
+     * other managers must be rebuilt afterwards.
+     */
+    Result apply(const Options& options);
+
+    /**
+     * @brief Apply with default options
+     */
+    Result apply() { return apply(Options()); }
+
+private:
+    Model& model_;
+    const ecad::OdbJob& job_;
+    const ecad::Step& step_;
+};
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/dyna/IdReferences.hpp>
+#include <koo/dyna/Model.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace koo::dyna::managers {
+
+/**
+ * @brief Bulk ID renumbering and offsetting
+ *
+ * Rewrites every ID definition and reference in a model in one parallel
+ * pass, driven by an IdReferenceMap (which keyword fields hold which ID
+ * kinds). Two modes are supported:
+ * - Offset: add a per-kind offset to the IDs the model defines (include merging)
+ * - Compact: map the defined IDs of each kind onto a dense range
+ *
+ * References to IDs the model does not define are kept. A kind is skipped
+ * (left unchanged) when a keyword refers to it in fields the reference map
+ * cannot rewrite (including keywords the map has no accessor for, see
+ * IdReferenceMap::unmappedKinds()), and in Compact mode when *_GENERATE
+ * ranges refer to it or when a reference to an undefined ID falls inside
+ * the new dense range and would alias a renumbered ID.
+ *
+ * Large keywords (nodes, elements, set members) are split into chunks so a
+ * single *NODE block is processed by all threads.
+ *
+ * Usage:
+ *   // Merge a sub-assembly without ID collisions
+ *   Model vehicle = reader.read("vehicle.k");
+ *   Model dummy = reader.read("dummy.k");
+ *
+ *   RenumberManager mgr(vehicle);
+ *   auto result = mgr.merge(dummy);
+ *   NodeId moved = result.map(IdKind::Node).at(1);  // New ID of dummy node 1
+ *
+ *   // Compact all IDs to 1..n
+ *   RenumberManager::Options options;
+ *   options.mode = RenumberManager::Mode::Compact;
+ *   mgr.renumber(options);
+ */
+class KOO_API RenumberManager {
+public:
+    /// Old ID -> new ID
+    using IdMap = std::unordered_map<int64_t, int64_t>;
+
+    /**
+     * @brief Renumbering mode
+     */
+    enum class Mode {
+        Offset,   ///< new = old + offsets[kind] for defined IDs
+        Compact   ///< new = start[kind] + rank of old among the defined IDs
+    };
+
+    /**
+     * @brief ID range of one kind
+     */
+    struct IdRange {
+        int64_t min = 0;
+        int64_t max = 0;
+        size_t count = 0;   ///< Number of definitions (duplicates included)
+    };
+
+    using IdRanges = std::array<IdRange, kIdKindCount>;
+
+    /**
+     * @brief Renumbering options
+     */
+    struct Options {
+        Mode mode = Mode::Offset;
+        std::array<int64_t, kIdKindCount> offsets{};  ///< Offset mode: per-kind offset
+        std::array<int64_t, kIdKindCount> start{};    ///< Compact mode: first ID (0 = 1)
+        bool buildMaps = true;                        ///< Fill Result::maps
+        size_t threads = 0;                           ///< Worker threads (0 = hardware concurrency)
+        const IdReferenceMap* references = nullptr;   ///< Reference map (nullptr = defaults)
+
+        /// Set the offset of one kind
+        Options& offset(IdKind kind, int64_t value) {
+            offsets[static_cast<size_t>(kind)] = value;
+            return *this;
+        }
+    };
+
+    /**
+     * @brief Renumbering result
+     */
+    struct Result {
+        std::array<IdMap, kIdKindCount> maps;               ///< Old -> new per kind (defined IDs)
+        std::array<size_t, kIdKindCount> rewritten{};      ///< Fields changed per kind
+        std::array<size_t, kIdKindCount> unresolved{};     ///< References to undefined IDs (kept)
+        std::array<bool, kIdKindCount> skipped{};           ///< Kinds left unchanged (see class notes)
+        size_t keywordCount = 0;                            ///< Keywords with ID fields
+
+        const IdMap& map(IdKind kind) const { return maps[static_cast<size_t>(kind)]; }
+    };
+
+    /**
+     * @brief Construct a RenumberManager for the given model
+     * @param model The model to renumber (must outlive this manager)
+     */
+    explicit RenumberManager(Model& model);
+
+    /**
+     * @brief Destructor
+     */
+    ~RenumberManager() = default;
+
+    // Prevent copying (managers reference a model)
+    RenumberManager(const RenumberManager&) = delete;
+    RenumberManager& operator=(const RenumberManager&) = delete;
+
+    // Allow moving
+    RenumberManager(RenumberManager&&) noexcept = default;
+    RenumberManager& operator=(RenumberManager&&) noexcept = default;
+
+    // ========================================================================
+    // ID Ranges
+    // ========================================================================
+
+    /**
+     * @brief Get the defined ID range of every kind
+     * @param references Reference map (nullptr = defaults)
+     */
+    IdRanges getIdRanges(const IdReferenceMap* references = nullptr) const;
+
+    /**
+     * @brief Compute offsets that place another model's IDs above this model's
+     * @param other Model to be merged into this one
+     * @param references Reference map (nullptr = defaults)
+     * @return Per-kind offsets; 0 for kinds whose ranges do not overlap
+     */
+    std::array<int64_t, kIdKindCount> computeCollisionFreeOffsets(
+        const Model& other, const IdReferenceMap* references = nullptr) const;
+
+    // ========================================================================
+    // Renumbering
+    // ========================================================================
+
+    /**
+     * @brief Rewrite all IDs of the model
+     * @param options Mode, offsets and threading
+     * @return Old -> new maps and statistics
+     *
+     * IDs <= 0 are left alone (0 means "none"; negative values carry special
+     * meanings in several LS-DYNA fields), as are references to IDs defined
+     * elsewhere. *_GENERATE range end points need not be defined: in Offset
+     * mode those inside the span of defined IDs are shifted.
+     */
+    Result renumber(const Options& options);
+
+    /**
+     * @brief Offset another model's IDs and move its keywords into this model
+     * @param source Model to merge; left empty afterwards
+     * @param options Threading and reference map; offsets are computed with
+     *        computeCollisionFreeOffsets(), mode is forced to Offset
+     * @return Old -> new maps of the source model; Result::skipped lists
+     *         kinds that kept their IDs and may collide
+     *
+     * This is what *INCLUDE_AUTO_OFFSET does for an included file.
+     */
+    Result merge(Model& source, Options options);
+
+    /**
+     * @brief Merge with default options
+     */
+    Result merge(Model& source) { return merge(source, Options()); }
+
+private:
+    Model& model_;
+};
+
+} // namespace koo::dyna::managers
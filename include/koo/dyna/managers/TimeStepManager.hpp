@@ -0,0 +1,154 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/dyna/Model.hpp>
+#include <koo/dyna/Element.hpp>
+#include <koo/util/Types.hpp>
+#include <vector>
+#include <cstddef>
+
+namespace koo::dyna::managers {
+
+/**
+ * @brief Explicit time-step estimator and mass-scaling preview
+ *
+ * Estimates the stable explicit time step of every shell, solid and beam
+ * element from its characteristic length and the elastic wave speed of its
+ * part's material, then reports per part:
+ * - Minimum time step and the N smallest (controlling) elements
+ * - Part mass and the mass that *CONTROL_TIMESTEP DT2MS would add
+ *
+ * Part, material and section lookups are resolved once up front; the
+ * per-element work runs in parallel and is deterministic for any thread count.
+ *
+ * Usage:
+ *   Model model = reader.read("model.k");
+ *   TimeStepManager mgr(model);
+ *
+ *   TimeStepManager::Options options;
+ *   options.dt2ms = -1.0e-6;               // Preview mass scaling to 1 us
+ *   auto report = mgr.estimate(options);
+ *
+ *   for (const auto& part : report.parts) {
+ *       std::cout << part.pid << ": " << part.minTimeStep << "\n";
+ *   }
+ */
+class KOO_API TimeStepManager {
+public:
+    /**
+     * @brief Estimation options
+     */
+    struct Options {
+        size_t smallestPerPart = 10;  ///< Number of controlling elements kept per part
+        double tssfac = 0.0;          ///< Time step scale factor (0 = *CONTROL_TIMESTEP or 0.9)
+        double dt2ms = 0.0;           ///< Mass scaling time step (0 = *CONTROL_TIMESTEP DT2MS)
+        size_t threads = 0;           ///< Worker threads (0 = hardware concurrency)
+    };
+
+    /**
+     * @brief Time step of a single element
+     */
+    struct ElementTimeStep {
+        ElementId eid = 0;
+        PartId pid = 0;
+        ElementType type = ElementType::Unknown;
+        double charLength = 0.0;  ///< Characteristic length
+        double waveSpeed = 0.0;   ///< Elastic wave speed
+        double timeStep = 0.0;    ///< Scaled stable time step (TSSFAC * Lc / c)
+        double mass = 0.0;        ///< Element mass
+        double addedMass = 0.0;   ///< Mass added by DT2MS mass scaling
+    };
+
+    /**
+     * @brief Time step summary of a part
+     */
+    struct PartTimeStep {
+        PartId pid = 0;
+        MaterialId mid = 0;
+        SectionId secid = 0;
+        size_t elementCount = 0;
+        double minTimeStep = 0.0;
+        double mass = 0.0;
+        double addedMass = 0.0;
+        size_t scaledElementCount = 0;          ///< Elements receiving added mass
+        std::vector<ElementTimeStep> smallest;  ///< Smallest time steps, ascending
+    };
+
+    /**
+     * @brief Model-wide estimation result
+     */
+    struct Report {
+        std::vector<PartTimeStep> parts;     ///< Parts sorted by ID
+        ElementTimeStep controlling;         ///< Element with the smallest time step
+        double tssfac = 0.0;                 ///< Scale factor that was applied
+        double dt2ms = 0.0;                  ///< Mass scaling time step that was applied
+        double totalMass = 0.0;
+        double totalAddedMass = 0.0;
+        size_t elementCount = 0;             ///< Elements with a valid time step
+        size_t skippedCount = 0;             ///< Elements without material, section or geometry
+    };
+
+    /**
+     * @brief Construct a TimeStepManager for the given model
+     * @param model The model to analyze (must outlive this manager)
+     */
+    explicit TimeStepManager(Model& model);
+
+    /**
+     * @brief Destructor
+     */
+    ~TimeStepManager() = default;
+
+    // Prevent copying (managers reference a model)
+    TimeStepManager(const TimeStepManager&) = delete;
+    TimeStepManager& operator=(const TimeStepManager&) = delete;
+
+    // Allow moving
+    TimeStepManager(TimeStepManager&&) noexcept = default;
+    TimeStepManager& operator=(TimeStepManager&&) noexcept = default;
+
+    // ========================================================================
+    // Estimation
+    // ========================================================================
+
+    /**
+     * @brief Estimate element time steps and the mass-scaling preview
+     * @param options Estimation options
+     * @return Per-part and model-wide results
+     *
+     * Elements with dt < TSSFAC * |DT2MS| receive added mass
+     * m * ((TSSFAC * |DT2MS| / dt)^2 - 1), as LS-DYNA would add at start-up.
+     * Discrete, seatbelt, mass and inertia elements are not considered.
+     */
+    Report estimate(const Options& options) const;
+
+    /**
+     * @brief Estimate with default options
+     */
+    Report estimate() const { return estimate(Options()); }
+
+    // ========================================================================
+    // Element Formulas
+    // ========================================================================
+
+    /**
+     * @brief Shell characteristic length
+     * @param nodes 3 or 4 corner positions
+     * @param count Number of corners (3 or 4)
+     * @param useDiagonals Use the diagonals instead of the sides (ISDO = 1)
+     * @return (1 + beta) * A / max(L), beta = 1 for triangles, 0 for quads
+     */
+    static double shellCharacteristicLength(const Vec3* nodes, size_t count, bool useDiagonals = false);
+
+    /**
+     * @brief Solid characteristic length
+     * @param nodes Positions of the 8 hexahedron nodes (degenerate nodes repeated)
+     * @return V / max face area for hexahedra/pentahedra, minimum altitude for tetrahedra
+     */
+    static double solidCharacteristicLength(const Vec3* nodes);
+
+private:
+    Model& model_;
+};
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace koo::ecad {
+
+class EdaData;
+class LayerMatrix;
+class Step;
+class SymbolCache;
+
+/**
+ * @brief Design-rule clearance check of copper layers
+ *
+ * Every copper feature is reduced to exact primitives: round pads are
+ * discs and oblong pads slots, other pads their symbol outline (rotated,
+ * mirrored and resized), lines and arcs their centerline grown by the
+ * symbol radius (lines drawn with a non-round symbol sweep its outline),
+ * and surfaces keep their contours with true arcs. Distances are measured
+ * between segments and arcs in closed form, so a gap is reported to
+ * rounding error rather than to a tessellation tolerance; a feature lying
+ * inside a pad or surface is at distance 0.
+ *
+ * Each layer is cut into tiles of about equal feature count, processed in
+ * parallel. A feature queries the layer R-tree with its extent grown by the
+ * largest clearance any rule can ask for, and every neighbour on a
+ * different net is measured against the clearance required for that pair:
+ * the default clearance, raised by every rule matching the layer and nets.
+ * Violations are streamed one batch of tiles at a time, in an order that
+ * does not depend on the thread count.
+ *
+ * With an edge clearance, copper is also checked against the step profile
+ * (in layer units): copper closer than the edge clearance to the outline,
+ * or lying outside it, is a BoardEdge violation.
+ *
+ * Nets come from the feature net names, overridden by the EDA FID records.
+ * Features without a net are only checked when asked to (each then counts
+ * as a net of its own). Negative-polarity features, text and barcodes are
+ * not checked; a negative feature clears the copper drawn before it, so
+ * contact or closest points lying under a later negative feature are not
+ * measured (the gap to the edge of the clearing itself is not checked).
+ *
+ * Usage:
+ *   ClearanceChecker checker(step, job.getMatrix());
+ *   ClearanceChecker::Options options;
+ *   options.clearance = 0.004;
+ *   options.rules = ClearanceChecker::rulesFromImpedance(job.getImpedanceConstraints());
+ *   checker.check(options, [](const ClearanceChecker::Violation& v) {
+ *       std::cout << ClearanceChecker::formatViolation(v) << "\n";
+ *   });
+ */
+class KOO_API ClearanceChecker {
+public:
+    /// Feature index of board edge violations
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Kind of violation
+     */
+    enum class ViolationType {
+        Clearance,      ///< Two nets closer than their clearance
+        BoardEdge       ///< Copper closer than the edge clearance to the profile, or outside it
+    };
+
+    /**
+     * @brief Minimum spacing between nets
+     *
+     * Empty fields match anything. A rule with one net applies to that net
+     * against every other; a rule with both applies to that pair only.
+     */
+    struct Rule {
+        std::string layer;          ///< Layer name (empty = every layer)
+        std::string net;            ///< Net name (empty = any net)
+        std::string otherNet;       ///< Net on the other side (empty = any net)
+        double clearance = 0.0;     ///< Required spacing (layer units)
+    };
+
+    /**
+     * @brief Check options
+     */
+    struct Options {
+        double clearance = 0.0;         ///< Default spacing between nets (layer units)
+        double edgeClearance = 0.0;     ///< Spacing to the step profile (0 = no board edge check)
+        std::vector<Rule> rules;        ///< Spacing rules raising the default
+        std::vector<std::string> layers;        ///< Layers to check (empty = matrix copper layers)
+        bool checkUnassigned = false;   ///< Check features without a net
+        size_t threads = 0;             ///< Worker threads (0 = hardware concurrency)
+        const SymbolCache* symbols = nullptr;   ///< Shared symbol geometry (nullptr = each layer's, else a private cache)
+    };
+
+    /**
+     * @brief One violation
+     */
+    struct Violation {
+        ViolationType type = ViolationType::Clearance;
+        std::string layer;
+        size_t feature = 0;             ///< Feature index in the layer
+        size_t other = npos;            ///< Feature on the other net (npos for board edge)
+        std::string net;                ///< Net of feature (empty if none)
+        std::string otherNet;           ///< Net of other (empty for board edge)
+        double distance = 0.0;          ///< Copper gap (0 when overlapping or off the board)
+        double required = 0.0;          ///< Clearance that applied
+        Point2D location;               ///< Midpoint of the closest approach
+    };
+
+    /// Receives violations as they are found
+    using ViolationCallback = std::function<void(const Violation& violation)>;
+
+    /**
+     * @brief Check result
+     */
+    struct Result {
+        std::vector<std::string> layers;        ///< Layers checked, in order
+        std::vector<Violation> violations;      ///< By layer, then tile, then feature
+        size_t clearanceCount = 0;
+        size_t edgeCount = 0;
+        size_t pairCount = 0;                   ///< Different-net pairs measured
+
+        bool ok() const { return clearanceCount == 0 && edgeCount == 0; }
+    };
+
+    /**
+     * @brief Construct for a step
+     * @param step Step whose layers, profile and EDA data are used (must outlive this object)
+     * @param matrix Job layer matrix (copper layers and their order)
+     */
+    ClearanceChecker(const Step& step, const LayerMatrix& matrix);
+
+    /**
+     * @brief Check and collect every violation
+     *
+     * The result does not depend on the thread count.
+     */
+    Result check(const Options& options) const;
+
+    /**
+     * @brief Check with default options
+     */
+    Result check() const { return check(Options()); }
+
+    /**
+     * @brief Check and stream violations instead of storing them
+     * @param options Rules, layers and threading
+     * @param callback Called on the calling thread, in the order check() stores them
+     * @return Counts and layers; violations is left empty
+     */
+    Result check(const Options& options, const ViolationCallback& callback) const;
+
+    // ========== Rule Tables ==========
+
+    /**
+     * @brief Layer-wide rules from impedance constraints
+     *
+     * Each constraint with a spacing gives its layer that minimum spacing.
+     */
+    static std::vector<Rule> rulesFromImpedance(const std::vector<ImpedanceConstraint>& constraints);
+
+    /**
+     * @brief One rule per EDA net of a class, sorted by net name
+     */
+    static std::vector<Rule> rulesFromNetClass(const EdaData& eda, NetClass netClass, double clearance);
+
+    /**
+     * @brief Format a violation as a one-line message
+     */
+    static std::string formatViolation(const Violation& violation);
+
+private:
+    const Step& step_;
+    const LayerMatrix& matrix_;
+};
+
+} // namespace koo::ecad
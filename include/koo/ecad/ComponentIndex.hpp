@@ -0,0 +1,148 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <koo/ecad/SpatialIndex.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace koo::ecad {
+
+class EdaData;
+struct Pin;
+
+/**
+ * @brief Side-aware spatial lookup of placed components and pins
+ *
+ * Each component is placed by its CMP record: its package's PKG box (or
+ * the bounds of the package outlines) is mirrored, rotated clockwise and
+ * moved to the component position. Pins are the component's toeprints,
+ * which are already in board coordinates, or else its package's pins
+ * placed the same way. Components and pins live in one packed R-tree per
+ * mounting side, so every query looks at one side only.
+ *
+ * Area queries test the board-space boxes; point queries on components
+ * test the footprint box in the package frame, so rotated parts are exact.
+ * The index refers to the EdaData it was built from, which must outlive it
+ * and stay unchanged. Queries are const and may run concurrently; the
+ * batched forms split their work over threads.
+ *
+ * Usage:
+ *   ComponentIndex index(step.getEdaData());
+ *   size_t pin = index.getPinAt({x, y}, MountSide::Top, 0.05);
+ *   for (size_t c : index.getComponentsInArea(region, MountSide::Bottom)) { ... }
+ *   auto owners = index.getComponentsAt(centroids, MountSide::Top);
+ */
+class KOO_API ComponentIndex {
+public:
+    static constexpr size_t npos = SpatialIndex::npos;
+
+    /**
+     * @brief Where a component sits on the board
+     */
+    struct Placement {
+        Transform2D transform;      ///< Package frame -> board
+        BoundingBox2D footprint;    ///< Footprint box in the package frame (invalid if unknown)
+        BoundingBox2D bounds;       ///< Board-space box of the placed footprint and pins
+        MountSide side = MountSide::Top;
+    };
+
+    /**
+     * @brief A pin at its board position
+     */
+    struct PlacedPin {
+        const Pin* pin = nullptr;   ///< Component toeprint or package pin
+        uint32_t component = 0;     ///< Index into EdaData::getComponents()
+        Point2D position;           ///< Board coordinates
+    };
+
+    /**
+     * @brief Build the index
+     * @param eda Components and packages to index
+     * @param threads Worker threads for building the trees (0 = hardware concurrency)
+     */
+    explicit ComponentIndex(const EdaData& eda, size_t threads = 0);
+
+    const EdaData& getEdaData() const { return eda_; }
+
+    // ========== Components ==========
+
+    /// Placement of a component (index into EdaData::getComponents())
+    const Placement& getPlacement(size_t component) const { return placements_[component]; }
+
+    /// Components on a side whose board box overlaps an area (ascending)
+    std::vector<size_t> getComponentsInArea(const BoundingBox2D& area, MountSide side) const;
+
+    /// Components on a side whose footprint contains a point (ascending)
+    std::vector<size_t> getComponentsAt(const Point2D& point, MountSide side) const;
+
+    /// Area queries run in parallel; result i answers areas[i]
+    std::vector<std::vector<size_t>> getComponentsInAreas(const std::vector<BoundingBox2D>& areas,
+                                                          MountSide side, size_t threads = 0) const;
+
+    /**
+     * @brief Point queries run in parallel
+     * @return Per point, the last component in EdaData order whose footprint
+     *         contains it, or npos
+     */
+    std::vector<size_t> getComponentsAt(const std::vector<Point2D>& points, MountSide side,
+                                        size_t threads = 0) const;
+
+    // ========== Pins ==========
+
+    /// All placed pins, grouped by component in EdaData order
+    const std::vector<PlacedPin>& getPins() const { return pins_; }
+
+    /// Pins of a component: getPins()[first .. last)
+    std::pair<size_t, size_t> getComponentPins(size_t component) const {
+        return {pinOffsets_[component], pinOffsets_[component + 1]};
+    }
+
+    /// Pins on a side inside an area (indices into getPins(), ascending)
+    std::vector<size_t> getPinsInArea(const BoundingBox2D& area, MountSide side) const;
+
+    /**
+     * @brief Pin on a side closest to a point
+     * @param point Query point
+     * @param side Mounting side
+     * @param tolerance Largest accepted distance
+     * @param distance Optional output: distance to the pin
+     * @return Index into getPins(), or npos if no pin is within tolerance
+     */
+    size_t getPinAt(const Point2D& point, MountSide side, double tolerance,
+                    double* distance = nullptr) const;
+
+    /// Pin lookups run in parallel; result i answers points[i]
+    std::vector<size_t> getPinsAt(const std::vector<Point2D>& points, MountSide side,
+                                  double tolerance, size_t threads = 0) const;
+
+private:
+    /**
+     * @brief Trees over the components and pins of one side
+     */
+    struct SideIndex {
+        std::vector<uint32_t> components;   ///< Tree item -> component
+        SpatialIndex componentTree;
+        std::vector<uint32_t> pins;         ///< Tree item -> pin
+        SpatialIndex pinTree;
+    };
+
+    const SideIndex& sideIndex(MountSide side) const {
+        return sides_[side == MountSide::Bottom ? 1 : 0];
+    }
+
+    /// Whether a component's footprint (or board box, if unknown) contains a point
+    bool footprintContains(size_t component, const Point2D& point) const;
+
+    const EdaData& eda_;
+    std::vector<Placement> placements_;
+    std::vector<Transform2D> toPackage_;    ///< Board -> package frame, per component
+    std::vector<PlacedPin> pins_;
+    std::vector<size_t> pinOffsets_;        ///< Component c owns pins_[pinOffsets_[c] .. pinOffsets_[c + 1])
+    std::array<SideIndex, 2> sides_;        ///< Top, bottom
+};
+
+} // namespace koo::ecad
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <koo/ecad/SpatialIndex.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace koo::ecad {
+
+class Layer;
+class SymbolCache;
+struct SymbolGeometry;
+
+/**
+ * @brief Copper area and density of a layer, with overlaps and polarity resolved
+ *
+ * Every feature is turned into filled polygons: pads take their symbol
+ * outline (round, square, rectangle with rounded or chamfered corners,
+ * oblong, diamond, octagon, round/square donut; other symbols fall back to
+ * their box), lines and arcs sweep their symbol along the path, and
+ * surfaces keep their islands and holes. Arcs are flattened to within the
+ * arc tolerance and all vertices are snapped to an integer grid, so shared
+ * vertices meet exactly. Symbol outlines come from a SymbolCache; pass the
+ * job's to share them across layers (they keep the cache's tolerance).
+ *
+ * The features are then combined in drawing order: a negative feature
+ * erases whatever was drawn before it, a later positive one draws again.
+ * Areas come from an exact trapezoid scanline over the snapped polygons,
+ * one tile (a block of map cells) at a time, with tiles processed in
+ * parallel; each tile only sees the features an R-tree finds overlapping it,
+ * clipped to the tile, and spreads every trapezoid over the cells it spans.
+ *
+ * The same outlines can be rasterized for previews and density or
+ * conductivity maps. Square tiles of pixels are rendered in parallel, each
+ * painting its features in drawing order into a sample mask: one sample
+ * per pixel center, or N x N samples averaged into an anti-aliased
+ * coverage. Rasters hold 8-bit or float coverage and export as PGM, raw
+ * pixels or NumPy .npy.
+ *
+ * Text and barcodes are not copper and are ignored, as is the layer's own
+ * polarity.
+ *
+ * Usage:
+ *   CopperArea copper(*step.getLayer("top"));
+ *   double area = copper.getArea();
+ *   auto map = copper.getDensityMap(100, 80);
+ *   double fill = map.getDensity(10, 20);
+ *   copper.rasterize(2000, 1600).writePgm("top.pgm");
+ */
+class KOO_API CopperArea {
+public:
+    /**
+     * @brief Geometry options
+     */
+    struct Options {
+        double resolution = 1e-6;   ///< Snap grid (layer units)
+        double arcTolerance = 1e-4; ///< Max chord deviation when flattening arcs (layer units)
+        size_t threads = 0;         ///< Worker threads (0 = hardware concurrency)
+        const SymbolCache* symbols = nullptr;   ///< Shared symbol outlines (nullptr = a private cache)
+    };
+
+    /**
+     * @brief Copper area on a regular grid
+     *
+     * Cell (column, row) covers [min.x + column*w, +w) x [min.y + row*h, +h).
+     */
+    struct DensityMap {
+        BoundingBox2D bounds;
+        size_t columns = 0;
+        size_t rows = 0;
+        std::vector<double> area;           ///< Copper area per cell, row-major from bounds.min
+
+        double getCellWidth() const { return columns ? bounds.width() / static_cast<double>(columns) : 0.0; }
+        double getCellHeight() const { return rows ? bounds.height() / static_cast<double>(rows) : 0.0; }
+
+        /// Copper area of a cell
+        double getArea(size_t column, size_t row) const { return area[row * columns + column]; }
+
+        /// Copper fraction of a cell (0..1)
+        double getDensity(size_t column, size_t row) const;
+
+        /// Copper area over the whole map
+        double getTotalArea() const;
+    };
+
+    /// Pixel type of a raster
+    enum class PixelFormat {
+        UInt8,          ///< Coverage scaled to 0..255
+        Float32         ///< Coverage 0..1
+    };
+
+    /**
+     * @brief Rasterization options
+     */
+    struct RasterOptions {
+        PixelFormat format = PixelFormat::UInt8;
+        bool antialias = true;      ///< Average samples x samples points per pixel (else pixel centers only)
+        size_t samples = 4;         ///< Samples per pixel axis when anti-aliasing
+        size_t tileSize = 256;      ///< Tile edge in pixels (unit of parallel work)
+    };
+
+    /**
+     * @brief Copper coverage on a pixel grid
+     *
+     * Pixel (column, row) covers the same area as a DensityMap cell; rows
+     * run from bounds.min upward.
+     */
+    struct Raster {
+        BoundingBox2D bounds;
+        size_t columns = 0;
+        size_t rows = 0;
+        PixelFormat format = PixelFormat::UInt8;
+        std::vector<uint8_t> bytes;         ///< UInt8 pixels, row-major from bounds.min
+        std::vector<float> values;          ///< Float32 pixels, row-major from bounds.min
+
+        /// Coverage of a pixel (0..1)
+        double getCoverage(size_t column, size_t row) const;
+
+        /// Binary 8-bit PGM (P5), top row first so viewers show the board upright
+        bool writePgm(const std::filesystem::path& path) const;
+
+        /// Pixels as stored, without a header
+        bool writeRaw(const std::filesystem::path& path) const;
+
+        /// NumPy .npy array of shape (rows, columns), uint8 or float32
+        bool writeNpy(const std::filesystem::path& path) const;
+    };
+
+    /**
+     * @brief Prepare a layer (outlines its surfaces and indexes every feature)
+     * @param layer Layer to measure (must outlive this object and stay unchanged)
+     * @param options Snap grid, arc tolerance and threading
+     */
+    CopperArea(const Layer& layer, const Options& options);
+
+    /// Prepare a layer with default options
+    explicit CopperArea(const Layer& layer);
+
+    ~CopperArea();
+
+    /// Bounds of all copper, including symbol extents
+    BoundingBox2D getBounds() const { return bounds_; }
+
+    /// Total copper area of the layer
+    double getArea() const;
+
+    /// Copper area inside a window
+    double getArea(const BoundingBox2D& window) const;
+
+    /// Density map over the copper bounds
+    DensityMap getDensityMap(size_t columns, size_t rows) const;
+
+    /// Density map over given bounds
+    DensityMap getDensityMap(const BoundingBox2D& bounds, size_t columns, size_t rows) const;
+
+    /**
+     * @brief Rasterize the layer
+     * @param bounds Area covered by the raster (layer units)
+     * @param columns Pixels across
+     * @param rows Pixels up
+     * @param options Pixel format, anti-aliasing and tiling
+     */
+    Raster rasterize(const BoundingBox2D& bounds, size_t columns, size_t rows,
+                     const RasterOptions& options) const;
+
+    /// Anti-aliased 8-bit raster over the copper bounds
+    Raster rasterize(size_t columns, size_t rows) const {
+        return rasterize(bounds_, columns, rows, RasterOptions());
+    }
+
+private:
+    /// One feature outline: rings of snapped grid coordinates
+    struct Outline {
+        std::vector<Point2D> points;
+        std::vector<uint32_t> rings;    ///< Ring start offsets plus end sentinel
+    };
+
+    /// Outline of a feature in grid units (nullptr for non-copper features);
+    /// surfaces come from the cache, others are built into scratch
+    const Outline* buildOutline(size_t index, Outline& scratch) const;
+
+    /// Add the copper area of each cell of a tile (grid units) to area (columns x rows, row-major)
+    void tileArea(const BoundingBox2D& tile, size_t columns, size_t rows,
+                  double* area, Outline& scratch) const;
+
+    /// Set the coverage of each pixel of a tile (grid units) from samples x samples points per pixel
+    void tileCoverage(const BoundingBox2D& tile, size_t columns, size_t rows, size_t samples,
+                      float* coverage, Outline& scratch) const;
+
+    const Layer& layer_;
+    Options options_;
+    double scale_ = 1.0;                                ///< Layer units -> grid units
+    std::unique_ptr<SymbolCache> ownSymbols_;           ///< Used when no cache is shared
+    std::vector<const SymbolGeometry*> symbols_;        ///< Layer symbol table, resolved
+    std::unordered_map<size_t, Outline> surfaces_;      ///< Surface outlines (grid units)
+    SpatialIndex index_;                                ///< Feature outline bounds (grid units)
+    BoundingBox2D bounds_;
+    size_t vertices_ = 0;                               ///< Outline vertices of all features (sizes tiles)
+};
+
+} // namespace koo::ecad
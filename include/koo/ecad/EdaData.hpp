@@ -3,6 +3,7 @@
 #include <koo/Export.hpp>
 #include <koo/ecad/Types.hpp>
 #include <koo/ecad/Feature.hpp>
+#include <koo/ecad/FeatureStore.hpp>
 #include <memory>
 #include <string>
 #include <vector>
@@ -27,7 +28,7 @@ class Package;
 struct KOO_API Pin {
     std::string name;           ///< Pin name (1, 2, A1, VCC, etc.)
     std::string netName;        ///< Connected net name
-    double x = 0.0, y = 0.0;    ///< Position (relative to component origin)
+    double x = 0.0, y = 0.0;    ///< Position (package pins: package frame; component toeprints: board)
     PinType type = PinType::Smd;
     int featureLayerIndex = -1; ///< Feature layer index
     int electricalLayerIndex = -1; ///< Electrical layer index
@@ -287,6 +288,11 @@ private:
  * - Components
  * - Packages
  * - Feature-to-net mappings
+ *
+ * Reference designators and net names are interned into one StringTable;
+ * components and nets live in insertion order and are found through
+ * per-name-ID slots, so lookups by name hash once and lookups by index
+ * do not hash at all.
  */
 class KOO_API EdaData {
 public:
@@ -298,19 +304,24 @@ public:
     Component* getComponent(const std::string& refDes);
     const Component* getComponent(const std::string& refDes) const;
 
-    /// Add component
+    /// Get component by index into getComponents()
+    Component* getComponent(int index);
+    const Component* getComponent(int index) const;
+
+    /// Index of a component in getComponents() (-1 if absent)
+    int getComponentIndex(const std::string& refDes) const;
+
+    /// Add component (replaces one with the same reference designator in place)
     void addComponent(std::unique_ptr<Component> comp);
 
-    /// Get all component reference designators
+    /// Get all component reference designators, in insertion order
     std::vector<std::string> getComponentRefDes() const;
 
     /// Get component count
     size_t getComponentCount() const { return components_.size(); }
 
-    /// Get all components
-    const std::unordered_map<std::string, std::unique_ptr<Component>>& getComponents() const {
-        return components_;
-    }
+    /// Get all components, in insertion order
+    const std::vector<std::unique_ptr<Component>>& getComponents() const { return components_; }
 
     // ========== Nets ==========
 
@@ -318,19 +329,29 @@ public:
     Net* getNet(const std::string& name);
     const Net* getNet(const std::string& name) const;
 
-    /// Add net
+    /// Get net by index into getNets()
+    Net* getNet(int index);
+    const Net* getNet(int index) const;
+
+    /// Index of a net in getNets() (-1 if absent)
+    int getNetIndex(const std::string& name) const;
+
+    /// Add net (replaces one with the same name in place)
     void addNet(std::unique_ptr<Net> net);
 
-    /// Get all net names
+    /// Get all net names, in insertion order
     std::vector<std::string> getNetNames() const;
 
     /// Get net count
     size_t getNetCount() const { return nets_.size(); }
 
-    /// Get all nets
-    const std::unordered_map<std::string, std::unique_ptr<Net>>& getNets() const {
-        return nets_;
-    }
+    /// Get all nets, in insertion order
+    const std::vector<std::unique_ptr<Net>>& getNets() const { return nets_; }
+
+    // ========== Interned Names ==========
+
+    /// Reference designators and net names with their 32-bit IDs
+    const StringTable& getNameTable() const { return names_; }
 
     // ========== Packages ==========
 
@@ -428,9 +449,18 @@ public:
     /// Get net/subnet for a feature
     std::pair<int, int> getFeatureNetSubnet(const FeatureId& fid) const;
 
+    /// Get all feature ID records, in file order
+    const std::vector<FeatureIdRecord>& getFeatureIdRecords() const { return featureIdRecords_; }
+
 private:
-    std::unordered_map<std::string, std::unique_ptr<Component>> components_;
-    std::unordered_map<std::string, std::unique_ptr<Net>> nets_;
+    /// Index into components_/nets_ by name ID + 1 (slot 0 is the empty name), -1 if none
+    static int slotOf(const std::vector<int32_t>& slots, int32_t nameId);
+
+    StringTable names_;
+    std::vector<std::unique_ptr<Component>> components_;
+    std::vector<int32_t> componentSlots_;
+    std::vector<std::unique_ptr<Net>> nets_;
+    std::vector<int32_t> netSlots_;
     std::vector<std::unique_ptr<Package>> packages_;
     std::unordered_map<std::string, size_t> packageNameToIndex_;
 
@@ -442,8 +472,8 @@ private:
     std::vector<BomItem> bomItems_;
     std::unordered_map<std::string, size_t> bomRefDesIndex_;
 
-    // Subnets (stored per net)
-    std::unordered_map<std::string, std::vector<Subnet>> netSubnets_;
+    // Subnets (stored per net name ID)
+    std::unordered_map<int32_t, std::vector<Subnet>> netSubnets_;
 
     // Feature groups
     std::vector<FeatureGroup> featureGroups_;
@@ -8,6 +8,8 @@
 
 namespace koo::ecad {
 
+class SymbolCache;
+
 /**
  * @brief Base class for all ODB++ features
  *
@@ -33,6 +35,9 @@ public:
     /// Clone this feature (Prototype pattern)
     virtual std::unique_ptr<Feature> clone() const = 0;
 
+    /// Move this feature by a placement transform (step-repeat instancing)
+    virtual void transform(const Transform2D& t) = 0;
+
     /// Get unique identifier
     const std::string& getId() const { return id_; }
     void setId(const std::string& id) { id_ = id; }
@@ -85,6 +90,7 @@ public:
     FeatureType getType() const override { return FeatureType::Line; }
     BoundingBox2D getBoundingBox() const override;
     std::unique_ptr<Feature> clone() const override;
+    void transform(const Transform2D& t) override;
 
     /// Start point
     Point2D getStart() const { return {xs_, ys_}; }
@@ -132,6 +138,10 @@ public:
     FeatureType getType() const override { return FeatureType::Pad; }
     BoundingBox2D getBoundingBox() const override;
     std::unique_ptr<Feature> clone() const override;
+    void transform(const Transform2D& t) override;
+
+    /// Box of the placed symbol outline (the position alone for unknown symbols)
+    BoundingBox2D getBoundingBox(const SymbolCache& symbols, const std::string& layerUnits) const;
 
     /// Position
     Point2D getPosition() const { return {x_, y_}; }
@@ -188,6 +198,7 @@ public:
     FeatureType getType() const override { return FeatureType::Arc; }
     BoundingBox2D getBoundingBox() const override;
     std::unique_ptr<Feature> clone() const override;
+    void transform(const Transform2D& t) override;
 
     /// Start point
     Point2D getStart() const { return {xs_, ys_}; }
@@ -295,6 +306,9 @@ public:
     /// Check if point is inside
     bool contains(double x, double y) const;
 
+    /// Move by a placement transform (arcs flip direction when mirrored)
+    void transform(const Transform2D& t);
+
 private:
     double startX_ = 0.0, startY_ = 0.0;
     PolygonType polygonType_ = PolygonType::Island;
@@ -322,6 +336,7 @@ public:
     FeatureType getType() const override { return FeatureType::Surface; }
     BoundingBox2D getBoundingBox() const override;
     std::unique_ptr<Feature> clone() const override;
+    void transform(const Transform2D& t) override;
 
     /// Add contour
     void addContour(const Contour& contour);
@@ -366,6 +381,7 @@ public:
     FeatureType getType() const override { return FeatureType::Text; }
     BoundingBox2D getBoundingBox() const override;
     std::unique_ptr<Feature> clone() const override;
+    void transform(const Transform2D& t) override;
 
     /// Position
     Point2D getPosition() const { return {x_, y_}; }
@@ -428,6 +444,7 @@ public:
     FeatureType getType() const override { return FeatureType::Barcode; }
     BoundingBox2D getBoundingBox() const override;
     std::unique_ptr<Feature> clone() const override;
+    void transform(const Transform2D& t) override;
 
     /// Position
     Point2D getPosition() const { return {x_, y_}; }
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <koo/ecad/Feature.hpp>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace koo::ecad {
+
+struct SymbolGeometry;
+
+/**
+ * @brief Interned string table (string <-> 32-bit index)
+ *
+ * The empty string is never stored; it maps to index -1.
+ */
+class KOO_API StringTable {
+public:
+    StringTable() = default;
+
+    /// Index of a string, adding it if new (-1 for the empty string)
+    int32_t intern(const std::string& str);
+
+    /// Index of a string, or -1 if not present
+    int32_t find(const std::string& str) const;
+
+    /// String at index (empty for -1 or out of range)
+    const std::string& get(int32_t index) const;
+
+    /// All strings in index order
+    const std::vector<std::string>& getStrings() const { return strings_; }
+
+    size_t size() const { return strings_.size(); }
+    void clear();
+
+private:
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, int32_t> index_;
+};
+
+class FeatureStore;
+
+/**
+ * @brief Read-only view of one feature in a FeatureStore
+ *
+ * Cheap to copy; valid until the store is modified. Geometry getters only
+ * return meaningful values for the matching feature type, as on the
+ * corresponding Feature subclass.
+ */
+class KOO_API FeatureView {
+public:
+    FeatureView(const FeatureStore& store, size_t index) : store_(&store), index_(index) {}
+
+    /// Position in the owning store
+    size_t getIndex() const { return index_; }
+
+    FeatureType getType() const;
+    Polarity getPolarity() const;
+    int getDcode() const;
+    const std::string& getId() const;
+    const std::string& getNetName() const;
+    std::string getAttribute(const std::string& key) const;
+
+    /// Symbol name and store symbol index (Line, Pad and Arc)
+    const std::string& getSymbolName() const;
+    int32_t getSymbolIndex() const;
+
+    /// Start/end point (Line, Arc)
+    Point2D getStart() const;
+    Point2D getEnd() const;
+
+    /// Arc center and direction
+    Point2D getCenter() const;
+    bool isClockwise() const;
+
+    /// Pad position and orientation
+    Point2D getPosition() const;
+    double getRotation() const;
+    bool isMirrored() const;
+    double getResizeFactor() const;
+    bool hasResize() const;
+
+    /// Backing object for Surface, Text and Barcode features (nullptr otherwise)
+    const Feature* getObject() const;
+
+    /// Bounding box, as Feature::getBoundingBox()
+    BoundingBox2D getBoundingBox() const;
+
+    /// Build a standalone Feature object with the same contents
+    std::unique_ptr<Feature> materialize() const;
+
+private:
+    const FeatureStore* store_;
+    size_t index_;
+};
+
+/**
+ * @brief Columnar feature storage for a layer
+ *
+ * Lines, pads and arcs live in per-type coordinate columns with symbol and
+ * net names held as indices into interned tables; IDs and attributes, which
+ * most features lack, go into sparse side tables. Surfaces, text and
+ * barcodes keep their Feature object. Per-feature columns (type, row in the
+ * per-type table, polarity, dcode, net) preserve insertion order.
+ *
+ * Features are read through FeatureView; materialize() builds a Feature
+ * object on demand.
+ *
+ * Usage:
+ *   for (const auto& feature : layer.getFeatures()) {
+ *       if (feature.getType() == FeatureType::Line) { ... }
+ *   }
+ */
+class KOO_API FeatureStore {
+public:
+    /// Line columns (L records)
+    struct LineColumns {
+        std::vector<double> xs, ys, xe, ye;
+        std::vector<int32_t> symbol;
+    };
+
+    /// Pad columns (P records)
+    struct PadColumns {
+        std::vector<double> x, y;
+        std::vector<double> rotation;
+        std::vector<double> resize;
+        std::vector<int32_t> symbol;
+        std::vector<uint8_t> flags;     ///< PadMirror | PadResize
+    };
+
+    /// Arc columns (A records)
+    struct ArcColumns {
+        std::vector<double> xs, ys, xe, ye, xc, yc;
+        std::vector<int32_t> symbol;
+        std::vector<uint8_t> clockwise;
+    };
+
+    static constexpr uint8_t PadMirror = 1;
+    static constexpr uint8_t PadResize = 2;
+
+    /// Forward iterator yielding FeatureView
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FeatureView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = FeatureView;
+
+        Iterator(const FeatureStore* store, size_t index) : store_(store), index_(index) {}
+        FeatureView operator*() const { return FeatureView(*store_, index_); }
+        Iterator& operator++() { ++index_; return *this; }
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const FeatureStore* store_;
+        size_t index_;
+    };
+
+    FeatureStore() = default;
+    FeatureStore(FeatureStore&&) noexcept = default;
+    FeatureStore& operator=(FeatureStore&&) noexcept = default;
+
+    // ========== Size / Iteration ==========
+
+    size_t size() const { return types_.size(); }
+    bool empty() const { return types_.empty(); }
+
+    /// Approximate heap bytes held by the columns, side tables, objects and strings
+    size_t getMemoryUsage() const;
+
+    FeatureView operator[](size_t index) const { return FeatureView(*this, index); }
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, size()); }
+
+    // ========== Adding / Removing ==========
+
+    /// Add a feature object; lines, pads and arcs are split into columns
+    size_t add(std::unique_ptr<Feature> feature);
+
+    /// Append a line (symbol is an index into getSymbols(), -1 for none)
+    size_t addLine(double xs, double ys, double xe, double ye, int32_t symbol,
+                   Polarity polarity = Polarity::Positive, int dcode = 0);
+
+    /// Append a pad
+    size_t addPad(double x, double y, int32_t symbol,
+                  Polarity polarity = Polarity::Positive, int dcode = 0,
+                  double rotation = 0.0, bool mirror = false,
+                  bool hasResize = false, double resizeFactor = 0.0);
+
+    /// Append an arc
+    size_t addArc(double xs, double ys, double xe, double ye, double xc, double yc,
+                  int32_t symbol, bool clockwise,
+                  Polarity polarity = Polarity::Positive, int dcode = 0);
+
+    /**
+     * @brief Append one transformed copy of another store per transform
+     *
+     * Copies follow each other in transform order, each in source order.
+     * Columns are sized once and filled in parallel (0 = hardware concurrency).
+     */
+    void appendInstances(const FeatureStore& source, const std::vector<Transform2D>& transforms,
+                         size_t threads = 0);
+
+    /// Remove the feature at index (later features shift down)
+    void remove(size_t index);
+
+    /// Remove all features and clear the string tables
+    void clear();
+
+    // ========== Per-Feature Columns ==========
+
+    FeatureType getType(size_t index) const { return static_cast<FeatureType>(types_[index]); }
+    Polarity getPolarity(size_t index) const { return static_cast<Polarity>(polarity_[index]); }
+    int getDcode(size_t index) const { return dcode_[index]; }
+
+    /// Row in the per-type columns (or in the object list)
+    uint32_t getRow(size_t index) const { return rows_[index]; }
+
+    /// Net index into getNets() (-1 for none)
+    int32_t getNet(size_t index) const { return net_[index]; }
+
+    const std::string& getId(size_t index) const;
+    const AttributeList& getAttributes(size_t index) const;
+
+    void setNetName(size_t index, const std::string& netName);
+    void setId(size_t index, const std::string& id);
+    void setAttribute(size_t index, const std::string& key, const std::string& value);
+
+    // ========== Typed Columns ==========
+
+    const LineColumns& getLines() const { return lines_; }
+    const PadColumns& getPads() const { return pads_; }
+    const ArcColumns& getArcs() const { return arcs_; }
+
+    /// Surface, Text or Barcode object by row
+    const Feature* getObject(uint32_t row) const { return objects_[row].get(); }
+
+    // ========== String Tables ==========
+
+    StringTable& getSymbols() { return symbols_; }
+    const StringTable& getSymbols() const { return symbols_; }
+
+    StringTable& getNets() { return nets_; }
+    const StringTable& getNets() const { return nets_; }
+
+    // ========== Geometry ==========
+
+    /// Bounding box of one feature
+    BoundingBox2D getBoundingBox(size_t index) const;
+
+    /// Bounding box of all features
+    BoundingBox2D getBoundingBox() const;
+
+    /// Bounding box of every feature, computed in parallel (0 = hardware concurrency)
+    std::vector<BoundingBox2D> getBoundingBoxes(size_t threads = 0) const;
+
+    /**
+     * @brief Copper extent of every feature, computed in parallel
+     * @param symbols Geometry of each symbol table entry (see SymbolCache::resolve)
+     * @param boxes Filled with one box per feature; its storage is reused
+     * @param threads Worker threads (0 = hardware concurrency)
+     *
+     * Pads place their symbol outline with rotation, mirror and resize;
+     * lines and arcs grow by their symbol's extent. Features with unknown
+     * symbols keep their centerline box.
+     */
+    void computeExtents(const std::vector<const SymbolGeometry*>& symbols,
+                        std::vector<BoundingBox2D>& boxes, size_t threads = 0) const;
+
+private:
+    friend class OdbCache;  // Stores and restores the columns in bulk
+
+    size_t push(FeatureType type, size_t row, Polarity polarity, int dcode, int32_t net);
+
+    // Per-feature columns, in insertion order
+    std::vector<uint8_t> types_;
+    std::vector<uint32_t> rows_;
+    std::vector<uint8_t> polarity_;
+    std::vector<int32_t> dcode_;
+    std::vector<int32_t> net_;
+
+    LineColumns lines_;
+    PadColumns pads_;
+    ArcColumns arcs_;
+    std::vector<std::unique_ptr<Feature>> objects_;
+
+    // Sparse side tables for line/pad/arc features, keyed by feature index
+    std::unordered_map<size_t, std::string> ids_;
+    std::unordered_map<size_t, AttributeList> attributes_;
+
+    StringTable symbols_;
+    StringTable nets_;
+};
+
+} // namespace koo::ecad
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace koo::ecad {
+
+class Layer;
+class OdbJob;
+class SymbolLibrary;
+
+/**
+ * @brief Differences between two revisions of an ODB++ job
+ *
+ * Steps and layers are matched by name. Every feature gets two 64-bit
+ * content hashes, computed in parallel: a placement hash over everything
+ * (type, polarity, dcode, symbol and net names, attributes and geometry,
+ * with coordinates snapped to the tolerance grid) and a shape hash that
+ * leaves out where the feature sits. A layer's hash sums its placement
+ * hashes, so it does not depend on feature order; equal hashes mean an
+ * unchanged layer and nothing more is done for it.
+ *
+ * Changed layers are matched feature by feature: equal placement hashes
+ * are unchanged features, leftovers with equal shape hashes are moves, and
+ * the rest are removed (old layer) or added (new layer). Feature IDs are
+ * not compared, as they are renumbered between exports.
+ *
+ * User symbols are hashed from their features the same way, and a feature
+ * that places a user symbol mixes in that symbol's hash, so editing a
+ * symbol changes every layer that uses it; the symbols themselves are
+ * compared by name as well.
+ *
+ * Components (by reference designator), nets (by name; subnets count by
+ * type and size only, since they list feature IDs), the step profile, the
+ * stackup and the layer matrix are compared too. Hashes are stable
+ * across runs and platforms, so they can be stored and compared later.
+ *
+ * Usage:
+ *   JobDiff diff(oldJob, newJob);
+ *   auto result = diff.compare();
+ *   for (const auto& step : result.steps) {
+ *       for (const auto& name : step.getChangedLayers()) remesh(step.name, name);
+ *   }
+ */
+class KOO_API JobDiff {
+public:
+    /**
+     * @brief How an item differs between the revisions
+     */
+    enum class ChangeType {
+        Unchanged,
+        Added,          ///< Only in the new job
+        Removed,        ///< Only in the old job
+        Changed
+    };
+
+    /**
+     * @brief Comparison options
+     */
+    struct Options {
+        double tolerance = 1e-6;    ///< Coordinate grid for hashing (layer units)
+        bool matchMoves = true;     ///< Pair removed and added features of equal shape as moves
+        size_t threads = 0;         ///< Worker threads (0 = hardware concurrency)
+    };
+
+    /**
+     * @brief A feature that kept its shape but changed place
+     */
+    struct FeatureMove {
+        size_t before = 0;          ///< Index in the old layer
+        size_t after = 0;           ///< Index in the new layer
+        Point2D offset;             ///< Displacement of the feature anchor
+    };
+
+    /**
+     * @brief Differences of one layer
+     */
+    struct LayerDiff {
+        std::string name;
+        ChangeType change = ChangeType::Unchanged;
+        uint64_t hashBefore = 0;                ///< Content hash (0 if the layer is absent)
+        uint64_t hashAfter = 0;
+        std::vector<size_t> added;              ///< Feature indices in the new layer
+        std::vector<size_t> removed;            ///< Feature indices in the old layer
+        std::vector<FeatureMove> moved;         ///< By old index
+    };
+
+    /**
+     * @brief A named item (component, net, stackup or matrix layer) that differs
+     */
+    struct ItemDiff {
+        std::string name;
+        ChangeType change = ChangeType::Changed;
+    };
+
+    /**
+     * @brief Differences of one step
+     */
+    struct StepDiff {
+        std::string name;
+        ChangeType change = ChangeType::Unchanged;
+        std::vector<LayerDiff> layers;          ///< Every layer of either revision, by name
+        std::vector<ItemDiff> components;       ///< Differing components, by reference designator
+        std::vector<ItemDiff> nets;             ///< Differing nets, by name
+        bool profileChanged = false;
+
+        /// Names of the layers that are not unchanged
+        std::vector<std::string> getChangedLayers() const;
+    };
+
+    /**
+     * @brief Differences of the whole job
+     */
+    struct Result {
+        std::vector<StepDiff> steps;            ///< Every step of either revision, by name
+        std::vector<ItemDiff> symbols;          ///< Differing user symbols, by name
+        std::vector<ItemDiff> stackup;          ///< Differing stackup layers, by name
+        std::vector<ItemDiff> matrix;           ///< Differing matrix layer definitions, by name
+
+        /// Whether the revisions are the same
+        bool isIdentical() const;
+    };
+
+    /**
+     * @brief Construct for two revisions
+     * @param before Old revision (must outlive this object)
+     * @param after New revision (must outlive this object)
+     */
+    JobDiff(const OdbJob& before, const OdbJob& after);
+
+    /**
+     * @brief Compare the revisions
+     *
+     * The result does not depend on the thread count.
+     */
+    Result compare(const Options& options) const;
+
+    /**
+     * @brief Compare with default options
+     */
+    Result compare() const { return compare(Options()); }
+
+    /**
+     * @brief Order-invariant content hash of a layer (units and attributes included)
+     * @param layer Layer to hash
+     * @param tolerance Coordinate grid (layer units)
+     * @param threads Worker threads (0 = hardware concurrency)
+     * @param symbols User symbols to mix into the features placing them (nullptr: names only)
+     */
+    static uint64_t hashLayer(const Layer& layer, double tolerance, size_t threads = 0,
+                              const SymbolLibrary* symbols = nullptr);
+
+private:
+    const OdbJob& before_;
+    const OdbJob& after_;
+};
+
+} // namespace koo::ecad
@@ -3,7 +3,11 @@
 #include <koo/Export.hpp>
 #include <koo/ecad/Types.hpp>
 #include <koo/ecad/Feature.hpp>
+#include <koo/ecad/FeatureStore.hpp>
+#include <koo/ecad/LayerCache.hpp>
+#include <koo/ecad/SpatialIndex.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -21,8 +25,8 @@ struct LayerDefinition {
     Polarity polarity = Polarity::Positive;
     Side side = Side::None;
     int row = 0;                    ///< Row number in matrix
-    int startName = 0;              ///< Start drill name (for drill layers)
-    int endName = 0;                ///< End drill name (for drill layers)
+    std::string startName;          ///< First layer a drill spans (matrix START_NAME, empty = unset)
+    std::string endName;            ///< Last layer a drill spans (matrix END_NAME, empty = unset)
     double thickness = 0.0;         ///< Layer thickness (for copper)
     std::string oldName;            ///< Original name before renaming
 };
@@ -37,12 +41,15 @@ struct LayerDefinition {
  *   - profile - layer outline (optional)
  *   - components - component data (for component layers)
  *   - tools - drill tools (for drill layers)
+ *
+ * A layer attached to a LayerCache is a proxy whose features, units and
+ * symbol names are loaded on first access (see LayerCache).
  */
 class KOO_API Layer {
 public:
     Layer() = default;
     explicit Layer(const std::string& name);
-    virtual ~Layer() = default;
+    virtual ~Layer();
 
     /// Layer name
     const std::string& getName() const { return name_; }
@@ -70,12 +77,29 @@ public:
 
     // ========== Features ==========
 
-    /// Get all features
-    const std::vector<std::unique_ptr<Feature>>& getFeatures() const { return features_; }
-    std::vector<std::unique_ptr<Feature>>& getFeatures() { return features_; }
+    /// Get all features (columnar storage, iterated as FeatureView)
+    const FeatureStore& getFeatures() const {
+        if (cacheEntry_) loadFeatures();
+        return features_;
+    }
+
+    /// Mutable features; a cached proxy is loaded and leaves its cache
+    FeatureStore& getFeatures() {
+        if (cacheEntry_) detachFromCache();
+        return features_;
+    }
 
     /// Get feature count
-    size_t getFeatureCount() const { return features_.size(); }
+    size_t getFeatureCount() const { return getFeatures().size(); }
+
+    /// Whether the features are in memory (false only for an evicted or unloaded proxy)
+    bool isResident() const;
+
+    /// Whether the layer is a proxy backed by a LayerCache
+    bool isCached() const { return cacheEntry_ != nullptr; }
+
+    /// Load a cached proxy and keep it resident while the pin lives (empty pin otherwise)
+    LayerCache::Pin pin() const;
 
     /// Add feature
     void addFeature(std::unique_ptr<Feature> feature);
@@ -86,21 +110,61 @@ public:
     /// Clear all features
     void clearFeatures();
 
-    /// Get feature by index
-    Feature* getFeature(size_t index);
-    const Feature* getFeature(size_t index) const;
+    /// Get a copy of the feature at index (nullptr if out of range)
+    std::unique_ptr<Feature> getFeature(size_t index) const;
+
+    /// Find features by net name (feature indices, ascending)
+    std::vector<size_t> getFeaturesByNet(const std::string& netName) const;
+
+    // ========== Spatial Queries ==========
+
+    /// Find features whose bounding box overlaps an area (feature indices, ascending)
+    std::vector<size_t> getFeaturesInArea(const BoundingBox2D& area) const;
+
+    /// Find features whose bounding box contains a point
+    std::vector<size_t> getFeaturesAt(const Point2D& point) const;
+
+    /// Feature whose bounding box is closest to a point (SpatialIndex::npos if none)
+    size_t getNearestFeature(const Point2D& point, double* distance = nullptr) const;
+
+    /// Area queries run in parallel; result i answers areas[i]
+    std::vector<std::vector<size_t>> getFeaturesInAreas(const std::vector<BoundingBox2D>& areas,
+                                                        size_t threads = 0) const;
 
-    /// Find features by net name
-    std::vector<Feature*> getFeaturesByNet(const std::string& netName);
+    /**
+     * @brief R-tree over feature extents, built on first use
+     *
+     * Extents include the symbol (see getFeatureExtents()), so pads are
+     * found wherever their copper reaches. addFeature/removeFeature/
+     * clearFeatures drop it together with the net index; call
+     * invalidateIndex() after editing through getFeatures().
+     */
+    const SpatialIndex& getSpatialIndex() const;
 
-    /// Find features in area
-    std::vector<Feature*> getFeaturesInArea(const BoundingBox2D& area);
+    /// Copper extent of every feature (FeatureStore::computeExtents), built with the spatial index
+    const std::vector<BoundingBox2D>& getFeatureExtents() const;
+
+    /// Drop the cached spatial and net indices
+    void invalidateIndex();
+
+    /**
+     * @brief Symbol geometry used for the feature extents
+     *
+     * Set by the owning Step to its job's SymbolCache so user symbols are
+     * resolved; nullptr falls back to a private cache of standard symbols.
+     * The cache must outlive the layer.
+     */
+    const SymbolCache* getSymbolCache() const { return symbolCache_; }
+    void setSymbolCache(const SymbolCache* symbols);
 
     // ========== Bounding Box ==========
 
-    /// Get layer bounding box
+    /// Get layer bounding box (feature centerlines and pad centers)
     BoundingBox2D getBoundingBox() const;
 
+    /// Bounds of the feature extents, symbols included
+    BoundingBox2D getExtent() const;
+
     // ========== Attributes ==========
 
     /// Attributes
@@ -116,8 +180,11 @@ public:
     // ========== Units ==========
 
     /// Units (INCH or MM)
-    const std::string& getUnits() const { return units_; }
-    void setUnits(const std::string& u) { units_ = u; }
+    const std::string& getUnits() const {
+        if (cacheEntry_) loadMetadata();
+        return units_;
+    }
+    void setUnits(const std::string& u) { units_ = u; invalidateIndex(); }
 
     // ========== Profile ==========
 
@@ -129,7 +196,10 @@ public:
     // ========== Symbol Names ==========
 
     /// Symbol name table (index -> name mapping)
-    const std::vector<std::string>& getSymbolNames() const { return symbolNames_; }
+    const std::vector<std::string>& getSymbolNames() const {
+        if (cacheEntry_) loadMetadata();
+        return symbolNames_;
+    }
     void setSymbolNames(const std::vector<std::string>& names) { symbolNames_ = names; }
     void addSymbolName(const std::string& name);
     std::string getSymbolName(int index) const;
@@ -144,10 +214,34 @@ protected:
     int row_ = 0;
     std::string units_ = "MM";
 
-    std::vector<std::unique_ptr<Feature>> features_;
+    FeatureStore features_;
     AttributeList attributes_;
     std::vector<Contour> profile_;
     std::vector<std::string> symbolNames_;
+
+    /// Feature indices of net n: netFeatures_[netOffsets_[n] .. netOffsets_[n + 1])
+    const uint32_t* netFeatures(int32_t net, size_t& count) const;
+
+    mutable std::mutex indexMutex_;
+    mutable std::unique_ptr<SpatialIndex> spatialIndex_;
+    mutable std::vector<BoundingBox2D> extents_;
+    mutable std::vector<uint32_t> netOffsets_;
+    mutable std::vector<uint32_t> netFeatures_;
+    const SymbolCache* symbolCache_ = nullptr;
+
+private:
+    friend class LayerCache;
+
+    /// Load a cached proxy's features and mark them used
+    void loadFeatures() const;
+
+    /// Load a cached proxy once so units and symbol names are known
+    void loadMetadata() const;
+
+    /// Load a cached proxy and leave the cache
+    void detachFromCache();
+
+    LayerCacheEntry* cacheEntry_ = nullptr;
 };
 
 // ============================================================================
@@ -172,11 +266,11 @@ public:
     double getThickness() const { return thickness_; }
     void setThickness(double t) { thickness_ = t; }
 
-    /// Get traces (line features) on specific net
-    std::vector<LineFeature*> getTracesOnNet(const std::string& netName);
+    /// Get traces (line features) on specific net (feature indices)
+    std::vector<size_t> getTracesOnNet(const std::string& netName) const;
 
-    /// Get pads on specific net
-    std::vector<PadFeature*> getPadsOnNet(const std::string& netName);
+    /// Get pads on specific net (feature indices)
+    std::vector<size_t> getPadsOnNet(const std::string& netName) const;
 
 private:
     int layerNumber_ = 1;
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+
+namespace koo::ecad {
+
+class Layer;
+class LayerCache;
+
+/**
+ * @brief Cache bookkeeping of one lazily loaded layer (owned by LayerCache)
+ */
+struct LayerCacheEntry {
+    LayerCache* cache = nullptr;
+    Layer* layer = nullptr;
+    std::string source;                     ///< Passed to the loader
+    std::atomic<bool> resident{false};      ///< Features are in memory
+    std::atomic<uint64_t> lastUse{0};       ///< Access tick for LRU eviction
+    size_t bytes = 0;                       ///< Feature storage while resident
+    size_t pins = 0;
+    std::atomic<bool> loaded{false};        ///< Loaded at least once (units and symbol names known)
+};
+
+/**
+ * @brief Bounded cache of layer features loaded on first access
+ *
+ * Attached layers are proxies: their metadata (name, type, attributes) is
+ * set up front, while features, units and symbol names are parsed by the
+ * loader the first time they are read. When the resident feature storage
+ * exceeds the byte budget, the least recently used layers drop their
+ * features (and spatial/net indices) and reload them on next access. Units
+ * and symbol names survive eviction.
+ *
+ * A feature reference taken from Layer::getFeatures() stays valid until the
+ * layer is evicted, which happens whenever another layer loads, on any
+ * thread. Code that keeps a reference across other layers' loads, or reads
+ * while other threads load, holds a Pin (Layer::pin()) for as long as it
+ * uses the features; the writer, diff, connectivity and clearance passes do.
+ * Loads are serialized; reading resident layers takes no lock.
+ *
+ * Non-const feature access (Layer::getFeatures(), addFeature, ...) loads the
+ * layer and takes it out of the cache for good, since edits cannot be
+ * reloaded from the source.
+ *
+ * Usage:
+ *   OdbReader::Options options;
+ *   options.lazyFeatures = true;
+ *   options.featureCacheBytes = 256 << 20;
+ *   OdbJob job = reader.read(path, options);                 // metadata only
+ *   const Layer* top = job.getStep("pcb")->getLayer("top");
+ *   for (const auto& feature : top->getFeatures()) { ... }  // parsed here
+ */
+class KOO_API LayerCache {
+public:
+    /// Parses the features of source into a fresh layer
+    using Loader = std::function<void(const std::string& source, Layer& layer)>;
+
+    /**
+     * @brief Cache counters
+     */
+    struct Statistics {
+        size_t layers = 0;              ///< Attached layers
+        size_t residentLayers = 0;
+        size_t residentBytes = 0;
+        size_t loads = 0;               ///< Loads, reloads included
+        size_t evictions = 0;
+    };
+
+    /**
+     * @brief Keeps a layer resident while alive (must not outlive the layer)
+     */
+    class KOO_API Pin {
+    public:
+        Pin() = default;
+        ~Pin();
+        Pin(Pin&& other) noexcept : entry_(other.entry_) { other.entry_ = nullptr; }
+        Pin& operator=(Pin&& other) noexcept;
+        Pin(const Pin&) = delete;
+        Pin& operator=(const Pin&) = delete;
+
+    private:
+        friend class LayerCache;
+        explicit Pin(LayerCacheEntry* entry) : entry_(entry) {}
+        LayerCacheEntry* entry_ = nullptr;
+    };
+
+    /**
+     * @brief Construct with a loader
+     * @param loader Called (serialized) to parse a layer's features
+     * @param byteBudget Resident feature storage limit (0 = unlimited)
+     */
+    LayerCache(Loader loader, size_t byteBudget);
+
+    /// Detaches every remaining layer, keeping whatever is resident
+    ~LayerCache();
+
+    LayerCache(const LayerCache&) = delete;
+    LayerCache& operator=(const LayerCache&) = delete;
+
+    /**
+     * @brief Make a layer a proxy loaded from source
+     *
+     * The layer must have no features; it detaches itself when destroyed.
+     */
+    void attach(Layer& layer, const std::string& source);
+
+    /// Resident feature storage limit (0 = unlimited)
+    size_t getByteBudget() const;
+
+    /// Change the budget, evicting down to it
+    void setByteBudget(size_t bytes);
+
+    /**
+     * @brief Load a layer and keep it resident until the pin is released
+     *
+     * Layers not attached to this cache get an empty pin.
+     */
+    Pin pin(const Layer& layer);
+
+    /// Drop the features of every unpinned layer
+    void evictAll();
+
+    /// Current counters
+    Statistics getStatistics() const;
+
+private:
+    friend class Layer;
+
+    /// Load the entry's layer if needed and mark it used
+    void acquire(LayerCacheEntry& entry);
+
+    /// Remove a layer from the cache, loading it first if load is set
+    void detach(LayerCacheEntry& entry, bool load);
+
+    /// Parse the entry's layer if it is not resident (lock held)
+    void loadLocked(LayerCacheEntry& entry);
+
+    /// Evict least recently used layers other than keep until within budget (lock held)
+    void evictLocked(const LayerCacheEntry* keep);
+
+    /// Drop one entry's features (lock held)
+    void dropLocked(LayerCacheEntry& entry);
+
+    Loader loader_;
+    size_t byteBudget_ = 0;
+    size_t residentBytes_ = 0;
+    size_t loads_ = 0;
+    size_t evictions_ = 0;
+    std::atomic<uint64_t> clock_{0};
+    std::list<LayerCacheEntry> entries_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace koo::ecad
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace koo::ecad {
+
+class LayerMatrix;
+class Step;
+class SymbolCache;
+
+/**
+ * @brief Electrical connectivity extracted from copper and drill geometry
+ *
+ * Copper layers (signal, power/ground, mixed) are taken from the layer
+ * matrix in row order; drill layers connect every copper layer whose row
+ * lies between the rows of the matrix layers named by their START_NAME and
+ * END_NAME (through all copper when unset or unknown). Layers missing from
+ * the matrix fall back to their own type and, for a DrillLayer, its 1-based
+ * start/end copper layer when those differ. Non-plated
+ * DrillLayer holes connect nothing.
+ *
+ * Within a layer, each feature is queried against a packed R-tree of its
+ * neighbours and exact contact is tested on the feature shapes: lines and
+ * arcs as round-ended tracks of their symbol width, round and oblong pads as
+ * discs and slots, other pads as their rotated symbol box, and surfaces as
+ * their contours filled even-odd, so holes cut their islands. Drill hits are joined to
+ * the copper they overlap on each spanned layer. Queries run in parallel and
+ * contacts are merged as they are found by a lock-free union-find, so no
+ * contact list is ever stored: beyond the R-trees, each feature costs one
+ * parent word and one component word.
+ *
+ * Negative-polarity features, text and barcodes carry no current and belong
+ * to no connected component. A negative feature clears the copper drawn
+ * before it: a contact whose point lies under a later negative feature on
+ * either layer does not count. Contacts are tested at one point, so a
+ * negative feature that splits a single track does not split its component.
+ *
+ * The extracted components are then checked against the netlist: the EDA
+ * FID records (or the feature net names when a feature has none) assign
+ * features to nets. A net split over several components is an open; a
+ * component holding features of several nets is a short.
+ *
+ * Usage:
+ *   NetConnectivity connectivity(step, job.getMatrix());
+ *   auto result = connectivity.extract();
+ *   for (const auto& issue : result.issues) {
+ *       std::cout << NetConnectivity::formatIssue(issue) << "\n";
+ *   }
+ */
+class KOO_API NetConnectivity {
+public:
+    /// Component id of features that do not conduct
+    static constexpr uint32_t kNoComponent = static_cast<uint32_t>(-1);
+
+    /**
+     * @brief Kind of netlist issue
+     */
+    enum class IssueType {
+        Open,
+        Short
+    };
+
+    /**
+     * @brief One netlist issue
+     */
+    struct Issue {
+        IssueType type = IssueType::Open;
+        std::vector<std::string> nets;          ///< Open: the split net; Short: the merged nets, sorted
+        std::vector<uint32_t> components;       ///< Open: the net's components; Short: the shorted component
+    };
+
+    /**
+     * @brief Extraction options
+     */
+    struct Options {
+        size_t threads = 0;         ///< Worker threads (0 = hardware concurrency)
+        double tolerance = 0.0;     ///< Extra gap still treated as contact (layer units)
+        bool checkNetlist = true;   ///< Report opens and shorts against the EDA nets
+        const SymbolCache* symbols = nullptr;   ///< Shared symbol geometry (nullptr = each layer's, else a private cache)
+    };
+
+    /**
+     * @brief Extraction result
+     *
+     * Features are numbered globally: layer k owns
+     * [layerOffsets[k], layerOffsets[k + 1]).
+     */
+    struct Result {
+        std::vector<std::string> layers;        ///< Copper layers in stack order, then drill layers
+        std::vector<size_t> layerOffsets;       ///< First global feature of each layer, plus an end sentinel
+        std::vector<uint32_t> components;       ///< Component per global feature (kNoComponent if not conducting)
+        size_t componentCount = 0;              ///< Components, numbered by their first feature
+        size_t contactCount = 0;                ///< Feature pairs found in contact
+
+        std::vector<Issue> issues;              ///< Opens by net name, then shorts by component
+        size_t openCount = 0;
+        size_t shortCount = 0;
+
+        bool ok() const { return openCount == 0 && shortCount == 0; }
+
+        /// Component of a feature by layer name and feature index (kNoComponent if unknown)
+        uint32_t getComponent(const std::string& layer, size_t feature) const;
+    };
+
+    /**
+     * @brief Construct for a step
+     * @param step Step whose layers and EDA data are used (must outlive this object)
+     * @param matrix Job layer matrix (layer types, order and drill spans)
+     */
+    NetConnectivity(const Step& step, const LayerMatrix& matrix);
+
+    /**
+     * @brief Extract connectivity and check it against the netlist
+     *
+     * The result does not depend on the thread count.
+     */
+    Result extract(const Options& options) const;
+
+    /**
+     * @brief Extract with default options
+     */
+    Result extract() const { return extract(Options()); }
+
+    /**
+     * @brief Format an issue as a one-line message
+     */
+    static std::string formatIssue(const Issue& issue);
+
+private:
+    const Step& step_;
+    const LayerMatrix& matrix_;
+};
+
+} // namespace koo::ecad
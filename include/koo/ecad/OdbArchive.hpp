@@ -0,0 +1,146 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+struct gzFile_s;
+
+namespace koo::ecad {
+
+/**
+ * @brief Read-only view of an ODB++ job packed as .tgz / .tar.gz / .tar
+ *
+ * The archive is streamed once on open() and every member is indexed by its
+ * path relative to the job root (the directory that contains matrix/matrix,
+ * so "job/steps/pcb/stephdr" is looked up as "steps/pcb/stephdr").
+ * Members of a gzip-compressed archive are kept in memory; members of a
+ * plain .tar are read on demand from their recorded offsets.
+ *
+ * Lookups and reads are const and safe to call from several threads.
+ *
+ * Usage:
+ *   OdbArchive archive;
+ *   if (archive.open("design.tgz")) {
+ *       std::string matrix;
+ *       archive.read("matrix/matrix", matrix);
+ *   }
+ */
+class KOO_API OdbArchive {
+public:
+    OdbArchive() = default;
+
+    /// Check whether a path names a supported archive (by extension)
+    static bool isArchivePath(const std::filesystem::path& path);
+
+    /// Archive file name without its archive extension ("job.tgz" -> "job")
+    static std::string archiveStem(const std::filesystem::path& path);
+
+    /// Open and index an archive; returns false and sets the last error on failure
+    bool open(const std::filesystem::path& archivePath);
+
+    /// Source archive path
+    const std::filesystem::path& getPath() const { return path_; }
+
+    /// Job name: the job root directory, or the archive stem if members are not nested
+    const std::string& getJobName() const { return jobName_; }
+
+    // ========== Lookup ==========
+
+    /// Check whether a file or directory exists (path relative to the job root)
+    bool exists(const std::string& path) const;
+
+    /// Check whether a path is a directory
+    bool isDirectory(const std::string& path) const;
+
+    /// Names of the immediate subdirectories of a directory, sorted
+    std::vector<std::string> listDirectories(const std::string& path) const;
+
+    /// Read a member's bytes; returns false if it is not a regular file
+    bool read(const std::string& path, std::string& content) const;
+
+    /// Number of indexed files
+    size_t getFileCount() const;
+
+    /// Get last error message
+    const std::string& getLastError() const { return lastError_; }
+
+private:
+    /// Index entry for one member
+    struct Entry {
+        uint64_t offset = 0;    ///< Offset into data_ (gzip) or the file (plain tar)
+        uint64_t size = 0;
+        bool directory = false;
+    };
+
+    void addEntry(std::string path, const Entry& entry);
+
+    std::filesystem::path path_;
+    std::string jobName_;
+    std::map<std::string, Entry> entries_;
+    std::string data_;          ///< Member contents of a gzip-compressed archive
+    bool inMemory_ = false;
+    std::string lastError_;
+};
+
+/**
+ * @brief Streaming writer for .tgz / .tar.gz / .tar ODB++ archives
+ *
+ * Members are appended in the order they are added; nothing touches the
+ * disk except the archive itself. All member paths are placed under a
+ * single top-level directory, as ODB++ tools expect.
+ *
+ * Usage:
+ *   OdbArchiveWriter tar;
+ *   tar.open("design.tgz", "design");
+ *   tar.addDirectory("matrix");
+ *   tar.addFile("matrix/matrix", content);
+ *   tar.close();
+ */
+class KOO_API OdbArchiveWriter {
+public:
+    OdbArchiveWriter() = default;
+    ~OdbArchiveWriter();
+
+    OdbArchiveWriter(const OdbArchiveWriter&) = delete;
+    OdbArchiveWriter& operator=(const OdbArchiveWriter&) = delete;
+
+    /**
+     * @brief Create the archive
+     * @param archivePath Output path (.tar is written uncompressed)
+     * @param rootName Top-level directory for all members
+     * @param compressionLevel gzip level (1-9)
+     */
+    bool open(const std::filesystem::path& archivePath, const std::string& rootName,
+              int compressionLevel = 6);
+
+    /// Append a directory (path relative to the root); repeated calls are ignored
+    bool addDirectory(const std::string& path);
+
+    /// Append a regular file (parent directories are added as needed)
+    bool addFile(const std::string& path, const std::string& content);
+
+    /// Write the end-of-archive marker and close the file
+    bool close();
+
+    /// Check whether the archive is open
+    bool isOpen() const { return file_ != nullptr; }
+
+    /// Get last error message
+    const std::string& getLastError() const { return lastError_; }
+
+private:
+    bool writeHeader(const std::string& name, uint64_t size, char type);
+    bool writeBytes(const char* data, size_t size);
+
+    gzFile_s* file_ = nullptr;
+    std::string root_;
+    std::set<std::string> directories_;
+    std::string lastError_;
+};
+
+} // namespace koo::ecad
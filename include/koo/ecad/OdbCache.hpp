@@ -0,0 +1,93 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace koo::ecad {
+
+class FeatureStore;
+class OdbJob;
+
+/**
+ * @brief Versioned binary snapshot of a parsed ODB++ job
+ *
+ * Holds what is expensive to parse: the matrix, job info and attributes,
+ * user symbols, every step (header, profile, layers with their feature
+ * columns, EDA data, zones, dimensions) and the stackup. Feature columns
+ * are stored as raw little-endian arrays aligned to 8 bytes, so loading
+ * reads the file in one pass and copies each column with a single memcpy.
+ * The small misc/ files (impedance, tools, variants, ...) are not cached;
+ * OdbReader parses them from the source after a cache load.
+ *
+ * A cache is tied to its source through a key (see sourceKey()) written in
+ * the header; read() rejects files with another key, another format
+ * version, another byte order or missing data. write() goes through a
+ * temporary file, so readers never see a partial cache.
+ *
+ * Usage:
+ *   std::string key = OdbCache::sourceKey(odbPath);
+ *   OdbCache cache;
+ *   if (!cache.read(OdbCache::defaultPath(odbPath), key, job)) {
+ *       job = reader.read(odbPath);
+ *       cache.write(job, OdbCache::defaultPath(odbPath), key);
+ *   }
+ */
+class KOO_API OdbCache {
+public:
+    /// Format version; files of other versions are rejected
+    static constexpr uint32_t kFormatVersion = 3;
+
+    OdbCache() = default;
+
+    /**
+     * @brief Cache file next to a job: "<job directory or archive>.koocache"
+     */
+    static std::filesystem::path defaultPath(const std::filesystem::path& odbPath);
+
+    /**
+     * @brief Key identifying the current contents of a job source
+     *
+     * Hashes the relative path, size and modification time of every file
+     * of a job directory, or the size and modification time of an archive.
+     * Returns an empty string if the source does not exist.
+     */
+    static std::string sourceKey(const std::filesystem::path& odbPath);
+
+    /**
+     * @brief Write a job to a cache file
+     * @param job Job to store (lazily loaded layers are loaded)
+     * @param cachePath Destination, replaced if present
+     * @param sourceKey Key of the job's source
+     * @return false on I/O failure (see getLastError())
+     */
+    bool write(const OdbJob& job, const std::filesystem::path& cachePath,
+               const std::string& sourceKey);
+
+    /**
+     * @brief Load a job from a cache file
+     * @param cachePath Cache to read
+     * @param sourceKey Expected key; a cache with another key is stale
+     * @param job Filled on success, left untouched otherwise
+     * @return false if the cache is missing, stale or damaged (see getLastError())
+     */
+    bool read(const std::filesystem::path& cachePath, const std::string& sourceKey, OdbJob& job);
+
+    /// Get last error message
+    const std::string& getLastError() const { return lastError_; }
+
+private:
+    class Encoder;      ///< Appends a job to a byte buffer (defined in the .cpp)
+    class Decoder;      ///< Rebuilds a job from a byte buffer (defined in the .cpp)
+
+    /// Append a layer's feature columns, side tables and objects
+    static void encodeFeatures(Encoder& out, const FeatureStore& store);
+
+    /// Restore feature storage written by encodeFeatures()
+    static void decodeFeatures(Decoder& in, FeatureStore& store);
+
+    std::string lastError_;
+};
+
+} // namespace koo::ecad
@@ -4,6 +4,7 @@
 #include <koo/ecad/Types.hpp>
 #include <koo/ecad/Step.hpp>
 #include <koo/ecad/Layer.hpp>
+#include <koo/ecad/LayerCache.hpp>
 #include <koo/ecad/Symbol.hpp>
 #include <memory>
 #include <string>
@@ -42,9 +43,9 @@ public:
     OdbJob(const OdbJob&) = delete;
     OdbJob& operator=(const OdbJob&) = delete;
 
-    // Allow moving
-    OdbJob(OdbJob&&) = default;
-    OdbJob& operator=(OdbJob&&) = default;
+    // Allow moving (the moved-from job keeps an empty symbol library and cache)
+    OdbJob(OdbJob&& other);
+    OdbJob& operator=(OdbJob&& other);
 
     // ========== Job Info ==========
 
@@ -73,7 +74,7 @@ public:
     Step* getStep(const std::string& name);
     const Step* getStep(const std::string& name) const;
 
-    /// Add step
+    /// Add step (its layers take the job's symbol cache)
     void addStep(std::unique_ptr<Step> step);
 
     /// Create and add new step
@@ -93,6 +94,10 @@ public:
         return steps_;
     }
 
+    /// Cache behind lazily loaded layers (nullptr unless read with OdbReader::Options::lazyFeatures)
+    LayerCache* getLayerCache() const { return layerCache_.get(); }
+    void setLayerCache(std::unique_ptr<LayerCache> cache) { layerCache_ = std::move(cache); }
+
     /// Get primary step (usually "pcb" or first step)
     Step* getPrimaryStep();
     const Step* getPrimaryStep() const;
@@ -100,8 +105,8 @@ public:
     // ========== Symbols ==========
 
     /// Get symbol library
-    SymbolLibrary& getSymbolLibrary() { return symbolLibrary_; }
-    const SymbolLibrary& getSymbolLibrary() const { return symbolLibrary_; }
+    SymbolLibrary& getSymbolLibrary() { return *symbolLibrary_; }
+    const SymbolLibrary& getSymbolLibrary() const { return *symbolLibrary_; }
 
     /// Convenience: get symbol by name
     Symbol* getSymbol(const std::string& name);
@@ -113,6 +118,9 @@ public:
     /// Get symbol names
     std::vector<std::string> getSymbolNames() const;
 
+    /// Parsed symbol geometry (standard and user symbols), shared by every layer of the job
+    const SymbolCache& getSymbolCache() const { return *symbolCache_; }
+
     // ========== Global Attributes ==========
 
     /// Global attributes (from misc/attrlist)
@@ -287,8 +295,11 @@ private:
     std::filesystem::path sourcePath_;
 
     LayerMatrix matrix_;
+    std::unique_ptr<LayerCache> layerCache_;    ///< Declared before steps_ so it outlives their layers
     std::unordered_map<std::string, std::unique_ptr<Step>> steps_;
-    SymbolLibrary symbolLibrary_;
+    std::unique_ptr<SymbolLibrary> symbolLibrary_ = std::make_unique<SymbolLibrary>();  ///< Boxed: the cache keeps its address
+    std::unique_ptr<SymbolCache> symbolCache_ =
+        std::make_unique<SymbolCache>(SymbolCache::kDefaultArcTolerance, symbolLibrary_.get());
     AttributeList attributes_;
 
     std::vector<StackupLayer> stackup_;
@@ -1,18 +1,24 @@
 #pragma once
 
 #include <koo/Export.hpp>
+#include <koo/ecad/OdbArchive.hpp>
 #include <koo/ecad/OdbJob.hpp>
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 namespace koo::ecad {
 
 /**
- * @brief ODB++ directory reader
+ * @brief ODB++ directory and archive reader
  *
  * Parses ODB++ job directory structure and loads data into OdbJob object.
+ * A path ending in .tgz, .tar.gz or .tar is read in place through an
+ * OdbArchive index instead of a directory, without extracting it.
  *
  * ODB++ directory structure:
  * odb_job/
@@ -31,6 +37,22 @@ namespace koo::ecad {
  * └── misc/                   - Metadata
  *     ├── info                - Job info
  *     └── attrlist            - Global attributes
+ *
+ * Layer feature files, each step's EDA data (eda/data, BOM, netlists) and
+ * user symbols are independent and are parsed concurrently. Every task fills
+ * its own object; results are attached to their step/job in directory order
+ * after all tasks finish, so the loaded job does not depend on the thread
+ * count. The progress callback is never invoked concurrently.
+ *
+ * With Options::lazyFeatures the matrix, step files, layer attributes, EDA
+ * data, symbols and stackup load as usual, but layers are proxies whose
+ * features are parsed on first access through the job's LayerCache, which
+ * shares this reader's archive index.
+ *
+ * Full reads (no filters, nothing skipped, not lazy) can go through a binary
+ * cache: with Options::writeCache the parsed job is saved with OdbCache,
+ * and later reads load it instead of parsing as long as the source is
+ * unchanged. The misc/ files the cache does not hold are still parsed.
  */
 class KOO_API OdbReader {
 public:
@@ -40,6 +62,22 @@ public:
         bool loadEdaData = true;        ///< Load EDA netlist data
         bool loadSymbols = true;        ///< Load user symbols
         bool decompressFeatures = true; ///< Decompress .z files
+        size_t threads = 0;             ///< Worker threads for layers, EDA data and symbols (0 = hardware concurrency)
+
+        /// Parse layer features on first access instead of up front (see LayerCache)
+        bool lazyFeatures = false;
+
+        /// Resident feature storage of lazy layers before LRU eviction (0 = unlimited)
+        size_t featureCacheBytes = 0;
+
+        /// Load full reads from a binary cache when one matches the source (see OdbCache)
+        bool readCache = true;
+
+        /// Write a binary cache after a full read
+        bool writeCache = false;
+
+        /// Binary cache file (empty = OdbCache::defaultPath(odbPath))
+        std::filesystem::path cachePath;
 
         /// Filter to load specific steps only (empty = load all)
         std::vector<std::string> stepFilter;
@@ -90,6 +128,39 @@ public:
     bool hasError() const { return !lastError_.empty(); }
 
 private:
+    /// One independently parseable unit of a job
+    struct LoadTask {
+        enum class Kind { Layer, EdaData, Symbol };
+
+        Kind kind = Kind::Layer;
+        std::filesystem::path path;
+        Step* step = nullptr;               ///< Owning step (Layer, EdaData)
+        std::unique_ptr<Layer> layer;       ///< Filled by Layer tasks
+        std::unique_ptr<Symbol> symbol;     ///< Filled by Symbol tasks
+        std::string label;                  ///< Progress message
+    };
+
+    // ========== Task Scheduling ==========
+
+    /// Parse step-level files and queue the step's layers and EDA data
+    void prepareStep(Step& step, const std::filesystem::path& stepPath,
+                     std::vector<LoadTask>& tasks);
+
+    /// Queue user symbols found under symbolsDir
+    void prepareSymbols(const std::filesystem::path& symbolsDir, std::vector<LoadTask>& tasks);
+
+    /// Run tasks on the worker pool, reporting progress in [progressBegin, progressEnd]
+    void runLoadTasks(std::vector<LoadTask>& tasks, double progressBegin, double progressEnd);
+
+    /// Attach parsed layers to their steps and symbols to the job, in task order
+    void attachLoadTasks(std::vector<LoadTask>& tasks, OdbJob* job);
+
+    /// Whether the options load the whole job, so a binary cache can stand in for parsing
+    bool isCacheable() const;
+
+    /// Parse the misc/ files and fonts read after the stackup (not held by OdbCache)
+    void parseMiscFiles(OdbJob& job, const std::filesystem::path& odbPath);
+
     // ========== Parsing Functions ==========
 
     /// Parse matrix file
@@ -113,9 +184,18 @@ private:
     /// Parse layer directory
     void parseLayer(Layer& layer, const std::filesystem::path& layerPath);
 
+    /// Parse the features file of a layer directory, if any
+    void parseLayerFeatures(Layer& layer, const std::filesystem::path& layerPath);
+
+    /// Cache that loads the features of the given layer tasks on demand
+    std::unique_ptr<LayerCache> makeLayerCache(std::vector<LoadTask>& tasks) const;
+
     /// Parse features file
     void parseFeatures(Layer& layer, const std::filesystem::path& featuresPath);
 
+    /// Parse a step's eda/ directory (data, BOM, netlists) into its EdaData
+    void parseStepEdaData(Step& step, const std::filesystem::path& edaDir);
+
     /// Parse EDA data
     void parseEdaData(EdaData& eda, const std::filesystem::path& edaPath);
 
@@ -187,40 +267,71 @@ private:
 
     // ========== Feature Parsing ==========
 
-    /// Parse single feature line
-    std::unique_ptr<Feature> parseFeatureLine(const std::string& line,
-                                               const std::vector<std::string>& symbolNames);
+    /// Fields of one feature record (defined in the .cpp)
+    struct RecordFields;
+
+    /// Buffered or streaming-inflate line source for features files (defined in the .cpp)
+    class FeatureLines;
+
+    /// Parse single feature line into the store; symbols maps file symbol
+    /// numbers to store symbol indices
+    void parseFeatureLine(std::string_view line, const std::vector<int32_t>& symbols,
+                          FeatureStore& store);
 
     /// Parse line feature
-    std::unique_ptr<LineFeature> parseLineFeature(const std::vector<std::string>& tokens,
-                                                  const std::vector<std::string>& symbolNames);
+    void parseLineFeature(const RecordFields& tokens, const std::vector<int32_t>& symbols,
+                          FeatureStore& store);
 
     /// Parse pad feature
-    std::unique_ptr<PadFeature> parsePadFeature(const std::vector<std::string>& tokens,
-                                                const std::vector<std::string>& symbolNames);
+    void parsePadFeature(const RecordFields& tokens, const std::vector<int32_t>& symbols,
+                         FeatureStore& store);
 
     /// Parse arc feature
-    std::unique_ptr<ArcFeature> parseArcFeature(const std::vector<std::string>& tokens,
-                                                const std::vector<std::string>& symbolNames);
+    void parseArcFeature(const RecordFields& tokens, const std::vector<int32_t>& symbols,
+                         FeatureStore& store);
 
     /// Parse text feature
-    std::unique_ptr<TextFeature> parseTextFeature(const std::vector<std::string>& tokens);
+    std::unique_ptr<TextFeature> parseTextFeature(const RecordFields& tokens);
 
-    /// Parse surface feature
-    std::unique_ptr<SurfaceFeature> parseSurfaceFeature(std::istream& stream,
-                                                        const std::string& firstLine);
+    /// Parse surface feature; consumes contour lines up to SE
+    std::unique_ptr<SurfaceFeature> parseSurfaceFeature(FeatureLines& lines,
+                                                        const RecordFields& header);
 
     // ========== Utility ==========
 
-    /// Decompress .z file to string
+    /// Decompress .z file (zlib or gzip; other data passes through) to string
     std::string decompressFile(const std::filesystem::path& compressedPath);
 
+    /// Decompress an in-memory .z member (zlib or gzip; other data passes through)
+    std::string decompressBuffer(const std::string& compressed);
+
     /// Read file contents (handling .z compression)
     std::string readFileContents(const std::filesystem::path& filePath, bool decompress = true);
 
-    /// Report progress
+    // ========== Job Source (directory or archive) ==========
+
+    /// Open odbPath as an archive if it names one; directories need no setup
+    bool openSource(const std::filesystem::path& odbPath);
+
+    /// Member path inside the open archive for a path under odbPath
+    std::string archiveMember(const std::filesystem::path& path) const;
+
+    /// Check whether a file or directory exists in the job source
+    bool fileExists(const std::filesystem::path& path) const;
+
+    /// Resolve basePath/filename, preferring the plain file over filename.z
+    std::filesystem::path findFile(const std::filesystem::path& basePath,
+                                   const std::string& filename) const;
+
+    /// Subdirectories of a job directory, sorted by name
+    std::vector<std::filesystem::path> listDirectories(const std::filesystem::path& dirPath) const;
+
+    /// Report progress (serialized across worker threads)
     void reportProgress(const std::string& message, double progress);
 
+    /// Record an error message (thread-safe)
+    void setError(const std::string& message);
+
     /// Parse structured text file into key-value pairs
     std::unordered_map<std::string, std::string> parseStructuredFile(const std::string& content);
 
@@ -228,7 +339,7 @@ private:
     std::vector<std::string> tokenize(const std::string& line);
 
     /// Parse orientation definition
-    void parseOrientDef(const std::string& orientStr, double& rotation, bool& mirror);
+    void parseOrientDef(std::string_view orientStr, double& rotation, bool& mirror);
 
     /// Parse feature attributes
     void parseFeatureAttributes(const std::string& attrStr, Feature& feature,
@@ -239,6 +350,10 @@ private:
     Options options_;
     std::string lastError_;
     ProgressCallback progressCallback_;
+    std::shared_ptr<const OdbArchive> archive_;             ///< Set while reading from an archive
+    std::filesystem::file_time_type archiveWriteTime_{};
+    std::mutex errorMutex_;
+    std::mutex progressMutex_;
 };
 
 } // namespace koo::ecad
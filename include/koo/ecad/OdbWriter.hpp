@@ -1,17 +1,22 @@
 #pragma once
 
 #include <koo/Export.hpp>
+#include <koo/ecad/OdbArchive.hpp>
 #include <koo/ecad/OdbJob.hpp>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <functional>
+#include <vector>
 
 namespace koo::ecad {
 
 /**
- * @brief ODB++ directory writer
+ * @brief ODB++ directory and archive writer
  *
- * Writes OdbJob data to ODB++ directory structure.
+ * Writes OdbJob data to ODB++ directory structure. When the output path
+ * ends in .tgz, .tar.gz or .tar, the same tree is streamed into a single
+ * archive (under a top-level directory named after the archive) instead.
  *
  * ODB++ directory structure:
  * odb_job/
@@ -32,6 +37,11 @@ namespace koo::ecad {
  *     ├── attrlist            - Global attributes
  *     ├── stackup             - Stackup definition
  *     └── ...
+ *
+ * Layer features, EDA data and symbols are independent files and are
+ * produced concurrently. Large layers are formatted in chunks on several
+ * threads while earlier chunks are deflated and written, so no file is held
+ * in memory whole (archives still collect each entry before appending it).
  */
 class KOO_API OdbWriter {
 public:
@@ -47,6 +57,7 @@ public:
         bool writeBom = true;            ///< Write BOM data
         bool overwrite = false;          ///< Overwrite existing directory
         int compressionLevel = 6;        ///< zlib compression level (1-9)
+        size_t threads = 0;              ///< Worker threads (0 = hardware concurrency)
     };
 
     /// Progress callback type
@@ -59,7 +70,7 @@ public:
 
     // ========== Full Write ==========
 
-    /// Write complete ODB++ job to directory
+    /// Write complete ODB++ job to directory or archive
     bool write(const OdbJob& job, const std::filesystem::path& odbPath);
 
     /// Write with options
@@ -91,8 +102,17 @@ public:
     bool hasError() const { return !lastError_.empty(); }
 
 private:
+    /// One output file, optionally deflated, bound for disk or the archive
+    class OutputSink;
+
+    /// One file produced by a worker thread
+    struct FileTask;
+
     // ========== Writing Functions ==========
 
+    /// Write all job files below odbPath (directory or open archive)
+    bool writeJob(const OdbJob& job, const std::filesystem::path& odbPath);
+
     /// Create ODB++ directory structure
     bool createDirectoryStructure(const std::filesystem::path& odbPath);
 
@@ -108,6 +128,10 @@ private:
     /// Write step directory
     bool writeStepDir(const Step& step, const std::filesystem::path& stepPath);
 
+    /// Write step directory, queueing its layer and EDA files
+    bool writeStepDir(const Step& step, const std::filesystem::path& stepPath,
+                      std::vector<FileTask>& tasks);
+
     /// Write stephdr file
     bool writeStepHeader(const Step& step, const std::filesystem::path& stephdrPath);
 
@@ -117,15 +141,30 @@ private:
     /// Write layer directory
     bool writeLayerDir(const Layer& layer, const std::filesystem::path& layerPath);
 
-    /// Write features file
-    bool writeFeatures(const Layer& layer, const std::filesystem::path& featuresPath);
+    /// Write layer directory, queueing its features file
+    bool writeLayerDir(const Layer& layer, const std::filesystem::path& layerPath,
+                       std::vector<FileTask>& tasks);
+
+    /// Format a features file in chunks (threads format, the caller's sink writes)
+    void writeFeatures(const Layer& layer, OutputSink& sink, size_t threads) const;
 
     /// Write EDA data file
     bool writeEdaDataFile(const EdaData& eda, const std::filesystem::path& edaPath);
 
+    /// Queue an EDA data file
+    void addEdaDataTask(const EdaData& eda, const std::filesystem::path& edaPath,
+                        std::vector<FileTask>& tasks) const;
+
     /// Write symbol directory
     bool writeSymbolDir(const Symbol& symbol, const std::filesystem::path& symbolPath);
 
+    /// Create a symbol directory, queueing its features file
+    bool writeSymbolDir(const Symbol& symbol, const std::filesystem::path& symbolPath,
+                        std::vector<FileTask>& tasks);
+
+    /// Produce queued files in parallel; archive entries are appended in queue order
+    bool runFileTasks(std::vector<FileTask>& tasks);
+
     /// Write attrlist file
     bool writeAttrList(const AttributeList& attrs, const std::filesystem::path& attrPath);
 
@@ -165,70 +204,70 @@ private:
 
     // ========== Feature Writing ==========
 
-    /// Write single feature to stream
-    void writeFeature(std::ostream& out, const Feature& feature,
-                      const std::vector<std::string>& symbolNames);
+    /// Append single feature
+    void writeFeature(std::string& out, const Feature& feature, const StringTable& symbols) const;
+
+    /// Append one feature of a layer straight from its columns
+    void writeFeature(std::string& out, const FeatureStore& features, size_t index) const;
 
-    /// Write line feature
-    void writeLineFeature(std::ostream& out, const LineFeature& line,
-                          const std::vector<std::string>& symbolNames);
+    /// Append line feature
+    void writeLineFeature(std::string& out, const LineFeature& line, const StringTable& symbols) const;
 
-    /// Write pad feature
-    void writePadFeature(std::ostream& out, const PadFeature& pad,
-                         const std::vector<std::string>& symbolNames);
+    /// Append pad feature
+    void writePadFeature(std::string& out, const PadFeature& pad, const StringTable& symbols) const;
 
-    /// Write arc feature
-    void writeArcFeature(std::ostream& out, const ArcFeature& arc,
-                         const std::vector<std::string>& symbolNames);
+    /// Append arc feature
+    void writeArcFeature(std::string& out, const ArcFeature& arc, const StringTable& symbols) const;
 
-    /// Write text feature
-    void writeTextFeature(std::ostream& out, const TextFeature& text);
+    /// Append text feature
+    void writeTextFeature(std::string& out, const TextFeature& text) const;
 
-    /// Write surface feature
-    void writeSurfaceFeature(std::ostream& out, const SurfaceFeature& surface);
+    /// Append surface feature
+    void writeSurfaceFeature(std::string& out, const SurfaceFeature& surface) const;
 
     // ========== EDA Data Writing ==========
 
+    /// Write the whole EDA data file
+    void writeEdaContent(std::ostream& out, const EdaData& eda) const;
+
     /// Write components section
-    void writeComponents(std::ostream& out, const EdaData& eda);
+    void writeComponents(std::ostream& out, const EdaData& eda) const;
 
     /// Write nets section
-    void writeNets(std::ostream& out, const EdaData& eda);
+    void writeNets(std::ostream& out, const EdaData& eda) const;
 
     /// Write packages section
-    void writePackages(std::ostream& out, const EdaData& eda);
+    void writePackages(std::ostream& out, const EdaData& eda) const;
 
     /// Write BOM section
-    void writeBomData(std::ostream& out, const EdaData& eda);
+    void writeBomData(std::ostream& out, const EdaData& eda) const;
 
     // ========== Utility ==========
 
-    /// Compress string with zlib
-    std::vector<uint8_t> compressData(const std::string& data);
-
-    /// Write compressed file
-    bool writeCompressedFile(const std::string& content, const std::filesystem::path& filePath);
-
     /// Write plain file
     bool writePlainFile(const std::string& content, const std::filesystem::path& filePath);
 
+    /// Create a directory (or its archive entry); throws on failure
+    void makeDirectories(const std::filesystem::path& dirPath);
+
+    /// Append file content to the open archive
+    bool addArchiveFile(const std::string& content, const std::filesystem::path& filePath);
+
     /// Report progress
     void reportProgress(const std::string& message, double progress);
 
     /// Format double value for output
     std::string formatDouble(double value, int precision = 6) const;
 
-    /// Get symbol index in list
-    int getSymbolIndex(const std::string& symbolName,
-                       const std::vector<std::string>& symbolNames) const;
-
-    /// Build symbol name list from layer
-    std::vector<std::string> buildSymbolList(const Layer& layer) const;
+    /// Get symbol index in the table (0 when absent)
+    int getSymbolIndex(const std::string& symbolName, const StringTable& symbols) const;
 
 private:
     Options options_;
     std::string lastError_;
     ProgressCallback progressCallback_;
+    std::unique_ptr<OdbArchiveWriter> archive_;     ///< Set while writing an archive
+    std::filesystem::path archiveRoot_;
 };
 
 } // namespace koo::ecad
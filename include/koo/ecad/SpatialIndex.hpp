@@ -0,0 +1,128 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace koo::ecad {
+
+/**
+ * @brief Static R-tree over 2D bounding boxes
+ *
+ * Bulk-loaded as a packed Hilbert R-tree: items are sorted by the Hilbert
+ * value of their box centers and grouped kNodeSize at a time, level by level,
+ * so the whole tree is a few flat arrays with no per-node allocation.
+ * Items are identified by their position in the array passed to build().
+ *
+ * The index is immutable once built; queries are const and may run
+ * concurrently.
+ *
+ * Usage:
+ *   SpatialIndex index(boxes);
+ *   for (size_t item : index.query(window)) { ... }
+ *   size_t closest = index.nearest({x, y});
+ */
+class KOO_API SpatialIndex {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// Children per node
+    static constexpr size_t kNodeSize = 16;
+
+    SpatialIndex() = default;
+    explicit SpatialIndex(const std::vector<BoundingBox2D>& boxes, size_t threads = 0) {
+        build(boxes, threads);
+    }
+
+    /**
+     * @brief Bulk-load the tree, replacing any previous contents
+     * @param boxes One box per item (invalid boxes are never returned by queries)
+     * @param threads Worker threads for the Hilbert sort keys (0 = hardware concurrency)
+     */
+    void build(const std::vector<BoundingBox2D>& boxes, size_t threads = 0);
+
+    /// Number of indexed items
+    size_t size() const { return order_.size(); }
+    bool empty() const { return order_.empty(); }
+
+    /// Bounds of all items
+    BoundingBox2D getBounds() const;
+
+    // ========== Queries ==========
+
+    /// Call fn(item) for every item whose box overlaps the window (unordered)
+    template<typename Fn>
+    void visit(const BoundingBox2D& window, Fn&& fn) const;
+
+    /// Items whose box overlaps the window, ascending
+    std::vector<size_t> query(const BoundingBox2D& window) const;
+
+    /// Items whose box contains the point, ascending
+    std::vector<size_t> queryPoint(const Point2D& point) const;
+
+    /**
+     * @brief Item whose box is closest to a point
+     * @param point Query point
+     * @param distance Optional output: distance to that box (0 if inside)
+     * @return Item index, or npos if the index is empty
+     */
+    size_t nearest(const Point2D& point, double* distance = nullptr) const;
+
+    /// Window queries run in parallel; result i answers windows[i]
+    std::vector<std::vector<size_t>> queryBatch(const std::vector<BoundingBox2D>& windows,
+                                                size_t threads = 0) const;
+
+private:
+    static bool overlaps(const BoundingBox2D& a, const BoundingBox2D& b) {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+               a.min.y <= b.max.y && a.max.y >= b.min.y;
+    }
+
+    size_t levelSize(size_t level) const { return levelStart_[level + 1] - levelStart_[level]; }
+
+    std::vector<BoundingBox2D> nodes_;  ///< All levels; level 0 holds the item boxes in Hilbert order
+    std::vector<size_t> levelStart_;    ///< Offset of each level in nodes_, plus an end sentinel
+    std::vector<uint32_t> order_;       ///< Level-0 slot -> item index
+};
+
+template<typename Fn>
+void SpatialIndex::visit(const BoundingBox2D& window, Fn&& fn) const {
+    if (order_.empty()) {
+        return;
+    }
+    size_t top = levelStart_.size() - 2;
+    if (!overlaps(nodes_[levelStart_[top]], window)) {
+        return;
+    }
+    if (top == 0) {
+        fn(static_cast<size_t>(order_[0]));
+        return;
+    }
+
+    // Depth-first; at most kNodeSize pending nodes per level
+    std::array<std::pair<size_t, size_t>, kNodeSize * 16> stack;
+    size_t depth = 0;
+    stack[depth++] = {top, 0};
+    while (depth > 0) {
+        auto [level, node] = stack[--depth];
+        size_t child = node * kNodeSize;
+        size_t end = std::min(child + kNodeSize, levelSize(level - 1));
+        const BoundingBox2D* boxes = nodes_.data() + levelStart_[level - 1];
+        for (; child < end; ++child) {
+            if (!overlaps(boxes[child], window)) {
+                continue;
+            }
+            if (level == 1) {
+                fn(static_cast<size_t>(order_[child]));
+            } else {
+                stack[depth++] = {level - 1, child};
+            }
+        }
+    }
+}
+
+} // namespace koo::ecad
@@ -48,9 +48,13 @@ public:
     Layer* getLayer(const std::string& name);
     const Layer* getLayer(const std::string& name) const;
 
-    /// Add layer
+    /// Add layer (it takes the step's symbol cache)
     void addLayer(std::unique_ptr<Layer> layer);
 
+    /// Symbol cache handed to every layer (set by OdbJob to its own; see Layer::setSymbolCache)
+    const SymbolCache* getSymbolCache() const { return symbolCache_; }
+    void setSymbolCache(const SymbolCache* symbols);
+
     /// Get all layer names
     std::vector<std::string> getLayerNames() const;
 
@@ -169,6 +173,7 @@ private:
 
     // Layers
     std::unordered_map<std::string, std::unique_ptr<Layer>> layers_;
+    const SymbolCache* symbolCache_ = nullptr;
 
     // EDA data
     EdaData edaData_;
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <koo/Export.hpp>
+#include <koo/ecad/Types.hpp>
+#include <koo/ecad/FeatureStore.hpp>
+#include <koo/ecad/SpatialIndex.hpp>
+#include <koo/ecad/Step.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace koo::ecad {
+
+class OdbJob;
+
+/**
+ * @brief One placed copy of a step inside a panel
+ */
+struct StepInstance {
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    const Step* step = nullptr;
+    Transform2D transform;          ///< Step coordinates -> root step coordinates
+    size_t parent = npos;           ///< Instance this one is placed in (npos for the root)
+    size_t repeat = 0;              ///< Index into the parent step's getStepRepeats()
+    int column = 0;                 ///< Position in the repeat array (0-based)
+    int row = 0;
+    size_t depth = 0;               ///< Nesting level (0 for the root)
+};
+
+/**
+ * @brief Feature of one instance
+ */
+struct InstanceFeature {
+    size_t instance = 0;
+    size_t feature = 0;             ///< Index in the instance step's layer
+
+    bool operator==(const InstanceFeature& other) const {
+        return instance == other.instance && feature == other.feature;
+    }
+};
+
+/**
+ * @brief Step-and-repeat panel expressed as instances of child steps
+ *
+ * Expands the STEP-REPEAT records of a step (recursively, for panels of
+ * arrays) into a flat list of instances, each a child step plus the
+ * placement that maps its coordinates into the root step. The root step
+ * itself is instance 0 with the identity transform. No feature is copied:
+ * iteration and queries read the child layers in place and transform on the
+ * fly, so a 48-up panel costs 48 instance records rather than 48 copies of
+ * the board.
+ *
+ * A placement puts the child datum at (x + column*dx, y + row*dy), after
+ * mirroring in X and rotating clockwise by the repeat angle. Repeats naming
+ * a missing step, or one already on the nesting path, are skipped and
+ * reported by getWarnings().
+ *
+ * Only export paths need the flat geometry; materialize() builds it.
+ *
+ * Usage:
+ *   StepInstances panel(job, *job.getStep("panel"));
+ *   panel.forEachFeature("top", [&](size_t instance, const FeatureView& f) {
+ *       Point2D p = panel[instance].transform.apply(f.getPosition());
+ *   });
+ *   for (const auto& hit : panel.query("top", window)) { ... }
+ */
+class KOO_API StepInstances {
+public:
+    /**
+     * @brief Expand the step-repeat tree of a step
+     * @param job Job owning the child steps (must outlive this object)
+     * @param root Step to expand (must outlive this object)
+     */
+    StepInstances(const OdbJob& job, const Step& root);
+
+    // ========== Instances ==========
+
+    size_t size() const { return instances_.size(); }
+    const StepInstance& operator[](size_t index) const { return instances_[index]; }
+    const std::vector<StepInstance>& getInstances() const { return instances_; }
+
+    /// Repeats skipped during expansion (missing or recursive steps)
+    const std::vector<std::string>& getWarnings() const { return warnings_; }
+
+    // ========== Lazy Iteration ==========
+
+    /// Layer of an instance's step (nullptr if the step lacks it)
+    const Layer* getLayer(size_t instance, const std::string& layerName) const;
+
+    /// Total features on a layer over all instances
+    size_t getFeatureCount(const std::string& layerName) const;
+
+    /**
+     * @brief Call fn(instance, view) for every feature of a layer, instance by instance
+     *
+     * Views are in the instance step's coordinates; map them with
+     * (*this)[instance].transform.
+     */
+    template<typename Fn>
+    void forEachFeature(const std::string& layerName, Fn&& fn) const;
+
+    /// Standalone copy of an instance feature, in root coordinates (nullptr if out of range)
+    std::unique_ptr<Feature> getFeature(const std::string& layerName, const InstanceFeature& ref) const;
+
+    /// Bounding box of an instance feature, in root coordinates
+    BoundingBox2D getBoundingBox(const std::string& layerName, const InstanceFeature& ref) const;
+
+    /// Extent of a layer over all instances (symbols included, see Layer::getExtent), in root coordinates
+    BoundingBox2D getBoundingBox(const std::string& layerName) const;
+
+    // ========== Spatial Queries ==========
+
+    /// Instance features whose transformed box overlaps the window, by instance then feature
+    std::vector<InstanceFeature> query(const std::string& layerName, const BoundingBox2D& window) const;
+
+    /// Instance features whose transformed box contains the point
+    std::vector<InstanceFeature> queryPoint(const std::string& layerName, const Point2D& point) const;
+
+    // ========== Materialization ==========
+
+    /**
+     * @brief Build the fully expanded layer in root coordinates
+     * @param layerName Layer to expand
+     * @param threads Worker threads (0 = hardware concurrency)
+     * @return New layer with every instance's features, in instance order
+     */
+    std::unique_ptr<Layer> materialize(const std::string& layerName, size_t threads = 0) const;
+
+private:
+    void expand(const Step& step, const Transform2D& transform, size_t parent,
+                size_t repeat, int column, int row, std::vector<const Step*>& path);
+
+    /// R-tree over the transformed layer bounds of every instance (built on first use)
+    const SpatialIndex& instanceIndex(const std::string& layerName) const;
+
+    const OdbJob& job_;
+    std::vector<StepInstance> instances_;
+    std::vector<std::string> warnings_;
+
+    mutable std::mutex indexMutex_;
+    mutable std::unordered_map<std::string, std::unique_ptr<SpatialIndex>> instanceIndex_;
+};
+
+template<typename Fn>
+void StepInstances::forEachFeature(const std::string& layerName, Fn&& fn) const {
+    for (size_t i = 0; i < instances_.size(); ++i) {
+        const Layer* layer = instances_[i].step->getLayer(layerName);
+        if (!layer) continue;
+        for (const auto& feature : layer->getFeatures()) {
+            fn(i, feature);
+        }
+    }
+}
+
+} // namespace koo::ecad
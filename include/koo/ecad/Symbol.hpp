@@ -8,6 +8,8 @@
 #include <vector>
 #include <optional>
 #include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
 
 namespace koo::ecad {
 
@@ -32,6 +34,7 @@ namespace koo::ecad {
  * - oct<w>x<h>x<r>         : Octagon
  * - tri<base>x<h>          : Triangle
  * - oval_h<w>x<h>          : Half oval
+ * - el<w>x<h>              : Ellipse
  *
  * Hexagons:
  * - hex_l<w>x<h>x<r>       : Horizontal hexagon
@@ -161,10 +164,15 @@ public:
     uint8_t getCorners() const { return corners_; }
     void setCorners(uint8_t corners) { corners_ = corners; }
 
-    /// Unit of the symbol dimensions ('I' for imperial/mils, 'M' for metric/microns)
+    /// Unit of the symbol dimensions ('I' for imperial/mils, 'M' for metric/microns);
+    /// for user symbols, the UNITS of their features file ('I' = INCH, 'M' = MM)
     char getUnit() const { return unit_; }
     void setUnit(char unit) { unit_ = unit; }
 
+    /// Factor converting dimensions to layer units ("INCH" or "MM"); unitless
+    /// dimensions are mils on inch layers and microns on metric ones
+    double getUnitScale(const std::string& layerUnits) const;
+
     // Helper methods for common dimension names
     double getWidth() const { return primaryDim_; }
     double getHeight() const { return secondaryDim_; }
@@ -512,4 +520,93 @@ private:
     std::unique_ptr<Symbol> createStandardSymbol(const std::string& name) const;
 };
 
+// ============================================================================
+// Symbol Geometry Cache
+// ============================================================================
+
+class StringTable;
+
+/**
+ * @brief Resolved geometry of a symbol in one layer unit system
+ *
+ * Outline and bounds are centered on the origin and scaled to layer units;
+ * pads place them with their rotation, mirror and resize factor. Islands run
+ * CCW and holes CW. A thermal has one island (and hole) per piece between
+ * its spoke gaps; a user symbol has the rings of each of its features, and
+ * its bounds are the smallest centered box around them.
+ */
+struct SymbolGeometry {
+    std::unique_ptr<Symbol> symbol;     ///< Parsed symbol, a bare named one for user symbols (nullptr if unknown)
+    std::vector<Point2D> points;        ///< Outline rings (round symbols are tessellated too)
+    std::vector<uint32_t> rings;        ///< Ring start offsets plus end sentinel
+    double radius = 0.0;                ///< Disc radius of round symbols
+    BoundingBox2D bounds;               ///< Extent (invalid for unknown symbols)
+
+    /// Symbol type (User for unknown names)
+    SymbolType getType() const { return symbol ? symbol->getType() : SymbolType::User; }
+
+    /// Whether the name resolved to a shape
+    bool isValid() const { return bounds.isValid(); }
+};
+
+/**
+ * @brief Job-wide cache of parsed symbol names and their outlines
+ *
+ * Symbol names such as "r10" or "rect20x40xr5" are parsed and tessellated
+ * once per layer unit system; every later lookup is one hash probe. Layers
+ * resolve their whole symbol table up front, so per-feature code indexes a
+ * vector instead of hashing at all. Lookups are thread-safe and returned
+ * references stay valid until clear().
+ *
+ * Given a SymbolLibrary, names that are not standard symbols are looked up
+ * there and outlined from the user symbol's positive features, so add user
+ * symbols before their first lookup.
+ *
+ * Usage:
+ *   const SymbolGeometry& r10 = job.getSymbolCache().get("r10", "INCH");
+ *   auto table = cache.resolve(layer.getFeatures().getSymbols(), layer.getUnits());
+ */
+class KOO_API SymbolCache {
+public:
+    static constexpr double kDefaultArcTolerance = 1e-4;
+
+    /// Cache with the default arc tolerance (1e-4 layer units)
+    SymbolCache();
+
+    /// Cache tessellating round corners to within arcTolerance (layer units)
+    explicit SymbolCache(double arcTolerance);
+
+    /// Cache that also outlines the user symbols of a library (which must outlive it)
+    SymbolCache(double arcTolerance, const SymbolLibrary* library);
+
+    // Prevent copying (entries are handed out by reference)
+    SymbolCache(const SymbolCache&) = delete;
+    SymbolCache& operator=(const SymbolCache&) = delete;
+
+    /// Geometry of a symbol for layers in the given units ("INCH" or "MM")
+    const SymbolGeometry& get(const std::string& name, const std::string& units) const;
+
+    /// Geometry of every entry of a layer symbol table, in table order
+    std::vector<const SymbolGeometry*> resolve(const StringTable& symbols,
+                                               const std::string& units) const;
+
+    /// Chord tolerance of the tessellated outlines
+    double getArcTolerance() const { return arcTolerance_; }
+
+    /// Number of cached (name, units) entries
+    size_t size() const;
+
+    /// Drop every entry
+    void clear();
+
+private:
+    /// get() for a symbol nested depth user symbols deep
+    const SymbolGeometry& lookup(const std::string& name, const std::string& units, size_t depth) const;
+
+    double arcTolerance_;
+    const SymbolLibrary* library_ = nullptr;
+    mutable std::shared_mutex mutex_;
+    mutable std::unordered_map<std::string, std::unique_ptr<SymbolGeometry>> entries_;
+};
+
 } // namespace koo::ecad
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koo/Export.hpp>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -74,6 +75,90 @@ struct BoundingBox2D {
     }
 };
 
+/**
+ * @brief Rigid 2D placement: mirror in X, rotate clockwise, then translate
+ *
+ * Matches how ODB++ orients pads and step-repeat instances. Composition
+ * stays in this form, so a transformed pad keeps a plain rotation/mirror.
+ */
+class Transform2D {
+public:
+    Transform2D() = default;
+
+    /// @param angle Clockwise rotation (degrees), applied after mirroring
+    /// @param mirror Mirror in X (x -> -x) first
+    /// @param offset Translation, applied last
+    Transform2D(double angle, bool mirror, const Point2D& offset)
+        : angle_(normalizeAngle(angle)), mirror_(mirror), offset_(offset) {
+        // Exact values for right angles keep axis-aligned data exact
+        double quarter = angle_ / 90.0;
+        if (quarter == std::floor(quarter)) {
+            static constexpr double kCos[] = {1.0, 0.0, -1.0, 0.0};
+            static constexpr double kSin[] = {0.0, 1.0, 0.0, -1.0};
+            auto q = static_cast<size_t>(quarter) % 4;
+            cos_ = kCos[q];
+            sin_ = kSin[q];
+        } else {
+            double rad = angle_ * 3.14159265358979323846 / 180.0;
+            cos_ = std::cos(rad);
+            sin_ = std::sin(rad);
+        }
+    }
+
+    double getAngle() const { return angle_; }
+    bool isMirrored() const { return mirror_; }
+    const Point2D& getOffset() const { return offset_; }
+    bool isIdentity() const { return angle_ == 0.0 && !mirror_ && offset_.x == 0.0 && offset_.y == 0.0; }
+
+    /// Transform a point
+    Point2D apply(const Point2D& p) const {
+        double x = mirror_ ? -p.x : p.x;
+        return {offset_.x + x * cos_ + p.y * sin_, offset_.y - x * sin_ + p.y * cos_};
+    }
+
+    /// Bounding box of a transformed box
+    BoundingBox2D apply(const BoundingBox2D& box) const {
+        BoundingBox2D result;
+        if (!box.isValid()) return result;
+        result.expand(apply(box.min));
+        result.expand(apply(box.max));
+        result.expand(apply(Point2D{box.min.x, box.max.y}));
+        result.expand(apply(Point2D{box.max.x, box.min.y}));
+        return result;
+    }
+
+    /// Orientation of a rotated/mirrored item after this transform
+    double applyAngle(double angle) const {
+        return normalizeAngle(angle_ + (mirror_ ? -angle : angle));
+    }
+
+    /// This transform applied after inner
+    Transform2D operator*(const Transform2D& inner) const {
+        return Transform2D(applyAngle(inner.angle_), mirror_ != inner.mirror_, apply(inner.offset_));
+    }
+
+    /// Inverse transform
+    Transform2D inverse() const {
+        Transform2D linear(mirror_ ? angle_ : -angle_, mirror_, {0.0, 0.0});
+        Point2D back = linear.apply(offset_);
+        return Transform2D(linear.angle_, mirror_, {-back.x, -back.y});
+    }
+
+    /// Angle in [0, 360)
+    static double normalizeAngle(double angle) {
+        angle = std::fmod(angle, 360.0);
+        if (angle < 0.0) angle += 360.0;
+        return angle < 360.0 ? angle : 0.0;
+    }
+
+private:
+    double angle_ = 0.0;
+    bool mirror_ = false;
+    Point2D offset_{0.0, 0.0};
+    double cos_ = 1.0;
+    double sin_ = 0.0;
+};
+
 // ============================================================================
 // Enumerations
 // ============================================================================
@@ -193,6 +278,7 @@ enum class SymbolType {
     Octagon,            ///< Octagon (oct<w>x<h>x<r>)
     Triangle,           ///< Triangle (tri<base>x<h>)
     HalfOval,           ///< Half oval (oval_h<w>x<h>)
+    Ellipse,            ///< Ellipse (el<w>x<h>)
 
     // Hexagons
     HorizontalHexagon,  ///< Horizontal hexagon (hex_l<w>x<h>x<r>)
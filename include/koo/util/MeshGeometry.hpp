@@ -0,0 +1,108 @@
+#pragma once
+
+#include <koo/util/Types.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace koo::util {
+
+/**
+ * @brief Area of a triangle
+ */
+inline double triangleArea(const Vec3& a, const Vec3& b, const Vec3& c) {
+    return 0.5 * (b - a).cross(c - a).length();
+}
+
+/**
+ * @brief Area of a (possibly degenerate or warped) quadrilateral
+ *
+ * Computed from the cross product of the diagonals, so a quad with a
+ * repeated last node yields the triangle area.
+ */
+inline double quadArea(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+    return 0.5 * (c - a).cross(d - b).length();
+}
+
+/**
+ * @brief Unsigned volume of a tetrahedron
+ */
+inline double tetVolume(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+    return std::abs((b - a).dot((c - a).cross(d - a))) / 6.0;
+}
+
+/**
+ * @brief Volume and largest face of a solid element
+ */
+struct SolidGeometry {
+    double volume = 0.0;
+    double maxFaceArea = 0.0;
+    bool tetrahedron = false;
+};
+
+/**
+ * @brief Compute volume and largest face area of an 8-node solid
+ * @param nodes Positions of the 8 hexahedron nodes in LS-DYNA order
+ *
+ * Tetrahedra (N1..N4 with N4 repeated) and pentahedra (N5, N6 repeated)
+ * are recognized from the repeated node positions.
+ */
+inline SolidGeometry computeSolidGeometry(const Vec3* nodes) {
+    static constexpr int kHexFaces[6][4] = {
+        {0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 5, 4},
+        {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}
+    };
+
+    SolidGeometry geom;
+
+    // Collect distinct corners to recognize degenerate tetrahedra
+    Vec3 unique[8];
+    size_t uniqueCount = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        bool seen = false;
+        for (size_t j = 0; j < uniqueCount; ++j) {
+            if (unique[j] == nodes[i]) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            unique[uniqueCount++] = nodes[i];
+        }
+    }
+
+    if (uniqueCount == 4) {
+        const Vec3& a = unique[0];
+        const Vec3& b = unique[1];
+        const Vec3& c = unique[2];
+        const Vec3& d = unique[3];
+        geom.tetrahedron = true;
+        geom.volume = tetVolume(a, b, c, d);
+        geom.maxFaceArea = std::max({triangleArea(a, b, c), triangleArea(a, b, d),
+                                     triangleArea(a, c, d), triangleArea(b, c, d)});
+        return geom;
+    }
+    if (uniqueCount < 4) {
+        return geom;
+    }
+
+    // Pentahedra and hexahedra: split each face into two triangles and
+    // sum the tetrahedra they form with the element center
+    Vec3 center;
+    for (size_t i = 0; i < uniqueCount; ++i) {
+        center += unique[i];
+    }
+    center = center / static_cast<double>(uniqueCount);
+
+    for (const auto& face : kHexFaces) {
+        const Vec3& a = nodes[face[0]];
+        const Vec3& b = nodes[face[1]];
+        const Vec3& c = nodes[face[2]];
+        const Vec3& d = nodes[face[3]];
+        geom.volume += tetVolume(center, a, b, c) + tetVolume(center, a, c, d);
+        geom.maxFaceArea = std::max(geom.maxFaceArea, quadArea(a, b, c, d));
+    }
+    return geom;
+}
+
+} // namespace koo::util
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace koo::util {
+
+/**
+ * @brief Resolve a requested worker count
+ * @param requested Requested thread count (0 = hardware concurrency)
+ * @return Number of worker threads to use (always >= 1)
+ */
+inline size_t resolveThreadCount(size_t requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 0 ? static_cast<size_t>(hw) : 1;
+}
+
+/**
+ * @brief Number of fixed-size blocks covering [0, count)
+ */
+inline size_t blockCount(size_t count, size_t blockSize) {
+    if (blockSize == 0) blockSize = 1;
+    return (count + blockSize - 1) / blockSize;
+}
+
+/**
+ * @brief Run a function over [0, count) split into fixed-size blocks
+ * @param count Number of items
+ * @param blockSize Items per block
+ * @param fn Callable fn(blockIndex, begin, end)
+ * @param threads Worker thread count (0 = hardware concurrency)
+ *
+ * Block boundaries depend only on count and blockSize, never on the thread
+ * count. Callers that store one partial result per block and combine them in
+ * block order therefore get bit-identical results for any thread count.
+ * Blocks are handed out dynamically, so uneven blocks still balance.
+ *
+ * The first exception thrown by fn is rethrown on the calling thread after
+ * all workers have joined.
+ */
+template<typename Fn>
+void parallelForBlocks(size_t count, size_t blockSize, Fn&& fn, size_t threads = 0) {
+    if (blockSize == 0) blockSize = 1;
+    const size_t nBlocks = blockCount(count, blockSize);
+    if (nBlocks == 0) {
+        return;
+    }
+
+    const size_t nThreads = std::min(resolveThreadCount(threads), nBlocks);
+    if (nThreads <= 1) {
+        for (size_t b = 0; b < nBlocks; ++b) {
+            size_t begin = b * blockSize;
+            fn(b, begin, std::min(begin + blockSize, count));
+        }
+        return;
+    }
+
+    std::atomic<size_t> nextBlock{0};
+    std::exception_ptr firstError;
+    std::mutex errorMutex;
+
+    auto worker = [&]() {
+        for (;;) {
+            size_t b = nextBlock.fetch_add(1, std::memory_order_relaxed);
+            if (b >= nBlocks) {
+                return;
+            }
+            try {
+                size_t begin = b * blockSize;
+                fn(b, begin, std::min(begin + blockSize, count));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+                nextBlock.store(nBlocks, std::memory_order_relaxed);
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(nThreads - 1);
+    for (size_t t = 1; t < nThreads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool) {
+        th.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+/**
+ * @brief Run fn(i) for every i in [0, count) on a pool of threads
+ * @param count Number of items
+ * @param fn Callable fn(index)
+ * @param threads Worker thread count (0 = hardware concurrency)
+ *
+ * Items are scheduled one at a time, which suits coarse independent tasks
+ * (files, layers, parts). For fine-grained loops use parallelForBlocks().
+ */
+template<typename Fn>
+void parallelFor(size_t count, Fn&& fn, size_t threads = 0) {
+    parallelForBlocks(count, 1, [&fn](size_t, size_t begin, size_t) { fn(begin); }, threads);
+}
+
+} // namespace koo::util
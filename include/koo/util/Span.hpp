@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace koo::util {
+
+/**
+ * @brief Non-owning view of a contiguous array
+ *
+ * Minimal stand-in for C++20 std::span (the library targets C++17). The
+ * view is invalidated by anything that reallocates the underlying storage.
+ *
+ * Usage:
+ *   Span<const NodeId> nodes = elementManager.getNodeSpan(eid);
+ *   for (NodeId nid : nodes) { ... }
+ */
+template<typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept : data_(data), size_(size) {}
+
+    template<typename U, typename Alloc,
+             typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    Span(std::vector<U, Alloc>& v) noexcept : data_(v.data()), size_(v.size()) {}
+
+    template<typename U, typename Alloc,
+             typename = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    Span(const std::vector<U, Alloc>& v) noexcept : data_(v.data()), size_(v.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr T& operator[](size_t i) const { return data_[i]; }
+    constexpr T& front() const { return data_[0]; }
+    constexpr T& back() const { return data_[size_ - 1]; }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    /// Sub-view [offset, offset + count)
+    constexpr Span subspan(size_t offset, size_t count) const {
+        return Span(data_ + offset, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace koo::util
@@ -954,6 +954,18 @@ void ElementTshell::rebuildIndex() {
 // ElementShellThickness
 // ============================================================================
 
+double ShellThicknessData::getAverageThickness() const {
+    double sum = 0.0;
+    int count = 0;
+    for (double v : {thick1, thick2, thick3, thick4}) {
+        if (v > 0.0) {
+            sum += v;
+            ++count;
+        }
+    }
+    return count > 0 ? sum / count : 0.0;
+}
+
 bool ElementShellThickness::parse(const std::vector<std::string>& lines,
                                    util::CardParser::Format format) {
     util::CardParser parser(format);
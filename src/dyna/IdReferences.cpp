@@ -0,0 +1,1682 @@
+#include <koo/dyna/IdReferences.hpp>
+#include <koo/dyna/Airbag.hpp>
+#include <koo/dyna/Ale.hpp>
+#include <koo/dyna/Boundary.hpp>
+#include <koo/dyna/Cese.hpp>
+#include <koo/dyna/Chemistry.hpp>
+#include <koo/dyna/Constrained.hpp>
+#include <koo/dyna/Contact.hpp>
+#include <koo/dyna/Control.hpp>
+#include <koo/dyna/Damping.hpp>
+#include <koo/dyna/Database.hpp>
+#include <koo/dyna/Define.hpp>
+#include <koo/dyna/DeformableToRigid.hpp>
+#include <koo/dyna/Dualcese.hpp>
+#include <koo/dyna/Element.hpp>
+#include <koo/dyna/Em.hpp>
+#include <koo/dyna/Eos.hpp>
+#include <koo/dyna/Frequency.hpp>
+#include <koo/dyna/Hourglass.hpp>
+#include <koo/dyna/Icfd.hpp>
+#include <koo/dyna/Implicit.hpp>
+#include <koo/dyna/Include.hpp>
+#include <koo/dyna/Initial.hpp>
+#include <koo/dyna/Integration.hpp>
+#include <koo/dyna/Interface.hpp>
+#include <koo/dyna/Load.hpp>
+#include <koo/dyna/MatAdd.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Node.hpp>
+#include <koo/dyna/Parameter.hpp>
+#include <koo/dyna/Part.hpp>
+#include <koo/dyna/Perturbation.hpp>
+#include <koo/dyna/Rigidwall.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/dyna/Sensor.hpp>
+#include <koo/dyna/Set.hpp>
+#include <koo/dyna/Sph.hpp>
+#include <koo/dyna/Stochastic.hpp>
+#include <koo/dyna/Thermal.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace koo::dyna {
+
+namespace {
+
+using Accessor = IdReferenceMap::Accessor;
+
+void visitField(const IdFieldCallback& cb, IdKind kind, IdRole role, int64_t& field) {
+    cb(kind, role, field);
+}
+
+void visitField(const IdFieldCallback& cb, IdKind kind, IdRole role, int& field) {
+    int64_t id = field;
+    cb(kind, role, id);
+    field = static_cast<int>(id);
+}
+
+template<typename Field>
+void visitRef(const IdFieldCallback& cb, IdKind kind, Field& field) {
+    visitField(cb, kind, IdRole::Reference, field);
+}
+
+template<typename T>
+struct IsVector : std::false_type {};
+template<typename T, typename A>
+struct IsVector<std::vector<T, A>> : std::true_type {};
+
+/**
+ * @brief Accessor for a keyword whose IDs live in a vector of rows
+ * @param items Returns the row vector of a keyword
+ * @param row Visits the ID fields of one row
+ */
+template<typename T, typename Items, typename Row>
+Accessor rowAccessor(Items items, Row row) {
+    Accessor accessor;
+    accessor.itemCount = [items](Keyword& kw) {
+        return items(static_cast<T&>(kw)).size();
+    };
+    accessor.visit = [items, row](Keyword& kw, size_t begin, size_t end, const IdFieldCallback& cb) {
+        auto& rows = items(static_cast<T&>(kw));
+        for (size_t i = begin; i < end && i < rows.size(); ++i) {
+            row(rows[i], cb);
+        }
+    };
+    return accessor;
+}
+
+/**
+ * @brief Accessor for a keyword with a fixed set of ID fields
+ */
+template<typename T, typename Fields>
+Accessor singleAccessor(Fields fields) {
+    Accessor accessor;
+    accessor.itemCount = [](Keyword&) { return size_t{1}; };
+    accessor.visit = [fields](Keyword& kw, size_t begin, size_t end, const IdFieldCallback& cb) {
+        if (begin == 0 && end > 0) {
+            fields(static_cast<T&>(kw), cb);
+        }
+    };
+    return accessor;
+}
+
+/**
+ * @brief Accessor for a set: item 0 is the set ID, items 1..n the members
+ */
+template<typename T, typename Items, typename Row>
+Accessor setAccessor(IdKind setKind, Items items, Row row) {
+    Accessor accessor;
+    accessor.itemCount = [items](Keyword& kw) {
+        return items(static_cast<T&>(kw)).size() + 1;
+    };
+    accessor.visit = [setKind, items, row](Keyword& kw, size_t begin, size_t end,
+                                           const IdFieldCallback& cb) {
+        T& set = static_cast<T&>(kw);
+        if (begin == 0 && end > 0) {
+            int64_t sid = set.getSetId();
+            cb(setKind, IdRole::Definition, sid);
+            set.setSetId(static_cast<int>(sid));
+            begin = 1;
+        }
+        auto& rows = items(set);
+        for (size_t i = begin; i < end && i - 1 < rows.size(); ++i) {
+            row(rows[i - 1], cb);
+        }
+    };
+    return accessor;
+}
+
+// Keywords whose ID fields live in getData(): one struct or a vector of rows
+template<typename T, typename Row>
+void addDataOf(std::unordered_map<std::type_index, Accessor>& map, Row row) {
+    using Data = std::decay_t<decltype(std::declval<T&>().getData())>;
+    if constexpr (IsVector<Data>::value) {
+        map[std::type_index(typeid(T))] = rowAccessor<T>(
+            [](T& kw) -> auto& { return kw.getData(); }, row);
+    } else {
+        map[std::type_index(typeid(T))] = singleAccessor<T>([row](T& kw, const IdFieldCallback& cb) {
+            row(kw.getData(), cb);
+        });
+    }
+}
+
+template<typename... Ts, typename Row>
+void addData(std::unordered_map<std::type_index, Accessor>& map, Row row) {
+    (addDataOf<Ts>(map, row), ...);
+}
+
+// Keywords whose ID fields live in the row vector returned by items
+template<typename... Ts, typename Items, typename Row>
+void addRows(std::unordered_map<std::type_index, Accessor>& map, Items items, Row row) {
+    ((map[std::type_index(typeid(Ts))] = rowAccessor<Ts>(items, row)), ...);
+}
+
+// Keywords that hold no IDs of any kind
+template<typename... Ts>
+void addIdFree(std::unordered_map<std::type_index, Accessor>& map) {
+    Accessor accessor;
+    accessor.itemCount = [](Keyword&) { return size_t{0}; };
+    accessor.visit = [](Keyword&, size_t, size_t, const IdFieldCallback&) {};
+    ((map[std::type_index(typeid(Ts))] = accessor), ...);
+}
+
+template<typename T>
+void addElements(std::unordered_map<std::type_index, Accessor>& map) {
+    Accessor accessor = rowAccessor<T>(
+        [](T& kw) -> auto& { return kw.getElements(); },
+        [](auto& elem, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, elem.id);
+            visitField(cb, IdKind::Part, IdRole::Reference, elem.pid);
+            for (auto& nid : elem.nodeIds) {
+                visitField(cb, IdKind::Node, IdRole::Reference, nid);
+            }
+            if constexpr (std::is_same_v<std::decay_t<decltype(elem)>, BeamElementData>) {
+                visitField(cb, IdKind::Node, IdRole::Reference, elem.n3);
+            }
+        });
+    accessor.finish = [](Keyword& kw) { static_cast<T&>(kw).rebuildIndex(); };
+    map[std::type_index(typeid(T))] = std::move(accessor);
+}
+
+// Sets whose members are accessed through getNodes()
+template<typename T>
+void addNodeSet(std::unordered_map<std::type_index, Accessor>& map, IdKind memberKind) {
+    map[std::type_index(typeid(T))] = setAccessor<T>(IdKind::NodeSet,
+        [](T& kw) -> auto& { return kw.getNodes(); },
+        [memberKind](auto& id, const IdFieldCallback& cb) {
+            visitField(cb, memberKind, IdRole::Reference, id);
+        });
+}
+
+// Sets whose members are accessed through getElements()
+template<typename T>
+void addElementSet(std::unordered_map<std::type_index, Accessor>& map, IdKind memberKind) {
+    map[std::type_index(typeid(T))] = setAccessor<T>(IdKind::ElementSet,
+        [](T& kw) -> auto& { return kw.getElements(); },
+        [memberKind](auto& id, const IdFieldCallback& cb) {
+            visitField(cb, memberKind, IdRole::Reference, id);
+        });
+}
+
+// Sets whose members are accessed through getParts()
+template<typename T>
+void addPartSet(std::unordered_map<std::type_index, Accessor>& map, IdKind memberKind) {
+    map[std::type_index(typeid(T))] = setAccessor<T>(IdKind::PartSet,
+        [](T& kw) -> auto& { return kw.getParts(); },
+        [memberKind](auto& id, const IdFieldCallback& cb) {
+            visitField(cb, memberKind, IdRole::Reference, id);
+        });
+}
+
+template<typename T>
+void addSegmentSet(std::unordered_map<std::type_index, Accessor>& map) {
+    map[std::type_index(typeid(T))] = setAccessor<T>(IdKind::SegmentSet,
+        [](T& kw) -> auto& { return kw.getSegments(); },
+        [](auto& seg, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Node, IdRole::Reference, seg.n1);
+            visitField(cb, IdKind::Node, IdRole::Reference, seg.n2);
+            visitField(cb, IdKind::Node, IdRole::Reference, seg.n3);
+            visitField(cb, IdKind::Node, IdRole::Reference, seg.n4);
+        });
+}
+
+template<typename T, typename = void>
+struct HasNodeRange : std::false_type {};
+template<typename T>
+struct HasNodeRange<T, std::void_t<decltype(std::declval<T&>().nid1)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct HasPartRange : std::false_type {};
+template<typename T>
+struct HasPartRange<T, std::void_t<decltype(std::declval<T&>().pid1)>> : std::true_type {};
+
+// *_GENERATE sets: range end points (nid1/nid2, pid1/pid2 or eid1/eid2)
+template<typename T>
+void addGenerateSet(std::unordered_map<std::type_index, Accessor>& map, IdKind setKind, IdKind memberKind) {
+    map[std::type_index(typeid(T))] = setAccessor<T>(setKind,
+        [](T& kw) -> auto& { return kw.getRanges(); },
+        [memberKind](auto& range, const IdFieldCallback& cb) {
+            using Range = std::decay_t<decltype(range)>;
+            if constexpr (HasNodeRange<Range>::value) {
+                visitField(cb, memberKind, IdRole::Range, range.nid1);
+                visitField(cb, memberKind, IdRole::Range, range.nid2);
+            } else if constexpr (HasPartRange<Range>::value) {
+                visitField(cb, memberKind, IdRole::Range, range.pid1);
+                visitField(cb, memberKind, IdRole::Range, range.pid2);
+            } else {
+                visitField(cb, memberKind, IdRole::Range, range.eid1);
+                visitField(cb, memberKind, IdRole::Range, range.eid2);
+            }
+        });
+}
+
+// *_GENERAL / *_COLUMN sets: only the set ID is visited; the option cards
+// refer to the unmapped kinds
+template<typename T>
+void addSetHeader(std::unordered_map<std::type_index, Accessor>& map, IdKind setKind,
+                  std::vector<IdKind> unmapped) {
+    Accessor accessor = singleAccessor<T>([setKind](T& kw, const IdFieldCallback& cb) {
+        visitField(cb, setKind, IdRole::Definition, kw.getData().sid);
+    });
+    accessor.unmapped = std::move(unmapped);
+    map[std::type_index(typeid(T))] = std::move(accessor);
+}
+
+// *_INTERSECT sets: intersection of two sets of the same kind
+template<typename T>
+void addIntersectSet(std::unordered_map<std::type_index, Accessor>& map, IdKind setKind) {
+    map[std::type_index(typeid(T))] = singleAccessor<T>([setKind](T& kw, const IdFieldCallback& cb) {
+        auto& data = kw.getData();
+        visitField(cb, setKind, IdRole::Definition, data.sid);
+        visitField(cb, setKind, IdRole::Reference, data.sid1);
+        visitField(cb, setKind, IdRole::Reference, data.sid2);
+    });
+}
+
+// Part option keywords: getData().pid defines or references a part
+template<typename T>
+void addPartOption(std::unordered_map<std::type_index, Accessor>& map, IdRole role) {
+    map[std::type_index(typeid(T))] = singleAccessor<T>([role](T& kw, const IdFieldCallback& cb) {
+        visitField(cb, IdKind::Part, role, kw.getData().pid);
+    });
+}
+
+// Materials with load curve fields: the material ID and each listed curve
+template<typename T, typename... Curves>
+void addMaterial(std::unordered_map<std::type_index, Accessor>& map, Curves... curves) {
+    map[std::type_index(typeid(T))] = singleAccessor<T>([curves...](T& kw, const IdFieldCallback& cb) {
+        int64_t id = kw.getMaterialId();
+        cb(IdKind::Material, IdRole::Definition, id);
+        kw.setMaterialId(id);
+        (visitField(cb, IdKind::Curve, IdRole::Reference, kw.getData().*curves), ...);
+    });
+}
+
+template<typename T>
+void addCurve(std::unordered_map<std::type_index, Accessor>& map) {
+    map[std::type_index(typeid(T))] = singleAccessor<T>([](T& kw, const IdFieldCallback& cb) {
+        int64_t id = kw.getCurveId();
+        cb(IdKind::Curve, IdRole::Definition, id);
+        kw.setCurveId(static_cast<int>(id));
+    });
+}
+
+// Contact surfaces: SSTYP/MSTYP select what SSID/MSID refer to
+bool contactSurfaceKind(int type, IdKind& kind) {
+    switch (type) {
+        case 0: kind = IdKind::SegmentSet; return true;
+        case 1: kind = IdKind::ElementSet; return true;
+        case 2: kind = IdKind::PartSet; return true;
+        case 3: kind = IdKind::Part; return true;
+        case 4: kind = IdKind::NodeSet; return true;
+        case 6: kind = IdKind::PartSet; return true;
+        default: return false;
+    }
+}
+
+template<typename T, typename = void>
+struct HasContactSurfaces : std::false_type {};
+template<typename T>
+struct HasContactSurfaces<T, std::void_t<decltype(std::declval<T&>().getCard1().ssid),
+                                         decltype(std::declval<T&>().getCard1().msid),
+                                         decltype(std::declval<T&>().getCard1().sstyp),
+                                         decltype(std::declval<T&>().getCard1().mstyp)>>
+    : std::true_type {};
+
+template<typename T, typename = void>
+struct HasContactId : std::false_type {};
+template<typename T>
+struct HasContactId<T, std::void_t<decltype(std::declval<T&>().getIdCard().cid)>> : std::true_type {};
+
+template<typename T>
+void addContact(std::unordered_map<std::type_index, Accessor>& map) {
+    if constexpr (HasContactSurfaces<T>::value || HasContactId<T>::value) {
+        map[std::type_index(typeid(T))] = singleAccessor<T>([](T& kw, const IdFieldCallback& cb) {
+            if constexpr (HasContactId<T>::value) {
+                visitField(cb, IdKind::Contact, IdRole::Definition, kw.getIdCard().cid);
+            }
+            if constexpr (HasContactSurfaces<T>::value) {
+                auto& card = kw.getCard1();
+                IdKind kind;
+                if (contactSurfaceKind(card.sstyp, kind)) {
+                    visitField(cb, kind, IdRole::Reference, card.ssid);
+                }
+                if (contactSurfaceKind(card.mstyp, kind)) {
+                    visitField(cb, kind, IdRole::Reference, card.msid);
+                }
+            }
+        });
+    }
+}
+
+template<typename... Ts>
+void addContacts(std::unordered_map<std::type_index, Accessor>& map) {
+    (addContact<Ts>(map), ...);
+}
+
+} // anonymous namespace
+
+const char* idKindName(IdKind kind) {
+    switch (kind) {
+        case IdKind::Node: return "node";
+        case IdKind::Element: return "element";
+        case IdKind::Part: return "part";
+        case IdKind::Material: return "material";
+        case IdKind::Section: return "section";
+        case IdKind::NodeSet: return "node set";
+        case IdKind::PartSet: return "part set";
+        case IdKind::ElementSet: return "element set";
+        case IdKind::SegmentSet: return "segment set";
+        case IdKind::Curve: return "curve";
+        case IdKind::Contact: return "contact";
+        case IdKind::CoordinateSystem: return "coordinate system";
+        case IdKind::Hourglass: return "hourglass";
+        case IdKind::Eos: return "EOS";
+    }
+    return "unknown";
+}
+
+const IdReferenceMap& IdReferenceMap::defaults() {
+    static const IdReferenceMap instance = [] {
+        IdReferenceMap refs;
+        auto& map = refs.accessors_;
+
+        // Nodes
+        {
+            Accessor accessor = rowAccessor<Node>(
+                [](Node& kw) -> auto& { return kw.getNodes(); },
+                [](NodeData& node, const IdFieldCallback& cb) {
+                    visitField(cb, IdKind::Node, IdRole::Definition, node.id);
+                });
+            accessor.finish = [](Keyword& kw) { static_cast<Node&>(kw).rebuildIndex(); };
+            map[std::type_index(typeid(Node))] = std::move(accessor);
+        }
+        addData<NodeTransform>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<NodeMerge, NodeThicknessSetGenerate>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+        });
+        addData<NodeMergeSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid1);
+            visitRef(cb, IdKind::NodeSet, data.nsid2);
+        });
+        addRows<NodeScalar, NodeThickness>(map,
+            [](auto& kw) -> auto& { return kw.getNodes(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+            });
+        addRows<NodeToTarget, NodeRigidSurface, NodeScalarValue, NodeToTargetVector>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+            });
+        addRows<NodeRigidBody>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::Node, row.nid);
+            });
+        addRows<NodeSpotWeld>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::NodeSet, row.nsid1);
+                visitRef(cb, IdKind::NodeSet, row.nsid2);
+            });
+        addRows<NodeReference>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addRows<NodeThicknessSet>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+            });
+        addIdFree<NodeMergeTolerance>(map);
+
+        // Elements
+        addElements<ElementShell>(map);
+        addElements<ElementSolid>(map);
+        addElements<ElementBeam>(map);
+        addElements<ElementDiscrete>(map);
+        addElements<ElementSeatbelt>(map);
+        addElements<ElementMass>(map);
+        addElements<ElementInertia>(map);
+        addElements<ElementTshell>(map);
+        map[std::type_index(typeid(ElementShellThickness))] = rowAccessor<ElementShellThickness>(
+            [](ElementShellThickness& kw) -> auto& { return kw.getThicknessData(); },
+            [](ShellThicknessData& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Element, IdRole::Reference, row.eid);
+            });
+        map[std::type_index(typeid(ElementBeamOrientation))] = rowAccessor<ElementBeamOrientation>(
+            [](ElementBeamOrientation& kw) -> auto& { return kw.getOrientationData(); },
+            [](BeamOrientationData& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, row.eid);
+            });
+        addData<ElementSolidOrtho, ElementGeneralizedShell>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, data.eid);
+            visitRef(cb, IdKind::Part, data.pid);
+            for (NodeId* nid : {&data.n1, &data.n2, &data.n3, &data.n4,
+                                &data.n5, &data.n6, &data.n7, &data.n8}) {
+                visitRef(cb, IdKind::Node, *nid);
+            }
+        });
+        addData<ElementShellComposite, ElementInterpolationShell,
+                ElementShellSourceSink>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, data.eid);
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Node, data.n3);
+            visitRef(cb, IdKind::Node, data.n4);
+        });
+        addData<ElementLancing>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, data.eid);
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Node, data.n3);
+            visitRef(cb, IdKind::Node, data.n4);
+        });
+        addData<ElementBeamPulley, ElementTrim>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, data.eid);
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Node, data.n3);
+        });
+        addData<ElementPlotel>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, data.id);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+        });
+        addData<ElementBearing>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Element, IdRole::Definition, data.id);
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+        });
+        addData<ElementSeatbeltSlipring>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Node, data.n3);
+        });
+        addData<ElementSeatbeltAccelerometer>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.nid);
+        });
+        addData<ElementSeatbeltRetractor>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.nid);
+            visitRef(cb, IdKind::Curve, data.llcid);
+        });
+        addData<ElementMassNodeSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+        addData<ElementMassPartSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addIdFree<ElementSeatbeltPretensioner, ElementSeatbeltSensor, ElementDirectMatrixInput>(map);
+
+        // Parts
+        {
+            Accessor accessor = rowAccessor<Part>(
+                [](Part& kw) -> auto& { return kw.getParts(); },
+                [](PartData& part, const IdFieldCallback& cb) {
+                    visitField(cb, IdKind::Part, IdRole::Definition, part.id);
+                    visitField(cb, IdKind::Section, IdRole::Reference, part.secid);
+                    visitField(cb, IdKind::Material, IdRole::Reference, part.mid);
+                    visitField(cb, IdKind::Eos, IdRole::Reference, part.eosid);
+                    visitField(cb, IdKind::Hourglass, IdRole::Reference, part.hgid);
+                });
+            accessor.finish = [](Keyword& kw) { static_cast<Part&>(kw).rebuildIndex(); };
+            map[std::type_index(typeid(Part))] = std::move(accessor);
+        }
+        map[std::type_index(typeid(PartInertia))] = singleAccessor<PartInertia>(
+            [](PartInertia& kw, const IdFieldCallback& cb) {
+                auto& data = kw.getData();
+                visitField(cb, IdKind::Part, IdRole::Definition, data.pid);
+                visitField(cb, IdKind::Section, IdRole::Reference, data.secid);
+                visitField(cb, IdKind::Material, IdRole::Reference, data.mid);
+                visitField(cb, IdKind::Eos, IdRole::Reference, data.eosid);
+                visitField(cb, IdKind::Hourglass, IdRole::Reference, data.hgid);
+                visitField(cb, IdKind::Node, IdRole::Reference, data.nodeid);
+            });
+
+        map[std::type_index(typeid(PartAveraged))] = singleAccessor<PartAveraged>(
+            [](PartAveraged& kw, const IdFieldCallback& cb) {
+                auto& data = kw.getData();
+                visitField(cb, IdKind::Part, IdRole::Definition, data.pid);
+                visitField(cb, IdKind::Section, IdRole::Reference, data.secid);
+                visitField(cb, IdKind::Material, IdRole::Reference, data.mid);
+                visitField(cb, IdKind::Eos, IdRole::Reference, data.eosid);
+                visitField(cb, IdKind::Hourglass, IdRole::Reference, data.hgid);
+            });
+        map[std::type_index(typeid(PartDuplicate))] = singleAccessor<PartDuplicate>(
+            [](PartDuplicate& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Part, IdRole::Definition, kw.getData().pid);
+                visitField(cb, IdKind::Part, IdRole::Reference, kw.getData().pidcopy);
+            });
+        addPartOption<PartContact>(map, IdRole::Definition);
+        addPartOption<PartStackedElements>(map, IdRole::Definition);
+        addPartOption<PartAdaptiveFailure>(map, IdRole::Reference);
+        addPartOption<PartAnneal>(map, IdRole::Reference);
+        addPartOption<PartModes>(map, IdRole::Reference);
+        addPartOption<PartSensor>(map, IdRole::Reference);
+        addData<PartComposite, PartCompositeTshell>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Part, IdRole::Definition, data.pid);
+            visitRef(cb, IdKind::Hourglass, data.hgid);
+        });
+        addData<PartMove>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<PartStiffness>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<PartsetDistribute>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addIdFree<PartsDistribute, ParticleBlast>(map);
+
+        // Materials and sections (resolved through their base classes unless listed below)
+        refs.materialAccessor_ = singleAccessor<MaterialBase>([](MaterialBase& kw, const IdFieldCallback& cb) {
+            int64_t id = kw.getMaterialId();
+            cb(IdKind::Material, IdRole::Definition, id);
+            kw.setMaterialId(id);
+        });
+        refs.sectionAccessor_ = singleAccessor<SectionBase>([](SectionBase& kw, const IdFieldCallback& cb) {
+            int64_t id = kw.getSectionId();
+            cb(IdKind::Section, IdRole::Definition, id);
+            kw.setSectionId(id);
+        });
+
+        // Material load curves
+        addMaterial<MatPiecewiseLinearPlasticity>(map,
+            &MatPiecewiseLinearPlasticity::Data::lcss, &MatPiecewiseLinearPlasticity::Data::lcsr);
+        addMaterial<MatModifiedPiecewiseLinearPlasticity>(map,
+            &MatModifiedPiecewiseLinearPlasticity::Data::lcss,
+            &MatModifiedPiecewiseLinearPlasticity::Data::lcsr);
+        addMaterial<MatLowDensityFoam>(map, &MatLowDensityFoam::Data::lcid);
+        addMaterial<MatLaminatedCompositeFabric>(map,
+            &MatLaminatedCompositeFabric::Data::lcxc, &MatLaminatedCompositeFabric::Data::lcxt,
+            &MatLaminatedCompositeFabric::Data::lcyc, &MatLaminatedCompositeFabric::Data::lcyt,
+            &MatLaminatedCompositeFabric::Data::lcsc);
+        addMaterial<MatElasticPlasticThermal>(map,
+            &MatElasticPlasticThermal::Data::lcss, &MatElasticPlasticThermal::Data::lcth);
+        addMaterial<MatSoilAndFoam>(map, &MatSoilAndFoam::Data::lcid);
+        addMaterial<MatPlasticityWithDamage>(map,
+            &MatPlasticityWithDamage::Data::lcss, &MatPlasticityWithDamage::Data::lcsr);
+        addMaterial<MatSamp1>(map,
+            &MatSamp1::Data::lcid_t, &MatSamp1::Data::lcid_c, &MatSamp1::Data::lcid_s,
+            &MatSamp1::Data::lcid_b);
+        addMaterial<MatOrthoElasticPlastic>(map, &MatOrthoElasticPlastic::Data::lcid);
+        addMaterial<MatForceLimited>(map, &MatForceLimited::Data::lcid);
+        addMaterial<MatBarlatAnisotropicPlasticity>(map, &MatBarlatAnisotropicPlasticity::Data::lcid);
+        addMaterial<MatSpringNonlinearElastic>(map, &MatSpringNonlinearElastic::Data::lcid);
+        addMaterial<MatSpringElastoplastic>(map, &MatSpringElastoplastic::Data::lcid);
+        addMaterial<MatSpringGeneralNonlinear>(map,
+            &MatSpringGeneralNonlinear::Data::lcidl, &MatSpringGeneralNonlinear::Data::lcidu);
+        addMaterial<MatFuChangFoam>(map, &MatFuChangFoam::Data::lcid);
+        addMaterial<MatPlasticGreenNaghdi>(map, &MatPlasticGreenNaghdi::Data::lcss);
+        addMaterial<Mat3ParameterBarlat>(map, &Mat3ParameterBarlat::Data::lcss);
+        addMaterial<MatTransverselyAnisotropicElasticPlastic>(map,
+            &MatTransverselyAnisotropicElasticPlastic::Data::hlcid);
+        addMaterial<MatFldTransverselyAnisotropic>(map,
+            &MatFldTransverselyAnisotropic::Data::hlcid, &MatFldTransverselyAnisotropic::Data::fld);
+        addMaterial<MatViscousFoam>(map, &MatViscousFoam::Data::lcid);
+        addMaterial<MatViscoelasticThermal>(map, &MatViscoelasticThermal::Data::lcte);
+        addMaterial<MatBilkhuDuboisFoam>(map, &MatBilkhuDuboisFoam::Data::lcid);
+        addMaterial<MatGeneralViscoelastic>(map,
+            &MatGeneralViscoelastic::Data::lcg, &MatGeneralViscoelastic::Data::lck);
+        addMaterial<MatPiecewiseLinearPlasticityStochastic>(map,
+            &MatPiecewiseLinearPlasticityStochastic::Data::lcss);
+        addMaterial<MatSimplifiedRubber>(map, &MatSimplifiedRubber::Data::sigf);
+        addMaterial<MatTabulatedJohnsonCook>(map,
+            &MatTabulatedJohnsonCook::Data::lcss, &MatTabulatedJohnsonCook::Data::lcts);
+        addMaterial<MatAnisotropicViscoplastic>(map, &MatAnisotropicViscoplastic::Data::lcss);
+        addMaterial<MatDamage3>(map, &MatDamage3::Data::lcss);
+        addMaterial<MatSpringInelastic>(map, &MatSpringInelastic::Data::lcid, &MatSpringInelastic::Data::lcu);
+        addMaterial<MatDamperNonlinearViscous>(map, &MatDamperNonlinearViscous::Data::lcdr);
+        addMaterial<MatHystereticBeam>(map,
+            &MatHystereticBeam::Data::lcpms, &MatHystereticBeam::Data::lcpma,
+            &MatHystereticBeam::Data::lcnms, &MatHystereticBeam::Data::lcnma);
+
+        // Node sets
+        addNodeSet<SetNode>(map, IdKind::Node);
+        addNodeSet<SetNodeList>(map, IdKind::Node);
+        addNodeSet<SetNodeListTitle>(map, IdKind::Node);
+        addNodeSet<SetNodeTitle>(map, IdKind::Node);
+        addNodeSet<SetNodeAdd>(map, IdKind::NodeSet);
+        addGenerateSet<SetNodeGenerate>(map, IdKind::NodeSet, IdKind::Node);
+        addGenerateSet<SetNodeGenerateTitle>(map, IdKind::NodeSet, IdKind::Node);
+        addSetHeader<SetNodeGeneral>(map, IdKind::NodeSet, {IdKind::Node, IdKind::Part, IdKind::ElementSet});
+        addSetHeader<SetNodeColumn>(map, IdKind::NodeSet, {IdKind::Node});
+        addIntersectSet<SetNodeIntersect>(map, IdKind::NodeSet);
+
+        // Part sets
+        addPartSet<SetPart>(map, IdKind::Part);
+        addPartSet<SetPartList>(map, IdKind::Part);
+        addPartSet<SetPartListTitle>(map, IdKind::Part);
+        addPartSet<SetPartTitle>(map, IdKind::Part);
+        addPartSet<SetPartAdd>(map, IdKind::PartSet);
+        addGenerateSet<SetPartGenerate>(map, IdKind::PartSet, IdKind::Part);
+        addGenerateSet<SetPartGenerateTitle>(map, IdKind::PartSet, IdKind::Part);
+        addGenerateSet<SetPartListGenerate>(map, IdKind::PartSet, IdKind::Part);
+        addSetHeader<SetPartGeneral>(map, IdKind::PartSet, {IdKind::Part});
+        addSetHeader<SetPartColumn>(map, IdKind::PartSet, {IdKind::Part});
+        addIntersectSet<SetPartIntersect>(map, IdKind::PartSet);
+
+        // Element sets
+        addElementSet<SetShell>(map, IdKind::Element);
+        addElementSet<SetShellList>(map, IdKind::Element);
+        addElementSet<SetShellListTitle>(map, IdKind::Element);
+        addElementSet<SetSolid>(map, IdKind::Element);
+        addElementSet<SetSolidList>(map, IdKind::Element);
+        addElementSet<SetSolidListTitle>(map, IdKind::Element);
+        addElementSet<SetBeam>(map, IdKind::Element);
+        addElementSet<SetBeamList>(map, IdKind::Element);
+        addElementSet<SetBeamListTitle>(map, IdKind::Element);
+        addElementSet<SetDiscrete>(map, IdKind::Element);
+        addElementSet<SetDiscreteList>(map, IdKind::Element);
+        addElementSet<SetDiscreteListTitle>(map, IdKind::Element);
+        addElementSet<SetTshell>(map, IdKind::Element);
+        addElementSet<SetTshellList>(map, IdKind::Element);
+        addElementSet<Set2dShell>(map, IdKind::Element);
+        addElementSet<SetSeatbelt>(map, IdKind::Element);
+        addElementSet<SetShellAdd>(map, IdKind::ElementSet);
+        addElementSet<SetSolidAdd>(map, IdKind::ElementSet);
+        addElementSet<SetBeamAdd>(map, IdKind::ElementSet);
+        addElementSet<SetDiscreteAdd>(map, IdKind::ElementSet);
+        addGenerateSet<SetShellGenerate>(map, IdKind::ElementSet, IdKind::Element);
+        addGenerateSet<SetShellGenerateTitle>(map, IdKind::ElementSet, IdKind::Element);
+        addGenerateSet<SetSolidGenerate>(map, IdKind::ElementSet, IdKind::Element);
+        addGenerateSet<SetSolidGenerateTitle>(map, IdKind::ElementSet, IdKind::Element);
+        addGenerateSet<SetBeamGenerate>(map, IdKind::ElementSet, IdKind::Element);
+        addGenerateSet<SetBeamGenerateTitle>(map, IdKind::ElementSet, IdKind::Element);
+        addSetHeader<SetShellGeneral>(map, IdKind::ElementSet, {IdKind::Element, IdKind::Part});
+        addSetHeader<SetSolidGeneral>(map, IdKind::ElementSet, {IdKind::Element, IdKind::Part});
+        addSetHeader<SetBeamGeneral>(map, IdKind::ElementSet, {IdKind::Element, IdKind::Part});
+        addSetHeader<SetDiscreteGeneral>(map, IdKind::ElementSet, {IdKind::Element, IdKind::Part});
+        addSetHeader<SetTshellGeneral>(map, IdKind::ElementSet, {IdKind::Element, IdKind::Part});
+        addIntersectSet<SetShellIntersect>(map, IdKind::ElementSet);
+        addIntersectSet<SetSolidIntersect>(map, IdKind::ElementSet);
+        addIntersectSet<SetBeamIntersect>(map, IdKind::ElementSet);
+
+        // Segment sets
+        addSegmentSet<SetSegment>(map);
+        addSegmentSet<SetSegmentTitle>(map);
+        addSegmentSet<SetSegmentAdd>(map);
+        addIntersectSet<SetSegmentIntersect>(map, IdKind::SegmentSet);
+
+        // Curves
+        addCurve<DefineCurve>(map);
+        addCurve<DefineCurveTitle>(map);
+        addCurve<DefineCurveSmooth>(map);
+        map[std::type_index(typeid(DefineCurveFunction))] = singleAccessor<DefineCurveFunction>(
+            [](DefineCurveFunction& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Curve, IdRole::Definition, kw.getData().lcid);
+            });
+        map[std::type_index(typeid(DefineCurveCompensated))] = singleAccessor<DefineCurveCompensated>(
+            [](DefineCurveCompensated& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Curve, IdRole::Definition, kw.getData().lcid);
+            });
+        map[std::type_index(typeid(DefineCurveDuplicate))] = singleAccessor<DefineCurveDuplicate>(
+            [](DefineCurveDuplicate& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Curve, IdRole::Definition, kw.getData().newlcid);
+                visitField(cb, IdKind::Curve, IdRole::Reference, kw.getData().oldlcid);
+            });
+
+        // Tables share the load curve ID namespace
+        map[std::type_index(typeid(DefineTable))] = singleAccessor<DefineTable>(
+            [](DefineTable& kw, const IdFieldCallback& cb) {
+                int64_t id = kw.getTableId();
+                cb(IdKind::Curve, IdRole::Definition, id);
+                kw.setTableId(static_cast<int>(id));
+                for (auto& entry : kw.getEntries()) {
+                    visitField(cb, IdKind::Curve, IdRole::Reference, entry.lcid);
+                }
+            });
+        map[std::type_index(typeid(DefineTable2D))] = singleAccessor<DefineTable2D>(
+            [](DefineTable2D& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Curve, IdRole::Definition, kw.getData().id);
+            });
+        map[std::type_index(typeid(DefineTable3D))] = singleAccessor<DefineTable3D>(
+            [](DefineTable3D& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Curve, IdRole::Definition, kw.getData().id);
+            });
+
+        // Coordinate systems
+        map[std::type_index(typeid(DefineCoordinateNodes))] = singleAccessor<DefineCoordinateNodes>(
+            [](DefineCoordinateNodes& kw, const IdFieldCallback& cb) {
+                auto& data = kw.getData();
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Definition, data.cid);
+                visitField(cb, IdKind::Node, IdRole::Reference, data.n1);
+                visitField(cb, IdKind::Node, IdRole::Reference, data.n2);
+                visitField(cb, IdKind::Node, IdRole::Reference, data.n3);
+            });
+        map[std::type_index(typeid(DefineCoordinateVector))] = singleAccessor<DefineCoordinateVector>(
+            [](DefineCoordinateVector& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Definition, kw.getData().cid);
+            });
+        map[std::type_index(typeid(DefineCoordinateSystem))] = singleAccessor<DefineCoordinateSystem>(
+            [](DefineCoordinateSystem& kw, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Definition, kw.getData().cid);
+            });
+
+        // Contacts
+        addContacts<
+            ContactAutomaticSingleSurface, ContactAutomaticSurfaceToSurface,
+            ContactAutomaticNodesToSurface, ContactAutomaticGeneral,
+            ContactSurfaceToSurface, ContactNodesToSurface,
+            ContactTiedNodesToSurface, ContactTiedSurfaceToSurface,
+            ContactSpotweld, ContactRigidBodyOneWay,
+            ContactErodingSingleSurface, ContactErodingSurfaceToSurface,
+            ContactErodingNodesToSurface, ContactFormingOneWaySurfaceToSurface,
+            ContactInterior, ContactAutomaticSingleSurfaceMortar,
+            ContactAutomaticSurfaceToSurfaceMortar, ContactTiedShellEdgeToSurface,
+            ContactDrawbead, ContactForceTransducerPenalty,
+            Contact2dAutomaticSingleSurface, ContactGebodSegment,
+            ContactAutomaticSurfaceToSurfaceTiebreak, ContactAutomaticSingleSurfaceId,
+            ContactEntity, ContactAutomaticSurfaceToSurfaceId,
+            ContactFormingSurfaceToSurface, ContactSingleSurface,
+            ContactAutomaticBeamsToSurface, ContactTiedShellEdgeToSolid,
+            ContactRigidBodyTwoWay, ContactAutomaticNodesToSurfaceId,
+            ContactAirbagSingleSurface, ContactGuidedCable,
+            ContactTiebreakNodesToSurface, ContactTiebreakSurfaceToSurface,
+            ContactSlidingOnlyPenalty, ContactOption,
+            ContactAddWear, Contact2DAutomaticSurfaceToSurface,
+            Contact2DNodesToSurface
+        >(map);
+
+        // Boundary conditions
+        map[std::type_index(typeid(BoundarySpcNode))] = rowAccessor<BoundarySpcNode>(
+            [](BoundarySpcNode& kw) -> auto& { return kw.getConstraints(); },
+            [](SpcData& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Node, IdRole::Reference, row.nid);
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Reference, row.cid);
+            });
+        map[std::type_index(typeid(BoundarySpcSet))] = rowAccessor<BoundarySpcSet>(
+            [](BoundarySpcSet& kw) -> auto& { return kw.getConstraints(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::NodeSet, IdRole::Reference, row.nsid);
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Reference, row.cid);
+            });
+        map[std::type_index(typeid(BoundaryPrescribedMotionNode))] = rowAccessor<BoundaryPrescribedMotionNode>(
+            [](BoundaryPrescribedMotionNode& kw) -> auto& { return kw.getMotions(); },
+            [](PrescribedMotionData& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Node, IdRole::Reference, row.id);
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+            });
+        map[std::type_index(typeid(BoundaryPrescribedMotionSet))] = rowAccessor<BoundaryPrescribedMotionSet>(
+            [](BoundaryPrescribedMotionSet& kw) -> auto& { return kw.getMotions(); },
+            [](PrescribedMotionData& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::NodeSet, IdRole::Reference, row.id);
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+            });
+
+        // Loads
+        map[std::type_index(typeid(LoadNodePoint))] = rowAccessor<LoadNodePoint>(
+            [](LoadNodePoint& kw) -> auto& { return kw.getLoads(); },
+            [](NodeLoadData& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Node, IdRole::Reference, row.nid);
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Reference, row.cid);
+            });
+        map[std::type_index(typeid(LoadNodeSet))] = rowAccessor<LoadNodeSet>(
+            [](LoadNodeSet& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::NodeSet, IdRole::Reference, row.nsid);
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+                visitField(cb, IdKind::CoordinateSystem, IdRole::Reference, row.cid);
+            });
+        map[std::type_index(typeid(LoadSegment))] = rowAccessor<LoadSegment>(
+            [](LoadSegment& kw) -> auto& { return kw.getLoads(); },
+            [](SegmentLoadData& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+                visitField(cb, IdKind::Node, IdRole::Reference, row.n1);
+                visitField(cb, IdKind::Node, IdRole::Reference, row.n2);
+                visitField(cb, IdKind::Node, IdRole::Reference, row.n3);
+                visitField(cb, IdKind::Node, IdRole::Reference, row.n4);
+            });
+        map[std::type_index(typeid(LoadSegmentSet))] = rowAccessor<LoadSegmentSet>(
+            [](LoadSegmentSet& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::SegmentSet, IdRole::Reference, row.ssid);
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+            });
+        map[std::type_index(typeid(LoadShellSet))] = rowAccessor<LoadShellSet>(
+            [](LoadShellSet& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitField(cb, IdKind::ElementSet, IdRole::Reference, row.esid);
+                visitField(cb, IdKind::Curve, IdRole::Reference, row.lcid);
+            });
+        auto bodyLoad = [](auto& kw, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Curve, IdRole::Reference, kw.getData().lcid);
+            visitField(cb, IdKind::Curve, IdRole::Reference, kw.getData().lciddr);
+        };
+        map[std::type_index(typeid(LoadBodyX))] = singleAccessor<LoadBodyX>(bodyLoad);
+        map[std::type_index(typeid(LoadBodyY))] = singleAccessor<LoadBodyY>(bodyLoad);
+        map[std::type_index(typeid(LoadBodyZ))] = singleAccessor<LoadBodyZ>(bodyLoad);
+
+
+        // Boundary conditions and loads without a dedicated accessor above
+        map[std::type_index(typeid(BoundaryPrescribedMotionRigid))] = rowAccessor<BoundaryPrescribedMotionRigid>(
+            [](BoundaryPrescribedMotionRigid& kw) -> auto& { return kw.getMotions(); },
+            [](PrescribedMotionData& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.id);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryThermalNode>(map,
+            [](auto& kw) -> auto& { return kw.getConstraints(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryThermalSet>(map,
+            [](auto& kw) -> auto& { return kw.getConstraints(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryConvectionSet>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::SegmentSet, row.ssid);
+                visitRef(cb, IdKind::Curve, row.hlcid);
+                visitRef(cb, IdKind::Curve, row.tlcid);
+            });
+        addRows<BoundaryRadiationSet>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::SegmentSet, row.ssid);
+                visitRef(cb, IdKind::Curve, row.elcid);
+                visitRef(cb, IdKind::Curve, row.tlcid);
+            });
+        addRows<BoundaryFluxSet>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::SegmentSet, row.ssid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryNonReflecting, BoundaryNonReflecting2D, BoundarySphNoslip>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::SegmentSet, row.ssid);
+            });
+        addRows<BoundarySpcSetBirthDeath>(map,
+            [](auto& kw) -> auto& { return kw.getConstraints(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addRows<BoundaryPrescribedMotionSetBox, BoundaryPrescribedMotionSetLine>(map,
+            [](auto& kw) -> auto& { return kw.getMotions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addData<BoundaryCyclic>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid1);
+            visitRef(cb, IdKind::NodeSet, data.nsid2);
+            visitRef(cb, IdKind::Node, data.nid);
+        });
+        addRows<BoundarySlidingPlane, BoundaryPrescribedAccelerometer, BoundarySymmetryFailure>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+            });
+        addData<BoundaryAmbientEos>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::Eos, data.eos);
+        });
+        addRows<BoundaryFluxTrajectory>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::SegmentSet, row.ssid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addData<BoundaryPap, BoundaryAcousticImpedance, BoundarySphFlow, BoundaryPressureOutflow,
+                BoundarySaleMeshFace>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<BoundaryPrescribedOrientationRigid>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<BoundarySpcSymmetryPlane>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+        });
+        addData<BoundaryPrecrack>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Node, data.n3);
+            visitRef(cb, IdKind::Node, data.n4);
+        });
+        addData<BoundaryMcol>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addData<BoundaryPrescribedFinalGeometry>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<BoundarySphNonReflecting, BoundaryAcousticFreeSurface,
+                BoundaryAcousticNonReflecting, BoundaryAcousticMapping, BoundaryAleMapping,
+                BoundaryAmbient, BoundaryDeNonReflecting, BoundaryElementMethod, BoundaryUsaSurface,
+                BoundaryFluidmFreeSurface>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+        });
+        addData<BoundaryAcousticCoupling,
+                BoundaryCoupled>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addRows<BoundaryPoreFluid, BoundaryPwp, BoundaryPzepot, BoundaryTemperatureRsw,
+                BoundaryThermalWeld>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryPrescribedMotionRigidLocal>(map,
+            [](auto& kw) -> auto& { return kw.getMotions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryPwpNode, BoundaryThermalBulknode>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryRadiationSegment>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.n1);
+                visitRef(cb, IdKind::Node, row.n2);
+                visitRef(cb, IdKind::Node, row.n3);
+                visitRef(cb, IdKind::Node, row.n4);
+                visitRef(cb, IdKind::Curve, row.elcid);
+                visitRef(cb, IdKind::Curve, row.tlcid);
+            });
+        addRows<BoundarySpc>(map,
+            [](auto& kw) -> auto& { return kw.getConstraints(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addRows<BoundarySphPeriodic>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::SegmentSet, row.ssid1);
+                visitRef(cb, IdKind::SegmentSet, row.ssid2);
+            });
+        addRows<BoundaryTemperatureTrajectory, BoundaryThermalWeldTrajectory>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<BoundaryPrescribedAccelerometerRigid>(map,
+            [](auto& kw) -> auto& { return kw.getConditions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+            });
+        addRows<BoundaryPrescribedMotionNodeId>(map,
+            [](auto& kw) -> auto& { return kw.getMotions(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addIdFree<BoundarySphSymmetryPlane, BoundaryElementMethodControl>(map);
+        addRows<LoadRigidBody>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addData<LoadThermalVariable, LoadHeatController, LoadPze, LoadThermalLoadCurve,
+                LoadThermalRsw, LoadLanczos, LoadRail, LoadMotionNodeSet,
+                LoadSpcSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addRows<LoadMotionNode>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<LoadBeamSet>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::ElementSet, row.bsid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addData<LoadBodyParts, LoadBodyPorous, LoadSsa,
+                LoadBodyPartSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+            visitRef(cb, IdKind::Curve, data.lcidx);
+            visitRef(cb, IdKind::Curve, data.lcidy);
+            visitRef(cb, IdKind::Curve, data.lcidz);
+        });
+        addData<LoadThermalConstant, LoadSeismic>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+        });
+        addData<LoadGravityPart>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<LoadDensityDepth, LoadRemovePart>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+        addData<LoadSeismicSsi, LoadBrode, LoadMask, LoadBlastSegmentSet, LoadSegmentFile,
+                LoadSeismicSsiAux>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+        });
+        addData<LoadSpcForce>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<LoadSurfaceStress>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::Curve, data.lcidxx);
+            visitRef(cb, IdKind::Curve, data.lcidyy);
+            visitRef(cb, IdKind::Curve, data.lcidzz);
+            visitRef(cb, IdKind::Curve, data.lcidxy);
+            visitRef(cb, IdKind::Curve, data.lcidyz);
+            visitRef(cb, IdKind::Curve, data.lcidzx);
+        });
+        addData<LoadMovingPressure>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::Curve, data.lcidv);
+        });
+        addData<LoadThermalBinout,
+                LoadThermalD3plot>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addData<LoadErodingPartSet,
+                LoadSteadyStateRolling>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<LoadHeatGenerationSet, LoadSuperplasticForming, LoadExpansionPressure,
+                LoadHeatExothermicReaction, LoadStiffenPart, LoadVolumeLoss, LoadDensity,
+                LoadSsaGravity, LoadInteriorPressure, LoadAirbagPressure, LoadThermalBody,
+                LoadAirmix>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<LoadSegmentNonuniform>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::Curve, data.lcidn1);
+            visitRef(cb, IdKind::Curve, data.lcidn2);
+            visitRef(cb, IdKind::Curve, data.lcidn3);
+            visitRef(cb, IdKind::Curve, data.lcidn4);
+        });
+        addData<LoadAleConvection, LoadSegmentData, LoadFluidPressure, LoadPressurePenetration,
+                LoadWave, LoadSurfaceStressSegment, LoadRadiation, LoadConvection, LoadHeatFlux,
+                LoadSegmentPressure>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::SegmentSet, data.ssid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<LoadNegativeVolume>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addData<LoadAcousticSource, LoadThermalVariableNode,
+                LoadSpc>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.nid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addRows<LoadBeam>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, row.eid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addData<LoadBodyGeneralized>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addRows<LoadHeatGeneration, LoadShellElement>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, row.eid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+            });
+        addRows<LoadNode>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+                visitRef(cb, IdKind::CoordinateSystem, row.cid);
+            });
+        addRows<LoadSegmentSetAngle>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::SegmentSet, row.ssid);
+                visitRef(cb, IdKind::Curve, row.lcid);
+                visitRef(cb, IdKind::Curve, row.lcang);
+            });
+        addData<LoadThermalTopaz, LoadBodyVector, LoadGravity, LoadBodyRx, LoadBodyRy, LoadBodyRz,
+                LoadThermalTopaz3d>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<LoadThermalVariableBeam>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::ElementSet, data.bsid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<LoadThermalVariableShell, LoadThermalVariableSolid,
+                LoadThermalVariableTshell>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::ElementSet, data.esid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addRows<LoadSegmentId>(map,
+            [](auto& kw) -> auto& { return kw.getLoads(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Curve, row.lcid);
+                visitRef(cb, IdKind::Node, row.n1);
+                visitRef(cb, IdKind::Node, row.n2);
+                visitRef(cb, IdKind::Node, row.n3);
+                visitRef(cb, IdKind::Node, row.n4);
+            });
+        addData<LoadThermalConstantNode>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.nid);
+        });
+        addData<LoadThermalElement, LoadThermalVariableElement,
+                LoadSoftElement>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Element, data.eid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<LoadRigidBodyInertia, LoadTyrePress, LoadTrackTurn, LoadWheelPatch,
+                LoadPendulum>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<LoadBodyPart>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Curve, data.lcidx);
+            visitRef(cb, IdKind::Curve, data.lcidy);
+            visitRef(cb, IdKind::Curve, data.lcidz);
+        });
+        addIdFree<LoadBlastEnhanced, LoadBlast>(map);
+
+        // Constraints
+        addData<ConstrainedNodalRigidBody>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::Node, data.pnode);
+        });
+        addRows<ConstrainedExtraNodesNode>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::Node, row.nid);
+            });
+        addRows<ConstrainedExtraNodesSet>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+                visitRef(cb, IdKind::NodeSet, row.nsid);
+            });
+        addRows<ConstrainedRigidBodies>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pidm);
+                visitRef(cb, IdKind::Part, row.pids);
+            });
+        addData<ConstrainedJointSpherical, ConstrainedJointRevolute, ConstrainedJointCylindrical,
+                ConstrainedJointTranslational, ConstrainedJointUniversal,
+                ConstrainedJointPlanar>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pidb);
+            visitRef(cb, IdKind::Part, data.pida);
+            visitRef(cb, IdKind::Node, data.n1);
+            visitRef(cb, IdKind::Node, data.n2);
+            visitRef(cb, IdKind::Node, data.n3);
+            visitRef(cb, IdKind::Node, data.n4);
+            visitRef(cb, IdKind::Node, data.n5);
+            visitRef(cb, IdKind::Node, data.n6);
+        });
+        addRows<ConstrainedSpotweld>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.n1);
+                visitRef(cb, IdKind::Node, row.n2);
+            });
+        addData<ConstrainedJointStiffness>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcidph);
+            visitRef(cb, IdKind::Curve, data.lcidth);
+            visitRef(cb, IdKind::Curve, data.lcidps);
+            visitRef(cb, IdKind::Curve, data.lcidtq);
+        });
+        addData<ConstrainedShellToSolid>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.sset);
+            visitRef(cb, IdKind::ElementSet, data.mset);
+        });
+        addRows<ConstrainedGeneralizedWeldNode>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.n1);
+                visitRef(cb, IdKind::Node, row.n2);
+                visitRef(cb, IdKind::Node, row.n3);
+                visitRef(cb, IdKind::Node, row.n4);
+                visitRef(cb, IdKind::Node, row.n5);
+                visitRef(cb, IdKind::Node, row.n6);
+                visitRef(cb, IdKind::Node, row.n7);
+                visitRef(cb, IdKind::Node, row.n8);
+            });
+        addData<ConstrainedBeamInSolid>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::ElementSet, data.bsid);
+            visitRef(cb, IdKind::ElementSet, data.ssid);
+        });
+        addData<ConstrainedRigidBodyStoppers>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+        addData<ConstrainedNodeSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addRows<ConstrainedLinear>(map,
+            [](auto& kw) -> auto& { return kw.getConstraints(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                for (auto& term : row.terms) {
+                    visitRef(cb, IdKind::Node, term.nid);
+                }
+            });
+        addRows<ConstrainedGlobal>(map,
+            [](auto& kw) -> auto& { return kw.getEquations(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                for (auto& term : row.terms) {
+                    visitRef(cb, IdKind::Node, term.nid);
+                }
+            });
+        addData<ConstrainedInterpolation>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.dnid);
+            for (auto& node : data.independentNodes) {
+                visitRef(cb, IdKind::Node, node.first);
+            }
+        });
+        addData<ConstrainedLagrangeInSolid>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, data.sstyp == 1 ? IdKind::Part : IdKind::PartSet, data.slave);
+            visitRef(cb, data.mstyp == 1 ? IdKind::Part : IdKind::PartSet, data.master);
+        });
+        addData<ConstrainedTieBreak>(map, [](auto& data, const IdFieldCallback& cb) {
+            IdKind kind;
+            if (contactSurfaceKind(data.sstyp, kind)) {
+                visitRef(cb, kind, data.ssid);
+            }
+            if (contactSurfaceKind(data.mstyp, kind)) {
+                visitRef(cb, kind, data.msid);
+            }
+        });
+
+        // Initial conditions
+        addRows<InitialVelocity, InitialVelocityNode>(map,
+            [](auto& kw) -> auto& { return kw.getVelocities(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+            });
+        addData<InitialVelocityGeneration>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::NodeSet, data.nsidex);
+            visitRef(cb, IdKind::CoordinateSystem, data.icid);
+        });
+        addRows<InitialStressShell, InitialStressSolid, InitialStressBeam, InitialStressTshell>(map,
+            [](auto& kw) -> auto& { return kw.getStresses(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, row.eid);
+            });
+        addRows<InitialStrainShell, InitialStrainSolid>(map,
+            [](auto& kw) -> auto& { return kw.getStrains(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, row.eid);
+            });
+        addData<InitialFoamReferenceGeometry>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+            visitRef(cb, IdKind::Node, data.nid);
+        });
+        addData<InitialDetonation, InitialMomentum,
+                InitialAngularMomentum>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+        addRows<InitialAxialForceBeam, InitialHistorySolid, InitialHistoryShell,
+                InitialStressDiscrete, InitialInternalDofSolid>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, row.eid);
+            });
+        addRows<InitialAlePressure>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Part, row.pid);
+            });
+        addData<InitialVelocitySet, InitialImpulseMine,
+                InitialRotationalVelocity>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+        });
+        addData<InitialStressSection>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+            visitRef(cb, IdKind::Section, data.secid);
+        });
+        addRows<InitialHistoryNode, InitialSpcRotationAngle, InitialSphMassFraction>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, row.nid);
+            });
+        addData<InitialStressDepth, InitialPwpDepth,
+                InitialAleMapping>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addRows<InitialContactWear>(map,
+            [](auto& kw) -> auto& { return kw.getEntries(); },
+            [](auto& row, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Contact, row.cid);
+            });
+        addData<InitialVolumeFraction>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::ElementSet, data.esid);
+        });
+        addIdFree<InitialAirbagParticlePosition, InitialGasMixture, InitialVolumeFractionGeometry>(map);
+
+        // Rigid walls
+
+        addData<RigidwallPlanar, RigidwallGeometricFlat, RigidwallGeometricCylinder,
+                RigidwallGeometricSphere, RigidwallPlanarMoving, RigidwallPlanarFinite,
+                RigidwallPlanarForces, RigidwallGeometricCone, RigidwallPlanarOrtho,
+                RigidwallGeometricPrism, RigidwallGeometricTorus, RigidwallPlanarId,
+                RigidwallPlanarFiniteId,
+                RigidwallPlanarMovingFinite>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::NodeSet, data.nsidex);
+        });
+        addData<RigidwallPlanarMovingForces>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::NodeSet, data.nsidex);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<RigidwallGeometricCurved>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::NodeSet, data.nsidex);
+            visitRef(cb, IdKind::Curve, data.curveid);
+        });
+        addData<RigidwallGeometricMotion>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcidvx);
+            visitRef(cb, IdKind::Curve, data.lcidvy);
+            visitRef(cb, IdKind::Curve, data.lcidvz);
+            visitRef(cb, IdKind::Curve, data.lcidax);
+            visitRef(cb, IdKind::Curve, data.lciday);
+            visitRef(cb, IdKind::Curve, data.lcidaz);
+        });
+
+        // Hourglass controls and equations of state
+        addData<Hourglass, HourglassTitle, HourglassId, HourglassShell, HourglassSolid,
+                HourglassThicknessChange, HourglassBeam>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Hourglass, IdRole::Definition, data.hgid);
+        });
+        addData<HourglassPart>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+
+        addData<EosLinearPolynomial, EosGruneisen, EosJwl, EosIdealGas, EosIgnitionGrowth,
+                EosMurnaghan, EosTillotson, EosStiffGas, EosRatioOfPolynomials, EosOsborne,
+                EosPropellantDeflagration, EosUserDefined, EosPowderBurn,
+                EosLinearPolynomialWithEnergyLeak,
+                EosJwlb>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Eos, IdRole::Definition, data.eosid);
+        });
+        addData<EosTabulatedCompaction>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Eos, IdRole::Definition, data.eosid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+            visitRef(cb, IdKind::Curve, data.lcid2);
+        });
+        addData<EosTabulated, EosSack>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Eos, IdRole::Definition, data.eosid);
+            visitRef(cb, IdKind::Curve, data.lcid);
+        });
+        addData<EosSesame>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Eos, IdRole::Definition, data.eosid);
+            visitRef(cb, IdKind::Material, data.matid);
+        });
+        addData<EosGasket>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Eos, IdRole::Definition, data.eosid);
+            visitRef(cb, IdKind::Curve, data.lcidl);
+            visitRef(cb, IdKind::Curve, data.lcidu);
+        });
+
+        // Output requests
+        addData<DatabaseBinaryD3plot>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcdt);
+            visitRef(cb, IdKind::PartSet, data.psetid);
+        });
+        addData<DatabaseBinaryD3thdt, DatabaseGlstat, DatabaseMatsum, DatabaseNodout, DatabaseElout,
+                DatabaseRcforc, DatabaseSleout, DatabaseSpcforc, DatabaseRwforc, DatabaseAbstat,
+                DatabaseSecforc, DatabaseJntforc, DatabaseBndout, DatabaseDeforc, DatabaseSwforc,
+                DatabaseNcforc, DatabaseBinaryD3dump, DatabaseBinaryRunrsf, DatabaseSsstat,
+                DatabaseRbdout, DatabaseCurvout, DatabaseTprint, DatabaseNodfor, DatabaseDcfail,
+                DatabaseBearing>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcdt);
+        });
+        addData<DatabaseCrossSectionSet>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::NodeSet, data.nsid);
+            visitRef(cb, IdKind::ElementSet, data.hsid);
+            visitRef(cb, IdKind::ElementSet, data.bsid);
+            visitRef(cb, IdKind::ElementSet, data.ssid);
+            visitRef(cb, IdKind::ElementSet, data.tsid);
+            visitRef(cb, IdKind::ElementSet, data.dsid);
+        });
+        addData<DatabaseCrossSectionPlane>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addData<DatabaseSbtout, DatabaseAtdout, DatabaseDisbout, DatabaseDefgeo, DatabasePrtube,
+                DatabaseCpmfor, DatabasePllyout, DatabaseDemrcf, DatabaseMovie, DatabaseFsi,
+                DatabaseMassout, DatabasePwpOutput, DatabaseFsiSensor, DatabaseJntforcLocal,
+                DatabaseBndoutVent, DatabaseCpmSensor, DatabaseAleMat, DatabaseNcforcFilter,
+                DatabaseCurvoutExtend, DatabaseSbtoutRetractor, DatabaseSbtoutSensor,
+                DatabasePllyoutRetractor, DatabaseSphFlowSensor, DatabaseDemassflow, DatabaseTotgeo,
+                DatabasePsd, DatabaseAbstatMass, DatabaseSwforcFilter,
+                DatabaseRve>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcur);
+        });
+        addData<DatabaseTracer>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Node, data.nid);
+        });
+        addRows<DatabaseHistoryNode>(map,
+            [](auto& kw) -> auto& { return kw.getNodeIds(); },
+            [](NodeId& nid, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Node, nid);
+            });
+        addRows<DatabaseHistoryShell, DatabaseHistorySolid, DatabaseHistoryBeam>(map,
+            [](auto& kw) -> auto& { return kw.getElementIds(); },
+            [](ElementId& eid, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, eid);
+            });
+        addRows<DatabaseHistoryTshell>(map,
+            [](auto& kw) -> auto& { return kw.getData().elemIds; },
+            [](int64_t& eid, const IdFieldCallback& cb) {
+                visitRef(cb, IdKind::Element, eid);
+            });
+        addIdFree<DatabaseExtentBinary, DatabaseFormat>(map);
+
+        // Controls
+
+        addData<ControlTimestep>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lctm);
+        });
+        addData<ControlAccuracy>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.pidosu);
+        });
+        addData<ControlImplicitForming>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::PartSet, data.psid);
+        });
+        addData<ControlFormingBestfit>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+        addData<ControlFormingOnestep>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.dieid);
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+        addData<ControlAdaptive>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Curve, data.lcadp);
+        });
+        addIdFree<ControlTermination, ControlEnergy, ControlOutput, ControlContact, ControlHourglass,
+                  ControlBulkViscosity, ControlShell, ControlSolid, ControlRigid, ControlCpu,
+                  ControlParallel, ControlDynamicRelaxation,
+                  ControlMppDecompositionDistributeAleElements, ControlAle, ControlRemeshing,
+                  ControlSpotweldBeam, ControlBeam, ControlSubcycle>(map);
+
+        // Definitions
+        addData<DefineVector>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::CoordinateSystem, data.cid);
+        });
+        addData<DefineFunction>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitField(cb, IdKind::Curve, IdRole::Definition, data.id);
+        });
+        addIdFree<DefineBox, DefineTransformation, DefineFriction, DefineSdOrientation, DefineFilter,
+                  DefineCarpetPlot, DefineRegion, DefineCurveEntity, DefineConnectionProperties>(map);
+
+        // Includes are resolved by the reader; a stamped part refers to its part
+        addIdFree<Include, IncludePath, IncludePathRelative, IncludeTransform, IncludeAutoOffset,
+                  IncludeCompensate, IncludeBinary>(map);
+        addData<IncludeStampedPart>(map, [](auto& data, const IdFieldCallback& cb) {
+            visitRef(cb, IdKind::Part, data.pid);
+        });
+
+        // Keywords of these families without an accessor may hold the listed kinds;
+        // any other unmapped keyword may hold every kind
+        refs.addFamily<AirbagKeyword>({IdKind::Part, IdKind::PartSet, IdKind::SegmentSet,
+                                       IdKind::Curve});
+        refs.addFamily<AleKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part, IdKind::PartSet,
+                                    IdKind::SegmentSet, IdKind::Curve});
+        refs.addFamily<CeseKeyword>({IdKind::Part, IdKind::PartSet, IdKind::SegmentSet,
+                                     IdKind::Material, IdKind::Eos, IdKind::Curve});
+        refs.addFamily<ChemistryKeyword>({IdKind::Curve});
+        refs.addFamily<ContactKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part,
+                                        IdKind::PartSet, IdKind::ElementSet, IdKind::SegmentSet,
+                                        IdKind::Curve, IdKind::Contact, IdKind::CoordinateSystem});
+        refs.addFamily<DampingKeyword>({IdKind::Part, IdKind::PartSet, IdKind::Material,
+                                        IdKind::Curve});
+        refs.addFamily<DefineKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Element,
+                                       IdKind::ElementSet, IdKind::Part, IdKind::PartSet,
+                                       IdKind::SegmentSet, IdKind::Material, IdKind::Curve,
+                                       IdKind::CoordinateSystem});
+        refs.addFamily<DeformableToRigidKeyword>({IdKind::Part, IdKind::PartSet,
+                                                  IdKind::CoordinateSystem});
+        refs.addFamily<DualceseKeyword>({IdKind::Part, IdKind::PartSet, IdKind::SegmentSet,
+                                         IdKind::Material, IdKind::Eos, IdKind::Curve});
+        refs.addFamily<EmKeyword>({IdKind::NodeSet, IdKind::Part, IdKind::PartSet,
+                                   IdKind::SegmentSet, IdKind::Material, IdKind::Curve});
+        refs.addFamily<FrequencyKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part,
+                                          IdKind::PartSet, IdKind::SegmentSet, IdKind::Curve});
+        refs.addFamily<IcfdKeyword>({IdKind::Part, IdKind::PartSet, IdKind::SegmentSet,
+                                     IdKind::Material, IdKind::Section, IdKind::Curve});
+        refs.addFamily<ImplicitKeyword>({IdKind::NodeSet, IdKind::Part, IdKind::PartSet,
+                                         IdKind::Curve});
+        refs.addFamily<IntegrationKeyword>({IdKind::Part});
+        refs.addFamily<InterfaceKeyword>({IdKind::NodeSet, IdKind::Part, IdKind::PartSet,
+                                          IdKind::SegmentSet});
+        refs.addFamily<MatAddKeyword>({IdKind::Material, IdKind::Curve});
+        refs.addFamily<PerturbationKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Element,
+                                             IdKind::Part, IdKind::PartSet, IdKind::Material,
+                                             IdKind::Section, IdKind::Curve,
+                                             IdKind::CoordinateSystem});
+        refs.addFamily<SphKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part, IdKind::PartSet,
+                                    IdKind::Section, IdKind::Curve});
+        refs.addFamily<StochasticKeyword>({IdKind::Part, IdKind::PartSet, IdKind::Material});
+        refs.addFamily<ThermalKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part,
+                                        IdKind::PartSet, IdKind::SegmentSet, IdKind::Curve});
+        refs.addFamily<SetKeyword>({IdKind::Node, IdKind::Element, IdKind::Part, IdKind::NodeSet,
+                                    IdKind::PartSet, IdKind::ElementSet, IdKind::SegmentSet});
+        refs.addFamily<ParameterKeyword>({});
+        refs.addFamily<BoundaryKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part,
+                                         IdKind::PartSet, IdKind::SegmentSet, IdKind::Curve,
+                                         IdKind::CoordinateSystem});
+        refs.addFamily<LoadKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Element, IdKind::Part,
+                                     IdKind::PartSet, IdKind::ElementSet, IdKind::SegmentSet,
+                                     IdKind::Curve, IdKind::CoordinateSystem});
+        refs.addFamily<ConstrainedKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Element,
+                                            IdKind::Part, IdKind::PartSet, IdKind::ElementSet,
+                                            IdKind::SegmentSet, IdKind::Curve,
+                                            IdKind::CoordinateSystem});
+        refs.addFamily<InitialKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Element,
+                                        IdKind::Part, IdKind::PartSet, IdKind::ElementSet,
+                                        IdKind::SegmentSet, IdKind::Curve, IdKind::Contact,
+                                        IdKind::CoordinateSystem});
+        refs.addFamily<RigidwallKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Part,
+                                          IdKind::PartSet, IdKind::Curve});
+        refs.addFamily<DatabaseKeyword>({IdKind::Node, IdKind::NodeSet, IdKind::Element,
+                                         IdKind::Part, IdKind::PartSet, IdKind::ElementSet,
+                                         IdKind::SegmentSet, IdKind::Curve,
+                                         IdKind::CoordinateSystem});
+        refs.addFamily<ControlKeyword>({IdKind::Part, IdKind::PartSet, IdKind::Curve});
+        refs.addFamily<HourglassKeyword>({IdKind::Part, IdKind::Hourglass});
+        refs.addFamily<EosKeyword>({IdKind::Eos, IdKind::Material, IdKind::Curve});
+
+        return refs;
+    }();
+    return instance;
+}
+
+const IdReferenceMap::Accessor* IdReferenceMap::find(const Keyword& keyword) const {
+    auto it = accessors_.find(std::type_index(typeid(keyword)));
+    if (it != accessors_.end()) {
+        return &it->second;
+    }
+    if (materialAccessor_.visit && dynamic_cast<const MaterialBase*>(&keyword)) {
+        return &materialAccessor_;
+    }
+    if (sectionAccessor_.visit && dynamic_cast<const SectionBase*>(&keyword)) {
+        return &sectionAccessor_;
+    }
+    return nullptr;
+}
+
+std::vector<IdKind> IdReferenceMap::unmappedKinds(const Keyword& keyword) const {
+    if (const Accessor* accessor = find(keyword)) {
+        return accessor->unmapped;
+    }
+    for (const auto& family : families_) {
+        if (family.matches(keyword)) {
+            return family.kinds;
+        }
+    }
+    std::vector<IdKind> kinds;
+    kinds.reserve(kIdKindCount);
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        kinds.push_back(static_cast<IdKind>(k));
+    }
+    return kinds;
+}
+
+bool IdReferenceMap::visitAll(Keyword& keyword, const IdFieldCallback& callback) const {
+    const Accessor* accessor = find(keyword);
+    if (!accessor) {
+        return false;
+    }
+    accessor->visit(keyword, 0, accessor->itemCount(keyword), callback);
+    return true;
+}
+
+} // namespace koo::dyna
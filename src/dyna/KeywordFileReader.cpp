@@ -1,5 +1,7 @@
 #include <koo/dyna/KeywordFileReader.hpp>
 #include <koo/dyna/KeywordFactory.hpp>
+#include <koo/dyna/Include.hpp>
+#include <koo/dyna/managers/RenumberManager.hpp>
 #include <koo/util/StringUtils.hpp>
 #include <fstream>
 #include <sstream>
@@ -36,6 +38,7 @@ Model KeywordFileReader::readFromString(const std::string& content,
     errors_.clear();
     warnings_.clear();
     currentFormat_ = options_.defaultFormat;
+    currentFile_.clear();
 
     Model model;
 
@@ -90,9 +93,12 @@ void KeywordFileReader::parseContent(const std::vector<std::string>& lines,
     std::string currentKeyword;
     std::vector<std::string> currentBlock;
     util::CardParser::Format blockFormat = currentFormat_;
+    size_t blockLine = 0;
 
     auto finishBlock = [&]() {
         if (!currentKeyword.empty() && !currentBlock.empty()) {
+            // Report against the keyword line rather than the next block
+            currentLine_ = blockLine;
             parseKeywordBlock(currentKeyword, currentBlock, blockFormat, model);
         }
         currentKeyword.clear();
@@ -134,6 +140,7 @@ void KeywordFileReader::parseContent(const std::vector<std::string>& lines,
                 // Collect include block
                 currentKeyword = keyword;
                 blockFormat = currentFormat_;
+                blockLine = i + 1;
                 continue;
             }
 
@@ -156,6 +163,7 @@ void KeywordFileReader::parseContent(const std::vector<std::string>& lines,
             }
 
             currentKeyword = keyword;
+            blockLine = i + 1;
             continue;
         }
 
@@ -187,6 +195,12 @@ void KeywordFileReader::parseKeywordBlock(const std::string& keywordName,
         return;
     }
 
+    // *INCLUDE_AUTO_OFFSET: merge the file with collision-free ID offsets
+    if (keywordName == "*INCLUDE_AUTO_OFFSET" && options_.followIncludes) {
+        handleAutoOffsetInclude(lines, options_.baseDirectory, model);
+        return;
+    }
+
     // Create keyword using factory
     auto keyword = KeywordFactory::instance().create(keywordName);
     if (!keyword) {
@@ -198,6 +212,7 @@ void KeywordFileReader::parseKeywordBlock(const std::string& keywordName,
     if (!keyword->parse(lines, format)) {
         reportWarning("Failed to parse keyword: " + keywordName);
     }
+    keyword->setSourceLocation(currentFile_.string(), currentLine_);
 
     model.addKeyword(std::move(keyword));
 }
@@ -223,13 +238,48 @@ void KeywordFileReader::handleInclude(const std::vector<std::string>& lines,
 
         // Parse included file
         if (std::filesystem::exists(includePath)) {
+            std::filesystem::path parentFile = currentFile_;
             parseFile(includePath, model);
+            currentFile_ = parentFile;
         } else {
             reportWarning("Include file not found: " + includePath.string());
         }
     }
 }
 
+void KeywordFileReader::handleAutoOffsetInclude(const std::vector<std::string>& lines,
+                                                const std::filesystem::path& basePath,
+                                                Model& model) {
+    IncludeAutoOffset include;
+    include.parse(lines);
+    if (include.getFilename().empty()) {
+        return;
+    }
+
+    std::filesystem::path includePath = include.getFilename();
+    if (includePath.is_relative()) {
+        includePath = basePath / includePath;
+    }
+    if (!std::filesystem::exists(includePath)) {
+        reportWarning("Include file not found: " + includePath.string());
+        return;
+    }
+
+    // Offsets are relative to everything read so far
+    Model included;
+    std::filesystem::path parentFile = currentFile_;
+    parseFile(includePath, included);
+    currentFile_ = parentFile;
+
+    auto result = managers::RenumberManager(model).merge(included);
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        if (result.skipped[k]) {
+            reportWarning(std::string("*INCLUDE_AUTO_OFFSET: ") + idKindName(static_cast<IdKind>(k)) +
+                          " IDs of " + includePath.string() + " were not offset");
+        }
+    }
+}
+
 void KeywordFileReader::handleKeywordDirective(const std::string& line) {
     // Check for memory/format options
     std::string upper = util::StringUtils::toUpper(line);
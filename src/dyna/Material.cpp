@@ -1,6 +1,8 @@
 #include <koo/dyna/Material.hpp>
 #include <koo/dyna/ModelVisitor.hpp>
 #include <koo/dyna/KeywordFactory.hpp>
+#include <type_traits>
+#include <utility>
 
 namespace koo::dyna {
 
@@ -7180,4 +7182,118 @@ void MatHystereticBeam::accept(ModelVisitor& visitor) {
 
 REGISTER_KEYWORD(MatHystereticBeam, "*MAT_HYSTERETIC_BEAM")
 
+// ============================================================================
+// Material property access
+// ============================================================================
+
+namespace {
+
+template<typename T, typename = void>
+struct HasDensity : std::false_type {};
+template<typename T>
+struct HasDensity<T, std::void_t<decltype(std::declval<const T&>().ro)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct HasYoungsModulus : std::false_type {};
+template<typename T>
+struct HasYoungsModulus<T, std::void_t<decltype(std::declval<const T&>().e)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct HasShearModulus : std::false_type {};
+template<typename T>
+struct HasShearModulus<T, std::void_t<decltype(std::declval<const T&>().g)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct HasPoissonRatio : std::false_type {};
+template<typename T>
+struct HasPoissonRatio<T, std::void_t<decltype(std::declval<const T&>().pr)>> : std::true_type {};
+
+template<typename T, typename = void>
+struct HasDataAccessor : std::false_type {};
+template<typename T>
+struct HasDataAccessor<T, std::void_t<decltype(std::declval<const T&>().getData())>> : std::true_type {};
+
+template<typename Data>
+std::optional<ElasticConstants> extractElasticConstants(const Data& data) {
+    if constexpr (!HasDensity<Data>::value) {
+        return std::nullopt;
+    } else {
+        ElasticConstants c;
+        c.density = static_cast<double>(data.ro);
+        if constexpr (HasPoissonRatio<Data>::value) {
+            c.poissonRatio = static_cast<double>(data.pr);
+        }
+        if constexpr (HasYoungsModulus<Data>::value) {
+            c.youngsModulus = static_cast<double>(data.e);
+        }
+        if constexpr (HasShearModulus<Data>::value) {
+            if (c.youngsModulus <= 0.0) {
+                c.youngsModulus = 2.0 * static_cast<double>(data.g) * (1.0 + c.poissonRatio);
+            }
+        }
+        return c;
+    }
+}
+
+template<typename T>
+bool tryGetElasticConstants(const MaterialBase& material, std::optional<ElasticConstants>& out) {
+    const auto* typed = dynamic_cast<const T*>(&material);
+    if (!typed) {
+        return false;
+    }
+    if constexpr (HasDataAccessor<T>::value) {
+        out = extractElasticConstants(typed->getData());
+    }
+    return true;
+}
+
+template<typename... Ts>
+struct MaterialTypeList {
+    static std::optional<ElasticConstants> get(const MaterialBase& material) {
+        std::optional<ElasticConstants> result;
+        (tryGetElasticConstants<Ts>(material, result) || ...);
+        return result;
+    }
+};
+
+using AllMaterialTypes = MaterialTypeList<
+        MatElastic, MatRigid, MatPlasticKinematic,
+        MatPiecewiseLinearPlasticity, MatJohnsonCook, MatNull,
+        MatViscoelastic, MatPowerLawPlasticity, MatHoneycomb,
+        MatModifiedPiecewiseLinearPlasticity, MatCrushableFoam, MatSpotWeld,
+        MatOgdenRubber, MatFabric, MatMooneyRivlinRubber,
+        MatLowDensityFoam, MatOrthotropicElastic, MatEnhancedCompositeDamage,
+        MatLaminatedCompositeFabric, MatElasticPlasticThermal, MatSoilAndFoam,
+        MatElasticPlasticHydro, MatCompositeDamage, MatGeologicCapModel,
+        MatPlasticityWithDamage, MatSimplifiedJohnsonCook, MatSamp1,
+        MatOrthoElasticPlastic, MatHighExplosiveBurn, MatBlatzKoRubber,
+        MatSteinberg, MatIsotropicElasticFailure, MatIsotropicElasticPlastic,
+        MatSoilAndFoamFailure, MatPseudoTensor, MatOrientedCrack,
+        MatStrainRateDependentPlasticity, MatThermalOrthotropic, MatTempDependentOrthotropic,
+        MatResultantPlasticity, MatForceLimited, MatShapeMemory,
+        MatFrazerNashRubber, MatLaminatedGlass, MatBarlatAnisotropicPlasticity,
+        MatSpringElastic, MatDamperViscous, MatSpringNonlinearElastic,
+        MatSpringElastoplastic, MatSpringGeneralNonlinear, MatSpringMaxwell,
+        MatCableDiscreteBeam, MatElasticViscoplasticThermal, MatUserDefined,
+        MatFuChangFoam, MatWinfrithConcrete, MatConcreteDamageRel3,
+        MatCscmConcrete, MatPlasticGreenNaghdi, Mat3ParameterBarlat,
+        MatTransverselyAnisotropicElasticPlastic, MatBlatzKoFoam, MatFldTransverselyAnisotropic,
+        MatNonlinearOrthotropic, MatBamman, MatBammanDamage,
+        MatClosedCellFoam, MatElasticWithViscosity, MatKelvinMaxwellViscoelastic,
+        MatViscousFoam, MatRateSensitiveCompositeFabric, MatCompositeFailureSolidModel,
+        MatViscoelasticThermal, MatBilkhuDuboisFoam, MatGeneralViscoelastic,
+        MatPlasticityWithDamageOrtho, MatPiecewiseLinearPlasticityStochastic, MatAcoustic,
+        MatSoftTissue, MatArrudaBoyce, MatSimplifiedRubber,
+        MatArupAdhesive, MatCohesiveGeneral, MatCohesiveElastic,
+        MatTabulatedJohnsonCook, MatAnisotropicViscoplastic, MatDamage3,
+        MatSeismicIsolator, MatSpringInelastic, MatDamperNonlinearViscous,
+        MatHystereticBeam
+>;
+
+} // anonymous namespace
+
+std::optional<ElasticConstants> getElasticConstants(const MaterialBase& material) {
+    return AllMaterialTypes::get(material);
+}
+
 } // namespace koo::dyna
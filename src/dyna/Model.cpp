@@ -94,6 +94,17 @@ const NodeData* Model::findNode(NodeId id) const {
     return nodes ? nodes->findNode(id) : nullptr;
 }
 
+std::unordered_map<NodeId, Vec3> Model::getNodePositions() const {
+    std::unordered_map<NodeId, Vec3> positions;
+    for (const auto* nodeKw : getKeywordsOfType<Node>()) {
+        positions.reserve(positions.size() + nodeKw->getNodeCount());
+        for (const auto& node : nodeKw->getNodes()) {
+            positions[node.id] = node.position;
+        }
+    }
+    return positions;
+}
+
 // Shell elements
 ElementShell* Model::getShellElements() {
     updateCache();
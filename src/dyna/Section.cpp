@@ -1309,6 +1309,27 @@ void SectionDiscreteTitle::accept(ModelVisitor& visitor) {
     visitor.visit(*this);
 }
 
+// ============================================================================
+// Section property access
+// ============================================================================
+
+SectionProperties getSectionProperties(const SectionBase& section) {
+    SectionProperties props;
+    if (const auto* shell = dynamic_cast<const SectionShell*>(&section)) {
+        props.shellThickness = shell->getThickness();
+    } else if (const auto* shellTitle = dynamic_cast<const SectionShellTitle*>(&section)) {
+        props.shellThickness = shellTitle->getThickness();
+    } else if (const auto* beam = dynamic_cast<const SectionBeam*>(&section)) {
+        const auto& cs = beam->getCrossSection();
+        if (beam->getArea() > 0.0) {
+            props.beamArea = beam->getArea();
+        } else if (cs.ts1 > 0.0 && cs.tt1 > 0.0) {
+            props.beamArea = cs.ts1 * cs.tt1;
+        }
+    }
+    return props;
+}
+
 // Register keywords
 REGISTER_KEYWORD(SectionShell, "*SECTION_SHELL")
 REGISTER_KEYWORD(SectionSolid, "*SECTION_SOLID")
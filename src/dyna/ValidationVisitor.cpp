@@ -1,8 +1,81 @@
 #include <koo/dyna/ValidationVisitor.hpp>
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 
 namespace koo::dyna {
 
+namespace {
+
+// Sort an ID table in place and return the IDs that occur more than once
+template<typename Id>
+std::vector<Id> sortAndFindDuplicates(std::vector<Id>& ids) {
+    std::sort(ids.begin(), ids.end());
+    std::vector<Id> duplicates;
+    for (size_t i = 1; i < ids.size(); ++i) {
+        if (ids[i] == ids[i - 1] && (duplicates.empty() || duplicates.back() != ids[i])) {
+            duplicates.push_back(ids[i]);
+        }
+    }
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return duplicates;
+}
+
+// IDs of `sorted` not contained in `sortedOther` (both sorted and unique)
+template<typename Id>
+std::vector<Id> difference(const std::vector<Id>& sorted, const std::vector<Id>& sortedOther) {
+    std::vector<Id> result;
+    std::set_difference(sorted.begin(), sorted.end(),
+                        sortedOther.begin(), sortedOther.end(),
+                        std::back_inserter(result));
+    return result;
+}
+
+} // anonymous namespace
+
+void ValidationVisitor::finalizeValidation() {
+    // Duplicate definitions
+    for (NodeId id : sortAndFindDuplicates(nodeIds_)) {
+        addError("Nodes", "Duplicate node ID: " + std::to_string(id));
+    }
+    for (ElementId id : sortAndFindDuplicates(elementIds_)) {
+        addError("Elements", "Duplicate element ID: " + std::to_string(id));
+    }
+    for (PartId id : sortAndFindDuplicates(partIds_)) {
+        addError("Parts", "Duplicate part ID: " + std::to_string(id));
+    }
+    for (MaterialId id : sortAndFindDuplicates(materialIds_)) {
+        addError("Materials", "Duplicate material ID: " + std::to_string(id));
+    }
+    for (SectionId id : sortAndFindDuplicates(sectionIds_)) {
+        addError("Sections", "Duplicate section ID: " + std::to_string(id));
+    }
+
+    sortAndFindDuplicates(nodeReferences_);
+    sortAndFindDuplicates(partReferences_);
+    sortAndFindDuplicates(materialReferences_);
+    sortAndFindDuplicates(sectionReferences_);
+
+    // Missing references
+    for (NodeId id : difference(nodeReferences_, nodeIds_)) {
+        addError("Elements", "Element references undefined node " + std::to_string(id));
+    }
+    for (PartId id : difference(partReferences_, partIds_)) {
+        addWarning("Elements", "Element references undefined part " + std::to_string(id));
+    }
+
+    // Unreferenced definitions
+    for (PartId id : difference(partIds_, partReferences_)) {
+        addWarning("Parts", "Part " + std::to_string(id) + " is not referenced by any elements");
+    }
+    for (MaterialId id : difference(materialIds_, materialReferences_)) {
+        addWarning("Materials", "Material " + std::to_string(id) + " is not referenced by any parts");
+    }
+    for (SectionId id : difference(sectionIds_, sectionReferences_)) {
+        addWarning("Sections", "Section " + std::to_string(id) + " is not referenced by any parts");
+    }
+}
+
 void ValidationVisitor::printMessages(std::ostream& os, ValidationSeverity minSeverity) const {
     const char* severityStr[] = {"INFO", "WARNING", "ERROR"};
     const char* severityColor[] = {"\033[36m", "\033[33m", "\033[31m"}; // Cyan, Yellow, Red
@@ -1,6 +1,7 @@
 #include <koo/dyna/managers/ElementManager.hpp>
 #include <koo/dyna/Element.hpp>
 #include <koo/dyna/Define.hpp>
+#include <koo/util/Parallel.hpp>
 #include <algorithm>
 
 namespace koo::dyna::managers {
@@ -13,67 +14,28 @@ ElementManager::ElementManager(Model& model)
 
 void ElementManager::buildIndex() {
     // Clear existing indices
-    elementIndex_.clear();
-    elementToPart_.clear();
-    elementType_.clear();
-    typeToElements_.clear();
-    birthTimes_.clear();
-    deathTimes_.clear();
-
-    // Helper lambda to index elements
-    auto indexElements = [this](const auto* keyword, ElementType type) {
-        if (!keyword) return;
-
-        const auto& elements = keyword->getElements();
-        for (const auto& elem : elements) {
-            elementIndex_[elem.id] = &elem;
-            elementToPart_[elem.id] = elem.pid;
-            elementType_[elem.id] = type;
-            typeToElements_[type].push_back(elem.id);
+    clearIndex();
+
+    // Helper lambda to index all keywords of one element type
+    auto indexElements = [this](auto keywords, ElementType type) {
+        auto& ids = typeToElements_[static_cast<size_t>(type)];
+        for (const auto* keyword : keywords) {
+            const auto& elements = keyword->getElements();
+            ids.reserve(ids.size() + elements.size());
+            for (const auto& elem : elements) {
+                elementIndex_[elem.id] = &elem;
+                elementToPart_[elem.id] = elem.pid;
+                elementType_[elem.id] = type;
+                ids.push_back(elem.id);
+            }
         }
     };
 
-    // Index shell elements
-    indexElements(model_.getShellElements(), ElementType::Shell);
-
-    // Index solid elements
-    indexElements(model_.getSolidElements(), ElementType::Solid);
-
-    // Index beam elements
-    auto beamKeywords = model_.getKeywordsOfType<ElementBeam>();
-    for (auto* keyword : beamKeywords) {
-        const auto& elements = keyword->getElements();
-        for (const auto& elem : elements) {
-            elementIndex_[elem.id] = &elem;
-            elementToPart_[elem.id] = elem.pid;
-            elementType_[elem.id] = ElementType::Beam;
-            typeToElements_[ElementType::Beam].push_back(elem.id);
-        }
-    }
-
-    // Index discrete elements
-    auto discreteKeywords = model_.getKeywordsOfType<ElementDiscrete>();
-    for (auto* keyword : discreteKeywords) {
-        const auto& elements = keyword->getElements();
-        for (const auto& elem : elements) {
-            elementIndex_[elem.id] = &elem;
-            elementToPart_[elem.id] = elem.pid;
-            elementType_[elem.id] = ElementType::Discrete;
-            typeToElements_[ElementType::Discrete].push_back(elem.id);
-        }
-    }
-
-    // Index seatbelt elements
-    auto seatbeltKeywords = model_.getKeywordsOfType<ElementSeatbelt>();
-    for (auto* keyword : seatbeltKeywords) {
-        const auto& elements = keyword->getElements();
-        for (const auto& elem : elements) {
-            elementIndex_[elem.id] = &elem;
-            elementToPart_[elem.id] = elem.pid;
-            elementType_[elem.id] = ElementType::Seatbelt;
-            typeToElements_[ElementType::Seatbelt].push_back(elem.id);
-        }
-    }
+    indexElements(model_.getKeywordsOfType<ElementShell>(), ElementType::Shell);
+    indexElements(model_.getKeywordsOfType<ElementSolid>(), ElementType::Solid);
+    indexElements(model_.getKeywordsOfType<ElementBeam>(), ElementType::Beam);
+    indexElements(model_.getKeywordsOfType<ElementDiscrete>(), ElementType::Discrete);
+    indexElements(model_.getKeywordsOfType<ElementSeatbelt>(), ElementType::Seatbelt);
 
     // Build birth/death time index
     buildBirthDeathIndex();
@@ -105,7 +67,9 @@ void ElementManager::clearIndex() {
     elementIndex_.clear();
     elementToPart_.clear();
     elementType_.clear();
-    typeToElements_.clear();
+    for (auto& ids : typeToElements_) {
+        ids.clear();
+    }
     birthTimes_.clear();
     deathTimes_.clear();
     indexBuilt_ = false;
@@ -139,8 +103,14 @@ ElementType ElementManager::getElementType(ElementId eid) const {
 }
 
 std::vector<ElementId> ElementManager::getElementsByType(ElementType type) const {
-    auto it = typeToElements_.find(type);
-    return it != typeToElements_.end() ? it->second : std::vector<ElementId>{};
+    auto ids = getElementIdSpan(type);
+    return std::vector<ElementId>(ids.begin(), ids.end());
+}
+
+util::Span<const ElementId> ElementManager::getElementIdSpan(ElementType type) const {
+    size_t index = static_cast<size_t>(type);
+    return index < typeToElements_.size() ? util::Span<const ElementId>(typeToElements_[index])
+                                          : util::Span<const ElementId>();
 }
 
 std::vector<ElementId> ElementManager::getShellElements() const {
@@ -169,33 +139,65 @@ std::vector<NodeId> ElementManager::getNodes(ElementId eid) const {
     return elem ? elem->nodeIds : std::vector<NodeId>{};
 }
 
+util::Span<const NodeId> ElementManager::getNodeSpan(ElementId eid) const {
+    const ElementData* elem = getElement(eid);
+    return elem ? util::Span<const NodeId>(elem->nodeIds) : util::Span<const NodeId>();
+}
+
 size_t ElementManager::getNodeCount(ElementId eid) const {
     const ElementData* elem = getElement(eid);
     return elem ? elem->nodeIds.size() : 0;
 }
 
-std::vector<ElementManager::Segment> ElementManager::getSegments(ElementId eid) const {
-    ElementType type = getElementType(eid);
-
-    if (type == ElementType::Shell) {
-        // Get shell element
-        auto* shellKeyword = model_.getShellElements();
-        if (shellKeyword) {
-            const ShellElementData* elem = shellKeyword->getElement(eid);
+size_t ElementManager::getNodes(util::Span<const ElementId> eids, Connectivity& out,
+                                size_t threads) const {
+    constexpr size_t kBlockSize = 16384;
+    const size_t count = eids.size();
+    out.offsets.assign(count + 1, 0);
+
+    // Pass 1: row sizes
+    std::vector<size_t> found(util::blockCount(count, kBlockSize), 0);
+    util::parallelForBlocks(count, kBlockSize, [&](size_t b, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const ElementData* elem = getElement(eids[i]);
             if (elem) {
-                return extractShellSegments(*elem);
+                out.offsets[i + 1] = elem->nodeIds.size();
+                ++found[b];
             }
         }
+    }, threads);
+
+    for (size_t i = 0; i < count; ++i) {
+        out.offsets[i + 1] += out.offsets[i];
     }
-    else if (type == ElementType::Solid) {
-        // Get solid element
-        auto* solidKeyword = model_.getSolidElements();
-        if (solidKeyword) {
-            const SolidElementData* elem = solidKeyword->getElement(eid);
-            if (elem) {
-                return extractSolidSegments(*elem);
+
+    // Pass 2: copy connectivity into place
+    out.nodeIds.resize(out.offsets[count]);
+    util::parallelForBlocks(count, kBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (out.offsets[i + 1] == out.offsets[i]) {
+                continue;
             }
+            const auto& nodes = getElement(eids[i])->nodeIds;
+            std::copy(nodes.begin(), nodes.end(), out.nodeIds.data() + out.offsets[i]);
         }
+    }, threads);
+
+    size_t total = 0;
+    for (size_t f : found) {
+        total += f;
+    }
+    return total;
+}
+
+std::vector<ElementManager::Segment> ElementManager::getSegments(ElementId eid) const {
+    ElementType type = getElementType(eid);
+
+    if (type == ElementType::Shell) {
+        return extractShellSegments(static_cast<const ShellElementData&>(*getElement(eid)));
+    }
+    else if (type == ElementType::Solid) {
+        return extractSolidSegments(static_cast<const SolidElementData&>(*getElement(eid)));
     }
 
     // Beam, discrete, etc. don't have segments
@@ -203,27 +205,44 @@ std::vector<ElementManager::Segment> ElementManager::getSegments(ElementId eid)
 }
 
 std::vector<ElementManager::Segment> ElementManager::getAllSegments() const {
+    std::vector<FaceSegment> faces;
+    getAllSegments(faces);
+
     std::vector<Segment> allSegments;
+    allSegments.reserve(faces.size());
+    for (const auto& face : faces) {
+        auto nodes = face.nodes();
+        allSegments.emplace_back(std::vector<NodeId>(nodes.begin(), nodes.end()),
+                                 face.sourceElement, face.faceIndex);
+    }
+    return allSegments;
+}
+
+size_t ElementManager::getSegments(ElementId eid, std::vector<FaceSegment>& out) const {
+    const ElementData* elem = getElement(eid);
+    return elem ? appendSegments(*elem, getElementType(eid), out) : 0;
+}
+
+size_t ElementManager::getAllSegments(std::vector<FaceSegment>& out) const {
+    size_t before = out.size();
 
     // Extract from all shell elements
-    auto* shellKeyword = model_.getShellElements();
-    if (shellKeyword) {
-        for (const auto& elem : shellKeyword->getElements()) {
-            auto segments = extractShellSegments(elem);
-            allSegments.insert(allSegments.end(), segments.begin(), segments.end());
+    for (const auto* keyword : model_.getKeywordsOfType<ElementShell>()) {
+        out.reserve(out.size() + keyword->getElementCount());
+        for (const auto& elem : keyword->getElements()) {
+            appendSegments(elem, ElementType::Shell, out);
         }
     }
 
     // Extract from all solid elements
-    auto* solidKeyword = model_.getSolidElements();
-    if (solidKeyword) {
-        for (const auto& elem : solidKeyword->getElements()) {
-            auto segments = extractSolidSegments(elem);
-            allSegments.insert(allSegments.end(), segments.begin(), segments.end());
+    for (const auto* keyword : model_.getKeywordsOfType<ElementSolid>()) {
+        out.reserve(out.size() + 6 * keyword->getElementCount());
+        for (const auto& elem : keyword->getElements()) {
+            appendSegments(elem, ElementType::Solid, out);
         }
     }
 
-    return allSegments;
+    return out.size() - before;
 }
 
 std::optional<double> ElementManager::getBirthTime(ElementId eid) const {
@@ -261,120 +280,106 @@ bool ElementManager::isAliveAt(ElementId eid, double time) const {
 std::vector<ElementManager::Segment> ElementManager::extractShellSegments(
     const ShellElementData& elem) const
 {
-    std::vector<Segment> segments;
+    std::vector<FaceSegment> faces;
+    appendSegments(elem, ElementType::Shell, faces);
 
-    // Shell has one segment (the shell face itself)
-    std::vector<NodeId> nodes;
-    for (NodeId nid : elem.nodeIds) {
-        if (nid != 0) {  // Skip zero node IDs (tri3 has only 3 nodes)
-            nodes.push_back(nid);
-        }
-    }
-
-    if (!nodes.empty()) {
-        segments.emplace_back(nodes, elem.id, 0);
+    std::vector<Segment> segments;
+    for (const auto& face : faces) {
+        auto nodes = face.nodes();
+        segments.emplace_back(std::vector<NodeId>(nodes.begin(), nodes.end()), elem.id, face.faceIndex);
     }
-
     return segments;
 }
 
 std::vector<ElementManager::Segment> ElementManager::extractSolidSegments(
     const SolidElementData& elem) const
 {
+    std::vector<FaceSegment> faces;
+    appendSegments(elem, ElementType::Solid, faces);
+
     std::vector<Segment> segments;
+    segments.reserve(faces.size());
+    for (const auto& face : faces) {
+        auto nodes = face.nodes();
+        segments.emplace_back(std::vector<NodeId>(nodes.begin(), nodes.end()), elem.id, face.faceIndex);
+    }
+    return segments;
+}
 
+size_t ElementManager::appendSegments(const ElementData& elem, ElementType type,
+                                      std::vector<FaceSegment>& out)
+{
     const auto& nodes = elem.nodeIds;
-    const size_t nNodes = nodes.size();
-
-    if (nNodes == 8) {
-        // Hexahedron (8 nodes) - 6 quad faces
-        // LS-DYNA node numbering for hex8
-        // Face indices follow LS-DYNA convention:
-        // Face 0: nodes 1-2-3-4 (bottom)
-        // Face 1: nodes 5-6-7-8 (top)
-        // Face 2: nodes 1-2-6-5 (front)
-        // Face 3: nodes 2-3-7-6 (right)
-        // Face 4: nodes 3-4-8-7 (back)
-        // Face 5: nodes 4-1-5-8 (left)
-
-        std::vector<std::vector<int>> faceIndices = {
-            {0, 1, 2, 3},  // Bottom
-            {4, 5, 6, 7},  // Top
-            {0, 1, 5, 4},  // Front
-            {1, 2, 6, 5},  // Right
-            {2, 3, 7, 6},  // Back
-            {3, 0, 4, 7}   // Left
-        };
-
-        for (size_t faceIdx = 0; faceIdx < faceIndices.size(); ++faceIdx) {
-            std::vector<NodeId> faceNodes;
-            for (int nodeIdx : faceIndices[faceIdx]) {
-                if (static_cast<size_t>(nodeIdx) < nodes.size() && nodes[nodeIdx] != 0) {
-                    faceNodes.push_back(nodes[nodeIdx]);
-                }
-            }
-            if (faceNodes.size() >= 3) {
-                segments.emplace_back(faceNodes, elem.id, static_cast<int>(faceIdx));
+
+    if (type == ElementType::Shell) {
+        // Shell has one segment (the shell face itself); skip zero node IDs
+        // (tri3 has only 3 nodes)
+        FaceSegment face;
+        face.sourceElement = elem.id;
+        for (NodeId nid : nodes) {
+            if (nid != 0 && face.nodeCount < 4) {
+                face.nodeIds[face.nodeCount++] = nid;
             }
         }
-    }
-    else if (nNodes == 6) {
-        // Wedge/Pentahedron (6 nodes) - 5 faces (2 tri + 3 quad)
-        // Faces:
-        // Face 0: nodes 1-2-3 (tri bottom)
-        // Face 1: nodes 4-5-6 (tri top)
-        // Face 2: nodes 1-2-5-4 (quad)
-        // Face 3: nodes 2-3-6-5 (quad)
-        // Face 4: nodes 3-1-4-6 (quad)
-
-        std::vector<std::vector<int>> faceIndices = {
-            {0, 1, 2},     // Tri bottom
-            {3, 4, 5},     // Tri top
-            {0, 1, 4, 3},  // Quad 1
-            {1, 2, 5, 4},  // Quad 2
-            {2, 0, 3, 5}   // Quad 3
-        };
-
-        for (size_t faceIdx = 0; faceIdx < faceIndices.size(); ++faceIdx) {
-            std::vector<NodeId> faceNodes;
-            for (int nodeIdx : faceIndices[faceIdx]) {
-                if (static_cast<size_t>(nodeIdx) < nodes.size() && nodes[nodeIdx] != 0) {
-                    faceNodes.push_back(nodes[nodeIdx]);
-                }
-            }
-            if (faceNodes.size() >= 3) {
-                segments.emplace_back(faceNodes, elem.id, static_cast<int>(faceIdx));
-            }
+        if (face.nodeCount == 0) {
+            return 0;
         }
+        out.push_back(face);
+        return 1;
     }
-    else if (nNodes == 4) {
-        // Tetrahedron (4 nodes) - 4 tri faces
-        // Face 0: nodes 1-2-3
-        // Face 1: nodes 1-4-2
-        // Face 2: nodes 2-4-3
-        // Face 3: nodes 3-4-1
-
-        std::vector<std::vector<int>> faceIndices = {
-            {0, 1, 2},
-            {0, 3, 1},
-            {1, 3, 2},
-            {2, 3, 0}
-        };
-
-        for (size_t faceIdx = 0; faceIdx < faceIndices.size(); ++faceIdx) {
-            std::vector<NodeId> faceNodes;
-            for (int nodeIdx : faceIndices[faceIdx]) {
-                if (static_cast<size_t>(nodeIdx) < nodes.size() && nodes[nodeIdx] != 0) {
-                    faceNodes.push_back(nodes[nodeIdx]);
-                }
-            }
-            if (faceNodes.size() == 3) {
-                segments.emplace_back(faceNodes, elem.id, static_cast<int>(faceIdx));
+
+    if (type != ElementType::Solid) {
+        return 0;
+    }
+
+    // Face tables follow the LS-DYNA node numbering; -1 marks an unused slot
+    //
+    // Hexahedron (8 nodes) - 6 quad faces:
+    //   bottom 1-2-3-4, top 5-6-7-8, front 1-2-6-5,
+    //   right 2-3-7-6, back 3-4-8-7, left 4-1-5-8
+    static constexpr int kHexFaces[6][4] = {
+        {0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 5, 4},
+        {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}
+    };
+    // Wedge/Pentahedron (6 nodes) - 2 tri + 3 quad faces:
+    //   1-2-3, 4-5-6, 1-2-5-4, 2-3-6-5, 3-1-4-6
+    static constexpr int kWedgeFaces[5][4] = {
+        {0, 1, 2, -1}, {3, 4, 5, -1},
+        {0, 1, 4, 3}, {1, 2, 5, 4}, {2, 0, 3, 5}
+    };
+    // Tetrahedron (4 nodes) - 4 tri faces:
+    //   1-2-3, 1-4-2, 2-4-3, 3-4-1
+    static constexpr int kTetFaces[4][4] = {
+        {0, 1, 2, -1}, {0, 3, 1, -1}, {1, 3, 2, -1}, {2, 3, 0, -1}
+    };
+
+    const int (*faces)[4] = nullptr;
+    size_t faceCount = 0;
+    size_t minNodes = 3;
+    size_t maxNodes = 4;
+    switch (nodes.size()) {
+        case 8: faces = kHexFaces; faceCount = 6; break;
+        case 6: faces = kWedgeFaces; faceCount = 5; break;
+        case 4: faces = kTetFaces; faceCount = 4; maxNodes = 3; break;
+        default: return 0;
+    }
+
+    size_t appended = 0;
+    for (size_t f = 0; f < faceCount; ++f) {
+        FaceSegment face;
+        face.sourceElement = elem.id;
+        face.faceIndex = static_cast<int>(f);
+        for (int slot : faces[f]) {
+            if (slot >= 0 && nodes[static_cast<size_t>(slot)] != 0) {
+                face.nodeIds[face.nodeCount++] = nodes[static_cast<size_t>(slot)];
             }
         }
+        if (face.nodeCount >= minNodes && face.nodeCount <= maxNodes) {
+            out.push_back(face);
+            ++appended;
+        }
     }
-
-    return segments;
+    return appended;
 }
 
 } // namespace koo::dyna::managers
@@ -0,0 +1,327 @@
+#include <koo/dyna/managers/IntegrityManager.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <sstream>
+
+namespace koo::dyna::managers {
+
+namespace {
+
+constexpr size_t kChunkSize = 8192;
+constexpr size_t kReferenceBlockSize = 65536;
+
+/**
+ * @brief A slice of one keyword's items processed as a unit
+ */
+struct Task {
+    uint32_t keyword = 0;
+    const IdReferenceMap::Accessor* accessor = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+/**
+ * @brief One ID field: value plus where it was found
+ */
+struct Entry {
+    int64_t id = 0;
+    uint32_t keyword = 0;
+    uint32_t item = 0;
+};
+
+bool entryLess(const Entry& a, const Entry& b) {
+    if (a.id != b.id) return a.id < b.id;
+    if (a.keyword != b.keyword) return a.keyword < b.keyword;
+    return a.item < b.item;
+}
+
+/**
+ * @brief One *_GENERATE range: both end points plus where it was found
+ */
+struct RangeEntry {
+    int64_t first = 0;
+    int64_t last = 0;
+    uint32_t keyword = 0;
+    uint32_t item = 0;
+};
+
+using EntryTables = std::array<std::vector<Entry>, kIdKindCount>;
+
+struct Collected {
+    EntryTables definitions;
+    EntryTables references;
+    std::array<std::vector<RangeEntry>, kIdKindCount> ranges;
+};
+
+/**
+ * @brief Collect all positive ID fields in parallel, concatenated in keyword order
+ *
+ * Range end points arrive in pairs and are kept as ranges: they need not be
+ * defined themselves.
+ */
+Collected collect(const std::vector<Keyword*>& keywords, const std::vector<Task>& tasks, size_t threads) {
+    std::vector<Collected> partial(tasks.size());
+    util::parallelFor(tasks.size(), [&](size_t t) {
+        const Task& task = tasks[t];
+        Collected& out = partial[t];
+        Keyword& kw = *keywords[task.keyword];
+        uint32_t item = 0;
+        bool rangeOpen = false;
+        int64_t rangeFirst = 0;
+        IdFieldCallback cb = [&](IdKind kind, IdRole role, int64_t& id) {
+            if (role == IdRole::Range) {
+                if (!rangeOpen) {
+                    rangeFirst = id;
+                } else if (rangeFirst > 0 && id > 0) {
+                    out.ranges[static_cast<size_t>(kind)].push_back(
+                        {std::min(rangeFirst, id), std::max(rangeFirst, id), task.keyword, item});
+                }
+                rangeOpen = !rangeOpen;
+                return;
+            }
+            if (id <= 0) {
+                return;
+            }
+            auto& table = role == IdRole::Definition ? out.definitions : out.references;
+            table[static_cast<size_t>(kind)].push_back({id, task.keyword, item});
+        };
+        for (size_t i = task.begin; i < task.end; ++i) {
+            item = static_cast<uint32_t>(i);
+            task.accessor->visit(kw, i, i + 1, cb);
+        }
+    }, threads);
+
+    Collected result;
+    auto concat = [&](EntryTables Collected::*tables) {
+        for (size_t k = 0; k < kIdKindCount; ++k) {
+            size_t total = 0;
+            for (const auto& p : partial) {
+                total += (p.*tables)[k].size();
+            }
+            auto& dest = (result.*tables)[k];
+            dest.reserve(total);
+            for (const auto& p : partial) {
+                dest.insert(dest.end(), (p.*tables)[k].begin(), (p.*tables)[k].end());
+            }
+        }
+    };
+    concat(&Collected::definitions);
+    concat(&Collected::references);
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        for (const auto& p : partial) {
+            result.ranges[k].insert(result.ranges[k].end(), p.ranges[k].begin(), p.ranges[k].end());
+        }
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Location
+// ============================================================================
+
+std::string IntegrityManager::Location::toString() const {
+    std::ostringstream oss;
+    if (keyword) {
+        if (!keyword->getSourceFile().empty()) {
+            oss << keyword->getSourceFile() << ":" << keyword->getSourceLine() << " ";
+        } else if (keyword->getSourceLine() > 0) {
+            oss << "line " << keyword->getSourceLine() << " ";
+        }
+        oss << keyword->getKeywordName() << " item " << item;
+    }
+    return oss.str();
+}
+
+IntegrityManager::IntegrityManager(Model& model)
+    : model_(model)
+{
+}
+
+// ============================================================================
+// Checking
+// ============================================================================
+
+IntegrityManager::Report IntegrityManager::check(const Options& options) const {
+    Report report;
+    const IdReferenceMap& refs = options.references ? *options.references : IdReferenceMap::defaults();
+
+    std::vector<Keyword*> keywords;
+    std::vector<Task> tasks;
+    for (auto& kw : model_.getKeywords()) {
+        const auto* accessor = refs.find(*kw);
+        if (!accessor) {
+            continue;
+        }
+        auto index = static_cast<uint32_t>(keywords.size());
+        keywords.push_back(kw.get());
+        size_t count = accessor->itemCount(*kw);
+        for (size_t begin = 0; begin < count; begin += kChunkSize) {
+            tasks.push_back({index, accessor, begin, std::min(begin + kChunkSize, count)});
+        }
+    }
+
+    Collected fields = collect(keywords, tasks, options.threads);
+    auto location = [&](const Entry& e) {
+        return Location{keywords[e.keyword], e.item};
+    };
+
+    // Sorted ID tables; the first definition of an ID wins
+    std::array<std::vector<int64_t>, kIdKindCount> ids;
+    std::array<std::vector<Entry>, kIdKindCount> firstDefinition;
+    std::array<std::vector<Issue>, kIdKindCount> duplicates;
+
+    util::parallelFor(kIdKindCount, [&](size_t k) {
+        auto& defs = fields.definitions[k];
+        std::sort(defs.begin(), defs.end(), entryLess);
+        for (size_t i = 0; i < defs.size(); ++i) {
+            if (i > 0 && defs[i].id == defs[i - 1].id) {
+                Issue issue;
+                issue.type = IssueType::Duplicate;
+                issue.kind = static_cast<IdKind>(k);
+                issue.id = defs[i].id;
+                issue.location = location(defs[i]);
+                issue.previous = location(firstDefinition[k].back());
+                duplicates[k].push_back(issue);
+                continue;
+            }
+            ids[k].push_back(defs[i].id);
+            firstDefinition[k].push_back(defs[i]);
+        }
+        report.definitions[k] = defs.size();
+        report.references[k] = fields.references[k].size() + fields.ranges[k].size();
+        defs.clear();
+        defs.shrink_to_fit();
+    }, options.threads);
+
+    // Resolve references block-wise; hits mark definitions as used
+    std::array<std::unique_ptr<std::atomic<uint8_t>[]>, kIdKindCount> used;
+    std::array<std::vector<Issue>, kIdKindCount> dangling;
+
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        const auto& table = ids[k];
+        const auto& references = fields.references[k];
+        const auto& ranges = fields.ranges[k];
+        if (references.empty() && ranges.empty()) {
+            continue;
+        }
+        used[k] = std::make_unique<std::atomic<uint8_t>[]>(table.size());
+        for (size_t i = 0; i < table.size(); ++i) {
+            used[k][i].store(0, std::memory_order_relaxed);
+        }
+
+        // A range uses every ID defined inside it and dangles when there is none
+        for (const auto& range : ranges) {
+            auto begin = std::lower_bound(table.begin(), table.end(), range.first);
+            auto end = std::upper_bound(begin, table.end(), range.last);
+            if (begin == end) {
+                Issue issue;
+                issue.type = IssueType::Dangling;
+                issue.kind = static_cast<IdKind>(k);
+                issue.id = range.first;
+                issue.last = range.last;
+                issue.location = Location{keywords[range.keyword], range.item};
+                dangling[k].push_back(issue);
+            }
+            for (auto it = begin; it != end; ++it) {
+                used[k][static_cast<size_t>(it - table.begin())].store(1, std::memory_order_relaxed);
+            }
+        }
+
+        size_t blocks = util::blockCount(references.size(), kReferenceBlockSize);
+        std::vector<std::vector<Entry>> missing(blocks);
+        util::parallelForBlocks(references.size(), kReferenceBlockSize,
+            [&](size_t b, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    auto it = std::lower_bound(table.begin(), table.end(), references[i].id);
+                    if (it != table.end() && *it == references[i].id) {
+                        used[k][static_cast<size_t>(it - table.begin())].store(1, std::memory_order_relaxed);
+                    } else {
+                        missing[b].push_back(references[i]);
+                    }
+                }
+            }, options.threads);
+
+        // One issue per missing ID, located at its first reference
+        std::vector<Entry> all;
+        for (auto& m : missing) {
+            all.insert(all.end(), m.begin(), m.end());
+        }
+        std::sort(all.begin(), all.end(), entryLess);
+        for (size_t i = 0; i < all.size(); ++i) {
+            if (i > 0 && all[i].id == all[i - 1].id) {
+                ++dangling[k].back().count;
+                continue;
+            }
+            Issue issue;
+            issue.type = IssueType::Dangling;
+            issue.kind = static_cast<IdKind>(k);
+            issue.id = all[i].id;
+            issue.location = location(all[i]);
+            dangling[k].push_back(issue);
+        }
+        std::stable_sort(dangling[k].begin(), dangling[k].end(),
+                         [](const Issue& a, const Issue& b) { return a.id < b.id; });
+    }
+
+    for (const auto& list : duplicates) {
+        report.issues.insert(report.issues.end(), list.begin(), list.end());
+        report.duplicateCount += list.size();
+    }
+    for (const auto& list : dangling) {
+        report.issues.insert(report.issues.end(), list.begin(), list.end());
+        report.danglingCount += list.size();
+    }
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        if (!options.reportUnused[k]) {
+            continue;
+        }
+        for (size_t i = 0; i < ids[k].size(); ++i) {
+            if (used[k] && used[k][i].load(std::memory_order_relaxed)) {
+                continue;
+            }
+            Issue issue;
+            issue.type = IssueType::Unused;
+            issue.kind = static_cast<IdKind>(k);
+            issue.id = ids[k][i];
+            issue.location = location(firstDefinition[k][i]);
+            report.issues.push_back(issue);
+            ++report.unusedCount;
+        }
+    }
+    return report;
+}
+
+std::string IntegrityManager::formatIssue(const Issue& issue) {
+    std::ostringstream oss;
+    std::string where = issue.location.toString();
+    if (!where.empty()) {
+        oss << where << ": ";
+    }
+    const char* kind = idKindName(issue.kind);
+    switch (issue.type) {
+        case IssueType::Duplicate:
+            oss << "duplicate " << kind << " ID " << issue.id
+                << " (first defined at " << issue.previous.toString() << ")";
+            break;
+        case IssueType::Dangling:
+            if (issue.last != 0) {
+                oss << "no " << kind << " ID defined in range " << issue.id << "-" << issue.last;
+                break;
+            }
+            oss << "undefined " << kind << " ID " << issue.id;
+            if (issue.count > 1) {
+                oss << " (" << issue.count << " references)";
+            }
+            break;
+        case IssueType::Unused:
+            oss << kind << " ID " << issue.id << " is not referenced";
+            break;
+    }
+    return oss.str();
+}
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,407 @@
+#include <koo/dyna/managers/MassPropertiesManager.hpp>
+#include <koo/dyna/Element.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Part.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/util/MeshGeometry.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+namespace koo::dyna::managers {
+
+namespace {
+
+using InertiaTensor = MassPropertiesManager::InertiaTensor;
+using MassProperties = MassPropertiesManager::MassProperties;
+
+constexpr size_t kBlockSize = 4096;
+
+enum class Shape { Shell, Solid, Beam, Mass, Inertia };
+
+/**
+ * @brief Element reference prepared for the parallel passes
+ */
+struct ElementRef {
+    const ElementData* element = nullptr;
+    Shape shape = Shape::Shell;
+};
+
+/**
+ * @brief Part properties resolved once per part
+ */
+struct PartProperties {
+    double density = 0.0;
+    double shellThickness = 0.0;
+    double beamArea = 0.0;
+    bool partInertia = false;  // Mass properties given by *PART_INERTIA
+};
+
+/**
+ * @brief Lookup tables shared by all workers (read-only during the passes)
+ */
+struct Context {
+    std::unordered_map<NodeId, Vec3> positions;
+    std::unordered_map<PartId, PartProperties> parts;
+    std::unordered_map<ElementId, double> thicknessOverrides;
+};
+
+/**
+ * @brief Mass of one element lumped to its distinct nodes
+ */
+struct LumpedElement {
+    double mass = 0.0;
+    Vec3 points[8];
+    size_t pointCount = 0;
+    InertiaTensor ownInertia;  // ELEMENT_INERTIA tensor about its node
+};
+
+/**
+ * @brief Running sums of one part
+ */
+struct Accumulator {
+    double mass = 0.0;
+    Vec3 firstMoment;
+    InertiaTensor inertia;
+    size_t elementCount = 0;
+};
+
+using BlockSums = std::unordered_map<PartId, Accumulator>;
+
+/**
+ * @brief Compute the lumped mass of an element
+ * @return false if the element has no density, no geometry or belongs to
+ *         a *PART_INERTIA part
+ */
+bool lumpElement(const ElementRef& ref, const Context& ctx, LumpedElement& out) {
+    const ElementData& elem = *ref.element;
+    out = LumpedElement();
+
+    // Distinct node positions (degenerate elements repeat node IDs)
+    NodeId seen[8];
+    Vec3 nodes[8];
+    size_t nodeCount = std::min<size_t>(elem.nodeIds.size(), 8);
+    for (size_t n = 0; n < nodeCount; ++n) {
+        auto posIt = ctx.positions.find(elem.nodeIds[n]);
+        if (posIt == ctx.positions.end()) {
+            return false;
+        }
+        nodes[n] = posIt->second;
+        if (std::find(seen, seen + out.pointCount, elem.nodeIds[n]) == seen + out.pointCount) {
+            seen[out.pointCount] = elem.nodeIds[n];
+            out.points[out.pointCount++] = nodes[n];
+        }
+    }
+    if (out.pointCount == 0) {
+        return false;
+    }
+
+    if (ref.shape == Shape::Mass) {
+        out.mass = static_cast<const MassElementData&>(elem).mass;
+        return true;
+    }
+    if (ref.shape == Shape::Inertia) {
+        const auto& inertia = static_cast<const InertiaElementData&>(elem);
+        out.mass = inertia.mass;
+        out.ownInertia = {inertia.ixx, inertia.ixy, inertia.ixz,
+                          inertia.iyy, inertia.iyz, inertia.izz};
+        return true;
+    }
+
+    auto propIt = ctx.parts.find(elem.pid);
+    if (propIt == ctx.parts.end() || propIt->second.partInertia || propIt->second.density <= 0.0) {
+        return false;
+    }
+    const PartProperties& props = propIt->second;
+
+    switch (ref.shape) {
+        case Shape::Shell: {
+            size_t corners = nodeCount;
+            if (corners == 4 && (elem.nodeIds[3] == 0 || elem.nodeIds[3] == elem.nodeIds[2])) {
+                corners = 3;
+            }
+            if (corners < 3) {
+                return false;
+            }
+            double thickness = props.shellThickness;
+            const auto& shell = static_cast<const ShellElementData&>(elem);
+            if (shell.thickness > 0.0) {
+                thickness = shell.thickness;
+            }
+            auto overrideIt = ctx.thicknessOverrides.find(elem.id);
+            if (overrideIt != ctx.thicknessOverrides.end()) {
+                thickness = overrideIt->second;
+            }
+            double area = corners == 3 ? util::triangleArea(nodes[0], nodes[1], nodes[2])
+                                       : util::quadArea(nodes[0], nodes[1], nodes[2], nodes[3]);
+            out.mass = props.density * area * thickness;
+            break;
+        }
+        case Shape::Solid: {
+            if (nodeCount < 4) {
+                return false;
+            }
+            for (size_t n = nodeCount; n < 8; ++n) {
+                nodes[n] = nodes[nodeCount - 1];
+            }
+            out.mass = props.density * util::computeSolidGeometry(nodes).volume;
+            break;
+        }
+        case Shape::Beam: {
+            if (nodeCount < 2) {
+                return false;
+            }
+            // Orientation node does not carry mass
+            out.pointCount = std::min<size_t>(out.pointCount, 2);
+            out.mass = props.density * props.beamArea * (nodes[1] - nodes[0]).length();
+            break;
+        }
+        default:
+            return false;
+    }
+    return true;
+}
+
+void addPointInertia(InertiaTensor& t, double m, const Vec3& d) {
+    t.ixx += m * (d.y * d.y + d.z * d.z);
+    t.iyy += m * (d.x * d.x + d.z * d.z);
+    t.izz += m * (d.x * d.x + d.y * d.y);
+    t.ixy -= m * d.x * d.y;
+    t.ixz -= m * d.x * d.z;
+    t.iyz -= m * d.y * d.z;
+}
+
+void addTensor(InertiaTensor& t, const InertiaTensor& other) {
+    t.ixx += other.ixx;
+    t.ixy += other.ixy;
+    t.ixz += other.ixz;
+    t.iyy += other.iyy;
+    t.iyz += other.iyz;
+    t.izz += other.izz;
+}
+
+} // anonymous namespace
+
+MassPropertiesManager::MassPropertiesManager(Model& model)
+    : model_(model)
+{
+}
+
+MassPropertiesManager::InertiaTensor MassPropertiesManager::shiftInertia(
+    const InertiaTensor& tensor, double mass, const Vec3& offset) {
+    InertiaTensor result = tensor;
+    addPointInertia(result, mass, offset);
+    return result;
+}
+
+// ============================================================================
+// Calculation
+// ============================================================================
+
+MassPropertiesManager::Report MassPropertiesManager::compute(const Options& options) const {
+    Report report;
+    Context ctx;
+
+    // Node coordinates
+    ctx.positions = model_.getNodePositions();
+
+    // Densities and section properties, indexed once
+    std::unordered_map<MaterialId, double> densities;
+    for (const auto* mat : model_.getMaterials()) {
+        if (auto constants = getElasticConstants(*mat)) {
+            densities.emplace(mat->getMaterialId(), constants->density);
+        }
+    }
+    std::unordered_map<SectionId, SectionProperties> sections;
+    for (const auto* sec : model_.getSections()) {
+        sections.emplace(sec->getSectionId(), getSectionProperties(*sec));
+    }
+
+    auto resolvePart = [&](MaterialId mid, SectionId secid) {
+        PartProperties props;
+        auto matIt = densities.find(mid);
+        if (matIt != densities.end()) {
+            props.density = matIt->second;
+        }
+        auto secIt = sections.find(secid);
+        if (secIt != sections.end()) {
+            props.shellThickness = secIt->second.shellThickness;
+            props.beamArea = secIt->second.beamArea;
+        }
+        return props;
+    };
+
+    for (const auto* partKw : model_.getKeywordsOfType<Part>()) {
+        for (const auto& part : partKw->getParts()) {
+            ctx.parts[part.id] = resolvePart(part.mid, part.secid);
+        }
+    }
+
+    // *PART_INERTIA parts carry their own mass properties
+    std::map<PartId, MassProperties> givenParts;
+    for (const auto* inertiaKw : model_.getKeywordsOfType<PartInertia>()) {
+        const auto& data = inertiaKw->getData();
+        PartProperties props = resolvePart(data.mid, data.secid);
+        props.partInertia = true;
+        ctx.parts[data.pid] = props;
+
+        MassProperties& given = givenParts[data.pid];
+        given.mass = data.tm;
+        given.centerOfGravity = Vec3(data.xc, data.yc, data.zc);
+        given.inertia = {data.ixx, data.ixy, data.ixz, data.iyy, data.iyz, data.izz};
+    }
+
+    for (const auto* kw : model_.getKeywordsOfType<ElementShellThickness>()) {
+        for (const auto& t : kw->getThicknessData()) {
+            double thick = t.getAverageThickness();
+            if (thick > 0.0) {
+                ctx.thicknessOverrides[t.eid] = thick;
+            }
+        }
+    }
+
+    // Flatten all mass-carrying elements
+    std::vector<ElementRef> refs;
+    auto collect = [&refs](const auto& keywords, Shape shape) {
+        for (const auto* kw : keywords) {
+            for (const auto& elem : kw->getElements()) {
+                refs.push_back({&elem, shape});
+            }
+        }
+    };
+    collect(model_.getKeywordsOfType<ElementShell>(), Shape::Shell);
+    collect(model_.getKeywordsOfType<ElementSolid>(), Shape::Solid);
+    collect(model_.getKeywordsOfType<ElementTshell>(), Shape::Solid);
+    collect(model_.getKeywordsOfType<ElementBeam>(), Shape::Beam);
+    collect(model_.getKeywordsOfType<ElementMass>(), Shape::Mass);
+    collect(model_.getKeywordsOfType<ElementInertia>(), Shape::Inertia);
+
+    const size_t nBlocks = util::blockCount(refs.size(), kBlockSize);
+    std::vector<BlockSums> blocks(nBlocks);
+    std::vector<size_t> blockSkipped(nBlocks, 0);
+
+    // Pass 1: mass and first moment per part
+    util::parallelForBlocks(refs.size(), kBlockSize, [&](size_t b, size_t begin, size_t end) {
+        LumpedElement lumped;
+        BlockSums& sums = blocks[b];
+        for (size_t i = begin; i < end; ++i) {
+            if (!lumpElement(refs[i], ctx, lumped)) {
+                auto propIt = ctx.parts.find(refs[i].element->pid);
+                bool givenPart = propIt != ctx.parts.end() && propIt->second.partInertia;
+                Accumulator& acc = sums[refs[i].element->pid];
+                if (givenPart) {
+                    ++acc.elementCount;
+                } else {
+                    ++blockSkipped[b];
+                }
+                continue;
+            }
+            Accumulator& acc = sums[refs[i].element->pid];
+            double pointMass = lumped.mass / static_cast<double>(lumped.pointCount);
+            for (size_t p = 0; p < lumped.pointCount; ++p) {
+                acc.firstMoment += lumped.points[p] * pointMass;
+            }
+            acc.mass += lumped.mass;
+            ++acc.elementCount;
+        }
+    }, options.threads);
+
+    // Combine in block order
+    std::map<PartId, Accumulator> totals;
+    for (size_t b = 0; b < nBlocks; ++b) {
+        for (const auto& [pid, acc] : blocks[b]) {
+            Accumulator& total = totals[pid];
+            total.mass += acc.mass;
+            total.firstMoment += acc.firstMoment;
+            total.elementCount += acc.elementCount;
+        }
+        report.skippedCount += blockSkipped[b];
+    }
+
+    std::unordered_map<PartId, Vec3> centers;
+    for (const auto& [pid, acc] : totals) {
+        centers[pid] = acc.mass > 0.0 ? acc.firstMoment / acc.mass : Vec3();
+    }
+
+    // Pass 2: inertia about each part's center of gravity
+    for (auto& sums : blocks) {
+        sums.clear();
+    }
+    util::parallelForBlocks(refs.size(), kBlockSize, [&](size_t b, size_t begin, size_t end) {
+        LumpedElement lumped;
+        BlockSums& sums = blocks[b];
+        for (size_t i = begin; i < end; ++i) {
+            if (!lumpElement(refs[i], ctx, lumped)) {
+                continue;
+            }
+            PartId pid = refs[i].element->pid;
+            const Vec3& center = centers.at(pid);
+            Accumulator& acc = sums[pid];
+            double pointMass = lumped.mass / static_cast<double>(lumped.pointCount);
+            for (size_t p = 0; p < lumped.pointCount; ++p) {
+                addPointInertia(acc.inertia, pointMass, lumped.points[p] - center);
+            }
+            addTensor(acc.inertia, lumped.ownInertia);
+        }
+    }, options.threads);
+
+    for (size_t b = 0; b < nBlocks; ++b) {
+        for (const auto& [pid, acc] : blocks[b]) {
+            addTensor(totals[pid].inertia, acc.inertia);
+        }
+    }
+
+    // Per-part results
+    for (auto& [pid, given] : givenParts) {
+        auto it = totals.find(pid);
+        given.elementCount = it != totals.end() ? it->second.elementCount : 0;
+    }
+    for (const auto& [pid, acc] : totals) {
+        MassProperties props;
+        props.mass = acc.mass;
+        props.centerOfGravity = centers[pid];
+        props.inertia = acc.inertia;
+        props.elementCount = acc.elementCount;
+
+        if (givenParts.count(pid)) {
+            continue;
+        }
+        if (ctx.parts.count(pid) == 0 && pid == 0) {
+            report.unassigned = props;
+            continue;
+        }
+        report.parts.push_back({pid, false, props});
+    }
+    for (const auto& [pid, given] : givenParts) {
+        report.parts.push_back({pid, true, given});
+    }
+    std::sort(report.parts.begin(), report.parts.end(),
+              [](const PartMassProperties& a, const PartMassProperties& b) { return a.pid < b.pid; });
+
+    // Model totals from the part results (parallel axis theorem)
+    std::vector<const MassProperties*> groups;
+    for (const auto& part : report.parts) {
+        groups.push_back(&part.properties);
+    }
+    groups.push_back(&report.unassigned);
+
+    Vec3 firstMoment;
+    for (const auto* group : groups) {
+        report.total.mass += group->mass;
+        report.total.elementCount += group->elementCount;
+        firstMoment += group->centerOfGravity * group->mass;
+    }
+    if (report.total.mass > 0.0) {
+        report.total.centerOfGravity = firstMoment / report.total.mass;
+    }
+    for (const auto* group : groups) {
+        addTensor(report.total.inertia,
+                  shiftInertia(group->inertia, group->mass,
+                               group->centerOfGravity - report.total.centerOfGravity));
+    }
+
+    return report;
+}
+
+} // namespace koo::dyna::managers
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <type_traits>
 
 namespace koo::dyna::managers {
 
@@ -17,17 +18,17 @@ void NodeManager::buildIndex() {
     // Clear existing indices
     nodeToElements_.clear();
 
-    // Get all element information
-    auto allElements = getAllElementInfo();
-
     // Build node → elements mapping
-    for (const auto& elem : allElements) {
-        for (NodeId nid : elem.nodeIds) {
+    forEachElement([this](ElementId eid, util::Span<const NodeId> nodeIds, NodeId extraNode) {
+        for (NodeId nid : nodeIds) {
             if (nid != 0) {  // Skip invalid node IDs
-                nodeToElements_[nid].push_back(elem.id);
+                nodeToElements_[nid].push_back(eid);
             }
         }
-    }
+        if (extraNode != 0) {
+            nodeToElements_[extraNode].push_back(eid);
+        }
+    });
 
     indexBuilt_ = true;
 }
@@ -214,69 +215,25 @@ void NodeManager::transformNodes(const std::vector<NodeId>& nodeIds, const Matri
     }
 }
 
-std::vector<NodeManager::ElementInfo> NodeManager::getAllElementInfo() const {
-    std::vector<ElementInfo> result;
-
-    // Helper lambda to extract element info
-    auto extractInfo = [&result](const auto* elemKeyword) {
-        if (!elemKeyword) return;
-
-        const auto& elements = elemKeyword->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.nodeIds = elem.nodeIds;
-            result.push_back(info);
-        }
-    };
-
-    // Collect shell elements
-    extractInfo(model_.getShellElements());
-
-    // Collect solid elements
-    extractInfo(model_.getSolidElements());
-
-    // Collect beam elements
-    auto beamKeywords = model_.getKeywordsOfType<ElementBeam>();
-    for (auto* beamKw : beamKeywords) {
-        const auto& elements = beamKw->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.nodeIds = elem.nodeIds;
-            // Add orientation node if present
-            if (elem.n3 != 0) {
-                info.nodeIds.push_back(elem.n3);
+template<typename Fn>
+void NodeManager::forEachElement(Fn&& fn) const {
+    auto visit = [&fn](const auto& keywords) {
+        for (const auto* keyword : keywords) {
+            for (const auto& elem : keyword->getElements()) {
+                NodeId extraNode = 0;
+                if constexpr (std::is_same_v<std::decay_t<decltype(elem)>, BeamElementData>) {
+                    extraNode = elem.n3;  // Orientation node
+                }
+                fn(elem.id, util::Span<const NodeId>(elem.nodeIds), extraNode);
             }
-            result.push_back(info);
         }
-    }
-
-    // Collect discrete elements
-    auto discreteKeywords = model_.getKeywordsOfType<ElementDiscrete>();
-    for (auto* discreteKw : discreteKeywords) {
-        const auto& elements = discreteKw->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.nodeIds = elem.nodeIds;
-            result.push_back(info);
-        }
-    }
-
-    // Collect seatbelt elements
-    auto seatbeltKeywords = model_.getKeywordsOfType<ElementSeatbelt>();
-    for (auto* seatbeltKw : seatbeltKeywords) {
-        const auto& elements = seatbeltKw->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.nodeIds = elem.nodeIds;
-            result.push_back(info);
-        }
-    }
+    };
 
-    return result;
+    visit(model_.getKeywordsOfType<ElementShell>());
+    visit(model_.getKeywordsOfType<ElementSolid>());
+    visit(model_.getKeywordsOfType<ElementBeam>());
+    visit(model_.getKeywordsOfType<ElementDiscrete>());
+    visit(model_.getKeywordsOfType<ElementSeatbelt>());
 }
 
 } // namespace koo::dyna::managers
@@ -3,7 +3,7 @@
 #include <koo/dyna/Node.hpp>
 #include <koo/dyna/Part.hpp>
 #include <algorithm>
-#include <unordered_set>
+#include <type_traits>
 
 namespace koo::dyna::managers {
 
@@ -18,33 +18,33 @@ void PartManager::buildIndex() {
     partToElements_.clear();
     partToNodes_.clear();
 
-    // Get all element information
-    auto allElements = getAllElementInfo();
-
-    // Build part → elements mapping
-    for (const auto& elem : allElements) {
-        partToElements_[elem.pid].push_back(elem.id);
-    }
-
-    // Build part → nodes mapping (unique nodes per part)
-    for (const auto& [pid, elementIds] : partToElements_) {
-        std::unordered_set<NodeId> uniqueNodes;
-
-        // Collect all nodes from all elements in this part
-        for (const auto& elem : allElements) {
-            if (elem.pid == pid) {
-                for (NodeId nid : elem.nodeIds) {
-                    if (nid != 0) {  // Skip invalid node IDs
-                        uniqueNodes.insert(nid);
-                    }
-                }
+    // Build part → elements and part → nodes mappings in one pass.
+    // Elements of one part are usually contiguous, so cache the last lookup.
+    PartId lastPid = 0;
+    std::vector<ElementId>* elements = nullptr;
+    std::vector<NodeId>* nodes = nullptr;
+
+    forEachElement([&](ElementId eid, PartId pid, util::Span<const NodeId> nodeIds, NodeId extraNode) {
+        if (!elements || pid != lastPid) {
+            lastPid = pid;
+            elements = &partToElements_[pid];
+            nodes = &partToNodes_[pid];
+        }
+        elements->push_back(eid);
+        for (NodeId nid : nodeIds) {
+            if (nid != 0) {  // Skip invalid node IDs
+                nodes->push_back(nid);
             }
         }
+        if (extraNode != 0) {
+            nodes->push_back(extraNode);
+        }
+    });
 
-        // Convert to sorted vector
-        std::vector<NodeId> nodeVec(uniqueNodes.begin(), uniqueNodes.end());
+    // Unique nodes per part, sorted
+    for (auto& [pid, nodeVec] : partToNodes_) {
         std::sort(nodeVec.begin(), nodeVec.end());
-        partToNodes_[pid] = std::move(nodeVec);
+        nodeVec.erase(std::unique(nodeVec.begin(), nodeVec.end()), nodeVec.end());
     }
 
     indexBuilt_ = true;
@@ -189,80 +189,28 @@ BoundingBox PartManager::getBoundingBox(PartId pid) const {
     return bbox;
 }
 
-std::vector<PartManager::ElementInfo> PartManager::getAllElementInfo() const {
-    std::vector<ElementInfo> result;
-
-    // Helper lambda to extract element info
-    auto extractInfo = [&result](const auto* elemKeyword, ElementType type) {
-        if (!elemKeyword) return;
-
-        const auto& elements = elemKeyword->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.pid = elem.pid;
-            info.nodeIds = elem.nodeIds;
-            info.type = type;
-            result.push_back(info);
-        }
-    };
-
-    // Collect shell elements
-    extractInfo(model_.getShellElements(), ElementType::Shell);
-
-    // Collect solid elements
-    extractInfo(model_.getSolidElements(), ElementType::Solid);
-
-    // Collect beam elements
-    auto beamKeywords = model_.getKeywordsOfType<ElementBeam>();
-    for (auto* beamKw : beamKeywords) {
-        const auto& elements = beamKw->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.pid = elem.pid;
-            info.nodeIds = elem.nodeIds;
-            // Add orientation node if present
-            if (elem.n3 != 0) {
-                info.nodeIds.push_back(elem.n3);
+template<typename Fn>
+void PartManager::forEachElement(Fn&& fn) const {
+    auto visit = [&fn](const auto& keywords) {
+        for (const auto* keyword : keywords) {
+            for (const auto& elem : keyword->getElements()) {
+                NodeId extraNode = 0;
+                if constexpr (std::is_same_v<std::decay_t<decltype(elem)>, BeamElementData>) {
+                    extraNode = elem.n3;  // Orientation node
+                }
+                fn(elem.id, elem.pid, util::Span<const NodeId>(elem.nodeIds), extraNode);
             }
-            info.type = ElementType::Beam;
-            result.push_back(info);
         }
-    }
+    };
 
-    // Collect discrete elements
-    auto discreteKeywords = model_.getKeywordsOfType<ElementDiscrete>();
-    for (auto* discreteKw : discreteKeywords) {
-        const auto& elements = discreteKw->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.pid = elem.pid;
-            info.nodeIds = elem.nodeIds;
-            info.type = ElementType::Discrete;
-            result.push_back(info);
-        }
-    }
-
-    // Collect seatbelt elements
-    auto seatbeltKeywords = model_.getKeywordsOfType<ElementSeatbelt>();
-    for (auto* seatbeltKw : seatbeltKeywords) {
-        const auto& elements = seatbeltKw->getElements();
-        for (const auto& elem : elements) {
-            ElementInfo info;
-            info.id = elem.id;
-            info.pid = elem.pid;
-            info.nodeIds = elem.nodeIds;
-            info.type = ElementType::Seatbelt;
-            result.push_back(info);
-        }
-    }
+    visit(model_.getKeywordsOfType<ElementShell>());
+    visit(model_.getKeywordsOfType<ElementSolid>());
+    visit(model_.getKeywordsOfType<ElementBeam>());
+    visit(model_.getKeywordsOfType<ElementDiscrete>());
+    visit(model_.getKeywordsOfType<ElementSeatbelt>());
 
     // Note: Mass elements don't have part IDs in LS-DYNA
     // (they use PID=0 or no PID), so we skip them for part-based queries
-
-    return result;
 }
 
 } // namespace koo::dyna::managers
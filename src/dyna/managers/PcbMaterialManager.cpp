@@ -0,0 +1,492 @@
+#include <koo/dyna/managers/PcbMaterialManager.hpp>
+#include <koo/dyna/Node.hpp>
+#include <koo/dyna/Element.hpp>
+#include <koo/dyna/Part.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/ecad/OdbJob.hpp>
+#include <koo/ecad/CopperArea.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+namespace koo::dyna::managers {
+
+namespace {
+
+constexpr size_t kBlockSize = 4096;
+constexpr size_t kMaxCells = size_t(1) << 24;
+constexpr size_t kMaxHull = 16;
+
+/// Projected element footprint (convex, counter-clockwise, layer units)
+struct Hull {
+    std::array<ecad::Point2D, kMaxHull> points;
+    size_t size = 0;
+    bool missingNode = false;
+};
+
+/// One raster cell under an element footprint
+struct Weight {
+    uint32_t cell = 0;
+    float weight = 0.0f;    ///< Share of the footprint area
+};
+
+/// A copper layer to measure
+struct CopperLayer {
+    std::string name;
+    const ecad::Layer* layer = nullptr;
+    double thickness = 0.0;
+};
+
+// Helper to lowercase a layer name
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return s;
+}
+
+// Helper to tell whether a layer type carries copper
+bool isCopperType(ecad::LayerType type) {
+    return type == ecad::LayerType::Signal || type == ecad::LayerType::PowerGround ||
+           type == ecad::LayerType::Mixed;
+}
+
+// Helper to collect the elements to map: shells first, then solids
+std::vector<ElementData*> collectElements(Model& model, const std::vector<PartId>& parts,
+                                          size_t& shellCount) {
+    std::unordered_set<PartId> wanted(parts.begin(), parts.end());
+    std::vector<ElementData*> elements;
+    for (auto* keyword : model.getKeywordsOfType<ElementShell>()) {
+        for (auto& element : keyword->getElements()) {
+            if (wanted.empty() || wanted.count(element.pid)) elements.push_back(&element);
+        }
+    }
+    shellCount = elements.size();
+    for (auto* keyword : model.getKeywordsOfType<ElementSolid>()) {
+        for (auto& element : keyword->getElements()) {
+            if (wanted.empty() || wanted.count(element.pid)) elements.push_back(&element);
+        }
+    }
+    return elements;
+}
+
+// Helper to cross the vectors oa and ob
+double cross(const ecad::Point2D& o, const ecad::Point2D& a, const ecad::Point2D& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Helper to project an element onto the layer plane as a convex hull
+void buildHull(const ElementData& element, const std::vector<const Node*>& nodes,
+               double scale, double offsetX, double offsetY, Hull& hull) {
+    std::array<ecad::Point2D, kMaxHull> points;
+    size_t count = 0;
+    hull.size = 0;
+    hull.missingNode = false;
+    for (NodeId id : element.nodeIds) {
+        if (id == 0) continue;
+        const NodeData* node = nullptr;
+        for (const Node* keyword : nodes) {
+            if ((node = keyword->getNode(id))) break;
+        }
+        if (!node) {
+            hull.missingNode = true;
+            continue;
+        }
+        ecad::Point2D p((node->position.x - offsetX) / scale, (node->position.y - offsetY) / scale);
+        if (std::find(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(count), p) ==
+                points.begin() + static_cast<std::ptrdiff_t>(count) && count < kMaxHull) {
+            points[count++] = p;
+        }
+    }
+    std::sort(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(count),
+              [](const ecad::Point2D& a, const ecad::Point2D& b) {
+                  return a.x < b.x || (a.x == b.x && a.y < b.y);
+              });
+    if (count < 3) {
+        std::copy(points.begin(), points.begin() + static_cast<std::ptrdiff_t>(count), hull.points.begin());
+        hull.size = count;
+        return;
+    }
+
+    // Monotone chain
+    std::array<ecad::Point2D, 2 * kMaxHull> chain;
+    size_t k = 0;
+    for (size_t i = 0; i < count; ++i) {
+        while (k >= 2 && cross(chain[k - 2], chain[k - 1], points[i]) <= 0.0) --k;
+        chain[k++] = points[i];
+    }
+    for (size_t i = count - 1, lowerSize = k + 1; i-- > 0;) {
+        while (k >= lowerSize && cross(chain[k - 2], chain[k - 1], points[i]) <= 0.0) --k;
+        chain[k++] = points[i];
+    }
+    hull.size = std::min(k - 1, kMaxHull);
+    std::copy(chain.begin(), chain.begin() + static_cast<std::ptrdiff_t>(hull.size), hull.points.begin());
+}
+
+// Helper to measure a polygon
+double polygonArea(const ecad::Point2D* points, size_t count) {
+    double twice = 0.0;
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        twice += points[j].x * points[i].y - points[i].x * points[j].y;
+    }
+    return 0.5 * twice;
+}
+
+// Helper to bound a hull
+ecad::BoundingBox2D hullBounds(const Hull& hull) {
+    ecad::BoundingBox2D box;
+    for (size_t i = 0; i < hull.size; ++i) box.expand(hull.points[i]);
+    return box;
+}
+
+// Helper to clip a convex polygon against one side of an axis line
+size_t clipAxis(const ecad::Point2D* in, size_t count, ecad::Point2D* out,
+                bool vertical, double value, bool keepAbove) {
+    auto inside = [&](const ecad::Point2D& p) {
+        double c = vertical ? p.x : p.y;
+        return keepAbove ? c >= value : c <= value;
+    };
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const ecad::Point2D& a = in[i];
+        const ecad::Point2D& b = in[(i + 1) % count];
+        bool aIn = inside(a);
+        bool bIn = inside(b);
+        if (aIn) out[n++] = a;
+        if (aIn != bIn) {
+            double t = vertical ? (value - a.x) / (b.x - a.x) : (value - a.y) / (b.y - a.y);
+            out[n++] = vertical ? ecad::Point2D(value, a.y + t * (b.y - a.y))
+                                : ecad::Point2D(a.x + t * (b.x - a.x), value);
+        }
+    }
+    return n;
+}
+
+// Helper to measure the part of a convex hull inside a cell
+double overlapArea(const Hull& hull, double x0, double y0, double x1, double y1) {
+    std::array<ecad::Point2D, kMaxHull + 8> a;
+    std::array<ecad::Point2D, kMaxHull + 8> b;
+    size_t n = clipAxis(hull.points.data(), hull.size, a.data(), true, x0, true);
+    if (n) n = clipAxis(a.data(), n, b.data(), true, x1, false);
+    if (n) n = clipAxis(b.data(), n, a.data(), false, y0, true);
+    if (n) n = clipAxis(a.data(), n, b.data(), false, y1, false);
+    return n >= 3 ? std::abs(polygonArea(b.data(), n)) : 0.0;
+}
+
+// Helper to format a copper share for part titles
+std::string shareTitle(const char* kind, double share) {
+    std::ostringstream out;
+    out << "PCB " << kind << " Cu " << std::fixed << std::setprecision(1) << share * 100.0 << "%";
+    return out.str();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// PcbMaterialManager - Construction
+// ============================================================================
+
+PcbMaterialManager::PcbMaterialManager(Model& model, const ecad::OdbJob& job, const ecad::Step& step)
+    : model_(model), job_(job), step_(step) {}
+
+// ============================================================================
+// PcbMaterialManager - Mapping
+// ============================================================================
+
+PcbMaterialManager::Result PcbMaterialManager::computeFractions(const Options& options) const {
+    Result result;
+    const double scale = options.scale > 0.0 ? options.scale : 1.0;
+
+    // Copper layers: stackup first, matrix copper rows when there is none
+    std::vector<CopperLayer> copper;
+    const auto& stackup = job_.getStackup();
+    for (const auto& entry : stackup) {
+        result.stackThickness += entry.thickness * options.thicknessScale;
+        if (entry.materialType != ecad::StackupMaterialType::Copper) continue;
+        const ecad::Layer* layer = step_.getLayer(entry.name);
+        if (!layer) {
+            std::string name = lower(entry.name);
+            for (const auto& [stepName, stepLayer] : step_.getLayers()) {
+                if (lower(stepName) == name) {
+                    layer = stepLayer.get();
+                    break;
+                }
+            }
+        }
+        if (!layer && entry.layerIndex >= 0) {
+            for (const auto& def : job_.getMatrix().getLayerDefinitions()) {
+                if (def.row == entry.layerIndex) {
+                    layer = step_.getLayer(def.name);
+                    break;
+                }
+            }
+        }
+        if (!layer) {
+            result.warnings.push_back("Stackup copper layer '" + entry.name + "' not found in step '" +
+                                      step_.getName() + "'");
+            continue;
+        }
+        copper.push_back({entry.name, layer, entry.thickness * options.thicknessScale});
+    }
+    if (stackup.empty()) {
+        result.warnings.push_back("Job has no stackup; using matrix copper layers");
+        std::vector<const ecad::LayerDefinition*> defs;
+        for (const auto& def : job_.getMatrix().getLayerDefinitions()) {
+            if (def.context == ecad::LayerContext::Board && isCopperType(def.type)) defs.push_back(&def);
+        }
+        std::stable_sort(defs.begin(), defs.end(),
+                         [](const ecad::LayerDefinition* a, const ecad::LayerDefinition* b) {
+                             return a->row < b->row;
+                         });
+        for (const auto* def : defs) {
+            if (const ecad::Layer* layer = step_.getLayer(def->name)) {
+                copper.push_back({def->name, layer, def->thickness * options.thicknessScale});
+            }
+        }
+    }
+    for (const auto& layer : copper) {
+        result.layers.push_back(layer.name);
+        result.layerThickness.push_back(layer.thickness);
+    }
+
+    // Elements and the nodes they reference
+    size_t shellCount = 0;
+    std::vector<ElementData*> elements = collectElements(model_, options.parts, shellCount);
+    const size_t count = elements.size();
+    result.elements.reserve(count);
+    for (const ElementData* element : elements) result.elements.push_back(element->id);
+    result.fractions.assign(count * copper.size(), 0.0);
+    result.volumeShares.assign(count, 0.0);
+    if (count == 0) return result;
+
+    std::vector<const Node*> nodes;
+    for (const Node* keyword : const_cast<const Model&>(model_).getKeywordsOfType<Node>()) {
+        nodes.push_back(keyword);
+    }
+
+    // Footprint bounds and mean size, combined in block order
+    const size_t blocks = util::blockCount(count, kBlockSize);
+    std::vector<ecad::BoundingBox2D> blockBounds(blocks);
+    std::vector<double> blockWidth(blocks, 0.0);
+    std::vector<size_t> blockMissing(blocks, 0);
+    util::parallelForBlocks(count, kBlockSize, [&](size_t block, size_t first, size_t last) {
+        Hull hull;
+        for (size_t e = first; e < last; ++e) {
+            buildHull(*elements[e], nodes, scale, options.offsetX, options.offsetY, hull);
+            if (hull.missingNode) ++blockMissing[block];
+            if (hull.size == 0) continue;
+            blockBounds[block].expand(hullBounds(hull));
+            if (hull.size >= 3) {
+                blockWidth[block] += std::sqrt(std::abs(polygonArea(hull.points.data(), hull.size)));
+            }
+        }
+    }, options.threads);
+
+    ecad::BoundingBox2D bounds;
+    double widthSum = 0.0;
+    size_t missing = 0;
+    for (size_t b = 0; b < blocks; ++b) {
+        if (blockBounds[b].isValid()) bounds.expand(blockBounds[b]);
+        widthSum += blockWidth[b];
+        missing += blockMissing[b];
+    }
+    if (missing > 0) {
+        result.warnings.push_back(std::to_string(missing) + " elements reference missing nodes");
+    }
+    if (!bounds.isValid() || copper.empty()) return result;
+
+    // Raster over the footprints, capped in size
+    double cell = options.cellSize > 0.0 ? options.cellSize / scale
+                                         : 0.5 * widthSum / static_cast<double>(count);
+    if (cell <= 0.0) cell = std::max(bounds.width(), bounds.height()) / 256.0;
+    if (cell <= 0.0) cell = 1.0;
+    size_t columns = 0;
+    size_t rows = 0;
+    for (;;) {
+        columns = std::max<size_t>(1, static_cast<size_t>(std::ceil(bounds.width() / cell)));
+        rows = std::max<size_t>(1, static_cast<size_t>(std::ceil(bounds.height() / cell)));
+        if (columns * rows <= kMaxCells) break;
+        cell *= std::sqrt(static_cast<double>(columns * rows) / static_cast<double>(kMaxCells)) * 1.01;
+    }
+    ecad::BoundingBox2D grid(bounds.min, {bounds.min.x + static_cast<double>(columns) * cell,
+                                          bounds.min.y + static_cast<double>(rows) * cell});
+
+    // Cells under each footprint, as a CSR table
+    std::vector<std::vector<Weight>> blockWeights(blocks);
+    std::vector<size_t> offsets(count + 1, 0);
+    util::parallelForBlocks(count, kBlockSize, [&](size_t block, size_t first, size_t last) {
+        Hull hull;
+        auto& weights = blockWeights[block];
+        auto cellOf = [&](double v, double origin, size_t limit) {
+            double c = std::floor((v - origin) / cell);
+            return c <= 0.0 ? size_t(0) : std::min(static_cast<size_t>(c), limit - 1);
+        };
+        for (size_t e = first; e < last; ++e) {
+            size_t before = weights.size();
+            buildHull(*elements[e], nodes, scale, options.offsetX, options.offsetY, hull);
+            if (hull.size > 0) {
+                ecad::BoundingBox2D box = hullBounds(hull);
+                double area = hull.size >= 3 ? std::abs(polygonArea(hull.points.data(), hull.size)) : 0.0;
+                size_t c0 = cellOf(box.min.x, grid.min.x, columns);
+                size_t c1 = cellOf(box.max.x, grid.min.x, columns);
+                size_t r0 = cellOf(box.min.y, grid.min.y, rows);
+                size_t r1 = cellOf(box.max.y, grid.min.y, rows);
+                if (area > 0.0) {
+                    for (size_t r = r0; r <= r1; ++r) {
+                        double y0 = grid.min.y + static_cast<double>(r) * cell;
+                        for (size_t c = c0; c <= c1; ++c) {
+                            double x0 = grid.min.x + static_cast<double>(c) * cell;
+                            double a = overlapArea(hull, x0, y0, x0 + cell, y0 + cell);
+                            if (a > 0.0) {
+                                weights.push_back({static_cast<uint32_t>(r * columns + c),
+                                                   static_cast<float>(a / area)});
+                            }
+                        }
+                    }
+                } else {
+                    // Edge-on element: sample the cell under its center
+                    ecad::Point2D center = box.center();
+                    size_t c = cellOf(center.x, grid.min.x, columns);
+                    size_t r = cellOf(center.y, grid.min.y, rows);
+                    weights.push_back({static_cast<uint32_t>(r * columns + c), 1.0f});
+                }
+            }
+            offsets[e + 1] = weights.size() - before;
+        }
+    }, options.threads);
+    for (size_t e = 0; e < count; ++e) offsets[e + 1] += offsets[e];
+    std::vector<Weight> weights;
+    weights.reserve(offsets[count]);
+    for (auto& block : blockWeights) {
+        weights.insert(weights.end(), block.begin(), block.end());
+        std::vector<Weight>().swap(block);
+    }
+
+    // Copper fraction per layer: area-weighted raster density
+    const size_t layerCount = copper.size();
+    const double cellArea = cell * cell;
+    ecad::CopperArea::Options areaOptions;
+    areaOptions.threads = options.threads;
+    areaOptions.symbols = &job_.getSymbolCache();
+    for (size_t l = 0; l < layerCount; ++l) {
+        ecad::CopperArea area(*copper[l].layer, areaOptions);
+        auto map = area.getDensityMap(grid, columns, rows);
+        util::parallelFor(count, [&](size_t e) {
+            double sum = 0.0;
+            for (size_t w = offsets[e]; w < offsets[e + 1]; ++w) {
+                sum += static_cast<double>(weights[w].weight) * map.area[weights[w].cell];
+            }
+            result.fractions[e * layerCount + l] = std::clamp(sum / cellArea, 0.0, 1.0);
+        }, options.threads);
+    }
+
+    // Copper share of the stack volume (mean fraction without thicknesses)
+    for (size_t e = 0; e < count; ++e) {
+        const double* f = &result.fractions[e * layerCount];
+        double share = 0.0;
+        if (result.stackThickness > 0.0) {
+            for (size_t l = 0; l < layerCount; ++l) share += copper[l].thickness * f[l];
+            share /= result.stackThickness;
+        } else {
+            for (size_t l = 0; l < layerCount; ++l) share += f[l];
+            share /= static_cast<double>(layerCount);
+        }
+        result.volumeShares[e] = std::clamp(share, 0.0, 1.0);
+    }
+    return result;
+}
+
+PcbMaterialManager::Result PcbMaterialManager::apply(const Options& options) {
+    Result result = computeFractions(options);
+    size_t shellCount = 0;
+    std::vector<ElementData*> elements = collectElements(model_, options.parts, shellCount);
+    if (elements.empty() || result.layers.empty()) return result;
+    if (result.stackThickness <= 0.0 && shellCount > 0) {
+        result.warnings.push_back("Stack thickness unknown; shell sections have zero thickness");
+    }
+
+    // Levels span the shares actually present
+    const size_t levels = std::max<size_t>(1, options.levels);
+    auto [low, high] = std::minmax_element(result.volumeShares.begin(), result.volumeShares.end());
+    const double vmin = *low;
+    const double span = *high - vmin;
+    std::vector<size_t> level(elements.size(), 0);
+    std::vector<double> shareSum(2 * levels, 0.0);
+    std::vector<size_t> members(2 * levels, 0);
+    for (size_t e = 0; e < elements.size(); ++e) {
+        size_t l = span > 0.0
+            ? std::min(levels - 1, static_cast<size_t>((result.volumeShares[e] - vmin) / span *
+                                                       static_cast<double>(levels)))
+            : 0;
+        level[e] = (e < shellCount ? 0 : levels) + l;
+        shareSum[level[e]] += result.volumeShares[e];
+        ++members[level[e]];
+    }
+
+    // New IDs continue after the existing ones
+    PartId nextPart = 0;
+    for (const auto* parts : const_cast<const Model&>(model_).getKeywordsOfType<Part>()) {
+        for (const auto& part : parts->getParts()) nextPart = std::max(nextPart, part.id);
+    }
+    MaterialId nextMaterial = 0;
+    for (const auto* material : model_.getMaterials()) {
+        nextMaterial = std::max(nextMaterial, material->getMaterialId());
+    }
+    SectionId nextSection = 0;
+    for (const auto* section : model_.getSections()) {
+        nextSection = std::max(nextSection, section->getSectionId());
+    }
+
+    std::vector<PartId> levelPart(2 * levels, 0);
+    Part& parts = model_.getOrCreateParts();
+    for (size_t g = 0; g < 2 * levels; ++g) {
+        if (members[g] == 0) continue;
+        bool solid = g >= levels;
+        double share = shareSum[g] / static_cast<double>(members[g]);
+        std::string title = shareTitle(solid ? "solid" : "shell", share);
+
+        // Rule of mixtures over the stack
+        MatElasticData data;
+        data.id = ++nextMaterial;
+        data.ro = share * options.copper.ro + (1.0 - share) * options.dielectric.ro;
+        data.e = share * options.copper.e + (1.0 - share) * options.dielectric.e;
+        data.pr = share * options.copper.pr + (1.0 - share) * options.dielectric.pr;
+        data.title = title;
+        auto material = std::make_unique<MatElastic>();
+        material->setData(data);
+
+        SectionId sid = ++nextSection;
+        std::unique_ptr<Keyword> section;
+        if (solid) {
+            auto s = std::make_unique<SectionSolid>();
+            s->setSectionId(sid);
+            s->setTitle(title);
+            section = std::move(s);
+        } else {
+            auto s = std::make_unique<SectionShell>();
+            s->setSectionId(sid);
+            s->setThickness(result.stackThickness);
+            s->setTitle(title);
+            section = std::move(s);
+        }
+
+        levelPart[g] = ++nextPart;
+        parts.addPart(PartData(levelPart[g], sid, data.id, title));
+        model_.addKeyword(std::move(material));
+        model_.addKeyword(std::move(section));
+        result.createdParts.push_back(levelPart[g]);
+    }
+
+    for (size_t e = 0; e < elements.size(); ++e) {
+        elements[e]->pid = levelPart[level[e]];
+    }
+    return result;
+}
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,302 @@
+#include <koo/dyna/managers/RenumberManager.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace koo::dyna::managers {
+
+namespace {
+
+constexpr size_t kChunkSize = 8192;
+
+/**
+ * @brief A slice of one keyword's items processed as a unit
+ */
+struct Task {
+    Keyword* keyword = nullptr;
+    const IdReferenceMap::Accessor* accessor = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+using KindFlags = std::array<bool, kIdKindCount>;
+
+std::vector<Task> buildTasks(Model& model, const IdReferenceMap& refs, size_t& keywordCount,
+                             KindFlags* unmapped = nullptr) {
+    std::vector<Task> tasks;
+    keywordCount = 0;
+    for (auto& kw : model.getKeywords()) {
+        // Kinds held in fields the map cannot follow are left alone; for a
+        // keyword without an accessor that is every kind it may refer to
+        if (unmapped) {
+            for (IdKind kind : refs.unmappedKinds(*kw)) {
+                (*unmapped)[static_cast<size_t>(kind)] = true;
+            }
+        }
+        const auto* accessor = refs.find(*kw);
+        if (!accessor) {
+            continue;
+        }
+        ++keywordCount;
+        size_t count = accessor->itemCount(*kw);
+        for (size_t begin = 0; begin < count; begin += kChunkSize) {
+            tasks.push_back({kw.get(), accessor, begin, std::min(begin + kChunkSize, count)});
+        }
+    }
+    return tasks;
+}
+
+using DefinedIds = std::array<std::vector<int64_t>, kIdKindCount>;
+
+/**
+ * @brief Collect all positive defined IDs, in keyword order
+ * @param ranged Optional: set for kinds referenced through ID ranges
+ */
+DefinedIds collectDefinitions(const std::vector<Task>& tasks, size_t threads, KindFlags* ranged = nullptr) {
+    std::vector<DefinedIds> partial(tasks.size());
+    std::vector<KindFlags> partialRanged(tasks.size(), KindFlags{});
+    util::parallelFor(tasks.size(), [&](size_t t) {
+        const Task& task = tasks[t];
+        DefinedIds& out = partial[t];
+        KindFlags& outRanged = partialRanged[t];
+        task.accessor->visit(*task.keyword, task.begin, task.end,
+            [&out, &outRanged](IdKind kind, IdRole role, int64_t& id) {
+                if (id <= 0) {
+                    return;
+                }
+                if (role == IdRole::Definition) {
+                    out[static_cast<size_t>(kind)].push_back(id);
+                } else if (role == IdRole::Range) {
+                    outRanged[static_cast<size_t>(kind)] = true;
+                }
+            });
+    }, threads);
+
+    DefinedIds result;
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        size_t total = 0;
+        for (const auto& p : partial) {
+            total += p[k].size();
+        }
+        result[k].reserve(total);
+        for (const auto& p : partial) {
+            result[k].insert(result[k].end(), p[k].begin(), p[k].end());
+        }
+        if (ranged) {
+            for (const auto& r : partialRanged) {
+                (*ranged)[k] = (*ranged)[k] || r[k];
+            }
+        }
+    }
+    return result;
+}
+
+RenumberManager::IdRanges rangesOf(const DefinedIds& defined) {
+    RenumberManager::IdRanges ranges;
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        const auto& ids = defined[k];
+        if (ids.empty()) {
+            continue;
+        }
+        auto [minIt, maxIt] = std::minmax_element(ids.begin(), ids.end());
+        ranges[k].min = *minIt;
+        ranges[k].max = *maxIt;
+        ranges[k].count = ids.size();
+    }
+    return ranges;
+}
+
+} // anonymous namespace
+
+RenumberManager::RenumberManager(Model& model)
+    : model_(model)
+{
+}
+
+// ============================================================================
+// ID Ranges
+// ============================================================================
+
+RenumberManager::IdRanges RenumberManager::getIdRanges(const IdReferenceMap* references) const {
+    const IdReferenceMap& refs = references ? *references : IdReferenceMap::defaults();
+    size_t keywordCount = 0;
+    auto tasks = buildTasks(model_, refs, keywordCount);
+    return rangesOf(collectDefinitions(tasks, 0));
+}
+
+std::array<int64_t, kIdKindCount> RenumberManager::computeCollisionFreeOffsets(
+    const Model& other, const IdReferenceMap* references) const {
+    // Collection only reads the ID fields; the accessors take non-const keywords
+    RenumberManager otherManager(const_cast<Model&>(other));
+    IdRanges mine = getIdRanges(references);
+    IdRanges theirs = otherManager.getIdRanges(references);
+
+    std::array<int64_t, kIdKindCount> offsets{};
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        if (mine[k].count == 0 || theirs[k].count == 0) {
+            continue;
+        }
+        bool overlap = theirs[k].min <= mine[k].max && mine[k].min <= theirs[k].max;
+        if (overlap) {
+            offsets[k] = mine[k].max - theirs[k].min + 1;
+        }
+    }
+    return offsets;
+}
+
+// ============================================================================
+// Renumbering
+// ============================================================================
+
+RenumberManager::Result RenumberManager::renumber(const Options& options) {
+    Result result;
+    const IdReferenceMap& refs = options.references ? *options.references : IdReferenceMap::defaults();
+    KindFlags unmapped{};
+    auto tasks = buildTasks(model_, refs, result.keywordCount, &unmapped);
+
+    // Kinds that change; kinds referenced where the map cannot follow are left alone
+    const bool compact = options.mode == Mode::Compact;
+    KindFlags ranged{};
+    DefinedIds defined = collectDefinitions(tasks, options.threads, &ranged);
+    KindFlags active{};
+    for (size_t k = 0; k < kIdKindCount; ++k) {
+        bool changes = compact ? !defined[k].empty() : options.offsets[k] != 0;
+        result.skipped[k] = changes && (unmapped[k] || (compact && ranged[k]));
+        active[k] = changes && !result.skipped[k];
+    }
+
+    // Old -> new maps of the defined IDs
+    std::array<std::pair<int64_t, int64_t>, kIdKindCount> spans{};
+    util::parallelFor(kIdKindCount, [&](size_t k) {
+        if (!active[k] && !options.buildMaps) {
+            return;
+        }
+        auto& ids = defined[k];
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        if (!ids.empty()) {
+            spans[k] = {ids.front(), ids.back()};
+        }
+
+        IdMap& map = result.maps[k];
+        map.reserve(ids.size());
+        int64_t first = options.start[k] > 0 ? options.start[k] : 1;
+        int64_t offset = active[k] ? options.offsets[k] : 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            map.emplace(ids[i], compact && active[k] ? first + static_cast<int64_t>(i)
+                                                     : ids[i] + offset);
+        }
+    }, options.threads);
+
+    // Compacting moves defined IDs onto a dense range; a kept reference to an
+    // undefined ID inside that range would silently alias a renumbered one
+    if (compact) {
+        std::vector<KindFlags> partialAliased(tasks.size(), KindFlags{});
+        util::parallelFor(tasks.size(), [&](size_t t) {
+            const Task& task = tasks[t];
+            KindFlags& aliased = partialAliased[t];
+            task.accessor->visit(*task.keyword, task.begin, task.end,
+                [&](IdKind kind, IdRole role, int64_t& id) {
+                    size_t k = static_cast<size_t>(kind);
+                    if (id <= 0 || !active[k] || role != IdRole::Reference) {
+                        return;
+                    }
+                    int64_t first = options.start[k] > 0 ? options.start[k] : 1;
+                    int64_t last = first + static_cast<int64_t>(result.maps[k].size()) - 1;
+                    if (id >= first && id <= last && result.maps[k].count(id) == 0) {
+                        aliased[k] = true;
+                    }
+                });
+        }, options.threads);
+
+        for (size_t k = 0; k < kIdKindCount; ++k) {
+            bool aliased = false;
+            for (const auto& flags : partialAliased) {
+                aliased = aliased || flags[k];
+            }
+            if (!aliased) {
+                continue;
+            }
+            result.skipped[k] = true;
+            active[k] = false;
+            for (auto& entry : result.maps[k]) {
+                entry.second = entry.first;
+            }
+        }
+    }
+
+    // Rewrite every field; counters are kept per task and summed afterwards
+    using Counters = std::array<size_t, kIdKindCount>;
+    std::vector<Counters> rewritten(tasks.size(), Counters{});
+    std::vector<Counters> unresolved(tasks.size(), Counters{});
+
+    util::parallelFor(tasks.size(), [&](size_t t) {
+        const Task& task = tasks[t];
+        Counters& changed = rewritten[t];
+        Counters& missing = unresolved[t];
+        task.accessor->visit(*task.keyword, task.begin, task.end,
+            [&](IdKind kind, IdRole role, int64_t& id) {
+                size_t k = static_cast<size_t>(kind);
+                if (id <= 0 || !active[k]) {
+                    return;
+                }
+                int64_t newId = id;
+                auto it = result.maps[k].find(id);
+                if (it != result.maps[k].end()) {
+                    newId = it->second;
+                } else if (role == IdRole::Range && id >= spans[k].first && id <= spans[k].second) {
+                    // Range end points need not be defined; inside the defined span they move along
+                    newId = id + options.offsets[k];
+                } else {
+                    ++missing[k];
+                    return;
+                }
+                if (newId != id) {
+                    id = newId;
+                    ++changed[k];
+                }
+            });
+    }, options.threads);
+
+    for (size_t t = 0; t < tasks.size(); ++t) {
+        for (size_t k = 0; k < kIdKindCount; ++k) {
+            result.rewritten[k] += rewritten[t][k];
+            result.unresolved[k] += unresolved[t][k];
+        }
+    }
+
+    // Rebuild per-keyword ID lookups
+    std::vector<Task> finishers;
+    for (const auto& task : tasks) {
+        if (task.begin == 0 && task.accessor->finish) {
+            finishers.push_back(task);
+        }
+    }
+    util::parallelFor(finishers.size(), [&](size_t i) {
+        finishers[i].accessor->finish(*finishers[i].keyword);
+    }, options.threads);
+
+    if (!options.buildMaps) {
+        for (auto& map : result.maps) {
+            map.clear();
+        }
+    }
+    return result;
+}
+
+RenumberManager::Result RenumberManager::merge(Model& source, Options options) {
+    options.mode = Mode::Offset;
+    options.offsets = computeCollisionFreeOffsets(source, options.references);
+
+    RenumberManager sourceManager(source);
+    Result result = sourceManager.renumber(options);
+
+    for (auto& kw : source.getKeywords()) {
+        model_.addKeyword(std::move(kw));
+    }
+    source.clear();
+    return result;
+}
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,341 @@
+#include <koo/dyna/managers/TimeStepManager.hpp>
+#include <koo/dyna/Control.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Part.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/util/MeshGeometry.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+namespace koo::dyna::managers {
+
+namespace {
+
+using util::computeSolidGeometry;
+using util::quadArea;
+using util::triangleArea;
+using util::SolidGeometry;
+
+constexpr size_t kBlockSize = 4096;
+constexpr double kDefaultTssfac = 0.9;
+
+/**
+ * @brief Element reference prepared for the parallel pass
+ */
+struct ElementRef {
+    const ElementData* element = nullptr;
+    double shellThickness = 0.0;  // Thickness from the element card
+};
+
+/**
+ * @brief Part properties resolved once per part
+ */
+struct PartProperties {
+    bool valid = false;
+    double density = 0.0;
+    double youngsModulus = 0.0;
+    double poissonRatio = 0.0;
+    double shellThickness = 0.0;
+    double beamArea = 0.0;
+};
+
+} // anonymous namespace
+
+TimeStepManager::TimeStepManager(Model& model)
+    : model_(model)
+{
+}
+
+// ============================================================================
+// Element Formulas
+// ============================================================================
+
+double TimeStepManager::shellCharacteristicLength(const Vec3* nodes, size_t count, bool useDiagonals) {
+    if (count == 3) {
+        double area = triangleArea(nodes[0], nodes[1], nodes[2]);
+        double maxSide = std::max({(nodes[1] - nodes[0]).length(),
+                                   (nodes[2] - nodes[1]).length(),
+                                   (nodes[0] - nodes[2]).length()});
+        return maxSide > 0.0 ? 2.0 * area / maxSide : 0.0;
+    }
+    if (count != 4) {
+        return 0.0;
+    }
+
+    double area = quadArea(nodes[0], nodes[1], nodes[2], nodes[3]);
+    double maxLength = 0.0;
+    if (useDiagonals) {
+        maxLength = std::max((nodes[2] - nodes[0]).length(), (nodes[3] - nodes[1]).length());
+    } else {
+        for (size_t i = 0; i < 4; ++i) {
+            maxLength = std::max(maxLength, (nodes[(i + 1) % 4] - nodes[i]).length());
+        }
+    }
+    return maxLength > 0.0 ? area / maxLength : 0.0;
+}
+
+double TimeStepManager::solidCharacteristicLength(const Vec3* nodes) {
+    SolidGeometry geom = computeSolidGeometry(nodes);
+    if (geom.maxFaceArea <= 0.0) {
+        return 0.0;
+    }
+    return (geom.tetrahedron ? 3.0 : 1.0) * geom.volume / geom.maxFaceArea;
+}
+
+// ============================================================================
+// Estimation
+// ============================================================================
+
+TimeStepManager::Report TimeStepManager::estimate(const Options& options) const {
+    Report report;
+
+    // Control parameters
+    const ControlTimestep* control = nullptr;
+    auto controls = model_.getKeywordsOfType<ControlTimestep>();
+    if (!controls.empty()) {
+        control = controls.back();
+    }
+    report.tssfac = options.tssfac > 0.0 ? options.tssfac
+                  : (control && control->getData().tssfac > 0.0 ? control->getData().tssfac
+                                                                : kDefaultTssfac);
+    report.dt2ms = options.dt2ms != 0.0 ? options.dt2ms
+                 : (control ? control->getData().dt2ms : 0.0);
+    const bool useDiagonals = control && control->getData().isdo == 1;
+    const double targetTimeStep = report.tssfac * std::abs(report.dt2ms);
+
+    // Node coordinates
+    const std::unordered_map<NodeId, Vec3> positions = model_.getNodePositions();
+
+    // Materials and sections, indexed once instead of per part
+    std::unordered_map<MaterialId, std::optional<ElasticConstants>> materials;
+    for (const auto* mat : model_.getMaterials()) {
+        materials.emplace(mat->getMaterialId(), getElasticConstants(*mat));
+    }
+    std::unordered_map<SectionId, SectionProperties> sections;
+    for (const auto* sec : model_.getSections()) {
+        sections.emplace(sec->getSectionId(), getSectionProperties(*sec));
+    }
+
+    // Part properties
+    std::map<PartId, PartTimeStep> partResults;
+    std::unordered_map<PartId, PartProperties> partProps;
+    for (const auto* partKw : model_.getKeywordsOfType<Part>()) {
+        for (const auto& part : partKw->getParts()) {
+            PartTimeStep& summary = partResults[part.id];
+            summary.pid = part.id;
+            summary.mid = part.mid;
+            summary.secid = part.secid;
+
+            PartProperties props;
+            auto matIt = materials.find(part.mid);
+            if (matIt != materials.end() && matIt->second && matIt->second->density > 0.0
+                && matIt->second->youngsModulus > 0.0) {
+                props.valid = true;
+                props.density = matIt->second->density;
+                props.youngsModulus = matIt->second->youngsModulus;
+                props.poissonRatio = matIt->second->poissonRatio;
+            }
+            auto secIt = sections.find(part.secid);
+            if (secIt != sections.end()) {
+                props.shellThickness = secIt->second.shellThickness;
+                props.beamArea = secIt->second.beamArea;
+            }
+            partProps[part.id] = props;
+        }
+    }
+
+    // Per-element thickness overrides
+    std::unordered_map<ElementId, double> thicknessOverrides;
+    for (const auto* kw : model_.getKeywordsOfType<ElementShellThickness>()) {
+        for (const auto& t : kw->getThicknessData()) {
+            double thick = t.getAverageThickness();
+            if (thick > 0.0) {
+                thicknessOverrides[t.eid] = thick;
+            }
+        }
+    }
+
+    // Flatten the elements that carry a time step
+    std::vector<ElementRef> refs;
+    for (const auto* kw : model_.getKeywordsOfType<ElementShell>()) {
+        for (const auto& elem : kw->getElements()) {
+            refs.push_back({&elem, elem.thickness});
+        }
+    }
+    for (const auto* kw : model_.getKeywordsOfType<ElementSolid>()) {
+        for (const auto& elem : kw->getElements()) {
+            refs.push_back({&elem, 0.0});
+        }
+    }
+    for (const auto* kw : model_.getKeywordsOfType<ElementBeam>()) {
+        for (const auto& elem : kw->getElements()) {
+            refs.push_back({&elem, 0.0});
+        }
+    }
+
+    // Per-element time step; each index is written by exactly one worker
+    std::vector<ElementTimeStep> results(refs.size());
+    std::vector<char> valid(refs.size(), 0);
+
+    util::parallelForBlocks(refs.size(), kBlockSize, [&](size_t, size_t begin, size_t end) {
+        Vec3 nodes[8];
+        for (size_t i = begin; i < end; ++i) {
+            const ElementData& elem = *refs[i].element;
+            ElementTimeStep& out = results[i];
+            out.eid = elem.id;
+            out.pid = elem.pid;
+            out.type = elem.type;
+
+            auto propIt = partProps.find(elem.pid);
+            if (propIt == partProps.end() || !propIt->second.valid) {
+                continue;
+            }
+            const PartProperties& props = propIt->second;
+
+            // Resolve node coordinates
+            size_t nodeCount = std::min<size_t>(elem.nodeIds.size(), 8);
+            bool resolved = nodeCount > 0;
+            for (size_t n = 0; n < nodeCount && resolved; ++n) {
+                auto posIt = positions.find(elem.nodeIds[n]);
+                if (posIt == positions.end()) {
+                    resolved = false;
+                } else {
+                    nodes[n] = posIt->second;
+                }
+            }
+            if (!resolved) {
+                continue;
+            }
+
+            const double rho = props.density;
+            const double e = props.youngsModulus;
+            const double nu = props.poissonRatio;
+
+            switch (elem.type) {
+                case ElementType::Shell: {
+                    size_t corners = nodeCount;
+                    if (corners == 4 && (elem.nodeIds[3] == 0 || elem.nodeIds[3] == elem.nodeIds[2])) {
+                        corners = 3;
+                    }
+                    if (corners < 3) {
+                        continue;
+                    }
+                    out.charLength = shellCharacteristicLength(nodes, corners, useDiagonals);
+                    out.waveSpeed = std::sqrt(e / (rho * (1.0 - nu * nu)));
+
+                    double thickness = props.shellThickness;
+                    if (refs[i].shellThickness > 0.0) {
+                        thickness = refs[i].shellThickness;
+                    }
+                    auto overrideIt = thicknessOverrides.find(elem.id);
+                    if (overrideIt != thicknessOverrides.end()) {
+                        thickness = overrideIt->second;
+                    }
+                    double area = corners == 3 ? triangleArea(nodes[0], nodes[1], nodes[2])
+                                               : quadArea(nodes[0], nodes[1], nodes[2], nodes[3]);
+                    out.mass = rho * area * thickness;
+                    break;
+                }
+                case ElementType::Solid: {
+                    if (nodeCount < 4) {
+                        continue;
+                    }
+                    // Pad 4-node input to the degenerate 8-node tetrahedron form
+                    for (size_t n = nodeCount; n < 8; ++n) {
+                        nodes[n] = nodes[nodeCount - 1];
+                    }
+                    SolidGeometry geom = computeSolidGeometry(nodes);
+                    if (geom.maxFaceArea > 0.0) {
+                        out.charLength = (geom.tetrahedron ? 3.0 : 1.0) * geom.volume / geom.maxFaceArea;
+                    }
+                    double denom = (1.0 + nu) * (1.0 - 2.0 * nu) * rho;
+                    out.waveSpeed = denom > 0.0 ? std::sqrt(e * (1.0 - nu) / denom) : 0.0;
+                    out.mass = rho * geom.volume;
+                    break;
+                }
+                case ElementType::Beam: {
+                    if (nodeCount < 2) {
+                        continue;
+                    }
+                    out.charLength = (nodes[1] - nodes[0]).length();
+                    out.waveSpeed = std::sqrt(e / rho);
+                    out.mass = rho * props.beamArea * out.charLength;
+                    break;
+                }
+                default:
+                    continue;
+            }
+
+            if (out.charLength <= 0.0 || out.waveSpeed <= 0.0) {
+                continue;
+            }
+            out.timeStep = report.tssfac * out.charLength / out.waveSpeed;
+            if (targetTimeStep > 0.0 && out.timeStep < targetTimeStep) {
+                double ratio = targetTimeStep / out.timeStep;
+                out.addedMass = out.mass * (ratio * ratio - 1.0);
+            }
+            valid[i] = 1;
+        }
+    }, options.threads);
+
+    // Aggregate per part in element order (deterministic)
+    std::unordered_map<PartId, std::vector<size_t>> partElements;
+    bool haveControlling = false;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!valid[i]) {
+            ++report.skippedCount;
+            continue;
+        }
+        const ElementTimeStep& r = results[i];
+        PartTimeStep& summary = partResults[r.pid];
+        summary.pid = r.pid;
+        if (summary.elementCount == 0 || r.timeStep < summary.minTimeStep) {
+            summary.minTimeStep = r.timeStep;
+        }
+        ++summary.elementCount;
+        summary.mass += r.mass;
+        summary.addedMass += r.addedMass;
+        if (r.addedMass > 0.0) {
+            ++summary.scaledElementCount;
+        }
+        partElements[r.pid].push_back(i);
+
+        if (!haveControlling || r.timeStep < report.controlling.timeStep) {
+            report.controlling = r;
+            haveControlling = true;
+        }
+        ++report.elementCount;
+    }
+
+    // Smallest elements per part
+    report.parts.reserve(partResults.size());
+    for (auto& [pid, summary] : partResults) {
+        auto it = partElements.find(pid);
+        if (it != partElements.end() && options.smallestPerPart > 0) {
+            auto& indices = it->second;
+            auto byTimeStep = [&results](size_t a, size_t b) {
+                if (results[a].timeStep != results[b].timeStep) {
+                    return results[a].timeStep < results[b].timeStep;
+                }
+                return results[a].eid < results[b].eid;
+            };
+            size_t keep = std::min(options.smallestPerPart, indices.size());
+            std::partial_sort(indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(keep), indices.end(), byTimeStep);
+            summary.smallest.reserve(keep);
+            for (size_t k = 0; k < keep; ++k) {
+                summary.smallest.push_back(results[indices[k]]);
+            }
+        }
+        report.totalMass += summary.mass;
+        report.totalAddedMass += summary.addedMass;
+        report.parts.push_back(std::move(summary));
+    }
+
+    return report;
+}
+
+} // namespace koo::dyna::managers
@@ -0,0 +1,966 @@
+#include <koo/ecad/ClearanceChecker.hpp>
+#include <koo/ecad/EdaData.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <koo/ecad/SpatialIndex.hpp>
+#include <koo/ecad/Step.hpp>
+#include <koo/ecad/Symbol.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kArcStep = kPi / 16.0;     // Max sweep per flattened arc step (containment only)
+constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr double kSlack = 1e-9;             // Relative slack before a gap falls short of its clearance
+constexpr size_t kTileFeatures = 256;       // Target features per tile
+constexpr size_t kPrimIndexMin = 64;        // Shapes with this many primitives get their own R-tree
+
+/// Straight segment (a == b for a point) or circular arc (radius > 0)
+struct Prim {
+    Point2D a, b;
+    Point2D center;
+    double radius = 0.0;
+    double start = 0.0;     ///< Arc start angle (radians)
+    double sweep = 0.0;     ///< Signed arc sweep, counter-clockwise positive
+    BoundingBox2D box;
+};
+
+/// Feature copper: primitives grown by radius, bounding an area when filled
+struct Shape {
+    std::vector<Prim> prims;
+    std::vector<Point2D> points;    ///< Flattened rings for containment (filled shapes only)
+    std::vector<uint32_t> rings;    ///< Ring start offsets plus end sentinel
+    double radius = 0.0;
+    bool filled = false;
+    BoundingBox2D box;              ///< Primitive bounds (radius excluded)
+    SpatialIndex index;             ///< Primitive R-tree (large shapes only)
+
+    void reset() {
+        prims.clear();
+        points.clear();
+        rings.clear();
+        radius = 0.0;
+        filled = false;
+        box = BoundingBox2D();
+    }
+};
+
+/// Closest pair of points found so far
+struct Closest {
+    double d2 = kInf;
+    Point2D p, q;
+
+    void consider(const Point2D& a, const Point2D& b) {
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double d = dx * dx + dy * dy;
+        if (d < d2) {
+            d2 = d;
+            p = a;
+            q = b;
+        }
+    }
+};
+
+/// One layer being checked
+struct CheckLayer {
+    const Layer* layer = nullptr;
+    std::vector<const SymbolGeometry*> symbols;
+    std::unordered_map<size_t, Shape> surfaces;
+    std::vector<size_t> negatives;                  ///< Negative features, in drawing order
+    SpatialIndex negativeIndex;                     ///< Over negatives
+    std::vector<int32_t> nets;                      ///< Net per feature (-1 = none)
+    double base = 0.0;                              ///< Clearance between any two nets
+    std::vector<double> netClearance;               ///< Single-net rules by net (empty if none)
+    std::map<std::pair<int32_t, int32_t>, double> pairClearance;   ///< Net-pair rules, lower net first
+    double reach = 0.0;                             ///< Largest clearance any pair can need
+};
+
+// Helper to tell whether a layer type carries copper
+bool isCopperType(LayerType type) {
+    return type == LayerType::Signal || type == LayerType::PowerGround || type == LayerType::Mixed;
+}
+
+// Helper to tell whether a feature draws copper of either polarity
+bool hasOutline(const FeatureStore& store, size_t index) {
+    FeatureType type = store.getType(index);
+    return type != FeatureType::Text && type != FeatureType::Barcode;
+}
+
+// Helper to tell whether a feature is checked
+bool isCopper(const FeatureStore& store, size_t index) {
+    return store.getPolarity(index) != Polarity::Negative && hasOutline(store, index);
+}
+
+// Helper to grow a box on every side
+BoundingBox2D inflate(BoundingBox2D box, double margin) {
+    box.min.x -= margin;
+    box.min.y -= margin;
+    box.max.x += margin;
+    box.max.y += margin;
+    return box;
+}
+
+// Helper to tell whether two boxes overlap (touching counts)
+bool overlaps(const BoundingBox2D& a, const BoundingBox2D& b) {
+    return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+// Helper to tell whether an angle lies within an arc's sweep
+bool inSweep(const Prim& arc, double angle) {
+    double t = arc.sweep >= 0.0 ? angle - arc.start : arc.start - angle;
+    t = std::fmod(t, 2.0 * kPi);
+    if (t < 0.0) t += 2.0 * kPi;
+    return t <= std::abs(arc.sweep);
+}
+
+// Helper to make a straight primitive
+Prim segmentPrim(const Point2D& a, const Point2D& b) {
+    Prim prim;
+    prim.a = a;
+    prim.b = b;
+    prim.box.expand(a);
+    prim.box.expand(b);
+    return prim;
+}
+
+// Helper to make an arc primitive (full circle if the ends coincide)
+Prim arcPrim(const Point2D& a, const Point2D& b, const Point2D& center, bool clockwise) {
+    double radius = std::hypot(a.x - center.x, a.y - center.y);
+    if (radius == 0.0) return segmentPrim(a, b);
+    Prim prim = segmentPrim(a, b);
+    prim.center = center;
+    prim.radius = radius;
+    prim.start = std::atan2(a.y - center.y, a.x - center.x);
+    double a1 = std::atan2(b.y - center.y, b.x - center.x);
+    double sweep = clockwise ? prim.start - a1 : a1 - prim.start;
+    while (sweep <= 0.0) sweep += 2.0 * kPi;
+    prim.sweep = clockwise ? -sweep : sweep;
+    for (int k = 0; k < 4; ++k) {
+        double angle = kPi / 2.0 * k;
+        if (inSweep(prim, angle)) {
+            prim.box.expand({center.x + radius * std::cos(angle), center.y + radius * std::sin(angle)});
+        }
+    }
+    return prim;
+}
+
+// Helper to append a flattened arc primitive (start point excluded)
+void appendArc(std::vector<Point2D>& points, const Prim& arc) {
+    auto steps = static_cast<size_t>(std::ceil(std::abs(arc.sweep) / kArcStep));
+    for (size_t k = 1; k < steps; ++k) {
+        double a = arc.start + arc.sweep * static_cast<double>(k) / static_cast<double>(steps);
+        points.push_back({arc.center.x + arc.radius * std::cos(a), arc.center.y + arc.radius * std::sin(a)});
+    }
+    points.push_back(arc.b);
+}
+
+// Helper to close a shape: bounds, and a primitive R-tree when it is large
+void finishShape(Shape& shape) {
+    for (const auto& prim : shape.prims) shape.box.expand(prim.box);
+    if (shape.prims.size() >= kPrimIndexMin) {
+        std::vector<BoundingBox2D> boxes;
+        boxes.reserve(shape.prims.size());
+        for (const auto& prim : shape.prims) boxes.push_back(prim.box);
+        shape.index.build(boxes, 1);
+    }
+}
+
+// Helper to turn contours into a filled shape with exact arcs (holes included)
+Shape contourShape(const std::vector<Contour>& contours) {
+    Shape shape;
+    shape.filled = true;
+    for (const auto& contour : contours) {
+        shape.rings.push_back(static_cast<uint32_t>(shape.points.size()));
+        Point2D current = contour.getStart();
+        shape.points.push_back(current);
+        for (const auto& seg : contour.getSegments()) {
+            Point2D next{seg.x, seg.y};
+            if (seg.type == ContourSegmentType::Arc) {
+                Prim arc = arcPrim(current, next, {seg.xc, seg.yc}, seg.clockwise);
+                if (arc.radius > 0.0) {
+                    appendArc(shape.points, arc);
+                } else {
+                    shape.points.push_back(next);
+                }
+                shape.prims.push_back(arc);
+            } else {
+                shape.prims.push_back(segmentPrim(current, next));
+                shape.points.push_back(next);
+            }
+            current = next;
+        }
+    }
+    shape.rings.push_back(static_cast<uint32_t>(shape.points.size()));
+    finishShape(shape);
+    return shape;
+}
+
+// Helper to place a pad symbol: mirror in X, then rotate clockwise
+Point2D placePad(double x, double y, const Point2D& origin, double rotation, bool mirror) {
+    if (mirror) x = -x;
+    double rad = rotation * kPi / 180.0;
+    double c = std::cos(rad), s = std::sin(rad);
+    return {origin.x + x * c + y * s, origin.y - x * s + y * c};
+}
+
+// Helper to turn the rings in shape.points into straight primitives
+void ringPrims(Shape& shape) {
+    for (size_t r = 0; r + 1 < shape.rings.size(); ++r) {
+        size_t first = shape.rings[r], last = shape.rings[r + 1];
+        for (size_t i = first, j = last - 1; i < last; j = i++) {
+            shape.prims.push_back(segmentPrim(shape.points[j], shape.points[i]));
+        }
+    }
+}
+
+double cross(const Point2D& o, const Point2D& a, const Point2D& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Helper to build the CCW convex hull of a point set (monotone chain)
+void convexHull(std::vector<Point2D>& pts, std::vector<Point2D>& hull) {
+    std::sort(pts.begin(), pts.end(), [](const Point2D& a, const Point2D& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    hull.clear();
+    for (int pass = 0; pass < 2; ++pass) {
+        size_t floor = hull.size();
+        for (size_t k = 0; k < pts.size(); ++k) {
+            const Point2D& p = pts[pass == 0 ? k : pts.size() - 1 - k];
+            while (hull.size() >= floor + 2 && cross(hull[hull.size() - 2], hull.back(), p) <= 0.0) {
+                hull.pop_back();
+            }
+            hull.push_back(p);
+        }
+        hull.pop_back();
+    }
+}
+
+// Helper to get the outline of a feature of either polarity (nullptr for
+// text). Surfaces come from the layer cache; other features are built into
+// the scratch shape.
+const Shape* outline(const CheckLayer& layer, size_t index, Shape& shape) {
+    const FeatureStore& store = layer.layer->getFeatures();
+    if (!hasOutline(store, index)) return nullptr;
+    if (store.getType(index) == FeatureType::Surface) {
+        auto it = layer.surfaces.find(index);
+        return it != layer.surfaces.end() ? &it->second : nullptr;
+    }
+
+    auto symbolAt = [&](int32_t symbol) -> const SymbolGeometry* {
+        if (symbol < 0 || static_cast<size_t>(symbol) >= layer.symbols.size()) return nullptr;
+        const SymbolGeometry* geometry = layer.symbols[static_cast<size_t>(symbol)];
+        return geometry->isValid() ? geometry : nullptr;
+    };
+
+    shape.reset();
+    uint32_t row = store.getRow(index);
+    switch (store.getType(index)) {
+        case FeatureType::Line: {
+            const auto& c = store.getLines();
+            Point2D start{c.xs[row], c.ys[row]}, end{c.xe[row], c.ye[row]};
+            const SymbolGeometry* geometry = symbolAt(c.symbol[row]);
+            if (geometry && geometry->getType() != SymbolType::Round && geometry->rings.size() >= 2) {
+                // Non-round symbols sweep the hull of all their rings along the line
+                std::vector<Point2D> swept;
+                for (const auto& p : geometry->points) {
+                    swept.push_back({start.x + p.x, start.y + p.y});
+                    swept.push_back({end.x + p.x, end.y + p.y});
+                }
+                convexHull(swept, shape.points);
+                if (shape.points.size() >= 3) {
+                    shape.filled = true;
+                    shape.rings = {0, static_cast<uint32_t>(shape.points.size())};
+                    ringPrims(shape);
+                    break;
+                }
+                shape.points.clear();
+            }
+            shape.prims.push_back(segmentPrim(start, end));
+            if (geometry) shape.radius = geometry->getType() == SymbolType::Round ? geometry->radius : 0.0;
+            break;
+        }
+        case FeatureType::Arc: {
+            const auto& c = store.getArcs();
+            shape.prims.push_back(arcPrim({c.xs[row], c.ys[row]}, {c.xe[row], c.ye[row]},
+                                          {c.xc[row], c.yc[row]}, c.clockwise[row] != 0));
+            if (const SymbolGeometry* geometry = symbolAt(c.symbol[row])) {
+                // A non-round symbol turns along the arc; its circumscribed
+                // circle bounds the copper it can reach
+                shape.radius = geometry->getType() == SymbolType::Round ? geometry->radius : 0.0;
+                if (geometry->getType() != SymbolType::Round) {
+                    for (const auto& p : geometry->points) {
+                        shape.radius = std::max(shape.radius, std::hypot(p.x, p.y));
+                    }
+                    if (geometry->points.empty()) {
+                        shape.radius = std::hypot(std::max(-geometry->bounds.min.x, geometry->bounds.max.x),
+                                                  std::max(-geometry->bounds.min.y, geometry->bounds.max.y));
+                    }
+                }
+            }
+            break;
+        }
+        case FeatureType::Pad: {
+            const auto& c = store.getPads();
+            Point2D origin{c.x[row], c.y[row]};
+            const SymbolGeometry* geometry = symbolAt(c.symbol[row]);
+            double scale = (c.flags[row] & FeatureStore::PadResize) && c.resize[row] > 0.0 ? c.resize[row] : 1.0;
+            double rotation = c.rotation[row];
+            bool mirror = (c.flags[row] & FeatureStore::PadMirror) != 0;
+            if (!geometry) {
+                shape.prims.push_back(segmentPrim(origin, origin));
+                break;
+            }
+            switch (geometry->getType()) {
+                case SymbolType::Round:
+                    shape.prims.push_back(segmentPrim(origin, origin));
+                    shape.radius = geometry->radius * scale;
+                    break;
+                case SymbolType::Oblong: {
+                    double hw = geometry->bounds.max.x * scale, hh = geometry->bounds.max.y * scale;
+                    bool wide = hw >= hh;
+                    shape.radius = std::min(hw, hh);
+                    double half = std::max(hw, hh) - shape.radius;
+                    shape.prims.push_back(
+                        segmentPrim(placePad(wide ? -half : 0.0, wide ? 0.0 : -half, origin, rotation, mirror),
+                                    placePad(wide ? half : 0.0, wide ? 0.0 : half, origin, rotation, mirror)));
+                    break;
+                }
+                default:
+                    shape.filled = true;
+                    for (const auto& p : geometry->points) {
+                        shape.points.push_back(placePad(p.x * scale, p.y * scale, origin, rotation, mirror));
+                    }
+                    shape.rings = geometry->rings;
+                    ringPrims(shape);
+                    break;
+            }
+            break;
+        }
+        default:
+            return nullptr;
+    }
+
+    for (const auto& prim : shape.prims) shape.box.expand(prim.box);
+    return &shape;
+}
+
+// Helper to get the copper of a checked feature (nullptr if not copper)
+const Shape* buildShape(const CheckLayer& layer, size_t index, Shape& shape) {
+    return isCopper(layer.layer->getFeatures(), index) ? outline(layer, index, shape) : nullptr;
+}
+
+// ========== Distance kernels ==========
+
+// Helper to find the point of a segment closest to p
+Point2D closestOnSegment(const Point2D& p, const Point2D& a, const Point2D& b) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double len2 = dx * dx + dy * dy;
+    double t = len2 > 0.0 ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / len2, 0.0, 1.0) : 0.0;
+    return {a.x + t * dx, a.y + t * dy};
+}
+
+// Helper to find the point of an arc closest to p
+Point2D closestOnArc(const Point2D& p, const Prim& arc) {
+    double dx = p.x - arc.center.x, dy = p.y - arc.center.y;
+    double len = std::hypot(dx, dy);
+    if (len > 0.0 && inSweep(arc, std::atan2(dy, dx))) {
+        return {arc.center.x + arc.radius * dx / len, arc.center.y + arc.radius * dy / len};
+    }
+    double da = std::hypot(p.x - arc.a.x, p.y - arc.a.y);
+    double db = std::hypot(p.x - arc.b.x, p.y - arc.b.y);
+    return da <= db ? arc.a : arc.b;
+}
+
+// Helper for two segments: their crossing, else the nearest end pair
+void segmentSegment(const Prim& s, const Prim& t, Closest& closest) {
+    double d1 = cross(t.a, t.b, s.a), d2 = cross(t.a, t.b, s.b);
+    double d3 = cross(s.a, s.b, t.a), d4 = cross(s.a, s.b, t.b);
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+        ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        double u = d1 / (d1 - d2);
+        Point2D x{s.a.x + u * (s.b.x - s.a.x), s.a.y + u * (s.b.y - s.a.y)};
+        closest.consider(x, x);
+        return;
+    }
+    closest.consider(s.a, closestOnSegment(s.a, t.a, t.b));
+    closest.consider(s.b, closestOnSegment(s.b, t.a, t.b));
+    closest.consider(closestOnSegment(t.a, s.a, s.b), t.a);
+    closest.consider(closestOnSegment(t.b, s.a, s.b), t.b);
+}
+
+// Helper for a segment and an arc. Besides end points and crossings, the
+// only interior minimum lies on the perpendicular from the arc center.
+void segmentArc(const Prim& s, const Prim& arc, Closest& closest) {
+    const Point2D& c = arc.center;
+    double dx = s.b.x - s.a.x, dy = s.b.y - s.a.y;
+    double len2 = dx * dx + dy * dy;
+    if (len2 > 0.0) {
+        double fx = s.a.x - c.x, fy = s.a.y - c.y;
+        double half = fx * dx + fy * dy;
+        double disc = half * half - len2 * (fx * fx + fy * fy - arc.radius * arc.radius);
+        if (disc >= 0.0) {
+            double root = std::sqrt(disc);
+            for (double t : {(-half - root) / len2, (-half + root) / len2}) {
+                if (t < 0.0 || t > 1.0) continue;
+                Point2D x{s.a.x + t * dx, s.a.y + t * dy};
+                if (inSweep(arc, std::atan2(x.y - c.y, x.x - c.x))) {
+                    closest.consider(x, x);
+                    return;
+                }
+            }
+        }
+    }
+
+    closest.consider(s.a, closestOnArc(s.a, arc));
+    closest.consider(s.b, closestOnArc(s.b, arc));
+    closest.consider(closestOnSegment(arc.a, s.a, s.b), arc.a);
+    closest.consider(closestOnSegment(arc.b, s.a, s.b), arc.b);
+
+    auto radial = [&](const Point2D& q, double ux, double uy) {
+        if (inSweep(arc, std::atan2(uy, ux))) {
+            closest.consider(q, {c.x + arc.radius * ux, c.y + arc.radius * uy});
+        }
+    };
+    Point2D q = closestOnSegment(c, s.a, s.b);
+    double len = std::hypot(q.x - c.x, q.y - c.y);
+    if (len > 0.0) {
+        radial(q, (q.x - c.x) / len, (q.y - c.y) / len);
+    } else if (len2 > 0.0) {
+        double n = std::sqrt(len2);
+        radial(q, -dy / n, dx / n);
+        radial(q, dy / n, -dx / n);
+    }
+}
+
+// Helper for two arcs. Besides end points and crossings, interior minima
+// lie on the line through both centers.
+void arcArc(const Prim& a, const Prim& b, Closest& closest) {
+    double dx = b.center.x - a.center.x, dy = b.center.y - a.center.y;
+    double d = std::hypot(dx, dy);
+    if (d > 0.0) {
+        double ux = dx / d, uy = dy / d;
+        if (d <= a.radius + b.radius && d >= std::abs(a.radius - b.radius)) {
+            double along = (d * d + a.radius * a.radius - b.radius * b.radius) / (2.0 * d);
+            double h = std::sqrt(std::max(0.0, a.radius * a.radius - along * along));
+            for (double side : {1.0, -1.0}) {
+                Point2D x{a.center.x + along * ux - side * h * uy, a.center.y + along * uy + side * h * ux};
+                if (inSweep(a, std::atan2(x.y - a.center.y, x.x - a.center.x)) &&
+                    inSweep(b, std::atan2(x.y - b.center.y, x.x - b.center.x))) {
+                    closest.consider(x, x);
+                    return;
+                }
+            }
+        }
+        for (double side : {1.0, -1.0}) {
+            if (!inSweep(a, std::atan2(side * uy, side * ux))) continue;
+            Point2D p{a.center.x + side * a.radius * ux, a.center.y + side * a.radius * uy};
+            closest.consider(p, closestOnArc(p, b));
+        }
+    }
+    closest.consider(a.a, closestOnArc(a.a, b));
+    closest.consider(a.b, closestOnArc(a.b, b));
+    closest.consider(closestOnArc(b.a, a), b.a);
+    closest.consider(closestOnArc(b.b, a), b.b);
+}
+
+// Helper to measure two primitives (p on a, q on b)
+void closestPrims(const Prim& a, const Prim& b, Closest& closest) {
+    if (a.radius == 0.0) {
+        if (b.radius == 0.0) {
+            segmentSegment(a, b, closest);
+        } else {
+            segmentArc(a, b, closest);
+        }
+    } else if (b.radius == 0.0) {
+        Closest swapped;
+        segmentArc(b, a, swapped);
+        closest.consider(swapped.q, swapped.p);
+    } else {
+        arcArc(a, b, closest);
+    }
+}
+
+// Helper to test a point against a filled shape (even-odd over all rings, so holes count)
+bool inside(const Point2D& p, const Shape& shape) {
+    bool in = false;
+    for (size_t r = 0; r + 1 < shape.rings.size(); ++r) {
+        size_t first = shape.rings[r], last = shape.rings[r + 1];
+        for (size_t i = first, j = last - 1; i < last; j = i++) {
+            const Point2D& a = shape.points[i];
+            const Point2D& b = shape.points[j];
+            if ((a.y > p.y) != (b.y > p.y) &&
+                p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) {
+                in = !in;
+            }
+        }
+    }
+    return in;
+}
+
+// Helper to call fn(prim) for the primitives of a shape whose boxes meet a window
+template<typename Fn>
+void visitPrims(const Shape& shape, const BoundingBox2D& window, Fn&& fn) {
+    if (!shape.index.empty()) {
+        shape.index.visit(window, [&](size_t k) { fn(shape.prims[k]); });
+        return;
+    }
+    for (const auto& prim : shape.prims) {
+        if (overlaps(prim.box, window)) fn(prim);
+    }
+}
+
+// Helper to find the closest boundary points of two shapes within limit
+// (closest.d2 stays infinite when nothing is that close). Pairs accept(p, q)
+// rejects are skipped.
+template<typename Accept>
+void closestBoundary(const Shape& a, const Shape& b, double limit, Closest& closest, Accept&& accept) {
+    double limit2 = limit * limit;
+    visitPrims(a, inflate(b.box, limit), [&](const Prim& pa) {
+        if (closest.d2 == 0.0) return;
+        visitPrims(b, inflate(pa.box, limit), [&](const Prim& pb) {
+            if (closest.d2 == 0.0) return;
+            Closest pair;
+            closestPrims(pa, pb, pair);
+            if (pair.d2 <= limit2 && pair.d2 < closest.d2 && accept(pair.p, pair.q)) {
+                closest.consider(pair.p, pair.q);
+            }
+        });
+    });
+}
+
+void closestBoundary(const Shape& a, const Shape& b, double limit, Closest& closest) {
+    closestBoundary(a, b, limit, closest, [](const Point2D&, const Point2D&) { return true; });
+}
+
+// Helper to tell whether a shape covers a point
+bool covers(const Shape& shape, const Point2D& p) {
+    if (shape.filled && inside(p, shape)) return true;
+    if (shape.radius <= 0.0) return false;
+    double radius2 = shape.radius * shape.radius;
+    for (const auto& prim : shape.prims) {
+        Point2D q = prim.radius > 0.0 ? closestOnArc(p, prim) : closestOnSegment(p, prim.a, prim.b);
+        double dx = q.x - p.x, dy = q.y - p.y;
+        if (dx * dx + dy * dy <= radius2) return true;
+    }
+    return false;
+}
+
+// Helper to tell whether a negative feature drawn after `after` clears the
+// copper at a point
+bool clearedAfter(const CheckLayer& layer, size_t after, const Point2D& p, Shape& scratch) {
+    if (layer.negatives.empty()) return false;
+    BoundingBox2D window;
+    window.expand(p);
+    bool cleared = false;
+    layer.negativeIndex.visit(window, [&](size_t k) {
+        size_t n = layer.negatives[k];
+        if (cleared || n <= after) return;
+        const Shape* shape = outline(layer, n, scratch);
+        cleared = shape && covers(*shape, p);
+    });
+    return cleared;
+}
+
+// Helper to find the copper gap of two shapes if it is below limit (-1 if
+// not). Only points accept(p on a, q on b) agrees with are measured.
+template<typename Accept>
+double copperGap(const Shape& a, const Shape& b, double limit, Closest& closest, Accept&& accept) {
+    if (a.prims.empty() || b.prims.empty()) return -1.0;
+    const Point2D& pb = b.prims[0].a;
+    if (a.filled && inside(pb, a) && accept(pb, pb)) {
+        closest.consider(pb, pb);
+        return 0.0;
+    }
+    const Point2D& pa = a.prims[0].a;
+    if (b.filled && inside(pa, b) && accept(pa, pa)) {
+        closest.consider(pa, pa);
+        return 0.0;
+    }
+    closestBoundary(a, b, limit + a.radius + b.radius, closest, accept);
+    if (closest.d2 == kInf) return -1.0;
+    double gap = std::max(0.0, std::sqrt(closest.d2) - a.radius - b.radius);
+    return gap < limit ? gap : -1.0;
+}
+
+// Helper to place a violation midway across the gap between two shapes
+Point2D gapMidpoint(const Closest& closest, double radius, double gap) {
+    double dx = closest.q.x - closest.p.x, dy = closest.q.y - closest.p.y;
+    double len = std::hypot(dx, dy);
+    if (len == 0.0) return closest.p;
+    double t = std::min(1.0, (radius + gap / 2.0) / len);
+    return {closest.p.x + t * dx, closest.p.y + t * dy};
+}
+
+// Helper to get the clearance required between two nets of a layer
+double requiredClearance(const CheckLayer& layer, int32_t a, int32_t b) {
+    double required = layer.base;
+    if (!layer.netClearance.empty()) {
+        if (a >= 0) required = std::max(required, layer.netClearance[static_cast<size_t>(a)]);
+        if (b >= 0) required = std::max(required, layer.netClearance[static_cast<size_t>(b)]);
+    }
+    if (a >= 0 && b >= 0 && !layer.pairClearance.empty()) {
+        auto it = layer.pairClearance.find(std::minmax(a, b));
+        if (it != layer.pairClearance.end()) required = std::max(required, it->second);
+    }
+    return required;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ClearanceChecker
+// ============================================================================
+
+ClearanceChecker::ClearanceChecker(const Step& step, const LayerMatrix& matrix)
+    : step_(step), matrix_(matrix) {}
+
+ClearanceChecker::Result ClearanceChecker::check(const Options& options) const {
+    std::vector<Violation> violations;
+    Result result = check(options, [&](const Violation& violation) { violations.push_back(violation); });
+    result.violations = std::move(violations);
+    return result;
+}
+
+ClearanceChecker::Result ClearanceChecker::check(const Options& options,
+                                                 const ViolationCallback& callback) const {
+    Result result;
+    size_t threads = util::resolveThreadCount(options.threads);
+
+    // ========== Layers ==========
+
+    std::vector<const Layer*> selected;
+    if (!options.layers.empty()) {
+        for (const auto& name : options.layers) {
+            if (const Layer* layer = step_.getLayer(name)) selected.push_back(layer);
+        }
+    } else {
+        // Matrix copper rows first, then copper layers the matrix does not list (by name)
+        std::vector<const LayerDefinition*> rows;
+        for (const auto& def : matrix_.getLayerDefinitions()) rows.push_back(&def);
+        std::stable_sort(rows.begin(), rows.end(),
+                         [](const LayerDefinition* a, const LayerDefinition* b) { return a->row < b->row; });
+        for (const auto* def : rows) {
+            const Layer* layer = step_.getLayer(def->name);
+            if (layer && isCopperType(def->type)) selected.push_back(layer);
+        }
+        std::vector<const Layer*> unlisted;
+        for (const auto& [name, layer] : step_.getLayers()) {
+            if (!matrix_.getLayerDefinition(name) && isCopperType(layer->getType())) {
+                unlisted.push_back(layer.get());
+            }
+        }
+        std::sort(unlisted.begin(), unlisted.end(),
+                  [](const Layer* a, const Layer* b) { return a->getName() < b->getName(); });
+        selected.insert(selected.end(), unlisted.begin(), unlisted.end());
+    }
+    for (const Layer* layer : selected) result.layers.push_back(layer->getName());
+
+    // ========== Nets ==========
+
+    // Net of each feature: feature net names, overridden by EDA FID records
+    std::vector<std::string> netNames;
+    std::unordered_map<std::string, int32_t> netIndex;
+    auto internNet = [&](const std::string& name) {
+        auto [it, added] = netIndex.emplace(name, static_cast<int32_t>(netNames.size()));
+        if (added) netNames.push_back(name);
+        return it->second;
+    };
+
+    std::vector<CheckLayer> layers(selected.size());
+    std::unordered_map<std::string, size_t> layerIndex;
+    for (size_t k = 0; k < selected.size(); ++k) {
+        CheckLayer& layer = layers[k];
+        layer.layer = selected[k];
+        layerIndex.emplace(layer.layer->getName(), k);
+        const FeatureStore& store = layer.layer->getFeatures();
+        std::vector<int32_t> nets;
+        for (const auto& name : store.getNets().getStrings()) nets.push_back(internNet(name));
+        layer.nets.assign(store.size(), -1);
+        for (size_t i = 0; i < store.size(); ++i) {
+            int32_t net = store.getNet(i);
+            if (net >= 0) layer.nets[i] = nets[static_cast<size_t>(net)];
+        }
+    }
+
+    const EdaData& eda = step_.getEdaData();
+    std::unordered_map<int, int32_t> netByNumber;
+    for (const auto& net : eda.getNets()) {
+        netByNumber.emplace(net->getNetNumber(), internNet(net->getName()));
+    }
+    const auto& edaLayers = eda.getLayerNames();
+    for (const auto& record : eda.getFeatureIdRecords()) {
+        const FeatureId& fid = record.featureId;
+        if (fid.type == 'L' || fid.layerNum < 0 || fid.featureNum < 0 ||
+            static_cast<size_t>(fid.layerNum) >= edaLayers.size()) {
+            continue;
+        }
+        auto layer = layerIndex.find(edaLayers[static_cast<size_t>(fid.layerNum)]);
+        auto net = netByNumber.find(record.netNum);
+        if (layer == layerIndex.end() || net == netByNumber.end()) continue;
+        auto& nets = layers[layer->second].nets;
+        auto feature = static_cast<size_t>(fid.featureNum);
+        if (feature < nets.size()) nets[feature] = net->second;
+    }
+
+    // ========== Rules ==========
+
+    for (CheckLayer& layer : layers) {
+        layer.base = options.clearance;
+        for (const auto& rule : options.rules) {
+            if (!rule.layer.empty() && rule.layer != layer.layer->getName()) continue;
+            auto net = netIndex.find(rule.net);
+            auto other = netIndex.find(rule.otherNet);
+            if ((!rule.net.empty() && net == netIndex.end()) ||
+                (!rule.otherNet.empty() && other == netIndex.end())) {
+                continue;
+            }
+            if (rule.net.empty() && rule.otherNet.empty()) {
+                layer.base = std::max(layer.base, rule.clearance);
+            } else if (rule.net.empty() || rule.otherNet.empty()) {
+                int32_t id = rule.net.empty() ? other->second : net->second;
+                if (layer.netClearance.empty()) layer.netClearance.assign(netNames.size(), 0.0);
+                double& value = layer.netClearance[static_cast<size_t>(id)];
+                value = std::max(value, rule.clearance);
+            } else {
+                double& value = layer.pairClearance[std::minmax(net->second, other->second)];
+                value = std::max(value, rule.clearance);
+            }
+        }
+        layer.reach = layer.base;
+        for (double value : layer.netClearance) layer.reach = std::max(layer.reach, value);
+        for (const auto& [pair, value] : layer.pairClearance) layer.reach = std::max(layer.reach, value);
+    }
+
+    // ========== Board profile ==========
+
+    Shape profile;
+    bool checkEdge = options.edgeClearance > 0.0 && !step_.getProfile().empty();
+    if (checkEdge) profile = contourShape(step_.getProfile());
+
+    // ========== Layers, tile by tile ==========
+
+    SymbolCache ownSymbols;
+
+    for (CheckLayer& layer : layers) {
+        // One layer is checked at a time; the pin keeps a cached one resident throughout
+        LayerCache::Pin pin = layer.layer->pin();
+        const FeatureStore& store = layer.layer->getFeatures();
+        const std::string& name = layer.layer->getName();
+        const SymbolCache* shared = options.symbols ? options.symbols : layer.layer->getSymbolCache();
+        layer.symbols = (shared ? *shared : ownSymbols).resolve(store.getSymbols(), layer.layer->getUnits());
+
+        // Negative surfaces are kept too: they clear the copper drawn before them
+        std::vector<size_t> surfaceIndices;
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (store.getType(i) == FeatureType::Surface) surfaceIndices.push_back(i);
+        }
+        std::vector<Shape> surfaceShapes(surfaceIndices.size());
+        util::parallelFor(surfaceIndices.size(), [&](size_t k) {
+            uint32_t row = store.getRow(surfaceIndices[k]);
+            if (const auto* surface = dynamic_cast<const SurfaceFeature*>(store.getObject(row))) {
+                surfaceShapes[k] = contourShape(surface->getContours());
+            }
+        }, threads);
+        for (size_t k = 0; k < surfaceIndices.size(); ++k) {
+            layer.surfaces.emplace(surfaceIndices[k], std::move(surfaceShapes[k]));
+        }
+
+        const SpatialIndex& index = layer.layer->getSpatialIndex();
+        const std::vector<BoundingBox2D>& extents = layer.layer->getFeatureExtents();
+
+        std::vector<BoundingBox2D> negativeBoxes;
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (store.getPolarity(i) == Polarity::Negative && hasOutline(store, i)) {
+                layer.negatives.push_back(i);
+                negativeBoxes.push_back(extents[i]);
+            }
+        }
+        layer.negativeIndex.build(negativeBoxes, threads);
+
+        // Tiles of about kTileFeatures features, each feature in the tile of its extent center
+        BoundingBox2D bounds = layer.layer->getExtent();
+        std::vector<size_t> features;
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (isCopper(store, i) && extents[i].isValid()) features.push_back(i);
+        }
+        auto side = static_cast<size_t>(std::ceil(std::sqrt(
+            static_cast<double>(features.size()) / static_cast<double>(kTileFeatures))));
+        side = std::max<size_t>(side, 1);
+        double tileW = bounds.width() / static_cast<double>(side);
+        double tileH = bounds.height() / static_cast<double>(side);
+        auto tileOf = [&](size_t i) {
+            const BoundingBox2D& box = extents[i];
+            auto cell = [&](double v, double origin, double size) {
+                if (!(size > 0.0)) return size_t(0);
+                return std::min(static_cast<size_t>(std::max(0.0, (v - origin) / size)), side - 1);
+            };
+            return cell((box.min.y + box.max.y) / 2.0, bounds.min.y, tileH) * side +
+                   cell((box.min.x + box.max.x) / 2.0, bounds.min.x, tileW);
+        };
+        std::vector<size_t> tileStart(side * side + 1, 0);
+        for (size_t i : features) ++tileStart[tileOf(i) + 1];
+        for (size_t t = 0; t < side * side; ++t) tileStart[t + 1] += tileStart[t];
+        std::vector<size_t> tileFeatures(features.size());
+        {
+            std::vector<size_t> fill(tileStart.begin(), tileStart.end() - 1);
+            for (size_t i : features) tileFeatures[fill[tileOf(i)]++] = i;
+        }
+
+        auto checkTile = [&](size_t tile, std::vector<Violation>& found, size_t& pairs) {
+            Shape scratch, otherScratch, cutScratch;
+            for (size_t k = tileStart[tile]; k < tileStart[tile + 1]; ++k) {
+                size_t i = tileFeatures[k];
+                const Shape* shape = buildShape(layer, i, scratch);
+                if (!shape || shape->prims.empty()) continue;
+                int32_t net = layer.nets[i];
+                size_t first = found.size();
+
+                if (layer.reach > 0.0 && (net >= 0 || options.checkUnassigned)) {
+                    index.visit(inflate(extents[i], layer.reach), [&](size_t j) {
+                        if (j <= i) return;
+                        int32_t otherNet = layer.nets[j];
+                        if (otherNet < 0 ? !options.checkUnassigned : otherNet == net) return;
+                        double required = requiredClearance(layer, net, otherNet);
+                        if (required <= 0.0 || !overlaps(inflate(extents[i], required), extents[j])) {
+                            return;
+                        }
+                        const Shape* other = buildShape(layer, j, otherScratch);
+                        if (!other) return;
+                        ++pairs;
+                        // Copper cleared by a later negative feature is not measured
+                        auto copperAt = [&](const Point2D& p, const Point2D& q) {
+                            return !clearedAfter(layer, i, p, cutScratch) &&
+                                   !clearedAfter(layer, j, q, cutScratch);
+                        };
+                        Closest closest;
+                        double gap = copperGap(*shape, *other, required * (1.0 - kSlack), closest, copperAt);
+                        if (gap < 0.0) return;
+                        Violation v;
+                        v.type = ViolationType::Clearance;
+                        v.layer = name;
+                        v.feature = i;
+                        v.other = j;
+                        if (net >= 0) v.net = netNames[static_cast<size_t>(net)];
+                        if (otherNet >= 0) v.otherNet = netNames[static_cast<size_t>(otherNet)];
+                        v.distance = gap;
+                        v.required = required;
+                        v.location = gapMidpoint(closest, shape->radius, gap);
+                        found.push_back(std::move(v));
+                    });
+                }
+
+                if (checkEdge) {
+                    Violation v;
+                    v.type = ViolationType::BoardEdge;
+                    v.layer = name;
+                    v.feature = i;
+                    if (net >= 0) v.net = netNames[static_cast<size_t>(net)];
+                    v.required = options.edgeClearance;
+                    Closest closest;
+                    closestBoundary(*shape, profile, options.edgeClearance + shape->radius, closest);
+                    if (!inside(shape->prims[0].a, profile)) {
+                        v.distance = 0.0;
+                        v.location = shape->prims[0].a;
+                        found.push_back(std::move(v));
+                    } else if (closest.d2 != kInf) {
+                        double gap = std::max(0.0, std::sqrt(closest.d2) - shape->radius);
+                        if (gap < options.edgeClearance * (1.0 - kSlack)) {
+                            v.distance = gap;
+                            v.location = gapMidpoint(closest, shape->radius, gap);
+                            found.push_back(std::move(v));
+                        }
+                    }
+                }
+
+                std::sort(found.begin() + static_cast<std::ptrdiff_t>(first), found.end(),
+                          [](const Violation& a, const Violation& b) { return a.other < b.other; });
+            }
+        };
+
+        // Tiles run in parallel a window at a time; each window is streamed in tile order
+        size_t tileCount = side * side;
+        size_t window = std::max<size_t>(threads * 4, 1);
+        for (size_t w = 0; w < tileCount; w += window) {
+            size_t count = std::min(window, tileCount - w);
+            std::vector<std::vector<Violation>> found(count);
+            std::vector<size_t> pairs(count, 0);
+            util::parallelFor(count, [&](size_t t) { checkTile(w + t, found[t], pairs[t]); }, threads);
+            for (size_t t = 0; t < count; ++t) {
+                result.pairCount += pairs[t];
+                for (const auto& v : found[t]) {
+                    if (v.type == ViolationType::Clearance) {
+                        ++result.clearanceCount;
+                    } else {
+                        ++result.edgeCount;
+                    }
+                    if (callback) callback(v);
+                }
+            }
+        }
+        layer.surfaces.clear();
+        layer.negatives.clear();
+        layer.negativeIndex = SpatialIndex();
+    }
+    return result;
+}
+
+// ============================================================================
+// Rule Tables
+// ============================================================================
+
+std::vector<ClearanceChecker::Rule> ClearanceChecker::rulesFromImpedance(
+    const std::vector<ImpedanceConstraint>& constraints) {
+    std::vector<Rule> rules;
+    for (const auto& constraint : constraints) {
+        if (constraint.spacing <= 0.0) continue;
+        Rule rule;
+        rule.layer = constraint.layer;
+        rule.clearance = constraint.spacing;
+        rules.push_back(std::move(rule));
+    }
+    return rules;
+}
+
+std::vector<ClearanceChecker::Rule> ClearanceChecker::rulesFromNetClass(const EdaData& eda, NetClass netClass,
+                                                                        double clearance) {
+    std::vector<Rule> rules;
+    for (const auto& net : eda.getNets()) {
+        if (net->getNetClass() != netClass) continue;
+        Rule rule;
+        rule.net = net->getName();
+        rule.clearance = clearance;
+        rules.push_back(std::move(rule));
+    }
+    std::sort(rules.begin(), rules.end(), [](const Rule& a, const Rule& b) { return a.net < b.net; });
+    return rules;
+}
+
+std::string ClearanceChecker::formatViolation(const Violation& violation) {
+    auto describe = [](size_t feature, const std::string& net) {
+        return "feature " + std::to_string(feature) + (net.empty() ? std::string() : " (" + net + ")");
+    };
+    std::ostringstream message;
+    if (violation.type == ViolationType::Clearance) {
+        message << "Clearance: layer " << violation.layer << " " << describe(violation.feature, violation.net)
+                << " and " << describe(violation.other, violation.otherNet) << " are " << violation.distance
+                << " apart";
+    } else {
+        message << "Board edge: layer " << violation.layer << " " << describe(violation.feature, violation.net)
+                << " is " << violation.distance << " from the profile";
+    }
+    message << ", " << violation.required << " required at (" << violation.location.x << ", "
+            << violation.location.y << ")";
+    return message.str();
+}
+
+} // namespace koo::ecad
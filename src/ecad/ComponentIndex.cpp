@@ -0,0 +1,190 @@
+#include <koo/ecad/ComponentIndex.hpp>
+#include <koo/ecad/EdaData.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBatchBlockSize = 256;
+
+// Helper to find a component's package by index, falling back to its name
+const Package* findPackage(const EdaData& eda, const Component& component) {
+    if (const Package* package = eda.getPackage(component.getPackageIndex())) {
+        return package;
+    }
+    return component.getPackageName().empty() ? nullptr : eda.getPackage(component.getPackageName());
+}
+
+// Helper to get a package's footprint: its PKG box, else the bounds of its outlines
+BoundingBox2D packageFootprint(const Package& package) {
+    BoundingBox2D box = package.getBoundingBox();
+    if (box.isValid()) {
+        return box;
+    }
+    for (const auto& outline : package.getOutlines()) {
+        box.expand(outline.getBoundingBox());
+    }
+    return box;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ComponentIndex - Construction
+// ============================================================================
+
+ComponentIndex::ComponentIndex(const EdaData& eda, size_t threads) : eda_(eda) {
+    const auto& components = eda.getComponents();
+    placements_.resize(components.size());
+    toPackage_.resize(components.size());
+    pinOffsets_.assign(components.size() + 1, 0);
+
+    for (size_t c = 0; c < components.size(); ++c) {
+        const Component& component = *components[c];
+        const Package* package = findPackage(eda, component);
+        Placement& placement = placements_[c];
+        placement.transform = Transform2D(component.getRotation(), component.isMirrored(),
+                                          component.getPosition());
+        placement.side = component.getSide();
+        if (package) {
+            placement.footprint = packageFootprint(*package);
+        }
+        placement.bounds = placement.transform.apply(placement.footprint);
+        toPackage_[c] = placement.transform.inverse();
+
+        // Toeprints are already placed; package pins go through the placement
+        if (!component.getPins().empty()) {
+            for (const auto& pin : component.getPins()) {
+                pins_.push_back({&pin, static_cast<uint32_t>(c), {pin.x, pin.y}});
+            }
+        } else if (package) {
+            for (const auto& pin : package->getPins()) {
+                pins_.push_back({&pin, static_cast<uint32_t>(c),
+                                 placement.transform.apply(Point2D{pin.x, pin.y})});
+            }
+        }
+        pinOffsets_[c + 1] = pins_.size();
+        for (size_t p = pinOffsets_[c]; p < pins_.size(); ++p) {
+            placement.bounds.expand(pins_[p].position);
+        }
+        if (!placement.bounds.isValid()) {
+            placement.bounds.expand(component.getPosition());
+        }
+    }
+
+    std::array<std::vector<BoundingBox2D>, 2> componentBoxes, pinBoxes;
+    for (size_t c = 0; c < placements_.size(); ++c) {
+        size_t s = placements_[c].side == MountSide::Bottom ? 1 : 0;
+        sides_[s].components.push_back(static_cast<uint32_t>(c));
+        componentBoxes[s].push_back(placements_[c].bounds);
+    }
+    for (size_t p = 0; p < pins_.size(); ++p) {
+        size_t s = placements_[pins_[p].component].side == MountSide::Bottom ? 1 : 0;
+        sides_[s].pins.push_back(static_cast<uint32_t>(p));
+        pinBoxes[s].push_back(BoundingBox2D(pins_[p].position, pins_[p].position));
+    }
+    for (size_t s = 0; s < sides_.size(); ++s) {
+        sides_[s].componentTree.build(componentBoxes[s], threads);
+        sides_[s].pinTree.build(pinBoxes[s], threads);
+    }
+}
+
+// ============================================================================
+// ComponentIndex - Components
+// ============================================================================
+
+bool ComponentIndex::footprintContains(size_t component, const Point2D& point) const {
+    const Placement& placement = placements_[component];
+    if (!placement.footprint.isValid()) {
+        return placement.bounds.contains(point);
+    }
+    return placement.footprint.contains(toPackage_[component].apply(point));
+}
+
+std::vector<size_t> ComponentIndex::getComponentsInArea(const BoundingBox2D& area, MountSide side) const {
+    const SideIndex& index = sideIndex(side);
+    std::vector<size_t> result;
+    index.componentTree.visit(area, [&](size_t item) { result.push_back(index.components[item]); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<size_t> ComponentIndex::getComponentsAt(const Point2D& point, MountSide side) const {
+    const SideIndex& index = sideIndex(side);
+    std::vector<size_t> result;
+    index.componentTree.visit(BoundingBox2D(point, point), [&](size_t item) {
+        if (footprintContains(index.components[item], point)) {
+            result.push_back(index.components[item]);
+        }
+    });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::vector<size_t>> ComponentIndex::getComponentsInAreas(
+        const std::vector<BoundingBox2D>& areas, MountSide side, size_t threads) const {
+    std::vector<std::vector<size_t>> results(areas.size());
+    util::parallelForBlocks(areas.size(), kBatchBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = getComponentsInArea(areas[i], side);
+        }
+    }, threads);
+    return results;
+}
+
+std::vector<size_t> ComponentIndex::getComponentsAt(const std::vector<Point2D>& points, MountSide side,
+                                                    size_t threads) const {
+    const SideIndex& index = sideIndex(side);
+    std::vector<size_t> results(points.size(), npos);
+    util::parallelForBlocks(points.size(), kBatchBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            index.componentTree.visit(BoundingBox2D(points[i], points[i]), [&](size_t item) {
+                size_t component = index.components[item];
+                if ((results[i] == npos || component > results[i]) &&
+                    footprintContains(component, points[i])) {
+                    results[i] = component;
+                }
+            });
+        }
+    }, threads);
+    return results;
+}
+
+// ============================================================================
+// ComponentIndex - Pins
+// ============================================================================
+
+std::vector<size_t> ComponentIndex::getPinsInArea(const BoundingBox2D& area, MountSide side) const {
+    const SideIndex& index = sideIndex(side);
+    std::vector<size_t> result;
+    index.pinTree.visit(area, [&](size_t item) { result.push_back(index.pins[item]); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+size_t ComponentIndex::getPinAt(const Point2D& point, MountSide side, double tolerance,
+                                double* distance) const {
+    const SideIndex& index = sideIndex(side);
+    double d = 0.0;
+    size_t item = index.pinTree.nearest(point, &d);
+    if (item == SpatialIndex::npos || d > tolerance) {
+        return npos;
+    }
+    if (distance) *distance = d;
+    return index.pins[item];
+}
+
+std::vector<size_t> ComponentIndex::getPinsAt(const std::vector<Point2D>& points, MountSide side,
+                                              double tolerance, size_t threads) const {
+    std::vector<size_t> results(points.size(), npos);
+    util::parallelForBlocks(points.size(), kBatchBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = getPinAt(points[i], side, tolerance);
+        }
+    }, threads);
+    return results;
+}
+
+} // namespace koo::ecad
@@ -0,0 +1,832 @@
+#include <koo/ecad/CopperArea.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <koo/ecad/Symbol.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBlockSize = 1024;
+constexpr size_t kMinTiles = 256;          // Tiles per density map, for parallelism
+constexpr size_t kTileVertices = 512;      // Outline vertices per tile, for short scanlines
+constexpr size_t kMaxArcSegments = 1024;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kEps = 1e-6;               // Grid units
+
+/// Polygon edge for the scanline, stored bottom to top
+struct Edge {
+    double x0, y0, x1, y1;
+    uint32_t shape;                 ///< Candidate index (drawing order within the tile)
+    int dir;                        ///< +1 if the ring runs upward along it, -1 otherwise
+
+    double xAt(double y) const { return x0 + (x1 - x0) * (y - y0) / (y1 - y0); }
+};
+
+// Helper to close the ring started after the last sentinel
+void closeRing(std::vector<Point2D>& points, std::vector<uint32_t>& rings) {
+    if (rings.empty()) rings.push_back(0);
+    if (points.size() > rings.back()) rings.push_back(static_cast<uint32_t>(points.size()));
+}
+
+// Helper to count chords for an arc so that no chord strays beyond the tolerance
+size_t arcSegments(double radius, double sweep, double tolerance) {
+    double step = tolerance < radius ? 2.0 * std::acos(1.0 - tolerance / radius) : kPi / 2.0;
+    auto count = static_cast<size_t>(std::ceil(std::fabs(sweep) / std::max(step, 1e-9)));
+    return std::clamp<size_t>(count, 1, kMaxArcSegments);
+}
+
+// Helper to append an arc from angle a0 over a signed sweep (CCW positive), both ends included
+void appendArc(std::vector<Point2D>& points, const Point2D& center, double radius,
+               double a0, double sweep, double tolerance) {
+    size_t steps = arcSegments(radius, sweep, tolerance);
+    for (size_t k = 0; k <= steps; ++k) {
+        double a = a0 + sweep * static_cast<double>(k) / static_cast<double>(steps);
+        points.push_back({center.x + radius * std::cos(a), center.y + radius * std::sin(a)});
+    }
+}
+
+// Helper to get the signed sweep of an arc from start to end (full circle if they coincide)
+double arcSweep(const Point2D& start, const Point2D& end, const Point2D& center, bool clockwise,
+                double& a0) {
+    a0 = std::atan2(start.y - center.y, start.x - center.x);
+    double a1 = std::atan2(end.y - center.y, end.x - center.x);
+    double sweep = clockwise ? a0 - a1 : a1 - a0;
+    while (sweep <= 0.0) sweep += 2.0 * kPi;
+    return clockwise ? -sweep : sweep;
+}
+
+// Helper to compute twice the signed area of a ring (positive when CCW)
+double signedArea2(const Point2D* ring, size_t count) {
+    double sum = 0.0;
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        sum += (ring[j].x - ring[i].x) * (ring[j].y + ring[i].y);
+    }
+    return sum;
+}
+
+// Helper to build the CCW convex hull of a point set (monotone chain)
+void convexHull(std::vector<Point2D>& pts, std::vector<Point2D>& hull) {
+    std::sort(pts.begin(), pts.end(), [](const Point2D& a, const Point2D& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    hull.clear();
+    if (pts.size() < 3) {
+        hull = pts;
+        return;
+    }
+    auto cross = [](const Point2D& o, const Point2D& a, const Point2D& b) {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    };
+    hull.resize(2 * pts.size());
+    size_t k = 0;
+    for (size_t i = 0; i < pts.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0) --k;
+        hull[k++] = pts[i];
+    }
+    for (size_t i = pts.size() - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0) --k;
+        hull[k++] = pts[i];
+    }
+    hull.resize(k - 1);
+}
+
+// Helper to clip a ring to one side of an axis-aligned line (Sutherland-Hodgman)
+void clipRing(const std::vector<Point2D>& in, std::vector<Point2D>& out,
+              int axis, double limit, bool keepAbove) {
+    out.clear();
+    if (in.empty()) return;
+    auto coord = [axis](const Point2D& p) { return axis == 0 ? p.x : p.y; };
+    auto inside = [&](const Point2D& p) { return keepAbove ? coord(p) >= limit : coord(p) <= limit; };
+    auto cut = [&](const Point2D& a, const Point2D& b) {
+        double t = (limit - coord(a)) / (coord(b) - coord(a));
+        return axis == 0 ? Point2D{limit, a.y + t * (b.y - a.y)} : Point2D{a.x + t * (b.x - a.x), limit};
+    };
+    Point2D prev = in.back();
+    bool prevInside = inside(prev);
+    for (const auto& p : in) {
+        bool pInside = inside(p);
+        if (pInside != prevInside) out.push_back(cut(prev, p));
+        if (pInside) out.push_back(p);
+        prev = p;
+        prevInside = pInside;
+    }
+}
+
+/// Cells of a tile that receive the swept area
+struct CellGrid {
+    double x0, y0;                  ///< Lower-left corner (grid units)
+    double cellWidth, cellHeight;
+    size_t columns, rows;
+    double* area;                   ///< columns x rows, row-major
+};
+
+// Helper to integrate clamp(x(y) - a, 0, w) over a strip where x runs
+// linearly from p (bottom) to q (top), both relative to a. The integrand is
+// linear between the kinks at 0 and w, so splitting there makes each piece
+// exact at its midpoint.
+double clampIntegral(double p, double q, double w, double height) {
+    double ts[4] = {0.0, 1.0, 1.0, 1.0};
+    size_t n = 1;
+    if (q != p) {
+        for (double edge : {0.0, w}) {
+            double t = (edge - p) / (q - p);
+            if (t > 0.0 && t < 1.0) ts[n++] = t;
+        }
+    }
+    ts[n++] = 1.0;
+    std::sort(ts, ts + n);
+    double sum = 0.0;
+    for (size_t k = 1; k < n; ++k) {
+        double mid = p + (q - p) * 0.5 * (ts[k - 1] + ts[k]);
+        sum += (ts[k] - ts[k - 1]) * std::clamp(mid, 0.0, w);
+    }
+    return sum * height;
+}
+
+// Helper to add the trapezoid between a left and right edge to the cells of a
+// row. Only the columns an edge passes through are integrated; the columns
+// in between are fully covered and go into runs, a difference array of
+// columns + 1 entries per row.
+void addSpan(const CellGrid& grid, double* runs, size_t row,
+             double lb, double lt, double rb, double rt, double height) {
+    auto column = [&](double x) {
+        double c = std::floor((x - grid.x0) / grid.cellWidth);
+        return static_cast<size_t>(std::clamp(c, 0.0, static_cast<double>(grid.columns - 1)));
+    };
+    auto edgeArea = [&](double b, double t, size_t c) {
+        double a = grid.x0 + grid.cellWidth * static_cast<double>(c);
+        return clampIntegral(b - a, t - a, grid.cellWidth, height);
+    };
+    double* cells = grid.area + row * grid.columns;
+    size_t leftFirst = column(std::min(lb, lt)), leftLast = column(std::max(lb, lt));
+    size_t rightFirst = column(std::min(rb, rt)), rightLast = column(std::max(rb, rt));
+    if (leftFirst == rightLast) {
+        cells[leftFirst] += 0.5 * ((rb - lb) + (rt - lt)) * height;
+        return;
+    }
+    if (leftLast + 1 >= rightFirst) {
+        for (size_t c = leftFirst; c <= rightLast; ++c) {
+            cells[c] += edgeArea(rb, rt, c) - edgeArea(lb, lt, c);
+        }
+        return;
+    }
+    double full = grid.cellWidth * height;
+    for (size_t c = leftFirst; c <= leftLast; ++c) cells[c] += full - edgeArea(lb, lt, c);
+    for (size_t c = rightFirst; c <= rightLast; ++c) cells[c] += edgeArea(rb, rt, c);
+    runs[row * (grid.columns + 1) + leftLast + 1] += full;
+    runs[row * (grid.columns + 1) + rightFirst] -= full;
+}
+
+// Helper to measure the area covered by the edges, later shapes painting over
+// earlier ones, cell by cell. Strips between vertex heights (and cell rows)
+// are split at edge crossings, so the edges never swap order inside a
+// trapezoid.
+void sweepArea(std::vector<Edge>& edges, const std::vector<uint8_t>& positive, const CellGrid& grid) {
+    std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+    std::vector<double> ys;
+    ys.reserve(edges.size() * 2 + grid.rows);
+    for (const auto& e : edges) {
+        ys.push_back(e.y0);
+        ys.push_back(e.y1);
+    }
+    for (size_t r = 1; r < grid.rows; ++r) {
+        ys.push_back(grid.y0 + grid.cellHeight * static_cast<double>(r));
+    }
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+
+    // Active edges in x order with their x at the bottom and top of the current trapezoid
+    struct Span {
+        double xb, xt;
+        uint32_t edge;
+    };
+    std::vector<Span> order;
+    std::vector<int> winding(positive.size(), 0);
+    std::vector<uint32_t> covering;
+    std::vector<double> runs((grid.columns + 1) * grid.rows, 0.0);
+    size_t next = 0;
+
+    for (size_t k = 0; k + 1 < ys.size(); ++k) {
+        double stripBottom = ys[k], stripTop = ys[k + 1];
+        order.erase(std::remove_if(order.begin(), order.end(),
+                                   [&](const Span& s) { return edges[s.edge].y1 <= stripBottom; }),
+                    order.end());
+        for (; next < edges.size() && edges[next].y0 <= stripBottom; ++next) {
+            if (edges[next].y1 > stripBottom) order.push_back({0.0, 0.0, static_cast<uint32_t>(next)});
+        }
+        if (order.size() < 2) continue;
+        for (auto& s : order) s.xb = edges[s.edge].xAt(stripBottom);
+        double rowPos = std::floor((0.5 * (stripBottom + stripTop) - grid.y0) / grid.cellHeight);
+        auto row = static_cast<size_t>(std::clamp(rowPos, 0.0, static_cast<double>(grid.rows - 1)));
+
+        double bottom = stripBottom;
+        while (bottom < stripTop) {
+            // Order by x at mid height (insertion sort: the order barely changes
+            // from one trapezoid to the next); lower the top to the first crossing.
+            // Crossings at the bottom itself are rounding left over from the
+            // previous cut (steep edges amplify it) and are skipped.
+            double top = stripTop;
+            for (;;) {
+                for (auto& s : order) s.xt = edges[s.edge].xAt(top);
+                for (size_t i = 1; i < order.size(); ++i) {
+                    Span s = order[i];
+                    size_t j = i;
+                    for (; j > 0 && order[j - 1].xb + order[j - 1].xt > s.xb + s.xt; --j) {
+                        order[j] = order[j - 1];
+                    }
+                    order[j] = s;
+                }
+                double cut = top;
+                for (size_t i = 0; i + 1 < order.size(); ++i) {
+                    double db = order[i].xb - order[i + 1].xb;
+                    double dt = order[i].xt - order[i + 1].xt;
+                    if ((db > kEps || dt > kEps) && (db > 0.0) != (dt > 0.0)) {
+                        double y = bottom + (top - bottom) * db / (db - dt);
+                        if (y > bottom + kEps) cut = std::min(cut, y);
+                    }
+                }
+                if (cut >= top - kEps) break;
+                top = cut;
+            }
+
+            // Walk left to right with per-shape nonzero winding
+            double height = top - bottom;
+            covering.clear();
+            for (size_t i = 0; i < order.size(); ++i) {
+                const Edge& e = edges[order[i].edge];
+                int before = winding[e.shape];
+                winding[e.shape] += e.dir;
+                if (before == 0 && winding[e.shape] != 0) {
+                    covering.push_back(e.shape);
+                } else if (before != 0 && winding[e.shape] == 0) {
+                    covering.erase(std::find(covering.begin(), covering.end(), e.shape));
+                }
+                if (!covering.empty() && i + 1 < order.size() &&
+                    positive[*std::max_element(covering.begin(), covering.end())]) {
+                    addSpan(grid, runs.data(), row, order[i].xb, order[i].xt, order[i + 1].xb, order[i + 1].xt, height);
+                }
+            }
+            for (auto& s : order) {
+                winding[edges[s.edge].shape] = 0;
+                s.xb = s.xt;
+            }
+            bottom = top;
+        }
+    }
+
+    for (size_t r = 0; r < grid.rows; ++r) {
+        double run = 0.0;
+        for (size_t c = 0; c < grid.columns; ++c) {
+            run += runs[r * (grid.columns + 1) + c];
+            grid.area[r * grid.columns + c] += run;
+        }
+    }
+}
+
+// Sample points of a tile mask: column c, row r at (x0 + (c + 0.5) dx, y0 + (r + 0.5) dy)
+struct SampleGrid {
+    double x0, y0;
+    double dx, dy;
+    size_t columns, rows;
+    uint8_t* mask;
+};
+
+// Helper to paint the samples inside a shape (nonzero winding) with value.
+// Edges sorted by y0 enter an active list as the scanline reaches them.
+void fillShape(const std::vector<Edge>& edges, const SampleGrid& grid, uint8_t value,
+               std::vector<size_t>& active, std::vector<std::pair<double, int>>& crossings) {
+    if (edges.empty()) return;
+    double yMin = edges.front().y0, yMax = yMin;
+    for (const auto& e : edges) yMax = std::max(yMax, e.y1);
+    double first = std::max(0.0, std::ceil((yMin - grid.y0) / grid.dy - 0.5));
+    double last = std::min(static_cast<double>(grid.rows),
+                           std::ceil((yMax - grid.y0) / grid.dy - 0.5));
+    auto sampleIndex = [&](double x) {
+        double c = std::ceil((x - grid.x0) / grid.dx - 0.5);
+        return static_cast<size_t>(std::clamp(c, 0.0, static_cast<double>(grid.columns)));
+    };
+
+    active.clear();
+    size_t next = 0;
+    for (auto r = static_cast<size_t>(first); r < static_cast<size_t>(std::max(first, last)); ++r) {
+        double y = grid.y0 + (static_cast<double>(r) + 0.5) * grid.dy;
+        for (; next < edges.size() && edges[next].y0 <= y; ++next) active.push_back(next);
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&](size_t e) { return edges[e].y1 <= y; }),
+                     active.end());
+        crossings.clear();
+        for (size_t e : active) crossings.emplace_back(edges[e].xAt(y), edges[e].dir);
+        std::sort(crossings.begin(), crossings.end());
+
+        uint8_t* line = grid.mask + r * grid.columns;
+        int winding = 0;
+        double start = 0.0;
+        for (const auto& [x, dir] : crossings) {
+            int before = winding;
+            winding += dir;
+            if (before == 0 && winding != 0) {
+                start = x;
+            } else if (before != 0 && winding == 0) {
+                size_t c0 = sampleIndex(start), c1 = sampleIndex(x);
+                if (c0 < c1) std::memset(line + c0, value, c1 - c0);
+            }
+        }
+    }
+}
+
+// Helper to write a whole buffer to a file
+bool writeFile(const std::filesystem::path& path, const std::string& header,
+               const void* data, size_t size) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return static_cast<bool>(out);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// DensityMap
+// ============================================================================
+
+double CopperArea::DensityMap::getDensity(size_t column, size_t row) const {
+    double cell = getCellWidth() * getCellHeight();
+    return cell > 0.0 ? getArea(column, row) / cell : 0.0;
+}
+
+double CopperArea::DensityMap::getTotalArea() const {
+    double total = 0.0;
+    for (double a : area) total += a;
+    return total;
+}
+
+// ============================================================================
+// Raster
+// ============================================================================
+
+double CopperArea::Raster::getCoverage(size_t column, size_t row) const {
+    size_t index = row * columns + column;
+    return format == PixelFormat::UInt8 ? bytes[index] / 255.0 : static_cast<double>(values[index]);
+}
+
+bool CopperArea::Raster::writePgm(const std::filesystem::path& path) const {
+    std::vector<uint8_t> pixels(columns * rows);
+    for (size_t r = 0; r < rows; ++r) {
+        uint8_t* line = pixels.data() + (rows - 1 - r) * columns;
+        for (size_t c = 0; c < columns; ++c) {
+            size_t index = r * columns + c;
+            line[c] = format == PixelFormat::UInt8
+                    ? bytes[index]
+                    : static_cast<uint8_t>(std::lround(std::clamp(values[index], 0.0f, 1.0f) * 255.0f));
+        }
+    }
+    std::string header = "P5\n" + std::to_string(columns) + " " + std::to_string(rows) + "\n255\n";
+    return writeFile(path, header, pixels.data(), pixels.size());
+}
+
+bool CopperArea::Raster::writeRaw(const std::filesystem::path& path) const {
+    return format == PixelFormat::UInt8
+         ? writeFile(path, std::string(), bytes.data(), bytes.size())
+         : writeFile(path, std::string(), values.data(), values.size() * sizeof(float));
+}
+
+bool CopperArea::Raster::writeNpy(const std::filesystem::path& path) const {
+    // Format 1.0: magic, version, little-endian header length, then a dict
+    // padded with spaces so the data starts on a 64-byte boundary
+    const uint16_t probe = 1;
+    uint8_t low = 0;
+    std::memcpy(&low, &probe, 1);
+    std::string descr = format == PixelFormat::UInt8 ? "|u1" : (low ? "<f4" : ">f4");
+    std::string dict = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (" +
+                       std::to_string(rows) + ", " + std::to_string(columns) + "), }";
+    size_t length = 10 + dict.size() + 1;
+    dict.append((64 - length % 64) % 64, ' ');
+    dict += '\n';
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    header += static_cast<char>(dict.size() & 0xff);
+    header += static_cast<char>((dict.size() >> 8) & 0xff);
+    header += dict;
+    return format == PixelFormat::UInt8
+         ? writeFile(path, header, bytes.data(), bytes.size())
+         : writeFile(path, header, values.data(), values.size() * sizeof(float));
+}
+
+// ============================================================================
+// CopperArea - Construction
+// ============================================================================
+
+CopperArea::CopperArea(const Layer& layer, const Options& options)
+    : layer_(layer), options_(options) {
+    scale_ = options_.resolution > 0.0 ? 1.0 / options_.resolution : 1.0;
+    const FeatureStore& store = layer_.getFeatures();
+    const std::string& units = layer_.getUnits();
+
+    const SymbolCache* cache = options_.symbols;
+    if (!cache) {
+        ownSymbols_ = std::make_unique<SymbolCache>(options_.arcTolerance);
+        cache = ownSymbols_.get();
+    }
+    symbols_ = cache->resolve(store.getSymbols(), units);
+
+    // Surfaces: islands CCW, holes CW, so holes cancel under nonzero winding
+    for (size_t i = 0; i < store.size(); ++i) {
+        if (store.getType(i) != FeatureType::Surface) continue;
+        const auto* surface = dynamic_cast<const SurfaceFeature*>(store.getObject(store.getRow(i)));
+        if (!surface) continue;
+        Outline& outline = surfaces_[i];
+        for (const auto& contour : surface->getContours()) {
+            size_t first = outline.points.size();
+            Point2D current = contour.getStart();
+            outline.points.push_back(current);
+            for (const auto& seg : contour.getSegments()) {
+                Point2D next{seg.x, seg.y};
+                if (seg.type == ContourSegmentType::Arc) {
+                    Point2D center{seg.xc, seg.yc};
+                    double a0 = 0.0;
+                    double sweep = arcSweep(current, next, center, seg.clockwise, a0);
+                    double radius = std::hypot(current.x - center.x, current.y - center.y);
+                    appendArc(outline.points, center, radius, a0, sweep, options_.arcTolerance);
+                    outline.points.back() = next;
+                } else {
+                    outline.points.push_back(next);
+                }
+                current = next;
+            }
+            size_t count = outline.points.size() - first;
+            if (count < 3) {
+                outline.points.resize(first);
+                continue;
+            }
+            Point2D* ring = outline.points.data() + first;
+            bool ccw = signedArea2(ring, count) > 0.0;
+            if (ccw != (contour.getPolygonType() == PolygonType::Island)) std::reverse(ring, ring + count);
+            for (size_t k = 0; k < count; ++k) {
+                ring[k] = {std::round(ring[k].x * scale_), std::round(ring[k].y * scale_)};
+            }
+            closeRing(outline.points, outline.rings);
+        }
+    }
+
+    std::vector<BoundingBox2D> boxes(store.size());
+    std::vector<size_t> vertices(util::blockCount(store.size(), kBlockSize), 0);
+    util::parallelForBlocks(store.size(), kBlockSize, [&](size_t block, size_t first, size_t last) {
+        Outline scratch;
+        for (size_t i = first; i < last; ++i) {
+            const Outline* outline = buildOutline(i, scratch);
+            if (!outline) continue;
+            for (const auto& p : outline->points) boxes[i].expand(p);
+            vertices[block] += outline->points.size();
+        }
+    }, options_.threads);
+    index_.build(boxes, options_.threads);
+    for (size_t count : vertices) vertices_ += count;
+
+    BoundingBox2D grid = index_.getBounds();
+    if (grid.isValid()) {
+        bounds_ = BoundingBox2D({grid.min.x / scale_, grid.min.y / scale_},
+                                {grid.max.x / scale_, grid.max.y / scale_});
+    }
+}
+
+CopperArea::CopperArea(const Layer& layer) : CopperArea(layer, Options()) {}
+
+CopperArea::~CopperArea() = default;
+
+const CopperArea::Outline* CopperArea::buildOutline(size_t index, Outline& scratch) const {
+    const FeatureStore& store = layer_.getFeatures();
+    FeatureType type = store.getType(index);
+    if (type == FeatureType::Surface) {
+        auto it = surfaces_.find(index);
+        return it != surfaces_.end() ? &it->second : nullptr;
+    }
+    if (type != FeatureType::Line && type != FeatureType::Arc && type != FeatureType::Pad) {
+        return nullptr;
+    }
+
+    scratch.points.clear();
+    scratch.rings.clear();
+    uint32_t row = store.getRow(index);
+    int32_t symbolIndex = type == FeatureType::Line ? store.getLines().symbol[row]
+                        : type == FeatureType::Arc  ? store.getArcs().symbol[row]
+                                                    : store.getPads().symbol[row];
+    if (symbolIndex < 0 || static_cast<size_t>(symbolIndex) >= symbols_.size()) return nullptr;
+    const SymbolGeometry& symbol = *symbols_[static_cast<size_t>(symbolIndex)];
+    if (symbol.rings.size() < 2) return nullptr;
+    double tolerance = options_.arcTolerance;
+
+    // Round symbols sweep exactly; other symbols sweep every ring as one hull
+    double radius = symbol.radius;
+    bool round = radius > 0.0;
+    std::vector<Point2D> hullPoints, hull;
+    auto sweepSegment = [&](const Point2D& a, const Point2D& b) {
+        if (round) {
+            double angle = std::atan2(b.y - a.y, b.x - a.x);
+            appendArc(scratch.points, b, radius, angle - kPi / 2.0, kPi, tolerance);
+            appendArc(scratch.points, a, radius, angle + kPi / 2.0, kPi, tolerance);
+        } else {
+            hullPoints.clear();
+            for (const auto& p : symbol.points) {
+                hullPoints.push_back({a.x + p.x, a.y + p.y});
+                hullPoints.push_back({b.x + p.x, b.y + p.y});
+            }
+            convexHull(hullPoints, hull);
+            scratch.points.insert(scratch.points.end(), hull.begin(), hull.end());
+        }
+        closeRing(scratch.points, scratch.rings);
+    };
+
+    switch (type) {
+        case FeatureType::Line: {
+            const auto& c = store.getLines();
+            sweepSegment({c.xs[row], c.ys[row]}, {c.xe[row], c.ye[row]});
+            break;
+        }
+        case FeatureType::Arc: {
+            const auto& c = store.getArcs();
+            Point2D start{c.xs[row], c.ys[row]}, center{c.xc[row], c.yc[row]};
+            double a0 = 0.0;
+            double sweep = arcSweep(start, {c.xe[row], c.ye[row]}, center, c.clockwise[row] != 0, a0);
+            double arcRadius = std::hypot(start.x - center.x, start.y - center.y);
+            if (round && arcRadius > radius) {
+                // Annular sector with round caps (or a full ring)
+                double a1 = a0 + sweep;
+                if (std::fabs(sweep) >= 2.0 * kPi - 1e-12) {
+                    appendArc(scratch.points, center, arcRadius + radius, 0.0, 2.0 * kPi, tolerance);
+                    scratch.points.pop_back();
+                    closeRing(scratch.points, scratch.rings);
+                    appendArc(scratch.points, center, arcRadius - radius, 0.0, -2.0 * kPi, tolerance);
+                    scratch.points.pop_back();
+                    closeRing(scratch.points, scratch.rings);
+                    break;
+                }
+                double turn = sweep > 0.0 ? kPi : -kPi;
+                Point2D end{center.x + arcRadius * std::cos(a1), center.y + arcRadius * std::sin(a1)};
+                appendArc(scratch.points, center, arcRadius + radius, a0, sweep, tolerance);
+                appendArc(scratch.points, end, radius, a1, turn, tolerance);
+                appendArc(scratch.points, center, arcRadius - radius, a1, -sweep, tolerance);
+                appendArc(scratch.points, start, radius, a0 + kPi, turn, tolerance);
+                closeRing(scratch.points, scratch.rings);
+                break;
+            }
+            std::vector<Point2D> path;
+            appendArc(path, center, arcRadius, a0, sweep, tolerance);
+            for (size_t k = 1; k < path.size(); ++k) sweepSegment(path[k - 1], path[k]);
+            break;
+        }
+        case FeatureType::Pad: {
+            const auto& c = store.getPads();
+            double resize = (c.flags[row] & FeatureStore::PadResize) && c.resize[row] > 0.0 ? c.resize[row] : 1.0;
+            Transform2D place(c.rotation[row], (c.flags[row] & FeatureStore::PadMirror) != 0,
+                              {c.x[row], c.y[row]});
+            for (const auto& p : symbol.points) {
+                scratch.points.push_back(place.apply(Point2D{p.x * resize, p.y * resize}));
+            }
+            scratch.rings = symbol.rings;
+            break;
+        }
+        default:
+            return nullptr;
+    }
+
+    for (auto& p : scratch.points) {
+        p = {std::round(p.x * scale_), std::round(p.y * scale_)};
+    }
+    return &scratch;
+}
+
+// ============================================================================
+// CopperArea - Area
+// ============================================================================
+
+void CopperArea::tileArea(const BoundingBox2D& tile, size_t columns, size_t rows,
+                          double* area, Outline& scratch) const {
+    std::vector<size_t> candidates;
+    index_.visit(tile, [&](size_t i) { candidates.push_back(i); });
+    if (candidates.empty()) return;
+    std::sort(candidates.begin(), candidates.end());
+
+    const FeatureStore& store = layer_.getFeatures();
+    std::vector<Edge> edges;
+    std::vector<uint8_t> positive;
+    std::vector<Point2D> ring, clipped;
+    for (size_t i : candidates) {
+        const Outline* outline = buildOutline(i, scratch);
+        if (!outline) continue;
+        auto shape = static_cast<uint32_t>(positive.size());
+        positive.push_back(store.getPolarity(i) != Polarity::Negative);
+
+        for (size_t r = 0; r + 1 < outline->rings.size(); ++r) {
+            ring.assign(outline->points.begin() + outline->rings[r],
+                        outline->points.begin() + outline->rings[r + 1]);
+            BoundingBox2D box;
+            for (const auto& p : ring) box.expand(p);
+            if (box.min.x < tile.min.x || box.max.x > tile.max.x ||
+                box.min.y < tile.min.y || box.max.y > tile.max.y) {
+                clipRing(ring, clipped, 0, tile.min.x, true);
+                clipRing(clipped, ring, 0, tile.max.x, false);
+                clipRing(ring, clipped, 1, tile.min.y, true);
+                clipRing(clipped, ring, 1, tile.max.y, false);
+            }
+            for (size_t k = 0, j = ring.size() - 1; k < ring.size(); j = k++) {
+                const Point2D& a = ring[j];
+                const Point2D& b = ring[k];
+                if (a.y == b.y) continue;
+                if (a.y < b.y) {
+                    edges.push_back({a.x, a.y, b.x, b.y, shape, 1});
+                } else {
+                    edges.push_back({b.x, b.y, a.x, a.y, shape, -1});
+                }
+            }
+        }
+    }
+    CellGrid grid{tile.min.x, tile.min.y,
+                  tile.width() / static_cast<double>(columns), tile.height() / static_cast<double>(rows),
+                  columns, rows, area};
+    sweepArea(edges, positive, grid);
+}
+
+double CopperArea::getArea() const {
+    return bounds_.isValid() ? getDensityMap(bounds_, 1, 1).getTotalArea() : 0.0;
+}
+
+double CopperArea::getArea(const BoundingBox2D& window) const {
+    return window.isValid() ? getDensityMap(window, 1, 1).getTotalArea() : 0.0;
+}
+
+CopperArea::DensityMap CopperArea::getDensityMap(size_t columns, size_t rows) const {
+    return getDensityMap(bounds_, columns, rows);
+}
+
+CopperArea::DensityMap CopperArea::getDensityMap(const BoundingBox2D& bounds,
+                                                 size_t columns, size_t rows) const {
+    DensityMap map;
+    map.bounds = bounds;
+    map.columns = columns;
+    map.rows = rows;
+    map.area.assign(columns * rows, 0.0);
+    if (map.area.empty() || !bounds.isValid() || index_.empty()) {
+        return map;
+    }
+
+    // Tiles hold about kTileVertices outline vertices (scanline cost grows
+    // faster than tile size). Few large cells are split into equal subcells,
+    // many small ones grouped into blocks; one sweep per tile fills all of
+    // its subcells.
+    double overlap = std::max(0.0, std::min(bounds.max.x, bounds_.max.x) - std::max(bounds.min.x, bounds_.min.x)) *
+                     std::max(0.0, std::min(bounds.max.y, bounds_.max.y) - std::max(bounds.min.y, bounds_.min.y));
+    double share = bounds_.width() * bounds_.height() > 0.0
+                 ? std::min(1.0, overlap / (bounds_.width() * bounds_.height())) : 1.0;
+    double tileCount = std::max(static_cast<double>(kMinTiles),
+                                share * static_cast<double>(vertices_) / static_cast<double>(kTileVertices));
+    auto cells = static_cast<double>(columns * rows);
+    size_t sub = 1, block = 1;
+    if (cells < tileCount) {
+        sub = static_cast<size_t>(std::lround(std::sqrt(tileCount / cells)));
+    } else {
+        block = static_cast<size_t>(std::max(1L, std::lround(std::sqrt(cells / tileCount))));
+    }
+    size_t fineX = columns * sub, fineY = rows * sub;
+    size_t tilesX = (fineX + block - 1) / block, tilesY = (fineY + block - 1) / block;
+    double x0 = bounds.min.x * scale_, y0 = bounds.min.y * scale_;
+    double w = bounds.width() * scale_, h = bounds.height() * scale_;
+    if (w <= 0.0 || h <= 0.0) {
+        return map;
+    }
+    auto edgeX = [&](size_t i) { return x0 + w * static_cast<double>(i) / static_cast<double>(fineX); };
+    auto edgeY = [&](size_t j) { return y0 + h * static_cast<double>(j) / static_cast<double>(fineY); };
+
+    std::vector<std::vector<double>> tiles(tilesX * tilesY);
+    util::parallelFor(tiles.size(), [&](size_t t) {
+        size_t i0 = (t % tilesX) * block, j0 = (t / tilesX) * block;
+        size_t i1 = std::min(i0 + block, fineX), j1 = std::min(j0 + block, fineY);
+        Outline scratch;
+        tiles[t].assign((i1 - i0) * (j1 - j0), 0.0);
+        tileArea(BoundingBox2D({edgeX(i0), edgeY(j0)}, {edgeX(i1), edgeY(j1)}),
+                 i1 - i0, j1 - j0, tiles[t].data(), scratch);
+    }, options_.threads);
+
+    // Sum subcells in a fixed order so results do not depend on the thread count
+    double toLayer = 1.0 / (scale_ * scale_);
+    for (size_t t = 0; t < tiles.size(); ++t) {
+        size_t i0 = (t % tilesX) * block, j0 = (t / tilesX) * block;
+        size_t nx = std::min(i0 + block, fineX) - i0;
+        for (size_t k = 0; k < tiles[t].size(); ++k) {
+            size_t column = (i0 + k % nx) / sub, row = (j0 + k / nx) / sub;
+            map.area[row * columns + column] += tiles[t][k] * toLayer;
+        }
+    }
+    return map;
+}
+
+// ============================================================================
+// CopperArea - Raster
+// ============================================================================
+
+void CopperArea::tileCoverage(const BoundingBox2D& tile, size_t columns, size_t rows, size_t samples,
+                              float* coverage, Outline& scratch) const {
+    std::vector<size_t> candidates;
+    index_.visit(tile, [&](size_t i) { candidates.push_back(i); });
+    if (candidates.empty()) return;
+    std::sort(candidates.begin(), candidates.end());
+
+    // Paint whole outlines in drawing order; spans are clamped to the tile
+    // per scanline, so no clipping is needed
+    std::vector<uint8_t> mask(columns * samples * rows * samples, 0);
+    SampleGrid grid{tile.min.x, tile.min.y,
+                    tile.width() / static_cast<double>(columns * samples),
+                    tile.height() / static_cast<double>(rows * samples),
+                    columns * samples, rows * samples, mask.data()};
+    const FeatureStore& store = layer_.getFeatures();
+    std::vector<Edge> edges;
+    std::vector<size_t> active;
+    std::vector<std::pair<double, int>> crossings;
+    for (size_t i : candidates) {
+        const Outline* outline = buildOutline(i, scratch);
+        if (!outline) continue;
+        edges.clear();
+        for (size_t r = 0; r + 1 < outline->rings.size(); ++r) {
+            const Point2D* ring = outline->points.data() + outline->rings[r];
+            size_t count = outline->rings[r + 1] - outline->rings[r];
+            for (size_t k = 0, j = count - 1; k < count; j = k++) {
+                const Point2D& a = ring[j];
+                const Point2D& b = ring[k];
+                if (a.y == b.y) continue;
+                if (a.y < b.y) {
+                    edges.push_back({a.x, a.y, b.x, b.y, 0, 1});
+                } else {
+                    edges.push_back({b.x, b.y, a.x, a.y, 0, -1});
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+        fillShape(edges, grid, store.getPolarity(i) != Polarity::Negative ? 1 : 0, active, crossings);
+    }
+
+    float weight = 1.0f / static_cast<float>(samples * samples);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < columns; ++c) {
+            unsigned count = 0;
+            for (size_t sr = 0; sr < samples; ++sr) {
+                const uint8_t* line = mask.data() + (r * samples + sr) * grid.columns + c * samples;
+                for (size_t sc = 0; sc < samples; ++sc) count += line[sc];
+            }
+            coverage[r * columns + c] = static_cast<float>(count) * weight;
+        }
+    }
+}
+
+CopperArea::Raster CopperArea::rasterize(const BoundingBox2D& bounds, size_t columns, size_t rows,
+                                         const RasterOptions& options) const {
+    Raster raster;
+    raster.bounds = bounds;
+    raster.columns = columns;
+    raster.rows = rows;
+    raster.format = options.format;
+    if (options.format == PixelFormat::UInt8) {
+        raster.bytes.assign(columns * rows, 0);
+    } else {
+        raster.values.assign(columns * rows, 0.0f);
+    }
+    double x0 = bounds.min.x * scale_, y0 = bounds.min.y * scale_;
+    double w = bounds.width() * scale_, h = bounds.height() * scale_;
+    if (columns * rows == 0 || !bounds.isValid() || index_.empty() || w <= 0.0 || h <= 0.0) {
+        return raster;
+    }
+
+    // Tiles cover disjoint pixels, so each writes its part of the raster directly
+    size_t tile = std::max<size_t>(1, options.tileSize);
+    size_t samples = options.antialias ? std::max<size_t>(1, options.samples) : 1;
+    size_t tilesX = (columns + tile - 1) / tile, tilesY = (rows + tile - 1) / tile;
+    auto edgeX = [&](size_t i) { return x0 + w * static_cast<double>(i) / static_cast<double>(columns); };
+    auto edgeY = [&](size_t j) { return y0 + h * static_cast<double>(j) / static_cast<double>(rows); };
+    util::parallelFor(tilesX * tilesY, [&](size_t t) {
+        size_t i0 = (t % tilesX) * tile, j0 = (t / tilesX) * tile;
+        size_t nx = std::min(i0 + tile, columns) - i0, ny = std::min(j0 + tile, rows) - j0;
+        Outline scratch;
+        std::vector<float> coverage(nx * ny, 0.0f);
+        tileCoverage(BoundingBox2D({edgeX(i0), edgeY(j0)}, {edgeX(i0 + nx), edgeY(j0 + ny)}),
+                     nx, ny, samples, coverage.data(), scratch);
+        for (size_t r = 0; r < ny; ++r) {
+            size_t offset = (j0 + r) * columns + i0;
+            for (size_t c = 0; c < nx; ++c) {
+                float value = coverage[r * nx + c];
+                if (raster.format == PixelFormat::UInt8) {
+                    raster.bytes[offset + c] = static_cast<uint8_t>(std::lround(value * 255.0f));
+                } else {
+                    raster.values[offset + c] = value;
+                }
+            }
+        }
+    }, options_.threads);
+    return raster;
+}
+
+} // namespace koo::ecad
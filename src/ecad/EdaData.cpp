@@ -103,52 +103,111 @@ void Net::addSubnet(const Subnet& subnet) {
 // EdaData
 // ============================================================================
 
+int EdaData::slotOf(const std::vector<int32_t>& slots, int32_t nameId) {
+    auto slot = static_cast<size_t>(nameId + 1);
+    return (slot < slots.size()) ? slots[slot] : -1;
+}
+
 Component* EdaData::getComponent(const std::string& refDes) {
-    auto it = components_.find(refDes);
-    return (it != components_.end()) ? it->second.get() : nullptr;
+    return getComponent(getComponentIndex(refDes));
 }
 
 const Component* EdaData::getComponent(const std::string& refDes) const {
-    auto it = components_.find(refDes);
-    return (it != components_.end()) ? it->second.get() : nullptr;
+    return getComponent(getComponentIndex(refDes));
+}
+
+Component* EdaData::getComponent(int index) {
+    if (index >= 0 && static_cast<size_t>(index) < components_.size()) {
+        return components_[static_cast<size_t>(index)].get();
+    }
+    return nullptr;
+}
+
+const Component* EdaData::getComponent(int index) const {
+    if (index >= 0 && static_cast<size_t>(index) < components_.size()) {
+        return components_[static_cast<size_t>(index)].get();
+    }
+    return nullptr;
+}
+
+int EdaData::getComponentIndex(const std::string& refDes) const {
+    int32_t id = names_.find(refDes);
+    if (id < 0 && !refDes.empty()) return -1;
+    return slotOf(componentSlots_, id);
 }
 
 void EdaData::addComponent(std::unique_ptr<Component> comp) {
-    if (comp) {
-        components_[comp->getRefDes()] = std::move(comp);
+    if (!comp) return;
+
+    auto slot = static_cast<size_t>(names_.intern(comp->getRefDes()) + 1);
+    if (slot >= componentSlots_.size()) {
+        componentSlots_.resize(names_.size() + 1, -1);
+    }
+    if (componentSlots_[slot] >= 0) {
+        components_[static_cast<size_t>(componentSlots_[slot])] = std::move(comp);
+    } else {
+        componentSlots_[slot] = static_cast<int32_t>(components_.size());
+        components_.push_back(std::move(comp));
     }
 }
 
 std::vector<std::string> EdaData::getComponentRefDes() const {
     std::vector<std::string> refDes;
     refDes.reserve(components_.size());
-    for (const auto& pair : components_) {
-        refDes.push_back(pair.first);
+    for (const auto& comp : components_) {
+        refDes.push_back(comp->getRefDes());
     }
     return refDes;
 }
 
 Net* EdaData::getNet(const std::string& name) {
-    auto it = nets_.find(name);
-    return (it != nets_.end()) ? it->second.get() : nullptr;
+    return getNet(getNetIndex(name));
 }
 
 const Net* EdaData::getNet(const std::string& name) const {
-    auto it = nets_.find(name);
-    return (it != nets_.end()) ? it->second.get() : nullptr;
+    return getNet(getNetIndex(name));
+}
+
+Net* EdaData::getNet(int index) {
+    if (index >= 0 && static_cast<size_t>(index) < nets_.size()) {
+        return nets_[static_cast<size_t>(index)].get();
+    }
+    return nullptr;
+}
+
+const Net* EdaData::getNet(int index) const {
+    if (index >= 0 && static_cast<size_t>(index) < nets_.size()) {
+        return nets_[static_cast<size_t>(index)].get();
+    }
+    return nullptr;
+}
+
+int EdaData::getNetIndex(const std::string& name) const {
+    int32_t id = names_.find(name);
+    if (id < 0 && !name.empty()) return -1;
+    return slotOf(netSlots_, id);
 }
 
 void EdaData::addNet(std::unique_ptr<Net> net) {
-    if (net) {
-        nets_[net->getName()] = std::move(net);
+    if (!net) return;
+
+    auto slot = static_cast<size_t>(names_.intern(net->getName()) + 1);
+    if (slot >= netSlots_.size()) {
+        netSlots_.resize(names_.size() + 1, -1);
+    }
+    if (netSlots_[slot] >= 0) {
+        nets_[static_cast<size_t>(netSlots_[slot])] = std::move(net);
+    } else {
+        netSlots_[slot] = static_cast<int32_t>(nets_.size());
+        nets_.push_back(std::move(net));
     }
 }
 
 std::vector<std::string> EdaData::getNetNames() const {
     std::vector<std::string> names;
     names.reserve(nets_.size());
-    for (const auto& pair : nets_) {
-        names.push_back(pair.first);
+    for (const auto& net : nets_) {
+        names.push_back(net->getName());
     }
     return names;
 }
@@ -201,17 +260,17 @@ std::vector<std::string> EdaData::getPackageNames() const {
 
 size_t EdaData::getTotalPinCount() const {
     size_t count = 0;
-    for (const auto& pair : components_) {
-        count += pair.second->getPinCount();
+    for (const auto& comp : components_) {
+        count += comp->getPinCount();
     }
     return count;
 }
 
 std::vector<const Component*> EdaData::getComponentsOnSide(MountSide side) const {
     std::vector<const Component*> result;
-    for (const auto& pair : components_) {
-        if (pair.second->getSide() == side) {
-            result.push_back(pair.second.get());
+    for (const auto& comp : components_) {
+        if (comp->getSide() == side) {
+            result.push_back(comp.get());
         }
     }
     return result;
@@ -243,11 +302,13 @@ const BomItem* EdaData::getBomItem(const std::string& refDes) const {
 // ============================================================================
 
 void EdaData::addSubnet(const std::string& netName, const Subnet& subnet) {
-    netSubnets_[netName].push_back(subnet);
+    netSubnets_[names_.intern(netName)].push_back(subnet);
 }
 
 std::vector<Subnet> EdaData::getSubnets(const std::string& netName) const {
-    auto it = netSubnets_.find(netName);
+    int32_t id = names_.find(netName);
+    if (id < 0 && !netName.empty()) return {};
+    auto it = netSubnets_.find(id);
     if (it != netSubnets_.end()) {
         return it->second;
     }
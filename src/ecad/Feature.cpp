@@ -1,4 +1,5 @@
 #include <koo/ecad/Feature.hpp>
+#include <koo/ecad/Symbol.hpp>
 #include <cmath>
 #include <algorithm>
 
@@ -23,6 +24,13 @@ std::unique_ptr<Feature> LineFeature::clone() const {
     return std::make_unique<LineFeature>(*this);
 }
 
+void LineFeature::transform(const Transform2D& t) {
+    Point2D start = t.apply(getStart());
+    Point2D end = t.apply(getEnd());
+    xs_ = start.x; ys_ = start.y;
+    xe_ = end.x; ye_ = end.y;
+}
+
 double LineFeature::getLength() const {
     double dx = xe_ - xs_;
     double dy = ye_ - ys_;
@@ -45,10 +53,38 @@ BoundingBox2D PadFeature::getBoundingBox() const {
     return box;
 }
 
+BoundingBox2D PadFeature::getBoundingBox(const SymbolCache& symbols,
+                                         const std::string& layerUnits) const {
+    const SymbolGeometry& symbol = symbols.get(symbolName_, layerUnits);
+    if (!symbol.isValid()) {
+        return getBoundingBox();
+    }
+    double resize = hasResize_ && resizeFactor_ > 0.0 ? resizeFactor_ : 1.0;
+    BoundingBox2D box;
+    if (symbol.radius > 0.0) {
+        double r = symbol.radius * resize;
+        box.expand({x_ - r, y_ - r});
+        box.expand({x_ + r, y_ + r});
+        return box;
+    }
+    Transform2D place(rotation_, mirror_, {x_, y_});
+    for (const auto& p : symbol.points) {
+        box.expand(place.apply(Point2D{p.x * resize, p.y * resize}));
+    }
+    return box;
+}
+
 std::unique_ptr<Feature> PadFeature::clone() const {
     return std::make_unique<PadFeature>(*this);
 }
 
+void PadFeature::transform(const Transform2D& t) {
+    Point2D pos = t.apply(getPosition());
+    x_ = pos.x; y_ = pos.y;
+    rotation_ = t.applyAngle(rotation_);
+    mirror_ = mirror_ != t.isMirrored();
+}
+
 // ============================================================================
 // ArcFeature
 // ============================================================================
@@ -100,6 +136,16 @@ std::unique_ptr<Feature> ArcFeature::clone() const {
     return std::make_unique<ArcFeature>(*this);
 }
 
+void ArcFeature::transform(const Transform2D& t) {
+    Point2D start = t.apply(getStart());
+    Point2D end = t.apply(getEnd());
+    Point2D center = t.apply(getCenter());
+    xs_ = start.x; ys_ = start.y;
+    xe_ = end.x; ye_ = end.y;
+    xc_ = center.x; yc_ = center.y;
+    clockwise_ = clockwise_ != t.isMirrored();
+}
+
 double ArcFeature::getRadius() const {
     double dx = xs_ - xc_;
     double dy = ys_ - yc_;
@@ -230,6 +276,19 @@ bool Contour::contains(double x, double y) const {
     return (crossings % 2) == 1;
 }
 
+void Contour::transform(const Transform2D& t) {
+    Point2D start = t.apply(getStart());
+    startX_ = start.x;
+    startY_ = start.y;
+    for (auto& seg : segments_) {
+        Point2D end = t.apply({seg.x, seg.y});
+        Point2D center = t.apply({seg.xc, seg.yc});
+        seg.x = end.x; seg.y = end.y;
+        seg.xc = center.x; seg.yc = center.y;
+        seg.clockwise = seg.clockwise != t.isMirrored();
+    }
+}
+
 // ============================================================================
 // SurfaceFeature
 // ============================================================================
@@ -246,6 +305,12 @@ std::unique_ptr<Feature> SurfaceFeature::clone() const {
     return std::make_unique<SurfaceFeature>(*this);
 }
 
+void SurfaceFeature::transform(const Transform2D& t) {
+    for (auto& contour : contours_) {
+        contour.transform(t);
+    }
+}
+
 void SurfaceFeature::addContour(const Contour& contour) {
     contours_.push_back(contour);
 }
@@ -331,6 +396,13 @@ std::unique_ptr<Feature> TextFeature::clone() const {
     return std::make_unique<TextFeature>(*this);
 }
 
+void TextFeature::transform(const Transform2D& t) {
+    Point2D pos = t.apply(getPosition());
+    x_ = pos.x; y_ = pos.y;
+    rotation_ = t.applyAngle(rotation_);
+    mirror_ = mirror_ != t.isMirrored();
+}
+
 // ============================================================================
 // BarcodeFeature
 // ============================================================================
@@ -348,4 +420,11 @@ std::unique_ptr<Feature> BarcodeFeature::clone() const {
     return std::make_unique<BarcodeFeature>(*this);
 }
 
+void BarcodeFeature::transform(const Transform2D& t) {
+    Point2D pos = t.apply(getPosition());
+    x_ = pos.x; y_ = pos.y;
+    rotation_ = t.applyAngle(rotation_);
+    mirror_ = mirror_ != t.isMirrored();
+}
+
 } // namespace koo::ecad
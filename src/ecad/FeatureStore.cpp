@@ -0,0 +1,800 @@
+#include <koo/ecad/FeatureStore.hpp>
+#include <koo/ecad/Symbol.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBlockSize = 16384;
+
+const std::string kEmptyString;
+const AttributeList kEmptyAttributes;
+
+/// Rough heap cost of a hash or tree node, used by getMemoryUsage()
+constexpr size_t kNodeBytes = 64;
+
+// Helper to count the heap bytes of a column
+template<typename T>
+size_t columnBytes(const std::vector<T>& column) {
+    return column.capacity() * sizeof(T);
+}
+
+// Helper to estimate the heap bytes of a Surface, Text or Barcode object
+size_t objectBytes(const Feature& object) {
+    size_t bytes = kNodeBytes * 4 + object.getAttributes().size() * kNodeBytes;
+    if (object.getType() == FeatureType::Surface) {
+        for (const auto& contour : static_cast<const SurfaceFeature&>(object).getContours()) {
+            bytes += sizeof(Contour) + contour.getSegments().capacity() * sizeof(ContourSegment);
+        }
+    }
+    return bytes;
+}
+
+// Helper to erase one row from a column
+template<typename T>
+void eraseRow(std::vector<T>& column, size_t row) {
+    column.erase(column.begin() + static_cast<std::ptrdiff_t>(row));
+}
+
+// Helper to shift sparse-table keys down after removing a feature
+template<typename Map>
+void eraseKey(Map& table, size_t index) {
+    if (table.empty()) return;
+    Map shifted;
+    shifted.reserve(table.size());
+    for (auto& entry : table) {
+        if (entry.first < index) {
+            shifted.emplace(entry.first, std::move(entry.second));
+        } else if (entry.first > index) {
+            shifted.emplace(entry.first - 1, std::move(entry.second));
+        }
+    }
+    table.swap(shifted);
+}
+
+/// Symbol extent as the pad kernel needs it (layer units, centered)
+struct PadSymbol {
+    double hw = 0.0;                ///< Half extent along x (radius for round symbols)
+    double hh = 0.0;                ///< Half extent along y
+    bool valid = false;
+    bool round = false;             ///< Extent independent of orientation
+    bool box = false;               ///< Rectangular outline: rotated extents are exact in closed form
+    const SymbolGeometry* geometry = nullptr;
+};
+
+// Helper to reduce resolved symbols to what the extent kernels read
+std::vector<PadSymbol> padSymbols(const std::vector<const SymbolGeometry*>& symbols) {
+    std::vector<PadSymbol> result(symbols.size());
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        const SymbolGeometry* g = symbols[i];
+        if (!g || !g->isValid()) continue;
+        PadSymbol& p = result[i];
+        p.valid = true;
+        p.geometry = g;
+        p.hw = g->bounds.max.x;
+        p.hh = g->bounds.max.y;
+        p.round = g->radius > 0.0;
+        p.box = g->rings.size() == 2 && g->points.size() == 4 &&
+                std::all_of(g->points.begin(), g->points.end(), [&](const Point2D& v) {
+                    return std::fabs(v.x) == p.hw && std::fabs(v.y) == p.hh;
+                });
+    }
+    return result;
+}
+
+// Helper to get cos/sin of a clockwise pad rotation, exact for quarter turns
+void padTrig(double degrees, double& c, double& s) {
+    double angle = Transform2D::normalizeAngle(degrees);
+    double quarter = angle / 90.0;
+    if (quarter == std::floor(quarter)) {
+        static constexpr double kCos[] = {1.0, 0.0, -1.0, 0.0};
+        static constexpr double kSin[] = {0.0, 1.0, 0.0, -1.0};
+        auto q = static_cast<size_t>(quarter) % 4;
+        c = kCos[q];
+        s = kSin[q];
+    } else {
+        double rad = angle * 3.14159265358979323846 / 180.0;
+        c = std::cos(rad);
+        s = std::sin(rad);
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// StringTable
+// ============================================================================
+
+int32_t StringTable::intern(const std::string& str) {
+    if (str.empty()) return -1;
+    auto it = index_.find(str);
+    if (it != index_.end()) {
+        return it->second;
+    }
+    auto index = static_cast<int32_t>(strings_.size());
+    strings_.push_back(str);
+    index_.emplace(str, index);
+    return index;
+}
+
+int32_t StringTable::find(const std::string& str) const {
+    auto it = index_.find(str);
+    return (it != index_.end()) ? it->second : -1;
+}
+
+const std::string& StringTable::get(int32_t index) const {
+    if (index >= 0 && static_cast<size_t>(index) < strings_.size()) {
+        return strings_[static_cast<size_t>(index)];
+    }
+    return kEmptyString;
+}
+
+void StringTable::clear() {
+    strings_.clear();
+    index_.clear();
+}
+
+// ============================================================================
+// FeatureView
+// ============================================================================
+
+FeatureType FeatureView::getType() const { return store_->getType(index_); }
+Polarity FeatureView::getPolarity() const { return store_->getPolarity(index_); }
+int FeatureView::getDcode() const { return store_->getDcode(index_); }
+const std::string& FeatureView::getId() const { return store_->getId(index_); }
+
+const std::string& FeatureView::getNetName() const {
+    return store_->getNets().get(store_->getNet(index_));
+}
+
+std::string FeatureView::getAttribute(const std::string& key) const {
+    const auto& attrs = store_->getAttributes(index_);
+    auto it = attrs.find(key);
+    return (it != attrs.end()) ? it->second : "";
+}
+
+int32_t FeatureView::getSymbolIndex() const {
+    uint32_t row = store_->getRow(index_);
+    switch (getType()) {
+        case FeatureType::Line: return store_->getLines().symbol[row];
+        case FeatureType::Pad:  return store_->getPads().symbol[row];
+        case FeatureType::Arc:  return store_->getArcs().symbol[row];
+        default:                return -1;
+    }
+}
+
+const std::string& FeatureView::getSymbolName() const {
+    return store_->getSymbols().get(getSymbolIndex());
+}
+
+Point2D FeatureView::getStart() const {
+    uint32_t row = store_->getRow(index_);
+    if (getType() == FeatureType::Line) {
+        const auto& c = store_->getLines();
+        return {c.xs[row], c.ys[row]};
+    }
+    if (getType() == FeatureType::Arc) {
+        const auto& c = store_->getArcs();
+        return {c.xs[row], c.ys[row]};
+    }
+    return {};
+}
+
+Point2D FeatureView::getEnd() const {
+    uint32_t row = store_->getRow(index_);
+    if (getType() == FeatureType::Line) {
+        const auto& c = store_->getLines();
+        return {c.xe[row], c.ye[row]};
+    }
+    if (getType() == FeatureType::Arc) {
+        const auto& c = store_->getArcs();
+        return {c.xe[row], c.ye[row]};
+    }
+    return {};
+}
+
+Point2D FeatureView::getCenter() const {
+    if (getType() != FeatureType::Arc) return {};
+    uint32_t row = store_->getRow(index_);
+    return {store_->getArcs().xc[row], store_->getArcs().yc[row]};
+}
+
+bool FeatureView::isClockwise() const {
+    return getType() == FeatureType::Arc &&
+           store_->getArcs().clockwise[store_->getRow(index_)] != 0;
+}
+
+Point2D FeatureView::getPosition() const {
+    if (getType() != FeatureType::Pad) return {};
+    uint32_t row = store_->getRow(index_);
+    return {store_->getPads().x[row], store_->getPads().y[row]};
+}
+
+double FeatureView::getRotation() const {
+    if (getType() != FeatureType::Pad) return 0.0;
+    return store_->getPads().rotation[store_->getRow(index_)];
+}
+
+bool FeatureView::isMirrored() const {
+    return getType() == FeatureType::Pad &&
+           (store_->getPads().flags[store_->getRow(index_)] & FeatureStore::PadMirror) != 0;
+}
+
+double FeatureView::getResizeFactor() const {
+    if (getType() != FeatureType::Pad) return 0.0;
+    return store_->getPads().resize[store_->getRow(index_)];
+}
+
+bool FeatureView::hasResize() const {
+    return getType() == FeatureType::Pad &&
+           (store_->getPads().flags[store_->getRow(index_)] & FeatureStore::PadResize) != 0;
+}
+
+const Feature* FeatureView::getObject() const {
+    switch (getType()) {
+        case FeatureType::Line:
+        case FeatureType::Pad:
+        case FeatureType::Arc:
+            return nullptr;
+        default:
+            return store_->getObject(store_->getRow(index_));
+    }
+}
+
+BoundingBox2D FeatureView::getBoundingBox() const {
+    return store_->getBoundingBox(index_);
+}
+
+std::unique_ptr<Feature> FeatureView::materialize() const {
+    std::unique_ptr<Feature> feature;
+    switch (getType()) {
+        case FeatureType::Line: {
+            auto start = getStart();
+            auto end = getEnd();
+            auto line = std::make_unique<LineFeature>(start.x, start.y, end.x, end.y,
+                                                      getSymbolName());
+            line->setSymbolIndex(getSymbolIndex());
+            feature = std::move(line);
+            break;
+        }
+        case FeatureType::Pad: {
+            auto pos = getPosition();
+            auto pad = std::make_unique<PadFeature>(pos.x, pos.y, getSymbolName(),
+                                                    getRotation(), isMirrored());
+            pad->setSymbolIndex(getSymbolIndex());
+            pad->setHasResize(hasResize());
+            pad->setResizeFactor(getResizeFactor());
+            feature = std::move(pad);
+            break;
+        }
+        case FeatureType::Arc: {
+            auto start = getStart();
+            auto end = getEnd();
+            auto center = getCenter();
+            auto arc = std::make_unique<ArcFeature>(start.x, start.y, end.x, end.y,
+                                                    center.x, center.y, getSymbolName(),
+                                                    isClockwise());
+            arc->setSymbolIndex(getSymbolIndex());
+            feature = std::move(arc);
+            break;
+        }
+        default:
+            // Objects carry their own ID, attributes and net
+            return getObject()->clone();
+    }
+
+    feature->setPolarity(getPolarity());
+    feature->setDcode(getDcode());
+    feature->setNetName(getNetName());
+    feature->setId(getId());
+    for (const auto& attr : store_->getAttributes(index_)) {
+        feature->setAttribute(attr.first, attr.second);
+    }
+    return feature;
+}
+
+// ============================================================================
+// FeatureStore - Adding / Removing
+// ============================================================================
+
+size_t FeatureStore::push(FeatureType type, size_t row, Polarity polarity, int dcode, int32_t net) {
+    types_.push_back(static_cast<uint8_t>(type));
+    rows_.push_back(static_cast<uint32_t>(row));
+    polarity_.push_back(static_cast<uint8_t>(polarity));
+    dcode_.push_back(dcode);
+    net_.push_back(net);
+    return types_.size() - 1;
+}
+
+size_t FeatureStore::add(std::unique_ptr<Feature> feature) {
+    size_t index = 0;
+    switch (feature->getType()) {
+        case FeatureType::Line: {
+            const auto& line = static_cast<const LineFeature&>(*feature);
+            auto start = line.getStart();
+            auto end = line.getEnd();
+            index = addLine(start.x, start.y, end.x, end.y, symbols_.intern(line.getSymbolName()),
+                            line.getPolarity(), line.getDcode());
+            break;
+        }
+        case FeatureType::Pad: {
+            const auto& pad = static_cast<const PadFeature&>(*feature);
+            auto pos = pad.getPosition();
+            index = addPad(pos.x, pos.y, symbols_.intern(pad.getSymbolName()),
+                           pad.getPolarity(), pad.getDcode(), pad.getRotation(), pad.isMirrored(),
+                           pad.hasResize(), pad.getResizeFactor());
+            break;
+        }
+        case FeatureType::Arc: {
+            const auto& arc = static_cast<const ArcFeature&>(*feature);
+            auto start = arc.getStart();
+            auto end = arc.getEnd();
+            auto center = arc.getCenter();
+            index = addArc(start.x, start.y, end.x, end.y, center.x, center.y,
+                           symbols_.intern(arc.getSymbolName()), arc.isClockwise(),
+                           arc.getPolarity(), arc.getDcode());
+            break;
+        }
+        default: {
+            index = push(feature->getType(), objects_.size(), feature->getPolarity(),
+                         feature->getDcode(), nets_.intern(feature->getNetName()));
+            objects_.push_back(std::move(feature));
+            return index;
+        }
+    }
+
+    net_[index] = nets_.intern(feature->getNetName());
+    if (!feature->getId().empty()) {
+        ids_[index] = feature->getId();
+    }
+    if (!feature->getAttributes().empty()) {
+        attributes_[index] = feature->getAttributes();
+    }
+    return index;
+}
+
+size_t FeatureStore::addLine(double xs, double ys, double xe, double ye, int32_t symbol,
+                             Polarity polarity, int dcode) {
+    lines_.xs.push_back(xs);
+    lines_.ys.push_back(ys);
+    lines_.xe.push_back(xe);
+    lines_.ye.push_back(ye);
+    lines_.symbol.push_back(symbol);
+    return push(FeatureType::Line, lines_.xs.size() - 1, polarity, dcode, -1);
+}
+
+size_t FeatureStore::addPad(double x, double y, int32_t symbol, Polarity polarity, int dcode,
+                            double rotation, bool mirror, bool hasResize, double resizeFactor) {
+    pads_.x.push_back(x);
+    pads_.y.push_back(y);
+    pads_.rotation.push_back(rotation);
+    pads_.resize.push_back(resizeFactor);
+    pads_.symbol.push_back(symbol);
+    pads_.flags.push_back(static_cast<uint8_t>((mirror ? PadMirror : 0) | (hasResize ? PadResize : 0)));
+    return push(FeatureType::Pad, pads_.x.size() - 1, polarity, dcode, -1);
+}
+
+size_t FeatureStore::addArc(double xs, double ys, double xe, double ye, double xc, double yc,
+                            int32_t symbol, bool clockwise, Polarity polarity, int dcode) {
+    arcs_.xs.push_back(xs);
+    arcs_.ys.push_back(ys);
+    arcs_.xe.push_back(xe);
+    arcs_.ye.push_back(ye);
+    arcs_.xc.push_back(xc);
+    arcs_.yc.push_back(yc);
+    arcs_.symbol.push_back(symbol);
+    arcs_.clockwise.push_back(clockwise ? 1 : 0);
+    return push(FeatureType::Arc, arcs_.xs.size() - 1, polarity, dcode, -1);
+}
+
+void FeatureStore::appendInstances(const FeatureStore& source,
+                                   const std::vector<Transform2D>& transforms, size_t threads) {
+    if (&source == this) {
+        FeatureStore copy;
+        copy.appendInstances(source, {Transform2D()}, threads);
+        appendInstances(copy, transforms, threads);
+        return;
+    }
+
+    // Source table index -> table index here
+    auto remap = [](const StringTable& from, StringTable& to) {
+        std::vector<int32_t> map;
+        map.reserve(from.size());
+        for (const auto& str : from.getStrings()) map.push_back(to.intern(str));
+        return map;
+    };
+    std::vector<int32_t> symbolMap = remap(source.symbols_, symbols_);
+    std::vector<int32_t> netMap = remap(source.nets_, nets_);
+    auto mapped = [](const std::vector<int32_t>& map, int32_t index) {
+        return index < 0 ? index : map[static_cast<size_t>(index)];
+    };
+
+    size_t count = source.size();
+    size_t copies = transforms.size();
+    size_t base = size();
+    size_t lineBase = lines_.xs.size(), lineCount = source.lines_.xs.size();
+    size_t padBase = pads_.x.size(), padCount = source.pads_.x.size();
+    size_t arcBase = arcs_.xs.size(), arcCount = source.arcs_.xs.size();
+    size_t objectBase = objects_.size(), objectCount = source.objects_.size();
+
+    for (auto* column : {&lines_.xs, &lines_.ys, &lines_.xe, &lines_.ye}) {
+        column->resize(lineBase + lineCount * copies);
+    }
+    lines_.symbol.resize(lineBase + lineCount * copies);
+    for (auto* column : {&pads_.x, &pads_.y, &pads_.rotation, &pads_.resize}) {
+        column->resize(padBase + padCount * copies);
+    }
+    pads_.symbol.resize(padBase + padCount * copies);
+    pads_.flags.resize(padBase + padCount * copies);
+    for (auto* column : {&arcs_.xs, &arcs_.ys, &arcs_.xe, &arcs_.ye, &arcs_.xc, &arcs_.yc}) {
+        column->resize(arcBase + arcCount * copies);
+    }
+    arcs_.symbol.resize(arcBase + arcCount * copies);
+    arcs_.clockwise.resize(arcBase + arcCount * copies);
+    objects_.resize(objectBase + objectCount * copies);
+    types_.resize(base + count * copies);
+    rows_.resize(base + count * copies);
+    polarity_.resize(base + count * copies);
+    dcode_.resize(base + count * copies);
+    net_.resize(base + count * copies);
+
+    util::parallelForBlocks(count, kBlockSize, [&](size_t, size_t first, size_t last) {
+        for (size_t k = 0; k < copies; ++k) {
+            const Transform2D& t = transforms[k];
+            uint8_t mirrorFlag = t.isMirrored() ? PadMirror : 0;
+            for (size_t i = first; i < last; ++i) {
+                size_t index = base + k * count + i;
+                uint32_t from = source.rows_[i];
+                size_t row = 0;
+                switch (source.getType(i)) {
+                    case FeatureType::Line: {
+                        row = lineBase + k * lineCount + from;
+                        Point2D start = t.apply({source.lines_.xs[from], source.lines_.ys[from]});
+                        Point2D end = t.apply({source.lines_.xe[from], source.lines_.ye[from]});
+                        lines_.xs[row] = start.x;
+                        lines_.ys[row] = start.y;
+                        lines_.xe[row] = end.x;
+                        lines_.ye[row] = end.y;
+                        lines_.symbol[row] = mapped(symbolMap, source.lines_.symbol[from]);
+                        break;
+                    }
+                    case FeatureType::Pad: {
+                        row = padBase + k * padCount + from;
+                        Point2D pos = t.apply({source.pads_.x[from], source.pads_.y[from]});
+                        pads_.x[row] = pos.x;
+                        pads_.y[row] = pos.y;
+                        pads_.rotation[row] = t.applyAngle(source.pads_.rotation[from]);
+                        pads_.resize[row] = source.pads_.resize[from];
+                        pads_.symbol[row] = mapped(symbolMap, source.pads_.symbol[from]);
+                        pads_.flags[row] = static_cast<uint8_t>(source.pads_.flags[from] ^ mirrorFlag);
+                        break;
+                    }
+                    case FeatureType::Arc: {
+                        row = arcBase + k * arcCount + from;
+                        Point2D start = t.apply({source.arcs_.xs[from], source.arcs_.ys[from]});
+                        Point2D end = t.apply({source.arcs_.xe[from], source.arcs_.ye[from]});
+                        Point2D center = t.apply({source.arcs_.xc[from], source.arcs_.yc[from]});
+                        arcs_.xs[row] = start.x;
+                        arcs_.ys[row] = start.y;
+                        arcs_.xe[row] = end.x;
+                        arcs_.ye[row] = end.y;
+                        arcs_.xc[row] = center.x;
+                        arcs_.yc[row] = center.y;
+                        arcs_.symbol[row] = mapped(symbolMap, source.arcs_.symbol[from]);
+                        arcs_.clockwise[row] = static_cast<uint8_t>((source.arcs_.clockwise[from] != 0) != t.isMirrored());
+                        break;
+                    }
+                    default: {
+                        row = objectBase + k * objectCount + from;
+                        auto object = source.objects_[from]->clone();
+                        object->transform(t);
+                        objects_[row] = std::move(object);
+                        break;
+                    }
+                }
+                types_[index] = source.types_[i];
+                rows_[index] = static_cast<uint32_t>(row);
+                polarity_[index] = source.polarity_[i];
+                dcode_[index] = source.dcode_[i];
+                net_[index] = mapped(netMap, source.net_[i]);
+            }
+        }
+    }, threads);
+
+    for (size_t k = 0; k < copies; ++k) {
+        for (const auto& [index, id] : source.ids_) {
+            ids_.emplace(base + k * count + index, id);
+        }
+        for (const auto& [index, attributes] : source.attributes_) {
+            attributes_.emplace(base + k * count + index, attributes);
+        }
+    }
+}
+
+void FeatureStore::remove(size_t index) {
+    if (index >= size()) return;
+
+    uint8_t type = types_[index];
+    uint32_t row = rows_[index];
+    switch (getType(index)) {
+        case FeatureType::Line:
+            for (auto* column : {&lines_.xs, &lines_.ys, &lines_.xe, &lines_.ye}) {
+                eraseRow(*column, row);
+            }
+            eraseRow(lines_.symbol, row);
+            break;
+        case FeatureType::Pad:
+            for (auto* column : {&pads_.x, &pads_.y, &pads_.rotation, &pads_.resize}) {
+                eraseRow(*column, row);
+            }
+            eraseRow(pads_.symbol, row);
+            eraseRow(pads_.flags, row);
+            break;
+        case FeatureType::Arc:
+            for (auto* column : {&arcs_.xs, &arcs_.ys, &arcs_.xe, &arcs_.ye, &arcs_.xc, &arcs_.yc}) {
+                eraseRow(*column, row);
+            }
+            eraseRow(arcs_.symbol, row);
+            eraseRow(arcs_.clockwise, row);
+            break;
+        default:
+            eraseRow(objects_, row);
+            break;
+    }
+
+    for (size_t i = 0; i < types_.size(); ++i) {
+        if (types_[i] == type && rows_[i] > row) {
+            --rows_[i];
+        }
+    }
+
+    eraseRow(types_, index);
+    eraseRow(rows_, index);
+    eraseRow(polarity_, index);
+    eraseRow(dcode_, index);
+    eraseRow(net_, index);
+    eraseKey(ids_, index);
+    eraseKey(attributes_, index);
+}
+
+void FeatureStore::clear() {
+    *this = FeatureStore();
+}
+
+size_t FeatureStore::getMemoryUsage() const {
+    size_t bytes = columnBytes(types_) + columnBytes(rows_) + columnBytes(polarity_) +
+                   columnBytes(dcode_) + columnBytes(net_);
+    bytes += columnBytes(lines_.xs) + columnBytes(lines_.ys) + columnBytes(lines_.xe) +
+             columnBytes(lines_.ye) + columnBytes(lines_.symbol);
+    bytes += columnBytes(pads_.x) + columnBytes(pads_.y) + columnBytes(pads_.rotation) +
+             columnBytes(pads_.resize) + columnBytes(pads_.symbol) + columnBytes(pads_.flags);
+    bytes += columnBytes(arcs_.xs) + columnBytes(arcs_.ys) + columnBytes(arcs_.xe) +
+             columnBytes(arcs_.ye) + columnBytes(arcs_.xc) + columnBytes(arcs_.yc) +
+             columnBytes(arcs_.symbol) + columnBytes(arcs_.clockwise);
+
+    bytes += columnBytes(objects_);
+    for (const auto& object : objects_) {
+        bytes += objectBytes(*object);
+    }
+    for (const auto& entry : ids_) {
+        bytes += kNodeBytes + entry.second.capacity();
+    }
+    for (const auto& entry : attributes_) {
+        bytes += kNodeBytes + entry.second.size() * kNodeBytes;
+    }
+    for (const auto* table : {&symbols_, &nets_}) {
+        for (const auto& name : table->getStrings()) {
+            bytes += sizeof(std::string) + name.capacity() + kNodeBytes;
+        }
+    }
+    return bytes;
+}
+
+// ============================================================================
+// FeatureStore - Per-Feature Columns
+// ============================================================================
+
+const std::string& FeatureStore::getId(size_t index) const {
+    if (const Feature* object = FeatureView(*this, index).getObject()) {
+        return object->getId();
+    }
+    auto it = ids_.find(index);
+    return (it != ids_.end()) ? it->second : kEmptyString;
+}
+
+const AttributeList& FeatureStore::getAttributes(size_t index) const {
+    if (const Feature* object = FeatureView(*this, index).getObject()) {
+        return object->getAttributes();
+    }
+    auto it = attributes_.find(index);
+    return (it != attributes_.end()) ? it->second : kEmptyAttributes;
+}
+
+void FeatureStore::setNetName(size_t index, const std::string& netName) {
+    net_[index] = nets_.intern(netName);
+    if (FeatureView(*this, index).getObject()) {
+        objects_[rows_[index]]->setNetName(netName);
+    }
+}
+
+void FeatureStore::setId(size_t index, const std::string& id) {
+    if (FeatureView(*this, index).getObject()) {
+        objects_[rows_[index]]->setId(id);
+    } else if (id.empty()) {
+        ids_.erase(index);
+    } else {
+        ids_[index] = id;
+    }
+}
+
+void FeatureStore::setAttribute(size_t index, const std::string& key, const std::string& value) {
+    if (FeatureView(*this, index).getObject()) {
+        objects_[rows_[index]]->setAttribute(key, value);
+    } else {
+        attributes_[index][key] = value;
+    }
+}
+
+// ============================================================================
+// FeatureStore - Geometry
+// ============================================================================
+
+BoundingBox2D FeatureStore::getBoundingBox(size_t index) const {
+    uint32_t row = rows_[index];
+    BoundingBox2D box;
+    switch (getType(index)) {
+        case FeatureType::Line:
+            box.expand({lines_.xs[row], lines_.ys[row]});
+            box.expand({lines_.xe[row], lines_.ye[row]});
+            return box;
+        case FeatureType::Pad:
+            box.expand({pads_.x[row], pads_.y[row]});
+            return box;
+        case FeatureType::Arc:
+            return ArcFeature(arcs_.xs[row], arcs_.ys[row], arcs_.xe[row], arcs_.ye[row],
+                              arcs_.xc[row], arcs_.yc[row], std::string(),
+                              arcs_.clockwise[row] != 0).getBoundingBox();
+        default:
+            return objects_[row]->getBoundingBox();
+    }
+}
+
+BoundingBox2D FeatureStore::getBoundingBox() const {
+    BoundingBox2D box;
+    if (!lines_.xs.empty()) {
+        auto [xsMin, xsMax] = std::minmax_element(lines_.xs.begin(), lines_.xs.end());
+        auto [ysMin, ysMax] = std::minmax_element(lines_.ys.begin(), lines_.ys.end());
+        auto [xeMin, xeMax] = std::minmax_element(lines_.xe.begin(), lines_.xe.end());
+        auto [yeMin, yeMax] = std::minmax_element(lines_.ye.begin(), lines_.ye.end());
+        box.expand({std::min(*xsMin, *xeMin), std::min(*ysMin, *yeMin)});
+        box.expand({std::max(*xsMax, *xeMax), std::max(*ysMax, *yeMax)});
+    }
+    if (!pads_.x.empty()) {
+        auto [xMin, xMax] = std::minmax_element(pads_.x.begin(), pads_.x.end());
+        auto [yMin, yMax] = std::minmax_element(pads_.y.begin(), pads_.y.end());
+        box.expand({*xMin, *yMin});
+        box.expand({*xMax, *yMax});
+    }
+    for (size_t row = 0; row < arcs_.xs.size(); ++row) {
+        box.expand(ArcFeature(arcs_.xs[row], arcs_.ys[row], arcs_.xe[row], arcs_.ye[row],
+                              arcs_.xc[row], arcs_.yc[row], std::string(),
+                              arcs_.clockwise[row] != 0).getBoundingBox());
+    }
+    for (const auto& object : objects_) {
+        box.expand(object->getBoundingBox());
+    }
+    return box;
+}
+
+std::vector<BoundingBox2D> FeatureStore::getBoundingBoxes(size_t threads) const {
+    std::vector<BoundingBox2D> boxes(size());
+    util::parallelForBlocks(size(), kBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            boxes[i] = getBoundingBox(i);
+        }
+    }, threads);
+    return boxes;
+}
+
+void FeatureStore::computeExtents(const std::vector<const SymbolGeometry*>& symbols,
+                                  std::vector<BoundingBox2D>& boxes, size_t threads) const {
+    const std::vector<PadSymbol> table = padSymbols(symbols);
+    auto symbolAt = [&table](int32_t symbol) -> const PadSymbol* {
+        if (symbol < 0 || static_cast<size_t>(symbol) >= table.size()) return nullptr;
+        const PadSymbol& p = table[static_cast<size_t>(symbol)];
+        return p.valid ? &p : nullptr;
+    };
+
+    // Pads, column by column: half extents first, then the boxes in one
+    // branch-free pass the compiler can vectorize
+    const size_t padCount = pads_.x.size();
+    std::vector<BoundingBox2D> padBoxes(padCount);
+    util::parallelForBlocks(padCount, kBlockSize, [&](size_t, size_t first, size_t last) {
+        const size_t n = last - first;
+        std::vector<double> ex0(n), ey0(n), ex1(n), ey1(n);
+        double lastAngle = 0.0, c = 1.0, s = 0.0;   // Orientations repeat: keep the last one's trig
+        for (size_t k = 0; k < n; ++k) {
+            size_t row = first + k;
+            const PadSymbol* p = symbolAt(pads_.symbol[row]);
+            if (!p) continue;
+            double scale = (pads_.flags[row] & PadResize) && pads_.resize[row] > 0.0 ? pads_.resize[row] : 1.0;
+            if (p->round) {
+                ex0[k] = ex1[k] = ey0[k] = ey1[k] = p->hw * scale;
+                continue;
+            }
+            if (pads_.rotation[row] != lastAngle) {
+                lastAngle = pads_.rotation[row];
+                padTrig(lastAngle, c, s);
+            }
+            if (p->box || c == 0.0 || s == 0.0) {
+                // Symmetric outline: extents of the rotated bounds are exact
+                double ac = std::fabs(c), as = std::fabs(s);
+                ex0[k] = ex1[k] = (ac * p->hw + as * p->hh) * scale;
+                ey0[k] = ey1[k] = (as * p->hw + ac * p->hh) * scale;
+                continue;
+            }
+            // Rounded or slanted outlines at arbitrary angles: walk the rings
+            bool mirror = (pads_.flags[row] & PadMirror) != 0;
+            const SymbolGeometry& g = *p->geometry;
+            double xMin = 0.0, xMax = 0.0, yMin = 0.0, yMax = 0.0;
+            for (const auto& v : g.points) {
+                double px = mirror ? -v.x : v.x;
+                double py = v.y;
+                double x = px * c + py * s;
+                double y = -px * s + py * c;
+                xMin = std::min(xMin, x);
+                xMax = std::max(xMax, x);
+                yMin = std::min(yMin, y);
+                yMax = std::max(yMax, y);
+            }
+            ex0[k] = -xMin * scale;
+            ex1[k] = xMax * scale;
+            ey0[k] = -yMin * scale;
+            ey1[k] = yMax * scale;
+        }
+        const double* x = pads_.x.data() + first;
+        const double* y = pads_.y.data() + first;
+        BoundingBox2D* out = padBoxes.data() + first;
+        for (size_t k = 0; k < n; ++k) {
+            out[k].min.x = x[k] - ex0[k];
+            out[k].min.y = y[k] - ey0[k];
+            out[k].max.x = x[k] + ex1[k];
+            out[k].max.y = y[k] + ey1[k];
+        }
+    }, threads);
+
+    boxes.resize(size());
+    util::parallelForBlocks(size(), kBlockSize, [&](size_t, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            uint32_t row = rows_[i];
+            const PadSymbol* p = nullptr;
+            switch (getType(i)) {
+                case FeatureType::Pad:
+                    boxes[i] = padBoxes[row];
+                    continue;
+                case FeatureType::Line:
+                    p = symbolAt(lines_.symbol[row]);
+                    break;
+                case FeatureType::Arc:
+                    p = symbolAt(arcs_.symbol[row]);
+                    break;
+                default:
+                    break;
+            }
+            BoundingBox2D box = getBoundingBox(i);
+            if (p) {
+                // Line and arc symbols are not rotated along the path
+                box.min.x -= p->hw;
+                box.min.y -= p->hh;
+                box.max.x += p->hw;
+                box.max.y += p->hh;
+            }
+            boxes[i] = box;
+        }
+    }, threads);
+}
+
+} // namespace koo::ecad
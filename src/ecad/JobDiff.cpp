@@ -0,0 +1,536 @@
+#include <koo/ecad/JobDiff.hpp>
+#include <koo/ecad/EdaData.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <koo/ecad/OdbJob.hpp>
+#include <koo/ecad/Step.hpp>
+#include <koo/ecad/Symbol.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBlockSize = 4096;
+constexpr double kValueGrid = 1e-9;     // Grid for angles, factors and other non-coordinates
+constexpr size_t kMaxUserDepth = 8;     // User symbols placed inside user symbols (as in SymbolCache)
+
+/// Content hash of each user symbol, by name
+using SymbolHashes = std::map<std::string, uint64_t>;
+
+// Helper to scramble 64 bits (splitmix64 finalizer)
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/// Stable 64-bit hash of a sequence of values (no std::hash, so results do not vary by platform)
+class Hasher {
+public:
+    Hasher& add(uint64_t value) {
+        h_ = mix(h_ ^ (value + 0x9e3779b97f4a7c15ULL + (h_ << 6) + (h_ >> 2)));
+        return *this;
+    }
+
+    Hasher& addInt(int64_t value) { return add(static_cast<uint64_t>(value)); }
+
+    Hasher& add(const std::string& text) {
+        uint64_t fnv = 0xcbf29ce484222325ULL;
+        for (char c : text) {
+            fnv ^= static_cast<uint8_t>(c);
+            fnv *= 0x100000001b3ULL;
+        }
+        return add(fnv).add(text.size());
+    }
+
+    uint64_t get() const { return h_; }
+
+private:
+    uint64_t h_ = 0x6a09e667f3bcc908ULL;
+};
+
+// Helper to snap a value to a grid
+int64_t snap(double value, double grid) {
+    return static_cast<int64_t>(std::llround(value / grid));
+}
+
+// Helper to hash an attribute list independently of its order
+uint64_t hashAttributes(const AttributeList& attributes) {
+    uint64_t sum = 0;
+    for (const auto& [key, value] : attributes) sum += Hasher().add(key).add(value).get();
+    return sum;
+}
+
+// Helper to add contours relative to an anchor (snapped grid units)
+void addContours(Hasher& h, const std::vector<Contour>& contours, int64_t ax, int64_t ay, double grid) {
+    h.add(contours.size());
+    for (const auto& contour : contours) {
+        Point2D start = contour.getStart();
+        h.addInt(static_cast<int64_t>(contour.getPolygonType()));
+        h.addInt(snap(start.x, grid) - ax).addInt(snap(start.y, grid) - ay);
+        h.add(contour.getSegments().size());
+        for (const auto& seg : contour.getSegments()) {
+            h.addInt(static_cast<int64_t>(seg.type));
+            h.addInt(snap(seg.x, grid) - ax).addInt(snap(seg.y, grid) - ay);
+            if (seg.type == ContourSegmentType::Arc) {
+                h.addInt(snap(seg.xc, grid) - ax).addInt(snap(seg.yc, grid) - ay).add(seg.clockwise);
+            }
+        }
+    }
+}
+
+// Helper to get the point a feature is placed by (line/arc start, pad and
+// text position, first contour start)
+Point2D anchorOf(const FeatureStore& store, size_t index) {
+    uint32_t row = store.getRow(index);
+    switch (store.getType(index)) {
+        case FeatureType::Line:
+            return {store.getLines().xs[row], store.getLines().ys[row]};
+        case FeatureType::Pad:
+            return {store.getPads().x[row], store.getPads().y[row]};
+        case FeatureType::Arc:
+            return {store.getArcs().xs[row], store.getArcs().ys[row]};
+        default:
+            break;
+    }
+    const Feature* object = store.getObject(row);
+    if (const auto* surface = dynamic_cast<const SurfaceFeature*>(object)) {
+        return surface->getContours().empty() ? Point2D() : surface->getContours()[0].getStart();
+    }
+    if (const auto* text = dynamic_cast<const TextFeature*>(object)) return text->getPosition();
+    if (const auto* barcode = dynamic_cast<const BarcodeFeature*>(object)) return barcode->getPosition();
+    return {};
+}
+
+// Helper to add a symbol name and, for a user symbol, its content hash
+void addSymbol(Hasher& h, const std::string& name, const SymbolHashes* symbols) {
+    h.add(name);
+    if (!symbols) return;
+    auto it = symbols->find(name);
+    if (it != symbols->end()) h.add(it->second);
+}
+
+/// Content hashes of one feature
+struct FeatureHash {
+    uint64_t shape = 0;     ///< Everything but the anchor position
+    uint64_t place = 0;     ///< Shape plus the anchor position
+};
+
+// Helper to hash one feature; geometry is snapped to the grid and taken
+// relative to the anchor for the shape hash
+FeatureHash hashFeature(const FeatureStore& store, size_t index, double grid, const SymbolHashes* symbols) {
+    Hasher h;
+    FeatureType type = store.getType(index);
+    h.addInt(static_cast<int64_t>(type));
+    h.addInt(static_cast<int64_t>(store.getPolarity(index)));
+    h.addInt(store.getDcode(index));
+    h.add(store.getNets().get(store.getNet(index)));
+    h.add(hashAttributes(store.getAttributes(index)));
+
+    Point2D anchor = anchorOf(store, index);
+    int64_t ax = snap(anchor.x, grid), ay = snap(anchor.y, grid);
+    uint32_t row = store.getRow(index);
+    switch (type) {
+        case FeatureType::Line: {
+            const auto& c = store.getLines();
+            addSymbol(h, store.getSymbols().get(c.symbol[row]), symbols);
+            h.addInt(snap(c.xe[row], grid) - ax).addInt(snap(c.ye[row], grid) - ay);
+            break;
+        }
+        case FeatureType::Pad: {
+            const auto& c = store.getPads();
+            addSymbol(h, store.getSymbols().get(c.symbol[row]), symbols);
+            h.addInt(snap(c.rotation[row], kValueGrid)).add(c.flags[row]);
+            if (c.flags[row] & FeatureStore::PadResize) h.addInt(snap(c.resize[row], kValueGrid));
+            break;
+        }
+        case FeatureType::Arc: {
+            const auto& c = store.getArcs();
+            addSymbol(h, store.getSymbols().get(c.symbol[row]), symbols);
+            h.addInt(snap(c.xe[row], grid) - ax).addInt(snap(c.ye[row], grid) - ay);
+            h.addInt(snap(c.xc[row], grid) - ax).addInt(snap(c.yc[row], grid) - ay);
+            h.add(c.clockwise[row]);
+            break;
+        }
+        default: {
+            const Feature* object = store.getObject(row);
+            if (const auto* surface = dynamic_cast<const SurfaceFeature*>(object)) {
+                addContours(h, surface->getContours(), ax, ay, grid);
+            } else if (const auto* text = dynamic_cast<const TextFeature*>(object)) {
+                h.add(text->getText()).add(text->getFont());
+                h.addInt(snap(text->getXSize(), grid)).addInt(snap(text->getYSize(), grid));
+                h.addInt(snap(text->getWidthFactor(), kValueGrid)).addInt(snap(text->getRotation(), kValueGrid));
+                h.add(text->isMirrored()).addInt(text->getVersion());
+            } else if (const auto* barcode = dynamic_cast<const BarcodeFeature*>(object)) {
+                h.add(barcode->getBarcodeType()).add(barcode->getFont()).add(barcode->getText());
+                h.addInt(snap(barcode->getRotation(), kValueGrid)).add(barcode->isMirrored());
+                h.addInt(snap(barcode->getElementWidth(), grid)).addInt(snap(barcode->getHeight(), grid));
+                h.add(barcode->isFullAscii()).add(barcode->hasChecksum()).add(barcode->hasInvertedBackground());
+                h.add(barcode->hasAdditionalString()).add(barcode->isStringOnTop());
+            }
+            break;
+        }
+    }
+
+    FeatureHash hash;
+    hash.shape = h.get();
+    hash.place = h.addInt(ax).addInt(ay).get();
+    return hash;
+}
+
+// Helper to hash every feature of a layer in parallel; returns the layer
+// hash (units, attributes and the order-free sum of placement hashes)
+uint64_t hashFeatures(const Layer& layer, double grid, size_t threads, const SymbolHashes* symbols,
+                      std::vector<FeatureHash>& hashes) {
+    LayerCache::Pin pin = layer.pin();
+    const FeatureStore& store = layer.getFeatures();
+    hashes.resize(store.size());
+    std::vector<uint64_t> sums(util::blockCount(store.size(), kBlockSize), 0);
+    util::parallelForBlocks(store.size(), kBlockSize, [&](size_t block, size_t first, size_t last) {
+        uint64_t sum = 0;
+        for (size_t i = first; i < last; ++i) {
+            hashes[i] = hashFeature(store, i, grid, symbols);
+            sum += hashes[i].place;
+        }
+        sums[block] = sum;
+    }, threads);
+    uint64_t sum = 0;
+    for (uint64_t s : sums) sum += s;
+    return Hasher().add(layer.getUnits()).add(hashAttributes(layer.getAttributes()))
+        .add(store.size()).add(sum).get();
+}
+
+// Helper to hash one user symbol (units, attributes and the order-free sum
+// of its feature hashes); user symbols it places are hashed first
+uint64_t hashSymbol(const SymbolLibrary& library, const Symbol& symbol, double grid, size_t depth,
+                    SymbolHashes& done) {
+    auto found = done.find(symbol.getName());
+    if (found != done.end()) return found->second;
+
+    FeatureStore store;
+    for (const auto& feature : symbol.getFeatures()) store.add(feature->clone());
+    SymbolHashes nested;
+    if (depth < kMaxUserDepth) {
+        for (const auto& name : store.getSymbols().getStrings()) {
+            if (const Symbol* child = library.getSymbol(name)) {
+                nested[name] = hashSymbol(library, *child, grid, depth + 1, done);
+            }
+        }
+    }
+    uint64_t sum = 0;
+    for (size_t i = 0; i < store.size(); ++i) sum += hashFeature(store, i, grid, &nested).place;
+    uint64_t hash = Hasher().add(static_cast<uint64_t>(symbol.getUnit()))
+        .add(hashAttributes(symbol.getAttributes())).add(store.size()).add(sum).get();
+    done.emplace(symbol.getName(), hash);
+    return hash;
+}
+
+// Helper to hash every user symbol of a library by name
+SymbolHashes symbolHashes(const SymbolLibrary& library, double grid) {
+    SymbolHashes hashes;
+    for (const auto& name : library.getSymbolNames()) {
+        if (const Symbol* symbol = library.getSymbol(name)) hashSymbol(library, *symbol, grid, 0, hashes);
+    }
+    return hashes;
+}
+
+// Helper to pair equal keys of two sorted (key, index) lists; unpaired
+// indices go to the leftover lists
+template<typename Fn>
+void pairSorted(const std::vector<std::pair<uint64_t, size_t>>& a,
+                const std::vector<std::pair<uint64_t, size_t>>& b,
+                std::vector<size_t>& leftA, std::vector<size_t>& leftB, Fn&& paired) {
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (a[i].first == b[j].first) {
+            paired(a[i].second, b[j].second);
+            ++i;
+            ++j;
+        } else if (a[i].first < b[j].first) {
+            leftA.push_back(a[i++].second);
+        } else {
+            leftB.push_back(b[j++].second);
+        }
+    }
+    for (; i < a.size(); ++i) leftA.push_back(a[i].second);
+    for (; j < b.size(); ++j) leftB.push_back(b[j].second);
+}
+
+// Helper to match the features of a changed layer
+void matchFeatures(const Layer& before, const Layer& after,
+                   const std::vector<FeatureHash>& hashBefore, const std::vector<FeatureHash>& hashAfter,
+                   bool matchMoves, JobDiff::LayerDiff& diff) {
+    auto keyed = [](const std::vector<FeatureHash>& hashes, const std::vector<size_t>* subset, bool shape) {
+        std::vector<std::pair<uint64_t, size_t>> keys;
+        size_t count = subset ? subset->size() : hashes.size();
+        keys.reserve(count);
+        for (size_t k = 0; k < count; ++k) {
+            size_t i = subset ? (*subset)[k] : k;
+            keys.emplace_back(shape ? hashes[i].shape : hashes[i].place, i);
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+
+    std::vector<size_t> removed, added;
+    pairSorted(keyed(hashBefore, nullptr, false), keyed(hashAfter, nullptr, false), removed, added,
+               [](size_t, size_t) {});
+    if (matchMoves && !removed.empty() && !added.empty()) {
+        auto shapesBefore = keyed(hashBefore, &removed, true);
+        auto shapesAfter = keyed(hashAfter, &added, true);
+        removed.clear();
+        added.clear();
+        pairSorted(shapesBefore, shapesAfter, removed, added, [&](size_t i, size_t j) {
+            Point2D from = anchorOf(before.getFeatures(), i);
+            Point2D to = anchorOf(after.getFeatures(), j);
+            diff.moved.push_back({i, j, {to.x - from.x, to.y - from.y}});
+        });
+    }
+    std::sort(removed.begin(), removed.end());
+    std::sort(added.begin(), added.end());
+    std::sort(diff.moved.begin(), diff.moved.end(),
+              [](const JobDiff::FeatureMove& a, const JobDiff::FeatureMove& b) { return a.before < b.before; });
+    diff.removed = std::move(removed);
+    diff.added = std::move(added);
+}
+
+// Helper to compare two keyed hash tables into sorted item diffs
+void diffItems(const std::map<std::string, uint64_t>& before, const std::map<std::string, uint64_t>& after,
+               std::vector<JobDiff::ItemDiff>& out) {
+    auto a = before.begin();
+    auto b = after.begin();
+    while (a != before.end() || b != after.end()) {
+        if (b == after.end() || (a != before.end() && a->first < b->first)) {
+            out.push_back({a->first, JobDiff::ChangeType::Removed});
+            ++a;
+        } else if (a == before.end() || b->first < a->first) {
+            out.push_back({b->first, JobDiff::ChangeType::Added});
+            ++b;
+        } else {
+            if (a->second != b->second) out.push_back({a->first, JobDiff::ChangeType::Changed});
+            ++a;
+            ++b;
+        }
+    }
+}
+
+// Helper to hash each component of a step by reference designator
+std::map<std::string, uint64_t> componentHashes(const EdaData& eda, double grid) {
+    std::map<std::string, uint64_t> hashes;
+    for (const auto& component : eda.getComponents()) {
+        Hasher h;
+        Point2D position = component->getPosition();
+        h.add(component->getPartNumber()).add(component->getPackageName()).add(component->getComponentName());
+        h.addInt(snap(position.x, grid)).addInt(snap(position.y, grid));
+        h.addInt(snap(component->getRotation(), kValueGrid)).add(component->isMirrored());
+        h.addInt(static_cast<int64_t>(component->getSide()));
+        h.add(hashAttributes(component->getAttributes()));
+        h.add(component->getPins().size());
+        for (const auto& pin : component->getPins()) {
+            h.add(pin.name).add(pin.netName).addInt(static_cast<int64_t>(pin.type));
+            h.addInt(snap(pin.x, grid)).addInt(snap(pin.y, grid));
+            h.addInt(snap(pin.rotation, kValueGrid)).add(pin.mirror).add(pin.padstackName);
+        }
+        hashes.emplace(component->getRefDes(), h.get());
+    }
+    return hashes;
+}
+
+// Helper to hash each net of a step by name (pins and subnets in any order);
+// subnets count by type and size, as their feature IDs are renumbered
+std::map<std::string, uint64_t> netHashes(const EdaData& eda) {
+    std::map<std::string, uint64_t> hashes;
+    for (const auto& net : eda.getNets()) {
+        Hasher h;
+        h.addInt(static_cast<int64_t>(net->getNetClass()));
+        h.add(hashAttributes(net->getAttributes()));
+        uint64_t pins = 0;
+        for (const auto& pin : net->getPins()) pins += Hasher().add(pin.refDes).add(pin.pinName).get();
+        h.add(net->getPins().size()).add(pins);
+        uint64_t subnets = 0;
+        for (const auto& subnet : net->getSubnets()) {
+            subnets += Hasher().addInt(static_cast<int64_t>(subnet.type)).add(subnet.featureIds.size()).get();
+        }
+        h.add(net->getSubnets().size()).add(subnets);
+        hashes.emplace(net->getName(), h.get());
+    }
+    return hashes;
+}
+
+// Helper to hash the stackup by layer name (repeated names hash in order)
+std::map<std::string, uint64_t> stackupHashes(const OdbJob& job) {
+    std::map<std::string, uint64_t> hashes;
+    for (const auto& layer : job.getStackup()) {
+        Hasher h;
+        h.add(hashes[layer.name]);
+        h.addInt(static_cast<int64_t>(layer.materialType)).add(layer.material).addInt(layer.layerIndex);
+        h.addInt(snap(layer.thickness, kValueGrid)).addInt(snap(layer.dielectricConstant, kValueGrid));
+        h.addInt(snap(layer.lossTangent, kValueGrid)).add(hashAttributes(layer.properties));
+        hashes[layer.name] = h.get();
+    }
+    return hashes;
+}
+
+// Helper to hash the matrix layer definitions by name
+std::map<std::string, uint64_t> matrixHashes(const OdbJob& job) {
+    std::map<std::string, uint64_t> hashes;
+    for (const auto& def : job.getMatrix().getLayerDefinitions()) {
+        Hasher h;
+        h.addInt(static_cast<int64_t>(def.type)).addInt(static_cast<int64_t>(def.context));
+        h.addInt(static_cast<int64_t>(def.polarity)).addInt(static_cast<int64_t>(def.side));
+        h.addInt(def.row).add(def.startName).add(def.endName);
+        h.addInt(snap(def.thickness, kValueGrid));
+        hashes[def.name] = h.get();
+    }
+    return hashes;
+}
+
+// Helper to hash a step profile
+uint64_t profileHash(const Step& step, double grid) {
+    Hasher h;
+    addContours(h, step.getProfile(), 0, 0, grid);
+    return h.get();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Result
+// ============================================================================
+
+std::vector<std::string> JobDiff::StepDiff::getChangedLayers() const {
+    std::vector<std::string> names;
+    for (const auto& layer : layers) {
+        if (layer.change != ChangeType::Unchanged) names.push_back(layer.name);
+    }
+    return names;
+}
+
+bool JobDiff::Result::isIdentical() const {
+    if (!symbols.empty() || !stackup.empty() || !matrix.empty()) return false;
+    return std::all_of(steps.begin(), steps.end(),
+                       [](const StepDiff& step) { return step.change == ChangeType::Unchanged; });
+}
+
+// ============================================================================
+// JobDiff
+// ============================================================================
+
+JobDiff::JobDiff(const OdbJob& before, const OdbJob& after)
+    : before_(before), after_(after) {}
+
+uint64_t JobDiff::hashLayer(const Layer& layer, double tolerance, size_t threads,
+                           const SymbolLibrary* symbols) {
+    std::vector<FeatureHash> hashes;
+    if (!symbols) return hashFeatures(layer, tolerance, threads, nullptr, hashes);
+    SymbolHashes symbolTable = symbolHashes(*symbols, tolerance);
+    return hashFeatures(layer, tolerance, threads, &symbolTable, hashes);
+}
+
+JobDiff::Result JobDiff::compare(const Options& options) const {
+    Result result;
+    size_t threads = util::resolveThreadCount(options.threads);
+    double grid = options.tolerance > 0.0 ? options.tolerance : 1e-6;
+
+    // ========== User symbols, mixed into the features that place them ==========
+
+    SymbolHashes symbolsBefore = symbolHashes(before_.getSymbolLibrary(), grid);
+    SymbolHashes symbolsAfter = symbolHashes(after_.getSymbolLibrary(), grid);
+    diffItems(symbolsBefore, symbolsAfter, result.symbols);
+
+    // ========== Steps and layers, by name ==========
+
+    std::set<std::string> stepNames;
+    for (const auto& [name, step] : before_.getSteps()) stepNames.insert(name);
+    for (const auto& [name, step] : after_.getSteps()) stepNames.insert(name);
+
+    /// A layer pair waiting for its feature match
+    struct Pending {
+        const Layer* before = nullptr;
+        const Layer* after = nullptr;
+        LayerDiff* diff = nullptr;
+        std::vector<FeatureHash> hashBefore, hashAfter;
+    };
+    std::vector<Pending> pending;
+
+    for (const auto& name : stepNames) {
+        StepDiff stepDiff;
+        stepDiff.name = name;
+        const Step* before = before_.getStep(name);
+        const Step* after = after_.getStep(name);
+        std::set<std::string> layerNames;
+        if (before) for (const auto& [layer, object] : before->getLayers()) layerNames.insert(layer);
+        if (after) for (const auto& [layer, object] : after->getLayers()) layerNames.insert(layer);
+        for (const auto& layer : layerNames) {
+            LayerDiff layerDiff;
+            layerDiff.name = layer;
+            Pending work;
+            work.before = before ? before->getLayer(layer) : nullptr;
+            work.after = after ? after->getLayer(layer) : nullptr;
+            if (work.before) {
+                layerDiff.hashBefore = hashFeatures(*work.before, grid, threads, &symbolsBefore, work.hashBefore);
+            }
+            if (work.after) {
+                layerDiff.hashAfter = hashFeatures(*work.after, grid, threads, &symbolsAfter, work.hashAfter);
+            }
+            if (!work.before) {
+                layerDiff.change = ChangeType::Added;
+                for (size_t i = 0; i < work.hashAfter.size(); ++i) layerDiff.added.push_back(i);
+            } else if (!work.after) {
+                layerDiff.change = ChangeType::Removed;
+                for (size_t i = 0; i < work.hashBefore.size(); ++i) layerDiff.removed.push_back(i);
+            } else if (layerDiff.hashBefore != layerDiff.hashAfter) {
+                layerDiff.change = ChangeType::Changed;
+            }
+            stepDiff.layers.push_back(std::move(layerDiff));
+            if (stepDiff.layers.back().change == ChangeType::Changed) pending.push_back(std::move(work));
+        }
+
+        if (before && after) {
+            diffItems(componentHashes(before->getEdaData(), grid), componentHashes(after->getEdaData(), grid),
+                      stepDiff.components);
+            diffItems(netHashes(before->getEdaData()), netHashes(after->getEdaData()), stepDiff.nets);
+            stepDiff.profileChanged = profileHash(*before, grid) != profileHash(*after, grid);
+            bool changed = stepDiff.profileChanged || !stepDiff.components.empty() || !stepDiff.nets.empty() ||
+                           !stepDiff.getChangedLayers().empty();
+            stepDiff.change = changed ? ChangeType::Changed : ChangeType::Unchanged;
+        } else {
+            stepDiff.change = before ? ChangeType::Removed : ChangeType::Added;
+        }
+        result.steps.push_back(std::move(stepDiff));
+    }
+
+    // Layer diffs are only pointed to once every step is in place
+    size_t next = 0;
+    for (auto& step : result.steps) {
+        for (auto& layer : step.layers) {
+            if (layer.change == ChangeType::Changed) pending[next++].diff = &layer;
+        }
+    }
+
+    // ========== Feature matching, one changed layer per task ==========
+
+    util::parallelFor(pending.size(), [&](size_t k) {
+        Pending& work = pending[k];
+        // Other tasks load their layers meanwhile; keep this pair resident
+        LayerCache::Pin pinBefore = work.before->pin();
+        LayerCache::Pin pinAfter = work.after->pin();
+        matchFeatures(*work.before, *work.after, work.hashBefore, work.hashAfter, options.matchMoves, *work.diff);
+    }, threads);
+
+    // ========== Job tables ==========
+
+    diffItems(stackupHashes(before_), stackupHashes(after_), result.stackup);
+    diffItems(matrixHashes(before_), matrixHashes(after_), result.matrix);
+    return result;
+}
+
+} // namespace koo::ecad
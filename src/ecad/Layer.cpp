@@ -1,4 +1,6 @@
 #include <koo/ecad/Layer.hpp>
+#include <koo/ecad/LayerCache.hpp>
+#include <koo/ecad/Symbol.hpp>
 #include <algorithm>
 
 namespace koo::ecad {
@@ -9,59 +11,46 @@ namespace koo::ecad {
 
 Layer::Layer(const std::string& name) : name_(name) {}
 
+Layer::~Layer() {
+    if (cacheEntry_) {
+        cacheEntry_->cache->detach(*cacheEntry_, false);
+    }
+}
+
 void Layer::addFeature(std::unique_ptr<Feature> feature) {
     if (feature) {
-        features_.push_back(std::move(feature));
+        getFeatures().add(std::move(feature));
+        invalidateIndex();
     }
 }
 
 void Layer::removeFeature(size_t index) {
-    if (index < features_.size()) {
-        features_.erase(features_.begin() + static_cast<std::ptrdiff_t>(index));
-    }
+    getFeatures().remove(index);
+    invalidateIndex();
 }
 
 void Layer::clearFeatures() {
-    features_.clear();
+    getFeatures().clear();
+    invalidateIndex();
 }
 
-Feature* Layer::getFeature(size_t index) {
-    return (index < features_.size()) ? features_[index].get() : nullptr;
+std::unique_ptr<Feature> Layer::getFeature(size_t index) const {
+    const FeatureStore& features = getFeatures();
+    return (index < features.size()) ? features[index].materialize() : nullptr;
 }
 
-const Feature* Layer::getFeature(size_t index) const {
-    return (index < features_.size()) ? features_[index].get() : nullptr;
-}
-
-std::vector<Feature*> Layer::getFeaturesByNet(const std::string& netName) {
-    std::vector<Feature*> result;
-    for (const auto& f : features_) {
-        if (f->getNetName() == netName) {
-            result.push_back(f.get());
-        }
-    }
-    return result;
+std::vector<size_t> Layer::getFeaturesByNet(const std::string& netName) const {
+    size_t count = 0;
+    const uint32_t* indices = netFeatures(getFeatures().getNets().find(netName), count);
+    return std::vector<size_t>(indices, indices + count);
 }
 
-std::vector<Feature*> Layer::getFeaturesInArea(const BoundingBox2D& area) {
-    std::vector<Feature*> result;
-    for (const auto& f : features_) {
-        BoundingBox2D box = f->getBoundingBox();
-        // Check if bounding boxes overlap
-        if (box.min.x <= area.max.x && box.max.x >= area.min.x &&
-            box.min.y <= area.max.y && box.max.y >= area.min.y) {
-            result.push_back(f.get());
-        }
-    }
-    return result;
+BoundingBox2D Layer::getBoundingBox() const {
+    return getFeatures().getBoundingBox();
 }
 
-BoundingBox2D Layer::getBoundingBox() const {
-    BoundingBox2D box;
-    for (const auto& f : features_) {
-        box.expand(f->getBoundingBox());
-    }
-    return box;
+BoundingBox2D Layer::getExtent() const {
+    return getSpatialIndex().getBounds();
 }
 
 void Layer::addProfileContour(const Contour& contour) {
@@ -73,6 +62,7 @@ void Layer::addSymbolName(const std::string& name) {
 }
 
 std::string Layer::getSymbolName(int index) const {
+    if (cacheEntry_) loadMetadata();
     if (index >= 0 && static_cast<size_t>(index) < symbolNames_.size()) {
         return symbolNames_[static_cast<size_t>(index)];
     }
@@ -80,6 +70,7 @@ std::string Layer::getSymbolName(int index) const {
 }
 
 int Layer::getSymbolIndex(const std::string& name) const {
+    if (cacheEntry_) loadMetadata();
     for (size_t i = 0; i < symbolNames_.size(); ++i) {
         if (symbolNames_[i] == name) {
             return static_cast<int>(i);
@@ -88,25 +79,150 @@ int Layer::getSymbolIndex(const std::string& name) const {
     return -1;
 }
 
+// ============================================================================
+// Layer - Indices
+// ============================================================================
+
+const SpatialIndex& Layer::getSpatialIndex() const {
+    const FeatureStore& features = getFeatures();
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    if (!spatialIndex_) {
+        SymbolCache ownSymbols;
+        const SymbolCache& symbols = symbolCache_ ? *symbolCache_ : ownSymbols;
+        features.computeExtents(symbols.resolve(features.getSymbols(), units_), extents_);
+        spatialIndex_ = std::make_unique<SpatialIndex>(extents_);
+    }
+    return *spatialIndex_;
+}
+
+void Layer::setSymbolCache(const SymbolCache* symbols) {
+    if (symbols == symbolCache_) return;
+    symbolCache_ = symbols;
+    invalidateIndex();
+}
+
+const std::vector<BoundingBox2D>& Layer::getFeatureExtents() const {
+    getSpatialIndex();
+    return extents_;
+}
+
+void Layer::invalidateIndex() {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    spatialIndex_.reset();
+    extents_.clear();
+    netOffsets_.clear();
+    netFeatures_.clear();
+}
+
+const uint32_t* Layer::netFeatures(int32_t net, size_t& count) const {
+    count = 0;
+    if (net < 0) {
+        return nullptr;
+    }
+
+    const FeatureStore& features = getFeatures();
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    if (netOffsets_.empty()) {
+        // Counting sort of feature indices by net (CSR layout)
+        size_t netCount = features.getNets().size();
+        netOffsets_.assign(netCount + 1, 0);
+        for (size_t i = 0; i < features.size(); ++i) {
+            if (features.getNet(i) >= 0) {
+                ++netOffsets_[static_cast<size_t>(features.getNet(i)) + 1];
+            }
+        }
+        for (size_t n = 0; n < netCount; ++n) {
+            netOffsets_[n + 1] += netOffsets_[n];
+        }
+        netFeatures_.resize(netOffsets_[netCount]);
+        std::vector<uint32_t> next(netOffsets_.begin(), netOffsets_.end() - 1);
+        for (size_t i = 0; i < features.size(); ++i) {
+            if (features.getNet(i) >= 0) {
+                netFeatures_[next[static_cast<size_t>(features.getNet(i))]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+
+    auto n = static_cast<size_t>(net);
+    if (n + 1 >= netOffsets_.size()) {
+        return nullptr;
+    }
+    count = netOffsets_[n + 1] - netOffsets_[n];
+    return netFeatures_.data() + netOffsets_[n];
+}
+
+// ============================================================================
+// Layer - Cache
+// ============================================================================
+
+bool Layer::isResident() const {
+    return !cacheEntry_ || cacheEntry_->resident.load(std::memory_order_acquire);
+}
+
+void Layer::loadFeatures() const {
+    cacheEntry_->cache->acquire(*cacheEntry_);
+}
+
+void Layer::loadMetadata() const {
+    if (!cacheEntry_->loaded.load(std::memory_order_acquire)) {
+        cacheEntry_->cache->acquire(*cacheEntry_);
+    }
+}
+
+void Layer::detachFromCache() {
+    cacheEntry_->cache->detach(*cacheEntry_, true);
+}
+
+LayerCache::Pin Layer::pin() const {
+    return cacheEntry_ ? cacheEntry_->cache->pin(*this) : LayerCache::Pin();
+}
+
+// ============================================================================
+// Layer - Spatial Queries
+// ============================================================================
+
+std::vector<size_t> Layer::getFeaturesInArea(const BoundingBox2D& area) const {
+    return getSpatialIndex().query(area);
+}
+
+std::vector<size_t> Layer::getFeaturesAt(const Point2D& point) const {
+    return getSpatialIndex().queryPoint(point);
+}
+
+size_t Layer::getNearestFeature(const Point2D& point, double* distance) const {
+    return getSpatialIndex().nearest(point, distance);
+}
+
+std::vector<std::vector<size_t>> Layer::getFeaturesInAreas(const std::vector<BoundingBox2D>& areas,
+                                                           size_t threads) const {
+    return getSpatialIndex().queryBatch(areas, threads);
+}
+
 // ============================================================================
 // CopperLayer
 // ============================================================================
 
-std::vector<LineFeature*> CopperLayer::getTracesOnNet(const std::string& netName) {
-    std::vector<LineFeature*> result;
-    for (const auto& f : features_) {
-        if (f->getType() == FeatureType::Line && f->getNetName() == netName) {
-            result.push_back(static_cast<LineFeature*>(f.get()));
+std::vector<size_t> CopperLayer::getTracesOnNet(const std::string& netName) const {
+    std::vector<size_t> result;
+    size_t count = 0;
+    const FeatureStore& features = getFeatures();
+    const uint32_t* indices = netFeatures(features.getNets().find(netName), count);
+    for (size_t k = 0; k < count; ++k) {
+        if (features.getType(indices[k]) == FeatureType::Line) {
+            result.push_back(indices[k]);
         }
     }
     return result;
 }
 
-std::vector<PadFeature*> CopperLayer::getPadsOnNet(const std::string& netName) {
-    std::vector<PadFeature*> result;
-    for (const auto& f : features_) {
-        if (f->getType() == FeatureType::Pad && f->getNetName() == netName) {
-            result.push_back(static_cast<PadFeature*>(f.get()));
+std::vector<size_t> CopperLayer::getPadsOnNet(const std::string& netName) const {
+    std::vector<size_t> result;
+    size_t count = 0;
+    const FeatureStore& features = getFeatures();
+    const uint32_t* indices = netFeatures(features.getNets().find(netName), count);
+    for (size_t k = 0; k < count; ++k) {
+        if (features.getType(indices[k]) == FeatureType::Pad) {
+            result.push_back(indices[k]);
         }
     }
     return result;
@@ -124,12 +240,11 @@ std::unordered_map<double, int> DrillLayer::getDrillSizeHistogram() const {
     std::unordered_map<double, int> histogram;
 
     // Count from features
-    for (const auto& f : features_) {
-        if (f->getType() == FeatureType::Pad) {
-            // For drill layers, pad symbol typically indicates drill size
-            // This is a simplified implementation - actual size comes from symbol
-            histogram[1.0]++;  // Placeholder
-        }
+    const FeatureStore& features = getFeatures();
+    if (!features.getPads().x.empty()) {
+        // For drill layers, pad symbol typically indicates drill size
+        // This is a simplified implementation - actual size comes from symbol
+        histogram[1.0] += static_cast<int>(features.getPads().x.size());  // Placeholder
     }
 
     // Also use tool definitions
@@ -0,0 +1,173 @@
+#include <koo/ecad/LayerCache.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <algorithm>
+
+namespace koo::ecad {
+
+// ============================================================================
+// LayerCache::Pin
+// ============================================================================
+
+LayerCache::Pin::~Pin() {
+    if (entry_) {
+        // Over-budget layers are evicted by the next load
+        std::lock_guard<std::mutex> lock(entry_->cache->mutex_);
+        --entry_->pins;
+    }
+}
+
+LayerCache::Pin& LayerCache::Pin::operator=(Pin&& other) noexcept {
+    if (this != &other) {
+        Pin released(std::move(*this));
+        entry_ = other.entry_;
+        other.entry_ = nullptr;
+    }
+    return *this;
+}
+
+// ============================================================================
+// LayerCache
+// ============================================================================
+
+LayerCache::LayerCache(Loader loader, size_t byteBudget)
+    : loader_(std::move(loader)), byteBudget_(byteBudget) {}
+
+LayerCache::~LayerCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : entries_) {
+        entry.layer->cacheEntry_ = nullptr;
+    }
+}
+
+void LayerCache::attach(Layer& layer, const std::string& source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.emplace_back();
+    LayerCacheEntry& entry = entries_.back();
+    entry.cache = this;
+    entry.layer = &layer;
+    entry.source = source;
+    layer.cacheEntry_ = &entry;
+}
+
+size_t LayerCache::getByteBudget() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byteBudget_;
+}
+
+void LayerCache::setByteBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    byteBudget_ = bytes;
+    evictLocked(nullptr);
+}
+
+LayerCache::Pin LayerCache::pin(const Layer& layer) {
+    LayerCacheEntry* entry = layer.cacheEntry_;
+    if (!entry || entry->cache != this) {
+        return Pin();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++entry->pins;
+    loadLocked(*entry);
+    entry->lastUse.store(++clock_, std::memory_order_relaxed);
+    evictLocked(entry);
+    return Pin(entry);
+}
+
+void LayerCache::evictAll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : entries_) {
+        if (entry.pins == 0 && entry.resident.load(std::memory_order_relaxed)) {
+            dropLocked(entry);
+        }
+    }
+}
+
+LayerCache::Statistics LayerCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Statistics stats;
+    stats.layers = entries_.size();
+    for (const auto& entry : entries_) {
+        if (entry.resident.load(std::memory_order_relaxed)) {
+            ++stats.residentLayers;
+        }
+    }
+    stats.residentBytes = residentBytes_;
+    stats.loads = loads_;
+    stats.evictions = evictions_;
+    return stats;
+}
+
+void LayerCache::acquire(LayerCacheEntry& entry) {
+    // Resident layers only record the access
+    if (!entry.resident.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loadLocked(entry);
+        entry.lastUse.store(++clock_, std::memory_order_relaxed);
+        evictLocked(&entry);
+        return;
+    }
+    entry.lastUse.store(++clock_, std::memory_order_relaxed);
+}
+
+void LayerCache::detach(LayerCacheEntry& entry, bool load) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (load) {
+        loadLocked(entry);
+    }
+    if (entry.resident.load(std::memory_order_relaxed)) {
+        residentBytes_ -= entry.bytes;
+    }
+    entry.layer->cacheEntry_ = nullptr;
+    entries_.remove_if([&entry](const LayerCacheEntry& e) { return &e == &entry; });
+}
+
+void LayerCache::loadLocked(LayerCacheEntry& entry) {
+    if (entry.resident.load(std::memory_order_relaxed)) return;
+
+    // Parse into a scratch layer, then move the results over
+    Layer scratch(entry.layer->getName());
+    loader_(entry.source, scratch);
+
+    Layer& layer = *entry.layer;
+    layer.features_ = std::move(scratch.features_);
+    layer.units_ = scratch.units_;
+    layer.symbolNames_ = std::move(scratch.symbolNames_);
+    layer.invalidateIndex();
+
+    entry.bytes = layer.features_.getMemoryUsage();
+    residentBytes_ += entry.bytes;
+    ++loads_;
+    entry.loaded.store(true, std::memory_order_release);
+    entry.resident.store(true, std::memory_order_release);
+}
+
+void LayerCache::evictLocked(const LayerCacheEntry* keep) {
+    if (byteBudget_ == 0) return;
+
+    while (residentBytes_ > byteBudget_) {
+        LayerCacheEntry* victim = nullptr;
+        for (auto& entry : entries_) {
+            if (&entry == keep || entry.pins > 0 || !entry.resident.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            if (!victim || entry.lastUse.load(std::memory_order_relaxed) <
+                           victim->lastUse.load(std::memory_order_relaxed)) {
+                victim = &entry;
+            }
+        }
+        if (!victim) break;
+        dropLocked(*victim);
+    }
+}
+
+void LayerCache::dropLocked(LayerCacheEntry& entry) {
+    entry.resident.store(false, std::memory_order_release);
+    entry.layer->features_ = FeatureStore();
+    entry.layer->invalidateIndex();
+    residentBytes_ -= entry.bytes;
+    entry.bytes = 0;
+    ++evictions_;
+}
+
+} // namespace koo::ecad
@@ -0,0 +1,781 @@
+#include <koo/ecad/NetConnectivity.hpp>
+#include <koo/ecad/EdaData.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <koo/ecad/SpatialIndex.hpp>
+#include <koo/ecad/Step.hpp>
+#include <koo/ecad/Symbol.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBlockSize = 1024;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kArcStep = kPi / 16.0;     // Max sweep per flattened arc segment
+
+/// Symbol outline in layer units, centered on the origin
+struct SymbolShape {
+    enum class Kind { Point, Disc, Slot, Box };
+    Kind kind = Kind::Point;
+    double halfWidth = 0.0;
+    double halfHeight = 0.0;
+};
+
+/// Feature outline: a path (open) or rings (filled), grown by radius
+struct Shape {
+    std::vector<Point2D> points;
+    std::vector<uint32_t> rings;    ///< Ring start offsets plus end sentinel (filled shapes only)
+    double radius = 0.0;
+    bool filled = false;
+    BoundingBox2D box;              ///< Bounds including radius
+
+    void reset() {
+        points.clear();
+        rings.clear();
+        radius = 0.0;
+        filled = false;
+        box = BoundingBox2D();
+    }
+};
+
+/// One layer taking part in the extraction
+struct StackLayer {
+    const Layer* layer = nullptr;
+    bool drill = false;
+    size_t firstCopper = 0;         ///< Drill span over the copper layers, inclusive
+    size_t lastCopper = 0;
+    size_t offset = 0;              ///< First global feature
+    LayerCache::Pin pin;            ///< Keeps a cached layer resident for the whole build
+    std::vector<SymbolShape> symbols;
+    std::unordered_map<size_t, Shape> surfaces;
+    SpatialIndex index;
+    std::vector<size_t> negatives;  ///< Negative features, in drawing order
+    SpatialIndex negativeIndex;     ///< Over negatives
+};
+
+// Helper to tell whether a layer type carries copper
+bool isCopperType(LayerType type) {
+    return type == LayerType::Signal || type == LayerType::PowerGround || type == LayerType::Mixed;
+}
+
+// Helper to grow a box on every side
+BoundingBox2D inflate(BoundingBox2D box, double margin) {
+    box.min.x -= margin;
+    box.min.y -= margin;
+    box.max.x += margin;
+    box.max.y += margin;
+    return box;
+}
+
+// Helper to reduce cached symbol geometry to a contact shape
+SymbolShape resolveSymbol(const SymbolGeometry& geometry) {
+    SymbolShape shape;
+    if (!geometry.isValid()) {
+        return shape;
+    }
+    shape.halfWidth = geometry.bounds.max.x;
+    shape.halfHeight = geometry.bounds.max.y;
+    switch (geometry.getType()) {
+        case SymbolType::Round:
+        case SymbolType::Butterfly:
+        case SymbolType::RoundDonut:
+            shape.kind = SymbolShape::Kind::Disc;
+            break;
+        case SymbolType::Oblong:
+            shape.kind = SymbolShape::Kind::Slot;
+            break;
+        default:
+            shape.kind = SymbolShape::Kind::Box;
+            break;
+    }
+    return shape;
+}
+
+// Helper to give a line or arc its track radius
+double trackRadius(const StackLayer& stack, int32_t symbol) {
+    if (symbol < 0 || static_cast<size_t>(symbol) >= stack.symbols.size()) return 0.0;
+    const SymbolShape& s = stack.symbols[static_cast<size_t>(symbol)];
+    return s.kind == SymbolShape::Kind::Disc ? s.halfWidth : std::min(s.halfWidth, s.halfHeight);
+}
+
+// Helper to append a flattened arc (start point excluded)
+void appendArc(std::vector<Point2D>& points, const Point2D& start, const Point2D& end,
+               const Point2D& center, bool clockwise) {
+    double radius = std::hypot(start.x - center.x, start.y - center.y);
+    double a0 = std::atan2(start.y - center.y, start.x - center.x);
+    double a1 = std::atan2(end.y - center.y, end.x - center.x);
+    double sweep = clockwise ? a0 - a1 : a1 - a0;
+    while (sweep <= 0.0) sweep += 2.0 * kPi;   // Coincident ends: full circle
+    auto steps = static_cast<size_t>(std::ceil(sweep / kArcStep));
+    double step = (clockwise ? -sweep : sweep) / static_cast<double>(steps);
+    for (size_t k = 1; k < steps; ++k) {
+        double a = a0 + step * static_cast<double>(k);
+        points.push_back({center.x + radius * std::cos(a), center.y + radius * std::sin(a)});
+    }
+    points.push_back(end);
+}
+
+// Helper to flatten a surface's contours into rings; holes are filled
+// even-odd together with their islands
+Shape surfaceShape(const SurfaceFeature& surface) {
+    Shape shape;
+    shape.filled = true;
+    for (const auto& contour : surface.getContours()) {
+        shape.rings.push_back(static_cast<uint32_t>(shape.points.size()));
+        Point2D current = contour.getStart();
+        shape.points.push_back(current);
+        for (const auto& seg : contour.getSegments()) {
+            Point2D next{seg.x, seg.y};
+            if (seg.type == ContourSegmentType::Arc) {
+                appendArc(shape.points, current, next, {seg.xc, seg.yc}, seg.clockwise);
+            } else {
+                shape.points.push_back(next);
+            }
+            current = next;
+        }
+    }
+    shape.rings.push_back(static_cast<uint32_t>(shape.points.size()));
+    for (const auto& p : shape.points) shape.box.expand(p);
+    return shape;
+}
+
+// Helper to place a pad symbol: mirror in X, then rotate clockwise
+Point2D placePad(double x, double y, const Point2D& origin, double rotation, bool mirror) {
+    if (mirror) x = -x;
+    double rad = rotation * kPi / 180.0;
+    double c = std::cos(rad), s = std::sin(rad);
+    return {origin.x + x * c + y * s, origin.y - x * s + y * c};
+}
+
+// Helper to tell whether a feature draws copper of either polarity
+bool hasOutline(const FeatureStore& store, size_t index) {
+    FeatureType type = store.getType(index);
+    return type != FeatureType::Text && type != FeatureType::Barcode;
+}
+
+// Helper to tell whether a feature carries current
+bool conducts(const FeatureStore& store, size_t index) {
+    return store.getPolarity(index) != Polarity::Negative && hasOutline(store, index);
+}
+
+// Helper to get the outline of a feature of either polarity (nullptr for
+// text). Surfaces come from the layer cache; other features are built into
+// the scratch shape.
+const Shape* outline(const StackLayer& stack, size_t index, Shape& shape) {
+    const FeatureStore& store = stack.layer->getFeatures();
+    if (!hasOutline(store, index)) return nullptr;
+    if (store.getType(index) == FeatureType::Surface) {
+        auto it = stack.surfaces.find(index);
+        return it != stack.surfaces.end() ? &it->second : nullptr;
+    }
+
+    shape.reset();
+    uint32_t row = store.getRow(index);
+    switch (store.getType(index)) {
+        case FeatureType::Line: {
+            const auto& c = store.getLines();
+            shape.points = {{c.xs[row], c.ys[row]}, {c.xe[row], c.ye[row]}};
+            shape.radius = trackRadius(stack, c.symbol[row]);
+            break;
+        }
+        case FeatureType::Arc: {
+            const auto& c = store.getArcs();
+            Point2D start{c.xs[row], c.ys[row]};
+            shape.points.push_back(start);
+            appendArc(shape.points, start, {c.xe[row], c.ye[row]}, {c.xc[row], c.yc[row]},
+                      c.clockwise[row] != 0);
+            shape.radius = trackRadius(stack, c.symbol[row]);
+            break;
+        }
+        case FeatureType::Pad: {
+            const auto& c = store.getPads();
+            Point2D origin{c.x[row], c.y[row]};
+            int32_t symbol = c.symbol[row];
+            SymbolShape s;
+            if (symbol >= 0 && static_cast<size_t>(symbol) < stack.symbols.size()) {
+                s = stack.symbols[static_cast<size_t>(symbol)];
+            }
+            if ((c.flags[row] & FeatureStore::PadResize) && c.resize[row] > 0.0) {
+                s.halfWidth *= c.resize[row];
+                s.halfHeight *= c.resize[row];
+            }
+            double rotation = c.rotation[row];
+            bool mirror = (c.flags[row] & FeatureStore::PadMirror) != 0;
+            switch (s.kind) {
+                case SymbolShape::Kind::Point:
+                    shape.points = {origin};
+                    break;
+                case SymbolShape::Kind::Disc:
+                    shape.points = {origin};
+                    shape.radius = s.halfWidth;
+                    break;
+                case SymbolShape::Kind::Slot: {
+                    bool wide = s.halfWidth >= s.halfHeight;
+                    shape.radius = std::min(s.halfWidth, s.halfHeight);
+                    double half = std::max(s.halfWidth, s.halfHeight) - shape.radius;
+                    shape.points = {placePad(wide ? -half : 0.0, wide ? 0.0 : -half, origin, rotation, mirror),
+                                    placePad(wide ? half : 0.0, wide ? 0.0 : half, origin, rotation, mirror)};
+                    break;
+                }
+                case SymbolShape::Kind::Box:
+                    shape.filled = true;
+                    shape.points = {placePad(-s.halfWidth, -s.halfHeight, origin, rotation, mirror),
+                                    placePad(s.halfWidth, -s.halfHeight, origin, rotation, mirror),
+                                    placePad(s.halfWidth, s.halfHeight, origin, rotation, mirror),
+                                    placePad(-s.halfWidth, s.halfHeight, origin, rotation, mirror)};
+                    shape.rings = {0, 4};
+                    break;
+            }
+            break;
+        }
+        default:
+            return nullptr;
+    }
+
+    for (const auto& p : shape.points) shape.box.expand(p);
+    shape.box = inflate(shape.box, shape.radius);
+    return &shape;
+}
+
+// Helper to get the outline of a conducting feature (nullptr if it carries no current)
+const Shape* buildShape(const StackLayer& stack, size_t index, Shape& shape) {
+    return conducts(stack.layer->getFeatures(), index) ? outline(stack, index, shape) : nullptr;
+}
+
+double cross(const Point2D& o, const Point2D& a, const Point2D& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Helper for the point of a segment closest to p
+Point2D closestOnSegment(const Point2D& p, const Point2D& a, const Point2D& b) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double len2 = dx * dx + dy * dy;
+    double t = len2 > 0.0 ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / len2, 0.0, 1.0) : 0.0;
+    return {a.x + t * dx, a.y + t * dy};
+}
+
+// Helper for the squared distance from a point to a segment
+double pointSegmentDistance2(const Point2D& p, const Point2D& a, const Point2D& b) {
+    Point2D q = closestOnSegment(p, a, b);
+    double ex = q.x - p.x, ey = q.y - p.y;
+    return ex * ex + ey * ey;
+}
+
+// Helper to tell whether two segments properly cross
+bool segmentsCross(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+    double d1 = cross(c, d, a), d2 = cross(c, d, b);
+    double d3 = cross(a, b, c), d4 = cross(a, b, d);
+    return ((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+           ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0));
+}
+
+// Helper for the squared distance between two segments (0 if they cross)
+double segmentDistance2(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+    if (segmentsCross(a, b, c, d)) return 0.0;
+    return std::min({pointSegmentDistance2(a, c, d), pointSegmentDistance2(b, c, d),
+                     pointSegmentDistance2(c, a, b), pointSegmentDistance2(d, a, b)});
+}
+
+// Helper for the point where two segments meet: their crossing, or midway
+// between their closest points
+Point2D contactPoint(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+    if (segmentsCross(a, b, c, d)) {
+        double t = cross(c, d, a) / (cross(c, d, a) - cross(c, d, b));
+        return {a.x + t * (b.x - a.x), a.y + t * (b.y - a.y)};
+    }
+    std::pair<Point2D, Point2D> candidates[] = {
+        {a, closestOnSegment(a, c, d)}, {b, closestOnSegment(b, c, d)},
+        {closestOnSegment(c, a, b), c}, {closestOnSegment(d, a, b), d}};
+    const auto* best = &candidates[0];
+    double bestDistance2 = std::numeric_limits<double>::max();
+    for (const auto& candidate : candidates) {
+        double dx = candidate.first.x - candidate.second.x, dy = candidate.first.y - candidate.second.y;
+        if (dx * dx + dy * dy < bestDistance2) {
+            bestDistance2 = dx * dx + dy * dy;
+            best = &candidate;
+        }
+    }
+    return {(best->first.x + best->second.x) / 2.0, (best->first.y + best->second.y) / 2.0};
+}
+
+// Helper to test a point against the rings of a filled shape (even-odd over
+// all rings, so holes cut their islands)
+bool insideRings(const Point2D& p, const Shape& shape) {
+    bool inside = false;
+    for (size_t r = 0; r + 1 < shape.rings.size(); ++r) {
+        size_t begin = shape.rings[r], end = shape.rings[r + 1];
+        for (size_t i = begin, j = end - 1; i < end; j = i++) {
+            const Point2D& a = shape.points[i];
+            const Point2D& b = shape.points[j];
+            if ((a.y > p.y) != (b.y > p.y) &&
+                p.x < (b.x - a.x) * (p.y - a.y) / (b.y - a.y) + a.x) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+// Helper to call fn(a, b) for every edge of a shape until it returns true
+template<typename Fn>
+bool anyEdge(const Shape& shape, Fn&& fn) {
+    if (!shape.filled) {
+        if (shape.points.size() == 1) return fn(shape.points[0], shape.points[0]);
+        for (size_t i = 1; i < shape.points.size(); ++i) {
+            if (fn(shape.points[i - 1], shape.points[i])) return true;
+        }
+        return false;
+    }
+    for (size_t r = 0; r + 1 < shape.rings.size(); ++r) {
+        size_t begin = shape.rings[r], end = shape.rings[r + 1];
+        for (size_t i = begin, j = end - 1; i < end; j = i++) {
+            if (fn(shape.points[j], shape.points[i])) return true;
+        }
+    }
+    return false;
+}
+
+// Helper to test whether a shape covers a point
+bool covers(const Shape& shape, const Point2D& p) {
+    if (shape.filled && insideRings(p, shape)) return true;
+    if (shape.radius <= 0.0) return false;
+    double radius2 = shape.radius * shape.radius;
+    return anyEdge(shape, [&](const Point2D& a, const Point2D& b) {
+        return pointSegmentDistance2(p, a, b) <= radius2;
+    });
+}
+
+// Helper to tell whether a negative feature drawn after `after` clears the
+// copper at a point
+bool clearedAfter(const StackLayer& stack, size_t after, const Point2D& p, Shape& scratch) {
+    if (stack.negatives.empty()) return false;
+    BoundingBox2D window;
+    window.expand(p);
+    bool cleared = false;
+    stack.negativeIndex.visit(window, [&](size_t k) {
+        size_t n = stack.negatives[k];
+        if (cleared || n <= after) return;
+        const Shape* shape = outline(stack, n, scratch);
+        cleared = shape && covers(*shape, p);
+    });
+    return cleared;
+}
+
+// Helper to test whether two shapes touch within a gap at a point accept()
+// agrees with. Points of one shape inside the other are tried while they
+// stay inside; edges contribute the point where they meet.
+template<typename Accept>
+bool touches(const Shape& a, const Shape& b, double gap, Accept&& accept) {
+    if (a.points.empty() || b.points.empty()) return false;
+    double reach = a.radius + b.radius + gap;
+    auto anyInside = [&](const Shape& outer, const Shape& inner) {
+        if (!outer.filled) return false;
+        for (const auto& p : inner.points) {
+            if (!insideRings(p, outer)) return false;
+            if (accept(p)) return true;
+        }
+        return false;
+    };
+    if (anyInside(a, b) || anyInside(b, a)) return true;
+
+    double reach2 = reach * reach;
+    BoundingBox2D bWindow = inflate(b.box, a.radius + gap);
+    return anyEdge(a, [&](const Point2D& p0, const Point2D& p1) {
+        BoundingBox2D edge;
+        edge.expand(p0);
+        edge.expand(p1);
+        if (edge.min.x > bWindow.max.x || edge.max.x < bWindow.min.x ||
+            edge.min.y > bWindow.max.y || edge.max.y < bWindow.min.y) {
+            return false;
+        }
+        BoundingBox2D edgeWindow = inflate(edge, reach);
+        return anyEdge(b, [&](const Point2D& q0, const Point2D& q1) {
+            if (std::max(q0.x, q1.x) < edgeWindow.min.x || std::min(q0.x, q1.x) > edgeWindow.max.x ||
+                std::max(q0.y, q1.y) < edgeWindow.min.y || std::min(q0.y, q1.y) > edgeWindow.max.y) {
+                return false;
+            }
+            return segmentDistance2(p0, p1, q0, q1) <= reach2 && accept(contactPoint(p0, p1, q0, q1));
+        });
+    });
+}
+
+/**
+ * Concurrent union-find over 32-bit ids.
+ *
+ * Roots are always linked under the smaller root, so parents only ever
+ * decrease, no cycle can form, and each root is the smallest id of its set.
+ */
+class UnionFind {
+public:
+    explicit UnionFind(size_t count) : parent_(count) {
+        for (size_t i = 0; i < count; ++i) {
+            parent_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t find(uint32_t x) {
+        while (true) {
+            uint32_t p = parent_[x].load(std::memory_order_acquire);
+            if (p == x) return x;
+            uint32_t gp = parent_[p].load(std::memory_order_acquire);
+            if (gp != p) {
+                parent_[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel);
+            }
+            x = gp;
+        }
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            uint32_t expected = a;
+            if (parent_[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel)) return;
+        }
+    }
+
+private:
+    std::vector<std::atomic<uint32_t>> parent_;
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// Result
+// ============================================================================
+
+uint32_t NetConnectivity::Result::getComponent(const std::string& layer, size_t feature) const {
+    for (size_t k = 0; k < layers.size(); ++k) {
+        if (layers[k] != layer) continue;
+        size_t global = layerOffsets[k] + feature;
+        return global < layerOffsets[k + 1] ? components[global] : kNoComponent;
+    }
+    return kNoComponent;
+}
+
+// ============================================================================
+// NetConnectivity
+// ============================================================================
+
+NetConnectivity::NetConnectivity(const Step& step, const LayerMatrix& matrix)
+    : step_(step), matrix_(matrix) {}
+
+NetConnectivity::Result NetConnectivity::extract(const Options& options) const {
+    Result result;
+    size_t threads = util::resolveThreadCount(options.threads);
+
+    // ========== Layer stack ==========
+
+    // Matrix rows first, then layers the matrix does not list (by name)
+    std::vector<std::pair<const Layer*, const LayerDefinition*>> ordered;
+    std::vector<const LayerDefinition*> rows;
+    for (const auto& def : matrix_.getLayerDefinitions()) rows.push_back(&def);
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const LayerDefinition* a, const LayerDefinition* b) { return a->row < b->row; });
+    for (const auto* def : rows) {
+        if (const Layer* layer = step_.getLayer(def->name)) ordered.emplace_back(layer, def);
+    }
+    std::vector<const Layer*> unlisted;
+    for (const auto& [name, layer] : step_.getLayers()) {
+        if (!matrix_.getLayerDefinition(name)) unlisted.push_back(layer.get());
+    }
+    std::sort(unlisted.begin(), unlisted.end(),
+              [](const Layer* a, const Layer* b) { return a->getName() < b->getName(); });
+    for (const Layer* layer : unlisted) ordered.emplace_back(layer, nullptr);
+
+    std::vector<std::unique_ptr<StackLayer>> stack;
+    std::vector<int> copperRows;    ///< Matrix row of each copper layer, ascending (unlisted last)
+    std::vector<std::pair<const Layer*, const LayerDefinition*>> drills;
+    for (const auto& [layer, def] : ordered) {
+        LayerType type = def ? def->type : layer->getType();
+        if (isCopperType(type)) {
+            auto entry = std::make_unique<StackLayer>();
+            entry->layer = layer;
+            entry->pin = layer->pin();
+            stack.push_back(std::move(entry));
+            copperRows.push_back(def ? def->row : std::numeric_limits<int>::max());
+        } else if (type == LayerType::Drill) {
+            drills.emplace_back(layer, def);
+        }
+    }
+    size_t copperCount = stack.size();
+    for (const auto& [layer, def] : drills) {
+        auto entry = std::make_unique<StackLayer>();
+        entry->layer = layer;
+        entry->drill = true;
+        const auto* drill = dynamic_cast<const DrillLayer*>(layer);
+        if (copperCount == 0 || (drill && drill->getDrillType() == DrillType::NonPlated)) continue;
+        entry->pin = layer->pin();
+        entry->firstCopper = 0;
+        entry->lastCopper = copperCount - 1;
+        if (def) {
+            // START_NAME/END_NAME name the matrix layers the drill runs between
+            const LayerDefinition* from = matrix_.getLayerDefinition(def->startName);
+            const LayerDefinition* to = matrix_.getLayerDefinition(def->endName);
+            if (from && to) {
+                auto begin = std::lower_bound(copperRows.begin(), copperRows.end(), std::min(from->row, to->row));
+                auto end = std::upper_bound(copperRows.begin(), copperRows.end(), std::max(from->row, to->row));
+                if (begin < end) {
+                    entry->firstCopper = static_cast<size_t>(begin - copperRows.begin());
+                    entry->lastCopper = static_cast<size_t>(end - copperRows.begin()) - 1;
+                }
+            }
+        } else if (drill && drill->getStartLayer() != drill->getEndLayer() &&
+                   drill->getStartLayer() > 0 && drill->getEndLayer() > 0) {
+            int start = drill->getStartLayer(), end = drill->getEndLayer();
+            entry->firstCopper = std::min(static_cast<size_t>(std::min(start, end)), copperCount) - 1;
+            entry->lastCopper = std::min(static_cast<size_t>(std::max(start, end)), copperCount) - 1;
+        }
+        stack.push_back(std::move(entry));
+    }
+
+    size_t total = 0;
+    for (auto& entry : stack) {
+        entry->offset = total;
+        total += entry->layer->getFeatures().size();
+        result.layers.push_back(entry->layer->getName());
+        result.layerOffsets.push_back(entry->offset);
+    }
+    result.layerOffsets.push_back(total);
+
+    // ========== Per-layer geometry and R-trees ==========
+
+    SymbolCache ownSymbols;
+
+    for (auto& entry : stack) {
+        const FeatureStore& store = entry->layer->getFeatures();
+        const std::string& units = entry->layer->getUnits();
+        const SymbolCache* shared = options.symbols ? options.symbols : entry->layer->getSymbolCache();
+        for (const SymbolGeometry* geometry : (shared ? *shared : ownSymbols).resolve(store.getSymbols(), units)) {
+            entry->symbols.push_back(resolveSymbol(*geometry));
+        }
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (store.getType(i) != FeatureType::Surface) continue;
+            if (const auto* surface = dynamic_cast<const SurfaceFeature*>(store.getObject(store.getRow(i)))) {
+                entry->surfaces.emplace(i, surfaceShape(*surface));
+            }
+        }
+
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (store.getPolarity(i) == Polarity::Negative && hasOutline(store, i)) {
+                entry->negatives.push_back(i);
+            }
+        }
+
+        std::vector<BoundingBox2D> boxes(store.size());
+        std::vector<BoundingBox2D> negativeBoxes(entry->negatives.size());
+        const StackLayer& layer = *entry;
+        util::parallelForBlocks(store.size(), kBlockSize, [&](size_t, size_t begin, size_t end) {
+            Shape scratch;
+            for (size_t i = begin; i < end; ++i) {
+                if (const Shape* shape = buildShape(layer, i, scratch)) boxes[i] = shape->box;
+            }
+        }, threads);
+        util::parallelForBlocks(layer.negatives.size(), kBlockSize, [&](size_t, size_t begin, size_t end) {
+            Shape scratch;
+            for (size_t k = begin; k < end; ++k) {
+                if (const Shape* shape = outline(layer, layer.negatives[k], scratch)) {
+                    negativeBoxes[k] = shape->box;
+                }
+            }
+        }, threads);
+        entry->index.build(boxes, threads);
+        entry->negativeIndex.build(negativeBoxes, threads);
+    }
+
+    // ========== Contacts ==========
+
+    UnionFind sets(total);
+    double gap = options.tolerance;
+    for (const auto& entry : stack) {
+        const StackLayer& layer = *entry;
+        size_t count = layer.layer->getFeatures().size();
+        std::vector<size_t> contacts(util::blockCount(count, kBlockSize), 0);
+        util::parallelForBlocks(count, kBlockSize, [&](size_t block, size_t begin, size_t end) {
+            Shape scratch, otherScratch, cutScratch;
+            size_t found = 0;
+            for (size_t i = begin; i < end; ++i) {
+                const Shape* shape = buildShape(layer, i, scratch);
+                if (!shape) continue;
+                auto self = static_cast<uint32_t>(layer.offset + i);
+                BoundingBox2D window = inflate(shape->box, gap);
+
+                auto connect = [&](const StackLayer& target, size_t j) {
+                    const Shape* other = buildShape(target, j, otherScratch);
+                    if (!other) return;
+                    // Both features must still hold copper at the contact
+                    auto copperAt = [&](const Point2D& p) {
+                        return !clearedAfter(layer, i, p, cutScratch) &&
+                               !clearedAfter(target, j, p, cutScratch);
+                    };
+                    if (!touches(*shape, *other, gap, copperAt)) return;
+                    sets.unite(self, static_cast<uint32_t>(target.offset + j));
+                    ++found;
+                };
+                if (!layer.drill) {
+                    layer.index.visit(window, [&](size_t j) {
+                        if (j > i) connect(layer, j);
+                    });
+                } else {
+                    for (size_t c = layer.firstCopper; c <= layer.lastCopper; ++c) {
+                        const StackLayer& copper = *stack[c];
+                        copper.index.visit(window, [&](size_t j) { connect(copper, j); });
+                    }
+                }
+            }
+            contacts[block] = found;
+        }, threads);
+        for (size_t found : contacts) result.contactCount += found;
+    }
+
+    // ========== Components ==========
+
+    // Roots are the smallest member, so a single ascending pass numbers
+    // components by their first feature
+    result.components.assign(total, kNoComponent);
+    for (const auto& entry : stack) {
+        const StackLayer& layer = *entry;
+        const FeatureStore& store = layer.layer->getFeatures();
+        for (size_t i = 0; i < store.size(); ++i) {
+            if (!conducts(store, i)) continue;
+            auto global = static_cast<uint32_t>(layer.offset + i);
+            uint32_t root = sets.find(global);
+            if (root == global) {
+                result.components[global] = static_cast<uint32_t>(result.componentCount++);
+            } else {
+                result.components[global] = result.components[root];
+            }
+        }
+    }
+
+    if (!options.checkNetlist) {
+        return result;
+    }
+
+    // ========== Netlist check ==========
+
+    // Net of each feature: feature net names, overridden by EDA FID records
+    std::vector<std::string> netNames;
+    std::unordered_map<std::string, int32_t> netIndex;
+    auto internNet = [&](const std::string& name) {
+        auto [it, added] = netIndex.emplace(name, static_cast<int32_t>(netNames.size()));
+        if (added) netNames.push_back(name);
+        return it->second;
+    };
+
+    std::vector<int32_t> featureNet(total, -1);
+    std::unordered_map<std::string, size_t> layerIndex;
+    for (size_t k = 0; k < stack.size(); ++k) {
+        const StackLayer& layer = *stack[k];
+        layerIndex.emplace(layer.layer->getName(), k);
+        const FeatureStore& store = layer.layer->getFeatures();
+        std::vector<int32_t> nets;
+        for (const auto& name : store.getNets().getStrings()) nets.push_back(internNet(name));
+        for (size_t i = 0; i < store.size(); ++i) {
+            int32_t net = store.getNet(i);
+            if (net >= 0) featureNet[layer.offset + i] = nets[static_cast<size_t>(net)];
+        }
+    }
+
+    const EdaData& eda = step_.getEdaData();
+    std::unordered_map<int, int32_t> netByNumber;
+    for (const auto& net : eda.getNets()) {
+        netByNumber.emplace(net->getNetNumber(), internNet(net->getName()));
+    }
+    const auto& edaLayers = eda.getLayerNames();
+    for (const auto& record : eda.getFeatureIdRecords()) {
+        const FeatureId& fid = record.featureId;
+        if (fid.type == 'L' || fid.layerNum < 0 || static_cast<size_t>(fid.layerNum) >= edaLayers.size()) {
+            continue;
+        }
+        auto layer = layerIndex.find(edaLayers[static_cast<size_t>(fid.layerNum)]);
+        auto net = netByNumber.find(record.netNum);
+        if (layer == layerIndex.end() || net == netByNumber.end()) continue;
+        size_t first = result.layerOffsets[layer->second];
+        size_t global = first + static_cast<size_t>(std::max(fid.featureNum, 0));
+        if (fid.featureNum >= 0 && global < result.layerOffsets[layer->second + 1]) {
+            featureNet[global] = net->second;
+        }
+    }
+
+    // (net, component) pairs; a net in several components is an open, a
+    // component with several nets is a short
+    std::vector<std::pair<int32_t, uint32_t>> pairs;
+    for (size_t g = 0; g < total; ++g) {
+        if (featureNet[g] >= 0 && result.components[g] != kNoComponent) {
+            pairs.emplace_back(featureNet[g], result.components[g]);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    std::vector<Issue> opens;
+    for (size_t i = 0; i < pairs.size();) {
+        size_t j = i;
+        while (j < pairs.size() && pairs[j].first == pairs[i].first) ++j;
+        if (j - i > 1) {
+            Issue issue;
+            issue.type = IssueType::Open;
+            issue.nets.push_back(netNames[static_cast<size_t>(pairs[i].first)]);
+            for (size_t k = i; k < j; ++k) issue.components.push_back(pairs[k].second);
+            opens.push_back(std::move(issue));
+        }
+        i = j;
+    }
+    std::sort(opens.begin(), opens.end(),
+              [](const Issue& a, const Issue& b) { return a.nets[0] < b.nets[0]; });
+
+    std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    std::vector<Issue> shorts;
+    for (size_t i = 0; i < pairs.size();) {
+        size_t j = i;
+        while (j < pairs.size() && pairs[j].second == pairs[i].second) ++j;
+        if (j - i > 1) {
+            Issue issue;
+            issue.type = IssueType::Short;
+            issue.components.push_back(pairs[i].second);
+            for (size_t k = i; k < j; ++k) issue.nets.push_back(netNames[static_cast<size_t>(pairs[k].first)]);
+            std::sort(issue.nets.begin(), issue.nets.end());
+            shorts.push_back(std::move(issue));
+        }
+        i = j;
+    }
+
+    result.openCount = opens.size();
+    result.shortCount = shorts.size();
+    result.issues = std::move(opens);
+    result.issues.insert(result.issues.end(), std::make_move_iterator(shorts.begin()),
+                         std::make_move_iterator(shorts.end()));
+    return result;
+}
+
+std::string NetConnectivity::formatIssue(const Issue& issue) {
+    std::string message;
+    if (issue.type == IssueType::Open) {
+        message = "Open: net " + (issue.nets.empty() ? std::string() : issue.nets[0]) +
+                  " is split into " + std::to_string(issue.components.size()) + " components";
+    } else {
+        message = "Short: nets";
+        for (size_t i = 0; i < issue.nets.size(); ++i) {
+            message += (i == 0 ? " " : ", ") + issue.nets[i];
+        }
+        if (!issue.components.empty()) {
+            message += " meet in component " + std::to_string(issue.components[0]);
+        }
+    }
+    return message;
+}
+
+} // namespace koo::ecad
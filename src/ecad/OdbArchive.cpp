@@ -0,0 +1,489 @@
+#include <koo/ecad/OdbArchive.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <zlib.h>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBlockSize = 512;
+constexpr unsigned kMaxChunk = 1u << 30;    // gzread/gzwrite take an unsigned length
+
+// Helper to check a suffix
+bool endsWith(const std::string& str, const std::string& suffix) {
+    return str.size() >= suffix.size() &&
+           str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Helper to lowercase an ASCII string
+std::string toLower(std::string str) {
+    std::transform(str.begin(), str.end(), str.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+// Helper to normalize a member path: no "./" prefix, no leading or trailing '/'
+std::string normalizePath(std::string path) {
+    while (path.compare(0, 2, "./") == 0) {
+        path.erase(0, 2);
+    }
+    while (!path.empty() && path.front() == '/') {
+        path.erase(0, 1);
+    }
+    while (!path.empty() && path.back() == '/') {
+        path.pop_back();
+    }
+    return path == "." ? std::string() : path;
+}
+
+// Helper to read a NUL-terminated header field
+std::string headerString(const char* field, size_t length) {
+    return std::string(field, strnlen(field, length));
+}
+
+// Helper to parse an octal header number
+uint64_t parseOctal(const char* field, size_t length) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < length; ++i) {
+        char c = field[i];
+        if (c == ' ' && value == 0) continue;
+        if (c < '0' || c > '7') break;
+        value = value * 8 + static_cast<uint64_t>(c - '0');
+    }
+    return value;
+}
+
+// Helper to compute a header checksum (chksum field counted as spaces)
+unsigned headerChecksum(const unsigned char* header) {
+    unsigned sum = 0;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        sum += (i >= 148 && i < 156) ? static_cast<unsigned>(' ') : header[i];
+    }
+    return sum;
+}
+
+uint64_t paddedSize(uint64_t size) {
+    return (size + kBlockSize - 1) / kBlockSize * kBlockSize;
+}
+
+// Helper to read exactly size bytes from a gzip stream
+bool readExact(gzFile gz, char* out, uint64_t size) {
+    while (size > 0) {
+        unsigned chunk = static_cast<unsigned>(std::min<uint64_t>(size, kMaxChunk));
+        int n = gzread(gz, out, chunk);
+        if (n <= 0) return false;
+        out += n;
+        size -= static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+// Helper to skip bytes in a gzip stream
+bool skip(gzFile gz, uint64_t size) {
+    if (size == 0) return true;
+    return gzseek(gz, static_cast<z_off_t>(size), SEEK_CUR) >= 0;
+}
+
+// Helper to extract the "path" record of a pax extended header
+std::string paxPath(const std::string& records) {
+    size_t pos = 0;
+    while (pos < records.size()) {
+        size_t space = records.find(' ', pos);
+        if (space == std::string::npos) break;
+        size_t length = std::strtoul(records.c_str() + pos, nullptr, 10);
+        if (length == 0 || pos + length > records.size()) break;
+        std::string record = records.substr(space + 1, pos + length - space - 2);
+        if (record.compare(0, 5, "path=") == 0) {
+            return record.substr(5);
+        }
+        pos += length;
+    }
+    return "";
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// OdbArchive
+// ============================================================================
+
+bool OdbArchive::isArchivePath(const std::filesystem::path& path) {
+    std::string name = toLower(path.filename().string());
+    return endsWith(name, ".tgz") || endsWith(name, ".tar.gz") || endsWith(name, ".tar");
+}
+
+std::string OdbArchive::archiveStem(const std::filesystem::path& path) {
+    std::string name = path.filename().string();
+    std::string lower = toLower(name);
+    for (const char* ext : {".tar.gz", ".tgz", ".tar"}) {
+        if (endsWith(lower, ext)) {
+            return name.substr(0, name.size() - std::strlen(ext));
+        }
+    }
+    return path.stem().string();
+}
+
+bool OdbArchive::open(const std::filesystem::path& archivePath) {
+    path_ = archivePath;
+    jobName_.clear();
+    entries_.clear();
+    data_.clear();
+    inMemory_ = false;
+    lastError_.clear();
+
+    gzFile gz = gzopen(archivePath.string().c_str(), "rb");
+    if (!gz) {
+        lastError_ = "Cannot open archive: " + archivePath.string();
+        return false;
+    }
+    gzbuffer(gz, 1u << 17);
+
+    // Pass 1: stream headers once, keeping member data of compressed archives
+    std::vector<std::pair<std::string, Entry>> members;
+    std::array<unsigned char, kBlockSize> header{};
+    std::string longName;
+    bool first = true;
+
+    for (;;) {
+        int n = gzread(gz, header.data(), static_cast<unsigned>(kBlockSize));
+        if (n == 0) break;
+        if (n != static_cast<int>(kBlockSize)) {
+            lastError_ = "Truncated archive: " + archivePath.string();
+            break;
+        }
+        if (first) {
+            // Plain .tar is read through zlib's transparent mode; index offsets only
+            inMemory_ = gzdirect(gz) == 0;
+            first = false;
+        }
+        if (std::all_of(header.begin(), header.end(), [](unsigned char c) { return c == 0; })) {
+            break;
+        }
+
+        const char* h = reinterpret_cast<const char*>(header.data());
+        if (parseOctal(h + 148, 8) != headerChecksum(header.data())) {
+            lastError_ = "Invalid tar header in archive: " + archivePath.string();
+            break;
+        }
+
+        uint64_t size = parseOctal(h + 124, 12);
+        char type = h[156];
+
+        // GNU long name and pax extended headers name the next member
+        if (type == 'L' || type == 'x') {
+            std::string payload(static_cast<size_t>(size), '\0');
+            if (!readExact(gz, payload.data(), size) || !skip(gz, paddedSize(size) - size)) {
+                lastError_ = "Truncated archive: " + archivePath.string();
+                break;
+            }
+            longName = type == 'L' ? payload.substr(0, strnlen(payload.c_str(), payload.size()))
+                                   : paxPath(payload);
+            continue;
+        }
+
+        std::string name = longName;
+        longName.clear();
+        if (name.empty()) {
+            name = headerString(h, 100);
+            std::string prefix = headerString(h + 345, 155);
+            if (std::memcmp(h + 257, "ustar", 5) == 0 && !prefix.empty()) {
+                name = prefix + "/" + name;
+            }
+        }
+
+        Entry entry;
+        entry.size = size;
+        entry.directory = type == '5' || (!name.empty() && name.back() == '/');
+        bool regular = !entry.directory && (type == '0' || type == '\0' || type == '7');
+
+        bool ok = true;
+        if (regular && inMemory_) {
+            entry.offset = data_.size();
+            data_.resize(data_.size() + static_cast<size_t>(size));
+            ok = readExact(gz, data_.data() + entry.offset, size) &&
+                 skip(gz, paddedSize(size) - size);
+        } else {
+            if (regular) {
+                entry.offset = static_cast<uint64_t>(gztell(gz));
+            }
+            ok = skip(gz, paddedSize(size));
+        }
+        if (!ok) {
+            lastError_ = "Truncated archive: " + archivePath.string();
+            break;
+        }
+
+        if (regular || entry.directory) {
+            members.emplace_back(normalizePath(name), entry);
+        }
+    }
+    gzclose(gz);
+
+    if (!lastError_.empty()) {
+        entries_.clear();
+        data_.clear();
+        return false;
+    }
+
+    // Pass 2: the job root is the directory holding matrix/matrix
+    std::string root;
+    bool rootFound = false;
+    for (const auto& m : members) {
+        const std::string& name = m.first;
+        if (name == "matrix/matrix" || endsWith(name, "/matrix/matrix")) {
+            std::string candidate = name.substr(0, name.size() - std::strlen("matrix/matrix"));
+            if (!rootFound || candidate.size() < root.size()) {
+                root = candidate;
+                rootFound = true;
+            }
+        }
+    }
+    if (!rootFound && !members.empty()) {
+        // Fall back to a single top-level directory shared by all members
+        std::string top = members.front().first.substr(0, members.front().first.find('/'));
+        bool shared = std::all_of(members.begin(), members.end(), [&](const auto& m) {
+            return m.first == top || m.first.compare(0, top.size() + 1, top + "/") == 0;
+        });
+        if (shared && !(members.size() == 1 && !members.front().second.directory)) {
+            root = top + "/";
+        }
+    }
+
+    for (auto& m : members) {
+        if (m.first.compare(0, root.size(), root) == 0) {
+            addEntry(m.first.substr(root.size()), m.second);
+        }
+    }
+
+    std::string rootName = normalizePath(root);
+    auto slash = rootName.rfind('/');
+    jobName_ = rootName.empty() ? archiveStem(archivePath)
+                                : rootName.substr(slash == std::string::npos ? 0 : slash + 1);
+    return true;
+}
+
+void OdbArchive::addEntry(std::string path, const Entry& entry) {
+    path = normalizePath(path);
+    if (path.empty()) return;
+
+    // Later members replace earlier ones, as on extraction
+    entries_[path] = entry;
+
+    // Archives need not list parent directories explicitly
+    for (auto slash = path.rfind('/'); slash != std::string::npos; slash = path.rfind('/', slash - 1)) {
+        Entry dir;
+        dir.directory = true;
+        entries_.emplace(path.substr(0, slash), dir);
+        if (slash == 0) break;
+    }
+}
+
+bool OdbArchive::exists(const std::string& path) const {
+    std::string key = normalizePath(path);
+    return key.empty() || entries_.count(key) > 0;
+}
+
+bool OdbArchive::isDirectory(const std::string& path) const {
+    std::string key = normalizePath(path);
+    if (key.empty()) return true;
+    auto it = entries_.find(key);
+    return it != entries_.end() && it->second.directory;
+}
+
+std::vector<std::string> OdbArchive::listDirectories(const std::string& path) const {
+    std::vector<std::string> result;
+    std::string prefix = normalizePath(path);
+    if (!prefix.empty()) prefix += '/';
+
+    for (auto it = entries_.lower_bound(prefix);
+         it != entries_.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        std::string rest = it->first.substr(prefix.size());
+        if (it->second.directory && !rest.empty() && rest.find('/') == std::string::npos) {
+            result.push_back(rest);
+        }
+    }
+    return result;
+}
+
+bool OdbArchive::read(const std::string& path, std::string& content) const {
+    auto it = entries_.find(normalizePath(path));
+    if (it == entries_.end() || it->second.directory) {
+        return false;
+    }
+
+    const Entry& entry = it->second;
+    if (inMemory_) {
+        content.assign(data_, static_cast<size_t>(entry.offset), static_cast<size_t>(entry.size));
+        return true;
+    }
+
+    std::ifstream file(path_, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    content.resize(static_cast<size_t>(entry.size));
+    file.seekg(static_cast<std::streamoff>(entry.offset));
+    file.read(content.data(), static_cast<std::streamsize>(entry.size));
+    return static_cast<bool>(file);
+}
+
+size_t OdbArchive::getFileCount() const {
+    return static_cast<size_t>(std::count_if(entries_.begin(), entries_.end(),
+        [](const auto& e) { return !e.second.directory; }));
+}
+
+// ============================================================================
+// OdbArchiveWriter
+// ============================================================================
+
+OdbArchiveWriter::~OdbArchiveWriter() {
+    if (file_) {
+        close();
+    }
+}
+
+bool OdbArchiveWriter::open(const std::filesystem::path& archivePath, const std::string& rootName,
+                            int compressionLevel) {
+    if (file_) {
+        close();
+    }
+    lastError_.clear();
+    directories_.clear();
+    root_ = normalizePath(rootName);
+
+    std::string mode = "wb";
+    if (endsWith(toLower(archivePath.filename().string()), ".tar")) {
+        mode += "T";
+    } else {
+        mode += std::to_string(std::clamp(compressionLevel, 1, 9));
+    }
+
+    file_ = gzopen(archivePath.string().c_str(), mode.c_str());
+    if (!file_) {
+        lastError_ = "Failed to create archive: " + archivePath.string();
+        return false;
+    }
+    gzbuffer(file_, 1u << 17);
+
+    if (!root_.empty()) {
+        if (!writeHeader(root_ + "/", 0, '5')) return false;
+    }
+    return true;
+}
+
+bool OdbArchiveWriter::addDirectory(const std::string& path) {
+    std::string dir = normalizePath(path);
+    if (dir.empty()) return true;
+
+    // Parents first, each written once
+    size_t pos = 0;
+    for (;;) {
+        size_t slash = dir.find('/', pos);
+        std::string current = dir.substr(0, slash);
+        if (directories_.insert(current).second) {
+            std::string name = (root_.empty() ? "" : root_ + "/") + current + "/";
+            if (!writeHeader(name, 0, '5')) return false;
+        }
+        if (slash == std::string::npos) break;
+        pos = slash + 1;
+    }
+    return true;
+}
+
+bool OdbArchiveWriter::addFile(const std::string& path, const std::string& content) {
+    std::string name = normalizePath(path);
+    auto slash = name.rfind('/');
+    if (slash != std::string::npos && !addDirectory(name.substr(0, slash))) {
+        return false;
+    }
+
+    if (!root_.empty()) {
+        name = root_ + "/" + name;
+    }
+    if (!writeHeader(name, content.size(), '0') || !writeBytes(content.data(), content.size())) {
+        return false;
+    }
+
+    static const char zeros[kBlockSize] = {};
+    size_t padding = static_cast<size_t>(paddedSize(content.size()) - content.size());
+    return writeBytes(zeros, padding);
+}
+
+bool OdbArchiveWriter::close() {
+    if (!file_) {
+        return false;
+    }
+
+    static const char zeros[2 * kBlockSize] = {};
+    bool ok = writeBytes(zeros, sizeof(zeros));
+    if (gzclose(file_) != Z_OK && ok) {
+        lastError_ = "Failed to finish archive";
+        ok = false;
+    }
+    file_ = nullptr;
+    return ok;
+}
+
+bool OdbArchiveWriter::writeHeader(const std::string& name, uint64_t size, char type) {
+    std::array<unsigned char, kBlockSize> header{};
+    char* h = reinterpret_cast<char*>(header.data());
+
+    std::string shortName = name;
+    std::string prefix;
+    if (name.size() > 100) {
+        // Split into ustar prefix/name at a '/', else fall back to a GNU long name
+        size_t split = name.rfind('/', name.size() - 2);
+        while (split != std::string::npos && (name.size() - split - 1 > 100 || split > 155)) {
+            split = split == 0 ? std::string::npos : name.rfind('/', split - 1);
+        }
+        if (split != std::string::npos && name.size() - split - 1 <= 100 && split <= 155) {
+            prefix = name.substr(0, split);
+            shortName = name.substr(split + 1);
+        } else {
+            std::string payload = name + '\0';
+            static const char zeros[kBlockSize] = {};
+            if (!writeHeader("././@LongLink", payload.size(), 'L') ||
+                !writeBytes(payload.data(), payload.size()) ||
+                !writeBytes(zeros, static_cast<size_t>(paddedSize(payload.size()) - payload.size()))) {
+                return false;
+            }
+            shortName = name.substr(0, 100);
+        }
+    }
+
+    std::memcpy(h, shortName.data(), std::min<size_t>(shortName.size(), 100));
+    std::snprintf(h + 100, 8, "%07o", type == '5' ? 0755u : 0644u);
+    std::snprintf(h + 108, 8, "%07o", 0u);
+    std::snprintf(h + 116, 8, "%07o", 0u);
+    std::snprintf(h + 124, 12, "%011llo", static_cast<unsigned long long>(size));
+    std::snprintf(h + 136, 12, "%011llo", static_cast<unsigned long long>(std::time(nullptr)));
+    h[156] = type;
+    std::memcpy(h + 257, "ustar", 6);
+    std::memcpy(h + 263, "00", 2);
+    std::memcpy(h + 345, prefix.data(), std::min<size_t>(prefix.size(), 155));
+
+    std::snprintf(h + 148, 8, "%06o", headerChecksum(header.data()));
+    h[155] = ' ';
+
+    return writeBytes(h, kBlockSize);
+}
+
+bool OdbArchiveWriter::writeBytes(const char* data, size_t size) {
+    while (size > 0) {
+        unsigned chunk = static_cast<unsigned>(std::min<size_t>(size, kMaxChunk));
+        if (gzwrite(file_, data, chunk) != static_cast<int>(chunk)) {
+            lastError_ = "Failed to write archive data";
+            return false;
+        }
+        data += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+} // namespace koo::ecad
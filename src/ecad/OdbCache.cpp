@@ -0,0 +1,1245 @@
+#include <koo/ecad/OdbCache.hpp>
+#include <koo/ecad/OdbJob.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x3148434143424F4BULL;     // "KOBCACH1" in file byte order
+constexpr uint64_t kTrailer = 0x444E454843424F4BULL;   // "KOBCHEND"
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+constexpr uint64_t kFnvOffset = 0xcbf29ce484222325ULL;
+constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+// Helper to fold bytes into an FNV-1a hash
+void mix(uint64_t& hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+}
+
+// Helper to fold a file's size and modification time into a hash
+void mixFile(uint64_t& hash, const std::filesystem::path& path) {
+    std::error_code ec;
+    uint64_t size = static_cast<uint64_t>(std::filesystem::file_size(path, ec));
+    if (ec) size = 0;
+    int64_t time = static_cast<int64_t>(std::filesystem::last_write_time(path, ec).time_since_epoch().count());
+    if (ec) time = 0;
+    mix(hash, &size, sizeof(size));
+    mix(hash, &time, sizeof(time));
+}
+
+// Helper to list attributes in key order, so equal jobs give equal files
+std::vector<std::pair<std::string, std::string>> sortedAttributes(const AttributeList& attrs) {
+    std::vector<std::pair<std::string, std::string>> sorted(attrs.begin(), attrs.end());
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+// Helper to list map keys in order
+template <typename Map>
+std::vector<typename Map::key_type> sortedKeys(const Map& map) {
+    std::vector<typename Map::key_type> keys;
+    keys.reserve(map.size());
+    for (const auto& [key, value] : map) keys.push_back(key);
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// OdbCache::Encoder
+// ============================================================================
+
+class OdbCache::Encoder {
+public:
+    std::string& bytes() { return bytes_; }
+
+    template <typename T>
+    void value(T v) { append(&v, sizeof(T)); }
+
+    void flag(bool b) { value<uint8_t>(b ? 1 : 0); }
+
+    template <typename E>
+    void tag(E e) { value(static_cast<uint8_t>(e)); }
+
+    void count(size_t n) { value(static_cast<uint64_t>(n)); }
+
+    void string(const std::string& str) {
+        count(str.size());
+        append(str.data(), str.size());
+    }
+
+    /// Raw array, aligned to 8 bytes from the start of the file
+    template <typename T>
+    void column(const std::vector<T>& values) {
+        count(values.size());
+        bytes_.resize((bytes_.size() + 7) & ~size_t(7), '\0');
+        append(values.data(), values.size() * sizeof(T));
+    }
+
+    void strings(const std::vector<std::string>& values) {
+        count(values.size());
+        for (const auto& str : values) string(str);
+    }
+
+    void point(const Point2D& p) {
+        value(p.x);
+        value(p.y);
+    }
+
+    void box(const BoundingBox2D& b) {
+        point(b.min);
+        point(b.max);
+    }
+
+    void attributes(const AttributeList& attrs) {
+        count(attrs.size());
+        for (const auto& [key, text] : sortedAttributes(attrs)) {
+            string(key);
+            string(text);
+        }
+    }
+
+    void featureId(const FeatureId& id) {
+        value(id.type);
+        value<int32_t>(id.layerNum);
+        value<int32_t>(id.featureNum);
+    }
+
+    void contour(const Contour& c) {
+        point(c.getStart());
+        tag(c.getPolygonType());
+        count(c.getSegments().size());
+        for (const auto& segment : c.getSegments()) {
+            tag(segment.type);
+            value(segment.x);
+            value(segment.y);
+            value(segment.xc);
+            value(segment.yc);
+            flag(segment.clockwise);
+        }
+    }
+
+    void contours(const std::vector<Contour>& values) {
+        count(values.size());
+        for (const auto& c : values) contour(c);
+    }
+
+    void feature(const Feature& f) {
+        tag(f.getType());
+        string(f.getId());
+        tag(f.getPolarity());
+        value<int32_t>(f.getDcode());
+        string(f.getNetName());
+        attributes(f.getAttributes());
+
+        switch (f.getType()) {
+            case FeatureType::Line: {
+                const auto& line = static_cast<const LineFeature&>(f);
+                point(line.getStart());
+                point(line.getEnd());
+                string(line.getSymbolName());
+                value<int32_t>(line.getSymbolIndex());
+                break;
+            }
+            case FeatureType::Pad: {
+                const auto& pad = static_cast<const PadFeature&>(f);
+                point(pad.getPosition());
+                string(pad.getSymbolName());
+                value<int32_t>(pad.getSymbolIndex());
+                value(pad.getRotation());
+                flag(pad.isMirrored());
+                value(pad.getResizeFactor());
+                flag(pad.hasResize());
+                break;
+            }
+            case FeatureType::Arc: {
+                const auto& arc = static_cast<const ArcFeature&>(f);
+                point(arc.getStart());
+                point(arc.getEnd());
+                point(arc.getCenter());
+                string(arc.getSymbolName());
+                value<int32_t>(arc.getSymbolIndex());
+                flag(arc.isClockwise());
+                break;
+            }
+            case FeatureType::Surface:
+                contours(static_cast<const SurfaceFeature&>(f).getContours());
+                break;
+            case FeatureType::Text: {
+                const auto& text = static_cast<const TextFeature&>(f);
+                point(text.getPosition());
+                string(text.getText());
+                string(text.getFont());
+                value(text.getXSize());
+                value(text.getYSize());
+                value(text.getWidthFactor());
+                value(text.getRotation());
+                flag(text.isMirrored());
+                value<int32_t>(text.getVersion());
+                break;
+            }
+            case FeatureType::Barcode: {
+                const auto& barcode = static_cast<const BarcodeFeature&>(f);
+                point(barcode.getPosition());
+                string(barcode.getBarcodeType());
+                string(barcode.getFont());
+                value(barcode.getRotation());
+                flag(barcode.isMirrored());
+                value(barcode.getElementWidth());
+                value(barcode.getHeight());
+                flag(barcode.isFullAscii());
+                flag(barcode.hasChecksum());
+                flag(barcode.hasInvertedBackground());
+                flag(barcode.hasAdditionalString());
+                flag(barcode.isStringOnTop());
+                string(barcode.getText());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    void pin(const Pin& p) {
+        string(p.name);
+        string(p.netName);
+        value(p.x);
+        value(p.y);
+        tag(p.type);
+        value<int32_t>(p.featureLayerIndex);
+        value<int32_t>(p.electricalLayerIndex);
+        value<int32_t>(p.mechanicalLayerIndex);
+        value(p.rotation);
+        flag(p.mirror);
+        string(p.padstackName);
+        attributes(p.attributes);
+    }
+
+    void pins(const std::vector<Pin>& values) {
+        count(values.size());
+        for (const auto& p : values) pin(p);
+    }
+
+    void layer(const Layer& l) {
+        string(l.getName());
+        tag(l.getType());
+        tag(l.getContext());
+        tag(l.getPolarity());
+        tag(l.getSide());
+        value<int32_t>(l.getRow());
+        string(l.getUnits());
+        attributes(l.getAttributes());
+        contours(l.getProfile());
+        strings(l.getSymbolNames());
+        encodeFeatures(*this, l.getFeatures());
+    }
+
+    void eda(const EdaData& data) {
+        strings(data.getLayerNames());
+        strings(data.getNetAttributeNames());
+        strings(data.getNetAttributeStrings());
+
+        count(data.getPackageCount());
+        for (size_t i = 0; i < data.getPackageCount(); ++i) {
+            const Package& package = *data.getPackage(static_cast<int>(i));
+            string(package.getName());
+            value(package.getPitch());
+            box(package.getBoundingBox());
+            pins(package.getPins());
+            contours(package.getOutlines());
+            attributes(package.getAttributes());
+        }
+
+        count(data.getComponents().size());
+        for (const auto& component : data.getComponents()) {
+            string(component->getRefDes());
+            string(component->getPartNumber());
+            string(component->getPackageName());
+            value<int32_t>(component->getPackageIndex());
+            point(component->getPosition());
+            value(component->getRotation());
+            flag(component->isMirrored());
+            tag(component->getSide());
+            string(component->getComponentName());
+            pins(component->getPins());
+            string(component->getValue());
+            string(component->getDescription());
+            string(component->getManufacturer());
+            string(component->getManufacturerPartNumber());
+            value<int32_t>(component->getToeprintTop());
+            value<int32_t>(component->getToeprintBottom());
+            attributes(component->getAttributes());
+        }
+
+        count(data.getNets().size());
+        for (const auto& net : data.getNets()) {
+            string(net->getName());
+            value<int32_t>(net->getNetNumber());
+            count(net->getPins().size());
+            for (const auto& ref : net->getPins()) {
+                string(ref.refDes);
+                string(ref.pinName);
+            }
+            tag(net->getNetClass());
+            attributes(net->getAttributes());
+            count(net->getSubnets().size());
+            for (const auto& subnet : net->getSubnets()) {
+                tag(subnet.type);
+                column(subnet.featureIds);
+            }
+        }
+
+        // Subnets recorded per net name, which need not name a Net
+        std::vector<std::string> subnetNames;
+        for (const auto& name : data.getNameTable().getStrings()) {
+            if (!data.getSubnets(name).empty()) subnetNames.push_back(name);
+        }
+        count(subnetNames.size());
+        for (const auto& name : subnetNames) {
+            string(name);
+            auto subnets = data.getSubnets(name);
+            count(subnets.size());
+            for (const auto& subnet : subnets) {
+                tag(subnet.type);
+                value(subnet.side);
+                value<int32_t>(subnet.componentNum);
+                value<int32_t>(subnet.toeprintNum);
+                tag(subnet.fillType);
+                tag(subnet.cutoutType);
+                value(subnet.fillSize);
+                count(subnet.features.size());
+                for (const auto& id : subnet.features) featureId(id);
+            }
+        }
+
+        count(data.getFeatureGroups().size());
+        for (const auto& group : data.getFeatureGroups()) {
+            string(group.type);
+            count(group.features.size());
+            for (const auto& id : group.features) featureId(id);
+            attributes(group.attributes);
+        }
+
+        // One FID record per feature on large boards: stored as columns
+        const auto& records = data.getFeatureIdRecords();
+        std::vector<char> types(records.size());
+        std::vector<int32_t> layers(records.size()), features(records.size());
+        std::vector<int32_t> nets(records.size()), subnets(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            types[i] = records[i].featureId.type;
+            layers[i] = records[i].featureId.layerNum;
+            features[i] = records[i].featureId.featureNum;
+            nets[i] = records[i].netNum;
+            subnets[i] = records[i].subnetNum;
+        }
+        column(types);
+        column(layers);
+        column(features);
+        column(nets);
+        column(subnets);
+
+        count(data.getBomItems().size());
+        for (const auto& item : data.getBomItems()) {
+            string(item.refDes);
+            string(item.partNumber);
+            string(item.manufacturer);
+            string(item.description);
+            value<int32_t>(item.quantity);
+            strings(item.descriptions);
+            attributes(item.attributes);
+        }
+    }
+
+    void step(const Step& s) {
+        string(s.getName());
+        tag(s.getType());
+        flag(s.hasEdaData());
+        point(s.getDatum());
+        value(s.getXDatum());
+        value(s.getYDatum());
+        flag(s.getAffectHoles());
+        box(s.getActiveArea());
+
+        count(s.getStepRepeats().size());
+        for (const auto& repeat : s.getStepRepeats()) {
+            string(repeat.stepName);
+            value(repeat.x);
+            value(repeat.y);
+            value(repeat.dx);
+            value(repeat.dy);
+            value<int32_t>(repeat.nx);
+            value<int32_t>(repeat.ny);
+            value(repeat.angle);
+            flag(repeat.mirror);
+        }
+
+        attributes(s.getAttributes());
+        contours(s.getProfile());
+
+        auto layerNames = sortedKeys(s.getLayers());
+        count(layerNames.size());
+        for (const auto& name : layerNames) layer(*s.getLayer(name));
+
+        eda(s.getEdaData());
+
+        count(s.getZones().size());
+        for (const auto& zone : s.getZones()) {
+            string(zone.name);
+            count(zone.boundary.size());
+            for (const auto& p : zone.boundary) point(p);
+            value<int32_t>(zone.startLayer);
+            value<int32_t>(zone.endLayer);
+            attributes(zone.attributes);
+        }
+
+        count(s.getDimensions().size());
+        for (const auto& dim : s.getDimensions()) {
+            tag(dim.type);
+            point(dim.start);
+            point(dim.end);
+            point(dim.textPosition);
+            string(dim.text);
+            value(dim.value);
+            string(dim.units);
+            attributes(dim.attributes);
+        }
+    }
+
+    void job(const OdbJob& j) {
+        string(j.getName());
+        const JobInfo& info = j.getInfo();
+        string(info.name);
+        string(info.creationDate);
+        string(info.modificationDate);
+        string(info.saveApp);
+        string(info.saveUser);
+        tag(info.version);
+        string(info.units);
+        attributes(j.getAttributes());
+
+        const LayerMatrix& matrix = j.getMatrix();
+        count(matrix.getLayerDefinitions().size());
+        for (const auto& def : matrix.getLayerDefinitions()) {
+            string(def.name);
+            tag(def.type);
+            tag(def.context);
+            tag(def.polarity);
+            tag(def.side);
+            value<int32_t>(def.row);
+            string(def.startName);
+            string(def.endName);
+            value(def.thickness);
+            string(def.oldName);
+        }
+        count(matrix.getStepDefinitions().size());
+        for (const auto& def : matrix.getStepDefinitions()) {
+            string(def.name);
+            value<int32_t>(def.col);
+        }
+
+        auto symbolNames = j.getSymbolNames();
+        std::sort(symbolNames.begin(), symbolNames.end());
+        count(symbolNames.size());
+        for (const auto& name : symbolNames) {
+            const Symbol& symbol = *j.getSymbol(name);
+            string(symbol.getName());
+            tag(symbol.getType());
+            value(symbol.getUnit());
+            box(symbol.getBoundingBox());
+            attributes(symbol.getAttributes());
+            count(symbol.getFeatures().size());
+            for (const auto& f : symbol.getFeatures()) feature(*f);
+        }
+
+        auto stepNames = sortedKeys(j.getSteps());
+        count(stepNames.size());
+        for (const auto& name : stepNames) step(*j.getStep(name));
+
+        count(j.getStackup().size());
+        for (const auto& layer : j.getStackup()) {
+            string(layer.name);
+            tag(layer.materialType);
+            value(layer.thickness);
+            value(layer.dielectricConstant);
+            value(layer.lossTangent);
+            string(layer.material);
+            value<int32_t>(layer.layerIndex);
+            attributes(layer.properties);
+        }
+    }
+
+private:
+    void append(const void* data, size_t size) {
+        bytes_.append(static_cast<const char*>(data), size);
+    }
+
+    std::string bytes_;
+};
+
+// ============================================================================
+// OdbCache::Decoder
+// ============================================================================
+
+class OdbCache::Decoder {
+public:
+    Decoder(const char* data, size_t size) : begin_(data), pos_(data), end_(data + size) {}
+
+    bool atEnd() const { return pos_ == end_; }
+
+    template <typename T>
+    T value() {
+        T v;
+        std::memcpy(&v, take(sizeof(T)), sizeof(T));
+        return v;
+    }
+
+    bool flag() { return value<uint8_t>() != 0; }
+
+    template <typename E>
+    E tag() { return static_cast<E>(value<uint8_t>()); }
+
+    /// Element count, checked against the bytes left
+    size_t count(size_t elementBytes = 1) {
+        uint64_t n = value<uint64_t>();
+        if (n > static_cast<uint64_t>(end_ - pos_) / elementBytes) {
+            throw std::runtime_error("Cache file is truncated");
+        }
+        return static_cast<size_t>(n);
+    }
+
+    std::string string() {
+        size_t n = count();
+        return std::string(take(n), n);
+    }
+
+    template <typename T>
+    void column(std::vector<T>& values) {
+        size_t n = count(sizeof(T));
+        auto offset = static_cast<size_t>(pos_ - begin_);
+        take(((offset + 7) & ~size_t(7)) - offset);     // Alignment padding
+        values.resize(n);
+        if (n > 0) std::memcpy(values.data(), take(n * sizeof(T)), n * sizeof(T));
+    }
+
+    std::vector<std::string> strings() {
+        std::vector<std::string> values(count());
+        for (auto& str : values) str = string();
+        return values;
+    }
+
+    Point2D point() {
+        double x = value<double>();
+        return {x, value<double>()};
+    }
+
+    BoundingBox2D box() {
+        Point2D min = point();
+        return {min, point()};
+    }
+
+    template <typename Target>
+    void attributes(Target& target) {
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) {
+            std::string key = string();
+            target.setAttribute(key, string());
+        }
+    }
+
+    AttributeList attributes() {
+        AttributeList attrs;
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) {
+            std::string key = string();
+            attrs[key] = string();
+        }
+        return attrs;
+    }
+
+    FeatureId featureId() {
+        FeatureId id;
+        id.type = value<char>();
+        id.layerNum = value<int32_t>();
+        id.featureNum = value<int32_t>();
+        return id;
+    }
+
+    std::vector<FeatureId> featureIds() {
+        std::vector<FeatureId> ids(count());
+        for (auto& id : ids) id = featureId();
+        return ids;
+    }
+
+    Contour contour() {
+        Point2D start = point();
+        Contour c(start.x, start.y, tag<PolygonType>());
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) {
+            auto type = tag<ContourSegmentType>();
+            double x = value<double>(), y = value<double>();
+            double xc = value<double>(), yc = value<double>();
+            bool clockwise = flag();
+            if (type == ContourSegmentType::Arc) {
+                c.addArcSegment(x, y, xc, yc, clockwise);
+            } else {
+                c.addLineSegment(x, y);
+            }
+        }
+        return c;
+    }
+
+    std::vector<Contour> contours() {
+        std::vector<Contour> values;
+        size_t n = count();
+        values.reserve(n);
+        for (size_t i = 0; i < n; ++i) values.push_back(contour());
+        return values;
+    }
+
+    std::unique_ptr<Feature> feature() {
+        auto type = tag<FeatureType>();
+        std::string id = string();
+        auto polarity = tag<Polarity>();
+        int dcode = value<int32_t>();
+        std::string netName = string();
+        AttributeList attrs = attributes();
+
+        std::unique_ptr<Feature> f;
+        switch (type) {
+            case FeatureType::Line: {
+                auto line = std::make_unique<LineFeature>();
+                Point2D start = point(), end = point();
+                line->setStart(start.x, start.y);
+                line->setEnd(end.x, end.y);
+                line->setSymbolName(string());
+                line->setSymbolIndex(value<int32_t>());
+                f = std::move(line);
+                break;
+            }
+            case FeatureType::Pad: {
+                auto pad = std::make_unique<PadFeature>();
+                Point2D position = point();
+                pad->setPosition(position.x, position.y);
+                pad->setSymbolName(string());
+                pad->setSymbolIndex(value<int32_t>());
+                pad->setRotation(value<double>());
+                pad->setMirrored(flag());
+                pad->setResizeFactor(value<double>());
+                pad->setHasResize(flag());
+                f = std::move(pad);
+                break;
+            }
+            case FeatureType::Arc: {
+                auto arc = std::make_unique<ArcFeature>();
+                Point2D start = point(), end = point(), center = point();
+                arc->setStart(start.x, start.y);
+                arc->setEnd(end.x, end.y);
+                arc->setCenter(center.x, center.y);
+                arc->setSymbolName(string());
+                arc->setSymbolIndex(value<int32_t>());
+                arc->setClockwise(flag());
+                f = std::move(arc);
+                break;
+            }
+            case FeatureType::Surface: {
+                auto surface = std::make_unique<SurfaceFeature>();
+                for (auto& c : contours()) surface->addContour(std::move(c));
+                f = std::move(surface);
+                break;
+            }
+            case FeatureType::Text: {
+                auto text = std::make_unique<TextFeature>();
+                Point2D position = point();
+                text->setPosition(position.x, position.y);
+                text->setText(string());
+                text->setFont(string());
+                double xSize = value<double>();
+                text->setSize(xSize, value<double>());
+                text->setWidthFactor(value<double>());
+                text->setRotation(value<double>());
+                text->setMirrored(flag());
+                text->setVersion(value<int32_t>());
+                f = std::move(text);
+                break;
+            }
+            case FeatureType::Barcode: {
+                auto barcode = std::make_unique<BarcodeFeature>();
+                Point2D position = point();
+                barcode->setPosition(position.x, position.y);
+                barcode->setBarcodeType(string());
+                barcode->setFont(string());
+                barcode->setRotation(value<double>());
+                barcode->setMirrored(flag());
+                barcode->setElementWidth(value<double>());
+                barcode->setHeight(value<double>());
+                barcode->setFullAscii(flag());
+                barcode->setChecksum(flag());
+                barcode->setInvertedBackground(flag());
+                barcode->setHasAdditionalString(flag());
+                barcode->setStringOnTop(flag());
+                barcode->setText(string());
+                f = std::move(barcode);
+                break;
+            }
+            default:
+                throw std::runtime_error("Cache file has an unknown feature type");
+        }
+
+        f->setId(id);
+        f->setPolarity(polarity);
+        f->setDcode(dcode);
+        f->setNetName(netName);
+        for (const auto& [key, text] : attrs) f->setAttribute(key, text);
+        return f;
+    }
+
+    Pin pin() {
+        Pin p;
+        p.name = string();
+        p.netName = string();
+        p.x = value<double>();
+        p.y = value<double>();
+        p.type = tag<PinType>();
+        p.featureLayerIndex = value<int32_t>();
+        p.electricalLayerIndex = value<int32_t>();
+        p.mechanicalLayerIndex = value<int32_t>();
+        p.rotation = value<double>();
+        p.mirror = flag();
+        p.padstackName = string();
+        p.attributes = attributes();
+        return p;
+    }
+
+    template <typename Target>
+    void pins(Target& target) {
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) target.addPin(pin());
+    }
+
+    std::unique_ptr<Layer> layer() {
+        auto l = std::make_unique<Layer>(string());
+        l->setType(tag<LayerType>());
+        l->setContext(tag<LayerContext>());
+        l->setPolarity(tag<Polarity>());
+        l->setSide(tag<Side>());
+        l->setRow(value<int32_t>());
+        l->setUnits(string());
+        attributes(*l);
+        for (const auto& c : contours()) l->addProfileContour(c);
+        l->setSymbolNames(strings());
+        decodeFeatures(*this, l->getFeatures());
+        return l;
+    }
+
+    void eda(EdaData& data) {
+        data.setLayerNames(strings());
+        data.setNetAttributeNames(strings());
+        data.setNetAttributeStrings(strings());
+
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) {
+            auto package = std::make_unique<Package>(string());
+            package->setPitch(value<double>());
+            package->setBoundingBox(box());
+            pins(*package);
+            for (const auto& c : contours()) package->addOutline(c);
+            attributes(*package);
+            data.addPackage(std::move(package));
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            auto component = std::make_unique<Component>(string());
+            component->setPartNumber(string());
+            component->setPackageName(string());
+            component->setPackageIndex(value<int32_t>());
+            Point2D position = point();
+            component->setPosition(position.x, position.y);
+            component->setRotation(value<double>());
+            component->setMirrored(flag());
+            component->setSide(tag<MountSide>());
+            component->setComponentName(string());
+            pins(*component);
+            component->setValue(string());
+            component->setDescription(string());
+            component->setManufacturer(string());
+            component->setManufacturerPartNumber(string());
+            component->setToeprintTop(value<int32_t>());
+            component->setToeprintBottom(value<int32_t>());
+            attributes(*component);
+            data.addComponent(std::move(component));
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            auto net = std::make_unique<Net>(string());
+            net->setNetNumber(value<int32_t>());
+            size_t pinCount = count();
+            for (size_t k = 0; k < pinCount; ++k) {
+                std::string refDes = string();
+                net->addPin(refDes, string());
+            }
+            net->setNetClass(tag<NetClass>());
+            attributes(*net);
+            size_t subnetCount = count();
+            for (size_t k = 0; k < subnetCount; ++k) {
+                Net::Subnet subnet;
+                subnet.type = tag<Net::Subnet::Type>();
+                column(subnet.featureIds);
+                net->addSubnet(subnet);
+            }
+            data.addNet(std::move(net));
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            std::string name = string();
+            size_t subnetCount = count();
+            for (size_t k = 0; k < subnetCount; ++k) {
+                Subnet subnet;
+                subnet.type = tag<SubnetType>();
+                subnet.side = value<char>();
+                subnet.componentNum = value<int32_t>();
+                subnet.toeprintNum = value<int32_t>();
+                subnet.fillType = tag<PlaneFillType>();
+                subnet.cutoutType = tag<PlaneCutoutType>();
+                subnet.fillSize = value<double>();
+                subnet.features = featureIds();
+                data.addSubnet(name, subnet);
+            }
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            EdaData::FeatureGroup group;
+            group.type = string();
+            group.features = featureIds();
+            group.attributes = attributes();
+            data.addFeatureGroup(group);
+        }
+
+        std::vector<char> types;
+        std::vector<int32_t> layers, features, nets, subnets;
+        column(types);
+        column(layers);
+        column(features);
+        column(nets);
+        column(subnets);
+        if (layers.size() != types.size() || features.size() != types.size() ||
+            nets.size() != types.size() || subnets.size() != types.size()) {
+            throw std::runtime_error("Cache file has inconsistent FID columns");
+        }
+        for (size_t i = 0; i < types.size(); ++i) {
+            EdaData::FeatureIdRecord record;
+            record.featureId = {types[i], layers[i], features[i]};
+            record.netNum = nets[i];
+            record.subnetNum = subnets[i];
+            data.addFeatureIdRecord(record);
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            BomItem item;
+            item.refDes = string();
+            item.partNumber = string();
+            item.manufacturer = string();
+            item.description = string();
+            item.quantity = value<int32_t>();
+            item.descriptions = strings();
+            item.attributes = attributes();
+            data.addBomItem(item);
+        }
+    }
+
+    std::unique_ptr<Step> step() {
+        auto s = std::make_unique<Step>(string());
+        s->setType(tag<StepType>());
+        s->setHasEdaData(flag());
+        s->setDatum(point());
+        s->setXDatum(value<char>());
+        s->setYDatum(value<char>());
+        s->setAffectHoles(flag());
+        s->setActiveArea(box());
+
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) {
+            StepRepeat repeat;
+            repeat.stepName = string();
+            repeat.x = value<double>();
+            repeat.y = value<double>();
+            repeat.dx = value<double>();
+            repeat.dy = value<double>();
+            repeat.nx = value<int32_t>();
+            repeat.ny = value<int32_t>();
+            repeat.angle = value<double>();
+            repeat.mirror = flag();
+            s->addStepRepeat(repeat);
+        }
+
+        attributes(*s);
+        for (const auto& c : contours()) s->addProfileContour(c);
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) s->addLayer(layer());
+
+        eda(s->getEdaData());
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            Zone zone;
+            zone.name = string();
+            size_t points = count();
+            for (size_t k = 0; k < points; ++k) zone.boundary.push_back(point());
+            zone.startLayer = value<int32_t>();
+            zone.endLayer = value<int32_t>();
+            zone.attributes = attributes();
+            s->addZone(zone);
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            Dimension dim;
+            dim.type = tag<DimensionType>();
+            dim.start = point();
+            dim.end = point();
+            dim.textPosition = point();
+            dim.text = string();
+            dim.value = value<double>();
+            dim.units = string();
+            dim.attributes = attributes();
+            s->addDimension(dim);
+        }
+        return s;
+    }
+
+    void job(OdbJob& j) {
+        j.setName(string());
+        JobInfo info;
+        info.name = string();
+        info.creationDate = string();
+        info.modificationDate = string();
+        info.saveApp = string();
+        info.saveUser = string();
+        info.version = tag<OdbVersion>();
+        info.units = string();
+        j.setInfo(info);
+        attributes(j);
+
+        size_t n = count();
+        for (size_t i = 0; i < n; ++i) {
+            LayerDefinition def;
+            def.name = string();
+            def.type = tag<LayerType>();
+            def.context = tag<LayerContext>();
+            def.polarity = tag<Polarity>();
+            def.side = tag<Side>();
+            def.row = value<int32_t>();
+            def.startName = string();
+            def.endName = string();
+            def.thickness = value<double>();
+            def.oldName = string();
+            j.getMatrix().addLayer(def);
+        }
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            LayerMatrix::StepDefinition def;
+            def.name = string();
+            def.col = value<int32_t>();
+            j.getMatrix().addStep(def);
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            auto symbol = std::make_unique<Symbol>(string());
+            symbol->setType(tag<SymbolType>());
+            symbol->setUnit(value<char>());
+            symbol->setBoundingBox(box());
+            attributes(*symbol);
+            size_t features = count();
+            for (size_t k = 0; k < features; ++k) symbol->addFeature(feature());
+            j.addSymbol(std::move(symbol));
+        }
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) j.addStep(step());
+
+        n = count();
+        for (size_t i = 0; i < n; ++i) {
+            StackupLayer layer;
+            layer.name = string();
+            layer.materialType = tag<StackupMaterialType>();
+            layer.thickness = value<double>();
+            layer.dielectricConstant = value<double>();
+            layer.lossTangent = value<double>();
+            layer.material = string();
+            layer.layerIndex = value<int32_t>();
+            layer.properties = attributes();
+            j.addStackupLayer(layer);
+        }
+    }
+
+private:
+    const char* take(size_t size) {
+        if (size > static_cast<size_t>(end_ - pos_)) {
+            throw std::runtime_error("Cache file is truncated");
+        }
+        const char* data = pos_;
+        pos_ += size;
+        return data;
+    }
+
+    const char* begin_;
+    const char* pos_;
+    const char* end_;
+};
+
+// ============================================================================
+// Feature Columns
+// ============================================================================
+
+void OdbCache::encodeFeatures(Encoder& out, const FeatureStore& store) {
+    out.column(store.types_);
+    out.column(store.rows_);
+    out.column(store.polarity_);
+    out.column(store.dcode_);
+    out.column(store.net_);
+
+    const auto& lines = store.lines_;
+    out.column(lines.xs);
+    out.column(lines.ys);
+    out.column(lines.xe);
+    out.column(lines.ye);
+    out.column(lines.symbol);
+
+    const auto& pads = store.pads_;
+    out.column(pads.x);
+    out.column(pads.y);
+    out.column(pads.rotation);
+    out.column(pads.resize);
+    out.column(pads.symbol);
+    out.column(pads.flags);
+
+    const auto& arcs = store.arcs_;
+    out.column(arcs.xs);
+    out.column(arcs.ys);
+    out.column(arcs.xe);
+    out.column(arcs.ye);
+    out.column(arcs.xc);
+    out.column(arcs.yc);
+    out.column(arcs.symbol);
+    out.column(arcs.clockwise);
+
+    out.count(store.objects_.size());
+    for (const auto& object : store.objects_) out.feature(*object);
+
+    out.count(store.ids_.size());
+    for (size_t index : sortedKeys(store.ids_)) {
+        out.value<uint64_t>(index);
+        out.string(store.ids_.at(index));
+    }
+    out.count(store.attributes_.size());
+    for (size_t index : sortedKeys(store.attributes_)) {
+        out.value<uint64_t>(index);
+        out.attributes(store.attributes_.at(index));
+    }
+
+    out.strings(store.symbols_.getStrings());
+    out.strings(store.nets_.getStrings());
+}
+
+void OdbCache::decodeFeatures(Decoder& in, FeatureStore& store) {
+    in.column(store.types_);
+    in.column(store.rows_);
+    in.column(store.polarity_);
+    in.column(store.dcode_);
+    in.column(store.net_);
+
+    auto& lines = store.lines_;
+    in.column(lines.xs);
+    in.column(lines.ys);
+    in.column(lines.xe);
+    in.column(lines.ye);
+    in.column(lines.symbol);
+
+    auto& pads = store.pads_;
+    in.column(pads.x);
+    in.column(pads.y);
+    in.column(pads.rotation);
+    in.column(pads.resize);
+    in.column(pads.symbol);
+    in.column(pads.flags);
+
+    auto& arcs = store.arcs_;
+    in.column(arcs.xs);
+    in.column(arcs.ys);
+    in.column(arcs.xe);
+    in.column(arcs.ye);
+    in.column(arcs.xc);
+    in.column(arcs.yc);
+    in.column(arcs.symbol);
+    in.column(arcs.clockwise);
+
+    size_t n = in.count();
+    store.objects_.reserve(n);
+    for (size_t i = 0; i < n; ++i) store.objects_.push_back(in.feature());
+
+    n = in.count();
+    for (size_t i = 0; i < n; ++i) {
+        auto index = static_cast<size_t>(in.value<uint64_t>());
+        store.ids_[index] = in.string();
+    }
+    n = in.count();
+    for (size_t i = 0; i < n; ++i) {
+        auto index = static_cast<size_t>(in.value<uint64_t>());
+        store.attributes_[index] = in.attributes();
+    }
+
+    for (const auto& name : in.strings()) store.symbols_.intern(name);
+    for (const auto& name : in.strings()) store.nets_.intern(name);
+
+    size_t size = store.types_.size();
+    if (store.rows_.size() != size || store.polarity_.size() != size ||
+        store.dcode_.size() != size || store.net_.size() != size) {
+        throw std::runtime_error("Cache file has inconsistent feature columns");
+    }
+}
+
+// ============================================================================
+// OdbCache
+// ============================================================================
+
+std::filesystem::path OdbCache::defaultPath(const std::filesystem::path& odbPath) {
+    std::filesystem::path source = odbPath;
+    if (!source.has_filename()) source = source.parent_path();
+    source += ".koocache";
+    return source;
+}
+
+std::string OdbCache::sourceKey(const std::filesystem::path& odbPath) {
+    std::error_code ec;
+    auto status = std::filesystem::status(odbPath, ec);
+    if (ec || !std::filesystem::exists(status)) {
+        return {};
+    }
+
+    uint64_t hash = kFnvOffset;
+    if (std::filesystem::is_directory(status)) {
+        // Directory order is unspecified: sort by relative path
+        std::vector<std::filesystem::path> files;
+        for (std::filesystem::recursive_directory_iterator it(odbPath, ec), end; !ec && it != end;
+             it.increment(ec)) {
+            if (it->is_regular_file(ec)) files.push_back(it->path());
+        }
+        std::sort(files.begin(), files.end());
+        for (const auto& file : files) {
+            std::string relative = file.lexically_relative(odbPath).generic_string();
+            mix(hash, relative.data(), relative.size() + 1);
+            mixFile(hash, file);
+        }
+    } else {
+        mixFile(hash, odbPath);
+    }
+
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+    return key;
+}
+
+bool OdbCache::write(const OdbJob& job, const std::filesystem::path& cachePath,
+                     const std::string& sourceKey) {
+    lastError_.clear();
+
+    Encoder out;
+    out.value(kMagic);
+    out.value(kFormatVersion);
+    out.value(kByteOrderMark);
+    out.string(sourceKey);
+    out.job(job);
+    out.value(kTrailer);
+    const std::string& bytes = out.bytes();
+
+    // Write beside the target and rename over it
+    std::filesystem::path tempPath = cachePath;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            lastError_ = "Cannot create cache file: " + tempPath.string();
+            return false;
+        }
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!file.flush()) {
+            lastError_ = "Cannot write cache file: " + tempPath.string();
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        lastError_ = "Cannot replace cache file " + cachePath.string() + ": " + ec.message();
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool OdbCache::read(const std::filesystem::path& cachePath, const std::string& sourceKey,
+                    OdbJob& job) {
+    lastError_.clear();
+
+    // One read of the whole file; columns are then copied out in bulk
+    std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        lastError_ = "Cannot open cache file: " + cachePath.string();
+        return false;
+    }
+    std::string bytes(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+        lastError_ = "Cannot read cache file: " + cachePath.string();
+        return false;
+    }
+
+    try {
+        Decoder in(bytes.data(), bytes.size());
+        if (in.value<uint64_t>() != kMagic) {
+            lastError_ = "Not an ODB++ cache file: " + cachePath.string();
+            return false;
+        }
+        if (in.value<uint32_t>() != kFormatVersion || in.value<uint32_t>() != kByteOrderMark) {
+            lastError_ = "Cache file has another format version or byte order";
+            return false;
+        }
+        if (in.string() != sourceKey) {
+            lastError_ = "Cache file is stale";
+            return false;
+        }
+
+        OdbJob loaded;
+        in.job(loaded);
+        if (in.value<uint64_t>() != kTrailer || !in.atEnd()) {
+            lastError_ = "Cache file is damaged: " + cachePath.string();
+            return false;
+        }
+        job = std::move(loaded);
+    } catch (const std::exception& e) {
+        lastError_ = std::string(e.what()) + ": " + cachePath.string();
+        return false;
+    }
+    return true;
+}
+
+} // namespace koo::ecad
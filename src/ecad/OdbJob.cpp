@@ -6,6 +6,43 @@ namespace koo::ecad {
 
 OdbJob::OdbJob(const std::string& name) : name_(name) {}
 
+OdbJob::OdbJob(OdbJob&& other) {
+    *this = std::move(other);
+}
+
+OdbJob& OdbJob::operator=(OdbJob&& other) {
+    if (this == &other) return *this;
+
+    // Old layers detach from the old layer cache, so steps go first
+    name_ = std::move(other.name_);
+    info_ = std::move(other.info_);
+    sourcePath_ = std::move(other.sourcePath_);
+    matrix_ = std::move(other.matrix_);
+    steps_ = std::move(other.steps_);
+    layerCache_ = std::move(other.layerCache_);
+
+    // Moved steps keep pointing at the symbol cache that moves with them;
+    // the moved-from job gets a fresh library and cache
+    symbolLibrary_ = std::move(other.symbolLibrary_);
+    symbolCache_ = std::move(other.symbolCache_);
+    other.symbolLibrary_ = std::make_unique<SymbolLibrary>();
+    other.symbolCache_ =
+        std::make_unique<SymbolCache>(SymbolCache::kDefaultArcTolerance, other.symbolLibrary_.get());
+
+    attributes_ = std::move(other.attributes_);
+    stackup_ = std::move(other.stackup_);
+    impedanceConstraints_ = std::move(other.impedanceConstraints_);
+    intentionalShorts_ = std::move(other.intentionalShorts_);
+    drillTools_ = std::move(other.drillTools_);
+    metadata_ = std::move(other.metadata_);
+    variants_ = std::move(other.variants_);
+    embeddedComponents_ = std::move(other.embeddedComponents_);
+    buildupInfo_ = std::move(other.buildupInfo_);
+    vendorParts_ = std::move(other.vendorParts_);
+    customerInfo_ = std::move(other.customerInfo_);
+    return *this;
+}
+
 Step* OdbJob::getStep(const std::string& name) {
     auto it = steps_.find(name);
     return (it != steps_.end()) ? it->second.get() : nullptr;
@@ -18,12 +55,14 @@ const Step* OdbJob::getStep(const std::string& name) const {
 
 void OdbJob::addStep(std::unique_ptr<Step> step) {
     if (step) {
+        step->setSymbolCache(symbolCache_.get());
         steps_[step->getName()] = std::move(step);
     }
 }
 
 Step& OdbJob::createStep(const std::string& name) {
     auto step = std::make_unique<Step>(name);
+    step->setSymbolCache(symbolCache_.get());
     Step* ptr = step.get();
     steps_[name] = std::move(step);
     return *ptr;
@@ -67,19 +106,19 @@ const Step* OdbJob::getPrimaryStep() const {
 }
 
 Symbol* OdbJob::getSymbol(const std::string& name) {
-    return symbolLibrary_.getSymbol(name);
+    return symbolLibrary_->getSymbol(name);
 }
 
 const Symbol* OdbJob::getSymbol(const std::string& name) const {
-    return symbolLibrary_.getSymbol(name);
+    return symbolLibrary_->getSymbol(name);
 }
 
 void OdbJob::addSymbol(std::unique_ptr<Symbol> symbol) {
-    symbolLibrary_.addSymbol(std::move(symbol));
+    symbolLibrary_->addSymbol(std::move(symbol));
 }
 
 std::vector<std::string> OdbJob::getSymbolNames() const {
-    return symbolLibrary_.getSymbolNames();
+    return symbolLibrary_->getSymbolNames();
 }
 
 std::vector<std::string> OdbJob::getLayerNames() const {
@@ -121,7 +160,9 @@ void OdbJob::clear() {
     sourcePath_.clear();
     matrix_ = LayerMatrix();
     steps_.clear();
-    symbolLibrary_.clear();
+    layerCache_.reset();
+    symbolLibrary_->clear();
+    symbolCache_->clear();
     attributes_.clear();
     stackup_.clear();
     impedanceConstraints_.clear();
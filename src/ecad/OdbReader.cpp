@@ -1,10 +1,18 @@
 #include <koo/ecad/OdbReader.hpp>
+#include <koo/ecad/OdbCache.hpp>
+#include <koo/util/Parallel.hpp>
 #include <fstream>
+#include <optional>
 #include <sstream>
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
 #include <regex>
 #include <stdexcept>
+#include <thread>
 #include <zlib.h>
 #include <vector>
 
@@ -28,25 +36,297 @@ std::string toUpper(const std::string& str) {
     return result;
 }
 
-// Helper to check if file exists
-bool fileExists(const std::filesystem::path& path) {
-    return std::filesystem::exists(path);
+// Helper to trim whitespace from a view
+std::string_view trimView(std::string_view str) {
+    size_t first = str.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) return {};
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, last - first + 1);
 }
 
-// Helper to check for compressed file
-std::filesystem::path findFile(const std::filesystem::path& basePath,
-                               const std::string& filename) {
-    auto plain = basePath / filename;
-    if (fileExists(plain)) return plain;
+// Helper to parse a number like std::stod/stoi: leading match, throws if none
+template<typename T>
+T toNumber(std::string_view token) {
+    const char* first = token.data();
+    const char* last = first + token.size();
+    if (first != last && *first == '+') ++first;
 
-    auto compressed = basePath / (filename + ".z");
-    if (fileExists(compressed)) return compressed;
+    T value{};
+    auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc()) {
+        throw std::invalid_argument("Invalid number in features file: " + std::string(token));
+    }
+    return value;
+}
 
-    return plain;  // Return plain path even if not found
+double toDouble(std::string_view token) { return toNumber<double>(token); }
+int toInt(std::string_view token) { return toNumber<int>(token); }
+
+/**
+ * @brief Incremental zlib/gzip inflater
+ *
+ * Input that does not start with a zlib or gzip header is passed through
+ * unchanged, as gzread does for plain files.
+ */
+class Inflater {
+public:
+    Inflater() {
+        // 15 + 32: accept both zlib and gzip headers
+        ok_ = inflateInit2(&zs_, 15 + 32) == Z_OK;
+        if (!ok_) error_ = "inflateInit failed";
+    }
+    ~Inflater() { inflateEnd(&zs_); }
+
+    Inflater(const Inflater&) = delete;
+    Inflater& operator=(const Inflater&) = delete;
+
+    /**
+     * @brief Inflate one block of input
+     * @param sink Callable bool(const char*, size_t); returning false aborts
+     * @return false on a decompression error or when the sink aborts
+     */
+    template<typename Sink>
+    bool feed(const char* data, size_t size, Sink&& sink) {
+        if (!ok_ || size == 0 || done_) return ok_;
+        if (passthrough_) return sink(data, size);
+
+        zs_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        zs_.avail_in = static_cast<uInt>(size);
+        while (zs_.avail_in > 0 && !done_) {
+            zs_.next_out = reinterpret_cast<Bytef*>(out_.data());
+            zs_.avail_out = static_cast<uInt>(out_.size());
+            int ret = inflate(&zs_, Z_NO_FLUSH);
+
+            if (ret == Z_DATA_ERROR && zs_.total_out == 0) {
+                // Not deflate data
+                passthrough_ = true;
+                return sink(data, size);
+            }
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+                ok_ = false;
+                error_ = zs_.msg ? zs_.msg : "inflate failed";
+                return false;
+            }
+            done_ = ret == Z_STREAM_END;
+            size_t produced = out_.size() - zs_.avail_out;
+            if (produced > 0 && !sink(out_.data(), produced)) return false;
+        }
+        return true;
+    }
+
+    /// True once the whole stream was inflated (or passed through)
+    bool complete() const { return ok_ && (done_ || passthrough_); }
+
+    const std::string& error() const { return error_; }
+
+private:
+    z_stream zs_{};
+    std::vector<char> out_ = std::vector<char>(65536);
+    bool ok_ = false;
+    bool done_ = false;
+    bool passthrough_ = false;
+    std::string error_;
+};
+
+// Helper to map a file symbol number to a store symbol index
+int32_t storeSymbol(int symNum, const std::vector<int32_t>& symbols) {
+    if (symNum >= 0 && static_cast<size_t>(symNum) < symbols.size()) {
+        return symbols[static_cast<size_t>(symNum)];
+    }
+    return -1;
 }
 
 } // anonymous namespace
 
+// ============================================================================
+// Feature Records
+// ============================================================================
+
+/**
+ * @brief Fields of one feature record, viewing the decompressed buffer
+ *
+ * Fields are separated by spaces/tabs; quoted text stays one field. The
+ * record ends at the first ';' outside quotes (attributes and ID follow).
+ */
+struct OdbReader::RecordFields {
+    static constexpr size_t kMaxFields = 16;
+
+    std::array<std::string_view, kMaxFields> fields;
+    size_t count = 0;
+
+    explicit RecordFields(std::string_view line) {
+        size_t i = 0;
+        while (i < line.size() && line[i] != ';' && count < kMaxFields) {
+            if (line[i] == ' ' || line[i] == '\t') {
+                ++i;
+                continue;
+            }
+            size_t start = i;
+            char quote = 0;
+            for (; i < line.size(); ++i) {
+                char c = line[i];
+                if (quote) {
+                    if (c == quote) quote = 0;
+                } else if (c == '\'' || c == '"') {
+                    quote = c;
+                } else if (c == ' ' || c == '\t' || c == ';') {
+                    break;
+                }
+            }
+            fields[count++] = line.substr(start, i - start);
+        }
+    }
+
+    size_t size() const { return count; }
+    std::string_view operator[](size_t i) const { return fields[i]; }
+};
+
+/**
+ * @brief Line source for features files
+ *
+ * Views an in-memory buffer, or pipelines a compressed file: a producer
+ * thread inflates into fixed-size chunks handed over through a bounded
+ * queue, so decompression overlaps parsing and memory stays at
+ * (queueDepth + 1) chunks regardless of the file size.
+ */
+class OdbReader::FeatureLines {
+public:
+    static constexpr size_t kChunkSize = size_t(1) << 20;
+    static constexpr size_t kQueueDepth = 4;
+
+    explicit FeatureLines(std::string_view text) : current_(text) {}
+
+    explicit FeatureLines(std::unique_ptr<std::istream> compressed)
+        : streaming_(true) {
+        producer_ = std::thread([this, in = std::move(compressed)]() { produce(*in); });
+    }
+
+    ~FeatureLines() {
+        if (producer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            cv_.notify_all();
+            producer_.join();
+        }
+    }
+
+    FeatureLines(const FeatureLines&) = delete;
+    FeatureLines& operator=(const FeatureLines&) = delete;
+
+    /// Next trimmed line; the view stays valid until the next call
+    bool next(std::string_view& line) {
+        carry_.clear();
+        for (;;) {
+            size_t eol = current_.find('\n');
+            if (eol != std::string_view::npos) {
+                std::string_view piece = current_.substr(0, eol);
+                current_.remove_prefix(eol + 1);
+                if (carry_.empty()) {
+                    line = trimView(piece);
+                } else {
+                    carry_.append(piece);
+                    line = trimView(carry_);
+                }
+                return true;
+            }
+
+            // Line continues in the next chunk
+            carry_.append(current_);
+            current_ = {};
+            if (streaming_ && pop()) {
+                continue;
+            }
+            if (streaming_ && !error().empty()) {
+                return false;   // Drop the cut-off last line of a damaged stream
+            }
+            line = trimView(carry_);
+            return !carry_.empty();
+        }
+    }
+
+    /// Decompression error, if any (check after next() returned false)
+    std::string error() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_;
+    }
+
+private:
+    void produce(std::istream& in) {
+        Inflater inflater;
+        std::string chunk;
+        chunk.reserve(kChunkSize);
+
+        auto sink = [&](const char* data, size_t size) {
+            while (size > 0) {
+                size_t take = std::min(size, kChunkSize - chunk.size());
+                chunk.append(data, take);
+                data += take;
+                size -= take;
+                if (chunk.size() == kChunkSize) {
+                    if (!push(std::move(chunk))) return false;
+                    chunk = std::string();
+                    chunk.reserve(kChunkSize);
+                }
+            }
+            return true;
+        };
+
+        std::vector<char> input(size_t(1) << 16);
+        bool ok = true;
+        while (ok && in) {
+            in.read(input.data(), static_cast<std::streamsize>(input.size()));
+            auto got = static_cast<size_t>(in.gcount());
+            if (got == 0) break;
+            ok = inflater.feed(input.data(), got, sink);
+        }
+        if (ok && !chunk.empty()) {
+            ok = push(std::move(chunk));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stop_ && !inflater.complete()) {
+            error_ = inflater.error().empty() ? "truncated compressed data" : inflater.error();
+        }
+        done_ = true;
+        cv_.notify_all();
+    }
+
+    bool push(std::string&& chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return stop_ || queue_.size() < kQueueDepth; });
+        if (stop_) return false;
+        queue_.push_back(std::move(chunk));
+        cv_.notify_all();
+        return true;
+    }
+
+    bool pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return done_ || !queue_.empty(); });
+        if (queue_.empty()) return false;
+        chunk_ = std::move(queue_.front());
+        queue_.pop_front();
+        cv_.notify_all();
+        current_ = chunk_;
+        return true;
+    }
+
+    std::string_view current_;  ///< Unconsumed part of the current buffer/chunk
+    std::string chunk_;         ///< Chunk currently being consumed (streaming)
+    std::string carry_;         ///< Line spanning chunk boundaries
+    bool streaming_ = false;
+
+    std::thread producer_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::string> queue_;
+    bool done_ = false;
+    bool stop_ = false;
+    std::string error_;
+};
+
 // ============================================================================
 // Main Read Functions
 // ============================================================================
@@ -67,9 +347,32 @@ OdbJob OdbReader::read(const std::filesystem::path& odbPath, const Options& opti
             lastError_ = "ODB++ path does not exist: " + odbPath.string();
             throw std::runtime_error(lastError_);
         }
+        if (!openSource(odbPath)) {
+            throw std::runtime_error(lastError_);
+        }
+
+        // Load a binary cache of an earlier full read if the source is unchanged;
+        // the key is taken before parsing so a cache never outdates its source
+        std::filesystem::path cachePath;
+        std::string cacheKey;
+        if (isCacheable()) {
+            cachePath = options_.cachePath.empty() ? OdbCache::defaultPath(odbPath) : options_.cachePath;
+            bool haveCache = options_.readCache && std::filesystem::exists(cachePath);
+            if (haveCache || options_.writeCache) {
+                cacheKey = OdbCache::sourceKey(odbPath);
+            }
+            OdbCache cache;
+            if (haveCache && cache.read(cachePath, cacheKey, job)) {
+                job.setName(archive_ ? archive_->getJobName() : odbPath.filename().string());
+                job.setSourcePath(odbPath);
+                parseMiscFiles(job, odbPath);
+                reportProgress("Complete", 1.0);
+                return job;
+            }
+        }
 
-        // Get job name from directory name
-        job.setName(odbPath.filename().string());
+        // Get job name from directory (or archive root) name
+        job.setName(archive_ ? archive_->getJobName() : odbPath.filename().string());
         job.setSourcePath(odbPath);
 
         reportProgress("Reading matrix...", 0.0);
@@ -97,11 +400,9 @@ OdbJob OdbReader::read(const std::filesystem::path& odbPath, const Options& opti
         if (stepNames.empty()) {
             // Try to list directories in steps folder
             auto stepsDir = odbPath / "steps";
-            if (std::filesystem::exists(stepsDir)) {
-                for (const auto& entry : std::filesystem::directory_iterator(stepsDir)) {
-                    if (entry.is_directory()) {
-                        stepNames.push_back(entry.path().filename().string());
-                    }
+            if (fileExists(stepsDir)) {
+                for (const auto& dir : listDirectories(stepsDir)) {
+                    stepNames.push_back(dir.filename().string());
                 }
             }
         }
@@ -118,46 +419,41 @@ OdbJob OdbReader::read(const std::filesystem::path& odbPath, const Options& opti
             stepNames = filtered;
         }
 
-        // Parse each step
-        double stepProgress = 0.1;
-        double stepIncrement = 0.7 / static_cast<double>(std::max(size_t(1), stepNames.size()));
+        // Parse step-level files and queue layers, EDA data and symbols
+        std::vector<std::unique_ptr<Step>> steps;
+        std::vector<LoadTask> tasks;
 
         for (const auto& stepName : stepNames) {
-            reportProgress("Reading step: " + stepName, stepProgress);
+            reportProgress("Reading step: " + stepName, 0.1);
 
             auto stepPath = odbPath / "steps" / stepName;
 
             // Try case-insensitive match if exact path doesn't exist
-            if (!std::filesystem::exists(stepPath)) {
+            if (!fileExists(stepPath)) {
                 std::string lowerStepName = stepName;
                 std::transform(lowerStepName.begin(), lowerStepName.end(),
                                lowerStepName.begin(), ::tolower);
                 stepPath = odbPath / "steps" / lowerStepName;
             }
 
-            if (std::filesystem::exists(stepPath)) {
+            if (fileExists(stepPath)) {
                 auto step = std::make_unique<Step>(stepName);
-                parseStep(*step, stepPath);
-                job.addStep(std::move(step));
+                prepareStep(*step, stepPath, tasks);
+                steps.push_back(std::move(step));
             }
-
-            stepProgress += stepIncrement;
         }
 
-        // Parse symbols if requested
         if (options_.loadSymbols) {
-            reportProgress("Reading symbols...", 0.8);
-
-            auto symbolsDir = odbPath / "symbols";
-            if (std::filesystem::exists(symbolsDir)) {
-                for (const auto& entry : std::filesystem::directory_iterator(symbolsDir)) {
-                    if (entry.is_directory()) {
-                        auto symbol = std::make_unique<Symbol>(entry.path().filename().string());
-                        parseSymbol(*symbol, entry.path());
-                        job.addSymbol(std::move(symbol));
-                    }
-                }
-            }
+            prepareSymbols(odbPath / "symbols", tasks);
+        }
+
+        runLoadTasks(tasks, 0.1, 0.8);
+        if (options_.loadFeatures && options_.lazyFeatures) {
+            job.setLayerCache(makeLayerCache(tasks));
+        }
+        attachLoadTasks(tasks, &job);
+        for (auto& step : steps) {
+            job.addStep(std::move(step));
         }
 
         reportProgress("Reading stackup...", 0.85);
@@ -171,95 +467,106 @@ OdbJob OdbReader::read(const std::filesystem::path& odbPath, const Options& opti
             parseStackup(job.getStackup(), stackupPath);
         }
 
-        // Parse impedance constraints (misc/impedance or misc/impedance.xml)
-        auto impedancePath = odbPath / "misc" / "impedance";
-        if (!fileExists(impedancePath)) {
-            impedancePath = odbPath / "misc" / "impedance.xml";
-        }
-        if (fileExists(impedancePath)) {
-            parseImpedance(job.getImpedanceConstraints(), impedancePath);
-        }
+        parseMiscFiles(job, odbPath);
 
-        // Parse drill tools (misc/tools)
-        auto toolsPath = odbPath / "misc" / "tools";
-        if (fileExists(toolsPath)) {
-            parseTools(job.getDrillTools(), toolsPath);
+        // A failed write only costs later reads their speed-up
+        if (options_.writeCache && isCacheable()) {
+            OdbCache cache;
+            cache.write(job, cachePath, cacheKey);
         }
 
-        reportProgress("Reading additional data...", 0.9);
+        reportProgress("Complete", 1.0);
 
-        // Parse intentional shorts (misc/shortf)
-        auto shortfPath = odbPath / "misc" / "shortf";
-        if (fileExists(shortfPath)) {
-            parseShortf(const_cast<std::vector<IntentionalShort>&>(job.getIntentionalShorts()), shortfPath);
+    } catch (const std::exception& e) {
+        if (lastError_.empty()) {
+            lastError_ = e.what();
         }
+        throw;
+    }
 
-        // Parse fonts directory
-        auto fontsDir = odbPath / "fonts";
-        if (std::filesystem::exists(fontsDir)) {
-            for (const auto& entry : std::filesystem::directory_iterator(fontsDir)) {
-                if (entry.is_directory()) {
-                    parseFont(entry.path());
-                }
-            }
-        }
+    return job;
+}
 
-        // Parse metadata (misc/metadata or misc/metadata.xml)
-        auto metadataPath = odbPath / "misc" / "metadata";
-        if (!fileExists(metadataPath)) {
-            metadataPath = odbPath / "misc" / "metadata.xml";
-        }
-        if (fileExists(metadataPath)) {
-            parseMetadata(job.getMetadata(), metadataPath);
-        }
+void OdbReader::parseMiscFiles(OdbJob& job, const std::filesystem::path& odbPath) {
+    // Parse impedance constraints (misc/impedance or misc/impedance.xml)
+    auto impedancePath = odbPath / "misc" / "impedance";
+    if (!fileExists(impedancePath)) {
+        impedancePath = odbPath / "misc" / "impedance.xml";
+    }
+    if (fileExists(impedancePath)) {
+        parseImpedance(job.getImpedanceConstraints(), impedancePath);
+    }
 
-        // Parse component variants (misc/variants)
-        auto variantsPath = odbPath / "misc" / "variants";
-        if (fileExists(variantsPath)) {
-            parseVariants(job.getVariants(), variantsPath);
-        }
+    // Parse drill tools (misc/tools)
+    auto toolsPath = odbPath / "misc" / "tools";
+    if (fileExists(toolsPath)) {
+        parseTools(job.getDrillTools(), toolsPath);
+    }
 
-        // Parse embedded components (misc/embedded or misc/embedded_passives)
-        auto embeddedPath = odbPath / "misc" / "embedded";
-        if (!fileExists(embeddedPath)) {
-            embeddedPath = odbPath / "misc" / "embedded_passives";
-        }
-        if (fileExists(embeddedPath)) {
-            parseEmbeddedComponents(job.getEmbeddedComponents(), embeddedPath);
-        }
+    reportProgress("Reading additional data...", 0.9);
 
-        // Parse build-up information (misc/buildup)
-        auto buildupPath = odbPath / "misc" / "buildup";
-        if (fileExists(buildupPath)) {
-            parseBuildup(job.getBuildupInfo(), buildupPath);
-        }
+    // Parse intentional shorts (misc/shortf)
+    auto shortfPath = odbPath / "misc" / "shortf";
+    if (fileExists(shortfPath)) {
+        parseShortf(const_cast<std::vector<IntentionalShort>&>(job.getIntentionalShorts()), shortfPath);
+    }
 
-        // Parse VPL - Vendor Part List (misc/vpl)
-        auto vplPath = odbPath / "misc" / "vpl";
-        if (fileExists(vplPath)) {
-            parseVpl(job.getVendorParts(), vplPath);
+    // Parse fonts directory
+    auto fontsDir = odbPath / "fonts";
+    if (fileExists(fontsDir)) {
+        for (const auto& dir : listDirectories(fontsDir)) {
+            parseFont(dir);
         }
+    }
 
-        // Parse customer information (misc/customer)
-        auto customerPath = odbPath / "misc" / "customer";
-        if (fileExists(customerPath)) {
-            parseCustomerInfo(job.getCustomerInfo(), customerPath);
-        }
+    // Parse metadata (misc/metadata or misc/metadata.xml)
+    auto metadataPath = odbPath / "misc" / "metadata";
+    if (!fileExists(metadataPath)) {
+        metadataPath = odbPath / "misc" / "metadata.xml";
+    }
+    if (fileExists(metadataPath)) {
+        parseMetadata(job.getMetadata(), metadataPath);
+    }
 
-        reportProgress("Complete", 1.0);
+    // Parse component variants (misc/variants)
+    auto variantsPath = odbPath / "misc" / "variants";
+    if (fileExists(variantsPath)) {
+        parseVariants(job.getVariants(), variantsPath);
+    }
 
-    } catch (const std::exception& e) {
-        if (lastError_.empty()) {
-            lastError_ = e.what();
-        }
-        throw;
+    // Parse embedded components (misc/embedded or misc/embedded_passives)
+    auto embeddedPath = odbPath / "misc" / "embedded";
+    if (!fileExists(embeddedPath)) {
+        embeddedPath = odbPath / "misc" / "embedded_passives";
+    }
+    if (fileExists(embeddedPath)) {
+        parseEmbeddedComponents(job.getEmbeddedComponents(), embeddedPath);
     }
 
-    return job;
+    // Parse build-up information (misc/buildup)
+    auto buildupPath = odbPath / "misc" / "buildup";
+    if (fileExists(buildupPath)) {
+        parseBuildup(job.getBuildupInfo(), buildupPath);
+    }
+
+    // Parse VPL - Vendor Part List (misc/vpl)
+    auto vplPath = odbPath / "misc" / "vpl";
+    if (fileExists(vplPath)) {
+        parseVpl(job.getVendorParts(), vplPath);
+    }
+
+    // Parse customer information (misc/customer)
+    auto customerPath = odbPath / "misc" / "customer";
+    if (fileExists(customerPath)) {
+        parseCustomerInfo(job.getCustomerInfo(), customerPath);
+    }
 }
 
 LayerMatrix OdbReader::readMatrix(const std::filesystem::path& odbPath) {
     OdbJob tempJob;
+    if (!openSource(odbPath)) {
+        return tempJob.getMatrix();
+    }
     auto matrixPath = odbPath / "matrix" / "matrix";
     if (fileExists(matrixPath)) {
         parseMatrix(tempJob, matrixPath);
@@ -269,13 +576,14 @@ LayerMatrix OdbReader::readMatrix(const std::filesystem::path& odbPath) {
 
 std::vector<std::string> OdbReader::listSteps(const std::filesystem::path& odbPath) {
     std::vector<std::string> steps;
+    if (!openSource(odbPath)) {
+        return steps;
+    }
 
     auto stepsDir = odbPath / "steps";
-    if (std::filesystem::exists(stepsDir)) {
-        for (const auto& entry : std::filesystem::directory_iterator(stepsDir)) {
-            if (entry.is_directory()) {
-                steps.push_back(entry.path().filename().string());
-            }
+    if (fileExists(stepsDir)) {
+        for (const auto& dir : listDirectories(stepsDir)) {
+            steps.push_back(dir.filename().string());
         }
     }
 
@@ -284,8 +592,12 @@ std::vector<std::string> OdbReader::listSteps(const std::filesystem::path& odbPa
 
 std::unique_ptr<Step> OdbReader::readStep(const std::filesystem::path& odbPath,
                                           const std::string& stepName) {
+    if (!openSource(odbPath)) {
+        return nullptr;
+    }
+
     auto stepPath = odbPath / "steps" / stepName;
-    if (!std::filesystem::exists(stepPath)) {
+    if (!fileExists(stepPath)) {
         lastError_ = "Step not found: " + stepName;
         return nullptr;
     }
@@ -298,8 +610,12 @@ std::unique_ptr<Step> OdbReader::readStep(const std::filesystem::path& odbPath,
 std::unique_ptr<Layer> OdbReader::readLayer(const std::filesystem::path& odbPath,
                                             const std::string& stepName,
                                             const std::string& layerName) {
+    if (!openSource(odbPath)) {
+        return nullptr;
+    }
+
     auto layerPath = odbPath / "steps" / stepName / "layers" / layerName;
-    if (!std::filesystem::exists(layerPath)) {
+    if (!fileExists(layerPath)) {
         lastError_ = "Layer not found: " + stepName + "/" + layerName;
         return nullptr;
     }
@@ -391,19 +707,11 @@ void OdbReader::parseMatrix(OdbJob& job, const std::filesystem::path& matrixPath
             else if (key == "POLARITY") {
                 currentLayer.polarity = (value == "POSITIVE") ? Polarity::Positive : Polarity::Negative;
             }
-            else if (key == "START_NAME" && !value.empty()) {
-                try {
-                    currentLayer.startName = std::stoi(value);
-                } catch (const std::exception&) {
-                    // Invalid integer, keep default value
-                }
+            else if (key == "START_NAME") {
+                currentLayer.startName = value;
             }
-            else if (key == "END_NAME" && !value.empty()) {
-                try {
-                    currentLayer.endName = std::stoi(value);
-                } catch (const std::exception&) {
-                    // Invalid integer, keep default value
-                }
+            else if (key == "END_NAME") {
+                currentLayer.endName = value;
             }
         }
     }
@@ -426,6 +734,14 @@ void OdbReader::parseJobAttributes(OdbJob& job, const std::filesystem::path& att
 }
 
 void OdbReader::parseStep(Step& step, const std::filesystem::path& stepPath) {
+    std::vector<LoadTask> tasks;
+    prepareStep(step, stepPath, tasks);
+    runLoadTasks(tasks, 0.0, 1.0);
+    attachLoadTasks(tasks, nullptr);
+}
+
+void OdbReader::prepareStep(Step& step, const std::filesystem::path& stepPath,
+                            std::vector<LoadTask>& tasks) {
     // Parse step header
     auto stephdrPath = stepPath / "stephdr";
     if (fileExists(stephdrPath)) {
@@ -450,57 +766,35 @@ void OdbReader::parseStep(Step& step, const std::filesystem::path& stepPath) {
 
     // Parse layers
     auto layersDir = stepPath / "layers";
-    if (std::filesystem::exists(layersDir)) {
-        for (const auto& entry : std::filesystem::directory_iterator(layersDir)) {
-            if (entry.is_directory()) {
-                std::string layerName = entry.path().filename().string();
-
-                // Check layer filter
-                if (!options_.layerFilter.empty() &&
-                    std::find(options_.layerFilter.begin(), options_.layerFilter.end(), layerName)
-                    == options_.layerFilter.end()) {
-                    continue;
-                }
-
-                auto layer = std::make_unique<Layer>(layerName);
-                parseLayer(*layer, entry.path());
-                step.addLayer(std::move(layer));
+    if (fileExists(layersDir)) {
+        for (const auto& dir : listDirectories(layersDir)) {
+            std::string layerName = dir.filename().string();
+
+            // Check layer filter
+            if (!options_.layerFilter.empty() &&
+                std::find(options_.layerFilter.begin(), options_.layerFilter.end(), layerName)
+                == options_.layerFilter.end()) {
+                continue;
             }
-        }
-    }
-
-    // Parse EDA data
-    if (options_.loadEdaData) {
-        auto edaPath = stepPath / "eda" / "data";
-        if (fileExists(edaPath)) {
-            parseEdaData(step.getEdaData(), edaPath);
-            step.setHasEdaData(true);
-        }
-
-        // Parse BOM (eda/bom or eda/bom.csv)
-        auto bomPath = stepPath / "eda" / "bom";
-        if (!fileExists(bomPath)) {
-            bomPath = stepPath / "eda" / "bom.csv";
-        }
-        if (fileExists(bomPath)) {
-            parseBom(step.getEdaData(), bomPath);
-        }
 
-        // Parse netlist (eda/cadnet or eda/refnet)
-        auto cadnetPath = stepPath / "eda" / "cadnet";
-        if (fileExists(cadnetPath)) {
-            parseNetlist(step.getEdaData(), cadnetPath);
-        }
-        auto refnetPath = stepPath / "eda" / "refnet";
-        if (fileExists(refnetPath)) {
-            parseNetlist(step.getEdaData(), refnetPath);
+            LoadTask task;
+            task.kind = LoadTask::Kind::Layer;
+            task.path = dir;
+            task.step = &step;
+            task.layer = std::make_unique<Layer>(layerName);
+            task.label = "Read layer: " + step.getName() + "/" + layerName;
+            tasks.push_back(std::move(task));
         }
+    }
 
-        // Parse HDI netlist (eda/hdi)
-        auto hdiPath = stepPath / "eda" / "hdi";
-        if (fileExists(hdiPath)) {
-            parseHdiNetlist(step.getEdaData(), hdiPath);
-        }
+    // EDA data, BOM and netlists all fill the step's EdaData: one task
+    if (options_.loadEdaData && fileExists(stepPath / "eda")) {
+        LoadTask task;
+        task.kind = LoadTask::Kind::EdaData;
+        task.path = stepPath / "eda";
+        task.step = &step;
+        task.label = "Read EDA data: " + step.getName();
+        tasks.push_back(std::move(task));
     }
 
     // Parse zones (step-level zones)
@@ -516,6 +810,118 @@ void OdbReader::parseStep(Step& step, const std::filesystem::path& stepPath) {
     }
 }
 
+void OdbReader::prepareSymbols(const std::filesystem::path& symbolsDir,
+                               std::vector<LoadTask>& tasks) {
+    if (!fileExists(symbolsDir)) return;
+
+    for (const auto& dir : listDirectories(symbolsDir)) {
+        std::string name = dir.filename().string();
+        LoadTask task;
+        task.kind = LoadTask::Kind::Symbol;
+        task.path = dir;
+        task.symbol = std::make_unique<Symbol>(name);
+        task.label = "Read symbol: " + name;
+        tasks.push_back(std::move(task));
+    }
+}
+
+void OdbReader::runLoadTasks(std::vector<LoadTask>& tasks, double progressBegin,
+                             double progressEnd) {
+    size_t done = 0;
+    double total = static_cast<double>(std::max(size_t(1), tasks.size()));
+
+    util::parallelFor(tasks.size(), [&](size_t i) {
+        LoadTask& task = tasks[i];
+        switch (task.kind) {
+            case LoadTask::Kind::Layer:
+                parseLayer(*task.layer, task.path);
+                break;
+            case LoadTask::Kind::EdaData:
+                parseStepEdaData(*task.step, task.path);
+                break;
+            case LoadTask::Kind::Symbol:
+                parseSymbol(*task.symbol, task.path);
+                break;
+        }
+
+        std::lock_guard<std::mutex> lock(progressMutex_);
+        ++done;
+        if (progressCallback_) {
+            progressCallback_(task.label,
+                progressBegin + (progressEnd - progressBegin) * static_cast<double>(done) / total);
+        }
+    }, options_.threads);
+}
+
+void OdbReader::attachLoadTasks(std::vector<LoadTask>& tasks, OdbJob* job) {
+    for (auto& task : tasks) {
+        if (task.layer) {
+            task.step->addLayer(std::move(task.layer));
+        } else if (task.symbol && job) {
+            job->addSymbol(std::move(task.symbol));
+        }
+    }
+}
+
+bool OdbReader::isCacheable() const {
+    return options_.loadFeatures && options_.loadEdaData && options_.loadSymbols &&
+           options_.decompressFeatures && !options_.lazyFeatures &&
+           options_.stepFilter.empty() && options_.layerFilter.empty();
+}
+
+std::unique_ptr<LayerCache> OdbReader::makeLayerCache(std::vector<LoadTask>& tasks) const {
+    // Loads run on a private reader sharing the options and archive index
+    auto loader = std::make_shared<OdbReader>();
+    loader->options_ = options_;
+    loader->archive_ = archive_;
+    loader->archiveWriteTime_ = archiveWriteTime_;
+
+    auto cache = std::make_unique<LayerCache>(
+        [loader](const std::string& source, Layer& layer) {
+            loader->parseLayerFeatures(layer, source);
+        },
+        options_.featureCacheBytes);
+    for (auto& task : tasks) {
+        if (task.layer) {
+            cache->attach(*task.layer, task.path.string());
+        }
+    }
+    return cache;
+}
+
+void OdbReader::parseStepEdaData(Step& step, const std::filesystem::path& edaDir) {
+    auto edaPath = edaDir / "data";
+    if (fileExists(edaPath)) {
+        parseEdaData(step.getEdaData(), edaPath);
+        step.setHasEdaData(true);
+    }
+
+    // Parse BOM (eda/bom or eda/bom.csv)
+    auto bomPath = edaDir / "bom";
+    if (!fileExists(bomPath)) {
+        bomPath = edaDir / "bom.csv";
+    }
+    if (fileExists(bomPath)) {
+        parseBom(step.getEdaData(), bomPath);
+    }
+
+    // Parse netlist (eda/cadnet or eda/refnet)
+    auto cadnetPath = edaDir / "cadnet";
+    if (fileExists(cadnetPath)) {
+        parseNetlist(step.getEdaData(), cadnetPath);
+    }
+    auto refnetPath = edaDir / "refnet";
+    if (fileExists(refnetPath)) {
+        parseNetlist(step.getEdaData(), refnetPath);
+    }
+
+    // Parse HDI netlist (eda/hdi)
+    auto hdiPath = edaDir / "hdi";
+    if (fileExists(hdiPath)) {
+        parseHdiNetlist(step.getEdaData(), hdiPath);
+    }
+}
+
 void OdbReader::parseStepHeader(Step& step, const std::filesystem::path& stephdrPath) {
     std::string content = readFileContents(stephdrPath);
     std::istringstream stream(content);
@@ -633,101 +1039,99 @@ void OdbReader::parseLayer(Layer& layer, const std::filesystem::path& layerPath)
         }
     }
 
-    // Parse features
-    if (options_.loadFeatures) {
-        auto featuresPath = findFile(layerPath, "features");
-        if (fileExists(featuresPath)) {
-            parseFeatures(layer, featuresPath);
-        }
+    // Parse features (lazy layers are loaded through the job's LayerCache)
+    if (options_.loadFeatures && !options_.lazyFeatures) {
+        parseLayerFeatures(layer, layerPath);
+    }
+}
+
+void OdbReader::parseLayerFeatures(Layer& layer, const std::filesystem::path& layerPath) {
+    auto featuresPath = findFile(layerPath, "features");
+    if (fileExists(featuresPath)) {
+        parseFeatures(layer, featuresPath);
     }
 }
 
 void OdbReader::parseFeatures(Layer& layer, const std::filesystem::path& featuresPath) {
-    std::string content = readFileContents(featuresPath);
-    std::istringstream stream(content);
-    std::string line;
+    // Compressed features are inflated on a producer thread while parsing
+    std::string content;
+    std::unique_ptr<FeatureLines> lines;
+    if (featuresPath.extension() == ".z" && options_.decompressFeatures) {
+        std::unique_ptr<std::istream> in;
+        if (archive_) {
+            if (archive_->read(archiveMember(featuresPath), content)) {
+                in = std::make_unique<std::istringstream>(std::move(content));
+            }
+        } else {
+            auto file = std::make_unique<std::ifstream>(featuresPath, std::ios::binary);
+            if (*file) {
+                in = std::move(file);
+            }
+        }
+        if (!in) {
+            setError("Cannot open compressed file: " + featuresPath.string());
+            return;
+        }
+        lines = std::make_unique<FeatureLines>(std::move(in));
+    } else {
+        content = readFileContents(featuresPath);
+        lines = std::make_unique<FeatureLines>(content);
+    }
 
+    std::string_view line;
     std::vector<std::string> symbolNames;
-    std::vector<std::string> attrNames;
-    std::vector<std::string> attrStrings;
+    std::vector<int32_t> symbols;
+    FeatureStore& store = layer.getFeatures();
 
-    while (std::getline(stream, line)) {
-        line = trim(line);
+    while (lines->next(line)) {
         if (line.empty() || line[0] == '#') continue;
 
         // Units
-        if (line.find("UNITS=") == 0) {
-            layer.setUnits(line.substr(6));
-            continue;
-        }
-
-        // Symbol names section
-        if (line[0] == '$') {
-            // $<num> <name>
-            auto tokens = tokenize(line);
-            if (tokens.size() >= 2) {
-                std::string numStr = tokens[0].substr(1);
-                int num = std::stoi(numStr);
-                std::string name = tokens[1];
-
-                // Ensure vector is large enough
-                if (num >= static_cast<int>(symbolNames.size())) {
-                    symbolNames.resize(static_cast<size_t>(num) + 1);
-                }
-                symbolNames[static_cast<size_t>(num)] = name;
-            }
+        if (line.compare(0, 6, "UNITS=") == 0) {
+            layer.setUnits(std::string(line.substr(6)));
             continue;
         }
 
-        // Attribute names section
-        if (line[0] == '@') {
-            // @<num> <name>
-            auto tokens = tokenize(line);
-            if (tokens.size() >= 2) {
-                std::string numStr = tokens[0].substr(1);
-                int num = std::stoi(numStr);
-                std::string name = tokens[1];
-
-                if (num >= static_cast<int>(attrNames.size())) {
-                    attrNames.resize(static_cast<size_t>(num) + 1);
+        switch (line[0]) {
+            case '$': {
+                // Symbol names section: $<num> <name>
+                RecordFields record(line);
+                if (record.size() >= 2) {
+                    auto num = static_cast<size_t>(std::max(0, toInt(record[0].substr(1))));
+                    if (num >= symbolNames.size()) {
+                        symbolNames.resize(num + 1);
+                        symbols.resize(num + 1, -1);
+                    }
+                    symbolNames[num] = std::string(record[1]);
+                    symbols[num] = store.getSymbols().intern(symbolNames[num]);
                 }
-                attrNames[static_cast<size_t>(num)] = name;
-            }
-            continue;
-        }
-
-        // Attribute text strings
-        if (line[0] == '&') {
-            // &<num> <string>
-            auto pos = line.find(' ');
-            if (pos != std::string::npos) {
-                std::string numStr = line.substr(1, pos - 1);
-                int num = std::stoi(numStr);
-                std::string text = line.substr(pos + 1);
-
-                if (num >= static_cast<int>(attrStrings.size())) {
-                    attrStrings.resize(static_cast<size_t>(num) + 1);
+                break;
+            }
+            case '@':
+            case '&':
+                // Attribute name/text tables: feature attributes are not loaded
+                break;
+            case 'L':
+            case 'P':
+            case 'A':
+            case 'T':
+            case 'B':
+                parseFeatureLine(line, symbols, store);
+                break;
+            case 'S':
+                if (line.compare(0, 2, "SE") != 0) {
+                    // Surface feature - consumes lines up to SE
+                    layer.addFeature(parseSurfaceFeature(*lines, RecordFields(line)));
                 }
-                attrStrings[static_cast<size_t>(num)] = text;
-            }
-            continue;
+                break;
+            default:
+                break;
         }
+    }
 
-        // Parse features
-        if (line[0] == 'L' || line[0] == 'P' || line[0] == 'A' ||
-            line[0] == 'T' || line[0] == 'B') {
-            auto feature = parseFeatureLine(line, symbolNames);
-            if (feature) {
-                layer.addFeature(std::move(feature));
-            }
-        }
-        else if (line[0] == 'S' && line.find("SE") != 0) {
-            // Surface feature - need to read until SE
-            auto feature = parseSurfaceFeature(stream, line);
-            if (feature) {
-                layer.addFeature(std::move(feature));
-            }
-        }
+    auto error = lines->error();
+    if (!error.empty()) {
+        setError("Decompression error in " + featuresPath.string() + ": " + error);
     }
 
     layer.setSymbolNames(symbolNames);
@@ -1004,10 +1408,12 @@ void OdbReader::parseSymbol(Symbol& symbol, const std::filesystem::path& symbolP
         Layer tempLayer;
         parseFeatures(tempLayer, featuresPath);
 
-        // Move features to symbol
-        for (auto& f : tempLayer.getFeatures()) {
-            symbol.addFeature(std::move(f));
+        // Copy features to symbol
+        for (const auto& f : tempLayer.getFeatures()) {
+            symbol.addFeature(f.materialize());
         }
+        // Coordinates stay in the file's units
+        symbol.setUnit(tempLayer.getUnits() == "INCH" ? 'I' : 'M');
     }
 }
 
@@ -1928,9 +2334,11 @@ void OdbReader::parseUserSymbol(Symbol& symbol, const std::filesystem::path& sym
         Layer tempLayer;
         parseFeatures(tempLayer, featuresPath);
 
-        for (auto& f : tempLayer.getFeatures()) {
-            symbol.addFeature(std::move(f));
+        for (const auto& f : tempLayer.getFeatures()) {
+            symbol.addFeature(f.materialize());
         }
+        // Coordinates stay in the file's units
+        symbol.setUnit(tempLayer.getUnits() == "INCH" ? 'I' : 'M');
     }
 
     // Parse attributes
@@ -2012,8 +2420,8 @@ void OdbReader::parseFont(const std::filesystem::path& fontPath) {
 
     // For now, just validate the font exists
     // Full font parsing would create character graphics
-    if (!std::filesystem::exists(fontPath)) {
-        lastError_ = "Font path does not exist: " + fontPath.string();
+    if (!fileExists(fontPath)) {
+        setError("Font path does not exist: " + fontPath.string());
     }
 
     // Fonts are stored in Layer's font list during feature parsing
@@ -2612,156 +3020,123 @@ void OdbReader::parseCustomerInfo(CustomerInfo& info, const std::filesystem::pat
 // Feature Parsing
 // ============================================================================
 
-std::unique_ptr<Feature> OdbReader::parseFeatureLine(const std::string& line,
-                                                     const std::vector<std::string>& symbolNames) {
-    auto tokens = tokenize(line);
-    if (tokens.empty()) return nullptr;
-
-    char type = tokens[0][0];
+void OdbReader::parseFeatureLine(std::string_view line, const std::vector<int32_t>& symbols,
+                                 FeatureStore& store) {
+    RecordFields tokens(line);
+    if (tokens.size() == 0) return;
 
-    switch (type) {
+    switch (tokens[0][0]) {
         case 'L':
-            return parseLineFeature(tokens, symbolNames);
+            parseLineFeature(tokens, symbols, store);
+            break;
         case 'P':
-            return parsePadFeature(tokens, symbolNames);
+            parsePadFeature(tokens, symbols, store);
+            break;
         case 'A':
-            return parseArcFeature(tokens, symbolNames);
+            parseArcFeature(tokens, symbols, store);
+            break;
         case 'T':
-            return parseTextFeature(tokens);
+            if (auto text = parseTextFeature(tokens)) {
+                store.add(std::move(text));
+            }
+            break;
         default:
-            return nullptr;
+            break;
     }
 }
 
-std::unique_ptr<LineFeature> OdbReader::parseLineFeature(const std::vector<std::string>& tokens,
-                                                         const std::vector<std::string>& symbolNames) {
+void OdbReader::parseLineFeature(const RecordFields& tokens, const std::vector<int32_t>& symbols,
+                                 FeatureStore& store) {
     // L <xs> <ys> <xe> <ye> <sym_num> <polarity> <dcode>
-    if (tokens.size() < 7) return nullptr;
-
-    double xs = std::stod(tokens[1]);
-    double ys = std::stod(tokens[2]);
-    double xe = std::stod(tokens[3]);
-    double ye = std::stod(tokens[4]);
-    int symNum = std::stoi(tokens[5]);
-
-    std::string symbolName;
-    if (symNum >= 0 && static_cast<size_t>(symNum) < symbolNames.size()) {
-        symbolName = symbolNames[static_cast<size_t>(symNum)];
-    }
-
-    auto line = std::make_unique<LineFeature>(xs, ys, xe, ye, symbolName);
-    line->setSymbolIndex(symNum);
-
-    if (tokens[6] == "N") {
-        line->setPolarity(Polarity::Negative);
-    }
+    if (tokens.size() < 7) return;
 
-    if (tokens.size() > 7) {
-        line->setDcode(std::stoi(tokens[7]));
-    }
+    double xs = toDouble(tokens[1]);
+    double ys = toDouble(tokens[2]);
+    double xe = toDouble(tokens[3]);
+    double ye = toDouble(tokens[4]);
+    int32_t symbol = storeSymbol(toInt(tokens[5]), symbols);
+    Polarity polarity = (tokens[6] == "N") ? Polarity::Negative : Polarity::Positive;
+    int dcode = (tokens.size() > 7) ? toInt(tokens[7]) : 0;
 
-    return line;
+    store.addLine(xs, ys, xe, ye, symbol, polarity, dcode);
 }
 
-std::unique_ptr<PadFeature> OdbReader::parsePadFeature(const std::vector<std::string>& tokens,
-                                                       const std::vector<std::string>& symbolNames) {
+void OdbReader::parsePadFeature(const RecordFields& tokens, const std::vector<int32_t>& symbols,
+                                FeatureStore& store) {
     // P <x> <y> <apt_def> <polarity> <dcode> <orient_def>
-    if (tokens.size() < 6) return nullptr;
-
-    double x = std::stod(tokens[1]);
-    double y = std::stod(tokens[2]);
+    if (tokens.size() < 6) return;
 
-    auto pad = std::make_unique<PadFeature>();
-    pad->setPosition(x, y);
+    double x = toDouble(tokens[1]);
+    double y = toDouble(tokens[2]);
 
     // Parse apt_def (can be -1 <sym_num> <resize> or just <sym_num>)
     size_t idx = 3;
-    int symNum = std::stoi(tokens[idx]);
+    int symNum = toInt(tokens[idx]);
+    bool hasResize = false;
+    double resizeFactor = 0.0;
 
     if (symNum == -1 && tokens.size() > idx + 2) {
         // Resized symbol
-        pad->setHasResize(true);
-        symNum = std::stoi(tokens[++idx]);
-        pad->setResizeFactor(std::stod(tokens[++idx]));
-    }
-
-    if (symNum >= 0 && static_cast<size_t>(symNum) < symbolNames.size()) {
-        pad->setSymbolName(symbolNames[static_cast<size_t>(symNum)]);
+        hasResize = true;
+        symNum = toInt(tokens[++idx]);
+        resizeFactor = toDouble(tokens[++idx]);
     }
-    pad->setSymbolIndex(symNum);
 
+    Polarity polarity = Polarity::Positive;
     ++idx;
     if (idx < tokens.size() && tokens[idx] == "N") {
-        pad->setPolarity(Polarity::Negative);
+        polarity = Polarity::Negative;
     }
 
+    int dcode = 0;
     ++idx;
     if (idx < tokens.size()) {
-        pad->setDcode(std::stoi(tokens[idx]));
+        dcode = toInt(tokens[idx]);
     }
 
     // Parse orientation
+    double rotation = 0.0;
+    bool mirror = false;
     ++idx;
     if (idx < tokens.size()) {
-        double rotation = 0.0;
-        bool mirror = false;
         parseOrientDef(tokens[idx], rotation, mirror);
 
         // Check for additional rotation angle
         if ((tokens[idx] == "8" || tokens[idx] == "9") && idx + 1 < tokens.size()) {
-            rotation = std::stod(tokens[idx + 1]);
+            rotation = toDouble(tokens[idx + 1]);
         }
-
-        pad->setRotation(rotation);
-        pad->setMirrored(mirror);
     }
 
-    return pad;
+    store.addPad(x, y, storeSymbol(symNum, symbols), polarity, dcode,
+                 rotation, mirror, hasResize, resizeFactor);
 }
 
-std::unique_ptr<ArcFeature> OdbReader::parseArcFeature(const std::vector<std::string>& tokens,
-                                                       const std::vector<std::string>& symbolNames) {
+void OdbReader::parseArcFeature(const RecordFields& tokens, const std::vector<int32_t>& symbols,
+                                FeatureStore& store) {
     // A <xs> <ys> <xe> <ye> <xc> <yc> <sym_num> <polarity> <dcode> <cw>
-    if (tokens.size() < 10) return nullptr;
-
-    double xs = std::stod(tokens[1]);
-    double ys = std::stod(tokens[2]);
-    double xe = std::stod(tokens[3]);
-    double ye = std::stod(tokens[4]);
-    double xc = std::stod(tokens[5]);
-    double yc = std::stod(tokens[6]);
-    int symNum = std::stoi(tokens[7]);
-
-    std::string symbolName;
-    if (symNum >= 0 && static_cast<size_t>(symNum) < symbolNames.size()) {
-        symbolName = symbolNames[static_cast<size_t>(symNum)];
-    }
-
-    bool cw = (tokens[10] == "Y");
-
-    auto arc = std::make_unique<ArcFeature>(xs, ys, xe, ye, xc, yc, symbolName, cw);
-    arc->setSymbolIndex(symNum);
-
-    if (tokens[8] == "N") {
-        arc->setPolarity(Polarity::Negative);
-    }
-
-    arc->setDcode(std::stoi(tokens[9]));
-
-    return arc;
+    if (tokens.size() < 10) return;
+
+    double xs = toDouble(tokens[1]);
+    double ys = toDouble(tokens[2]);
+    double xe = toDouble(tokens[3]);
+    double ye = toDouble(tokens[4]);
+    double xc = toDouble(tokens[5]);
+    double yc = toDouble(tokens[6]);
+    int32_t symbol = storeSymbol(toInt(tokens[7]), symbols);
+    Polarity polarity = (tokens[8] == "N") ? Polarity::Negative : Polarity::Positive;
+    int dcode = toInt(tokens[9]);
+    bool cw = tokens.size() > 10 && tokens[10] == "Y";
+
+    store.addArc(xs, ys, xe, ye, xc, yc, symbol, cw, polarity, dcode);
 }
 
-std::unique_ptr<TextFeature> OdbReader::parseTextFeature(const std::vector<std::string>& tokens) {
+std::unique_ptr<TextFeature> OdbReader::parseTextFeature(const RecordFields& tokens) {
     // T <x> <y> <font> <polarity> <orient_def> <xsize> <ysize> <width_factor> <text> <version>
     if (tokens.size() < 10) return nullptr;
 
-    double x = std::stod(tokens[1]);
-    double y = std::stod(tokens[2]);
-    std::string font = tokens[3];
-
     auto text = std::make_unique<TextFeature>();
-    text->setPosition(x, y);
-    text->setFont(font);
+    text->setPosition(toDouble(tokens[1]), toDouble(tokens[2]));
+    text->setFont(std::string(tokens[3]));
 
     if (tokens[4] == "N") {
         text->setPolarity(Polarity::Negative);
@@ -2773,61 +3148,59 @@ std::unique_ptr<TextFeature> OdbReader::parseTextFeature(const std::vector<std::
     parseOrientDef(tokens[5], rotation, mirror);
     size_t nextIdx = 6;
     if ((tokens[5] == "8" || tokens[5] == "9") && tokens.size() > 6) {
-        rotation = std::stod(tokens[6]);
+        rotation = toDouble(tokens[6]);
         nextIdx = 7;
     }
     text->setRotation(rotation);
     text->setMirrored(mirror);
 
     if (nextIdx + 2 < tokens.size()) {
-        text->setSize(std::stod(tokens[nextIdx]), std::stod(tokens[nextIdx + 1]));
+        text->setSize(toDouble(tokens[nextIdx]), toDouble(tokens[nextIdx + 1]));
         nextIdx += 2;
     }
 
     if (nextIdx < tokens.size()) {
-        text->setWidthFactor(std::stod(tokens[nextIdx]));
+        text->setWidthFactor(toDouble(tokens[nextIdx]));
         nextIdx++;
     }
 
     // Text string (may be quoted)
     if (nextIdx < tokens.size()) {
-        std::string textStr = tokens[nextIdx];
+        std::string_view textStr = tokens[nextIdx];
         // Remove quotes
         if (textStr.size() >= 2 &&
             ((textStr.front() == '\'' && textStr.back() == '\'') ||
              (textStr.front() == '"' && textStr.back() == '"'))) {
             textStr = textStr.substr(1, textStr.size() - 2);
         }
-        text->setText(textStr);
+        text->setText(std::string(textStr));
         nextIdx++;
     }
 
     if (nextIdx < tokens.size()) {
-        text->setVersion(std::stoi(tokens[nextIdx]));
+        text->setVersion(toInt(tokens[nextIdx]));
     }
 
     return text;
 }
 
-std::unique_ptr<SurfaceFeature> OdbReader::parseSurfaceFeature(std::istream& stream,
-                                                               const std::string& firstLine) {
+std::unique_ptr<SurfaceFeature> OdbReader::parseSurfaceFeature(FeatureLines& lines,
+                                                               const RecordFields& header) {
     auto surface = std::make_unique<SurfaceFeature>();
 
-    // Parse first line: S <polarity> <dcode>;...
-    auto tokens = tokenize(firstLine);
-    if (tokens.size() >= 2 && tokens[1] == "N") {
+    // Header: S <polarity> <dcode>;...
+    if (header.size() >= 2 && header[1] == "N") {
         surface->setPolarity(Polarity::Negative);
     }
-    if (tokens.size() >= 3) {
-        surface->setDcode(std::stoi(tokens[2]));
+    if (header.size() >= 3) {
+        surface->setDcode(toInt(header[2]));
     }
 
     // Parse contours
-    std::string line;
-    std::unique_ptr<Contour> currentContour;
+    std::string_view line;
+    std::optional<Contour> currentContour;
 
-    while (std::getline(stream, line)) {
-        line = trim(line);
+    while (lines.next(line)) {
         if (line.empty() || line[0] == '#') continue;
 
         if (line == "SE") {
@@ -2838,28 +3211,24 @@ std::unique_ptr<SurfaceFeature> OdbReader::parseSurfaceFeature(std::istream& str
             break;
         }
 
-        tokens = tokenize(line);
-        if (tokens.empty()) continue;
+        RecordFields tokens(line);
+        if (tokens.size() == 0) continue;
 
         if (tokens[0] == "OB" && tokens.size() >= 4) {
             if (currentContour) {
                 surface->addContour(std::move(*currentContour));
             }
-            double x = std::stod(tokens[1]);
-            double y = std::stod(tokens[2]);
             PolygonType type = (tokens[3] == "H") ? PolygonType::Hole : PolygonType::Island;
-            currentContour = std::make_unique<Contour>(x, y, type);
+            currentContour.emplace(toDouble(tokens[1]), toDouble(tokens[2]), type);
         }
         else if (tokens[0] == "OS" && tokens.size() >= 3 && currentContour) {
-            double x = std::stod(tokens[1]);
-            double y = std::stod(tokens[2]);
-            currentContour->addLineSegment(x, y);
+            currentContour->addLineSegment(toDouble(tokens[1]), toDouble(tokens[2]));
         }
         else if (tokens[0] == "OC" && tokens.size() >= 6 && currentContour) {
-            double xe = std::stod(tokens[1]);
-            double ye = std::stod(tokens[2]);
-            double xc = std::stod(tokens[3]);
-            double yc = std::stod(tokens[4]);
+            double xe = toDouble(tokens[1]);
+            double ye = toDouble(tokens[2]);
+            double xc = toDouble(tokens[3]);
+            double yc = toDouble(tokens[4]);
             bool cw = (tokens[5] == "Y");
             currentContour->addArcSegment(xe, ye, xc, yc, cw);
         }
@@ -2877,37 +3246,64 @@ std::unique_ptr<SurfaceFeature> OdbReader::parseSurfaceFeature(std::istream& str
 // ============================================================================
 
 std::string OdbReader::decompressFile(const std::filesystem::path& compressedPath) {
-    // Open compressed file
-    gzFile gz = gzopen(compressedPath.string().c_str(), "rb");
-    if (!gz) {
-        lastError_ = "Cannot open compressed file: " + compressedPath.string();
+    std::ifstream file(compressedPath, std::ios::binary);
+    if (!file) {
+        setError("Cannot open compressed file: " + compressedPath.string());
         return "";
     }
 
-    // Read decompressed data in chunks
     std::string result;
-    constexpr size_t bufferSize = 65536;  // 64KB buffer
-    std::vector<char> buffer(bufferSize);
-
-    int bytesRead;
-    while ((bytesRead = gzread(gz, buffer.data(), static_cast<unsigned int>(bufferSize))) > 0) {
-        result.append(buffer.data(), static_cast<size_t>(bytesRead));
+    Inflater inflater;
+    auto append = [&](const char* data, size_t size) {
+        result.append(data, size);
+        return true;
+    };
+
+    std::vector<char> buffer(65536);  // 64KB input blocks
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        auto got = static_cast<size_t>(file.gcount());
+        if (got == 0 || !inflater.feed(buffer.data(), got, append)) break;
+    }
+
+    if (!inflater.complete()) {
+        setError("Decompression error: " +
+                 (inflater.error().empty() ? std::string("truncated data") : inflater.error()));
+        return "";
     }
+    return result;
+}
 
-    // Check for errors
-    int errnum;
-    const char* errMsg = gzerror(gz, &errnum);
-    if (errnum != Z_OK && errnum != Z_STREAM_END) {
-        lastError_ = "Decompression error: " + std::string(errMsg ? errMsg : "unknown");
-        gzclose(gz);
+std::string OdbReader::decompressBuffer(const std::string& compressed) {
+    std::string result;
+    Inflater inflater;
+    inflater.feed(compressed.data(), compressed.size(), [&](const char* data, size_t size) {
+        result.append(data, size);
+        return true;
+    });
+
+    if (!inflater.complete()) {
+        setError("Decompression error: " +
+                 (inflater.error().empty() ? std::string("truncated data") : inflater.error()));
         return "";
     }
-
-    gzclose(gz);
     return result;
 }
 
 std::string OdbReader::readFileContents(const std::filesystem::path& filePath, bool decompress) {
+    if (archive_) {
+        std::string member = archiveMember(filePath);
+        std::string content;
+        if (filePath.extension() == ".z") {
+            if (!archive_->read(member, content)) return "";
+        } else if (archive_->read(member, content)) {
+            return content;
+        } else if (!archive_->read(member + ".z", content)) {
+            return "";
+        }
+        return decompress && options_.decompressFeatures ? decompressBuffer(content) : "";
+    }
+
     std::filesystem::path actualPath = filePath;
 
     // Check for compressed version
@@ -2933,7 +3329,7 @@ std::string OdbReader::readFileContents(const std::filesystem::path& filePath, b
     // Read plain file
     std::ifstream file(actualPath);
     if (!file) {
-        lastError_ = "Cannot open file: " + actualPath.string();
+        setError("Cannot open file: " + actualPath.string());
         return "";
     }
 
@@ -2942,12 +3338,85 @@ std::string OdbReader::readFileContents(const std::filesystem::path& filePath, b
     return buffer.str();
 }
 
+bool OdbReader::openSource(const std::filesystem::path& odbPath) {
+    if (!OdbArchive::isArchivePath(odbPath) || std::filesystem::is_directory(odbPath)) {
+        archive_.reset();
+        return true;
+    }
+
+    // Reuse the index while the archive is unchanged
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(odbPath, ec);
+    if (archive_ && archive_->getPath() == odbPath && archiveWriteTime_ == writeTime) {
+        return true;
+    }
+
+    auto archive = std::make_shared<OdbArchive>();
+    if (!archive->open(odbPath)) {
+        setError(archive->getLastError());
+        archive_.reset();
+        return false;
+    }
+    archive_ = std::move(archive);
+    archiveWriteTime_ = writeTime;
+    return true;
+}
+
+std::string OdbReader::archiveMember(const std::filesystem::path& path) const {
+    auto relative = path.lexically_relative(archive_->getPath()).generic_string();
+    return relative == "." ? std::string() : relative;
+}
+
+bool OdbReader::fileExists(const std::filesystem::path& path) const {
+    if (archive_) {
+        auto member = archiveMember(path);
+        return member.compare(0, 2, "..") != 0 && archive_->exists(member);
+    }
+    return std::filesystem::exists(path);
+}
+
+std::filesystem::path OdbReader::findFile(const std::filesystem::path& basePath,
+                                          const std::string& filename) const {
+    auto plain = basePath / filename;
+    if (fileExists(plain)) return plain;
+
+    auto compressed = basePath / (filename + ".z");
+    if (fileExists(compressed)) return compressed;
+
+    return plain;  // Return plain path even if not found
+}
+
+std::vector<std::filesystem::path> OdbReader::listDirectories(const std::filesystem::path& dirPath) const {
+    std::vector<std::filesystem::path> dirs;
+    if (archive_) {
+        for (const auto& name : archive_->listDirectories(archiveMember(dirPath))) {
+            dirs.push_back(dirPath / name);
+        }
+        return dirs;
+    }
+
+    if (!std::filesystem::is_directory(dirPath)) return dirs;
+    for (const auto& entry : std::filesystem::directory_iterator(dirPath)) {
+        if (entry.is_directory()) {
+            dirs.push_back(entry.path());
+        }
+    }
+    std::sort(dirs.begin(), dirs.end());
+    return dirs;
+}
+
 void OdbReader::reportProgress(const std::string& message, double progress) {
+    std::lock_guard<std::mutex> lock(progressMutex_);
     if (progressCallback_) {
         progressCallback_(message, progress);
     }
 }
 
+void OdbReader::setError(const std::string& message) {
+    std::lock_guard<std::mutex> lock(errorMutex_);
+    lastError_ = message;
+}
+
 std::unordered_map<std::string, std::string> OdbReader::parseStructuredFile(const std::string& content) {
     std::unordered_map<std::string, std::string> result;
     std::istringstream stream(content);
@@ -3009,10 +3478,10 @@ std::vector<std::string> OdbReader::tokenize(const std::string& line) {
     return tokens;
 }
 
-void OdbReader::parseOrientDef(const std::string& orientStr, double& rotation, bool& mirror) {
+void OdbReader::parseOrientDef(std::string_view orientStr, double& rotation, bool& mirror) {
     if (orientStr.empty()) return;
 
-    int orient = std::stoi(orientStr);
+    int orient = toInt(orientStr);
 
     switch (orient) {
         case 0: rotation = 0.0; mirror = false; break;
@@ -1,9 +1,12 @@
 #include <koo/ecad/OdbWriter.hpp>
+#include <koo/util/Parallel.hpp>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <future>
 #include <unordered_set>
 #include <zlib.h>
 
@@ -11,6 +14,35 @@ namespace koo::ecad {
 
 namespace {
 
+constexpr size_t kChunkFeatures = 8192;         // Features formatted per chunk
+constexpr size_t kSinkBufferSize = 1 << 18;     // Bytes gathered before a disk write or deflate call
+
+// Helper to append a number in fixed notation without trailing zeros
+void appendDouble(std::string& out, double value, int precision = 6) {
+    char buffer[400];
+    auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                   std::chars_format::fixed, precision);
+    if (ec != std::errc()) {
+        std::ostringstream fallback;
+        fallback << std::fixed << std::setprecision(precision) << value;
+        out += fallback.str();
+        return;
+    }
+    char* dot = std::find(buffer, end, '.');
+    if (dot != end) {
+        while (end > dot + 1 && end[-1] == '0') --end;
+        if (end == dot + 1) end = dot;
+    }
+    out.append(buffer, end);
+}
+
+// Helper to append an integer
+void appendInt(std::string& out, long long value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
 // Helper to convert layer type to string
 std::string layerTypeToString(LayerType type) {
     switch (type) {
@@ -111,6 +143,146 @@ std::string viaSpanTypeToString(ViaSpanType type) {
 
 } // anonymous namespace
 
+// ============================================================================
+// Output Sinks and File Tasks
+// ============================================================================
+
+class OdbWriter::OutputSink {
+public:
+    OutputSink(const std::filesystem::path& path, bool compress, int level, bool inMemory)
+        : path_(path), compress_(compress), inMemory_(inMemory) {
+        if (compress_) {
+            if (deflateInit(&stream_, level) != Z_OK) {
+                throw std::runtime_error("zlib compression failed");
+            }
+            deflating_ = true;
+        }
+        if (!inMemory_) {
+            file_.open(path_, std::ios::binary);
+            if (!file_) {
+                throw std::runtime_error("Failed to open file for writing: " + path_.string());
+            }
+        }
+    }
+
+    ~OutputSink() {
+        if (deflating_) deflateEnd(&stream_);
+    }
+
+    OutputSink(const OutputSink&) = delete;
+    OutputSink& operator=(const OutputSink&) = delete;
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    void write(const char* data, size_t size) {
+        if (!compress_) {
+            buffer_.append(data, size);
+        } else {
+            // Feed in pieces small enough for zlib's 32-bit counters
+            while (size > 0) {
+                size_t piece = std::min(size, size_t(1) << 30);
+                deflateChunk(data, piece, Z_NO_FLUSH);
+                data += piece;
+                size -= piece;
+            }
+        }
+        if (!inMemory_ && buffer_.size() >= kSinkBufferSize) flushToFile();
+    }
+
+    /// Finish the stream and close the file
+    void finish() {
+        if (compress_) deflateChunk(nullptr, 0, Z_FINISH);
+        if (!inMemory_) {
+            flushToFile();
+            file_.close();
+            if (!file_) {
+                throw std::runtime_error("Failed to write data to file: " + path_.string());
+            }
+        }
+    }
+
+    /// Everything written, for archive entries
+    std::string takeContent() { return std::move(buffer_); }
+
+private:
+    void deflateChunk(const char* data, size_t size, int flush) {
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        stream_.avail_in = static_cast<uInt>(size);
+        unsigned char out[1 << 16];
+        int result = Z_OK;
+        do {
+            stream_.next_out = out;
+            stream_.avail_out = sizeof(out);
+            result = deflate(&stream_, flush);
+            if (result == Z_STREAM_ERROR) {
+                throw std::runtime_error("zlib compression failed");
+            }
+            buffer_.append(reinterpret_cast<const char*>(out), sizeof(out) - stream_.avail_out);
+        } while (stream_.avail_out == 0 || (flush == Z_FINISH && result != Z_STREAM_END));
+    }
+
+    void flushToFile() {
+        file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        if (!file_.good()) {
+            throw std::runtime_error("Failed to write data to file: " + path_.string());
+        }
+        buffer_.clear();
+    }
+
+    std::filesystem::path path_;
+    bool compress_;
+    bool inMemory_;
+    bool deflating_ = false;
+    z_stream stream_{};
+    std::ofstream file_;
+    std::string buffer_;
+};
+
+struct OdbWriter::FileTask {
+    std::filesystem::path path;                             ///< Output path, ".z" included
+    bool compress = false;
+    std::function<void(OutputSink&, size_t)> produce;       ///< Writes the content (sink, threads)
+};
+
+bool OdbWriter::runFileTasks(std::vector<FileTask>& tasks) {
+    if (tasks.empty()) return true;
+    const size_t workers = util::resolveThreadCount(options_.threads);
+
+    // Threads left over when there are few files go to formatting inside them
+    const size_t inner = std::max<size_t>(1, workers / std::min(workers, tasks.size()));
+
+    // Archive entries are appended in queue order, a window of files at a time
+    const size_t window = archive_ ? workers * 2 : tasks.size();
+    for (size_t first = 0; first < tasks.size(); first += window) {
+        size_t last = std::min(first + window, tasks.size());
+        std::vector<std::string> contents(last - first);
+        std::vector<std::string> errors(last - first);
+        util::parallelFor(last - first, [&](size_t k) {
+            FileTask& task = tasks[first + k];
+            try {
+                OutputSink sink(task.path, task.compress, options_.compressionLevel, archive_ != nullptr);
+                task.produce(sink, inner);
+                sink.finish();
+                if (archive_) contents[k] = sink.takeContent();
+            } catch (const std::exception& e) {
+                errors[k] = e.what();
+            }
+        }, workers);
+
+        for (size_t k = 0; k < last - first; ++k) {
+            if (!errors[k].empty()) {
+                lastError_ = errors[k];
+                return false;
+            }
+            if (archive_ && !addArchiveFile(contents[k], tasks[first + k].path)) {
+                return false;
+            }
+            std::string().swap(contents[k]);
+        }
+    }
+    return true;
+}
+
 // ============================================================================
 // Main Write Functions
 // ============================================================================
@@ -125,7 +297,7 @@ bool OdbWriter::write(const OdbJob& job, const std::filesystem::path& odbPath,
     options_ = options;
 
     try {
-        // Check if directory exists
+        // Check if directory (or archive) exists
         if (std::filesystem::exists(odbPath)) {
             if (!options_.overwrite) {
                 lastError_ = "Directory already exists: " + odbPath.string();
@@ -133,7 +305,37 @@ bool OdbWriter::write(const OdbJob& job, const std::filesystem::path& odbPath,
             }
             std::filesystem::remove_all(odbPath);
         }
+    } catch (const std::exception& e) {
+        lastError_ = e.what();
+        return false;
+    }
 
+    if (!OdbArchive::isArchivePath(odbPath)) {
+        return writeJob(job, odbPath);
+    }
+
+    // Archive output: the same files are streamed into one .tgz/.tar
+    archive_ = std::make_unique<OdbArchiveWriter>();
+    archiveRoot_ = odbPath;
+    bool ok = archive_->open(odbPath, OdbArchive::archiveStem(odbPath), options_.compressionLevel) &&
+              writeJob(job, odbPath);
+    if (archive_->isOpen() && !archive_->close() && ok) {
+        ok = false;
+    }
+    if (!ok && lastError_.empty()) {
+        lastError_ = archive_->getLastError();
+    }
+    archive_.reset();
+
+    if (!ok) {
+        std::error_code ec;
+        std::filesystem::remove(odbPath, ec);
+    }
+    return ok;
+}
+
+bool OdbWriter::writeJob(const OdbJob& job, const std::filesystem::path& odbPath) {
+    try {
         reportProgress("Creating directory structure...", 0.0);
 
         // Create directory structure
@@ -163,10 +365,11 @@ bool OdbWriter::write(const OdbJob& job, const std::filesystem::path& odbPath,
             return false;
         }
 
-        // Write steps
+        // Write steps (layer features and EDA data are queued)
         const auto& stepNames = job.getStepNames();
         double stepProgress = 0.15;
-        double stepIncrement = 0.5 / static_cast<double>(std::max(size_t(1), stepNames.size()));
+        double stepIncrement = 0.2 / static_cast<double>(std::max(size_t(1), stepNames.size()));
+        std::vector<FileTask> tasks;
 
         for (const auto& stepName : stepNames) {
             reportProgress("Writing step: " + stepName, stepProgress);
@@ -174,7 +377,7 @@ bool OdbWriter::write(const OdbJob& job, const std::filesystem::path& odbPath,
             const Step* step = job.getStep(stepName);
             if (step) {
                 auto stepPath = odbPath / "steps" / stepName;
-                if (!writeStepDir(*step, stepPath)) {
+                if (!writeStepDir(*step, stepPath, tasks)) {
                     return false;
                 }
             }
@@ -182,22 +385,26 @@ bool OdbWriter::write(const OdbJob& job, const std::filesystem::path& odbPath,
             stepProgress += stepIncrement;
         }
 
-        // Write symbols
+        // Write symbols (queued as well)
         if (options_.writeSymbols) {
-            reportProgress("Writing symbols...", 0.7);
-
             const auto& symbolNames = job.getSymbolNames();
             for (const auto& symbolName : symbolNames) {
                 const Symbol* symbol = job.getSymbol(symbolName);
                 if (symbol && !symbol->isStandard()) {
                     auto symbolPath = odbPath / "symbols" / symbolName;
-                    if (!writeSymbolDir(*symbol, symbolPath)) {
+                    if (!writeSymbolDir(*symbol, symbolPath, tasks)) {
                         return false;
                     }
                 }
             }
         }
 
+        // Layers, EDA data and symbols are independent files
+        reportProgress("Writing layers, EDA data and symbols...", 0.35);
+        if (!runFileTasks(tasks)) {
+            return false;
+        }
+
         // Write stackup
         if (options_.writeStackup && !job.getStackup().empty()) {
             reportProgress("Writing stackup...", 0.75);
@@ -309,7 +516,7 @@ bool OdbWriter::writeMatrix(const OdbJob& job, const std::filesystem::path& odbP
 
     try {
         auto matrixDir = odbPath / "matrix";
-        std::filesystem::create_directories(matrixDir);
+        makeDirectories(matrixDir);
 
         auto matrixPath = matrixDir / "matrix";
         return writeMatrixFile(job, matrixPath);
@@ -348,7 +555,7 @@ bool OdbWriter::writeEdaData(const EdaData& eda, const std::filesystem::path& ed
     lastError_.clear();
 
     try {
-        std::filesystem::create_directories(edaPath);
+        makeDirectories(edaPath);
         auto dataPath = edaPath / "data";
         return writeEdaDataFile(eda, dataPath);
     } catch (const std::exception& e) {
@@ -375,14 +582,14 @@ bool OdbWriter::writeSymbol(const Symbol& symbol, const std::filesystem::path& s
 
 bool OdbWriter::createDirectoryStructure(const std::filesystem::path& odbPath) {
     try {
-        std::filesystem::create_directories(odbPath / "matrix");
-        std::filesystem::create_directories(odbPath / "steps");
-        std::filesystem::create_directories(odbPath / "symbols");
+        makeDirectories(odbPath / "matrix");
+        makeDirectories(odbPath / "steps");
+        makeDirectories(odbPath / "symbols");
         // NOTE: fonts directory reserved for future font writing implementation
-        std::filesystem::create_directories(odbPath / "fonts");
-        std::filesystem::create_directories(odbPath / "misc");
+        makeDirectories(odbPath / "fonts");
+        makeDirectories(odbPath / "misc");
         // NOTE: input directory is part of ODB++ spec for storing original input files
-        std::filesystem::create_directories(odbPath / "input");
+        makeDirectories(odbPath / "input");
         return true;
     } catch (const std::exception& e) {
         lastError_ = "Failed to create directory structure: " + std::string(e.what());
@@ -416,10 +623,10 @@ bool OdbWriter::writeMatrixFile(const OdbJob& job, const std::filesystem::path&
         out << "   NAME=" << layerDef.name << "\n";
         out << "   POLARITY=" << polarityToString(layerDef.polarity) << "\n";
 
-        if (layerDef.startName > 0) {
+        if (!layerDef.startName.empty()) {
             out << "   START_NAME=" << layerDef.startName << "\n";
         }
-        if (layerDef.endName > 0) {
+        if (!layerDef.endName.empty()) {
             out << "   END_NAME=" << layerDef.endName << "\n";
         }
         if (!layerDef.oldName.empty()) {
@@ -463,10 +670,16 @@ bool OdbWriter::writeJobAttributes(const OdbJob& job, const std::filesystem::pat
 // ============================================================================
 
 bool OdbWriter::writeStepDir(const Step& step, const std::filesystem::path& stepPath) {
+    std::vector<FileTask> tasks;
+    return writeStepDir(step, stepPath, tasks) && runFileTasks(tasks);
+}
+
+bool OdbWriter::writeStepDir(const Step& step, const std::filesystem::path& stepPath,
+                             std::vector<FileTask>& tasks) {
     try {
-        std::filesystem::create_directories(stepPath);
-        std::filesystem::create_directories(stepPath / "layers");
-        std::filesystem::create_directories(stepPath / "eda");
+        makeDirectories(stepPath);
+        makeDirectories(stepPath / "layers");
+        makeDirectories(stepPath / "eda");
 
         // Write stephdr
         auto stephdrPath = stepPath / "stephdr";
@@ -493,7 +706,7 @@ bool OdbWriter::writeStepDir(const Step& step, const std::filesystem::path& step
             const Layer* layer = step.getLayer(layerName);
             if (layer) {
                 auto layerPath = stepPath / "layers" / layerName;
-                if (!writeLayerDir(*layer, layerPath)) {
+                if (!writeLayerDir(*layer, layerPath, tasks)) {
                     return false;
                 }
             }
@@ -501,10 +714,7 @@ bool OdbWriter::writeStepDir(const Step& step, const std::filesystem::path& step
 
         // Write EDA data
         if (options_.writeEdaData) {
-            auto edaPath = stepPath / "eda" / "data";
-            if (!writeEdaDataFile(step.getEdaData(), edaPath)) {
-                return false;
-            }
+            addEdaDataTask(step.getEdaData(), stepPath / "eda" / "data", tasks);
         }
 
         return true;
@@ -597,14 +807,23 @@ bool OdbWriter::writeProfile(const std::vector<Contour>& profile,
 // ============================================================================
 
 bool OdbWriter::writeLayerDir(const Layer& layer, const std::filesystem::path& layerPath) {
+    std::vector<FileTask> tasks;
+    return writeLayerDir(layer, layerPath, tasks) && runFileTasks(tasks);
+}
+
+bool OdbWriter::writeLayerDir(const Layer& layer, const std::filesystem::path& layerPath,
+                              std::vector<FileTask>& tasks) {
     try {
-        std::filesystem::create_directories(layerPath);
+        makeDirectories(layerPath);
 
-        // Write features
-        auto featuresPath = layerPath / "features";
-        if (!writeFeatures(layer, featuresPath)) {
-            return false;
-        }
+        // Queue features
+        FileTask task;
+        task.compress = options_.compressFeatures;
+        task.path = task.compress ? layerPath / "features.z" : layerPath / "features";
+        task.produce = [this, &layer](OutputSink& sink, size_t threads) {
+            writeFeatures(layer, sink, threads);
+        };
+        tasks.push_back(std::move(task));
 
         // Write attrlist
         auto attrPath = layerPath / "attrlist";
@@ -620,74 +839,77 @@ bool OdbWriter::writeLayerDir(const Layer& layer, const std::filesystem::path& l
     }
 }
 
-bool OdbWriter::writeFeatures(const Layer& layer, const std::filesystem::path& featuresPath) {
-    std::ostringstream out;
+void OdbWriter::writeFeatures(const Layer& layer, OutputSink& sink, size_t threads) const {
+    std::string header;
 
-    // Build symbol list
-    auto symbolNames = buildSymbolList(layer);
+    // Symbol list: the layer's interned symbol table, already indexed by the feature columns.
+    // The pin keeps a cached layer resident while other files load theirs
+    LayerCache::Pin pin = layer.pin();
+    const FeatureStore& features = layer.getFeatures();
+    const auto& symbolNames = features.getSymbols().getStrings();
 
     // Write header
-    out << "#\n";
-    out << "# Layer: " << layer.getName() << "\n";
-    out << "#\n\n";
-    out << "UNITS=MM\n\n";
+    header += "#\n";
+    header += "# Layer: " + layer.getName() + "\n";
+    header += "#\n\n";
+    header += "UNITS=MM\n\n";
 
     // Write symbol names section
     // Format: $<index> <name>
     for (size_t i = 0; i < symbolNames.size(); ++i) {
-        out << "$" << i << " " << symbolNames[i] << "\n";
-    }
-    out << "\n";
-
-    // Write features
-    for (const auto& feature : layer.getFeatures()) {
-        writeFeature(out, *feature, symbolNames);
+        header += "$";
+        appendInt(header, static_cast<long long>(i));
+        header += " " + symbolNames[i] + "\n";
     }
+    header += "\n";
+    sink.write(header);
+
+    // Features go out in chunks: a batch is formatted in parallel while the
+    // previous one is deflated and written
+    const size_t count = features.size();
+    const size_t batch = kChunkFeatures * threads * 2;
+    std::vector<std::string> formatting;
+    std::vector<std::string> writing;
+    std::future<void> pending;
+    for (size_t first = 0; first < count; first += batch) {
+        size_t last = std::min(first + batch, count);
+        formatting.resize(util::blockCount(last - first, kChunkFeatures));
+        util::parallelFor(formatting.size(), [&](size_t chunk) {
+            std::string& text = formatting[chunk];
+            size_t from = first + chunk * kChunkFeatures;
+            size_t to = std::min(from + kChunkFeatures, last);
+            text.clear();
+            text.reserve((to - from) * 48);
+            for (size_t i = from; i < to; ++i) {
+                writeFeature(text, features, i);
+            }
+        }, threads);
 
-    // Compress if requested
-    if (options_.compressFeatures) {
-        return writeCompressedFile(out.str(), std::filesystem::path(featuresPath.string() + ".z"));
-    } else {
-        return writePlainFile(out.str(), featuresPath);
-    }
-}
-
-std::vector<std::string> OdbWriter::buildSymbolList(const Layer& layer) const {
-    std::vector<std::string> symbolNames;
-    std::unordered_set<std::string> seen;
-
-    for (const auto& feature : layer.getFeatures()) {
-        std::string symName;
-
-        if (auto* line = dynamic_cast<const LineFeature*>(feature.get())) {
-            symName = line->getSymbolName();
-        } else if (auto* pad = dynamic_cast<const PadFeature*>(feature.get())) {
-            symName = pad->getSymbolName();
-        } else if (auto* arc = dynamic_cast<const ArcFeature*>(feature.get())) {
-            symName = arc->getSymbolName();
-        }
-
-        if (!symName.empty() && seen.find(symName) == seen.end()) {
-            symbolNames.push_back(symName);
-            seen.insert(symName);
+        if (threads <= 1) {
+            for (const auto& text : formatting) sink.write(text);
+            continue;
         }
+        if (pending.valid()) pending.get();
+        formatting.swap(writing);
+        pending = std::async(std::launch::async, [&sink, &writing] {
+            for (const auto& text : writing) sink.write(text);
+        });
     }
-
-    return symbolNames;
+    if (pending.valid()) pending.get();
 }
 
 // ============================================================================
 // Feature Writing
 // ============================================================================
 
-void OdbWriter::writeFeature(std::ostream& out, const Feature& feature,
-                              const std::vector<std::string>& symbolNames) {
+void OdbWriter::writeFeature(std::string& out, const Feature& feature,
+                             const StringTable& symbols) const {
     if (auto* line = dynamic_cast<const LineFeature*>(&feature)) {
-        writeLineFeature(out, *line, symbolNames);
+        writeLineFeature(out, *line, symbols);
     } else if (auto* pad = dynamic_cast<const PadFeature*>(&feature)) {
-        writePadFeature(out, *pad, symbolNames);
+        writePadFeature(out, *pad, symbols);
     } else if (auto* arc = dynamic_cast<const ArcFeature*>(&feature)) {
-        writeArcFeature(out, *arc, symbolNames);
+        writeArcFeature(out, *arc, symbols);
     } else if (auto* text = dynamic_cast<const TextFeature*>(&feature)) {
         writeTextFeature(out, *text);
     } else if (auto* surface = dynamic_cast<const SurfaceFeature*>(&feature)) {
@@ -695,132 +917,237 @@ void OdbWriter::writeFeature(std::ostream& out, const Feature& feature,
     }
 }
 
-void OdbWriter::writeLineFeature(std::ostream& out, const LineFeature& line,
-                                  const std::vector<std::string>& symbolNames) {
-    int symIndex = getSymbolIndex(line.getSymbolName(), symbolNames);
+void OdbWriter::writeFeature(std::string& out, const FeatureStore& features, size_t index) const {
+    uint32_t row = features.getRow(index);
+    const char* polarity = features.getPolarity(index) == Polarity::Positive ? " P" : " N";
+    int dcode = features.getDcode(index);
+
+    switch (features.getType(index)) {
+        case FeatureType::Line: {
+            const auto& c = features.getLines();
+            out += "L ";
+            appendDouble(out, c.xs[row]);
+            out += ' ';
+            appendDouble(out, c.ys[row]);
+            out += ' ';
+            appendDouble(out, c.xe[row]);
+            out += ' ';
+            appendDouble(out, c.ye[row]);
+            out += ' ';
+            appendInt(out, std::max(c.symbol[row], 0));
+            out += polarity;
+            if (dcode > 0) {
+                out += ' ';
+                appendInt(out, dcode);
+            }
+            out += '\n';
+            break;
+        }
+        case FeatureType::Pad: {
+            const auto& c = features.getPads();
+            out += "P ";
+            appendDouble(out, c.x[row]);
+            out += ' ';
+            appendDouble(out, c.y[row]);
+            out += ' ';
+            appendInt(out, std::max(c.symbol[row], 0));
+            out += polarity;
+            out += ' ';
+            appendInt(out, dcode);
+            // Write orientation if not default
+            bool mirror = (c.flags[row] & FeatureStore::PadMirror) != 0;
+            if (std::abs(c.rotation[row]) > 0.001 || mirror) {
+                out += ' ';
+                appendInt(out, static_cast<int>(c.rotation[row]));
+                if (mirror) {
+                    out += " M";
+                }
+            }
+            out += '\n';
+            break;
+        }
+        case FeatureType::Arc: {
+            const auto& c = features.getArcs();
+            out += "A ";
+            appendDouble(out, c.xs[row]);
+            out += ' ';
+            appendDouble(out, c.ys[row]);
+            out += ' ';
+            appendDouble(out, c.xe[row]);
+            out += ' ';
+            appendDouble(out, c.ye[row]);
+            out += ' ';
+            appendDouble(out, c.xc[row]);
+            out += ' ';
+            appendDouble(out, c.yc[row]);
+            out += ' ';
+            appendInt(out, std::max(c.symbol[row], 0));
+            out += polarity;
+            out += ' ';
+            appendInt(out, dcode);
+            out += c.clockwise[row] ? " Y\n" : " N\n";
+            break;
+        }
+        default:
+            writeFeature(out, *features.getObject(row), features.getSymbols());
+            break;
+    }
+}
+
+void OdbWriter::writeLineFeature(std::string& out, const LineFeature& line,
+                                 const StringTable& symbols) const {
+    int symIndex = getSymbolIndex(line.getSymbolName(), symbols);
 
     auto start = line.getStart();
     auto end = line.getEnd();
-    out << "L " << formatDouble(start.x) << " " << formatDouble(start.y)
-        << " " << formatDouble(end.x) << " " << formatDouble(end.y)
-        << " " << symIndex
-        << " " << (line.getPolarity() == Polarity::Positive ? "P" : "N");
+    out += "L ";
+    appendDouble(out, start.x);
+    out += ' ';
+    appendDouble(out, start.y);
+    out += ' ';
+    appendDouble(out, end.x);
+    out += ' ';
+    appendDouble(out, end.y);
+    out += ' ';
+    appendInt(out, symIndex);
+    out += line.getPolarity() == Polarity::Positive ? " P" : " N";
 
     if (line.getDcode() > 0) {
-        out << " " << line.getDcode();
+        out += ' ';
+        appendInt(out, line.getDcode());
     }
 
-    out << "\n";
+    out += '\n';
 }
 
-void OdbWriter::writePadFeature(std::ostream& out, const PadFeature& pad,
-                                 const std::vector<std::string>& symbolNames) {
-    int symIndex = getSymbolIndex(pad.getSymbolName(), symbolNames);
+void OdbWriter::writePadFeature(std::string& out, const PadFeature& pad,
+                                const StringTable& symbols) const {
+    int symIndex = getSymbolIndex(pad.getSymbolName(), symbols);
 
     auto pos = pad.getPosition();
-    out << "P " << formatDouble(pos.x) << " " << formatDouble(pos.y)
-        << " " << symIndex
-        << " " << (pad.getPolarity() == Polarity::Positive ? "P" : "N");
+    out += "P ";
+    appendDouble(out, pos.x);
+    out += ' ';
+    appendDouble(out, pos.y);
+    out += ' ';
+    appendInt(out, symIndex);
+    out += pad.getPolarity() == Polarity::Positive ? " P" : " N";
 
     // Write dcode (required field, default to 0 if not set)
-    out << " " << pad.getDcode();
+    out += ' ';
+    appendInt(out, pad.getDcode());
 
     // Write orientation if not default
     double rotation = pad.getRotation();
     bool mirror = pad.isMirrored();
     if (std::abs(rotation) > 0.001 || mirror) {
-        out << " " << static_cast<int>(rotation);
+        out += ' ';
+        appendInt(out, static_cast<int>(rotation));
         if (mirror) {
-            out << " M";
+            out += " M";
         }
     }
 
-    out << "\n";
+    out += '\n';
 }
 
-void OdbWriter::writeArcFeature(std::ostream& out, const ArcFeature& arc,
-                                 const std::vector<std::string>& symbolNames) {
-    int symIndex = getSymbolIndex(arc.getSymbolName(), symbolNames);
+void OdbWriter::writeArcFeature(std::string& out, const ArcFeature& arc,
+                                const StringTable& symbols) const {
+    int symIndex = getSymbolIndex(arc.getSymbolName(), symbols);
 
     auto start = arc.getStart();
     auto end = arc.getEnd();
     auto center = arc.getCenter();
     // Format: A xs ys xe ye xc yc symNum polarity dcode cw
-    out << "A " << formatDouble(start.x) << " " << formatDouble(start.y)
-        << " " << formatDouble(end.x) << " " << formatDouble(end.y)
-        << " " << formatDouble(center.x) << " " << formatDouble(center.y)
-        << " " << symIndex
-        << " " << (arc.getPolarity() == Polarity::Positive ? "P" : "N")
-        << " " << arc.getDcode()
-        << " " << (arc.isClockwise() ? "Y" : "N");
-
-    out << "\n";
+    out += "A ";
+    appendDouble(out, start.x);
+    out += ' ';
+    appendDouble(out, start.y);
+    out += ' ';
+    appendDouble(out, end.x);
+    out += ' ';
+    appendDouble(out, end.y);
+    out += ' ';
+    appendDouble(out, center.x);
+    out += ' ';
+    appendDouble(out, center.y);
+    out += ' ';
+    appendInt(out, symIndex);
+    out += arc.getPolarity() == Polarity::Positive ? " P " : " N ";
+    appendInt(out, arc.getDcode());
+    out += arc.isClockwise() ? " Y\n" : " N\n";
 }
 
-void OdbWriter::writeTextFeature(std::ostream& out, const TextFeature& text) {
+void OdbWriter::writeTextFeature(std::string& out, const TextFeature& text) const {
     auto pos = text.getPosition();
-    out << "T " << formatDouble(pos.x) << " " << formatDouble(pos.y)
-        << " " << text.getFont()
-        << " " << (text.getPolarity() == Polarity::Positive ? "P" : "N")
-        << " " << static_cast<int>(text.getRotation())
-        << " " << (text.isMirrored() ? "M" : "N")
-        << " " << formatDouble(text.getXSize())
-        << " " << formatDouble(text.getYSize())
-        << " " << formatDouble(text.getWidthFactor())
-        << " '" << text.getText() << "'";
+    out += "T ";
+    appendDouble(out, pos.x);
+    out += ' ';
+    appendDouble(out, pos.y);
+    out += ' ';
+    out += text.getFont();
+    out += text.getPolarity() == Polarity::Positive ? " P " : " N ";
+    appendInt(out, static_cast<int>(text.getRotation()));
+    out += text.isMirrored() ? " M " : " N ";
+    appendDouble(out, text.getXSize());
+    out += ' ';
+    appendDouble(out, text.getYSize());
+    out += ' ';
+    appendDouble(out, text.getWidthFactor());
+    out += " '";
+    out += text.getText();
+    out += '\'';
 
     if (text.getVersion() > 0) {
-        out << " " << text.getVersion();
+        out += ' ';
+        appendInt(out, text.getVersion());
     }
 
-    out << "\n";
+    out += '\n';
 }
 
-void OdbWriter::writeSurfaceFeature(std::ostream& out, const SurfaceFeature& surface) {
-    out << "S " << (surface.getPolarity() == Polarity::Positive ? "P" : "N");
+void OdbWriter::writeSurfaceFeature(std::string& out, const SurfaceFeature& surface) const {
+    out += surface.getPolarity() == Polarity::Positive ? "S P" : "S N";
 
     if (surface.getDcode() > 0) {
-        out << " " << surface.getDcode();
+        out += ' ';
+        appendInt(out, surface.getDcode());
     }
 
-    out << "\n";
+    out += '\n';
 
     // Write contours
     for (const auto& contour : surface.getContours()) {
         auto start = contour.getStart();
-        out << "OB " << formatDouble(start.x) << " "
-            << formatDouble(start.y);
-
-        if (contour.getPolygonType() == PolygonType::Hole) {
-            out << " H";
-        } else {
-            out << " I";
-        }
-        out << "\n";
+        out += "OB ";
+        appendDouble(out, start.x);
+        out += ' ';
+        appendDouble(out, start.y);
+        out += contour.getPolygonType() == PolygonType::Hole ? " H\n" : " I\n";
 
         for (const auto& seg : contour.getSegments()) {
+            out += seg.type == ContourSegmentType::Arc ? "OC " : "OS ";
+            appendDouble(out, seg.x);
+            out += ' ';
+            appendDouble(out, seg.y);
             if (seg.type == ContourSegmentType::Arc) {
-                out << "OC " << formatDouble(seg.x) << " " << formatDouble(seg.y)
-                    << " " << formatDouble(seg.xc) << " " << formatDouble(seg.yc)
-                    << (seg.clockwise ? " Y" : " N") << "\n";
-            } else {
-                out << "OS " << formatDouble(seg.x) << " " << formatDouble(seg.y) << "\n";
+                out += ' ';
+                appendDouble(out, seg.xc);
+                out += ' ';
+                appendDouble(out, seg.yc);
+                out += seg.clockwise ? " Y" : " N";
             }
+            out += '\n';
         }
 
-        out << "OE\n";
+        out += "OE\n";
     }
 
-    out << "SE\n";
+    out += "SE\n";
 }
 
-int OdbWriter::getSymbolIndex(const std::string& symbolName,
-                               const std::vector<std::string>& symbolNames) const {
-    auto it = std::find(symbolNames.begin(), symbolNames.end(), symbolName);
-    if (it != symbolNames.end()) {
-        return static_cast<int>(std::distance(symbolNames.begin(), it));
-    }
-    return 0;
+int OdbWriter::getSymbolIndex(const std::string& symbolName, const StringTable& symbols) const {
+    return std::max(symbols.find(symbolName), 0);
 }
 
 // ============================================================================
@@ -828,8 +1155,25 @@ int OdbWriter::getSymbolIndex(const std::string& symbolName,
 // ============================================================================
 
 bool OdbWriter::writeEdaDataFile(const EdaData& eda, const std::filesystem::path& edaPath) {
-    std::ostringstream out;
+    std::vector<FileTask> tasks;
+    addEdaDataTask(eda, edaPath, tasks);
+    return runFileTasks(tasks);
+}
+
+void OdbWriter::addEdaDataTask(const EdaData& eda, const std::filesystem::path& edaPath,
+                               std::vector<FileTask>& tasks) const {
+    FileTask task;
+    task.compress = options_.compressFeatures;
+    task.path = task.compress ? std::filesystem::path(edaPath.string() + ".z") : edaPath;
+    task.produce = [this, &eda](OutputSink& sink, size_t) {
+        std::ostringstream out;
+        writeEdaContent(out, eda);
+        sink.write(out.str());
+    };
+    tasks.push_back(std::move(task));
+}
 
+void OdbWriter::writeEdaContent(std::ostream& out, const EdaData& eda) const {
     out << "#\n";
     out << "# EDA Data\n";
     out << "#\n\n";
@@ -857,15 +1201,9 @@ bool OdbWriter::writeEdaDataFile(const EdaData& eda, const std::filesystem::path
         writeBomData(out, eda);
     }
 
-    // Compress if requested
-    if (options_.compressFeatures) {
-        return writeCompressedFile(out.str(), std::filesystem::path(edaPath.string() + ".z"));
-    } else {
-        return writePlainFile(out.str(), edaPath);
-    }
 }
 
-void OdbWriter::writePackages(std::ostream& out, const EdaData& eda) {
+void OdbWriter::writePackages(std::ostream& out, const EdaData& eda) const {
     out << "#\n# Packages\n#\n";
 
     for (int i = 0; i < static_cast<int>(eda.getPackageCount()); ++i) {
@@ -915,7 +1253,7 @@ void OdbWriter::writePackages(std::ostream& out, const EdaData& eda) {
     }
 }
 
-void OdbWriter::writeComponents(std::ostream& out, const EdaData& eda) {
+void OdbWriter::writeComponents(std::ostream& out, const EdaData& eda) const {
     out << "#\n# Components\n#\n";
 
     for (const auto& refDes : eda.getComponentRefDes()) {
@@ -971,7 +1309,7 @@ void OdbWriter::writeComponents(std::ostream& out, const EdaData& eda) {
     }
 }
 
-void OdbWriter::writeNets(std::ostream& out, const EdaData& eda) {
+void OdbWriter::writeNets(std::ostream& out, const EdaData& eda) const {
     out << "#\n# Nets\n#\n";
 
     for (const auto& netName : eda.getNetNames()) {
@@ -1020,7 +1358,7 @@ void OdbWriter::writeNets(std::ostream& out, const EdaData& eda) {
     }
 }
 
-void OdbWriter::writeBomData(std::ostream& out, const EdaData& eda) {
+void OdbWriter::writeBomData(std::ostream& out, const EdaData& eda) const {
     const auto& bomItems = eda.getBomItems();
     if (bomItems.empty()) return;
 
@@ -1056,32 +1394,54 @@ void OdbWriter::writeBomData(std::ostream& out, const EdaData& eda) {
 // ============================================================================
 
 bool OdbWriter::writeSymbolDir(const Symbol& symbol, const std::filesystem::path& symbolPath) {
-    try {
-        std::filesystem::create_directories(symbolPath);
-
-        std::ostringstream out;
-
-        out << "#\n";
-        out << "# Symbol: " << symbol.getName() << "\n";
-        out << "#\n\n";
-        out << "UNITS=MM\n\n";
-
-        // Build symbol list from features
-        std::vector<std::string> symbolNames;
+    std::vector<FileTask> tasks;
+    return writeSymbolDir(symbol, symbolPath, tasks) && runFileTasks(tasks);
+}
 
-        // Write features
-        for (const auto& feature : symbol.getFeatures()) {
-            writeFeature(out, *feature, symbolNames);
-        }
+bool OdbWriter::writeSymbolDir(const Symbol& symbol, const std::filesystem::path& symbolPath,
+                               std::vector<FileTask>& tasks) {
+    try {
+        makeDirectories(symbolPath);
 
         auto featuresPath = symbolPath / "features";
+        FileTask task;
+        task.compress = options_.compressFeatures;
+        task.path = task.compress ? std::filesystem::path(featuresPath.string() + ".z") : featuresPath;
+        task.produce = [this, &symbol](OutputSink& sink, size_t) {
+            std::string out;
+            out += "#\n";
+            out += "# Symbol: " + symbol.getName() + "\n";
+            out += "#\n\n";
+            out += symbol.getUnit() == 'I' ? "UNITS=INCH\n\n" : "UNITS=MM\n\n";
+
+            // Build symbol list from features
+            StringTable symbols;
+            for (const auto& feature : symbol.getFeatures()) {
+                if (auto* line = dynamic_cast<const LineFeature*>(feature.get())) {
+                    symbols.intern(line->getSymbolName());
+                } else if (auto* pad = dynamic_cast<const PadFeature*>(feature.get())) {
+                    symbols.intern(pad->getSymbolName());
+                } else if (auto* arc = dynamic_cast<const ArcFeature*>(feature.get())) {
+                    symbols.intern(arc->getSymbolName());
+                }
+            }
+            for (size_t i = 0; i < symbols.size(); ++i) {
+                out += "$";
+                appendInt(out, static_cast<long long>(i));
+                out += " " + symbols.getStrings()[i] + "\n";
+            }
+            if (symbols.size() > 0) {
+                out += "\n";
+            }
 
-        if (options_.compressFeatures) {
-            return writeCompressedFile(out.str(),
-                                        std::filesystem::path(featuresPath.string() + ".z"));
-        } else {
-            return writePlainFile(out.str(), featuresPath);
-        }
+            // Write features
+            for (const auto& feature : symbol.getFeatures()) {
+                writeFeature(out, *feature, symbols);
+            }
+            sink.write(out);
+        };
+        tasks.push_back(std::move(task));
+        return true;
 
     } catch (const std::exception& e) {
         lastError_ = "Failed to write symbol: " + std::string(e.what());
@@ -1435,58 +1795,13 @@ bool OdbWriter::writeAttrList(const AttributeList& attrs,
 // Utility Functions
 // ============================================================================
 
-std::vector<uint8_t> OdbWriter::compressData(const std::string& data) {
-    std::vector<uint8_t> compressed;
-
-    uLongf compressedSize = compressBound(static_cast<uLong>(data.size()));
-    compressed.resize(compressedSize);
-
-    int result = compress2(
-        compressed.data(),
-        &compressedSize,
-        reinterpret_cast<const Bytef*>(data.data()),
-        static_cast<uLong>(data.size()),
-        options_.compressionLevel
-    );
-
-    if (result != Z_OK) {
-        throw std::runtime_error("zlib compression failed");
-    }
-
-    compressed.resize(compressedSize);
-    return compressed;
-}
-
-bool OdbWriter::writeCompressedFile(const std::string& content,
-                                     const std::filesystem::path& filePath) {
-    try {
-        auto compressed = compressData(content);
-
-        std::ofstream file(filePath, std::ios::binary);
-        if (!file) {
-            lastError_ = "Failed to open file for writing: " + filePath.string();
-            return false;
-        }
-
-        file.write(reinterpret_cast<const char*>(compressed.data()),
-                   static_cast<std::streamsize>(compressed.size()));
-
-        if (!file.good()) {
-            lastError_ = "Failed to write compressed data to file: " + filePath.string();
-            return false;
-        }
-
-        return true;
-
-    } catch (const std::exception& e) {
-        lastError_ = "Failed to write compressed file: " + std::string(e.what());
-        return false;
-    }
-}
-
 bool OdbWriter::writePlainFile(const std::string& content,
                                 const std::filesystem::path& filePath) {
     try {
+        if (archive_) {
+            return addArchiveFile(content, filePath);
+        }
+
         std::ofstream file(filePath);
         if (!file) {
             lastError_ = "Failed to open file for writing: " + filePath.string();
@@ -1508,6 +1823,24 @@ bool OdbWriter::writePlainFile(const std::string& content,
     }
 }
 
+void OdbWriter::makeDirectories(const std::filesystem::path& dirPath) {
+    if (!archive_) {
+        std::filesystem::create_directories(dirPath);
+        return;
+    }
+    if (!archive_->addDirectory(dirPath.lexically_relative(archiveRoot_).generic_string())) {
+        throw std::runtime_error(archive_->getLastError());
+    }
+}
+
+bool OdbWriter::addArchiveFile(const std::string& content, const std::filesystem::path& filePath) {
+    if (!archive_->addFile(filePath.lexically_relative(archiveRoot_).generic_string(), content)) {
+        lastError_ = archive_->getLastError();
+        return false;
+    }
+    return true;
+}
+
 void OdbWriter::reportProgress(const std::string& message, double progress) {
     if (progressCallback_) {
         progressCallback_(message, progress);
@@ -1515,21 +1848,8 @@ void OdbWriter::reportProgress(const std::string& message, double progress) {
 }
 
 std::string OdbWriter::formatDouble(double value, int precision) const {
-    std::ostringstream out;
-    out << std::fixed << std::setprecision(precision) << value;
-
-    // Remove trailing zeros
-    std::string result = out.str();
-    size_t dotPos = result.find('.');
-    if (dotPos != std::string::npos) {
-        size_t lastNonZero = result.find_last_not_of('0');
-        if (lastNonZero > dotPos) {
-            result = result.substr(0, lastNonZero + 1);
-        } else {
-            result = result.substr(0, dotPos);
-        }
-    }
-
+    std::string result;
+    appendDouble(result, value, precision);
     return result;
 }
 
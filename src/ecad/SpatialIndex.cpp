@@ -0,0 +1,173 @@
+#include <koo/ecad/SpatialIndex.hpp>
+#include <koo/util/Parallel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <tuple>
+
+namespace koo::ecad {
+
+namespace {
+
+constexpr size_t kBlockSize = 4096;
+constexpr size_t kBatchBlockSize = 64;
+constexpr uint32_t kHilbertMax = 0xFFFF;
+
+// Helper to compute the Hilbert curve distance of a point on a 2^16 grid
+uint64_t hilbertIndex(uint32_t x, uint32_t y) {
+    uint64_t d = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) ? 1u : 0u;
+        uint32_t ry = (y & s) ? 1u : 0u;
+        d += static_cast<uint64_t>(s) * s * ((3u * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = kHilbertMax - x;
+                y = kHilbertMax - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+// Helper to map a coordinate onto the Hilbert grid
+uint32_t gridCoordinate(double value, double min, double extent) {
+    if (extent <= 0.0) return 0;
+    double t = (value - min) / extent;
+    return static_cast<uint32_t>(std::clamp(t, 0.0, 1.0) * kHilbertMax);
+}
+
+// Helper to compute the distance from a point to a box (0 inside)
+double boxDistance(const BoundingBox2D& box, const Point2D& p) {
+    double dx = std::max({box.min.x - p.x, 0.0, p.x - box.max.x});
+    double dy = std::max({box.min.y - p.y, 0.0, p.y - box.max.y});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Building
+// ============================================================================
+
+void SpatialIndex::build(const std::vector<BoundingBox2D>& boxes, size_t threads) {
+    nodes_.clear();
+    levelStart_.clear();
+    order_.clear();
+    if (boxes.empty()) {
+        return;
+    }
+
+    BoundingBox2D bounds;
+    for (const auto& box : boxes) {
+        if (box.isValid()) bounds.expand(box);
+    }
+    double width = bounds.isValid() ? bounds.width() : 0.0;
+    double height = bounds.isValid() ? bounds.height() : 0.0;
+
+    // Sort items along the Hilbert curve through their box centers
+    std::vector<std::pair<uint64_t, uint32_t>> keys(boxes.size());
+    util::parallelForBlocks(boxes.size(), kBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Point2D c = boxes[i].isValid() ? boxes[i].center() : bounds.min;
+            keys[i] = {hilbertIndex(gridCoordinate(c.x, bounds.min.x, width),
+                                    gridCoordinate(c.y, bounds.min.y, height)),
+                       static_cast<uint32_t>(i)};
+        }
+    }, threads);
+    std::sort(keys.begin(), keys.end());
+
+    // Level 0: item boxes in curve order; each higher level packs kNodeSize children
+    size_t total = 0;
+    for (size_t count = boxes.size();; count = (count + kNodeSize - 1) / kNodeSize) {
+        total += count;
+        if (count == 1) break;
+    }
+    nodes_.reserve(total);
+    order_.reserve(boxes.size());
+    for (const auto& key : keys) {
+        order_.push_back(key.second);
+        nodes_.push_back(boxes[key.second]);
+    }
+
+    levelStart_.push_back(0);
+    size_t begin = 0;
+    size_t count = boxes.size();
+    while (count > 1) {
+        levelStart_.push_back(nodes_.size());
+        for (size_t child = 0; child < count; child += kNodeSize) {
+            BoundingBox2D box;
+            size_t end = std::min(child + kNodeSize, count);
+            for (size_t c = child; c < end; ++c) {
+                if (nodes_[begin + c].isValid()) box.expand(nodes_[begin + c]);
+            }
+            nodes_.push_back(box);
+        }
+        begin += count;
+        count = nodes_.size() - begin;
+    }
+    levelStart_.push_back(nodes_.size());
+}
+
+BoundingBox2D SpatialIndex::getBounds() const {
+    return nodes_.empty() ? BoundingBox2D() : nodes_.back();
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+std::vector<size_t> SpatialIndex::query(const BoundingBox2D& window) const {
+    std::vector<size_t> result;
+    visit(window, [&](size_t item) { result.push_back(item); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<size_t> SpatialIndex::queryPoint(const Point2D& point) const {
+    return query(BoundingBox2D(point, point));
+}
+
+size_t SpatialIndex::nearest(const Point2D& point, double* distance) const {
+    if (order_.empty()) {
+        return npos;
+    }
+
+    // Best-first search: (distance, level, node), closest first
+    using Entry = std::tuple<double, size_t, size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    size_t top = levelStart_.size() - 2;
+    queue.emplace(boxDistance(nodes_[levelStart_[top]], point), top, 0);
+
+    while (!queue.empty()) {
+        auto [dist, level, node] = queue.top();
+        queue.pop();
+        if (level == 0) {
+            if (distance) *distance = dist;
+            return order_[node];
+        }
+        size_t child = node * kNodeSize;
+        size_t end = std::min(child + kNodeSize, levelSize(level - 1));
+        for (; child < end; ++child) {
+            const auto& box = nodes_[levelStart_[level - 1] + child];
+            if (box.isValid()) {
+                queue.emplace(boxDistance(box, point), level - 1, child);
+            }
+        }
+    }
+    return npos;
+}
+
+std::vector<std::vector<size_t>> SpatialIndex::queryBatch(const std::vector<BoundingBox2D>& windows,
+                                                          size_t threads) const {
+    std::vector<std::vector<size_t>> results(windows.size());
+    util::parallelForBlocks(windows.size(), kBatchBlockSize, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            results[i] = query(windows[i]);
+        }
+    }, threads);
+    return results;
+}
+
+} // namespace koo::ecad
@@ -1,6 +1,5 @@
 #include <koo/ecad/Step.hpp>
 #include <algorithm>
-#include <set>
 
 namespace koo::ecad {
 
@@ -18,10 +17,18 @@ const Layer* Step::getLayer(const std::string& name) const {
 
 void Step::addLayer(std::unique_ptr<Layer> layer) {
     if (layer) {
+        if (symbolCache_) layer->setSymbolCache(symbolCache_);
         layers_[layer->getName()] = std::move(layer);
     }
 }
 
+void Step::setSymbolCache(const SymbolCache* symbols) {
+    symbolCache_ = symbols;
+    for (auto& pair : layers_) {
+        pair.second->setSymbolCache(symbols);
+    }
+}
+
 std::vector<std::string> Step::getLayerNames() const {
     std::vector<std::string> names;
     names.reserve(layers_.size());
@@ -109,23 +116,25 @@ std::vector<DrillLayer*> Step::getDrillLayers() {
 }
 
 std::vector<std::string> Step::getAllNetNames() const {
-    std::set<std::string> netNames;
+    StringTable names;
 
     // From EDA data
-    for (const auto& name : edaData_.getNetNames()) {
-        netNames.insert(name);
+    for (const auto& net : edaData_.getNets()) {
+        names.intern(net->getName());
     }
 
-    // From features
+    // From the layers' interned net tables; cached layers come straight from
+    // features files, which carry no net names, so they are not loaded
     for (const auto& pair : layers_) {
-        for (const auto& feature : pair.second->getFeatures()) {
-            if (!feature->getNetName().empty()) {
-                netNames.insert(feature->getNetName());
-            }
+        if (pair.second->isCached()) continue;
+        for (const auto& name : pair.second->getFeatures().getNets().getStrings()) {
+            names.intern(name);
         }
     }
 
-    return std::vector<std::string>(netNames.begin(), netNames.end());
+    std::vector<std::string> netNames = names.getStrings();
+    std::sort(netNames.begin(), netNames.end());
+    return netNames;
 }
 
 } // namespace koo::ecad
@@ -0,0 +1,187 @@
+#include <koo/ecad/StepInstances.hpp>
+#include <koo/ecad/OdbJob.hpp>
+#include <algorithm>
+
+namespace koo::ecad {
+
+namespace {
+
+// Helper to test two boxes for overlap
+bool overlaps(const BoundingBox2D& a, const BoundingBox2D& b) {
+    return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+           a.min.y <= b.max.y && a.max.y >= b.min.y;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// StepInstances - Expansion
+// ============================================================================
+
+StepInstances::StepInstances(const OdbJob& job, const Step& root) : job_(job) {
+    std::vector<const Step*> path;
+    expand(root, Transform2D(), StepInstance::npos, 0, 0, 0, path);
+}
+
+void StepInstances::expand(const Step& step, const Transform2D& transform, size_t parent,
+                           size_t repeat, int column, int row, std::vector<const Step*>& path) {
+    StepInstance instance;
+    instance.step = &step;
+    instance.transform = transform;
+    instance.parent = parent;
+    instance.repeat = repeat;
+    instance.column = column;
+    instance.row = row;
+    instance.depth = path.size();
+    size_t self = instances_.size();
+    instances_.push_back(instance);
+
+    path.push_back(&step);
+    const auto& repeats = step.getStepRepeats();
+    for (size_t r = 0; r < repeats.size(); ++r) {
+        const StepRepeat& sr = repeats[r];
+        const Step* child = job_.getStep(sr.stepName);
+        if (!child) {
+            warnings_.push_back("Step '" + step.getName() + "' repeats missing step '" + sr.stepName + "'");
+            continue;
+        }
+        if (std::find(path.begin(), path.end(), child) != path.end()) {
+            warnings_.push_back("Step '" + step.getName() + "' repeats '" + sr.stepName + "' recursively");
+            continue;
+        }
+
+        // Child datum -> placement point, oriented by the repeat
+        Point2D datum = child->getDatum();
+        for (int j = 0; j < sr.ny; ++j) {
+            for (int i = 0; i < sr.nx; ++i) {
+                Transform2D place(sr.angle, sr.mirror, {sr.x + i * sr.dx, sr.y + j * sr.dy});
+                Transform2D local = place * Transform2D(0.0, false, {-datum.x, -datum.y});
+                expand(*child, transform * local, self, r, i, j, path);
+            }
+        }
+    }
+    path.pop_back();
+}
+
+// ============================================================================
+// StepInstances - Lazy Iteration
+// ============================================================================
+
+const Layer* StepInstances::getLayer(size_t instance, const std::string& layerName) const {
+    return instance < instances_.size() ? instances_[instance].step->getLayer(layerName) : nullptr;
+}
+
+size_t StepInstances::getFeatureCount(const std::string& layerName) const {
+    size_t count = 0;
+    for (const auto& instance : instances_) {
+        if (const Layer* layer = instance.step->getLayer(layerName)) {
+            count += layer->getFeatureCount();
+        }
+    }
+    return count;
+}
+
+std::unique_ptr<Feature> StepInstances::getFeature(const std::string& layerName,
+                                                   const InstanceFeature& ref) const {
+    const Layer* layer = getLayer(ref.instance, layerName);
+    if (!layer || ref.feature >= layer->getFeatureCount()) return nullptr;
+    auto feature = layer->getFeatures()[ref.feature].materialize();
+    feature->transform(instances_[ref.instance].transform);
+    return feature;
+}
+
+BoundingBox2D StepInstances::getBoundingBox(const std::string& layerName,
+                                            const InstanceFeature& ref) const {
+    const Layer* layer = getLayer(ref.instance, layerName);
+    if (!layer || ref.feature >= layer->getFeatureCount()) return BoundingBox2D();
+    return instances_[ref.instance].transform.apply(layer->getFeatures().getBoundingBox(ref.feature));
+}
+
+BoundingBox2D StepInstances::getBoundingBox(const std::string& layerName) const {
+    BoundingBox2D box;
+    for (const auto& instance : instances_) {
+        if (const Layer* layer = instance.step->getLayer(layerName)) {
+            box.expand(instance.transform.apply(layer->getExtent()));
+        }
+    }
+    return box;
+}
+
+// ============================================================================
+// StepInstances - Spatial Queries
+// ============================================================================
+
+const SpatialIndex& StepInstances::instanceIndex(const std::string& layerName) const {
+    std::lock_guard<std::mutex> lock(indexMutex_);
+    auto& index = instanceIndex_[layerName];
+    if (!index) {
+        std::vector<BoundingBox2D> bounds(instances_.size());
+        for (size_t i = 0; i < instances_.size(); ++i) {
+            if (const Layer* layer = instances_[i].step->getLayer(layerName)) {
+                bounds[i] = instances_[i].transform.apply(layer->getExtent());
+            }
+        }
+        index = std::make_unique<SpatialIndex>(bounds, 1);
+    }
+    return *index;
+}
+
+std::vector<InstanceFeature> StepInstances::query(const std::string& layerName,
+                                                  const BoundingBox2D& window) const {
+    std::vector<InstanceFeature> result;
+    for (size_t i : instanceIndex(layerName).query(window)) {
+        const StepInstance& instance = instances_[i];
+        const Layer* layer = instance.step->getLayer(layerName);
+
+        // Search the step with the window mapped back into its coordinates,
+        // then keep what really overlaps once placed (rotations widen the box)
+        BoundingBox2D local = instance.transform.inverse().apply(window);
+        const auto& extents = layer->getFeatureExtents();
+        for (size_t feature : layer->getFeaturesInArea(local)) {
+            BoundingBox2D placed = instance.transform.apply(extents[feature]);
+            if (overlaps(placed, window)) {
+                result.push_back({i, feature});
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<InstanceFeature> StepInstances::queryPoint(const std::string& layerName,
+                                                       const Point2D& point) const {
+    return query(layerName, BoundingBox2D(point, point));
+}
+
+// ============================================================================
+// StepInstances - Materialization
+// ============================================================================
+
+std::unique_ptr<Layer> StepInstances::materialize(const std::string& layerName, size_t threads) const {
+    auto result = std::make_unique<Layer>(layerName);
+    bool described = false;
+    FeatureStore& store = result->getFeatures();
+
+    // Consecutive instances of the same step are appended in one pass
+    size_t i = 0;
+    while (i < instances_.size()) {
+        const Step* step = instances_[i].step;
+        std::vector<Transform2D> transforms;
+        for (; i < instances_.size() && instances_[i].step == step; ++i) {
+            transforms.push_back(instances_[i].transform);
+        }
+        const Layer* layer = step->getLayer(layerName);
+        if (!layer) continue;
+        if (!described) {
+            result->setType(layer->getType());
+            result->setContext(layer->getContext());
+            result->setPolarity(layer->getPolarity());
+            result->setUnits(layer->getUnits());
+            result->setSymbolCache(layer->getSymbolCache());
+            described = true;
+        }
+        store.appendInstances(layer->getFeatures(), transforms, threads);
+    }
+    return result;
+}
+
+} // namespace koo::ecad
@@ -1,4 +1,6 @@
 #include <koo/ecad/Symbol.hpp>
+#include <koo/ecad/FeatureStore.hpp>
+#include <mutex>
 #include <regex>
 #include <sstream>
 #include <algorithm>
@@ -33,6 +35,13 @@ Symbol::Symbol(const std::string& name) : name_(name) {
     }
 }
 
+double Symbol::getUnitScale(const std::string& layerUnits) const {
+    bool inch = (layerUnits == "INCH");
+    if (unit_ == 'I') return inch ? 1e-3 : 0.0254;
+    if (unit_ == 'M') return inch ? 1.0 / 25400.0 : 1e-3;
+    return 1e-3;
+}
+
 void Symbol::addFeature(std::unique_ptr<Feature> feature) {
     features_.push_back(std::move(feature));
 }
@@ -158,6 +167,20 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
         return std::make_unique<OblongSymbol>(width, height);
     }
 
+    // Ellipse: el<w>x<h>
+    static const std::regex ellipseRegex(R"(^el(\d+\.?\d*)x(\d+\.?\d*)$)", std::regex::icase);
+    if (std::regex_match(name, match, ellipseRegex)) {
+        double width = parseNum(match[1].str());
+        double height = parseNum(match[2].str());
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
+        sym->type_ = SymbolType::Ellipse;
+        sym->isStandard_ = true;
+        sym->primaryDim_ = width;
+        sym->secondaryDim_ = height;
+        sym->boundingBox_ = makeBBox(width, height);
+        return sym;
+    }
+
     // Diamond: di<w>x<h> (two params) or di<s> (single param, square diamond)
     static const std::regex diamond2Regex(R"(^di(\d+\.?\d*)x(\d+\.?\d*)$)", std::regex::icase);
     if (std::regex_match(name, match, diamond2Regex)) {
@@ -261,7 +284,7 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
     if (std::regex_match(name, match, donutSRRegex)) {
         double outer = parseNum(match[1].str());
         double inner = parseNum(match[2].str());
-        auto sym = std::make_unique<Symbol>(name);
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
         sym->type_ = SymbolType::SquareRoundDonut;
         sym->isStandard_ = true;
         sym->primaryDim_ = outer;
@@ -492,7 +515,7 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
         double od = parseNum(match[1].str());
         double id = parseNum(match[2].str());
         double angle = parseNum(match[3].str());
-        auto sym = std::make_unique<Symbol>(name);
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
         sym->type_ = SymbolType::Cross;
         sym->isStandard_ = true;
         sym->primaryDim_ = od;
@@ -511,7 +534,7 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
         double id = parseNum(match[4].str());
         double od = parseNum(match[5].str());
         double s = parseNum(match[6].str());
-        auto sym = std::make_unique<Symbol>(name);
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
         sym->type_ = SymbolType::DogBone;
         sym->isStandard_ = true;
         sym->primaryDim_ = w;
@@ -530,7 +553,7 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
         double w = parseNum(match[1].str());
         double h = parseNum(match[2].str());
         double a = parseNum(match[3].str());
-        auto sym = std::make_unique<Symbol>(name);
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
         sym->type_ = SymbolType::DPack;
         sym->isStandard_ = true;
         sym->primaryDim_ = w;
@@ -565,7 +588,7 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
     // Moire: moire<d>x<rw>x<rg>x<rc>x<lw>x<ll>x<la>
     static const std::regex moireRegex(R"(^moire(\d+\.?\d*)x(\d+\.?\d*)x(\d+\.?\d*)x(\d+)x(\d+\.?\d*)x(\d+\.?\d*)x(\d+\.?\d*)$)", std::regex::icase);
     if (std::regex_match(name, match, moireRegex)) {
-        auto sym = std::make_unique<Symbol>(name);
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
         sym->type_ = SymbolType::Moire;
         sym->isStandard_ = true;
         sym->primaryDim_ = parseNum(match[1].str());      // diameter
@@ -582,7 +605,7 @@ std::unique_ptr<Symbol> Symbol::parseStandardSymbol(const std::string& name) {
     // Hole: hole<d>x<p>x<tp>x<tm>
     static const std::regex holeRegex(R"(^hole(\d+\.?\d*)x([pn])x(\d+)x([yn])$)", std::regex::icase);
     if (std::regex_match(name, match, holeRegex)) {
-        auto sym = std::make_unique<Symbol>(name);
+        auto sym = std::unique_ptr<Symbol>(new Symbol(name, NoParseTag{}));
         sym->type_ = SymbolType::Hole;
         sym->isStandard_ = true;
         sym->primaryDim_ = parseNum(match[1].str());   // diameter
@@ -1050,4 +1073,536 @@ std::unique_ptr<Symbol> SymbolLibrary::createStandardSymbol(const std::string& n
     return Symbol::parseStandardSymbol(name);
 }
 
+// ============================================================================
+// SymbolCache
+// ============================================================================
+
+namespace {
+
+constexpr size_t kMaxArcSegments = 1024;
+constexpr size_t kMaxUserDepth = 8;        // User symbols placed inside user symbols
+constexpr double kPi = 3.14159265358979323846;
+
+// Helper to close the ring started after the last sentinel
+void closeRing(std::vector<Point2D>& points, std::vector<uint32_t>& rings) {
+    if (rings.empty()) rings.push_back(0);
+    if (points.size() > rings.back()) rings.push_back(static_cast<uint32_t>(points.size()));
+}
+
+// Helper to append an arc from angle a0 over a signed sweep (CCW positive) so
+// that no chord strays beyond the tolerance, both ends included
+void appendArc(std::vector<Point2D>& points, const Point2D& center, double radius,
+               double a0, double sweep, double tolerance) {
+    double step = tolerance < radius ? 2.0 * std::acos(1.0 - tolerance / radius) : kPi / 2.0;
+    auto steps = static_cast<size_t>(std::ceil(std::fabs(sweep) / std::max(step, 1e-9)));
+    steps = std::clamp<size_t>(steps, 1, kMaxArcSegments);
+    for (size_t k = 0; k <= steps; ++k) {
+        double a = a0 + sweep * static_cast<double>(k) / static_cast<double>(steps);
+        points.push_back({center.x + radius * std::cos(a), center.y + radius * std::sin(a)});
+    }
+}
+
+// Helper to get the signed sweep of an arc from start to end (full circle if they coincide)
+double arcSweep(const Point2D& start, const Point2D& end, const Point2D& center, bool clockwise,
+                double& a0) {
+    a0 = std::atan2(start.y - center.y, start.x - center.x);
+    double a1 = std::atan2(end.y - center.y, end.x - center.x);
+    double sweep = clockwise ? a0 - a1 : a1 - a0;
+    while (sweep <= 0.0) sweep += 2.0 * kPi;
+    return clockwise ? -sweep : sweep;
+}
+
+// Helper to compute twice the signed area of a ring (positive when CCW)
+double signedArea2(const std::vector<Point2D>& ring) {
+    double sum = 0.0;
+    for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        sum += (ring[j].x - ring[i].x) * (ring[j].y + ring[i].y);
+    }
+    return sum;
+}
+
+// Helper to build the CCW convex hull of a point set (monotone chain)
+void convexHull(std::vector<Point2D>& pts, std::vector<Point2D>& hull) {
+    std::sort(pts.begin(), pts.end(), [](const Point2D& a, const Point2D& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    hull.clear();
+    if (pts.size() < 3) {
+        hull = pts;
+        return;
+    }
+    auto cross = [](const Point2D& o, const Point2D& a, const Point2D& b) {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    };
+    hull.resize(2 * pts.size());
+    size_t k = 0;
+    for (size_t i = 0; i < pts.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0) --k;
+        hull[k++] = pts[i];
+    }
+    for (size_t i = pts.size() - 1, lower = k + 1; i-- > 0;) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0) --k;
+        hull[k++] = pts[i];
+    }
+    hull.resize(k - 1);
+}
+
+// Helper to add a ring; reverse makes a CCW ring a hole
+void addRing(std::vector<Point2D>& points, std::vector<uint32_t>& rings,
+             const std::vector<Point2D>& ring, bool reverse = false) {
+    if (ring.size() < 3) return;
+    if (reverse) {
+        points.insert(points.end(), ring.rbegin(), ring.rend());
+    } else {
+        points.insert(points.end(), ring.begin(), ring.end());
+    }
+    closeRing(points, rings);
+}
+
+// Helper to build a CCW box with rounded (or chamfered) corners
+std::vector<Point2D> roundedBox(double hw, double hh, double radius, bool chamfer, double tolerance) {
+    std::vector<Point2D> ring;
+    if (hw <= 0.0 || hh <= 0.0) return ring;
+    radius = std::clamp(radius, 0.0, std::min(hw, hh));
+    const double cx[4] = {1, -1, -1, 1};
+    const double cy[4] = {1, 1, -1, -1};
+    for (int c = 0; c < 4; ++c) {
+        Point2D center{cx[c] * (hw - radius), cy[c] * (hh - radius)};
+        double a0 = c * kPi / 2.0;
+        if (radius <= 0.0) {
+            ring.push_back(center);
+        } else if (chamfer) {
+            ring.push_back({center.x + radius * std::cos(a0), center.y + radius * std::sin(a0)});
+            ring.push_back({center.x + radius * std::cos(a0 + kPi / 2.0),
+                            center.y + radius * std::sin(a0 + kPi / 2.0)});
+        } else {
+            appendArc(ring, center, radius, a0, kPi / 2.0, tolerance);
+        }
+    }
+    return ring;
+}
+
+// Helper to add a CCW box with rounded (or chamfered) corners; reverse makes it a hole
+void addRoundedBox(std::vector<Point2D>& points, std::vector<uint32_t>& rings,
+                   double hw, double hh, double radius, bool chamfer, double tolerance,
+                   bool reverse = false) {
+    addRing(points, rings, roundedBox(hw, hh, radius, chamfer, tolerance), reverse);
+}
+
+// Helper to build a CCW ellipse, tessellated for its larger radius
+std::vector<Point2D> ellipse(double rx, double ry, double tolerance) {
+    std::vector<Point2D> ring;
+    if (rx <= 0.0 || ry <= 0.0) return ring;
+    double radius = std::max(rx, ry);
+    appendArc(ring, {0.0, 0.0}, radius, 0.0, 2.0 * kPi, tolerance);
+    ring.pop_back();
+    for (auto& p : ring) {
+        p = {p.x * rx / radius, p.y * ry / radius};
+    }
+    return ring;
+}
+
+// Helper to keep the part of a convex ring left of the line along (dx, dy)
+// through the origin, moved offset to its left (Sutherland-Hodgman)
+std::vector<Point2D> clipLeft(const std::vector<Point2D>& ring, double dx, double dy, double offset) {
+    std::vector<Point2D> out;
+    if (ring.empty()) return out;
+    auto side = [&](const Point2D& p) { return dx * p.y - dy * p.x - offset; };
+    for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        const Point2D& a = ring[j];
+        const Point2D& b = ring[i];
+        double sa = side(a), sb = side(b);
+        if ((sa >= 0.0) != (sb >= 0.0)) {
+            double t = sa / (sa - sb);
+            out.push_back({a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t});
+        }
+        if (sb >= 0.0) out.push_back(b);
+    }
+    return out;
+}
+
+// Helper to add a thermal: the band between a convex outer and inner outline,
+// opened by spokes gaps of width gap, the first at angle degrees CCW from +x.
+// Each piece between two gaps is clipped out of both outlines and becomes an
+// island with its own hole; extra zero-width cuts keep every piece convex
+void addThermal(std::vector<Point2D>& points, std::vector<uint32_t>& rings,
+                const std::vector<Point2D>& outer, const std::vector<Point2D>& inner,
+                double angle, int spokes, double gap) {
+    if (spokes <= 0) {
+        addRing(points, rings, outer);
+        addRing(points, rings, inner, true);
+        return;
+    }
+    size_t splits = spokes == 1 ? 3 : spokes == 2 ? 2 : 1;
+    auto count = static_cast<size_t>(spokes) * splits;
+    std::vector<double> cuts(count), halfGaps(count, 0.0);
+    for (size_t k = 0; k < count; ++k) {
+        cuts[k] = angle * kPi / 180.0 + 2.0 * kPi * static_cast<double>(k) / static_cast<double>(count);
+        if (k % splits == 0) halfGaps[k] = gap * 0.5;
+    }
+    for (size_t k = 0; k < count; ++k) {
+        size_t next = (k + 1) % count;
+        auto piece = [&](const std::vector<Point2D>& ring) {
+            return clipLeft(clipLeft(ring, std::cos(cuts[k]), std::sin(cuts[k]), halfGaps[k]),
+                            -std::cos(cuts[next]), -std::sin(cuts[next]), halfGaps[next]);
+        };
+        std::vector<Point2D> island = piece(outer);
+        if (island.size() < 3) continue;
+        addRing(points, rings, island);
+        addRing(points, rings, piece(inner), true);
+    }
+}
+
+// Helper to add a round thermal whose pieces end in half discs
+void addRoundedThermal(std::vector<Point2D>& points, std::vector<uint32_t>& rings,
+                       double outer, double inner, double angle, int spokes, double gap,
+                       double tolerance) {
+    double mid = (outer + inner) * 0.5, half = (outer - inner) * 0.5;
+    if (half <= 0.0) return;
+    if (spokes <= 0) {
+        addRing(points, rings, ellipse(outer, outer, tolerance));
+        addRing(points, rings, ellipse(inner, inner, tolerance), true);
+        return;
+    }
+    // Cap centers sit where the caps clear the spoke lines by half the gap
+    double span = 2.0 * kPi / spokes;
+    double delta = std::asin(std::min(1.0, (gap * 0.5 + half) / mid));
+    if (span <= 2.0 * delta) return;
+    for (int k = 0; k < spokes; ++k) {
+        double a0 = angle * kPi / 180.0 + k * span + delta;
+        double a1 = a0 + span - 2.0 * delta;
+        appendArc(points, {0.0, 0.0}, outer, a0, a1 - a0, tolerance);
+        points.pop_back();
+        appendArc(points, {mid * std::cos(a1), mid * std::sin(a1)}, half, a1, kPi, tolerance);
+        points.pop_back();
+        appendArc(points, {0.0, 0.0}, inner, a1, a0 - a1, tolerance);
+        points.pop_back();
+        appendArc(points, {mid * std::cos(a0), mid * std::sin(a0)}, half, a0 + kPi, kPi, tolerance);
+        points.pop_back();
+        closeRing(points, rings);
+    }
+}
+
+// Helper to parse and outline a symbol name in layer units
+std::unique_ptr<SymbolGeometry> buildGeometry(const std::string& name, const std::string& units,
+                                              double tolerance) {
+    auto geometry = std::make_unique<SymbolGeometry>();
+    geometry->symbol = Symbol::parseStandardSymbol(name);
+    const Symbol* symbol = geometry->symbol.get();
+    if (!symbol || !symbol->getBoundingBox().isValid()) return geometry;
+
+    double scale = symbol->getUnitScale(units);
+    double hw = symbol->getBoundingBox().width() * 0.5 * scale;
+    double hh = symbol->getBoundingBox().height() * 0.5 * scale;
+    geometry->bounds = BoundingBox2D({-hw, -hh}, {hw, hh});
+
+    auto& points = geometry->points;
+    auto& rings = geometry->rings;
+    double inner = symbol->getSecondaryDimension() * 0.5 * scale;
+    double radius = symbol->getCornerRadius() * scale;
+    double angle = symbol->getAngle();
+    int spokes = symbol->getSpokeCount();
+    double gap = symbol->getSpokeGap() * scale;
+    switch (symbol->getType()) {
+        case SymbolType::Round:
+        case SymbolType::Hole:
+            geometry->radius = hw;
+            addRoundedBox(points, rings, hw, hw, hw, false, tolerance);
+            break;
+        case SymbolType::RoundedRectangle:
+            addRoundedBox(points, rings, hw, hh, radius, false, tolerance);
+            break;
+        case SymbolType::ChamferedRectangle:
+            addRoundedBox(points, rings, hw, hh, radius, true, tolerance);
+            break;
+        case SymbolType::Octagon:
+            addRoundedBox(points, rings, hw, hh, symbol->getTertiaryDimension() * scale, true, tolerance);
+            break;
+        case SymbolType::Oblong:
+            addRoundedBox(points, rings, hw, hh, std::min(hw, hh), false, tolerance);
+            break;
+        case SymbolType::Ellipse:
+            addRing(points, rings, ellipse(hw, hh, tolerance));
+            break;
+        case SymbolType::Diamond:
+            addRing(points, rings, {{hw, 0.0}, {0.0, hh}, {-hw, 0.0}, {0.0, -hh}});
+            break;
+        case SymbolType::Triangle:
+            addRing(points, rings, {{-hw, -hh}, {hw, -hh}, {0.0, hh}});
+            break;
+        case SymbolType::HalfOval: {
+            // Flat on the left, a half disc of the full height on the right
+            double cx = std::max(hw - hh, -hw);
+            std::vector<Point2D> ring{{-hw, -hh}};
+            appendArc(ring, {cx, 0.0}, hh, -kPi / 2.0, kPi, tolerance);
+            ring.push_back({-hw, hh});
+            addRing(points, rings, ring);
+            break;
+        }
+        case SymbolType::HorizontalHexagon: {
+            double r = std::clamp(symbol->getTertiaryDimension() * scale, 0.0, hw);
+            addRing(points, rings, {{-hw, 0.0}, {-hw + r, -hh}, {hw - r, -hh},
+                                    {hw, 0.0}, {hw - r, hh}, {-hw + r, hh}});
+            break;
+        }
+        case SymbolType::VerticalHexagon: {
+            double r = std::clamp(symbol->getTertiaryDimension() * scale, 0.0, hh);
+            addRing(points, rings, {{0.0, -hh}, {hw, -hh + r}, {hw, hh - r},
+                                    {0.0, hh}, {-hw, hh - r}, {-hw, -hh + r}});
+            break;
+        }
+        case SymbolType::Butterfly:
+            // Quarter discs in the first and third quadrants
+            for (double a0 : {0.0, kPi}) {
+                std::vector<Point2D> ring{{0.0, 0.0}};
+                appendArc(ring, {0.0, 0.0}, hw, a0, kPi / 2.0, tolerance);
+                addRing(points, rings, ring);
+            }
+            break;
+        case SymbolType::SquareButterfly:
+            addRing(points, rings, {{0.0, 0.0}, {hw, 0.0}, {hw, hh}, {0.0, hh}});
+            addRing(points, rings, {{0.0, 0.0}, {-hw, 0.0}, {-hw, -hh}, {0.0, -hh}});
+            break;
+
+        // Donuts: the outer outline plus its hole
+        case SymbolType::RoundDonut:
+            addRoundedBox(points, rings, hw, hw, hw, false, tolerance);
+            addRoundedBox(points, rings, inner, inner, inner, false, tolerance, true);
+            break;
+        case SymbolType::SquareDonut:
+            addRoundedBox(points, rings, hw, hh, 0.0, false, tolerance);
+            addRoundedBox(points, rings, inner, inner, 0.0, false, tolerance, true);
+            break;
+        case SymbolType::SquareRoundDonut:
+            addRoundedBox(points, rings, hw, hh, 0.0, false, tolerance);
+            addRing(points, rings, ellipse(inner, inner, tolerance), true);
+            break;
+        case SymbolType::RoundedSquareDonut:
+            addRoundedBox(points, rings, hw, hh, radius, false, tolerance);
+            addRoundedBox(points, rings, inner, inner, radius - (hw - inner), false, tolerance, true);
+            break;
+        case SymbolType::RectangleDonut:
+        case SymbolType::RoundedRectDonut: {
+            double lw = symbol->getTertiaryDimension() * scale;
+            addRoundedBox(points, rings, hw, hh, radius, false, tolerance);
+            addRoundedBox(points, rings, hw - lw, hh - lw, radius - lw, false, tolerance, true);
+            break;
+        }
+        case SymbolType::OvalDonut: {
+            double lw = symbol->getTertiaryDimension() * scale;
+            addRoundedBox(points, rings, hw, hh, std::min(hw, hh), false, tolerance);
+            addRoundedBox(points, rings, hw - lw, hh - lw, std::min(hw, hh) - lw, false, tolerance, true);
+            break;
+        }
+
+        // Thermals: the band between two outlines, opened by the spoke gaps
+        case SymbolType::RoundThermalRounded:
+            addRoundedThermal(points, rings, hw, inner, angle, spokes, gap, tolerance);
+            break;
+        case SymbolType::RoundThermalSquared:
+        case SymbolType::Thermal:
+            addThermal(points, rings, ellipse(hw, hw, tolerance), ellipse(inner, inner, tolerance),
+                       angle, spokes, gap);
+            break;
+        case SymbolType::SquareThermal:
+        case SymbolType::SquareThermalOpenCorner:
+        case SymbolType::LineThermal:
+            addThermal(points, rings, roundedBox(hw, hh, 0.0, false, tolerance),
+                       roundedBox(inner, inner, 0.0, false, tolerance), angle, spokes, gap);
+            break;
+        case SymbolType::SquareRoundThermal:
+            addThermal(points, rings, roundedBox(hw, hh, 0.0, false, tolerance),
+                       ellipse(inner, inner, tolerance), angle, spokes, gap);
+            break;
+        case SymbolType::RoundedSquareThermal:
+            addThermal(points, rings, roundedBox(hw, hh, radius, false, tolerance),
+                       roundedBox(inner, inner, radius - (hw - inner), false, tolerance), angle, spokes, gap);
+            break;
+        case SymbolType::RectangularThermal:
+        case SymbolType::RectThermalOpenCorner:
+        case SymbolType::RoundedRectThermal: {
+            double lw = symbol->getSenaryDimension() * scale;
+            addThermal(points, rings, roundedBox(hw, hh, radius, false, tolerance),
+                       roundedBox(hw - lw, hh - lw, radius - lw, false, tolerance), angle, spokes, gap);
+            break;
+        }
+        case SymbolType::OvalThermal:
+        case SymbolType::OblongThermal: {
+            double lw = symbol->getTertiaryDimension() * scale;
+            double r = std::min(hw, hh);
+            addThermal(points, rings, roundedBox(hw, hh, r, false, tolerance),
+                       roundedBox(hw - lw, hh - lw, r - lw, false, tolerance), angle, spokes, gap);
+            break;
+        }
+        default:
+            addRoundedBox(points, rings, hw, hh, 0.0, false, tolerance);
+            break;
+    }
+    return geometry;
+}
+
+// Helper to get the factor taking user symbol coordinates to layer units (a
+// user symbol keeps the UNITS of its features file; unset means the layer's)
+double userScale(const Symbol& symbol, const std::string& units) {
+    bool inch = (units == "INCH");
+    if (symbol.getUnit() == 'I') return inch ? 1.0 : 25.4;
+    if (symbol.getUnit() == 'M') return inch ? 1.0 / 25.4 : 1.0;
+    return 1.0;
+}
+
+// Helper to outline a user symbol from its positive features in layer units.
+// lookup(name, units) resolves the symbols those features use in the
+// symbol's own units. Every feature adds its own rings, so overlaps union
+// under nonzero winding
+template<typename Lookup>
+void outlineUserSymbol(const Symbol& symbol, const std::string& units, double tolerance,
+                       Lookup&& lookup, SymbolGeometry& geometry) {
+    const double scale = userScale(symbol, units);
+    const std::string own = symbol.getUnit() == 'I' ? "INCH" : symbol.getUnit() == 'M' ? "MM" : units;
+    const double ownTolerance = tolerance / scale;
+    auto& points = geometry.points;
+    auto& rings = geometry.rings;
+    std::vector<Point2D> ring, hull;
+    auto toLayer = [scale](const Point2D& p) { return Point2D{p.x * scale, p.y * scale}; };
+
+    // Round symbols sweep as capsules, others as the hull of their outline
+    auto sweep = [&](const SymbolGeometry& shape, const Point2D& a, const Point2D& b) {
+        ring.clear();
+        if (shape.radius > 0.0) {
+            double angle = std::atan2(b.y - a.y, b.x - a.x);
+            appendArc(ring, toLayer(b), shape.radius * scale, angle - kPi / 2.0, kPi, tolerance);
+            appendArc(ring, toLayer(a), shape.radius * scale, angle + kPi / 2.0, kPi, tolerance);
+        } else {
+            for (const auto& p : shape.points) {
+                ring.push_back(toLayer(a + p));
+                ring.push_back(toLayer(b + p));
+            }
+            convexHull(ring, hull);
+            ring.swap(hull);
+        }
+        addRing(points, rings, ring);
+    };
+
+    for (const auto& feature : symbol.getFeatures()) {
+        if (feature->getPolarity() == Polarity::Negative) continue;
+        if (const auto* pad = dynamic_cast<const PadFeature*>(feature.get())) {
+            const SymbolGeometry& shape = lookup(pad->getSymbolName(), own);
+            double resize = pad->hasResize() && pad->getResizeFactor() > 0.0 ? pad->getResizeFactor() : 1.0;
+            Transform2D place(pad->getRotation(), pad->isMirrored(), pad->getPosition());
+            for (size_t r = 0; r + 1 < shape.rings.size(); ++r) {
+                ring.clear();
+                for (uint32_t k = shape.rings[r]; k < shape.rings[r + 1]; ++k) {
+                    const Point2D& p = shape.points[k];
+                    ring.push_back(toLayer(place.apply(Point2D{p.x * resize, p.y * resize})));
+                }
+                // Mirroring turns rings around; turn them back so islands stay CCW
+                addRing(points, rings, ring, pad->isMirrored());
+            }
+        } else if (const auto* line = dynamic_cast<const LineFeature*>(feature.get())) {
+            sweep(lookup(line->getSymbolName(), own), line->getStart(), line->getEnd());
+        } else if (const auto* arc = dynamic_cast<const ArcFeature*>(feature.get())) {
+            const SymbolGeometry& shape = lookup(arc->getSymbolName(), own);
+            Point2D start = arc->getStart(), center = arc->getCenter();
+            double a0 = 0.0;
+            double turn = arcSweep(start, arc->getEnd(), center, arc->isClockwise(), a0);
+            std::vector<Point2D> path;
+            appendArc(path, center, std::hypot(start.x - center.x, start.y - center.y), a0, turn, ownTolerance);
+            for (size_t k = 1; k < path.size(); ++k) sweep(shape, path[k - 1], path[k]);
+        } else if (const auto* surface = dynamic_cast<const SurfaceFeature*>(feature.get())) {
+            // Islands CCW, holes CW
+            for (const auto& contour : surface->getContours()) {
+                ring.assign(1, contour.getStart());
+                for (const auto& seg : contour.getSegments()) {
+                    Point2D next{seg.x, seg.y};
+                    if (seg.type == ContourSegmentType::Arc) {
+                        Point2D current = ring.back(), middle{seg.xc, seg.yc};
+                        double a0 = 0.0;
+                        double turn = arcSweep(current, next, middle, seg.clockwise, a0);
+                        double radius = std::hypot(current.x - middle.x, current.y - middle.y);
+                        appendArc(ring, middle, radius, a0, turn, ownTolerance);
+                        ring.back() = next;
+                    } else {
+                        ring.push_back(next);
+                    }
+                }
+                if (ring.size() > 1 && ring.front().x == ring.back().x && ring.front().y == ring.back().y) {
+                    ring.pop_back();
+                }
+                if (ring.size() < 3) continue;
+                for (auto& p : ring) p = toLayer(p);
+                bool ccw = signedArea2(ring) > 0.0;
+                addRing(points, rings, ring, ccw != (contour.getPolygonType() == PolygonType::Island));
+            }
+        }
+    }
+
+    BoundingBox2D box;
+    for (const auto& p : points) box.expand(p);
+    if (!box.isValid()) return;
+    double hw = std::max(-box.min.x, box.max.x);
+    double hh = std::max(-box.min.y, box.max.y);
+    geometry.bounds = BoundingBox2D({-hw, -hh}, {hw, hh});
+}
+
+} // anonymous namespace
+
+SymbolCache::SymbolCache() : SymbolCache(kDefaultArcTolerance) {}
+
+SymbolCache::SymbolCache(double arcTolerance) : arcTolerance_(arcTolerance) {}
+
+SymbolCache::SymbolCache(double arcTolerance, const SymbolLibrary* library)
+    : arcTolerance_(arcTolerance), library_(library) {}
+
+const SymbolGeometry& SymbolCache::get(const std::string& name, const std::string& units) const {
+    return lookup(name, units, 0);
+}
+
+const SymbolGeometry& SymbolCache::lookup(const std::string& name, const std::string& units,
+                                          size_t depth) const {
+    std::string key;
+    key.reserve(units.size() + 1 + name.size());
+    key.append(units).append(1, ' ').append(name);
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) return *it->second;
+    }
+
+    // Parse outside the lock; a racing thread's entry wins
+    auto geometry = buildGeometry(name, units, arcTolerance_);
+    const Symbol* user = !geometry->symbol && library_ && depth < kMaxUserDepth
+                       ? library_->getSymbol(name) : nullptr;
+    if (user) {
+        geometry->symbol = std::make_unique<Symbol>();
+        geometry->symbol->setName(name);
+        outlineUserSymbol(*user, units, arcTolerance_,
+            [&](const std::string& child, const std::string& childUnits) -> const SymbolGeometry& {
+                return lookup(child, childUnits, depth + 1);
+            }, *geometry);
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = entries_.try_emplace(std::move(key), std::move(geometry)).first;
+    return *it->second;
+}
+
+std::vector<const SymbolGeometry*> SymbolCache::resolve(const StringTable& symbols,
+                                                        const std::string& units) const {
+    std::vector<const SymbolGeometry*> result;
+    result.reserve(symbols.size());
+    for (const auto& name : symbols.getStrings()) {
+        result.push_back(&get(name, units));
+    }
+    return result;
+}
+
+size_t SymbolCache::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void SymbolCache::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    entries_.clear();
+}
+
 } // namespace koo::ecad
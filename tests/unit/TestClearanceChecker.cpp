@@ -0,0 +1,263 @@
+#include <gtest/gtest.h>
+#include <koo/ecad/ClearanceChecker.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <koo/ecad/Step.hpp>
+#include <cmath>
+#include <random>
+
+using namespace koo::ecad;
+
+namespace {
+
+/// One INCH signal layer; features are given nets through EDA FID records
+struct Board {
+    Step step{"pcb"};
+    LayerMatrix matrix;
+    Layer* top = nullptr;
+
+    Board() {
+        LayerDefinition def;
+        def.name = "top";
+        def.type = LayerType::Signal;
+        def.row = 1;
+        matrix.addLayer(def);
+        auto layer = std::make_unique<Layer>("top");
+        layer->setUnits("INCH");
+        top = layer.get();
+        step.addLayer(std::move(layer));
+        step.getEdaData().setLayerNames({"top"});
+    }
+
+    /// Add a feature on a net (EDA net numbers follow first use)
+    size_t add(std::unique_ptr<Feature> feature, const std::string& net) {
+        size_t index = top->getFeatures().size();
+        top->addFeature(std::move(feature));
+        EdaData& eda = step.getEdaData();
+        Net* entry = eda.getNet(net);
+        if (!entry) {
+            auto created = std::make_unique<Net>(net);
+            created->setNetNumber(static_cast<int>(eda.getNets().size()));
+            entry = created.get();
+            eda.addNet(std::move(created));
+        }
+        EdaData::FeatureIdRecord record;
+        record.featureId = {'C', 0, static_cast<int>(index)};
+        record.netNum = entry->getNetNumber();
+        eda.addFeatureIdRecord(record);
+        return index;
+    }
+};
+
+} // anonymous namespace
+
+TEST(ClearanceCheckerTest, TraceToPadGapIsExact) {
+    Board board;
+    board.add(std::make_unique<LineFeature>(0, 0, 1, 0, "r10"), "A");
+    board.add(std::make_unique<PadFeature>(1.02, 0, "r20"), "B");
+    board.add(std::make_unique<LineFeature>(0, 0.005, 0.9, 0.005, "r10"), "A");  // Same net, overlapping
+
+    ClearanceChecker checker(board.step, board.matrix);
+    ClearanceChecker::Options options;
+    options.clearance = 0.006;
+    auto result = checker.check(options);
+    ASSERT_EQ(result.layers, std::vector<std::string>{"top"});
+    ASSERT_EQ(result.clearanceCount, 1u);
+    const auto& v = result.violations[0];
+    EXPECT_EQ(v.feature, 0u);
+    EXPECT_EQ(v.other, 1u);
+    EXPECT_EQ(v.net, "A");
+    EXPECT_EQ(v.otherNet, "B");
+    EXPECT_NEAR(v.distance, 0.005, 1e-12);
+    EXPECT_DOUBLE_EQ(v.required, 0.006);
+    EXPECT_NEAR(v.location.x, 1.0075, 1e-12);
+    EXPECT_FALSE(ClearanceChecker::formatViolation(v).empty());
+
+    // A gap at or above the clearance passes
+    options.clearance = 0.005;
+    EXPECT_TRUE(checker.check(options).ok());
+}
+
+TEST(ClearanceCheckerTest, ArcsAreMeasuredExactly) {
+    Board board;
+    // Disc of radius 1 drawn as two arcs; pad 0.03 off its edge at 100 degrees
+    SurfaceFeature disc;
+    Contour outline(1.0, 0.0);
+    outline.addArcSegment(-1.0, 0.0, 0.0, 0.0, false);
+    outline.addArcSegment(1.0, 0.0, 0.0, 0.0, false);
+    disc.addContour(outline);
+    board.add(disc.clone(), "GND");
+    double angle = 100.0 * 3.14159265358979323846 / 180.0;
+    board.add(std::make_unique<PadFeature>(1.03 * std::cos(angle), 1.03 * std::sin(angle), "r20"), "A");
+    // Arc track (r10) of radius 2 around the disc, crossing the pad's side only within its sweep
+    board.add(std::make_unique<ArcFeature>(0, -2, 0, 2, 0, 0, "r10", false), "B");
+    board.add(std::make_unique<PadFeature>(0.5, 0.2, "r10"), "C");           // Inside the disc
+
+    ClearanceChecker checker(board.step, board.matrix);
+    ClearanceChecker::Options options;
+    options.clearance = 0.05;
+    auto result = checker.check(options);
+    ASSERT_EQ(result.clearanceCount, 2u);
+    EXPECT_EQ(result.violations[0].other, 1u);
+    EXPECT_NEAR(result.violations[0].distance, 0.02, 1e-12);
+    EXPECT_EQ(result.violations[1].other, 3u);
+    EXPECT_DOUBLE_EQ(result.violations[1].distance, 0.0);
+
+    // The arc track (radius 2, right half only) is 0.995 from the disc
+    options.clearance = 1.0;
+    result = checker.check(options);
+    bool found = false;
+    for (const auto& v : result.violations) {
+        if (v.feature == 0 && v.other == 2) {
+            EXPECT_NEAR(v.distance, 0.995, 1e-12);
+            found = true;
+        }
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST(ClearanceCheckerTest, SquareArcsReachTheirCorners) {
+    Board board;
+    // Arc of radius 1 drawn with s20: at 45 degrees a corner of the square
+    // reaches 0.01 * sqrt(2) off the centerline, toward a pad 0.03 out
+    board.add(std::make_unique<ArcFeature>(0, -1, 0, 1, 0, 0, "s20", false), "A");
+    double diagonal = 1.03 / std::sqrt(2.0);
+    board.add(std::make_unique<PadFeature>(diagonal, diagonal, "r10"), "B");
+
+    ClearanceChecker checker(board.step, board.matrix);
+    ClearanceChecker::Options options;
+    options.clearance = 0.012;
+    auto result = checker.check(options);
+    ASSERT_EQ(result.clearanceCount, 1u);
+    EXPECT_NEAR(result.violations[0].distance, 0.03 - 0.01 * std::sqrt(2.0) - 0.005, 1e-12);
+}
+
+TEST(ClearanceCheckerTest, RulesRaiseTheDefault) {
+    Board board;
+    board.add(std::make_unique<PadFeature>(0, 0, "r20"), "A");
+    board.add(std::make_unique<PadFeature>(0.03, 0, "r20"), "B");
+    board.add(std::make_unique<PadFeature>(0.06, 0, "r20"), "C");
+    board.step.getEdaData().getNet("B")->setNetClass(NetClass::Power);
+
+    ClearanceChecker checker(board.step, board.matrix);
+    ClearanceChecker::Options options;
+    options.clearance = 0.005;
+    EXPECT_TRUE(checker.check(options).ok());
+
+    // Pair rule: only A-B
+    options.rules = {{"", "A", "B", 0.02}};
+    auto result = checker.check(options);
+    ASSERT_EQ(result.clearanceCount, 1u);
+    EXPECT_EQ(result.violations[0].feature, 0u);
+    EXPECT_EQ(result.violations[0].other, 1u);
+    EXPECT_DOUBLE_EQ(result.violations[0].required, 0.02);
+
+    // Net class rule: B against everything
+    options.rules = ClearanceChecker::rulesFromNetClass(board.step.getEdaData(), NetClass::Power, 0.02);
+    ASSERT_EQ(options.rules.size(), 1u);
+    EXPECT_EQ(checker.check(options).clearanceCount, 2u);
+
+    // Impedance spacing applies to its layer only
+    ImpedanceConstraint constraint;
+    constraint.layer = "top";
+    constraint.spacing = 0.02;
+    options.rules = ClearanceChecker::rulesFromImpedance({constraint});
+    EXPECT_EQ(checker.check(options).clearanceCount, 2u);
+    options.rules[0].layer = "bottom";
+    EXPECT_TRUE(checker.check(options).ok());
+}
+
+TEST(ClearanceCheckerTest, BoardEdge) {
+    Board board;
+    Contour profile(0.0, 0.0);
+    profile.addLineSegment(2.0, 0.0);
+    profile.addLineSegment(2.0, 2.0);
+    profile.addLineSegment(0.0, 2.0);
+    profile.addLineSegment(0.0, 0.0);
+    board.step.addProfileContour(profile);
+    board.add(std::make_unique<LineFeature>(0.5, 1.99, 1.5, 1.99, "r10"), "A");
+    board.add(std::make_unique<PadFeature>(1.0, 1.0, "r20"), "B");
+    board.add(std::make_unique<PadFeature>(3.0, 1.0, "r20"), "C");
+
+    ClearanceChecker checker(board.step, board.matrix);
+    ClearanceChecker::Options options;
+    options.edgeClearance = 0.01;
+    auto result = checker.check(options);
+    EXPECT_EQ(result.clearanceCount, 0u);
+    ASSERT_EQ(result.edgeCount, 2u);
+    for (const auto& v : result.violations) {
+        EXPECT_EQ(v.type, ClearanceChecker::ViolationType::BoardEdge);
+        EXPECT_EQ(v.other, ClearanceChecker::npos);
+        if (v.feature == 0) {
+            EXPECT_NEAR(v.distance, 0.005, 1e-12);
+        } else {
+            EXPECT_EQ(v.feature, 2u);
+            EXPECT_DOUBLE_EQ(v.distance, 0.0);
+        }
+    }
+}
+
+TEST(ClearanceCheckerTest, NegativeFeaturesClearCopper) {
+    Board board;
+    SurfaceFeature plane;
+    Contour outline(0, 0);
+    outline.addLineSegment(2, 0);
+    outline.addLineSegment(2, 2);
+    outline.addLineSegment(0, 2);
+    outline.addLineSegment(0, 0);
+    plane.addContour(outline);
+    board.add(plane.clone(), "GND");
+    board.add(std::make_unique<PadFeature>(1, 1, "r8"), "SIG");
+
+    ClearanceChecker::Options options;
+    options.clearance = 0.005;
+    auto result = ClearanceChecker(board.step, board.matrix).check(options);
+    ASSERT_EQ(result.clearanceCount, 1u);
+    EXPECT_DOUBLE_EQ(result.violations[0].distance, 0.0);
+
+    // An antipad drawn after the plane clears the via
+    auto antipad = std::make_unique<PadFeature>(1, 1, "r40");
+    antipad->setPolarity(Polarity::Negative);
+    board.top->addFeature(std::move(antipad));
+    EXPECT_TRUE(ClearanceChecker(board.step, board.matrix).check(options).ok());
+
+    // A trace leaving the antipad still meets the plane
+    board.add(std::make_unique<LineFeature>(1, 1, 1, 2.5, "r8"), "SIG");
+    result = ClearanceChecker(board.step, board.matrix).check(options);
+    ASSERT_EQ(result.clearanceCount, 1u);
+    EXPECT_EQ(result.violations[0].other, 3u);
+}
+
+TEST(ClearanceCheckerTest, StreamingMatchesAcrossThreads) {
+    Board board;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(0.0, 4.0);
+    for (int i = 0; i < 3000; ++i) {
+        std::string net = "N" + std::to_string(i % 40);
+        if (i % 3 == 0) {
+            double x = coord(rng), y = coord(rng);
+            board.add(std::make_unique<LineFeature>(x, y, x + 0.05, y + 0.02, "r5"), net);
+        } else {
+            board.add(std::make_unique<PadFeature>(coord(rng), coord(rng), i % 2 ? "r20" : "rect20x30"), net);
+        }
+    }
+
+    ClearanceChecker checker(board.step, board.matrix);
+    ClearanceChecker::Options options;
+    options.clearance = 0.01;
+    options.threads = 1;
+    auto serial = checker.check(options);
+    EXPECT_GT(serial.clearanceCount, 0u);
+
+    options.threads = 4;
+    std::vector<ClearanceChecker::Violation> streamed;
+    auto counts = checker.check(options, [&](const ClearanceChecker::Violation& v) { streamed.push_back(v); });
+    EXPECT_TRUE(counts.violations.empty());
+    EXPECT_EQ(counts.clearanceCount, serial.clearanceCount);
+    EXPECT_EQ(counts.pairCount, serial.pairCount);
+    ASSERT_EQ(streamed.size(), serial.violations.size());
+    for (size_t k = 0; k < streamed.size(); ++k) {
+        EXPECT_EQ(streamed[k].feature, serial.violations[k].feature);
+        EXPECT_EQ(streamed[k].other, serial.violations[k].other);
+        EXPECT_EQ(streamed[k].distance, serial.violations[k].distance);
+    }
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <koo/ecad/ComponentIndex.hpp>
+#include <koo/ecad/EdaData.hpp>
+#include <random>
+
+using namespace koo::ecad;
+
+namespace {
+
+Pin makePin(const std::string& name, double x, double y) {
+    Pin pin;
+    pin.name = name;
+    pin.x = x;
+    pin.y = y;
+    return pin;
+}
+
+void addPackage(EdaData& eda, const std::string& name, const BoundingBox2D& box,
+                const std::vector<Pin>& pins) {
+    auto package = std::make_unique<Package>(name);
+    package->setBoundingBox(box);
+    for (const auto& pin : pins) package->addPin(pin);
+    eda.addPackage(std::move(package));
+}
+
+Component& addComponent(EdaData& eda, const std::string& refDes, int package,
+                        double x, double y, double rotation, bool mirror) {
+    auto component = std::make_unique<Component>(refDes);
+    component->setPackageIndex(package);
+    component->setPosition(x, y);
+    component->setRotation(rotation);
+    component->setMirrored(mirror);
+    component->setSide(mirror ? MountSide::Bottom : MountSide::Top);
+    eda.addComponent(std::move(component));
+    return *eda.getComponent(refDes);
+}
+
+// Resistors stacked on both sides at (10, 10), a QFN turned 45 degrees and
+// a connector with its own toeprints
+EdaData makeBoard() {
+    EdaData eda;
+    addPackage(eda, "R0603", BoundingBox2D({-1.0, -0.5}, {1.0, 0.5}),
+               {makePin("1", -0.75, 0.0), makePin("2", 0.75, 0.0)});
+    addPackage(eda, "QFN16", BoundingBox2D({-2.0, -2.0}, {2.0, 2.0}), {makePin("1", -1.5, 1.5)});
+    addComponent(eda, "R1", 0, 10.0, 10.0, 90.0, false);
+    addComponent(eda, "R2", 0, 10.0, 10.0, 0.0, true);
+    addComponent(eda, "U1", 1, 20.0, 0.0, 45.0, false);
+    Component& j1 = addComponent(eda, "J1", -1, 30.5, 5.0, 0.0, false);
+    j1.addPin(makePin("A", 30.0, 5.0));
+    j1.addPin(makePin("B", 31.0, 5.0));
+    return eda;
+}
+
+} // anonymous namespace
+
+TEST(ComponentIndexTest, PlacesPackagePins) {
+    EdaData eda = makeBoard();
+    ComponentIndex index(eda);
+    ASSERT_EQ(index.getPins().size(), 7);
+
+    // Clockwise rotation turns pin 1 of R1 to the top; R2 is mirrored underneath
+    double distance = -1.0;
+    size_t pin = index.getPinAt({10.0, 10.75}, MountSide::Top, 0.01, &distance);
+    ASSERT_NE(pin, ComponentIndex::npos);
+    EXPECT_EQ(index.getPins()[pin].pin->name, "1");
+    EXPECT_EQ(index.getPins()[pin].component, 0);
+    EXPECT_NEAR(distance, 0.0, 1e-12);
+    EXPECT_EQ(index.getPinAt({10.75, 10.0}, MountSide::Top, 0.01), ComponentIndex::npos);
+    pin = index.getPinAt({10.75, 10.0}, MountSide::Bottom, 0.01);
+    ASSERT_NE(pin, ComponentIndex::npos);
+    EXPECT_EQ(index.getPins()[pin].component, 1);
+    EXPECT_EQ(index.getPins()[pin].pin->name, "1");
+
+    // Toeprints stay where they are
+    auto [first, last] = index.getComponentPins(3);
+    EXPECT_EQ(last - first, 2);
+    EXPECT_EQ(index.getPinsInArea(BoundingBox2D({29.0, 4.0}, {32.0, 6.0}), MountSide::Top),
+              (std::vector<size_t>{first, first + 1}));
+    EXPECT_TRUE(index.getPinsInArea(BoundingBox2D({29.0, 4.0}, {32.0, 6.0}), MountSide::Bottom).empty());
+}
+
+TEST(ComponentIndexTest, ComponentQueries) {
+    EdaData eda = makeBoard();
+    ComponentIndex index(eda);
+
+    const auto& r1 = index.getPlacement(0);
+    EXPECT_NEAR(r1.bounds.min.x, 9.5, 1e-12);
+    EXPECT_NEAR(r1.bounds.max.y, 11.0, 1e-12);
+    BoundingBox2D around({9.0, 9.0}, {11.0, 11.0});
+    EXPECT_EQ(index.getComponentsInArea(around, MountSide::Top), std::vector<size_t>{0});
+    EXPECT_EQ(index.getComponentsInArea(around, MountSide::Bottom), std::vector<size_t>{1});
+
+    // The turned QFN's box reaches (22, 2) but its footprint does not
+    EXPECT_EQ(index.getComponentsInArea(BoundingBox2D({21.9, 1.9}, {22.0, 2.0}), MountSide::Top),
+              std::vector<size_t>{2});
+    EXPECT_TRUE(index.getComponentsAt({22.0, 2.0}, MountSide::Top).empty());
+    EXPECT_EQ(index.getComponentsAt({22.5, 0.0}, MountSide::Top), std::vector<size_t>{2});
+
+    // The connector has no package: its pins make its box
+    EXPECT_EQ(index.getComponentsAt({30.5, 5.0}, MountSide::Top), std::vector<size_t>{3});
+}
+
+TEST(ComponentIndexTest, BatchesMatchSingleQueries) {
+    EdaData eda;
+    addPackage(eda, "C0402", BoundingBox2D({-0.5, -0.25}, {0.5, 0.25}),
+               {makePin("1", -0.4, 0.0), makePin("2", 0.4, 0.0)});
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> pos(0.0, 50.0);
+    for (int i = 0; i < 2000; ++i) {
+        addComponent(eda, "C" + std::to_string(i), 0, pos(rng), pos(rng), 15.0 * (i % 24), i % 3 == 0);
+    }
+    ComponentIndex index(eda);
+
+    std::vector<Point2D> points;
+    std::vector<BoundingBox2D> areas;
+    for (int i = 0; i < 3000; ++i) {
+        points.push_back({pos(rng), pos(rng)});
+        areas.push_back(BoundingBox2D(points.back(), {points.back().x + 1.0, points.back().y + 1.0}));
+    }
+    for (MountSide side : {MountSide::Top, MountSide::Bottom}) {
+        auto owners = index.getComponentsAt(points, side, 4);
+        auto pins = index.getPinsAt(points, side, 0.5, 4);
+        auto inAreas = index.getComponentsInAreas(areas, side, 4);
+        for (size_t i = 0; i < points.size(); ++i) {
+            auto at = index.getComponentsAt(points[i], side);
+            EXPECT_EQ(owners[i], at.empty() ? ComponentIndex::npos : at.back());
+            EXPECT_EQ(pins[i], index.getPinAt(points[i], side, 0.5));
+            EXPECT_EQ(inAreas[i], index.getComponentsInArea(areas[i], side));
+        }
+    }
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <koo/ecad/CopperArea.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using namespace koo::ecad;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+std::unique_ptr<Layer> makeLayer() {
+    auto layer = std::make_unique<Layer>("top");
+    layer->setUnits("MM");
+    return layer;
+}
+
+void addPad(Layer& layer, double x, double y, const std::string& symbol,
+            Polarity polarity = Polarity::Positive) {
+    auto pad = std::make_unique<PadFeature>(x, y, symbol);
+    pad->setPolarity(polarity);
+    layer.addFeature(std::move(pad));
+}
+
+Contour makeBox(double x0, double y0, double x1, double y1, PolygonType type) {
+    Contour contour(x0, y0);
+    contour.setPolygonType(type);
+    contour.addLineSegment(x1, y0);
+    contour.addLineSegment(x1, y1);
+    contour.addLineSegment(x0, y1);
+    contour.addLineSegment(x0, y0);
+    return contour;
+}
+
+} // anonymous namespace
+
+TEST(CopperAreaTest, UnitesOverlappingFeatures) {
+    auto layer = makeLayer();
+    addPad(*layer, 0.0, 0.0, "s1000");
+    addPad(*layer, 0.5, 0.0, "s1000");
+    EXPECT_NEAR(CopperArea(*layer).getArea(), 1.5, 1e-9);
+
+    // Round shapes are flattened within the arc tolerance
+    auto round = makeLayer();
+    addPad(*round, 0.0, 0.0, "r1000");
+    round->addFeature(std::make_unique<LineFeature>(5.0, 0.0, 15.0, 0.0, "r1000"));
+    EXPECT_NEAR(CopperArea(*round).getArea(), 10.0 + 2.0 * kPi / 4.0, 1e-3);
+
+    // A track arc over a quarter circle of radius 5
+    auto arc = makeLayer();
+    arc->addFeature(std::make_unique<ArcFeature>(5.0, 0.0, 0.0, 5.0, 0.0, 0.0, "r1000", false));
+    EXPECT_NEAR(CopperArea(*arc).getArea(), 5.0 * kPi / 2.0 + kPi / 4.0, 1e-3);
+
+    CopperArea copper(*layer);
+    EXPECT_NEAR(copper.getBounds().min.x, -0.5, 1e-9);
+    EXPECT_NEAR(copper.getBounds().max.x, 1.0, 1e-9);
+    EXPECT_NEAR(copper.getArea(BoundingBox2D({0.0, -1.0}, {2.0, 1.0})), 1.0, 1e-9);
+}
+
+TEST(CopperAreaTest, PolarityAndHoles) {
+    // Negative clears what came before it, a later positive draws again
+    auto layer = makeLayer();
+    addPad(*layer, 0.0, 0.0, "s2000");
+    addPad(*layer, 0.0, 0.0, "s1000", Polarity::Negative);
+    EXPECT_NEAR(CopperArea(*layer).getArea(), 3.0, 1e-9);
+    addPad(*layer, 0.0, 0.0, "s500");
+    EXPECT_NEAR(CopperArea(*layer).getArea(), 3.25, 1e-9);
+
+    // Island with a hole, contours given in either orientation
+    auto plane = makeLayer();
+    SurfaceFeature surface;
+    surface.addContour(makeBox(0.0, 0.0, 4.0, 4.0, PolygonType::Island));
+    surface.addContour(makeBox(3.0, 3.0, 1.0, 1.0, PolygonType::Hole));
+    plane->addFeature(surface.clone());
+    addPad(*plane, 2.0, 2.0, "rect1000x500");
+    plane->addFeature(std::make_unique<TextFeature>(0.0, 0.0, "X", "standard", 1.0));
+    EXPECT_NEAR(CopperArea(*plane).getArea(), 12.5, 1e-9);
+}
+
+TEST(CopperAreaTest, DonutsAndThermals) {
+    auto area = [](const std::string& symbol) {
+        auto layer = makeLayer();
+        addPad(*layer, 0.0, 0.0, symbol);
+        return CopperArea(*layer).getArea();
+    };
+    // Area of the band |v| < h across a disc of radius r
+    auto chord = [](double r, double h) { return h * std::sqrt(r * r - h * h) + r * r * std::asin(h / r); };
+
+    EXPECT_NEAR(area("donut_rc4000x2000x500"), 8.0 - 3.0, 1e-9);
+    EXPECT_NEAR(area("donut_sr4000x2000"), 16.0 - kPi, 1e-3);
+    EXPECT_NEAR(area("donut_o4000x2000x500"), (8.0 - 4.0 + kPi) - (3.0 - 1.0 + kPi / 4.0), 1e-3);
+
+    // Square band of 12 with four diagonal gaps 0.5 wide and sqrt(2) long (cut
+    // vertices snap to the resolution grid)
+    EXPECT_NEAR(area("s_ths4000x2000x45x4x500"), 12.0 - 4.0 * 0.5 * std::sqrt(2.0), 1e-5);
+    // Round band of 3 pi with straight gaps, one or four of them
+    double gap = chord(2.0, 0.25) - chord(1.0, 0.25);
+    EXPECT_NEAR(area("ths4000x2000x0x4x500"), 3.0 * kPi - 4.0 * gap, 1e-3);
+    EXPECT_NEAR(area("ths4000x2000x0x1x500"), 3.0 * kPi - gap, 1e-3);
+    // Rounded ends: each piece is a 30 degree sector of the band plus a disc of radius 0.5
+    EXPECT_NEAR(area("thr4000x2000x0x4x500"), 4.0 * (3.0 * kPi / 12.0 + kPi / 4.0), 1e-3);
+}
+
+TEST(CopperAreaTest, DensityMap) {
+    auto layer = makeLayer();
+    SurfaceFeature surface;
+    surface.addContour(makeBox(0.0, 0.0, 4.0, 2.0, PolygonType::Island));
+    layer->addFeature(surface.clone());
+    addPad(*layer, 3.0, 1.0, "s1000", Polarity::Negative);
+
+    CopperArea copper(*layer);
+    auto map = copper.getDensityMap(4, 2);
+    ASSERT_EQ(map.area.size(), 8);
+    EXPECT_NEAR(map.getCellWidth(), 1.0, 1e-12);
+    EXPECT_NEAR(map.getTotalArea(), copper.getArea(), 1e-9);
+    EXPECT_NEAR(map.getDensity(0, 0), 1.0, 1e-9);
+    EXPECT_NEAR(map.getDensity(2, 0), 0.75, 1e-9);
+    EXPECT_NEAR(map.getDensity(3, 1), 0.75, 1e-9);
+    EXPECT_NEAR(map.getTotalArea(), 7.0, 1e-9);
+
+    auto empty = makeLayer();
+    EXPECT_EQ(CopperArea(*empty).getArea(), 0.0);
+    EXPECT_TRUE(CopperArea(*empty).getDensityMap(2, 2).area == std::vector<double>(4, 0.0));
+}
+
+TEST(CopperAreaTest, ThreadCountInvariant) {
+    auto layer = makeLayer();
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> pos(0.0, 20.0);
+    std::uniform_real_distribution<double> len(-0.5, 0.5);
+    for (int i = 0; i < 3000; ++i) {
+        double x = pos(rng), y = pos(rng);
+        if (i % 5 == 0) {
+            addPad(*layer, x, y, "oval300x600", i % 2 ? Polarity::Negative : Polarity::Positive);
+        } else if (i % 3 == 0) {
+            layer->addFeature(std::make_unique<PadFeature>(x, y, "rect400x200xr50", 30.0 * (i % 6)));
+        } else {
+            layer->addFeature(std::make_unique<LineFeature>(x, y, x + len(rng), y + len(rng), "r100"));
+        }
+    }
+
+    CopperArea::Options options;
+    options.threads = 1;
+    auto serial = CopperArea(*layer, options).getDensityMap(8, 8);
+    options.threads = 8;
+    auto parallel = CopperArea(*layer, options).getDensityMap(8, 8);
+    EXPECT_GT(serial.getTotalArea(), 0.0);
+    EXPECT_LT(serial.getTotalArea(), 400.0);
+    EXPECT_EQ(serial.area, parallel.area);
+
+    // Finer maps (several cells per tile) carve the same copper
+    CopperArea copper(*layer, options);
+    EXPECT_NEAR(copper.getDensityMap(32, 32).getTotalArea(), serial.getTotalArea(), 1e-6);
+    auto fine = copper.getDensityMap(100, 100);
+    EXPECT_NEAR(fine.getTotalArea(), serial.getTotalArea(), 1e-6);
+    EXPECT_NEAR(fine.getArea(37, 52), copper.getArea(BoundingBox2D(
+        {fine.bounds.min.x + 37 * fine.getCellWidth(), fine.bounds.min.y + 52 * fine.getCellHeight()},
+        {fine.bounds.min.x + 38 * fine.getCellWidth(), fine.bounds.min.y + 53 * fine.getCellHeight()})), 1e-6);
+}
+
+TEST(CopperAreaTest, Rasterize) {
+    auto layer = makeLayer();
+    SurfaceFeature surface;
+    surface.addContour(makeBox(0.0, 0.0, 4.0, 2.0, PolygonType::Island));
+    layer->addFeature(surface.clone());
+    addPad(*layer, 3.0, 1.0, "s1000", Polarity::Negative);
+    CopperArea copper(*layer);
+
+    // Pixel centers only: the hole clears exactly 10 x 10 of 40 x 20 pixels
+    CopperArea::RasterOptions options;
+    options.antialias = false;
+    auto raster = copper.rasterize(copper.getBounds(), 40, 20, options);
+    ASSERT_EQ(raster.bytes.size(), 800);
+    size_t set = 0;
+    for (uint8_t b : raster.bytes) set += b == 255;
+    EXPECT_EQ(set, 700);
+    EXPECT_EQ(raster.getCoverage(0, 0), 1.0);
+    EXPECT_EQ(raster.getCoverage(30, 10), 0.0);
+
+    // Small tiles render the same pixels
+    options.tileSize = 3;
+    EXPECT_EQ(copper.rasterize(copper.getBounds(), 40, 20, options).bytes, raster.bytes);
+
+    // Anti-aliased coverage follows the exact density map
+    options.antialias = true;
+    options.samples = 8;
+    options.format = CopperArea::PixelFormat::Float32;
+    auto coverage = copper.rasterize(copper.getBounds(), 7, 3, options);
+    auto map = copper.getDensityMap(7, 3);
+    ASSERT_EQ(coverage.values.size(), 21);
+    for (size_t r = 0; r < 3; ++r) {
+        for (size_t c = 0; c < 7; ++c) {
+            EXPECT_NEAR(coverage.getCoverage(c, r), map.getDensity(c, r), 0.1);
+        }
+    }
+
+    // Exports
+    auto dir = std::filesystem::temp_directory_path() / "koo_raster_test";
+    std::filesystem::create_directories(dir);
+    auto load = [](const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    ASSERT_TRUE(raster.writePgm(dir / "top.pgm"));
+    std::string pgm = load(dir / "top.pgm");
+    std::string header = "P5\n40 20\n255\n";
+    ASSERT_EQ(pgm.size(), header.size() + 800);
+    EXPECT_EQ(pgm.substr(0, header.size()), header);
+    EXPECT_EQ(static_cast<uint8_t>(pgm[header.size() + 9 * 40 + 30]), 0);   // row 10 from the top
+
+    ASSERT_TRUE(raster.writeRaw(dir / "top.raw"));
+    EXPECT_EQ(load(dir / "top.raw"), std::string(raster.bytes.begin(), raster.bytes.end()));
+
+    ASSERT_TRUE(coverage.writeNpy(dir / "top.npy"));
+    std::string npy = load(dir / "top.npy");
+    ASSERT_GT(npy.size(), 10u);
+    EXPECT_EQ(npy.substr(0, 8), std::string("\x93NUMPY\x01\x00", 8));
+    size_t length = static_cast<uint8_t>(npy[8]) | static_cast<size_t>(static_cast<uint8_t>(npy[9])) << 8;
+    EXPECT_EQ((10 + length) % 64, 0);
+    EXPECT_NE(npy.find("'shape': (3, 7)"), std::string::npos);
+    EXPECT_NE(npy.find("f4'"), std::string::npos);
+    EXPECT_EQ(npy.size(), 10 + length + 21 * sizeof(float));
+    std::filesystem::remove_all(dir);
+}
@@ -331,6 +331,45 @@ TEST(EdaDataTest, GetNetNames) {
     EXPECT_EQ(netNames.size(), 3);
 }
 
+TEST(EdaDataTest, InternedNameLookups) {
+    EdaData eda;
+
+    eda.addNet(std::make_unique<Net>("VCC"));
+    eda.addNet(std::make_unique<Net>("GND"));
+    eda.addComponent(std::make_unique<Component>("U1"));
+    eda.addComponent(std::make_unique<Component>("GND"));   // Shares the name ID with the net
+
+    // Insertion order and index lookups
+    EXPECT_EQ(eda.getNetNames(), (std::vector<std::string>{"VCC", "GND"}));
+    EXPECT_EQ(eda.getComponentRefDes(), (std::vector<std::string>{"U1", "GND"}));
+    EXPECT_EQ(eda.getNetIndex("GND"), 1);
+    EXPECT_EQ(eda.getComponentIndex("GND"), 1);
+    EXPECT_EQ(eda.getNetIndex("U1"), -1);
+    EXPECT_EQ(eda.getComponentIndex("R1"), -1);
+    EXPECT_EQ(eda.getNet(1)->getName(), "GND");
+    EXPECT_EQ(eda.getNet(2), nullptr);
+    EXPECT_EQ(eda.getComponent(0)->getRefDes(), "U1");
+    EXPECT_EQ(eda.getNameTable().size(), 3u);
+
+    // Re-adding a name replaces in place
+    auto replacement = std::make_unique<Net>("VCC");
+    replacement->setNetNumber(7);
+    eda.addNet(std::move(replacement));
+    EXPECT_EQ(eda.getNetCount(), 2u);
+    EXPECT_EQ(eda.getNet("VCC")->getNetNumber(), 7);
+    EXPECT_EQ(eda.getNetIndex("VCC"), 0);
+
+    // Subnets are keyed by name ID; the empty name is a name of its own
+    Subnet subnet;
+    subnet.type = SubnetType::Via;
+    eda.addSubnet("GND", subnet);
+    EXPECT_EQ(eda.getSubnets("GND").size(), 1u);
+    EXPECT_TRUE(eda.getSubnets("R1").empty());
+    EXPECT_TRUE(eda.getSubnets("").empty());
+    eda.addComponent(std::make_unique<Component>());
+    EXPECT_EQ(eda.getComponentIndex(""), 2);
+}
+
 TEST(EdaDataTest, GetPackageNames) {
     EdaData eda;
 
@@ -145,3 +145,12 @@ TEST(ElementSolidTest, Clone) {
     ASSERT_NE(solidClone, nullptr);
     EXPECT_EQ(solidClone->getElementCount(), 1);
 }
+
+TEST(ShellThicknessDataTest, AverageThickness) {
+    ShellThicknessData data;
+    EXPECT_DOUBLE_EQ(data.getAverageThickness(), 0.0);
+    data.thick1 = 1.0;
+    data.thick2 = 2.0;
+    data.thick3 = 3.0;
+    EXPECT_DOUBLE_EQ(data.getAverageThickness(), 2.0);
+}
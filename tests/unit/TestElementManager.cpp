@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <koo/dyna/Model.hpp>
+#include <koo/dyna/managers/ElementManager.hpp>
+#include <koo/dyna/managers/PartManager.hpp>
+
+using namespace koo::dyna;
+using namespace koo::dyna::managers;
+using namespace koo;
+
+namespace {
+
+void buildModel(Model& model) {
+    model.getOrCreateShellElements().addElement(1, 1, 1, 2, 3, 4);
+    model.getOrCreateShellElements().addElement(2, 1, 2, 5, 3, 0);  // Triangle
+
+    // Second shell block
+    auto shells = std::make_unique<ElementShell>();
+    shells->addElement(3, 2, 10, 11, 12, 13);
+    model.addKeyword(std::move(shells));
+
+    model.getOrCreateSolidElements().addElement(20, 3, 1, 2, 3, 4, 5, 6, 7, 8);
+}
+
+} // anonymous namespace
+
+TEST(ElementManagerTest, SpansViewElementStorage) {
+    Model model;
+    buildModel(model);
+
+    ElementManager mgr(model);
+    mgr.buildIndex();
+
+    auto shells = mgr.getElementIdSpan(ElementType::Shell);
+    ASSERT_EQ(shells.size(), 3);
+    EXPECT_EQ(shells[2], 3);
+    EXPECT_TRUE(mgr.getElementIdSpan(ElementType::Beam).empty());
+
+    auto nodes = mgr.getNodeSpan(3);
+    ASSERT_EQ(nodes.size(), 4);
+    EXPECT_EQ(nodes[0], 10);
+    EXPECT_EQ(nodes.data(), model.getKeywordsOfType<ElementShell>()[1]->getElement(3)->nodeIds.data());
+    EXPECT_TRUE(mgr.getNodeSpan(999).empty());
+}
+
+TEST(ElementManagerTest, BulkConnectivity) {
+    Model model;
+    buildModel(model);
+
+    ElementManager mgr(model);
+    mgr.buildIndex();
+
+    std::vector<ElementId> eids = {20, 999, 1};
+    ElementManager::Connectivity csr;
+    size_t found = mgr.getNodes(eids, csr);
+
+    EXPECT_EQ(found, 2);
+    ASSERT_EQ(csr.size(), 3);
+    EXPECT_EQ(csr[0].size(), 8);
+    EXPECT_TRUE(csr[1].empty());
+    EXPECT_EQ(csr[2].size(), 4);
+    EXPECT_EQ(csr[2][3], 4);
+    EXPECT_EQ(csr.nodeIds.size(), 12);
+}
+
+TEST(ElementManagerTest, FaceSegments) {
+    Model model;
+    buildModel(model);
+
+    ElementManager mgr(model);
+    mgr.buildIndex();
+
+    std::vector<ElementManager::FaceSegment> faces;
+    EXPECT_EQ(mgr.getSegments(20, faces), 6);
+    EXPECT_EQ(mgr.getSegments(2, faces), 1);
+    ASSERT_EQ(faces.size(), 7);
+    EXPECT_EQ(faces[6].nodeCount, 3);
+    EXPECT_EQ(faces[3].faceIndex, 3);
+    EXPECT_EQ(faces[3].nodes()[0], 2);
+
+    faces.clear();
+    EXPECT_EQ(mgr.getAllSegments(faces), 9);
+    EXPECT_EQ(mgr.getAllSegments().size(), 9);
+
+    auto legacy = mgr.getSegments(20);
+    ASSERT_EQ(legacy.size(), 6);
+    EXPECT_EQ(legacy[5].nodeIds, (std::vector<NodeId>{4, 1, 5, 8}));
+}
+
+TEST(ElementManagerTest, PartManagerCoversAllBlocks) {
+    Model model;
+    buildModel(model);
+
+    PartManager mgr(model);
+    mgr.buildIndex();
+
+    EXPECT_EQ(mgr.getElementCount(1), 2);
+    EXPECT_EQ(mgr.getElements(2), (std::vector<ElementId>{3}));
+    EXPECT_EQ(mgr.getNodes(1), (std::vector<NodeId>{1, 2, 3, 4, 5}));
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <koo/dyna/Model.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Set.hpp>
+#include <koo/dyna/KeywordFileReader.hpp>
+#include <koo/dyna/managers/IntegrityManager.hpp>
+
+using namespace koo::dyna;
+using namespace koo::dyna::managers;
+using namespace koo;
+
+namespace {
+
+const IntegrityManager::Issue* findIssue(const IntegrityManager::Report& report,
+                                         IntegrityManager::IssueType type, IdKind kind, int64_t id) {
+    for (const auto& issue : report.issues) {
+        if (issue.type == type && issue.kind == kind && issue.id == id) {
+            return &issue;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+TEST(IntegrityManagerTest, ReportsWithSourceLocation) {
+    std::string content = R"(*KEYWORD
+*NODE
+         1       0.0       0.0       0.0
+         2       1.0       0.0       0.0
+         3       1.0       1.0       0.0
+*NODE
+         1       0.0       1.0       0.0
+*ELEMENT_SHELL
+         1         1         1         2         3         9
+         2         1         1         2         3         9
+*END
+)";
+
+    KeywordFileReader reader;
+    Model model = reader.readFromString(content);
+
+    IntegrityManager mgr(model);
+    auto report = mgr.check();
+    EXPECT_FALSE(report.ok());
+    EXPECT_EQ(report.duplicateCount, 1);
+
+    using Type = IntegrityManager::IssueType;
+    const auto* duplicate = findIssue(report, Type::Duplicate, IdKind::Node, 1);
+    ASSERT_NE(duplicate, nullptr);
+    EXPECT_EQ(duplicate->location.keyword->getSourceLine(), 6);
+    EXPECT_EQ(duplicate->previous.keyword->getSourceLine(), 2);
+    EXPECT_EQ(duplicate->location.toString(), "line 6 *NODE item 0");
+
+    const auto* node = findIssue(report, Type::Dangling, IdKind::Node, 9);
+    ASSERT_NE(node, nullptr);
+    EXPECT_EQ(node->count, 2);
+    EXPECT_EQ(node->location.keyword->getSourceLine(), 8);
+    EXPECT_EQ(node->location.item, 0);
+
+    const auto* part = findIssue(report, Type::Dangling, IdKind::Part, 1);
+    ASSERT_NE(part, nullptr);
+    EXPECT_NE(IntegrityManager::formatIssue(*part).find("undefined part ID 1"), std::string::npos);
+}
+
+TEST(IntegrityManagerTest, MaterialsSetsAndUnused) {
+    Model model;
+    model.getOrCreateNodes().addNode(1, 0.0, 0.0, 0.0);
+    model.getOrCreateParts().addPart(1, 0, 5);
+
+    auto mat = std::make_unique<MatElastic>();
+    mat->getData().id = 2;
+    model.addKeyword(std::move(mat));
+
+    auto set = std::make_unique<SetNode>();
+    set->setSetId(1);
+    set->addNode(1);
+    set->addNode(4);
+    model.addKeyword(std::move(set));
+
+    IntegrityManager mgr(model);
+    auto report = mgr.check();
+
+    using Type = IntegrityManager::IssueType;
+    EXPECT_NE(findIssue(report, Type::Dangling, IdKind::Material, 5), nullptr);
+    EXPECT_NE(findIssue(report, Type::Dangling, IdKind::Node, 4), nullptr);
+    EXPECT_NE(findIssue(report, Type::Unused, IdKind::Material, 2), nullptr);
+    EXPECT_NE(findIssue(report, Type::Unused, IdKind::Part, 1), nullptr);
+    EXPECT_EQ(findIssue(report, Type::Dangling, IdKind::Node, 1), nullptr);
+    EXPECT_EQ(report.danglingCount, 2);
+    EXPECT_EQ(report.unusedCount, 2);
+    EXPECT_EQ(report.definitions[static_cast<size_t>(IdKind::NodeSet)], 1);
+}
+
+TEST(IntegrityManagerTest, GenerateRanges) {
+    Model model;
+    for (int64_t id : {1, 2, 3, 10}) {
+        model.getOrCreateNodes().addNode(id, 0.0, 0.0, 0.0);
+    }
+    auto set = std::make_unique<SetNodeGenerate>();
+    set->setSetId(1);
+    set->getRanges().push_back({1, 5, 1});      // End point 5 is not a node
+    set->getRanges().push_back({30, 20, 1});    // No node in 20-30
+    model.addKeyword(std::move(set));
+
+    IntegrityManager::Options options;
+    options.reportUnused[static_cast<size_t>(IdKind::Node)] = true;
+    auto report = IntegrityManager(model).check(options);
+
+    using Type = IntegrityManager::IssueType;
+    EXPECT_EQ(findIssue(report, Type::Dangling, IdKind::Node, 5), nullptr);
+    EXPECT_EQ(report.danglingCount, 1);
+    const auto* empty = findIssue(report, Type::Dangling, IdKind::Node, 20);
+    ASSERT_NE(empty, nullptr);
+    EXPECT_EQ(empty->last, 30);
+    EXPECT_EQ(empty->location.item, 2);
+    EXPECT_EQ(IntegrityManager::formatIssue(*empty),
+              "*SET_NODE_GENERATE item 2: no node ID defined in range 20-30");
+
+    // Nodes inside a range are used
+    EXPECT_EQ(findIssue(report, Type::Unused, IdKind::Node, 2), nullptr);
+    EXPECT_NE(findIssue(report, Type::Unused, IdKind::Node, 10), nullptr);
+    EXPECT_EQ(report.unusedCount, 1);
+}
+
+TEST(IntegrityManagerTest, ThreadCountIndependent) {
+    Model model;
+    model.getOrCreateParts().addPart(1, 1, 1);
+    auto& nodes = model.getOrCreateNodes();
+    for (int64_t i = 1; i <= 50000; ++i) {
+        // Every 97th node is missing, node 500 is defined twice
+        if (i % 97 != 0) {
+            nodes.addNode(i, 0.0, 0.0, 0.0);
+        }
+    }
+    nodes.getNodes().push_back(NodeData(500, 1.0, 0.0, 0.0));
+
+    auto& shells = model.getOrCreateShellElements();
+    for (int64_t i = 1; i + 3 <= 50000; ++i) {
+        shells.addElement(i, 1, i, i + 1, i + 2, i + 3);
+    }
+
+    IntegrityManager mgr(model);
+    IntegrityManager::Options serial;
+    serial.threads = 1;
+    IntegrityManager::Options parallel;
+    parallel.threads = 4;
+
+    auto a = mgr.check(serial);
+    auto b = mgr.check(parallel);
+    ASSERT_EQ(a.issues.size(), b.issues.size());
+    for (size_t i = 0; i < a.issues.size(); ++i) {
+        EXPECT_EQ(a.issues[i].id, b.issues[i].id);
+        EXPECT_EQ(a.issues[i].count, b.issues[i].count);
+        EXPECT_EQ(a.issues[i].location.item, b.issues[i].location.item);
+    }
+    EXPECT_EQ(a.duplicateCount, 1);
+    EXPECT_EQ(a.danglingCount, 50000 / 97 + 2);  // Plus section 1 and material 1
+}
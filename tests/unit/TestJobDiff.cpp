@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include <koo/ecad/JobDiff.hpp>
+#include <koo/ecad/OdbJob.hpp>
+#include <koo/ecad/Step.hpp>
+#include <algorithm>
+
+using namespace koo::ecad;
+
+namespace {
+
+// Board with a copper and a silkscreen layer, one component, one net and a
+// two-layer stackup; reversed adds the copper features in reverse order
+OdbJob makeJob(bool reversed = false) {
+    OdbJob job("board");
+    auto step = std::make_unique<Step>("pcb");
+
+    std::vector<std::unique_ptr<Feature>> copper;
+    copper.push_back(std::make_unique<LineFeature>(0, 0, 1, 0, "r10"));
+    copper.push_back(std::make_unique<PadFeature>(1, 0, "r20"));
+    copper.push_back(std::make_unique<PadFeature>(2, 0, "rect20x30"));
+    SurfaceFeature plane;
+    Contour outline(3, 0);
+    outline.addLineSegment(4, 0);
+    outline.addArcSegment(3, 0, 3.5, 0, true);
+    plane.addContour(outline);
+    copper.push_back(plane.clone());
+    if (reversed) std::reverse(copper.begin(), copper.end());
+
+    auto top = std::make_unique<Layer>("top");
+    for (auto& feature : copper) top->addFeature(std::move(feature));
+    step->addLayer(std::move(top));
+
+    auto silk = std::make_unique<Layer>("silk");
+    silk->addFeature(std::make_unique<TextFeature>(0.5, 0.5, "U1", "standard", 0.05));
+    step->addLayer(std::move(silk));
+
+    auto component = std::make_unique<Component>("U1");
+    component->setPosition(1.5, 0.0);
+    step->getEdaData().addComponent(std::move(component));
+    auto net = std::make_unique<Net>("GND");
+    net->addPin("U1", "1");
+    step->getEdaData().addNet(std::move(net));
+    step->addProfileContour(outline);
+    job.addStep(std::move(step));
+
+    StackupLayer layer;
+    layer.name = "TOP";
+    layer.materialType = StackupMaterialType::Copper;
+    layer.thickness = 0.035;
+    job.addStackupLayer(layer);
+    layer.name = "core";
+    layer.materialType = StackupMaterialType::Core;
+    layer.thickness = 1.5;
+    job.addStackupLayer(layer);
+    return job;
+}
+
+const JobDiff::LayerDiff* findLayer(const JobDiff::StepDiff& step, const std::string& name) {
+    for (const auto& layer : step.layers) {
+        if (layer.name == name) return &layer;
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+TEST(JobDiffTest, FeatureOrderDoesNotMatter) {
+    OdbJob before = makeJob();
+    OdbJob after = makeJob(true);
+
+    JobDiff diff(before, after);
+    auto result = diff.compare();
+    EXPECT_TRUE(result.isIdentical());
+    ASSERT_EQ(result.steps.size(), 1u);
+    EXPECT_TRUE(result.steps[0].getChangedLayers().empty());
+    const auto* top = findLayer(result.steps[0], "top");
+    ASSERT_NE(top, nullptr);
+    EXPECT_NE(top->hashBefore, 0u);
+    EXPECT_EQ(top->hashBefore, top->hashAfter);
+
+    // Layer hashes do not depend on threads, but do on net names
+    const Layer& layer = *before.getStep("pcb")->getLayer("top");
+    EXPECT_EQ(JobDiff::hashLayer(layer, 1e-6, 1), JobDiff::hashLayer(layer, 1e-6, 4));
+    before.getStep("pcb")->getLayer("top")->getFeatures().setNetName(0, "GND");
+    EXPECT_NE(JobDiff::hashLayer(layer, 1e-6), top->hashBefore);
+}
+
+TEST(JobDiffTest, ReportsAddedRemovedAndMovedFeatures) {
+    OdbJob before = makeJob();
+    OdbJob after = makeJob();
+    Layer* top = after.getStep("pcb")->getLayer("top");
+    top->removeFeature(0);                                                  // Line removed
+    top->removeFeature(1);                                                  // rect pad (old 2) removed...
+    top->addFeature(std::make_unique<PadFeature>(2.25, 0.5, "rect20x30")); // ...and placed elsewhere
+    top->addFeature(std::make_unique<ArcFeature>(0, 1, 1, 1, 0.5, 1, "r10", false));  // Arc added
+
+    JobDiff diff(before, after);
+    auto result = diff.compare();
+    EXPECT_FALSE(result.isIdentical());
+    const auto& step = result.steps[0];
+    EXPECT_EQ(step.change, JobDiff::ChangeType::Changed);
+    EXPECT_EQ(step.getChangedLayers(), std::vector<std::string>{"top"});
+
+    const auto* layer = findLayer(step, "top");
+    ASSERT_NE(layer, nullptr);
+    EXPECT_EQ(layer->change, JobDiff::ChangeType::Changed);
+    EXPECT_EQ(layer->removed, std::vector<size_t>{0});
+    EXPECT_EQ(layer->added, std::vector<size_t>{3});
+    ASSERT_EQ(layer->moved.size(), 1u);
+    EXPECT_EQ(layer->moved[0].before, 2u);
+    EXPECT_EQ(layer->moved[0].after, 2u);
+    EXPECT_NEAR(layer->moved[0].offset.x, 0.25, 1e-12);
+    EXPECT_NEAR(layer->moved[0].offset.y, 0.5, 1e-12);
+
+    // Without move matching the moved pad is a removal plus an addition
+    JobDiff::Options options;
+    options.matchMoves = false;
+    options.threads = 2;
+    result = diff.compare(options);
+    layer = findLayer(result.steps[0], "top");
+    EXPECT_EQ(layer->removed, (std::vector<size_t>{0, 2}));
+    EXPECT_EQ(layer->added, (std::vector<size_t>{2, 3}));
+    EXPECT_TRUE(layer->moved.empty());
+}
+
+TEST(JobDiffTest, ComponentsNetsStackupAndSteps) {
+    OdbJob before = makeJob();
+    OdbJob after = makeJob();
+    Step* step = after.getStep("pcb");
+    step->getEdaData().getComponent("U1")->setRotation(90.0);
+    step->getEdaData().getNet("GND")->addPin("U1", "2");
+    step->getEdaData().addNet(std::make_unique<Net>("VCC"));
+    after.getStackup()[1].thickness = 1.6;
+    after.addStep(std::make_unique<Step>("panel"));
+    step->addLayer(std::make_unique<Layer>("bottom"));
+
+    JobDiff diff(before, after);
+    auto result = diff.compare();
+    ASSERT_EQ(result.steps.size(), 2u);
+    EXPECT_EQ(result.steps[0].name, "panel");
+    EXPECT_EQ(result.steps[0].change, JobDiff::ChangeType::Added);
+
+    const auto& pcb = result.steps[1];
+    EXPECT_EQ(pcb.change, JobDiff::ChangeType::Changed);
+    EXPECT_FALSE(pcb.profileChanged);
+    EXPECT_EQ(pcb.getChangedLayers(), std::vector<std::string>{"bottom"});
+    EXPECT_EQ(findLayer(pcb, "bottom")->change, JobDiff::ChangeType::Added);
+    ASSERT_EQ(pcb.components.size(), 1u);
+    EXPECT_EQ(pcb.components[0].name, "U1");
+    EXPECT_EQ(pcb.components[0].change, JobDiff::ChangeType::Changed);
+    ASSERT_EQ(pcb.nets.size(), 2u);
+    EXPECT_EQ(pcb.nets[0].name, "GND");
+    EXPECT_EQ(pcb.nets[0].change, JobDiff::ChangeType::Changed);
+    EXPECT_EQ(pcb.nets[1].name, "VCC");
+    EXPECT_EQ(pcb.nets[1].change, JobDiff::ChangeType::Added);
+
+    ASSERT_EQ(result.stackup.size(), 1u);
+    EXPECT_EQ(result.stackup[0].name, "core");
+    EXPECT_TRUE(result.matrix.empty());
+}
+
+TEST(JobDiffTest, UserSymbolsAndSubnets) {
+    // A pad placing a user symbol; the after revision widens the symbol
+    auto addLogo = [](OdbJob& job, double width) {
+        auto logo = std::make_unique<Symbol>("logo");
+        logo->addFeature(std::make_unique<LineFeature>(0, 0, width, 0, "r5"));
+        job.addSymbol(std::move(logo));
+        job.getStep("pcb")->getLayer("silk")->addFeature(std::make_unique<PadFeature>(2, 2, "logo"));
+    };
+    auto addSubnet = [](OdbJob& job, int first) {
+        Net::Subnet subnet;
+        subnet.type = Net::Subnet::Type::Trace;
+        subnet.featureIds = {first, first + 1};
+        job.getStep("pcb")->getEdaData().getNet("GND")->addSubnet(subnet);
+    };
+    OdbJob before = makeJob();
+    OdbJob after = makeJob();
+    addLogo(before, 1.0);
+    addLogo(after, 2.0);
+    // Renumbered features leave the net unchanged
+    addSubnet(before, 0);
+    addSubnet(after, 7);
+
+    JobDiff diff(before, after);
+    auto result = diff.compare();
+    EXPECT_FALSE(result.isIdentical());
+    ASSERT_EQ(result.symbols.size(), 1u);
+    EXPECT_EQ(result.symbols[0].name, "logo");
+    EXPECT_EQ(result.symbols[0].change, JobDiff::ChangeType::Changed);
+
+    const auto& pcb = result.steps[0];
+    EXPECT_TRUE(pcb.nets.empty());
+    EXPECT_EQ(pcb.getChangedLayers(), std::vector<std::string>{"silk"});
+    const auto* silk = findLayer(pcb, "silk");
+    EXPECT_EQ(silk->removed, std::vector<size_t>{1});
+    EXPECT_EQ(silk->added, std::vector<size_t>{1});
+    EXPECT_TRUE(silk->moved.empty());
+
+    // Without the library only the symbol name is hashed
+    const Layer& layerBefore = *before.getStep("pcb")->getLayer("silk");
+    const Layer& layerAfter = *after.getStep("pcb")->getLayer("silk");
+    EXPECT_EQ(JobDiff::hashLayer(layerBefore, 1e-6), JobDiff::hashLayer(layerAfter, 1e-6));
+    EXPECT_EQ(JobDiff::hashLayer(layerBefore, 1e-6, 0, &before.getSymbolLibrary()), silk->hashBefore);
+    EXPECT_NE(JobDiff::hashLayer(layerAfter, 1e-6, 0, &after.getSymbolLibrary()), silk->hashBefore);
+}
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include <koo/ecad/Layer.hpp>
 #include <koo/ecad/Feature.hpp>
+#include <koo/ecad/Symbol.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
 
 using namespace koo::ecad;
 
@@ -90,7 +94,7 @@ TEST(LayerTest, GetFeatureByIndex) {
     pad->setPosition(5.0, 10.0);
     layer.addFeature(std::move(pad));
 
-    const Feature* feature = layer.getFeature(0);
+    auto feature = layer.getFeature(0);
     ASSERT_NE(feature, nullptr);
     EXPECT_EQ(feature->getType(), FeatureType::Pad);
 
@@ -110,6 +114,193 @@ TEST(LayerTest, ClearFeatures) {
     EXPECT_EQ(layer.getFeatureCount(), 0);
 }
 
+TEST(LayerTest, ColumnarFeatureStorage) {
+    CopperLayer layer("top");
+
+    auto line = std::make_unique<LineFeature>(0, 0, 10, 0, "r10");
+    line->setNetName("GND");
+    line->setId("7");
+    line->setAttribute(".smd", "");
+    layer.addFeature(std::move(line));
+    layer.addFeature(std::make_unique<PadFeature>(5, 5, "r10", 90.0, true));
+    layer.addFeature(std::make_unique<ArcFeature>(1, 0, -1, 0, 0, 0, "r20", false));
+
+    auto surface = std::make_unique<SurfaceFeature>();
+    Contour contour(0, 0);
+    contour.addLineSegment(2, 0);
+    contour.addLineSegment(2, -3);
+    surface->addContour(contour);
+    surface->setNetName("GND");
+    layer.addFeature(std::move(surface));
+
+    const auto& features = layer.getFeatures();
+    ASSERT_EQ(features.size(), 4);
+    EXPECT_EQ(features.getSymbols().size(), 2);   // "r10" interned once
+    EXPECT_EQ(features.getNets().size(), 1);
+    EXPECT_EQ(features.getLines().xs.size(), 1);
+
+    auto pad = features[1];
+    EXPECT_EQ(pad.getType(), FeatureType::Pad);
+    EXPECT_EQ(pad.getSymbolName(), "r10");
+    EXPECT_TRUE(pad.isMirrored());
+    EXPECT_DOUBLE_EQ(pad.getRotation(), 90.0);
+    EXPECT_EQ(pad.getObject(), nullptr);
+
+    EXPECT_EQ(layer.getFeaturesByNet("GND"), (std::vector<size_t>{0, 3}));
+    EXPECT_EQ(layer.getTracesOnNet("GND"), (std::vector<size_t>{0}));
+    EXPECT_TRUE(layer.getPadsOnNet("VCC").empty());
+    EXPECT_EQ(layer.getFeaturesInArea(BoundingBox2D({4, 4}, {6, 6})), (std::vector<size_t>{1}));
+
+    BoundingBox2D box = layer.getBoundingBox();
+    EXPECT_DOUBLE_EQ(box.min.y, -3.0);
+    EXPECT_DOUBLE_EQ(box.max.x, 10.0);
+    EXPECT_DOUBLE_EQ(box.max.y, 5.0);
+
+    // Materialized copies carry the side-table data
+    auto copy = layer.getFeature(0);
+    auto* lineCopy = dynamic_cast<const LineFeature*>(copy.get());
+    ASSERT_NE(lineCopy, nullptr);
+    EXPECT_EQ(lineCopy->getNetName(), "GND");
+    EXPECT_EQ(lineCopy->getId(), "7");
+    EXPECT_EQ(lineCopy->getAttributes().count(".smd"), 1);
+    EXPECT_DOUBLE_EQ(lineCopy->getEnd().x, 10.0);
+
+    // Removing shifts rows and sparse keys
+    layer.removeFeature(0);
+    ASSERT_EQ(features.size(), 3);
+    EXPECT_TRUE(features.getLines().xs.empty());
+    EXPECT_EQ(features[0].getType(), FeatureType::Pad);
+    EXPECT_TRUE(features[0].getId().empty());
+    EXPECT_EQ(features[2].getNetName(), "GND");
+    EXPECT_NE(dynamic_cast<const SurfaceFeature*>(features[2].getObject()), nullptr);
+}
+
+TEST(LayerTest, SpatialQueriesMatchBruteForce) {
+    CopperLayer layer("top");
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(0.0, 100.0);
+    std::uniform_real_distribution<double> len(-2.0, 2.0);
+    for (int i = 0; i < 3000; ++i) {
+        double x = coord(rng), y = coord(rng);
+        if (i % 3 == 0) {
+            auto pad = std::make_unique<PadFeature>(x, y, "r10");
+            pad->setNetName(i % 2 ? "GND" : "VCC");
+            layer.addFeature(std::move(pad));
+        } else {
+            auto line = std::make_unique<LineFeature>(x, y, x + len(rng), y + len(rng), "r5");
+            line->setNetName(i % 2 ? "GND" : "VCC");
+            layer.addFeature(std::move(line));
+        }
+    }
+
+    const auto& features = layer.getFeatures();
+    const auto& extents = layer.getFeatureExtents();
+    auto bruteForce = [&](const BoundingBox2D& area) {
+        std::vector<size_t> result;
+        for (size_t i = 0; i < features.size(); ++i) {
+            const BoundingBox2D& box = extents[i];
+            if (box.min.x <= area.max.x && box.max.x >= area.min.x &&
+                box.min.y <= area.max.y && box.max.y >= area.min.y) {
+                result.push_back(i);
+            }
+        }
+        return result;
+    };
+
+    std::vector<BoundingBox2D> areas;
+    for (int q = 0; q < 50; ++q) {
+        double x = coord(rng), y = coord(rng);
+        areas.emplace_back(Point2D{x, y}, Point2D{x + 5.0, y + 3.0});
+    }
+    auto batch = layer.getFeaturesInAreas(areas, 4);
+    ASSERT_EQ(batch.size(), areas.size());
+    for (size_t q = 0; q < areas.size(); ++q) {
+        auto expected = bruteForce(areas[q]);
+        EXPECT_EQ(layer.getFeaturesInArea(areas[q]), expected);
+        EXPECT_EQ(batch[q], expected);
+    }
+
+    // Nearest by box distance
+    Point2D probe{50.0, 50.0};
+    double distance = -1.0;
+    size_t nearest = layer.getNearestFeature(probe, &distance);
+    ASSERT_NE(nearest, SpatialIndex::npos);
+    double best = 1e30;
+    for (size_t i = 0; i < features.size(); ++i) {
+        const BoundingBox2D& box = extents[i];
+        double dx = std::max({box.min.x - probe.x, 0.0, probe.x - box.max.x});
+        double dy = std::max({box.min.y - probe.y, 0.0, probe.y - box.max.y});
+        best = std::min(best, std::sqrt(dx * dx + dy * dy));
+    }
+    EXPECT_DOUBLE_EQ(distance, best);
+
+    // Net index
+    auto pads = layer.getPadsOnNet("VCC");
+    EXPECT_EQ(pads.size(), 500);
+    for (size_t i : pads) {
+        EXPECT_EQ(features[i].getType(), FeatureType::Pad);
+        EXPECT_EQ(features[i].getNetName(), "VCC");
+    }
+    EXPECT_EQ(layer.getTracesOnNet("GND").size() + layer.getPadsOnNet("GND").size(),
+              layer.getFeaturesByNet("GND").size());
+
+    // addFeature invalidates both indices
+    auto pad = std::make_unique<PadFeature>(500.0, 500.0, "r10");
+    pad->setNetName("VCC");
+    layer.addFeature(std::move(pad));
+    EXPECT_EQ(layer.getFeaturesAt({500.0, 500.0}), (std::vector<size_t>{3000}));
+    EXPECT_EQ(layer.getPadsOnNet("VCC").size(), 501);
+}
+
+TEST(LayerTest, FeatureExtentsPlaceSymbols) {
+    CopperLayer layer("top");
+    layer.setUnits("INCH");
+    const char* symbols[] = {"rect20x40", "oval20x60", "r30", "rect20x40xr5", "di20x40", "logo"};
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> coord(0.0, 10.0);
+    std::uniform_int_distribution<int> pick(0, 5);
+    std::uniform_int_distribution<int> orient(0, 11);
+    for (int i = 0; i < 40000; ++i) {
+        // Mostly quarter turns, some arbitrary angles, a few mirrored and resized
+        int o = orient(rng);
+        double rotation = o < 8 ? 90.0 * (o % 4) : 37.5 * o;
+        auto pad = std::make_unique<PadFeature>(coord(rng), coord(rng), symbols[pick(rng)], rotation, o % 3 == 0);
+        if (i % 7 == 0) {
+            pad->setResizeFactor(1.5);
+            pad->setHasResize(true);
+        }
+        layer.addFeature(std::move(pad));
+    }
+    layer.addFeature(std::make_unique<LineFeature>(1.0, 1.0, 2.0, 1.5, "s10"));
+
+    SymbolCache cache;
+    const auto& features = layer.getFeatures();
+    const auto& extents = layer.getFeatureExtents();
+    ASSERT_EQ(extents.size(), features.size());
+    for (size_t i = 0; i + 1 < features.size(); ++i) {
+        auto pad = features[i].materialize();
+        BoundingBox2D expected = static_cast<const PadFeature&>(*pad).getBoundingBox(cache, "INCH");
+        ASSERT_NEAR(extents[i].min.x, expected.min.x, 1e-12) << i;
+        ASSERT_NEAR(extents[i].min.y, expected.min.y, 1e-12) << i;
+        ASSERT_NEAR(extents[i].max.x, expected.max.x, 1e-12) << i;
+        ASSERT_NEAR(extents[i].max.y, expected.max.y, 1e-12) << i;
+    }
+    const BoundingBox2D& line = extents.back();
+    EXPECT_DOUBLE_EQ(line.min.x, 0.995);
+    EXPECT_DOUBLE_EQ(line.max.y, 1.505);
+
+    // Same boxes on any thread count, into reused storage
+    std::vector<BoundingBox2D> boxes(3);
+    features.computeExtents(cache.resolve(features.getSymbols(), "INCH"), boxes, 1);
+    ASSERT_EQ(boxes.size(), extents.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        EXPECT_EQ(boxes[i].min.x, extents[i].min.x);
+        EXPECT_EQ(boxes[i].max.y, extents[i].max.y);
+    }
+    BoundingBox2D extent = layer.getExtent();
+    EXPECT_LT(extent.min.x, layer.getBoundingBox().min.x);
+}
+
 // ============================================================================
 // Layer Attributes Tests
 // ============================================================================
@@ -185,8 +376,8 @@ TEST(LayerDefinitionTest, SetValues) {
     def.polarity = Polarity::Positive;
     def.side = Side::Inner;
     def.row = 2;
-    def.startName = 0;
-    def.endName = 0;
+    def.startName = "";
+    def.endName = "";
 
     EXPECT_EQ(def.name, "signal_1");
     EXPECT_EQ(def.type, LayerType::Signal);
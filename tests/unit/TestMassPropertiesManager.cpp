@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <koo/dyna/Model.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/dyna/managers/MassPropertiesManager.hpp>
+
+using namespace koo::dyna;
+using namespace koo::dyna::managers;
+using namespace koo;
+
+namespace {
+
+void addMaterial(Model& model, MaterialId id, double density) {
+    auto mat = std::make_unique<MatElastic>();
+    mat->getData().id = id;
+    mat->getData().ro = density;
+    mat->getData().e = 1.0;
+    mat->getData().pr = 0.3;
+    model.addKeyword(std::move(mat));
+}
+
+// Unit cube solid (part 1, density 1) with corner at the origin
+void buildCubeModel(Model& model) {
+    addMaterial(model, 1, 1.0);
+    model.getOrCreateParts().addPart(1, 1, 1);
+
+    auto& nodes = model.getOrCreateNodes();
+    nodes.addNode(1, 0.0, 0.0, 0.0);
+    nodes.addNode(2, 1.0, 0.0, 0.0);
+    nodes.addNode(3, 1.0, 1.0, 0.0);
+    nodes.addNode(4, 0.0, 1.0, 0.0);
+    nodes.addNode(5, 0.0, 0.0, 1.0);
+    nodes.addNode(6, 1.0, 0.0, 1.0);
+    nodes.addNode(7, 1.0, 1.0, 1.0);
+    nodes.addNode(8, 0.0, 1.0, 1.0);
+
+    model.getOrCreateSolidElements().addElement(1, 1, 1, 2, 3, 4, 5, 6, 7, 8);
+}
+
+} // anonymous namespace
+
+TEST(MassPropertiesManagerTest, SolidCube) {
+    Model model;
+    buildCubeModel(model);
+
+    MassPropertiesManager mgr(model);
+    auto report = mgr.compute();
+
+    ASSERT_EQ(report.parts.size(), 1);
+    const auto& cube = report.parts[0].properties;
+    EXPECT_NEAR(cube.mass, 1.0, 1e-12);
+    EXPECT_NEAR(cube.centerOfGravity.x, 0.5, 1e-12);
+    EXPECT_NEAR(cube.centerOfGravity.y, 0.5, 1e-12);
+    EXPECT_NEAR(cube.centerOfGravity.z, 0.5, 1e-12);
+
+    // Mass lumped to the 8 corners
+    EXPECT_NEAR(cube.inertia.ixx, 0.5, 1e-12);
+    EXPECT_NEAR(cube.inertia.iyy, 0.5, 1e-12);
+    EXPECT_NEAR(cube.inertia.ixy, 0.0, 1e-12);
+}
+
+TEST(MassPropertiesManagerTest, PointMassAndShell) {
+    Model model;
+    buildCubeModel(model);
+
+    addMaterial(model, 2, 2.0);
+    auto sec = std::make_unique<SectionShell>();
+    sec->setSectionId(2);
+    sec->setThickness(0.5);
+    model.addKeyword(std::move(sec));
+    model.getOrCreateParts().addPart(2, 2, 2);
+    model.getOrCreateShellElements().addElement(10, 2, 1, 2, 3, 4);
+
+    auto& nodes = model.getOrCreateNodes();
+    nodes.addNode(100, 10.0, 0.0, 0.0);
+    auto masses = std::make_unique<ElementMass>();
+    masses->addElement(MassElementData(20, 100, 3.0));
+    model.addKeyword(std::move(masses));
+
+    MassPropertiesManager mgr(model);
+    auto report = mgr.compute();
+
+    ASSERT_EQ(report.parts.size(), 2);
+    EXPECT_NEAR(report.parts[1].properties.mass, 2.0 * 1.0 * 0.5, 1e-12);
+    EXPECT_NEAR(report.unassigned.mass, 3.0, 1e-12);
+
+    EXPECT_NEAR(report.total.mass, 5.0, 1e-12);
+    double cx = (1.0 * 0.5 + 1.0 * 0.5 + 3.0 * 10.0) / 5.0;
+    EXPECT_NEAR(report.total.centerOfGravity.x, cx, 1e-12);
+    EXPECT_EQ(report.total.elementCount, 3);
+}
+
+TEST(MassPropertiesManagerTest, PartInertiaOverridesElements) {
+    Model model;
+    buildCubeModel(model);
+
+    auto inertia = std::make_unique<PartInertia>();
+    inertia->getData().pid = 1;
+    inertia->getData().mid = 1;
+    inertia->getData().tm = 42.0;
+    inertia->getData().xc = 1.0;
+    inertia->getData().ixx = 7.0;
+    model.addKeyword(std::move(inertia));
+
+    MassPropertiesManager mgr(model);
+    auto report = mgr.compute();
+
+    ASSERT_EQ(report.parts.size(), 1);
+    EXPECT_TRUE(report.parts[0].fromPartInertia);
+    EXPECT_DOUBLE_EQ(report.parts[0].properties.mass, 42.0);
+    EXPECT_DOUBLE_EQ(report.total.inertia.ixx, 7.0);
+    EXPECT_EQ(report.skippedCount, 0);
+}
+
+TEST(MassPropertiesManagerTest, ThreadCountIndependent) {
+    Model model;
+    addMaterial(model, 1, 7.85e-9);
+    auto sec = std::make_unique<SectionShell>();
+    sec->setSectionId(1);
+    sec->setThickness(1.2);
+    model.addKeyword(std::move(sec));
+    model.getOrCreateParts().addPart(1, 1, 1);
+
+    // 100 x 100 shell grid, enough for several reduction blocks
+    const int n = 100;
+    auto& nodes = model.getOrCreateNodes();
+    for (int j = 0; j <= n; ++j) {
+        for (int i = 0; i <= n; ++i) {
+            nodes.addNode(j * (n + 1) + i + 1, 0.1 * i, 0.13 * j, 0.01 * i * j);
+        }
+    }
+    auto& shells = model.getOrCreateShellElements();
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            NodeId n1 = j * (n + 1) + i + 1;
+            shells.addElement(j * n + i + 1, 1, n1, n1 + 1, n1 + n + 2, n1 + n + 1);
+        }
+    }
+
+    MassPropertiesManager mgr(model);
+    MassPropertiesManager::Options serial;
+    serial.threads = 1;
+    MassPropertiesManager::Options parallel;
+    parallel.threads = 4;
+
+    auto a = mgr.compute(serial);
+    auto b = mgr.compute(parallel);
+    EXPECT_EQ(a.total.mass, b.total.mass);
+    EXPECT_EQ(a.total.centerOfGravity.x, b.total.centerOfGravity.x);
+    EXPECT_EQ(a.total.inertia.ixx, b.total.inertia.ixx);
+    EXPECT_EQ(a.total.inertia.ixz, b.total.inertia.ixz);
+}
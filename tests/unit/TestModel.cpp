@@ -76,6 +76,20 @@ TEST(ModelTest, FindNode) {
     EXPECT_EQ(notFound, nullptr);
 }
 
+TEST(ModelTest, GetNodePositions) {
+    Model model;
+    model.getOrCreateNodes().addNode(1, 1.0, 2.0, 3.0);
+    auto extra = std::make_unique<Node>();
+    extra->addNode(2, 4.0, 5.0, 6.0);
+    extra->addNode(1, 7.0, 8.0, 9.0);
+    model.addKeyword(std::move(extra));
+
+    auto positions = model.getNodePositions();
+    ASSERT_EQ(positions.size(), 2u);
+    EXPECT_DOUBLE_EQ(positions[1].x, 7.0);
+    EXPECT_DOUBLE_EQ(positions[2].z, 6.0);
+}
+
 TEST(ModelTest, FindPart) {
     Model model;
 
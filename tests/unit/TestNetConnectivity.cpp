@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+#include <koo/ecad/NetConnectivity.hpp>
+#include <koo/ecad/Layer.hpp>
+#include <koo/ecad/Step.hpp>
+#include <random>
+
+using namespace koo::ecad;
+
+namespace {
+
+void addMatrixLayer(LayerMatrix& matrix, const std::string& name, LayerType type, int row) {
+    LayerDefinition def;
+    def.name = name;
+    def.type = type;
+    def.row = row;
+    matrix.addLayer(def);
+}
+
+Layer* addStepLayer(Step& step, const std::string& name) {
+    auto layer = std::make_unique<Layer>(name);
+    layer->setUnits("INCH");
+    Layer* raw = layer.get();
+    step.addLayer(std::move(layer));
+    return raw;
+}
+
+void addNet(EdaData& eda, const std::string& name, int number,
+            const std::vector<FeatureId>& features) {
+    auto net = std::make_unique<Net>(name);
+    net->setNetNumber(number);
+    eda.addNet(std::move(net));
+    for (const auto& fid : features) {
+        EdaData::FeatureIdRecord record;
+        record.featureId = fid;
+        record.netNum = number;
+        eda.addFeatureIdRecord(record);
+    }
+}
+
+/// Two signal layers joined by a through via, plus a separate trace
+struct TwoLayerBoard {
+    Step step{"pcb"};
+    LayerMatrix matrix;
+    Layer* top = nullptr;
+    Layer* bottom = nullptr;
+    Layer* drill = nullptr;
+
+    TwoLayerBoard() {
+        addMatrixLayer(matrix, "top", LayerType::Signal, 1);
+        addMatrixLayer(matrix, "bottom", LayerType::Signal, 2);
+        addMatrixLayer(matrix, "drill", LayerType::Drill, 3);
+        addMatrixLayer(matrix, "silk", LayerType::SilkScreen, 4);
+        top = addStepLayer(step, "top");
+        bottom = addStepLayer(step, "bottom");
+        drill = addStepLayer(step, "drill");
+        addStepLayer(step, "silk")->addFeature(std::make_unique<LineFeature>(0, 0, 3, 0, "r10"));
+
+        top->addFeature(std::make_unique<LineFeature>(0, 0, 1, 0, "r10"));      // top 0
+        top->addFeature(std::make_unique<PadFeature>(1, 0, "r20"));             // top 1
+        top->addFeature(std::make_unique<LineFeature>(2, 0, 3, 0, "r10"));      // top 2
+
+        bottom->addFeature(std::make_unique<ArcFeature>(1, 0, 1, 1, 1, 0.5, "r10", true));  // bottom 0
+        SurfaceFeature plane;
+        Contour outline(0.9, 0.9);
+        outline.addLineSegment(1.5, 0.9);
+        outline.addLineSegment(1.5, 1.5);
+        outline.addLineSegment(0.9, 1.5);
+        outline.addLineSegment(0.9, 0.9);
+        plane.addContour(outline);
+        bottom->addFeature(plane.clone());                                      // bottom 1
+
+        drill->addFeature(std::make_unique<PadFeature>(1, 0, "r8"));            // drill 0
+
+        EdaData& eda = step.getEdaData();
+        eda.setLayerNames({"top", "bottom", "drill"});
+        addNet(eda, "SIG", 0, {{'C', 0, 0}, {'C', 0, 1}, {'C', 1, 0}, {'C', 1, 1}, {'H', 2, 0}});
+        addNet(eda, "GND", 1, {{'C', 0, 2}});
+    }
+};
+
+} // anonymous namespace
+
+TEST(NetConnectivityTest, ConnectsThroughDrills) {
+    TwoLayerBoard board;
+    NetConnectivity connectivity(board.step, board.matrix);
+    auto result = connectivity.extract();
+
+    ASSERT_EQ(result.layers, (std::vector<std::string>{"top", "bottom", "drill"}));
+    EXPECT_EQ(result.componentCount, 2);
+    EXPECT_TRUE(result.ok());
+    EXPECT_TRUE(result.issues.empty());
+
+    uint32_t sig = result.getComponent("top", 0);
+    EXPECT_EQ(result.getComponent("top", 1), sig);
+    EXPECT_EQ(result.getComponent("bottom", 0), sig);
+    EXPECT_EQ(result.getComponent("bottom", 1), sig);
+    EXPECT_EQ(result.getComponent("drill", 0), sig);
+    EXPECT_NE(result.getComponent("top", 2), sig);
+    EXPECT_EQ(result.getComponent("silk", 0), NetConnectivity::kNoComponent);
+    EXPECT_EQ(result.getComponent("top", 99), NetConnectivity::kNoComponent);
+}
+
+TEST(NetConnectivityTest, ReportsOpensAndShorts) {
+    using Type = NetConnectivity::IssueType;
+
+    // Without the via SIG falls apart into the top and bottom copper
+    TwoLayerBoard open;
+    open.drill->clearFeatures();
+    auto result = NetConnectivity(open.step, open.matrix).extract();
+    EXPECT_EQ(result.openCount, 1);
+    EXPECT_EQ(result.shortCount, 0);
+    ASSERT_EQ(result.issues.size(), 1);
+    EXPECT_EQ(result.issues[0].type, Type::Open);
+    EXPECT_EQ(result.issues[0].nets, (std::vector<std::string>{"SIG"}));
+    EXPECT_EQ(result.issues[0].components.size(), 2);
+    EXPECT_EQ(NetConnectivity::formatIssue(result.issues[0]),
+              "Open: net SIG is split into 2 components");
+
+    // A sliver from the pad to the GND trace shorts the two nets
+    TwoLayerBoard shorted;
+    shorted.top->addFeature(std::make_unique<LineFeature>(1, 0, 2, 0, "r2"));
+    result = NetConnectivity(shorted.step, shorted.matrix).extract();
+    EXPECT_EQ(result.openCount, 0);
+    EXPECT_EQ(result.shortCount, 1);
+    ASSERT_EQ(result.issues.size(), 1);
+    EXPECT_EQ(result.issues[0].type, Type::Short);
+    EXPECT_EQ(result.issues[0].nets, (std::vector<std::string>{"GND", "SIG"}));
+    EXPECT_EQ(result.componentCount, 1);
+
+    // A small gap closes with tolerance
+    TwoLayerBoard gapped;
+    NetConnectivity::Options options;
+    options.tolerance = 1.0;
+    result = NetConnectivity(gapped.step, gapped.matrix).extract(options);
+    EXPECT_EQ(result.shortCount, 1);
+
+    // Negative features do not conduct and clear the gap they are drawn over
+    auto cut = std::make_unique<LineFeature>(1.2, 0, 1.8, 0, "r10");
+    cut->setPolarity(Polarity::Negative);
+    gapped.top->addFeature(std::move(cut));
+    result = NetConnectivity(gapped.step, gapped.matrix).extract();
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.getComponent("top", 3), NetConnectivity::kNoComponent);
+    result = NetConnectivity(gapped.step, gapped.matrix).extract(options);
+    EXPECT_TRUE(result.ok());
+}
+
+TEST(NetConnectivityTest, PlaneClearances) {
+    // A via through a ground plane, joined to a signal pad on top
+    auto build = [](Step& step, LayerMatrix& matrix) {
+        addMatrixLayer(matrix, "top", LayerType::Signal, 1);
+        addMatrixLayer(matrix, "plane", LayerType::PowerGround, 2);
+        addMatrixLayer(matrix, "drill", LayerType::Drill, 3);
+        addStepLayer(step, "top")->addFeature(std::make_unique<PadFeature>(1, 1, "r20"));
+        addStepLayer(step, "drill")->addFeature(std::make_unique<PadFeature>(1, 1, "r8"));
+        Layer* plane = addStepLayer(step, "plane");
+        plane->addFeature(std::make_unique<PadFeature>(0.5, 0.5, "r10"));   // plane 0, under the plane
+        plane->getFeatures().setNetName(0, "GND");
+        step.getLayer("top")->getFeatures().setNetName(0, "SIG");
+        return plane;
+    };
+    auto square = [](double x0, double y0, double x1, double y1, PolygonType type) {
+        Contour contour(x0, y0, type);
+        contour.addLineSegment(x1, y0);
+        contour.addLineSegment(x1, y1);
+        contour.addLineSegment(x0, y1);
+        contour.addLineSegment(x0, y0);
+        return contour;
+    };
+
+    // Solid plane: the via shorts SIG to GND
+    Step solid("pcb");
+    LayerMatrix solidMatrix;
+    SurfaceFeature plane;
+    plane.addContour(square(0, 0, 2, 2, PolygonType::Island));
+    build(solid, solidMatrix)->addFeature(plane.clone());
+    auto result = NetConnectivity(solid, solidMatrix).extract();
+    EXPECT_EQ(result.shortCount, 1);
+
+    // A negative antipad drawn over the plane clears the via
+    auto antipad = std::make_unique<PadFeature>(1, 1, "r40");
+    antipad->setPolarity(Polarity::Negative);
+    solid.getLayer("plane")->addFeature(std::move(antipad));
+    result = NetConnectivity(solid, solidMatrix).extract();
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(result.getComponent("drill", 0), result.getComponent("top", 0));
+    EXPECT_NE(result.getComponent("drill", 0), result.getComponent("plane", 1));
+    EXPECT_EQ(result.getComponent("plane", 0), result.getComponent("plane", 1));
+
+    // An antipad drawn before the plane is covered by it again
+    Step early("pcb");
+    LayerMatrix earlyMatrix;
+    Layer* earlyPlane = build(early, earlyMatrix);
+    antipad = std::make_unique<PadFeature>(1, 1, "r40");
+    antipad->setPolarity(Polarity::Negative);
+    earlyPlane->addFeature(std::move(antipad));
+    earlyPlane->addFeature(plane.clone());
+    result = NetConnectivity(early, earlyMatrix).extract();
+    EXPECT_EQ(result.shortCount, 1);
+
+    // A hole contour in the plane clears the via as well
+    Step holed("pcb");
+    LayerMatrix holedMatrix;
+    SurfaceFeature cutout;
+    cutout.addContour(square(0, 0, 2, 2, PolygonType::Island));
+    cutout.addContour(square(0.9, 0.9, 1.1, 1.1, PolygonType::Hole));
+    build(holed, holedMatrix)->addFeature(cutout.clone());
+    result = NetConnectivity(holed, holedMatrix).extract();
+    EXPECT_TRUE(result.ok());
+    EXPECT_NE(result.getComponent("drill", 0), result.getComponent("plane", 1));
+}
+
+TEST(NetConnectivityTest, DrillSpanAndNetNames) {
+    TwoLayerBoard board;
+    board.step.getEdaData() = EdaData();
+
+    // Blind via stopping at the top layer leaves the bottom copper apart
+    LayerMatrix blind;
+    addMatrixLayer(blind, "top", LayerType::Signal, 1);
+    addMatrixLayer(blind, "bottom", LayerType::Signal, 2);
+    LayerDefinition def;
+    def.name = "drill";
+    def.type = LayerType::Drill;
+    def.row = 3;
+    def.startName = "top";
+    def.endName = "top";
+    blind.addLayer(def);
+
+    board.top->getFeatures().setNetName(0, "A");
+    board.bottom->getFeatures().setNetName(0, "A");
+    auto result = NetConnectivity(board.step, blind).extract();
+    EXPECT_EQ(result.componentCount, 3);
+    EXPECT_EQ(result.openCount, 1);
+    EXPECT_NE(result.getComponent("drill", 0), result.getComponent("bottom", 0));
+
+    result = NetConnectivity(board.step, board.matrix).extract();
+    EXPECT_EQ(result.componentCount, 2);
+    EXPECT_TRUE(result.ok());
+}
+
+TEST(NetConnectivityTest, ThreadCountInvariant) {
+    Step step("pcb");
+    LayerMatrix matrix;
+    addMatrixLayer(matrix, "l1", LayerType::Signal, 1);
+    Layer* layer = addStepLayer(step, "l1");
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> pos(0.0, 20.0);
+    std::uniform_real_distribution<double> len(-0.3, 0.3);
+    for (int i = 0; i < 5000; ++i) {
+        double x = pos(rng), y = pos(rng);
+        if (i % 3 == 0) {
+            layer->addFeature(std::make_unique<PadFeature>(x, y, "rect30x10", 45.0 * (i % 4)));
+        } else {
+            layer->addFeature(std::make_unique<LineFeature>(x, y, x + len(rng), y + len(rng), "r5"));
+        }
+    }
+
+    NetConnectivity connectivity(step, matrix);
+    NetConnectivity::Options options;
+    options.threads = 1;
+    auto serial = connectivity.extract(options);
+    options.threads = 8;
+    auto parallel = connectivity.extract(options);
+
+    EXPECT_GT(serial.contactCount, 0);
+    EXPECT_LT(serial.componentCount, 5000);
+    EXPECT_EQ(serial.contactCount, parallel.contactCount);
+    EXPECT_EQ(serial.componentCount, parallel.componentCount);
+    EXPECT_EQ(serial.components, parallel.components);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <koo/ecad/OdbJob.hpp>
 #include <koo/ecad/Step.hpp>
+#include <koo/ecad/StepInstances.hpp>
 
 using namespace koo::ecad;
 
@@ -148,6 +149,47 @@ TEST(OdbJobTest, GetSymbolNames) {
     EXPECT_EQ(names.size(), 2);
 }
 
+TEST(OdbJobTest, LayersResolveUserSymbols) {
+    // Inch symbol: a 0.1 x 0.05 plate right of its origin
+    OdbJob job;
+    auto logo = std::make_unique<Symbol>("logo");
+    logo->setUnit('I');
+    SurfaceFeature plate;
+    Contour outline(0.0, 0.0);
+    outline.addLineSegment(0.1, 0.0);
+    outline.addLineSegment(0.1, 0.05);
+    outline.addLineSegment(0.0, 0.05);
+    outline.addLineSegment(0.0, 0.0);
+    plate.addContour(outline);
+    logo->addFeature(plate.clone());
+    job.addSymbol(std::move(logo));
+
+    auto makeLayer = [] {
+        auto layer = std::make_unique<Layer>("top");
+        layer->setUnits("INCH");
+        layer->addFeature(std::make_unique<PadFeature>(1.0, 1.0, "logo"));
+        return layer;
+    };
+
+    // Layers added to a step of the job, and steps added with their layers
+    Step& created = job.createStep("pcb");
+    created.addLayer(makeLayer());
+    auto added = std::make_unique<Step>("panel");
+    added->addLayer(makeLayer());
+    job.addStep(std::move(added));
+
+    for (const char* name : {"pcb", "panel"}) {
+        const Layer* layer = job.getStep(name)->getLayer("top");
+        EXPECT_EQ(layer->getSymbolCache(), &job.getSymbolCache());
+        EXPECT_NEAR(layer->getExtent().max.x, 1.1, 1e-9) << name;
+        EXPECT_EQ(layer->getFeaturesAt({1.05, 1.02}), std::vector<size_t>{0}) << name;
+    }
+
+    // A detached layer only knows the standard symbols
+    auto detached = makeLayer();
+    EXPECT_TRUE(detached->getFeaturesAt({1.05, 1.02}).empty());
+}
+
 // ============================================================================
 // Attributes Tests
 // ============================================================================
@@ -476,15 +518,200 @@ TEST(OdbJobTest, MoveConstruction) {
     EXPECT_EQ(job2.getName(), "original");
     EXPECT_EQ(job2.getStepCount(), 1);
     EXPECT_EQ(job2.getAttribute("key"), "value");
+
+    // The moved-from job is left usable, with its own symbols
+    EXPECT_EQ(job1.getSymbol("logo"), nullptr);
+    auto logo = std::make_unique<Symbol>("logo");
+    logo->addFeature(std::make_unique<PadFeature>(0, 0, "r10"));
+    job1.addSymbol(std::move(logo));
+    EXPECT_NE(job1.getSymbol("logo"), nullptr);
+    EXPECT_EQ(job2.getSymbol("logo"), nullptr);
+    EXPECT_TRUE(job1.getSymbolCache().get("logo", "INCH").isValid());
+    job1.createStep("pcb");
+    EXPECT_EQ(job1.getStepCount(), 1);
 }
 
 TEST(OdbJobTest, MoveAssignment) {
     OdbJob job1("first");
     job1.createStep("step1");
 
+    job1.getStep("step1")->addLayer(std::make_unique<Layer>("top"));
+    job1.addSymbol(std::make_unique<Symbol>("logo"));
+
     OdbJob job2("second");
+    job2.createStep("step2");
     job2 = std::move(job1);
 
     EXPECT_EQ(job2.getName(), "first");
     EXPECT_EQ(job2.getStepCount(), 1);
+    EXPECT_NE(job2.getSymbol("logo"), nullptr);
+    // Moved layers still resolve symbols through the moved cache
+    EXPECT_EQ(job2.getStep("step1")->getLayer("top")->getSymbolCache(), &job2.getSymbolCache());
+
+    EXPECT_EQ(job1.getSymbol("logo"), nullptr);
+    EXPECT_EQ(job1.getSymbolNames().size(), 0u);
+    EXPECT_NE(&job1.getSymbolCache(), &job2.getSymbolCache());
+    job1.addSymbol(std::make_unique<Symbol>("logo"));
+    EXPECT_NE(job1.getSymbol("logo"), nullptr);
+}
+
+// ============================================================================
+// Step Instance Tests
+// ============================================================================
+
+namespace {
+
+void buildPanelJob(OdbJob& job) {
+    Step& pcb = job.createStep("pcb");
+    auto top = std::make_unique<Layer>("top");
+    auto line = std::make_unique<LineFeature>(0, 0, 1, 0, "r10");
+    line->setNetName("GND");
+    line->setId("7");
+    top->addFeature(std::move(line));
+    top->addFeature(std::make_unique<PadFeature>(1, 0.5, "rect20x10", 30.0));
+    top->addFeature(std::make_unique<ArcFeature>(0, 1, 1, 1, 0.5, 1, "r5", true));
+    SurfaceFeature surface;
+    Contour outline(2, 0);
+    outline.addLineSegment(3, 0);
+    outline.addArcSegment(3, 1, 3, 0.5, false);
+    outline.addLineSegment(2, 0);
+    surface.addContour(outline);
+    top->addFeature(surface.clone());
+    pcb.addLayer(std::move(top));
+
+    Step& panel = job.createStep("panel");
+    panel.setType(StepType::Panel);
+    auto rail = std::make_unique<Layer>("top");
+    rail->addFeature(std::make_unique<PadFeature>(-1, -1, "r40"));
+    panel.addLayer(std::move(rail));
+
+    StepRepeat grid;
+    grid.stepName = "pcb";
+    grid.x = 10;
+    grid.dx = 5;
+    grid.dy = 4;
+    grid.nx = 3;
+    grid.ny = 2;
+    grid.angle = 90;
+    panel.addStepRepeat(grid);
+
+    StepRepeat flipped;
+    flipped.stepName = "pcb";
+    flipped.x = -10;
+    flipped.mirror = true;
+    panel.addStepRepeat(flipped);
+
+    StepRepeat missing;
+    missing.stepName = "coupon";
+    panel.addStepRepeat(missing);
+}
+
+} // anonymous namespace
+
+TEST(StepInstancesTest, Transform2D) {
+    Transform2D rotate(90.0, false, {10.0, 0.0});
+    Point2D p = rotate.apply({1.0, 0.0});
+    EXPECT_DOUBLE_EQ(p.x, 10.0);
+    EXPECT_DOUBLE_EQ(p.y, -1.0);
+
+    Transform2D mirror(30.0, true, {1.0, 2.0});
+    Transform2D combined = rotate * mirror;
+    Point2D q{0.3, -0.7};
+    Point2D a = combined.apply(q);
+    Point2D b = rotate.apply(mirror.apply(q));
+    EXPECT_NEAR(a.x, b.x, 1e-12);
+    EXPECT_NEAR(a.y, b.y, 1e-12);
+
+    Point2D back = combined.inverse().apply(a);
+    EXPECT_NEAR(back.x, q.x, 1e-12);
+    EXPECT_NEAR(back.y, q.y, 1e-12);
+    EXPECT_DOUBLE_EQ(Transform2D::normalizeAngle(-90.0), 270.0);
+}
+
+TEST(StepInstancesTest, ExpandsRepeats) {
+    OdbJob job("panel_job");
+    buildPanelJob(job);
+    StepInstances panel(job, *job.getStep("panel"));
+
+    ASSERT_EQ(panel.size(), 8);
+    EXPECT_EQ(panel[0].step, job.getStep("panel"));
+    EXPECT_TRUE(panel[0].transform.isIdentity());
+    EXPECT_EQ(panel[0].parent, StepInstance::npos);
+    ASSERT_EQ(panel.getWarnings().size(), 1);
+
+    // Third column, second row of the rotated grid
+    const StepInstance& cell = panel[6];
+    EXPECT_EQ(cell.column, 2);
+    EXPECT_EQ(cell.row, 1);
+    EXPECT_EQ(cell.parent, 0);
+    EXPECT_EQ(cell.depth, 1);
+    Point2D p = cell.transform.apply({1.0, 0.0});
+    EXPECT_DOUBLE_EQ(p.x, 20.0);
+    EXPECT_DOUBLE_EQ(p.y, 3.0);
+
+    EXPECT_EQ(panel.getFeatureCount("top"), 1 + 7 * 4);
+    size_t visited = 0;
+    panel.forEachFeature("top", [&](size_t instance, const FeatureView& feature) {
+        EXPECT_LT(instance, panel.size());
+        EXPECT_LT(feature.getIndex(), 4);
+        ++visited;
+    });
+    EXPECT_EQ(visited, 29);
+
+    // Mirrored instance flips pads and arcs
+    auto pad = panel.getFeature("top", {7, 1});
+    ASSERT_NE(pad, nullptr);
+    const auto& flippedPad = static_cast<const PadFeature&>(*pad);
+    EXPECT_TRUE(flippedPad.isMirrored());
+    EXPECT_DOUBLE_EQ(flippedPad.getRotation(), 330.0);
+    EXPECT_DOUBLE_EQ(flippedPad.getPosition().x, -11.0);
+    auto arc = panel.getFeature("top", {7, 2});
+    EXPECT_FALSE(static_cast<const ArcFeature&>(*arc).isClockwise());
+    EXPECT_EQ(panel.getFeature("top", {7, 9}), nullptr);
+}
+
+TEST(StepInstancesTest, QueriesAndMaterializes) {
+    OdbJob job("panel_job");
+    buildPanelJob(job);
+    StepInstances panel(job, *job.getStep("panel"));
+
+    // The line of the first grid cell runs from (10, 0) to (10, -1)
+    auto hits = panel.query("top", BoundingBox2D({9.9, -0.6}, {10.1, -0.4}));
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].instance, 1);
+    EXPECT_EQ(hits[0].feature, 0);
+    hits = panel.queryPoint("top", {-1, -1});
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].instance, 0);
+    // The rail pad is found anywhere on its copper, not only at its center
+    hits = panel.queryPoint("top", {-1.015, -1});
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].instance, 0);
+    EXPECT_TRUE(panel.query("top", BoundingBox2D({100, 100}, {101, 101})).empty());
+
+    auto flat = panel.materialize("top", 1);
+    auto parallel = panel.materialize("top", 4);
+    ASSERT_EQ(flat->getFeatureCount(), 29);
+    ASSERT_EQ(parallel->getFeatureCount(), 29);
+
+    size_t global = 0;
+    for (size_t i = 0; i < panel.size(); ++i) {
+        size_t count = panel.getLayer(i, "top")->getFeatureCount();
+        for (size_t f = 0; f < count; ++f, ++global) {
+            auto expected = panel.getFeature("top", {i, f});
+            auto actual = flat->getFeature(global);
+            auto other = parallel->getFeature(global);
+            ASSERT_EQ(actual->getType(), expected->getType());
+            BoundingBox2D e = expected->getBoundingBox();
+            BoundingBox2D a = actual->getBoundingBox();
+            EXPECT_NEAR(a.min.x, e.min.x, 1e-12);
+            EXPECT_NEAR(a.min.y, e.min.y, 1e-12);
+            EXPECT_NEAR(a.max.x, e.max.x, 1e-12);
+            EXPECT_NEAR(a.max.y, e.max.y, 1e-12);
+            EXPECT_EQ(actual->getNetName(), expected->getNetName());
+            EXPECT_EQ(actual->getId(), expected->getId());
+            EXPECT_EQ(other->getBoundingBox().min.x, a.min.x);
+        }
+    }
+    EXPECT_EQ(flat->getFeaturesByNet("GND").size(), 7);
 }
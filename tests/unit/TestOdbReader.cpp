@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
+#include <koo/ecad/JobDiff.hpp>
+#include <koo/ecad/NetConnectivity.hpp>
+#include <koo/ecad/OdbCache.hpp>
 #include <koo/ecad/OdbReader.hpp>
 #include <koo/ecad/OdbWriter.hpp>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 
@@ -79,6 +84,38 @@ TEST_F(OdbReaderTest, ReadMatrix) {
     // Matrix should have at least the step we created
 }
 
+TEST_F(OdbReaderTest, ReadMatrixDrillSpanNames) {
+    // Blind via from signal_1 to signal_2 on a three layer board
+    auto odbPath = tempDir_ / "drill_span";
+    std::filesystem::create_directories(odbPath / "matrix");
+    std::ofstream(odbPath / "matrix" / "matrix")
+        << "STEP {\n   COL=1\n   NAME=pcb\n}\n"
+        << "LAYER {\n   ROW=1\n   CONTEXT=BOARD\n   TYPE=SIGNAL\n   NAME=signal_1\n   POLARITY=POSITIVE\n}\n"
+        << "LAYER {\n   ROW=2\n   CONTEXT=BOARD\n   TYPE=SIGNAL\n   NAME=signal_2\n   POLARITY=POSITIVE\n}\n"
+        << "LAYER {\n   ROW=3\n   CONTEXT=BOARD\n   TYPE=SIGNAL\n   NAME=signal_3\n   POLARITY=POSITIVE\n}\n"
+        << "LAYER {\n   ROW=4\n   CONTEXT=BOARD\n   TYPE=DRILL\n   NAME=via_1_2\n   POLARITY=POSITIVE\n"
+        << "   START_NAME=signal_1\n   END_NAME=signal_2\n}\n";
+
+    OdbReader reader;
+    LayerMatrix matrix = reader.readMatrix(odbPath);
+    const LayerDefinition* via = matrix.getLayerDefinition("via_1_2");
+    ASSERT_NE(via, nullptr);
+    EXPECT_EQ(via->startName, "signal_1");
+    EXPECT_EQ(via->endName, "signal_2");
+
+    // Pads stacked under the via: only the spanned layers join it
+    Step step("pcb");
+    for (const char* name : {"signal_1", "signal_2", "signal_3", "via_1_2"}) {
+        auto layer = std::make_unique<Layer>(name);
+        layer->addFeature(std::make_unique<PadFeature>(1.0, 1.0, std::string(name) == "via_1_2" ? "r8" : "r20"));
+        step.addLayer(std::move(layer));
+    }
+    auto result = NetConnectivity(step, matrix).extract();
+    EXPECT_EQ(result.componentCount, 2);
+    EXPECT_EQ(result.getComponent("signal_1", 0), result.getComponent("signal_2", 0));
+    EXPECT_NE(result.getComponent("signal_1", 0), result.getComponent("signal_3", 0));
+}
+
 TEST_F(OdbReaderTest, ListSteps) {
     auto odbPath = tempDir_ / "list_steps";
     createSimpleOdbStructure(odbPath);
@@ -220,6 +257,53 @@ TEST_F(OdbReaderTest, ReadCompressedFeatures) {
     EXPECT_EQ(1u, loadedLayer->getFeatureCount());
 }
 
+TEST_F(OdbReaderTest, StreamCompressedFeaturesAcrossChunks) {
+    // Several MB of feature text: spans many inflate chunks
+    OdbJob originalJob("stream_job");
+    Step& step = originalJob.createStep("pcb");
+    auto layer = std::make_unique<Layer>("top");
+    for (int i = 0; i < 60000; ++i) {
+        if (i % 1000 == 0) {
+            auto surface = std::make_unique<SurfaceFeature>();
+            Contour contour(0.0, 0.0, PolygonType::Island);
+            for (int k = 1; k <= 50; ++k) {
+                contour.addLineSegment(static_cast<double>(k), 0.123456789 * k);
+            }
+            surface->addContour(contour);
+            layer->addFeature(std::move(surface));
+        }
+        auto line = std::make_unique<LineFeature>();
+        line->setStart(0.123456789 * i, 1.0);
+        line->setEnd(2.0, 0.987654321 * i);
+        layer->addFeature(std::move(line));
+    }
+    step.addLayer(std::move(layer));
+
+    OdbWriter writer;
+    OdbWriter::Options writeOptions;
+    writeOptions.compressFeatures = true;
+    ASSERT_TRUE(writer.write(originalJob, tempDir_ / "stream", writeOptions)) << writer.getLastError();
+
+    OdbReader reader;
+    auto loaded = reader.readLayer(tempDir_ / "stream", "pcb", "top");
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_FALSE(reader.hasError()) << reader.getLastError();
+    ASSERT_EQ(60060u, loaded->getFeatureCount());
+    auto* surface = dynamic_cast<const SurfaceFeature*>(loaded->getFeatures()[59059].getObject());
+    ASSERT_NE(surface, nullptr);
+    EXPECT_EQ(50u, surface->getContours()[0].getSegments().size());
+
+    // A truncated stream keeps what was parsed and reports the error
+    auto featuresPath = tempDir_ / "stream" / "steps" / "pcb" / "layers" / "top" / "features.z";
+    std::filesystem::resize_file(featuresPath, std::filesystem::file_size(featuresPath) / 2);
+    OdbReader truncatedReader;
+    auto partial = truncatedReader.readLayer(tempDir_ / "stream", "pcb", "top");
+    ASSERT_NE(partial, nullptr);
+    EXPECT_TRUE(truncatedReader.hasError());
+    EXPECT_GT(partial->getFeatureCount(), 0u);
+    EXPECT_LT(partial->getFeatureCount(), 60060u);
+}
+
 TEST_F(OdbReaderTest, ReadUncompressedFeatures) {
     auto odbPath = tempDir_ / "uncompressed";
 
@@ -256,6 +340,63 @@ TEST_F(OdbReaderTest, ReadUncompressedFeatures) {
     EXPECT_EQ(1u, loadedLayer->getFeatureCount());
 }
 
+TEST_F(OdbReaderTest, ParseFeatureRecords) {
+    auto odbPath = tempDir_ / "records";
+    createSimpleOdbStructure(odbPath);
+
+    std::ofstream features(odbPath / "steps" / "pcb" / "layers" / "top" / "features");
+    features << "UNITS=MM\n"
+             << "$0 r10\n"
+             << "$1 rect20x10\n"
+             << "@0 .smd\n"
+             << "&0 some text\n"
+             << "# comment\n"
+             << "L 0 0 +1.5 2e1 0 N 3;0;ID=7\n"
+             << "P 1 2 -1 1 2.5 P 0 8 45.0;0\n"
+             << "A 0 0 1 1 0.5 0.5 0 P 0 Y\n"
+             << "T 1 1 standard P 0 0.2 0.3 1.0 'A; B' 1\n"
+             << "S N 4;0\n"
+             << "OB 0 0 I\n"
+             << "OS 1 0\n"
+             << "OC 0 0 0.5 0 Y\n"
+             << "OE\n"
+             << "SE\n";
+    features.close();
+
+    OdbReader reader;
+    auto layer = reader.readLayer(odbPath, "pcb", "top");
+    ASSERT_NE(layer, nullptr);
+    EXPECT_EQ("MM", layer->getUnits());
+    ASSERT_EQ(5u, layer->getFeatureCount());
+
+    const auto& f = layer->getFeatures();
+    auto line = f[0];
+    ASSERT_EQ(FeatureType::Line, line.getType());
+    EXPECT_EQ(Polarity::Negative, line.getPolarity());
+    EXPECT_EQ(3, line.getDcode());
+    EXPECT_EQ("r10", line.getSymbolName());
+
+    auto pad = f[1];
+    ASSERT_EQ(FeatureType::Pad, pad.getType());
+    EXPECT_EQ("rect20x10", pad.getSymbolName());
+    EXPECT_DOUBLE_EQ(2.5, pad.getResizeFactor());
+    EXPECT_DOUBLE_EQ(45.0, pad.getRotation());
+
+    auto arc = f[2];
+    ASSERT_EQ(FeatureType::Arc, arc.getType());
+    EXPECT_TRUE(arc.isClockwise());
+
+    auto* text = dynamic_cast<const TextFeature*>(f[3].getObject());
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ("A; B", text->getText());
+
+    auto* surface = dynamic_cast<const SurfaceFeature*>(f[4].getObject());
+    ASSERT_NE(surface, nullptr);
+    EXPECT_EQ(Polarity::Negative, surface->getPolarity());
+    EXPECT_EQ(4, surface->getDcode());
+    ASSERT_EQ(1u, surface->getContours().size());
+}
+
 // ============================================================================
 // Error Handling Tests
 // ============================================================================
@@ -406,6 +547,327 @@ TEST_F(OdbReaderTest, ReadSymbols) {
     EXPECT_NE(job.getSymbol("custom_pad"), nullptr);
 }
 
+TEST_F(OdbReaderTest, ParallelReadMatchesSerial) {
+    auto odbPath = tempDir_ / "parallel_test";
+
+    OdbWriter writer;
+    OdbJob originalJob("parallel_job");
+    for (const char* stepName : {"pcb", "panel"}) {
+        Step& step = originalJob.createStep(stepName);
+        for (int l = 0; l < 6; ++l) {
+            auto layer = std::make_unique<Layer>("layer" + std::to_string(l));
+            for (int f = 0; f <= l; ++f) {
+                auto line = std::make_unique<LineFeature>();
+                line->setStart(0.0, static_cast<double>(f));
+                line->setEnd(1.0, static_cast<double>(f));
+                layer->addFeature(std::move(line));
+            }
+            step.addLayer(std::move(layer));
+        }
+    }
+    auto symbol = std::make_unique<Symbol>("custom_pad");
+    symbol->setType(SymbolType::User);
+    symbol->addFeature(std::make_unique<LineFeature>());
+    originalJob.addSymbol(std::move(symbol));
+
+    OdbWriter::Options writeOptions;
+    writeOptions.writeSymbols = true;
+    writeOptions.compressFeatures = false;
+    writer.write(originalJob, odbPath, writeOptions);
+
+    auto readWith = [&](size_t threads, std::vector<double>& progress) {
+        OdbReader reader;
+        reader.setProgressCallback([&](const std::string&, double value) {
+            progress.push_back(value);
+        });
+        OdbReader::Options options;
+        options.threads = threads;
+        OdbJob job = reader.read(odbPath, options);
+        EXPECT_FALSE(reader.hasError()) << reader.getLastError();
+        return job;
+    };
+
+    std::vector<double> serialProgress;
+    std::vector<double> parallelProgress;
+    OdbJob serial = readWith(1, serialProgress);
+    OdbJob parallel = readWith(4, parallelProgress);
+
+    ASSERT_EQ(2u, parallel.getStepCount());
+    for (const char* stepName : {"pcb", "panel"}) {
+        const Step* a = serial.getStep(stepName);
+        const Step* b = parallel.getStep(stepName);
+        ASSERT_NE(a, nullptr);
+        ASSERT_NE(b, nullptr);
+        EXPECT_EQ(a->getLayerNames(), b->getLayerNames());
+        ASSERT_EQ(6u, b->getLayerCount());
+        for (int l = 0; l < 6; ++l) {
+            std::string name = "layer" + std::to_string(l);
+            EXPECT_EQ(static_cast<size_t>(l + 1), b->getLayer(name)->getFeatureCount());
+        }
+    }
+    EXPECT_NE(parallel.getSymbol("custom_pad"), nullptr);
+
+    // Progress stays ordered even when tasks finish on worker threads
+    EXPECT_EQ(serialProgress.size(), parallelProgress.size());
+    EXPECT_TRUE(std::is_sorted(parallelProgress.begin(), parallelProgress.end()));
+}
+
+TEST_F(OdbReaderTest, LazyLayersLoadOnDemand) {
+    auto odbPath = tempDir_ / "lazy_test";
+
+    OdbWriter writer;
+    OdbJob originalJob("lazy_job");
+    Step& step = originalJob.createStep("pcb");
+    for (int l = 0; l < 3; ++l) {
+        auto layer = std::make_unique<Layer>("layer" + std::to_string(l));
+        for (int f = 0; f < 100 * (l + 1); ++f) {
+            layer->addFeature(std::make_unique<PadFeature>(static_cast<double>(f), 0.0, "r10"));
+        }
+        step.addLayer(std::move(layer));
+    }
+    writer.write(originalJob, odbPath);
+
+    OdbReader reader;
+    OdbReader::Options options;
+    options.lazyFeatures = true;
+    options.featureCacheBytes = 1;      // Room for the layer in use only
+    OdbJob job = reader.read(odbPath, options);
+    ASSERT_FALSE(reader.hasError()) << reader.getLastError();
+
+    LayerCache* cache = job.getLayerCache();
+    ASSERT_NE(cache, nullptr);
+    EXPECT_EQ(3u, cache->getStatistics().layers);
+    EXPECT_EQ(0u, cache->getStatistics().loads);
+
+    const Step* loaded = job.getStep("pcb");
+    const Layer* layer0 = loaded->getLayer("layer0");
+    const Layer* layer1 = loaded->getLayer("layer1");
+    EXPECT_FALSE(layer0->isResident());
+    EXPECT_EQ("MM", layer0->getUnits());                    // Loads once for the units
+    EXPECT_EQ(1u, cache->getStatistics().loads);
+    EXPECT_EQ(100u, layer0->getFeatureCount());
+    EXPECT_TRUE(layer0->isResident());
+
+    // Loading another layer evicts the least recently used one
+    EXPECT_EQ(200u, layer1->getFeatureCount());
+    EXPECT_FALSE(layer0->isResident());
+    EXPECT_EQ(1u, cache->getStatistics().evictions);
+    EXPECT_EQ("MM", layer0->getUnits());                    // Kept across eviction
+    EXPECT_EQ(2u, cache->getStatistics().loads);
+    EXPECT_EQ(std::vector<size_t>{5}, layer0->getFeaturesAt(Point2D(5.0, 0.0)));
+    EXPECT_EQ(3u, cache->getStatistics().loads);
+    EXPECT_FALSE(layer1->isResident());
+
+    // Pinned layers stay resident past the budget
+    {
+        LayerCache::Pin pin = cache->pin(*layer1);
+        EXPECT_EQ(200u, layer1->getFeatureCount());
+        EXPECT_EQ(100u, layer0->getFeatureCount());
+        EXPECT_TRUE(layer1->isResident());
+        EXPECT_EQ(2u, cache->getStatistics().residentLayers);
+    }
+    cache->setByteBudget(cache->getStatistics().residentBytes - 1);
+    EXPECT_FALSE(layer1->isResident());
+    EXPECT_TRUE(layer0->isResident());
+
+    // Editing takes a layer out of the cache for good
+    Layer* layer2 = job.getStep("pcb")->getLayer("layer2");
+    layer2->addFeature(std::make_unique<PadFeature>(0.0, 1.0, "r10"));
+    EXPECT_EQ(301u, layer2->getFeatureCount());
+    EXPECT_EQ(2u, cache->getStatistics().layers);
+    cache->evictAll();
+    EXPECT_TRUE(layer2->isResident());
+    EXPECT_FALSE(layer0->isResident());
+    EXPECT_EQ(601u, job.getTotalFeatureCount());
+}
+
+TEST_F(OdbReaderTest, LazyJobsWriteAndDiffPastTheBudget) {
+    // Every layer holds more than the budget; parallel writing and matching
+    // load layers on several threads while others are still being read
+    auto writeJob = [&](const std::filesystem::path& path, double shift) {
+        OdbJob job("lazy_job");
+        Step& step = job.createStep("pcb");
+        for (int l = 0; l < 8; ++l) {
+            auto layer = std::make_unique<Layer>("layer" + std::to_string(l));
+            for (int f = 0; f < 2000; ++f) {
+                double x = static_cast<double>(f) + (f == l ? shift : 0.0);
+                layer->addFeature(std::make_unique<PadFeature>(x, static_cast<double>(l), "r10"));
+            }
+            step.addLayer(std::move(layer));
+        }
+        OdbWriter().write(job, path);
+    };
+    auto readLazy = [](const std::filesystem::path& path) {
+        OdbReader reader;
+        OdbReader::Options options;
+        options.lazyFeatures = true;
+        options.featureCacheBytes = 1;
+        OdbJob job = reader.read(path, options);
+        EXPECT_FALSE(reader.hasError()) << reader.getLastError();
+        return job;
+    };
+    writeJob(tempDir_ / "before", 0.0);
+    writeJob(tempDir_ / "after", 0.5);
+
+    // Writing a lazy job reproduces every layer
+    OdbJob before = readLazy(tempDir_ / "before");
+    OdbWriter writer;
+    OdbWriter::Options writeOptions;
+    writeOptions.threads = 4;
+    ASSERT_TRUE(writer.write(before, tempDir_ / "copy", writeOptions)) << writer.getLastError();
+    OdbReader reader;
+    OdbJob copy = reader.read(tempDir_ / "copy");
+    for (int l = 0; l < 8; ++l) {
+        std::string name = "layer" + std::to_string(l);
+        const FeatureStore& features = copy.getStep("pcb")->getLayer(name)->getFeatures();
+        ASSERT_EQ(2000u, features.size());
+        EXPECT_DOUBLE_EQ(static_cast<double>(l), features[1999].getPosition().y);
+    }
+
+    // Diffing two lazy jobs matches one moved pad per layer
+    OdbJob after = readLazy(tempDir_ / "after");
+    JobDiff::Options diffOptions;
+    diffOptions.threads = 4;
+    auto result = JobDiff(before, after).compare(diffOptions);
+    ASSERT_EQ(1u, result.steps.size());
+    ASSERT_EQ(8u, result.steps[0].getChangedLayers().size());
+    for (const auto& layer : result.steps[0].layers) {
+        ASSERT_EQ(1u, layer.moved.size()) << layer.name;
+        EXPECT_NEAR(0.5, layer.moved[0].offset.x, 1e-12);
+        EXPECT_TRUE(layer.removed.empty());
+    }
+    EXPECT_GT(before.getLayerCache()->getStatistics().evictions, 0u);
+}
+
+TEST_F(OdbReaderTest, BinaryCacheReplacesParsing) {
+    auto odbPath = tempDir_ / "cache_test";
+
+    OdbJob originalJob("cache_job");
+    Step& step = originalJob.createStep("pcb");
+    auto layer = std::make_unique<Layer>("top");
+    layer->addFeature(std::make_unique<LineFeature>(0.0, 0.0, 1.0, 0.0, "r10"));
+    layer->addFeature(std::make_unique<PadFeature>(1.0, 0.0, "rect20x30", 90.0, true));
+    layer->addFeature(std::make_unique<ArcFeature>(0.0, 1.0, 1.0, 1.0, 0.5, 1.0, "r10", true));
+    SurfaceFeature plane;
+    Contour outline(2.0, 0.0);
+    outline.addLineSegment(3.0, 0.0);
+    outline.addArcSegment(2.0, 0.0, 2.5, 0.0, true);
+    plane.addContour(outline);
+    layer->addFeature(plane.clone());
+    layer->addFeature(std::make_unique<PadFeature>(0.0, 2.0, "s15"));
+    step.addLayer(std::move(layer));
+    step.addProfileContour(outline);
+    step.getEdaData().addPackage(std::make_unique<Package>("PKG1"));
+    auto component = std::make_unique<Component>("U1");
+    component->setPackageName("PKG1");
+    component->setPackageIndex(0);
+    component->setPosition(1.0, 0.0);
+    step.getEdaData().addComponent(std::move(component));
+    StackupLayer copper;
+    copper.name = "top";
+    copper.materialType = StackupMaterialType::Copper;
+    copper.thickness = 0.035;
+    originalJob.addStackupLayer(copper);
+    OdbWriter writer;
+    OdbWriter::Options writeOptions;
+    writeOptions.compressFeatures = false;
+    ASSERT_TRUE(writer.write(originalJob, odbPath, writeOptions)) << writer.getLastError();
+
+    // A full read writes the cache; the next read loads it instead of parsing
+    OdbReader reader;
+    OdbReader::Options options;
+    options.writeCache = true;
+    OdbJob parsed = reader.read(odbPath, options);
+    ASSERT_FALSE(reader.hasError()) << reader.getLastError();
+    auto cachePath = OdbCache::defaultPath(odbPath);
+    EXPECT_EQ(tempDir_ / "cache_test.koocache", cachePath);
+    ASSERT_TRUE(std::filesystem::exists(cachePath));
+
+    std::vector<std::string> messages;
+    reader.setProgressCallback([&](const std::string& message, double) { messages.push_back(message); });
+    OdbJob cached = reader.read(odbPath);
+    ASSERT_FALSE(reader.hasError()) << reader.getLastError();
+    EXPECT_EQ(messages.end(), std::find(messages.begin(), messages.end(), "Reading matrix..."));
+    EXPECT_EQ("cache_test", cached.getName());
+    EXPECT_EQ(odbPath, cached.getSourcePath());
+    EXPECT_TRUE(JobDiff(parsed, cached).compare().isIdentical());
+    const Layer* top = cached.getStep("pcb")->getLayer("top");
+    ASSERT_NE(top, nullptr);
+    ASSERT_EQ(5u, top->getFeatureCount());
+    EXPECT_EQ(parsed.getStep("pcb")->getLayer("top")->getSymbolNames(), top->getSymbolNames());
+    EXPECT_EQ(FeatureType::Surface, top->getFeatures()[3].getType());
+    const Component* u1 = cached.getStep("pcb")->getEdaData().getComponent("U1");
+    ASSERT_NE(u1, nullptr);
+    EXPECT_EQ(0, u1->getPackageIndex());
+    EXPECT_EQ(1u, cached.getStackup().size());
+
+    // Touching a source file makes the cache stale, and a full read reparses
+    std::string key = OdbCache::sourceKey(odbPath);
+    auto matrixPath = odbPath / "matrix" / "matrix";
+    std::filesystem::last_write_time(matrixPath,
+        std::filesystem::last_write_time(matrixPath) + std::chrono::seconds(5));
+    EXPECT_NE(key, OdbCache::sourceKey(odbPath));
+    OdbCache cache;
+    OdbJob stale;
+    EXPECT_FALSE(cache.read(cachePath, OdbCache::sourceKey(odbPath), stale));
+    EXPECT_TRUE(cache.read(cachePath, key, stale)) << cache.getLastError();
+
+    messages.clear();
+    OdbJob reparsed = reader.read(odbPath);
+    EXPECT_NE(messages.end(), std::find(messages.begin(), messages.end(), "Reading matrix..."));
+    EXPECT_TRUE(JobDiff(parsed, reparsed).compare().isIdentical());
+
+    // A truncated cache is rejected rather than half loaded
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) / 2);
+    EXPECT_FALSE(cache.read(cachePath, key, stale));
+}
+
+// ============================================================================
+// Archive Tests
+// ============================================================================
+
+TEST_F(OdbReaderTest, ArchiveRoundTrip) {
+    OdbJob originalJob("archive_job");
+    Step& step = originalJob.createStep("pcb");
+    auto layer = std::make_unique<Layer>("top");
+    for (int f = 0; f < 3; ++f) {
+        auto line = std::make_unique<LineFeature>();
+        line->setEnd(1.0, static_cast<double>(f));
+        layer->addFeature(std::move(line));
+    }
+    step.addLayer(std::move(layer));
+
+    for (const char* name : {"job.tgz", "job.tar"}) {
+        for (bool compress : {false, true}) {
+            auto archivePath = tempDir_ / name;
+
+            OdbWriter writer;
+            OdbWriter::Options writeOptions;
+            writeOptions.compressFeatures = compress;
+            writeOptions.overwrite = true;
+            ASSERT_TRUE(writer.write(originalJob, archivePath, writeOptions)) << writer.getLastError();
+            EXPECT_TRUE(std::filesystem::is_regular_file(archivePath));
+
+            OdbArchive archive;
+            ASSERT_TRUE(archive.open(archivePath)) << archive.getLastError();
+            EXPECT_EQ("job", archive.getJobName());
+            EXPECT_TRUE(archive.isDirectory("steps/pcb/layers/top"));
+            EXPECT_EQ(std::vector<std::string>{"pcb"}, archive.listDirectories("steps"));
+
+            OdbReader reader;
+            OdbJob job = reader.read(archivePath);
+            EXPECT_FALSE(reader.hasError()) << reader.getLastError();
+            EXPECT_EQ("job", job.getName());
+            ASSERT_NE(job.getStep("pcb"), nullptr);
+            const Layer* top = job.getStep("pcb")->getLayer("top");
+            ASSERT_NE(top, nullptr);
+            EXPECT_EQ(3u, top->getFeatureCount()) << name << " compress=" << compress;
+
+            EXPECT_EQ(std::vector<std::string>{"pcb"}, reader.listSteps(archivePath));
+        }
+    }
+}
+
 // ============================================================================
 // Progress Callback Test
 // ============================================================================
@@ -1221,3 +1221,77 @@ TEST_F(OdbWriterTest, RoundTrip_Metadata) {
               loadedJob.getAttribute("custom_attr2"));
 }
 
+
+TEST_F(OdbWriterTest, ParallelWriteMatchesSerial) {
+    OdbJob job("parallel_job");
+    Step& step = job.createStep("pcb");
+    for (const char* name : {"top", "bottom", "inner"}) {
+        auto layer = std::make_unique<CopperLayer>(name);
+        for (int i = 0; i < 20000; ++i) {
+            if (i % 3 == 0) {
+                auto line = std::make_unique<LineFeature>(i * 0.125, -0.5, i * 0.125 + 1.0, 2.0 / 3.0, "r100");
+                layer->addFeature(std::move(line));
+            } else {
+                auto pad = std::make_unique<PadFeature>(i * 0.001, -i * 1e-7, i % 2 ? "r50" : "s75");
+                pad->setRotation(i % 5 == 0 ? 90.0 : 0.0);
+                layer->addFeature(std::move(pad));
+            }
+        }
+        step.addLayer(std::move(layer));
+    }
+
+    auto readFile = [](const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    };
+
+    OdbWriter writer;
+    OdbWriter::Options options;
+    options.compressFeatures = false;
+    options.threads = 1;
+    ASSERT_TRUE(writer.write(job, tempDir_ / "serial", options));
+    options.threads = 4;
+    ASSERT_TRUE(writer.write(job, tempDir_ / "parallel", options));
+
+    auto layers = std::filesystem::path("steps") / "pcb" / "layers";
+    std::string serial = readFile(tempDir_ / "serial" / layers / "inner" / "features");
+    EXPECT_NE(serial.find("L 0.375 -0.5 1.375 0.666667 0 P\n"), std::string::npos);
+    EXPECT_NE(serial.find("P 0.001 -0 1 P 0\n"), std::string::npos);
+    for (const char* name : {"top", "bottom", "inner"}) {
+        EXPECT_TRUE(readFile(tempDir_ / "parallel" / layers / name / "features") ==
+                    readFile(tempDir_ / "serial" / layers / name / "features")) << name;
+    }
+
+    // Streamed deflate reads back
+    options.compressFeatures = true;
+    ASSERT_TRUE(writer.write(job, tempDir_ / "compressed", options));
+    OdbReader reader;
+    OdbReader::Options readOptions;
+    readOptions.decompressFeatures = true;
+    OdbJob loaded = reader.read(tempDir_ / "compressed", readOptions);
+    ASSERT_FALSE(reader.hasError());
+    const Layer* loadedLayer = loaded.getStep("pcb")->getLayer("bottom");
+    ASSERT_NE(loadedLayer, nullptr);
+    EXPECT_EQ(loadedLayer->getFeatureCount(), 20000u);
+}
+
+TEST_F(OdbWriterTest, UserSymbolWritesSymbolTable) {
+    OdbJob job("symbol_table");
+    auto symbol = std::make_unique<Symbol>("custom_pad");
+    symbol->setType(SymbolType::User);
+    symbol->addFeature(std::make_unique<PadFeature>(0.0, 0.0, "r10"));
+    symbol->addFeature(std::make_unique<LineFeature>(-1.0, 0.0, 1.0, 0.0, "s20"));
+    symbol->addFeature(std::make_unique<PadFeature>(1.0, 0.0, "s20"));
+    job.addSymbol(std::move(symbol));
+
+    OdbWriter writer;
+    OdbWriter::Options options;
+    options.compressFeatures = false;
+    ASSERT_TRUE(writer.write(job, tempDir_ / "symbol_table", options));
+
+    std::ifstream file(tempDir_ / "symbol_table" / "symbols" / "custom_pad" / "features");
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("$0 r10\n$1 s20\n"), std::string::npos);
+    EXPECT_NE(content.find("L -1 0 1 0 1 P\n"), std::string::npos);
+    EXPECT_NE(content.find("P 1 0 1 P 0\n"), std::string::npos);
+}
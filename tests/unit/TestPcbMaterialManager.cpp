@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+#include <koo/dyna/managers/PcbMaterialManager.hpp>
+#include <koo/dyna/Node.hpp>
+#include <koo/dyna/Element.hpp>
+#include <koo/dyna/Part.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/ecad/OdbJob.hpp>
+#include <set>
+
+using namespace koo;
+using namespace koo::dyna;
+using namespace koo::dyna::managers;
+using namespace koo::ecad;
+
+namespace {
+
+// 4 x 2 board of 1 mm quads, element id = 1 + column + 4*row
+Model makeBoard() {
+    Model model;
+    auto nodes = std::make_unique<Node>();
+    for (int j = 0; j <= 2; ++j) {
+        for (int i = 0; i <= 4; ++i) nodes->addNode(1 + i + 5 * j, i, j, 0.0);
+    }
+    auto shells = std::make_unique<ElementShell>();
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 4; ++i) {
+            NodeId n = 1 + i + 5 * j;
+            shells->addElement(ShellElementData(1 + i + 4 * j, 1, n, n + 1, n + 6, n + 5));
+        }
+    }
+    auto parts = std::make_unique<Part>();
+    parts->addPart(1, 1, 1, "board");
+    model.addKeyword(std::move(nodes));
+    model.addKeyword(std::move(shells));
+    model.addKeyword(std::move(parts));
+    return model;
+}
+
+// Top: plane over the left half; bottom: one full and one half element pad
+OdbJob makeJob() {
+    OdbJob job;
+    auto step = std::make_unique<Step>("pcb");
+
+    auto top = std::make_unique<Layer>("top");
+    SurfaceFeature plane;
+    Contour contour(0.0, 0.0);
+    contour.addLineSegment(2.0, 0.0);
+    contour.addLineSegment(2.0, 2.0);
+    contour.addLineSegment(0.0, 2.0);
+    contour.addLineSegment(0.0, 0.0);
+    plane.addContour(contour);
+    top->addFeature(plane.clone());
+    step->addLayer(std::move(top));
+
+    auto bottom = std::make_unique<Layer>("bottom");
+    bottom->addFeature(std::make_unique<PadFeature>(2.5, 0.5, "s1000"));
+    bottom->addFeature(std::make_unique<PadFeature>(3.25, 1.5, "rect500x1000"));
+    step->addLayer(std::move(bottom));
+    job.addStep(std::move(step));
+
+    LayerDefinition def;
+    def.name = "top";
+    def.type = LayerType::Signal;
+    def.row = 1;
+    job.getMatrix().addLayer(def);
+    def.name = "bottom";
+    def.row = 3;
+    job.getMatrix().addLayer(def);
+
+    StackupLayer layer;
+    layer.name = "TOP";
+    layer.materialType = StackupMaterialType::Copper;
+    layer.thickness = 0.035;
+    job.addStackupLayer(layer);
+    layer.name = "core";
+    layer.materialType = StackupMaterialType::Core;
+    layer.thickness = 1.5;
+    job.addStackupLayer(layer);
+    layer.name = "L2";
+    layer.materialType = StackupMaterialType::Copper;
+    layer.thickness = 0.035;
+    layer.layerIndex = 3;
+    job.addStackupLayer(layer);
+    return job;
+}
+
+} // anonymous namespace
+
+TEST(PcbMaterialManagerTest, ComputesCopperFractions) {
+    Model model = makeBoard();
+    OdbJob job = makeJob();
+    PcbMaterialManager mgr(model, job, *job.getStep("pcb"));
+
+    PcbMaterialManager::Options options;
+    options.cellSize = 0.25;
+    auto result = mgr.computeFractions(options);
+    ASSERT_EQ(result.layers.size(), 2u);
+    EXPECT_EQ(result.layers[1], "L2");
+    ASSERT_EQ(result.elements.size(), 8u);
+    EXPECT_NEAR(result.stackThickness, 1.57, 1e-12);
+    EXPECT_TRUE(result.warnings.empty());
+
+    for (size_t e = 0; e < 8; ++e) {
+        size_t column = e % 4;
+        EXPECT_NEAR(result.getFraction(e, 0), column < 2 ? 1.0 : 0.0, 1e-6) << e;
+    }
+    EXPECT_NEAR(result.getFraction(2, 1), 1.0, 1e-6);
+    EXPECT_NEAR(result.getFraction(7, 1), 0.5, 1e-6);
+    EXPECT_NEAR(result.getFraction(3, 1), 0.0, 1e-6);
+    EXPECT_NEAR(result.volumeShares[0], 0.035 / 1.57, 1e-6);
+    EXPECT_NEAR(result.volumeShares[7], 0.0175 / 1.57, 1e-6);
+
+    // Placement maps model coordinates onto the layer; threads do not matter
+    options.scale = 2.0;
+    options.offsetX = -0.5;
+    options.threads = 3;
+    auto shifted = mgr.computeFractions(options);
+    EXPECT_NEAR(shifted.getFraction(0, 0), 1.0, 1e-6);
+    EXPECT_NEAR(shifted.getFraction(3, 0), 0.5, 1e-6);
+    options.threads = 1;
+    EXPECT_EQ(mgr.computeFractions(options).fractions, shifted.fractions);
+
+    // Unknown stackup copper is reported and skipped
+    job.addStackupLayer({"L3", StackupMaterialType::Copper, 0.035, 0.0, 0.0, "", -1, {}});
+    EXPECT_EQ(mgr.computeFractions().warnings.size(), 1u);
+}
+
+TEST(PcbMaterialManagerTest, ApplyCreatesLevelParts) {
+    Model model = makeBoard();
+    OdbJob job = makeJob();
+    PcbMaterialManager mgr(model, job, *job.getStep("pcb"));
+
+    PcbMaterialManager::Options options;
+    options.cellSize = 0.25;
+    options.levels = 4;
+    auto result = mgr.apply(options);
+
+    // Empty, half and full copper elements land in three levels
+    ASSERT_EQ(result.createdParts.size(), 3u);
+    EXPECT_EQ(result.createdParts[0], 2);
+    const auto* shells = model.getShellElements();
+    std::set<PartId> used;
+    for (const auto& element : shells->getElements()) used.insert(element.pid);
+    EXPECT_EQ(used, std::set<PartId>(result.createdParts.begin(), result.createdParts.end()));
+    EXPECT_EQ(shells->getElement(1)->pid, shells->getElement(3)->pid);
+    EXPECT_NE(shells->getElement(1)->pid, shells->getElement(8)->pid);
+    EXPECT_NE(shells->getElement(4)->pid, shells->getElement(8)->pid);
+
+    // Full level: rule of mixtures at the top share, stack-thick shell section
+    const PartData* full = model.findPart(shells->getElement(1)->pid);
+    ASSERT_NE(full, nullptr);
+    const auto* material = dynamic_cast<const MatElastic*>(model.findMaterial(full->mid));
+    ASSERT_NE(material, nullptr);
+    double share = 0.035 / 1.57;
+    EXPECT_NEAR(material->getData().e, share * 1.17e5 + (1.0 - share) * 2.2e4, 1e-3);
+    const SectionShell* section = nullptr;
+    for (const auto* s : model.getSections()) {
+        if (s->getSectionId() == full->secid) section = dynamic_cast<const SectionShell*>(s);
+    }
+    ASSERT_NE(section, nullptr);
+    EXPECT_NEAR(section->getThickness(), 1.57, 1e-12);
+    EXPECT_EQ(model.getMaterials().size(), 3u);
+}
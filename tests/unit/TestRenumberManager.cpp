@@ -0,0 +1,329 @@
+#include <gtest/gtest.h>
+#include <koo/dyna/Constrained.hpp>
+#include <koo/dyna/Define.hpp>
+#include <koo/dyna/Initial.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Model.hpp>
+#include <koo/dyna/Set.hpp>
+#include <koo/dyna/KeywordFileReader.hpp>
+#include <koo/dyna/managers/RenumberManager.hpp>
+#include <filesystem>
+#include <fstream>
+
+using namespace koo::dyna;
+using namespace koo::dyna::managers;
+using namespace koo;
+
+namespace {
+
+// Two shells on four nodes; nodes and elements start at `base`
+void buildStrip(Model& model, int64_t base, PartId pid) {
+    auto& nodes = model.getOrCreateNodes();
+    for (int64_t i = 0; i < 6; ++i) {
+        nodes.addNode(base + i * 10, static_cast<double>(i % 3), static_cast<double>(i / 3), 0.0);
+    }
+    model.getOrCreateParts().addPart(pid, 1, 1);
+    auto& shells = model.getOrCreateShellElements();
+    shells.addElement(base, pid, base, base + 10, base + 40, base + 30);
+    shells.addElement(base + 1, pid, base + 10, base + 20, base + 50, base + 40);
+}
+
+} // anonymous namespace
+
+TEST(RenumberManagerTest, CompactRewritesReferences) {
+    Model model;
+    buildStrip(model, 100, 7);
+
+    auto set = std::make_unique<SetNode>();
+    set->setSetId(3);
+    set->addNode(120);
+    set->addNode(999);  // Undefined node
+    model.addKeyword(std::move(set));
+
+    RenumberManager mgr(model);
+    RenumberManager::Options options;
+    options.mode = RenumberManager::Mode::Compact;
+    auto result = mgr.renumber(options);
+
+    EXPECT_EQ(result.map(IdKind::Node).at(100), 1);
+    EXPECT_EQ(result.map(IdKind::Node).at(150), 6);
+    EXPECT_EQ(result.map(IdKind::Part).at(7), 1);
+    EXPECT_EQ(result.map(IdKind::NodeSet).at(3), 1);
+    EXPECT_EQ(result.unresolved[static_cast<size_t>(IdKind::Node)], 1);
+
+    const auto& nodes = model.getOrCreateNodes();
+    ASSERT_NE(nodes.getNode(3), nullptr);
+    EXPECT_DOUBLE_EQ(nodes.getNode(3)->position.x, 2.0);
+    EXPECT_EQ(nodes.getNode(100), nullptr);
+
+    const auto* shell = model.getOrCreateShellElements().getElement(2);
+    ASSERT_NE(shell, nullptr);
+    EXPECT_EQ(shell->pid, 1);
+    EXPECT_EQ(shell->nodeIds, (std::vector<NodeId>{2, 3, 6, 5}));
+
+    const auto* nodeSet = model.getKeywordsOfType<SetNode>()[0];
+    EXPECT_EQ(nodeSet->getSetId(), 1);
+    EXPECT_EQ(nodeSet->getNodes(), (std::vector<NodeId>{3, 999}));
+}
+
+TEST(RenumberManagerTest, CompactRefusesToAliasUndefinedReferences) {
+    Model model;
+    buildStrip(model, 100, 7);
+    auto set = std::make_unique<SetNode>();
+    set->setSetId(3);
+    set->addNode(120);
+    set->addNode(4);  // Undefined, but inside the compacted node range 1..6
+    model.addKeyword(std::move(set));
+
+    RenumberManager::Options options;
+    options.mode = RenumberManager::Mode::Compact;
+    auto result = RenumberManager(model).renumber(options);
+    EXPECT_TRUE(result.skipped[static_cast<size_t>(IdKind::Node)]);
+    EXPECT_FALSE(result.skipped[static_cast<size_t>(IdKind::Part)]);
+    EXPECT_EQ(result.map(IdKind::Node).at(120), 120);
+
+    const auto* nodeSet = model.getKeywordsOfType<SetNode>()[0];
+    EXPECT_EQ(nodeSet->getNodes(), (std::vector<NodeId>{120, 4}));
+    EXPECT_NE(model.getOrCreateNodes().getNode(120), nullptr);
+    const auto* shell = model.getOrCreateShellElements().getElement(1);
+    ASSERT_NE(shell, nullptr);
+    EXPECT_EQ(shell->pid, 1);
+    EXPECT_EQ(shell->nodeIds[0], 100);
+}
+
+TEST(RenumberManagerTest, MergeAvoidsCollisions) {
+    Model target;
+    buildStrip(target, 1, 1);
+
+    Model source;
+    buildStrip(source, 1, 1);
+
+    RenumberManager mgr(target);
+    auto offsets = mgr.computeCollisionFreeOffsets(source);
+    EXPECT_EQ(offsets[static_cast<size_t>(IdKind::Node)], 51);
+    EXPECT_EQ(offsets[static_cast<size_t>(IdKind::Part)], 1);
+    EXPECT_EQ(offsets[static_cast<size_t>(IdKind::Curve)], 0);
+
+    auto result = mgr.merge(source);
+    EXPECT_TRUE(source.getKeywords().empty());
+    EXPECT_EQ(result.map(IdKind::Node).at(1), 52);
+    EXPECT_EQ(result.map(IdKind::Element).at(2), 4);
+
+    auto ranges = mgr.getIdRanges();
+    const auto& nodeRange = ranges[static_cast<size_t>(IdKind::Node)];
+    EXPECT_EQ(nodeRange.count, 12);
+    EXPECT_EQ(nodeRange.min, 1);
+    EXPECT_EQ(nodeRange.max, 102);
+
+    auto shellBlocks = target.getKeywordsOfType<ElementShell>();
+    ASSERT_EQ(shellBlocks.size(), 2);
+    const auto* moved = shellBlocks[1]->getElement(3);
+    ASSERT_NE(moved, nullptr);
+    EXPECT_EQ(moved->pid, 2);
+    EXPECT_EQ(moved->nodeIds[0], 52);
+}
+
+TEST(RenumberManagerTest, MaterialCurvesAreRewritten) {
+    Model model;
+    auto curve = std::make_unique<DefineCurve>();
+    curve->setCurveId(40);
+    curve->addPoint(0.0, 200.0);
+    model.addKeyword(std::move(curve));
+    auto mat = std::make_unique<MatPiecewiseLinearPlasticity>();
+    mat->setMaterialId(9);
+    mat->getData().lcss = 40;
+    mat->getData().lcsr = 77;  // Defined elsewhere
+    model.addKeyword(std::move(mat));
+
+    RenumberManager::Options options;
+    options.mode = RenumberManager::Mode::Compact;
+    auto result = RenumberManager(model).renumber(options);
+    EXPECT_EQ(result.unresolved[static_cast<size_t>(IdKind::Curve)], 1);
+
+    const auto* rewritten = model.getKeywordsOfType<MatPiecewiseLinearPlasticity>()[0];
+    EXPECT_EQ(rewritten->getMaterialId(), 1);
+    EXPECT_EQ(rewritten->getData().lcss, 1);
+    EXPECT_EQ(rewritten->getData().lcsr, 77);
+}
+
+TEST(RenumberManagerTest, OffsetKeepsExternalReferences) {
+    Model target;
+    buildStrip(target, 1, 1);
+
+    Model source;
+    buildStrip(source, 1, 1);
+    auto set = std::make_unique<SetNode>();
+    set->setSetId(1);
+    set->addNode(11);
+    set->addNode(500);  // Node of the target model
+    source.addKeyword(std::move(set));
+
+    auto result = RenumberManager(target).merge(source);
+    EXPECT_EQ(result.unresolved[static_cast<size_t>(IdKind::Node)], 1);
+    const auto* merged = target.getKeywordsOfType<SetNode>()[0];
+    EXPECT_EQ(merged->getNodes(), (std::vector<NodeId>{62, 500}));
+}
+
+TEST(RenumberManagerTest, GenerateRangesBlockCompaction) {
+    Model model;
+    buildStrip(model, 100, 7);
+    auto set = std::make_unique<SetNodeGenerate>();
+    set->setSetId(2);
+    set->getRanges().push_back({100, 130, 1});
+    model.addKeyword(std::move(set));
+
+    // Compacting would break the range: nodes keep their IDs
+    RenumberManager::Options compact;
+    compact.mode = RenumberManager::Mode::Compact;
+    auto result = RenumberManager(model).renumber(compact);
+    EXPECT_TRUE(result.skipped[static_cast<size_t>(IdKind::Node)]);
+    EXPECT_FALSE(result.skipped[static_cast<size_t>(IdKind::Part)]);
+    EXPECT_NE(model.getOrCreateNodes().getNode(150), nullptr);
+    EXPECT_EQ(model.getOrCreateShellElements().getElement(1)->pid, 1);
+
+    // Offsetting moves the range, end points need not be nodes
+    model.getKeywordsOfType<SetNodeGenerate>()[0]->getRanges()[0].nid2 = 135;
+    RenumberManager::Options offset;
+    offset.offset(IdKind::Node, 1000);
+    result = RenumberManager(model).renumber(offset);
+    EXPECT_FALSE(result.skipped[static_cast<size_t>(IdKind::Node)]);
+    const auto& range = model.getKeywordsOfType<SetNodeGenerate>()[0]->getRanges()[0];
+    EXPECT_EQ(range.nid1, 1100);
+    EXPECT_EQ(range.nid2, 1135);
+}
+
+TEST(RenumberManagerTest, GeneralSetsBlockTheirMemberKinds) {
+    Model model;
+    buildStrip(model, 100, 7);
+    auto set = std::make_unique<SetNodeGeneral>();
+    set->getData().sid = 4;
+    set->getData().da1 = 110;
+    model.addKeyword(std::move(set));
+
+    RenumberManager::Options options;
+    options.offset(IdKind::Node, 1000).offset(IdKind::Element, 1000);
+    auto result = RenumberManager(model).renumber(options);
+    EXPECT_TRUE(result.skipped[static_cast<size_t>(IdKind::Node)]);
+    EXPECT_FALSE(result.skipped[static_cast<size_t>(IdKind::Element)]);
+    EXPECT_NE(model.getOrCreateNodes().getNode(110), nullptr);
+    EXPECT_NE(model.getOrCreateShellElements().getElement(1101), nullptr);
+}
+
+TEST(RenumberManagerTest, MergeRewritesConstraintsAndInitialConditions) {
+    Model target;
+    buildStrip(target, 1, 1);
+
+    Model source;
+    buildStrip(source, 1, 1);
+    auto set = std::make_unique<SetNode>();
+    set->setSetId(1);
+    set->addNode(1);
+    set->addNode(11);
+    source.addKeyword(std::move(set));
+    auto rigid = std::make_unique<ConstrainedNodalRigidBody>();
+    rigid->getData().pid = 1;
+    rigid->getData().nsid = 1;
+    rigid->getData().pnode = 11;
+    source.addKeyword(std::move(rigid));
+    auto velocity = std::make_unique<InitialVelocity>();
+    velocity->addVelocity(1, 1.0, 0.0, 0.0);
+    velocity->addVelocity(21, 0.0, 1.0, 0.0);
+    source.addKeyword(std::move(velocity));
+
+    auto result = RenumberManager(target).merge(source);
+    EXPECT_FALSE(result.skipped[static_cast<size_t>(IdKind::Node)]);
+    EXPECT_FALSE(result.skipped[static_cast<size_t>(IdKind::Part)]);
+
+    const auto* moved = target.getKeywordsOfType<ConstrainedNodalRigidBody>()[0];
+    EXPECT_EQ(moved->getData().pid, 2);
+    EXPECT_EQ(moved->getData().nsid, 1);
+    EXPECT_EQ(moved->getData().pnode, 62);
+
+    const auto& velocities = target.getKeywordsOfType<InitialVelocity>()[0]->getVelocities();
+    ASSERT_EQ(velocities.size(), 2);
+    EXPECT_EQ(velocities[0].nid, 52);
+    EXPECT_EQ(velocities[1].nid, 72);
+}
+
+TEST(RenumberManagerTest, UnmappedKeywordsBlockEveryKind) {
+    Model model;
+    buildStrip(model, 100, 7);
+    model.addKeyword(std::make_unique<GenericKeyword>("*UNKNOWN_CARD"));
+
+    RenumberManager::Options options;
+    options.offset(IdKind::Node, 1000).offset(IdKind::Part, 10);
+    auto result = RenumberManager(model).renumber(options);
+    EXPECT_TRUE(result.skipped[static_cast<size_t>(IdKind::Node)]);
+    EXPECT_TRUE(result.skipped[static_cast<size_t>(IdKind::Part)]);
+    EXPECT_NE(model.getOrCreateNodes().getNode(100), nullptr);
+    EXPECT_NE(model.getOrCreateParts().getPart(7), nullptr);
+}
+
+TEST(RenumberManagerTest, ThreadCountIndependent) {
+    Model model;
+    auto& nodes = model.getOrCreateNodes();
+    auto& shells = model.getOrCreateShellElements();
+    // Large enough to be split into several chunks
+    for (int64_t i = 0; i < 20000; ++i) {
+        nodes.addNode(5 * i + 3, static_cast<double>(i), 0.0, 0.0);
+    }
+    for (int64_t i = 0; i + 3 < 20000; i += 2) {
+        shells.addElement(i + 1, 1, 5 * i + 3, 5 * i + 8, 5 * i + 13, 5 * i + 18);
+    }
+
+    Model copy(model);
+
+    RenumberManager::Options serial;
+    serial.mode = RenumberManager::Mode::Compact;
+    serial.threads = 1;
+    RenumberManager::Options parallel = serial;
+    parallel.threads = 4;
+
+    RenumberManager(model).renumber(serial);
+    RenumberManager(copy).renumber(parallel);
+
+    const auto& a = model.getOrCreateShellElements().getElements();
+    const auto& b = copy.getOrCreateShellElements().getElements();
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].id, b[i].id);
+        ASSERT_EQ(a[i].nodeIds, b[i].nodeIds);
+    }
+    EXPECT_EQ(a.back().nodeIds[3], 20000);
+}
+
+TEST(RenumberManagerTest, ReaderAppliesIncludeAutoOffset) {
+    auto dir = std::filesystem::temp_directory_path() / "koo_renumber_test";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream out(dir / "sub.k");
+        out << "*KEYWORD\n"
+               "*NODE\n"
+               "       1       0.0       0.0       0.0\n"
+               "       2       1.0       0.0       0.0\n"
+               "*END\n";
+    }
+
+    std::string content =
+        "*KEYWORD\n"
+        "*NODE\n"
+        "       1       0.0       0.0       0.0\n"
+        "       2       0.0       1.0       0.0\n"
+        "*INCLUDE_AUTO_OFFSET\n"
+        "sub.k\n"
+        "*END\n";
+
+    KeywordFileReader reader;
+    Model model = reader.readFromString(content, dir);
+
+    size_t nodeCount = 0;
+    for (const auto* block : model.getKeywordsOfType<Node>()) {
+        nodeCount += block->getNodeCount();
+    }
+    EXPECT_EQ(nodeCount, 4);
+
+    auto ranges = RenumberManager(model).getIdRanges();
+    EXPECT_EQ(ranges[static_cast<size_t>(IdKind::Node)].max, 4);
+
+    std::filesystem::remove_all(dir);
+}
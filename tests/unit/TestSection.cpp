@@ -91,3 +91,22 @@ TEST(SectionSolidTest, SectionType) {
     EXPECT_EQ(sec.getSectionType(), SectionType::Solid);
     EXPECT_EQ(sec.getKeywordName(), "*SECTION_SOLID");
 }
+
+TEST(SectionPropertiesTest, ShellThicknessAndBeamArea) {
+    SectionShell shell;
+    shell.setThickness(1.5);
+    EXPECT_DOUBLE_EQ(getSectionProperties(shell).shellThickness, 1.5);
+    EXPECT_DOUBLE_EQ(getSectionProperties(shell).beamArea, 0.0);
+
+    // Beam area falls back to TS1 * TT1 without an explicit A
+    SectionBeam beam;
+    beam.getCrossSection().ts1 = 2.0;
+    beam.getCrossSection().tt1 = 3.0;
+    EXPECT_DOUBLE_EQ(getSectionProperties(beam).beamArea, 6.0);
+    beam.setArea(4.0);
+    EXPECT_DOUBLE_EQ(getSectionProperties(beam).beamArea, 4.0);
+
+    SectionSolid solid;
+    EXPECT_DOUBLE_EQ(getSectionProperties(solid).shellThickness, 0.0);
+    EXPECT_DOUBLE_EQ(getSectionProperties(solid).beamArea, 0.0);
+}
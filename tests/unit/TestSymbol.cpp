@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <koo/ecad/Symbol.hpp>
 #include <koo/ecad/Feature.hpp>
+#include <koo/ecad/FeatureStore.hpp>
 
 using namespace koo::ecad;
 
@@ -237,3 +238,112 @@ TEST(SymbolTest, Clone) {
     EXPECT_FALSE(cloned->isStandard());
     EXPECT_EQ(cloned->getFeatures().size(), 1);
 }
+
+// ============================================================================
+// Symbol Cache Tests
+// ============================================================================
+
+TEST(SymbolCacheTest, ParsesOncePerUnits) {
+    SymbolCache cache;
+    const SymbolGeometry& round = cache.get("r10", "INCH");
+    EXPECT_EQ(&cache.get("r10", "INCH"), &round);
+    EXPECT_EQ(round.getType(), SymbolType::Round);
+    EXPECT_DOUBLE_EQ(round.radius, 0.005);
+    EXPECT_DOUBLE_EQ(round.bounds.max.x, 0.005);
+    EXPECT_EQ(round.rings.size(), 2u);
+
+    const SymbolGeometry& metric = cache.get("r10", "MM");
+    EXPECT_NE(&metric, &round);
+    EXPECT_NEAR(metric.radius, 0.005, 1e-15);
+    EXPECT_EQ(cache.size(), 2u);
+
+    const SymbolGeometry& unknown = cache.get("my_logo", "MM");
+    EXPECT_FALSE(unknown.isValid());
+    EXPECT_EQ(unknown.symbol, nullptr);
+    EXPECT_TRUE(unknown.points.empty());
+
+    StringTable table;
+    table.intern("rect20x40");
+    table.intern("r10");
+    auto resolved = cache.resolve(table, "INCH");
+    ASSERT_EQ(resolved.size(), 2u);
+    EXPECT_EQ(resolved[1], &round);
+    EXPECT_DOUBLE_EQ(resolved[0]->bounds.max.y, 0.02);
+    EXPECT_EQ(cache.size(), 4u);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(SymbolCacheTest, PadBoundingBoxPlacesOutline) {
+    SymbolCache cache;
+    PadFeature pad(1.0, 2.0, "rect20x40");
+    BoundingBox2D box = pad.getBoundingBox(cache, "INCH");
+    EXPECT_DOUBLE_EQ(box.min.x, 0.99);
+    EXPECT_DOUBLE_EQ(box.max.y, 2.02);
+
+    pad.setRotation(90.0);
+    pad.setResizeFactor(2.0);
+    pad.setHasResize(true);
+    box = pad.getBoundingBox(cache, "INCH");
+    EXPECT_NEAR(box.min.x, 0.96, 1e-12);
+    EXPECT_NEAR(box.max.y, 2.02, 1e-12);
+
+    PadFeature round(0.0, 0.0, "r10", 30.0);
+    EXPECT_DOUBLE_EQ(round.getBoundingBox(cache, "INCH").max.x, 0.005);
+
+    // Unknown symbols keep the point box
+    PadFeature logo(3.0, 4.0, "my_logo");
+    box = logo.getBoundingBox(cache, "INCH");
+    EXPECT_DOUBLE_EQ(box.min.x, 3.0);
+    EXPECT_DOUBLE_EQ(box.max.x, 3.0);
+}
+
+TEST(SymbolCacheTest, OutlinesUserSymbols) {
+    // Inch symbol: a 0.1 x 0.05 plate and an r20 pad left of it
+    SymbolLibrary library;
+    auto logo = std::make_unique<Symbol>();
+    logo->setName("logo");
+    logo->setUnit('I');
+    SurfaceFeature plate;
+    Contour outline(0.0, 0.0);
+    outline.addLineSegment(0.1, 0.0);
+    outline.addLineSegment(0.1, 0.05);
+    outline.addLineSegment(0.0, 0.05);
+    outline.addLineSegment(0.0, 0.0);
+    plate.addContour(outline);
+    logo->addFeature(plate.clone());
+    logo->addFeature(std::make_unique<PadFeature>(-0.1, 0.0, "r20"));
+    library.addSymbol(std::move(logo));
+
+    SymbolCache cache(1e-6, &library);
+    const SymbolGeometry& geometry = cache.get("logo", "MM");
+    ASSERT_TRUE(geometry.isValid());
+    EXPECT_EQ(geometry.getType(), SymbolType::User);
+    ASSERT_NE(geometry.symbol, nullptr);
+    EXPECT_EQ(geometry.symbol->getName(), "logo");
+    EXPECT_EQ(geometry.rings.size(), 3u);
+    EXPECT_NEAR(geometry.bounds.max.x, 0.11 * 25.4, 1e-9);
+    EXPECT_NEAR(geometry.bounds.min.y, -0.05 * 25.4, 1e-9);
+
+    PadFeature pad(10.0, 0.0, "logo");
+    BoundingBox2D box = pad.getBoundingBox(cache, "MM");
+    EXPECT_NEAR(box.min.x, 10.0 - 0.11 * 25.4, 1e-6);
+    EXPECT_NEAR(box.max.x, 10.0 + 0.1 * 25.4, 1e-9);
+
+    // Without a library the name stays unknown
+    EXPECT_FALSE(SymbolCache().get("logo", "MM").isValid());
+}
+
+TEST(SymbolCacheTest, OutlinesThermalPieces) {
+    SymbolCache cache;
+    const SymbolGeometry& thermal = cache.get("ths40x20x45x4x5", "INCH");
+    EXPECT_EQ(thermal.rings.size(), 9u);    // Island and hole per piece
+    EXPECT_DOUBLE_EQ(thermal.bounds.max.x, 0.02);
+
+    const SymbolGeometry& ellipse = cache.get("el40x20", "INCH");
+    EXPECT_EQ(ellipse.getType(), SymbolType::Ellipse);
+    for (const auto& p : ellipse.points) {
+        EXPECT_NEAR(p.x * p.x / 4e-4 + p.y * p.y / 1e-4, 1.0, 1e-12);
+    }
+}
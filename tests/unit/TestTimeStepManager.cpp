@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <koo/dyna/Model.hpp>
+#include <koo/dyna/Material.hpp>
+#include <koo/dyna/Section.hpp>
+#include <koo/dyna/managers/TimeStepManager.hpp>
+#include <cmath>
+
+using namespace koo::dyna;
+using namespace koo::dyna::managers;
+using namespace koo;
+
+namespace {
+
+constexpr double kE = 210000.0;
+constexpr double kNu = 0.3;
+constexpr double kRho = 7.85e-9;
+
+// Two shell parts: a unit square (part 1) and a half-size square (part 2)
+void buildShellModel(Model& model) {
+    auto mat = std::make_unique<MatElastic>();
+    mat->getData().id = 1;
+    mat->getData().ro = kRho;
+    mat->getData().e = kE;
+    mat->getData().pr = kNu;
+    model.addKeyword(std::move(mat));
+
+    auto sec = std::make_unique<SectionShell>();
+    sec->setSectionId(1);
+    sec->setThickness(2.0);
+    model.addKeyword(std::move(sec));
+
+    auto& parts = model.getOrCreateParts();
+    parts.addPart(1, 1, 1);
+    parts.addPart(2, 1, 1);
+
+    auto& nodes = model.getOrCreateNodes();
+    nodes.addNode(1, 0.0, 0.0, 0.0);
+    nodes.addNode(2, 1.0, 0.0, 0.0);
+    nodes.addNode(3, 1.0, 1.0, 0.0);
+    nodes.addNode(4, 0.0, 1.0, 0.0);
+    nodes.addNode(5, 2.0, 0.0, 0.0);
+    nodes.addNode(6, 2.5, 0.0, 0.0);
+    nodes.addNode(7, 2.5, 0.5, 0.0);
+    nodes.addNode(8, 2.0, 0.5, 0.0);
+
+    auto& shells = model.getOrCreateShellElements();
+    shells.addElement(1, 1, 1, 2, 3, 4);
+    shells.addElement(2, 2, 5, 6, 7, 8);
+}
+
+double shellTimeStep(double length) {
+    return 0.9 * length / std::sqrt(kE / (kRho * (1.0 - kNu * kNu)));
+}
+
+} // anonymous namespace
+
+TEST(TimeStepManagerTest, CharacteristicLengths) {
+    Vec3 quad[4] = {{0, 0, 0}, {2, 0, 0}, {2, 1, 0}, {0, 1, 0}};
+    EXPECT_NEAR(TimeStepManager::shellCharacteristicLength(quad, 4), 1.0, 1e-12);
+
+    Vec3 tri[3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    EXPECT_NEAR(TimeStepManager::shellCharacteristicLength(tri, 3), 1.0 / std::sqrt(2.0), 1e-12);
+
+    Vec3 hex[8] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                   {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    EXPECT_NEAR(TimeStepManager::solidCharacteristicLength(hex), 1.0, 1e-12);
+
+    // Degenerate tetrahedron: minimum altitude
+    Vec3 tet[8] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1},
+                   {0, 0, 1}, {0, 0, 1}, {0, 0, 1}, {0, 0, 1}};
+    EXPECT_NEAR(TimeStepManager::solidCharacteristicLength(tet), 1.0 / std::sqrt(3.0), 1e-12);
+}
+
+TEST(TimeStepManagerTest, PerPartMinimum) {
+    Model model;
+    buildShellModel(model);
+
+    TimeStepManager mgr(model);
+    auto report = mgr.estimate();
+
+    ASSERT_EQ(report.parts.size(), 2);
+    EXPECT_EQ(report.elementCount, 2);
+    EXPECT_EQ(report.skippedCount, 0);
+    EXPECT_NEAR(report.parts[0].minTimeStep, shellTimeStep(1.0), 1e-15);
+    EXPECT_NEAR(report.parts[1].minTimeStep, shellTimeStep(0.5), 1e-15);
+    EXPECT_EQ(report.controlling.eid, 2);
+    ASSERT_EQ(report.parts[0].smallest.size(), 1);
+    EXPECT_EQ(report.parts[0].smallest[0].eid, 1);
+
+    EXPECT_NEAR(report.parts[0].mass, kRho * 1.0 * 2.0, 1e-18);
+    EXPECT_NEAR(report.totalMass, kRho * 1.25 * 2.0, 1e-18);
+    EXPECT_DOUBLE_EQ(report.totalAddedMass, 0.0);
+}
+
+TEST(TimeStepManagerTest, MassScalingPreview) {
+    Model model;
+    buildShellModel(model);
+
+    TimeStepManager mgr(model);
+    TimeStepManager::Options options;
+    options.dt2ms = -shellTimeStep(1.0) / 0.9;  // Target = time step of element 1
+    auto report = mgr.estimate(options);
+
+    ASSERT_EQ(report.parts.size(), 2);
+    EXPECT_EQ(report.parts[0].scaledElementCount, 0);
+    EXPECT_EQ(report.parts[1].scaledElementCount, 1);
+
+    // Halving the time step needs four times the mass
+    double smallMass = kRho * 0.25 * 2.0;
+    EXPECT_NEAR(report.parts[1].addedMass, 3.0 * smallMass, 1e-15 * smallMass);
+}
+
+TEST(TimeStepManagerTest, ThreadCountIndependent) {
+    Model model;
+    buildShellModel(model);
+
+    // 100 x 100 warped shell grid over both parts, enough for several blocks
+    const int n = 100;
+    const NodeId base = 100;
+    auto& nodes = model.getOrCreateNodes();
+    for (int j = 0; j <= n; ++j) {
+        for (int i = 0; i <= n; ++i) {
+            nodes.addNode(base + j * (n + 1) + i, 0.1 * i + 0.002 * j, 0.13 * j, 0.01 * i * j);
+        }
+    }
+    auto& shells = model.getOrCreateShellElements();
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            NodeId n1 = base + j * (n + 1) + i;
+            shells.addElement(base + j * n + i, (i + j) % 2 + 1, n1, n1 + 1, n1 + n + 2, n1 + n + 1);
+        }
+    }
+
+    TimeStepManager mgr(model);
+    TimeStepManager::Options serial;
+    serial.threads = 1;
+    serial.dt2ms = -2.0e-8;
+    TimeStepManager::Options parallel = serial;
+    parallel.threads = 4;
+
+    auto a = mgr.estimate(serial);
+    auto b = mgr.estimate(parallel);
+    EXPECT_EQ(a.elementCount, 10002u);
+    EXPECT_GT(a.totalAddedMass, 0.0);
+    EXPECT_EQ(a.elementCount, b.elementCount);
+    EXPECT_EQ(a.controlling.eid, b.controlling.eid);
+    EXPECT_EQ(a.totalMass, b.totalMass);
+    EXPECT_EQ(a.totalAddedMass, b.totalAddedMass);
+    ASSERT_EQ(a.parts.size(), b.parts.size());
+    for (size_t i = 0; i < a.parts.size(); ++i) {
+        EXPECT_EQ(a.parts[i].minTimeStep, b.parts[i].minTimeStep);
+        EXPECT_EQ(a.parts[i].mass, b.parts[i].mass);
+        EXPECT_EQ(a.parts[i].addedMass, b.parts[i].addedMass);
+        EXPECT_EQ(a.parts[i].scaledElementCount, b.parts[i].scaledElementCount);
+        ASSERT_EQ(a.parts[i].smallest.size(), b.parts[i].smallest.size());
+        for (size_t k = 0; k < a.parts[i].smallest.size(); ++k) {
+            EXPECT_EQ(a.parts[i].smallest[k].eid, b.parts[i].smallest[k].eid);
+        }
+    }
+}